@@ -41,6 +41,10 @@ gridpack::powerflow::PFBus::PFBus(void)
   p_theta = 0.0;
   p_angle = 0.0;
   p_voltage = 0.0;
+  p_saveV = 0.0;
+  p_saveA = 0.0;
+  p_dcInj = 0.0;
+  p_dcAng = 0.0;
   /*p_pl = 0.0;
   p_ql = 0.0;
   p_ip = 0.0;
@@ -96,6 +100,11 @@ bool gridpack::powerflow::PFBus::matrixDiagSize(int *isize, int *jsize) const
     }
   } else if (p_mode == YBus) {
     return YMBus::matrixDiagSize(isize,jsize);
+  } else if (p_mode == DCFlow) {
+    if (isIsolated()) return false;
+    *isize = 1;
+    *jsize = 1;
+    return true;
   }
   return true;
 }
@@ -132,6 +141,29 @@ bool gridpack::powerflow::PFBus::matrixDiagValues(RealType *values)
     } else  {
       return true;
     }
+  } else if (p_mode == DCFlow) {
+    if (isIsolated()) return false;
+    // Angle at reference bus is fixed
+    if (getReferenceBus()) {
+      values[0] = 1.0;
+      return true;
+    }
+    std::vector<boost::shared_ptr<BaseComponent> > branches;
+    getNeighborBranches(branches);
+    int size = branches.size();
+    int i;
+    values[0] = 0.0;
+    for (i=0; i<size; i++) {
+      gridpack::powerflow::PFBranch *branch
+        = dynamic_cast<gridpack::powerflow::PFBranch*>(branches[i].get());
+      gridpack::powerflow::PFBus *bus1
+        = dynamic_cast<gridpack::powerflow::PFBus*>(branch->getBus1().get());
+      gridpack::powerflow::PFBus *bus2
+        = dynamic_cast<gridpack::powerflow::PFBus*>(branch->getBus2().get());
+      if (bus1->isIsolated() || bus2->isIsolated()) continue;
+      values[0] += branch->getDCSusceptance();
+    }
+    return true;
   }
   return false;
 }
@@ -164,6 +196,9 @@ bool gridpack::powerflow::PFBus::vectorSize(int *size) const
     }
   } else if (p_mode == S_Cal){
     *size = 1;
+  } else if (p_mode == DCFlow) {
+    if (isIsolated()) return false;
+    *size = 1;
   } else {
     *size = 2;
   }
@@ -203,6 +238,14 @@ bool gridpack::powerflow::PFBus::vectorValues(ComplexType *values)
 
 bool gridpack::powerflow::PFBus::vectorValues(RealType *values)
 {
+  if (p_mode == DCFlow) {
+    if (getReferenceBus()) {
+      values[0] = 0.0;
+    } else {
+      values[0] = p_dcInj;
+    }
+    return true;
+  }
   if (p_mode == State) {
     values[0] = p_v;
     values[1] = p_a;
@@ -357,6 +400,10 @@ void gridpack::powerflow::PFBus::setValues(gridpack::ComplexType *values)
 
 void gridpack::powerflow::PFBus::setValues(gridpack::RealType *values)
 {
+  if (p_mode == DCFlow) {
+    p_dcAng = values[0];
+    return;
+  }
   double vt = p_v;
   double at = p_a;
   p_a -= values[0];
@@ -409,6 +456,17 @@ void gridpack::powerflow::PFBus::setXCBuf(void *buf)
   
 }
 
+/**
+ * Restore pointer to DataCollection object after the network has been
+ * repartitioned. The rest of the state of the bus is included in serialize
+ * @param data: DataCollection object associated with this bus
+ */
+void gridpack::powerflow::PFBus::rebind(
+    const boost::shared_ptr<gridpack::component::DataCollection> &data)
+{
+  p_data = data.get();
+}
+
 /**
  * Load values stored in DataCollection object into PFBus object. The
  * DataCollection object will have been filled when the network was created
@@ -604,6 +662,34 @@ void gridpack::powerflow::PFBus::setMode(int mode)
   p_mode = mode;
 }
 
+/**
+ * Save current voltage and phase angle so that they can be restored
+ * with restoreVoltage
+ */
+void gridpack::powerflow::PFBus::saveVoltage(void)
+{
+  p_saveV = p_v;
+  p_saveA = p_a;
+}
+
+/**
+ * Restore voltage and phase angle to values saved with saveVoltage
+ */
+void gridpack::powerflow::PFBus::restoreVoltage(void)
+{
+  p_v = p_saveV;
+  p_a = p_saveA;
+  if (p_vMag_ptr) *p_vMag_ptr = p_v;
+  if (p_vAng_ptr) {
+    double pi = 4.0*atan(1.0);
+    if (p_a >= 0.0) {
+      *p_vAng_ptr = fmod(p_a+pi,2.0*pi)-pi;
+    } else {
+      *p_vAng_ptr = fmod(p_a-pi,2.0*pi)+pi;
+    }
+  }
+}
+
 /**
  * Reset voltage and phase angle to initial values
  */
@@ -622,6 +708,34 @@ void gridpack::powerflow::PFBus::resetVoltage(void)
   }
 }
 
+/**
+ * Set the real power injected at this bus for the DC power flow
+ * equations
+ * @param inj injected power (p.u.)
+ */
+void gridpack::powerflow::PFBus::setDCInjection(double inj)
+{
+  p_dcInj = inj;
+}
+
+/**
+ * Return the phase angle from the most recent DC power flow solution
+ * @return phase angle
+ */
+double gridpack::powerflow::PFBus::getDCAngle(void)
+{
+  return p_dcAng;
+}
+
+/**
+ * Set the phase angle for the DC power flow equations
+ * @param ang phase angle
+ */
+void gridpack::powerflow::PFBus::setDCAngle(double ang)
+{
+  p_dcAng = ang;
+}
+
 /**
  * Set voltage limits on bus
  * @param vmin lower value of voltage
@@ -812,6 +926,96 @@ void gridpack::powerflow::PFBus::updatePg(int busID, std::string genID, double v
 }
 */
 
+/**
+ * Evaluate real and reactive power for each generator on the bus
+ * @param pgen real power of each generator
+ * @param qgen reactive power of each generator
+ */
+void gridpack::powerflow::PFBus::getGeneratorPower(std::vector<double> &pgen,
+    std::vector<double> &qgen)
+{
+  int i;
+  int ngen=p_pFac.size();
+  // Evalate p_Pinj and p_Qinj if bus is reference bus. This is skipped when
+  // evaluating matrix elements.
+#ifndef LARGE_MATRIX
+  if (getReferenceBus() || isIsolated()) {
+    std::vector<boost::shared_ptr<BaseComponent> > branches;
+    getNeighborBranches(branches);
+    int size = branches.size();
+    double P, Q, p, q;
+    P = 0.0;
+    Q = 0.0;
+    for (i=0; i<size; i++) {
+      gridpack::powerflow::PFBranch *branch
+        = dynamic_cast<gridpack::powerflow::PFBranch*>(branches[i].get());
+      branch->getPQ(this, &p, &q);
+      P += p;
+      Q += q;
+    }
+    // Also add bus i's own Pi, Qi
+    P += p_v*p_v*p_ybusr;
+    Q += p_v*p_v*(-p_ybusi);
+    p_Pinj = P;
+    p_Qinj = Q;
+  }
+#endif
+  double pl =0.0;
+  double ql =0.0;
+  for (i=0; i<p_pl.size(); i++) {
+    if (p_lstatus[i] == 1) {
+      pl += p_pl[i];
+      ql += p_ql[i];
+    }
+  }
+  pgen.resize(ngen);
+  qgen.resize(ngen);
+  for (i=0; i<ngen; i++) {
+    pgen[i] = p_pFac[i]*(p_Pinj+pl/p_sbase);
+    qgen[i] = p_pFac[i]*(p_Qinj+ql/p_sbase);
+  }
+}
+
+/**
+ * Return numerical values from bus
+ * @param values vector that values are appended to
+ * @param signal "voltage" returns one record containing original bus index,
+ * angle (degrees), voltage magnitude, 1 if the voltage magnitude is
+ * monitored (0 for PV and isolated buses), and 1 if the bus type has changed.
+ * "generator" returns a record for each generator containing original bus
+ * index, real power and reactive power
+ * @return number of records appended to values
+ */
+int gridpack::powerflow::PFBus::getValues(std::vector<double> &values,
+    const char *signal)
+{
+  if (signal == NULL) return 0;
+  if (!strcmp(signal,"voltage")) {
+    double pi = 4.0*atan(1.0);
+    int use_vmag = 1;
+    if (p_saveisPV || p_original_isolated) use_vmag = 0;
+    int changed = 0;
+    if (p_isPV != p_saveisPV) changed = 1;
+    values.push_back(static_cast<double>(getOriginalIndex()));
+    values.push_back(p_a*180.0/pi);
+    values.push_back(p_v);
+    values.push_back(static_cast<double>(use_vmag));
+    values.push_back(static_cast<double>(changed));
+    return 1;
+  } else if (!strcmp(signal,"generator")) {
+    std::vector<double> pgen, qgen;
+    getGeneratorPower(pgen, qgen);
+    int i;
+    for (i=0; i<pgen.size(); i++) {
+      values.push_back(static_cast<double>(getOriginalIndex()));
+      values.push_back(pgen[i]);
+      values.push_back(qgen[i]);
+    }
+    return pgen.size();
+  }
+  return 0;
+}
+
 /**
  * Write output from buses to standard out
  * @param string (output) string with information to be printed out
@@ -968,41 +1172,11 @@ bool gridpack::powerflow::PFBus::serialWrite(char *string, const int bufsize,
     char *cptr = string;
     int i, len, slen = 0;
     int ngen=p_pFac.size();
-    // Evalate p_Pinj and p_Qinj if bus is reference bus. This is skipped when
-    // evaluating matrix elements.
-#ifndef LARGE_MATRIX
-    if (getReferenceBus() || isIsolated()) {
-      std::vector<boost::shared_ptr<BaseComponent> > branches;
-      getNeighborBranches(branches);
-      int size = branches.size();
-      double P, Q, p, q;
-      P = 0.0;
-      Q = 0.0;
-      for (i=0; i<size; i++) {
-        gridpack::powerflow::PFBranch *branch
-          = dynamic_cast<gridpack::powerflow::PFBranch*>(branches[i].get());
-        branch->getPQ(this, &p, &q);
-        P += p;
-        Q += q;
-      }
-      // Also add bus i's own Pi, Qi
-      P += p_v*p_v*p_ybusr;
-      Q += p_v*p_v*(-p_ybusi);
-      p_Pinj = P;
-      p_Qinj = Q;
-    }
-#endif
-    double pl =0.0;
-    double ql =0.0;
-    for (i=0; i<p_pl.size(); i++) {
-      if (p_lstatus[i] == 1) {
-        pl += p_pl[i];
-        ql += p_ql[i];
-      }
-    }
+    std::vector<double> pgen, qgen;
+    getGeneratorPower(pgen, qgen);
     for (i=0; i<ngen; i++) {
-      double pval = p_pFac[i]*(p_Pinj+pl/p_sbase);
-      double qval = p_pFac[i]*(p_Qinj+ql/p_sbase);
+      double pval = pgen[i];
+      double qval = qgen[i];
       if (!strcmp(signal,"power")) {
         sprintf(sbuf, "     %6d      %s   %12.6f      %12.6f\n",
             getOriginalIndex(),p_gid[i].c_str(),pval,qval);
@@ -1748,6 +1922,8 @@ bool gridpack::powerflow::PFBranch::matrixForwardSize(int *isize, int *jsize) co
     }
   } else if (p_mode == YBus) {
     return YMBranch::matrixForwardSize(isize,jsize);
+  } else if (p_mode == DCFlow) {
+    return dcMatrixSize(isize,jsize);
   }
   return false;
 }
@@ -1794,6 +1970,8 @@ bool gridpack::powerflow::PFBranch::matrixReverseSize(int *isize, int *jsize) co
     }
   } else if (p_mode == YBus) {
     return YMBranch::matrixReverseSize(isize,jsize);
+  } else if (p_mode == DCFlow) {
+    return dcMatrixSize(isize,jsize);
   }
   return false;
 }
@@ -1830,6 +2008,11 @@ bool gridpack::powerflow::PFBranch::matrixForwardValues(RealType *values)
     } else {
       return true;
     }
+  } else if (p_mode == DCFlow) {
+    int isize, jsize;
+    if (!dcMatrixSize(&isize,&jsize)) return false;
+    values[0] = -getDCSusceptance();
+    return true;
   }
   return false;
 }
@@ -1860,6 +2043,11 @@ bool gridpack::powerflow::PFBranch::matrixReverseValues(RealType *values)
     } else {
       return true;
     }
+  } else if (p_mode == DCFlow) {
+    int isize, jsize;
+    if (!dcMatrixSize(&isize,&jsize)) return false;
+    values[0] = -getDCSusceptance();
+    return true;
   }
   return false;
 }
@@ -2077,6 +2265,70 @@ gridpack::ComplexType gridpack::powerflow::PFBranch::getComplexPower(
   return s;
 }
 
+/**
+ * Evaluate power flow on a single line
+ * @param idx index of line
+ * @param tag tag of line
+ * @param p real power
+ * @param q reactive power
+ * @param perf square of ratio of flow to rating (0 if line has no rating)
+ * @param viol 1 if flow exceeds rating, 0 otherwise
+ */
+void gridpack::powerflow::PFBranch::getFlow(int idx, std::string tag,
+    double *p, double *q, double *perf, int *viol)
+{
+  gridpack::powerflow::PFBus *bus1
+    = dynamic_cast<gridpack::powerflow::PFBus*>(getBus1().get());
+  gridpack::powerflow::PFBus *bus2
+    = dynamic_cast<gridpack::powerflow::PFBus*>(getBus2().get());
+  gridpack::ComplexType s = getComplexPower(tag);
+  *p = real(s);
+  *q = imag(s);
+  if (!p_branch_status[idx]) *p = 0.0;
+  if (!p_branch_status[idx]) *q = 0.0;
+  if (bus1->isIsolated() || bus2->isIsolated()) *p=0.0;
+  if (bus1->isIsolated() || bus2->isIsolated()) *q=0.0;
+  *perf = 0.0;
+  *viol = 0;
+  if (p_rateA[idx] > 0.0) {
+    *perf = abs(s)/p_rateA[idx];
+    if (*perf > 1.0) *viol = 1;
+    *perf = (*perf)*(*perf);
+  }
+}
+
+/**
+ * Return numerical values from branch
+ * @param values vector that values are appended to
+ * @param signal "flow_values" returns a record for each line containing
+ * original indices of the two buses, real power, reactive power, square of
+ * ratio of flow to rating, rating and 1 if the flow exceeds the rating
+ * @return number of records appended to values
+ */
+int gridpack::powerflow::PFBranch::getValues(std::vector<double> &values,
+    const char *signal)
+{
+  if (signal == NULL || !p_active) return 0;
+  if (!strcmp(signal,"flow_values")) {
+    std::vector<std::string> tags = getLineTags();
+    int i;
+    for (i=0; i<p_elems; i++) {
+      double p, q, perf;
+      int viol;
+      getFlow(i, tags[i], &p, &q, &perf, &viol);
+      values.push_back(static_cast<double>(getBus1OriginalIndex()));
+      values.push_back(static_cast<double>(getBus2OriginalIndex()));
+      values.push_back(p);
+      values.push_back(q);
+      values.push_back(perf);
+      values.push_back(p_rateA[i]);
+      values.push_back(static_cast<double>(viol));
+    }
+    return p_elems;
+  }
+  return 0;
+}
+
 /**
  * Write output from branches to standard out
  * @param string (output) string with information to be printed out
@@ -2105,20 +2357,9 @@ bool gridpack::powerflow::PFBranch::serialWrite(char *string, const int bufsize,
     int i;
     int ilen = 0;
     for (i=0; i<p_elems; i++) {
-      s = getComplexPower(tags[i]);
-      double p = real(s);
-      double q = imag(s);
-      if (!p_branch_status[i]) p = 0.0;
-      if (!p_branch_status[i]) q = 0.0;
-      if (bus1->isIsolated() || bus2->isIsolated()) p=0.0;
-      if (bus1->isIsolated() || bus2->isIsolated()) q=0.0;
-      double perf = 0.0;
-      int viol = 0;
-      if (p_rateA[i] > 0.0) {
-        perf = abs(s)/p_rateA[i];
-        if (perf > 1.0) viol = 1;
-        perf = perf*perf;
-      }
+      double p, q, perf;
+      int viol;
+      getFlow(i, tags[i], &p, &q, &perf, &viol);
       if (rating) {
         sprintf(buf, "%6d %6d %s %20.12e %20.12e %20.12e %20.12e %1d\n",
             getBus1OriginalIndex(),getBus2OriginalIndex(),tags[i].c_str(),
@@ -2214,6 +2455,80 @@ bool gridpack::powerflow::PFBranch::serialWrite(char *string, const int bufsize,
   return false;
 }
 
+/**
+ * Return the susceptance of the branch used in the DC power flow
+ * equations
+ * @return DC susceptance (p.u.)
+ */
+double gridpack::powerflow::PFBranch::getDCSusceptance(void)
+{
+  double ret = 0.0;
+  int i;
+  for (i=0; i<p_elems; i++) {
+    if (p_branch_status[i] && p_reactance[i] != 0.0) {
+      ret += 1.0/p_reactance[i];
+    }
+  }
+  return ret;
+}
+
+/**
+ * Return the DC susceptance 1/x of a single line element
+ * @param tag character string identifying branch element
+ * @return DC susceptance (p.u.)
+ */
+double gridpack::powerflow::PFBranch::getDCSusceptance(std::string tag)
+{
+  int i;
+  for (i=0; i<p_elems; i++) {
+    if (tag == p_ckt[i]) {
+      if (p_branch_status[i] && p_reactance[i] != 0.0) {
+        return 1.0/p_reactance[i];
+      }
+      return 0.0;
+    }
+  }
+  return 0.0;
+}
+
+/**
+ * Return the difference between DC phase angles at the from and to
+ * buses of the branch
+ * @return phase angle difference
+ */
+double gridpack::powerflow::PFBranch::getDCAngleDifference(void)
+{
+  gridpack::powerflow::PFBus *bus1
+    = dynamic_cast<gridpack::powerflow::PFBus*>(getBus1().get());
+  gridpack::powerflow::PFBus *bus2
+    = dynamic_cast<gridpack::powerflow::PFBus*>(getBus2().get());
+  return bus1->getDCAngle()-bus2->getDCAngle();
+}
+
+/**
+ * Size of off-diagonal block in B' matrix. Rows and columns
+ * corresponding to the reference bus only have a diagonal element
+ * @param isize, jsize: number of rows and columns of matrix block
+ * @return false if branch does not contribute to B' matrix
+ */
+bool gridpack::powerflow::PFBranch::dcMatrixSize(int *isize, int *jsize) const
+{
+  gridpack::powerflow::PFBus *bus1
+    = dynamic_cast<gridpack::powerflow::PFBus*>(getBus1().get());
+  gridpack::powerflow::PFBus *bus2
+    = dynamic_cast<gridpack::powerflow::PFBus*>(getBus2().get());
+  bool ok = !bus1->getReferenceBus();
+  ok = ok && !bus2->getReferenceBus();
+  ok = ok && !bus1->isIsolated();
+  ok = ok && !bus2->isIsolated();
+  ok = ok && (p_active);
+  if (ok) {
+    *isize = 1;
+    *jsize = 1;
+  }
+  return ok;
+}
+
 /**
  * Get the status of the branch element
  * @param tag character string identifying branch element
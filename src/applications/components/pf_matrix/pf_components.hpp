@@ -27,7 +27,10 @@
 namespace gridpack {
 namespace powerflow {
 
-enum PFMode{YBus, Jacobian, RHS, S_Cal, State};
+// DCFlow is used to set up the linearized (DC) power flow equations. Buses
+// contribute one row to the B' matrix and to vectors of angles and
+// injections
+enum PFMode{YBus, Jacobian, RHS, S_Cal, State, DCFlow};
 
 class PFBus
   : public gridpack::ymatrix::YMBus
@@ -120,6 +123,13 @@ class PFBus
      */
     void load(const boost::shared_ptr<gridpack::component::DataCollection> &data);
 
+    /**
+     * Restore pointer to DataCollection object after the network has been
+     * repartitioned
+     * @param data: DataCollection object associated with this bus
+     */
+    void rebind(const boost::shared_ptr<gridpack::component::DataCollection> &data);
+
     /**
      * Set the mode to control what matrices and vectors are built when using
      * the mapper
@@ -132,6 +142,39 @@ class PFBus
      */
     void resetVoltage(void);
 
+    /**
+     * Save current voltage and phase angle so that they can be restored
+     * with restoreVoltage
+     */
+    void saveVoltage(void);
+
+    /**
+     * Restore voltage and phase angle to values saved with saveVoltage
+     */
+    void restoreVoltage(void);
+
+    /**
+     * Set the real power injected at this bus for the DC power flow
+     * equations. This is the value returned by vectorValues in DCFlow mode
+     * @param inj injected power (p.u.)
+     */
+    void setDCInjection(double inj);
+
+    /**
+     * Return the phase angle from the most recent DC power flow solution.
+     * This is the value set by setValues in DCFlow mode
+     * @return phase angle
+     */
+    double getDCAngle(void);
+
+    /**
+     * Set the phase angle for the DC power flow equations. The DC angle is
+     * not part of the bus exchange buffer, so this is used to assign the
+     * angle on ghost buses
+     * @param ang phase angle
+     */
+    void setDCAngle(double ang);
+
     /**
      * Set voltage limits on bus
      * @param vmin lower value of voltage
@@ -241,6 +284,25 @@ class PFBus
      */
     bool serialWrite(char *string, const int bufsize, const char *signal = NULL);
 
+    /**
+     * Return numerical values from bus
+     * @param values vector that values are appended to
+     * @param signal "voltage" returns one record containing original bus
+     * index, angle (degrees), voltage magnitude, 1 if the voltage magnitude is
+     * monitored (0 for PV and isolated buses), and 1 if the bus type has
+     * changed. "generator" returns a record for each generator containing
+     * original bus index, real power and reactive power
+     * @return number of records appended to values
+     */
+    int getValues(std::vector<double> &values, const char *signal = NULL);
+
+    /**
+     * Evaluate real and reactive power for each generator on the bus
+     * @param pgen real power of each generator
+     * @param qgen reactive power of each generator
+     */
+    void getGeneratorPower(std::vector<double> &pgen, std::vector<double> &qgen);
+
     /**
      * chkQlim
      check QLIM violations
@@ -434,6 +496,8 @@ class PFBus
     double p_P0, p_Q0; //double p_sbusr, p_sbusi;
     double p_angle;   // initial bus angle read from parser
     double p_voltage; // initial bus voltage read from parser
+    double p_saveV, p_saveA; // voltage and angle stored by saveVoltage
+    double p_dcInj, p_dcAng; // injection and angle for DC power flow
     // newly added priavate variables:
     std::vector<double> p_pg, p_qg, p_pFac;
     std::vector<double> p_savePg;
@@ -495,9 +559,12 @@ private:
       & p_ybusr & p_ybusi
       & p_P0 & p_Q0
       & p_angle & p_voltage
+      & p_saveV & p_saveA
+      & p_dcInj & p_dcAng
       & p_pg & p_qg & p_pFac & p_qmin & p_qmax
       & p_qmin_orig & p_qmax_orig & p_pFac_orig
-      & p_gstatus
+      & p_savePg
+      & p_gstatus & p_gstatus_save
       & p_vs & p_gid
       & p_pt & p_pb
       & p_pl & p_ql & p_ip & p_iq & p_yp & p_yq
@@ -507,11 +574,12 @@ private:
       & p_Pinj & p_Qinj
       & p_vmin & p_vmax
       & p_isPV
-      & p_saveisPV
+      & p_saveisPV & p_save2isPV
       & p_ngen & p_type & p_nload
       & p_area & p_zone
       & p_source & p_sink
-      & p_rtpr_scale;
+      & p_rtpr_scale
+      & p_original_isolated;
   }  
 
 };
@@ -610,6 +678,50 @@ class PFBranch
      */
     bool serialWrite(char *string, const int bufsize, const char *signal = NULL);
 
+    /**
+     * Return numerical values from branch
+     * @param values vector that values are appended to
+     * @param signal "flow_values" returns a record for each line containing
+     * original indices of the two buses, real power, reactive power, square
+     * of ratio of flow to rating, rating and 1 if the flow exceeds the rating
+     * @return number of records appended to values
+     */
+    int getValues(std::vector<double> &values, const char *signal = NULL);
+
+    /**
+     * Evaluate power flow on a single line
+     * @param idx index of line
+     * @param tag tag of line
+     * @param p real power
+     * @param q reactive power
+     * @param perf square of ratio of flow to rating (0 if line has no rating)
+     * @param viol 1 if flow exceeds rating, 0 otherwise
+     */
+    void getFlow(int idx, std::string tag, double *p, double *q, double *perf,
+        int *viol);
+
+    /**
+     * Return the susceptance of the branch used in the DC power flow
+     * equations. This is the sum of 1/x over all active line elements
+     * @return DC susceptance (p.u.)
+     */
+    double getDCSusceptance(void);
+
+    /**
+     * Return the DC susceptance 1/x of a single line element
+     * @param tag character string identifying branch element
+     * @return DC susceptance (p.u.). This is zero if the element is not
+     *         active
+     */
+    double getDCSusceptance(std::string tag);
+
+    /**
+     * Return the difference between DC phase angles at the from and to
+     * buses of the branch
+     * @return phase angle difference
+     */
+    double getDCAngleDifference(void);
+
     /**
      * Get the status of the branch element
      * @param tag character string identifying branch element
@@ -675,6 +787,13 @@ class PFBranch
     int reverseJacobianValues(double *rvals);
 
   private:
+    /**
+     * Size of off-diagonal block in B' matrix for DC power flow
+     * @param isize, jsize: number of rows and columns of matrix block
+     * @return false if branch does not contribute to B' matrix
+     */
+    bool dcMatrixSize(int *isize, int *jsize) const;
+
     std::vector<bool> p_ignore;
     std::vector<double> p_reactance;
     std::vector<double> p_resistance;
@@ -719,7 +838,7 @@ private:
       & p_shunt_admt_g2
       & p_shunt_admt_b2
       & p_xform & p_shunt 
-      & p_rateA
+      & p_rateA & p_rateB & p_rateC
       & p_branch_status
       & p_ckt
       & p_mode
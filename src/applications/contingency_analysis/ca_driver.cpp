@@ -20,6 +20,7 @@
 
 #include "gridpack/include/gridpack.hpp"
 #include "gridpack/applications/modules/powerflow/pf_app_module.hpp"
+#include "gridpack/applications/modules/powerflow/dc_screen_module.hpp"
 #include "ca_driver.hpp"
 
 #define USE_SUCCESS
@@ -204,6 +205,19 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
   if (!cursor->get("checkQLimit",&check_Qlim)) {
     check_Qlim = false;
   }
+  // Check for screening of contingencies using DC sensitivities. If
+  // validateScreening is true, all contingencies are still evaluated with
+  // the AC power flow so that the number of missed violations can be
+  // reported. The DC screen only estimates line loadings, so contingencies
+  // that are not flagged are not checked for voltage violations
+  bool screen_ctgs = cursor->get("screenContingencies",false);
+  double screen_threshold = cursor->get("screeningThreshold",0.9);
+  int screen_cache = cursor->get("screeningCacheLines",256);
+  bool validate_screen = cursor->get("validateScreening",false);
+  // Use rating B for line overload checks. The same rating is used by the
+  // AC violation checks and the DC screen, so that screening does not drop
+  // contingencies that the AC check would flag
+  bool use_rateB = cursor->get("useBranchRatingB",false);
   gridpack::parallel::Communicator task_comm = world.divide(grp_size);
 
   // Keep track of failed calculations
@@ -237,6 +251,7 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
   // Some buses may violate the voltage limits in the base problem. Flag these
   // buses to ignore voltage violations on them.
   pf_app.ignoreVoltageViolations();
+  pf_app.useRateB(use_rateB);
 
   // Read in contingency file name
   std::string contingencyfile;
@@ -281,6 +296,65 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
   }
 
 
+  // Screen contingencies using DC sensitivities. Only contingencies that
+  // may lead to line overloads are evaluated with the AC power flow.
+  // Voltage violations are not screened
+  std::vector<int> screen_flag(events.size(),1);
+  if (screen_ctgs) {
+    gridpack::powerflow::DCScreenModule dc_screen;
+    dc_screen.setThreshold(screen_threshold);
+    dc_screen.useRateB(use_rateB);
+    dc_screen.setCacheLimit(screen_cache);
+    dc_screen.setNetwork(pf_network,
+        config->getCursor("Configuration.Powerflow"));
+    std::vector<double> loading;
+    double t_start = timer->currentTime();
+    dc_screen.screen(events, world, loading);
+    double t_screen = timer->currentTime()-t_start;
+    world.max(&t_screen,1);
+    std::vector<int> order;
+    dc_screen.rank(loading, order);
+    int nflagged = 0;
+    int idx;
+    for (idx=0; idx<events.size(); idx++) {
+      if (!dc_screen.isFlagged(loading[idx])) {
+        screen_flag[idx] = 0;
+      } else {
+        nflagged++;
+      }
+    }
+    if (world.rank() == 0) {
+      printf("\nDC screening of %d contingencies: %f seconds"
+          " (%f contingencies/second)\n",static_cast<int>(events.size()),
+          t_screen,t_screen > 0.0 ? events.size()/t_screen : 0.0);
+      printf("Contingencies flagged for AC evaluation: %d\n",nflagged);
+      for (idx=0; idx<order.size(); idx++) {
+        int k = order[idx];
+        if (loading[k] < 0.0) {
+          printf("  %s estimated loading: not screened\n",
+              events[k].p_name.c_str());
+        } else {
+          printf("  %s estimated loading: %8.4f%s\n",
+              events[k].p_name.c_str(),loading[k],
+              screen_flag[k] ? " (flagged)" : "");
+        }
+      }
+    }
+    // Keep only flagged contingencies, in ranked order
+    if (!validate_screen) {
+      std::vector<gridpack::powerflow::Contingency> flagged;
+      for (idx=0; idx<order.size(); idx++) {
+        if (screen_flag[order[idx]]) flagged.push_back(events[order[idx]]);
+      }
+      events = flagged;
+      screen_flag.assign(events.size(),1);
+    }
+  }
+  // Contingencies that lead to line overloads or divergent calculations
+  std::vector<int> ac_fail(events.size(),0);
+  // Contingencies that lead to voltage violations
+  std::vector<int> ac_vfail(events.size(),0);
+
   // Set up task manager on the world communicator. The number of tasks is
   // equal to the number of contingencies
   gridpack::parallel::TaskManager taskmgr(world);
@@ -293,8 +367,14 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
 #ifdef USE_STATBLOCK
   int t_store = timer->createCategory("Store Statistics");
   timer->start(t_store);
-  std::vector<std::string> v_vals = pf_app.writeBusString("vr_str");
-  int nsize = v_vals.size();
+  // Numerical results are returned as contiguous records of nvals values,
+  // ordered by global index
+  std::vector<int> v_idx;
+  std::vector<double> v_data;
+  std::vector<std::string> v_vals;
+  double *rec;
+  int nvals = pf_app.getBusValues("voltage",v_idx,v_data);
+  int nsize = v_idx.size();
   std::vector<int> mag_ids;
   std::vector<int> ids;
   std::vector<int> branch_ids;
@@ -307,24 +387,27 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
   // Find bus IDs and create a dummy tag label and get voltage magnitude
   // and angle for base case
   for (i=0; i<nsize; i++) {
-    std::vector<std::string> tokens = util.blankTokenizer(v_vals[i]);
-    int not_isolated = atoi(tokens[3].c_str());
+    rec = &v_data[i*nvals];
+    int not_isolated = static_cast<int>(rec[3]);
     if (not_isolated == 1) {
-      mag_ids.push_back(atoi(tokens[0].c_str()));
+      mag_ids.push_back(static_cast<int>(rec[0]));
       mag_tags.push_back("1 ");
-      vmag.push_back(atof(tokens[2].c_str()));
-      if (atoi(tokens[4].c_str()) != 0) {
+      vmag.push_back(rec[2]);
+      if (static_cast<int>(rec[4]) != 0) {
         mag_mask.push_back(2);
       } else {
         mag_mask.push_back(1);
       }
     }
-    ids.push_back(atoi(tokens[0].c_str()));
+    ids.push_back(static_cast<int>(rec[0]));
     tags.push_back("1 ");
-    vang.push_back(atof(tokens[1].c_str()));
+    vang.push_back(rec[1]);
     mask.push_back(1);
   }
   int nmags = vmag.size();
+  // Number of local rows is needed for divergent contingencies
+  int bus_rows = vang.size();
+  int mag_rows = nmags;
   world.max(&nmags,1);
   world.max(&nbus,1);
 #endif
@@ -352,9 +435,10 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
   mask.clear();
   std::vector<double> pgen;
   std::vector<double> qgen;
+  // Generator tags are only available as strings. These are only needed
+  // once to label the rows
   v_vals = pf_app.writeBusString("power");
   nsize = v_vals.size();
-  // Find bus IDs and tags for generators and eveluate Pg and Qg for base case
   for (i=0; i<nsize; i++) {
     std::vector<std::string> tokens = util.blankTokenizer(v_vals[i]);
     if (tokens.size()%4 != 0) {
@@ -363,14 +447,24 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
     }
     int ngen = tokens.size()/4;
     for (j=0; j<ngen; j++) {
-      ids.push_back(atoi(tokens[j*4].c_str()));
       tags.push_back(tokens[j*4+1]);
-      pgen.push_back(atof(tokens[j*4+2].c_str()));
-      qgen.push_back(atof(tokens[j*4+3].c_str()));
-      mask.push_back(1);
     }
   }
+  // Find bus IDs for generators and evaluate Pg and Qg for base case
+  nvals = pf_app.getBusValues("generator",v_idx,v_data);
+  nsize = v_idx.size();
+  for (i=0; i<nsize; i++) {
+    rec = &v_data[i*nvals];
+    ids.push_back(static_cast<int>(rec[0]));
+    pgen.push_back(rec[1]);
+    qgen.push_back(rec[2]);
+    mask.push_back(1);
+  }
+  if (world.rank() == 0 && tags.size() != ids.size()) {
+    printf("Incorrect generator listing\n");
+  }
   nsize = pgen.size();
+  int gen_rows = nsize;
   world.max(&nsize,1);
 #endif
   // Create StatBlock objects for Pg and Qg and add labels as well as values for
@@ -398,10 +492,10 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
   std::vector<double> pflow;
   std::vector<double> qflow;
   std::vector<double> perf;
+  // Line tags are only available as strings. These are only needed once to
+  // label the rows
   v_vals = pf_app.writeBranchString("flow_str");
   nsize = v_vals.size();
-  // Parse branch line endpoints as well as line IDs and values of P and Q for
-  // base case
   for (i=0; i<nsize; i++) {
     std::vector<std::string> tokens = util.blankTokenizer(v_vals[i]);
     if (tokens.size()%8 != 0) {
@@ -410,22 +504,32 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
     }
     int nline = tokens.size()/8;
     for (j=0; j<nline; j++) {
-      id1.push_back(atoi(tokens[j*8].c_str()));
-      id2.push_back(atoi(tokens[j*8+1].c_str()));
       tags.push_back(tokens[j*8+2]);
-      pflow.push_back(atof(tokens[j*8+3].c_str()));
-      qflow.push_back(atof(tokens[j*8+4].c_str()));
-      perf.push_back(atof(tokens[j*8+5].c_str()));
-      pmin.push_back(-atof(tokens[j*8+6].c_str()));
-      pmax.push_back(atof(tokens[j*8+6].c_str()));
-      if (atoi(tokens[j*8+7].c_str()) == 0) {
-        mask.push_back(1);
-      } else {
-        mask.push_back(2);
-      }
     }
   }
+  // Find branch line endpoints and values of P and Q for base case
+  nvals = pf_app.getBranchValues("flow_values",v_idx,v_data);
+  nsize = v_idx.size();
+  for (i=0; i<nsize; i++) {
+    rec = &v_data[i*nvals];
+    id1.push_back(static_cast<int>(rec[0]));
+    id2.push_back(static_cast<int>(rec[1]));
+    pflow.push_back(rec[2]);
+    qflow.push_back(rec[3]);
+    perf.push_back(rec[4]);
+    pmin.push_back(-rec[5]);
+    pmax.push_back(rec[5]);
+    if (static_cast<int>(rec[6]) == 0) {
+      mask.push_back(1);
+    } else {
+      mask.push_back(2);
+    }
+  }
+  if (world.rank() == 0 && tags.size() != id1.size()) {
+    printf("Incorrect branch power flow listing\n");
+  }
   nsize = pflow.size();
+  int line_rows = nsize;
   world.max(&nsize,1);
 #endif
   // Create StatBlock objects for flow parameters and add labels and base case
@@ -449,6 +553,8 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
   timer->stop(t_store);
 #endif
   if (check_Qlim) pf_app.clearQlimViolations();
+  // Factor base case Jacobian if low-rank contingency solves are enabled
+  pf_app.setBaseCase();
 
 
   // Evaluate contingencies using the task manager
@@ -498,7 +604,7 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
 #ifdef USE_SUCCESS
     contingency_idx.push_back(task_id);
 #endif
-    if (pf_app.solve()) {
+    if (pf_app.contingencySolve()) {
 #ifdef USE_SUCCESS
       contingency_success.push_back(true);
 #endif
@@ -522,12 +628,14 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
       if (!ok1) {
         sprintf(sbuf,"\nBus Violation for contingency %s\n",
             events[task_id].p_name.c_str());
+        if (task_comm.rank() == 0) ac_vfail[task_id] = 1;
       }
       if (print_calcs) pf_app.print(sbuf);
       if (print_calcs) pf_app.writeCABus();
       if (!ok2) {
         sprintf(sbuf,"\nBranch Violation for contingency %s\n",
             events[task_id].p_name.c_str());
+        if (task_comm.rank() == 0) ac_fail[task_id] = 1;
       }
 
 #ifdef USE_SUCCESS
@@ -542,30 +650,28 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
         
       if (print_calcs) pf_app.print(sbuf);
       if (print_calcs) pf_app.writeCABranch();
-      // Get strings of data from power flow calculation and parse them to
-      // extract numerical values. Store these values in vectors and then
-      // add them to StatBlock objects
+      // Get numerical results from power flow calculation. Store these values
+      // in vectors and then add them to StatBlock objects
 #ifdef USE_STATBLOCK
       timer->start(t_store);
       vmag.clear();
       vang.clear();
       mask.clear();
       mag_mask.clear();
-      v_vals.clear();
-      v_vals = pf_app.writeBusString("vr_str");
-      nsize = v_vals.size();
+      nvals = pf_app.getBusValues("voltage",v_idx,v_data);
+      nsize = v_idx.size();
       for (i=0; i<nsize; i++) {
-        std::vector<std::string> tokens = util.blankTokenizer(v_vals[i]);
-        int not_isolated = atoi(tokens[3].c_str());
+        rec = &v_data[i*nvals];
+        int not_isolated = static_cast<int>(rec[3]);
         if (not_isolated == 1) {
-          vmag.push_back(atof(tokens[2].c_str()));
-          if (atoi(tokens[4].c_str()) != 0) {
+          vmag.push_back(rec[2]);
+          if (static_cast<int>(rec[4]) != 0) {
             mag_mask.push_back(2);
           } else {
             mag_mask.push_back(1);
           }
         }
-        vang.push_back(atof(tokens[1].c_str()));
+        vang.push_back(rec[1]);
         mask.push_back(1);
       }
 #endif
@@ -579,21 +685,13 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
       pgen.clear();
       qgen.clear();
       mask.clear();
-      v_vals.clear();
-      v_vals = pf_app.writeBusString("power");
-      nsize = v_vals.size();
+      nvals = pf_app.getBusValues("generator",v_idx,v_data);
+      nsize = v_idx.size();
       for (i=0; i<nsize; i++) {
-        std::vector<std::string> tokens = util.blankTokenizer(v_vals[i]);
-        if (tokens.size()%4 != 0) {
-          printf("Incorrect generator listing\n");
-          continue;
-        }
-        int ngen = tokens.size()/4;
-        for (j=0; j<ngen; j++) {
-          pgen.push_back(atof(tokens[j*4+2].c_str()));
-          qgen.push_back(atof(tokens[j*4+3].c_str()));
-          mask.push_back(1);
-        }
+        rec = &v_data[i*nvals];
+        pgen.push_back(rec[1]);
+        qgen.push_back(rec[2]);
+        mask.push_back(1);
       }
 #endif
 #ifdef USE_STATBLOCK
@@ -607,25 +705,17 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
       qflow.clear();
       perf.clear();
       mask.clear();
-      v_vals.clear();
-      v_vals = pf_app.writeBranchString("flow_str");
-      nsize = v_vals.size();
+      nvals = pf_app.getBranchValues("flow_values",v_idx,v_data);
+      nsize = v_idx.size();
       for (i=0; i<nsize; i++) {
-        std::vector<std::string> tokens = util.blankTokenizer(v_vals[i]);
-        if (tokens.size()%8 != 0) {
-          printf("Incorrect branch power flow listing\n");
-          continue;
-        }
-        int nline = tokens.size()/8;
-        for (j=0; j<nline; j++) {
-          pflow.push_back(atof(tokens[j*8+3].c_str()));
-          qflow.push_back(atof(tokens[j*8+4].c_str()));
-          perf.push_back(atof(tokens[j*8+5].c_str()));
-          if (atoi(tokens[j*8+7].c_str()) == 0) {
-            mask.push_back(1);
-          } else {
-            mask.push_back(2);
-          }
+        rec = &v_data[i*nvals];
+        pflow.push_back(rec[2]);
+        qflow.push_back(rec[3]);
+        perf.push_back(rec[4]);
+        if (static_cast<int>(rec[6]) == 0) {
+          mask.push_back(1);
+        } else {
+          mask.push_back(2);
         }
       }
 #endif
@@ -646,27 +736,16 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
       sprintf(sbuf,"\nDivergent for contingency %s\n",
           events[task_id].p_name.c_str());
       if (print_calcs) pf_app.print(sbuf);
+      if (task_comm.rank() == 0) ac_fail[task_id] = 1;
       // Add dummy values to StatBlock object. Mask value is set to 0 for all
       // network elements to indicate calculation failure
 #ifdef USE_STATBLOCK
       timer->start(t_store);
-      vmag.clear();
-      vang.clear();
-      mask.clear();
-      mag_mask.clear();
-      v_vals.clear();
-      v_vals = pf_app.writeBusString("vfail_str");
-      nsize = v_vals.size();
-      for (i=0; i<nsize; i++) {
-        std::vector<std::string> tokens = util.blankTokenizer(v_vals[i]);
-        int not_isolated = atoi(tokens[3].c_str());
-        if (not_isolated == 1) {
-          vmag.push_back(0.0);
-          mag_mask.push_back(0);
-        }
-        vang.push_back(0.0);
-        mask.push_back(0);
-      }
+      // Rows are the same as in the base case
+      vmag.assign(mag_rows,0.0);
+      mag_mask.assign(mag_rows,0);
+      vang.assign(bus_rows,0.0);
+      mask.assign(bus_rows,0);
 #endif
 #ifdef USE_STATBLOCK
       if (task_comm.rank() == 0) {
@@ -675,25 +754,9 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
       }
 #endif
 #ifdef USE_STATBLOCK
-      pgen.clear();
-      qgen.clear();
-      mask.clear();
-      v_vals.clear();
-      v_vals = pf_app.writeBusString("pfail_str");
-      nsize = v_vals.size();
-      for (i=0; i<nsize; i++) {
-        std::vector<std::string> tokens = util.blankTokenizer(v_vals[i]);
-        if (tokens.size()%4 != 0) {
-          printf("Incorrect generator listing\n");
-          continue;
-        }
-        int ngen = tokens.size()/4;
-        for (j=0; j<ngen; j++) {
-          pgen.push_back(0.0);
-          qgen.push_back(0.0);
-          mask.push_back(0);
-        }
-      }
+      pgen.assign(gen_rows,0.0);
+      qgen.assign(gen_rows,0.0);
+      mask.assign(gen_rows,0);
 #endif
 #ifdef USE_STATBLOCK
       if (task_comm.rank() == 0) {
@@ -702,27 +765,10 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
       }
 #endif
 #ifdef USE_STATBLOCK
-      pflow.clear();
-      qflow.clear();
-      perf.clear();
-      mask.clear();
-      v_vals.clear();
-      v_vals = pf_app.writeBranchString("fail_str");
-      nsize = v_vals.size();
-      for (i=0; i<nsize; i++) {
-        std::vector<std::string> tokens = util.blankTokenizer(v_vals[i]);
-        if (tokens.size()%8 != 0) {
-          printf("Incorrect branch power flow listing\n");
-          continue;
-        }
-        int nline = tokens.size()/8;
-        for (j=0; j<nline; j++) {
-          pflow.push_back(0.0);
-          qflow.push_back(0.0);
-          perf.push_back(0.0);
-          mask.push_back(0);
-        }
-      }
+      pflow.assign(line_rows,0.0);
+      qflow.assign(line_rows,0.0);
+      perf.assign(line_rows,0.0);
+      mask.assign(line_rows,0);
 #endif
 #ifdef USE_STATBLOCK
       if (task_comm.rank() == 0) {
@@ -742,6 +788,44 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
   // per processor
   taskmgr.printStats();
 
+  // Report contingencies that were not flagged by the screening but have
+  // line overloads or fail to converge in the AC calculation. Voltage
+  // violations are not screened, so these are reported separately
+  if (screen_ctgs && validate_screen) {
+    if (ntasks > 0) world.sum(&ac_fail[0],ntasks);
+    if (ntasks > 0) world.sum(&ac_vfail[0],ntasks);
+    int nmissed = 0;
+    int nunflagged = 0;
+    int nfail = 0;
+    int nvmissed = 0;
+    for (i=0; i<ntasks; i++) {
+      if (ac_fail[i]) nfail++;
+      if (!screen_flag[i]) {
+        nunflagged++;
+        if (ac_fail[i]) {
+          nmissed++;
+          if (world.rank() == 0) printf("Screening missed violation in"
+              " contingency %s\n",events[i].p_name.c_str());
+        }
+        if (ac_vfail[i]) {
+          nvmissed++;
+          if (world.rank() == 0) printf("Voltage violation in unscreened"
+              " contingency %s\n",events[i].p_name.c_str());
+        }
+      }
+    }
+    if (world.rank() == 0) {
+      printf("\nScreening validation: %d of %d contingencies with AC"
+          " violations were not flagged\n",nmissed,nfail);
+      printf("False negative rate: %f\n",
+          nfail > 0 ? static_cast<double>(nmissed)/nfail : 0.0);
+      printf("False omission rate: %f\n",
+          nunflagged > 0 ? static_cast<double>(nmissed)/nunflagged : 0.0);
+      printf("Contingencies not flagged with voltage violations: %d of %d"
+          " (voltage limits are not screened)\n",nvmissed,nunflagged);
+    }
+  }
+
   // Gather stats on successful contingency calculations
 #ifdef USE_SUCCESS
   if (task_comm.rank() == 0) {
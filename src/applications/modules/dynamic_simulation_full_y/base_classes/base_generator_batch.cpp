@@ -0,0 +1,139 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -----------------------------------------------------------
+/**
+ * @file   base_generator_batch.cpp
+ * @author agent
+ * @Last modified:   October 17, 2026
+ *
+ * @brief
+ *
+ *
+ */
+
+#include <vector>
+#include <cmath>
+
+#include "base_generator_batch.hpp"
+
+/**
+ *  Basic constructor
+ *  @param nfield number of variables stored for each generator
+ */
+gridpack::dynamic_simulation::BaseGeneratorBatch::BaseGeneratorBatch(
+    int nfield)
+{
+  p_nfield = nfield;
+  p_size = 0;
+}
+
+/**
+ *  Basic destructor
+ */
+gridpack::dynamic_simulation::BaseGeneratorBatch::~BaseGeneratorBatch(void)
+{
+}
+
+/**
+ * Copy parameters and current state of all generators into the batch
+ * and assign each generator to its slot
+ */
+void gridpack::dynamic_simulation::BaseGeneratorBatch::build()
+{
+  int i;
+  p_size = p_models.size();
+  p_data.assign(p_nfield*p_size, 0.0);
+  p_mag.assign(p_size, 0.0);
+  p_ang.assign(p_size, 0.0);
+  p_IrNorton.assign(p_size, 0.0);
+  p_IiNorton.assign(p_size, 0.0);
+  p_exciters.assign(p_size, NULL);
+  p_governors.assign(p_size, NULL);
+  p_pss.assign(p_size, NULL);
+  p_status.assign(p_size, 1);
+  for (i=0; i<p_size; i++) {
+    BaseGeneratorModel *gen = p_models[i];
+    if (gen->p_hasExciter) p_exciters[i] = gen->getExciter().get();
+    if (gen->p_hasGovernor) p_governors[i] = gen->getGovernor().get();
+    if (gen->p_hasPss) p_pss[i] = gen->getPss().get();
+    load(i);
+    gen->setBatch(this, i);
+  }
+  updateStatus();
+}
+
+/**
+ * Copy state of all generators back to the generator objects and remove
+ * them from the batch
+ */
+void gridpack::dynamic_simulation::BaseGeneratorBatch::clear()
+{
+  int i;
+  for (i=0; i<p_size; i++) {
+    sync(i);
+    p_models[i]->setBatch(NULL, -1);
+  }
+  p_models.clear();
+  p_data.clear();
+  p_exciters.clear();
+  p_governors.clear();
+  p_pss.clear();
+  p_status.clear();
+  p_size = 0;
+}
+
+/**
+ * Return number of generators in batch
+ * @return number of generators
+ */
+int gridpack::dynamic_simulation::BaseGeneratorBatch::size()
+{
+  return p_size;
+}
+
+/**
+ * Set terminal voltage of one generator
+ * @param slot location of generator in batch
+ * @param voltage complex voltage at generator bus
+ */
+void gridpack::dynamic_simulation::BaseGeneratorBatch::setVoltage(int slot,
+    gridpack::ComplexType voltage)
+{
+  p_mag[slot] = abs(voltage);
+  p_ang[slot] = atan2(imag(voltage), real(voltage));
+}
+
+/**
+ * Return contribution of one generator to Norton current
+ * @param slot location of generator in batch
+ * @return contribution to Norton vector
+ */
+gridpack::ComplexType
+gridpack::dynamic_simulation::BaseGeneratorBatch::INorton(int slot)
+{
+  return gridpack::ComplexType(p_IrNorton[slot], p_IiNorton[slot]);
+}
+
+/**
+ * Return array holding one variable for all generators in batch
+ * @param idx index of variable
+ * @return pointer to first element of array
+ */
+double* gridpack::dynamic_simulation::BaseGeneratorBatch::field(int idx)
+{
+  return &p_data[idx*p_size];
+}
+
+/**
+ * Update the service status of all generators in the batch
+ */
+void gridpack::dynamic_simulation::BaseGeneratorBatch::updateStatus()
+{
+  int i;
+  for (i=0; i<p_size; i++) {
+    p_status[i] = (p_models[i]->getGenStatus() ? 1 : 0);
+  }
+}
@@ -0,0 +1,166 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   base_generator_batch.hpp
+ * @author agent
+ * @Last modified:   October 17, 2026
+ *
+ * @brief
+ * Base class for batches of generators of a single type. A batch copies
+ * the parameters and state of all its generators into one block of memory,
+ * stored as one array per variable (structure of arrays), and integrates
+ * all of them in a single loop. The generators in the batch are skipped by
+ * the buses and forward voltage updates, Norton currents and output
+ * requests to the batch.
+ *
+ */
+
+#ifndef _base_generator_batch_h_
+#define _base_generator_batch_h_
+
+#include <vector>
+#include "gridpack/component/base_component.hpp"
+#include "base_generator_model.hpp"
+
+namespace gridpack {
+namespace dynamic_simulation {
+class BaseGeneratorBatch
+{
+  public:
+    /**
+     * Basic constructor
+     * @param nfield number of variables stored for each generator
+     */
+    BaseGeneratorBatch(int nfield);
+
+    /**
+     * Basic destructor. Batches for specific generator types should call
+     * clear in their destructors so that the generators are left with
+     * their current state
+     */
+    virtual ~BaseGeneratorBatch();
+
+    /**
+     * Add generator to batch if it is the type of generator handled by the
+     * batch. Generators can only be added before build is called
+     * @param generator generator model
+     * @return true if generator was added to batch
+     */
+    virtual bool add(BaseGeneratorModel *generator) = 0;
+
+    /**
+     * Copy parameters and current state of all generators into the batch
+     * and assign each generator to its slot. This should be called after
+     * the generators have been initialized
+     */
+    void build();
+
+    /**
+     * Copy state of all generators back to the generator objects and remove
+     * them from the batch
+     */
+    void clear();
+
+    /**
+     * Return number of generators in batch
+     * @return number of generators
+     */
+    int size();
+
+    /**
+     * Copy state of one generator from the batch back to the generator
+     * object so that its output functions report current values
+     * @param slot location of generator in batch
+     */
+    virtual void sync(int slot) = 0;
+
+    /**
+     * Set terminal voltage of one generator
+     * @param slot location of generator in batch
+     * @param voltage complex voltage at generator bus
+     */
+    void setVoltage(int slot, gridpack::ComplexType voltage);
+
+    /**
+     * Return contribution of one generator to Norton current
+     * @param slot location of generator in batch
+     * @return contribution to Norton vector
+     */
+    gridpack::ComplexType INorton(int slot);
+
+    /**
+     * Calculate current injections for all generators (predictor)
+     * @param flag initial step if true
+     */
+    virtual void predictor_currentInjection(bool flag) = 0;
+
+    /**
+     * Predict new state variables of all generators for time step
+     * @param t_inc time step increment
+     * @param flag initial step if true
+     */
+    virtual void predictor(double t_inc, bool flag) = 0;
+
+    /**
+     * Calculate current injections for all generators (corrector)
+     * @param flag initial step if true
+     */
+    virtual void corrector_currentInjection(bool flag) = 0;
+
+    /**
+     * Correct state variables of all generators for time step
+     * @param t_inc time step increment
+     * @param flag initial step if true
+     */
+    virtual void corrector(double t_inc, bool flag) = 0;
+
+  protected:
+
+    /**
+     * Copy parameters and state of one generator into the batch. Called
+     * by build for each generator after the storage has been allocated
+     * @param slot location of generator in batch
+     */
+    virtual void load(int slot) = 0;
+
+    /**
+     * Return array holding one variable for all generators in batch
+     * @param idx index of variable
+     * @return pointer to first element of array
+     */
+    double* field(int idx);
+
+    /**
+     * Update the service status of all generators in the batch. Generators
+     * can be tripped by relays during the simulation
+     */
+    void updateStatus();
+
+    std::vector<BaseGeneratorModel*> p_models;
+    int p_size;
+
+    // models attached to each generator (NULL if generator does not have
+    // the model) and service status of each generator
+    std::vector<BaseExciterModel*> p_exciters;
+    std::vector<BaseGovernorModel*> p_governors;
+    std::vector<BasePssModel*> p_pss;
+    std::vector<int> p_status;
+
+    // terminal voltage and Norton current of each generator
+    std::vector<double> p_mag;
+    std::vector<double> p_ang;
+    std::vector<double> p_IrNorton;
+    std::vector<double> p_IiNorton;
+
+  private:
+
+    int p_nfield;
+    std::vector<double> p_data;
+};
+}  // dynamic_simulation
+}  // gridpack
+#endif
@@ -31,6 +31,8 @@ gridpack::dynamic_simulation::BaseGeneratorModel::BaseGeneratorModel(void)
   p_hasPss = false;
   bStatus = true;
   p_wideareafreq = 0.0;
+  p_batch = NULL;
+  p_batchSlot = -1;
 }
 
 /**
@@ -272,3 +274,35 @@ void gridpack::dynamic_simulation::BaseGeneratorModel::getWatchValues(
 {
   vals.clear();
 }
+
+/**
+ * Assign generator to a batch
+ * @param batch batch containing generator (NULL if the generator is
+ *        integrated on its own)
+ * @param slot location of generator in batch
+ */
+void gridpack::dynamic_simulation::BaseGeneratorModel::setBatch(
+    BaseGeneratorBatch *batch, int slot)
+{
+  p_batch = batch;
+  p_batchSlot = slot;
+}
+
+/**
+ * Return the batch containing this generator
+ * @return pointer to batch (NULL if generator is not in a batch)
+ */
+gridpack::dynamic_simulation::BaseGeneratorBatch*
+gridpack::dynamic_simulation::BaseGeneratorModel::getBatch()
+{
+  return p_batch;
+}
+
+/**
+ * Return the location of this generator in its batch
+ * @return slot in batch
+ */
+int gridpack::dynamic_simulation::BaseGeneratorModel::getBatchSlot()
+{
+  return p_batchSlot;
+}
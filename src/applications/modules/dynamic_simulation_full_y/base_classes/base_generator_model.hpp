@@ -26,6 +26,8 @@
 
 namespace gridpack {
 namespace dynamic_simulation {
+class BaseGeneratorBatch;
+
 class BaseGeneratorModel
 {
   public:
@@ -165,6 +167,28 @@ class BaseGeneratorModel
      */
     virtual void getWatchValues(std::vector<double> &vals);
 
+    /**
+     * Assign generator to a batch. The batch holds the state of the
+     * generator and integrates it together with all other generators of
+     * the same type on this processor
+     * @param batch batch containing generator (NULL if the generator is
+     *        integrated on its own)
+     * @param slot location of generator in batch
+     */
+    void setBatch(BaseGeneratorBatch *batch, int slot);
+
+    /**
+     * Return the batch containing this generator
+     * @return pointer to batch (NULL if generator is not in a batch)
+     */
+    BaseGeneratorBatch* getBatch();
+
+    /**
+     * Return the location of this generator in its batch
+     * @return slot in batch
+     */
+    int getBatchSlot();
+
   //private:
 
     bool p_hasExciter;
@@ -179,6 +203,8 @@ class BaseGeneratorModel
 	boost::shared_ptr<BasePssModel> p_pss;
     bool p_watch;
 	bool bStatus;
+    BaseGeneratorBatch *p_batch;
+    int p_batchSlot;
     std::vector< boost::shared_ptr<BaseRelayModel> > vp_relay;  //renke add, relay vector
 
 };
@@ -22,11 +22,13 @@
 #include "gridpack/mapper/full_map.hpp"
 #include "gridpack/mapper/bus_vector_map.hpp"
 #include "gridpack/math/math.hpp"
+#include "gridpack/environment/threads.hpp"
 #include "gridpack/parallel/global_vector.hpp"
 #include "dsf_app_module.hpp"
 #include <iostream>
 #include <string>
 #include <vector>
+#include <set>
 
 using namespace std;
 
@@ -51,6 +53,9 @@ gridpack::dynamic_simulation::DSFullApp::DSFullApp(void)
   p_generators_read_in = false;
   p_save_time_series = false;
   p_monitorGenerators = false;
+  p_restored = false;
+  p_asyncIO = false;
+  p_batchGenerators = false;
 }
 
 /**
@@ -66,6 +71,9 @@ gridpack::dynamic_simulation::DSFullApp::DSFullApp(gridpack::parallel::Communica
   p_generators_read_in = false;
   p_save_time_series = false;
   p_monitorGenerators = false;
+  p_restored = false;
+  p_asyncIO = false;
+  p_batchGenerators = false;
 }
 
 /**
@@ -125,8 +133,33 @@ void gridpack::dynamic_simulation::DSFullApp::readNetwork(
   p_monitorGenerators = cursor->get("monitorGenerators",false);
   p_maximumFrequency = cursor->get("frequencyMaximum",61.8);
 
+  // Use point-to-point exchanges between neighboring processors for ghost
+  // bus updates
+  network->useNeighborExchange(cursor->get("neighborExchange",false));
+  // Number of threads used in loops over buses and branches (only used if
+  // GridPACK is built with OpenMP)
+  gridpack::Threads::instance()->setNumThreads(
+      cursor->get("componentThreads",1));
+  // Integrate GENROU and GENSAL generators in batches of the same type
+  p_batchGenerators = cursor->get("generatorBatching",false);
+
+  // Restore the partitioned network from a snapshot if one exists for the
+  // current network configuration and generator parameter files
+  p_snapshot = cursor->get("networkSnapshot","");
+  p_restored = false;
+  if (p_snapshot.size() > 0) {
+    p_snap.reset(new gridpack::network::NetworkSnapshot<DSFullNetwork>(network));
+    p_snap->addSourceFile(filename);
+    p_snap->addSourceFile(cursor->get("generatorParameters",""));
+    p_restored = p_snap->read(p_snapshot);
+  }
+
   // load input file
-  if (filetype == PTI23) {
+  if (p_restored) {
+    if (p_comm.rank() == 0) {
+      printf("Network restored from snapshot %s\n",p_snapshot.c_str());
+    }
+  } else if (filetype == PTI23) {
     gridpack::parser::PTI23_parser<DSFullNetwork> parser(network);
     if (filename.size() > 0) parser.parse(filename.c_str());
   } else if (filetype == PTI33) {
@@ -139,11 +172,16 @@ void gridpack::dynamic_simulation::DSFullApp::readNetwork(
   filename = cursor->get("generatorParameters","");
 
   // partition network
-  network->partition();
+  if (!p_restored) network->partition();
 
   // Create serial IO object to export data from buses or branches
   p_busIO.reset(new gridpack::serial_io::SerialBusIO<DSFullNetwork>(512, network));
   p_branchIO.reset(new gridpack::serial_io::SerialBranchIO<DSFullNetwork>(128, network));
+
+  // Write output from a background thread on process 0
+  p_asyncIO = cursor->get("asynchronousIO",false);
+  p_busIO->setAsync(p_asyncIO);
+  p_branchIO->setAsync(p_asyncIO);
 }
 
 /**
@@ -177,10 +215,22 @@ void gridpack::dynamic_simulation::DSFullApp::setNetwork(
   if (p_time_step == 0.0) {
     // TODO: some kind of error
   }
+  network->useNeighborExchange(cursor->get("neighborExchange",false));
+  // Number of threads used in loops over buses and branches (only used if
+  // GridPACK is built with OpenMP)
+  gridpack::Threads::instance()->setNumThreads(
+      cursor->get("componentThreads",1));
+  // Integrate GENROU and GENSAL generators in batches of the same type
+  p_batchGenerators = cursor->get("generatorBatching",false);
 
   // Create serial IO object to export data from buses or branches
   p_busIO.reset(new gridpack::serial_io::SerialBusIO<DSFullNetwork>(512, network));
   p_branchIO.reset(new gridpack::serial_io::SerialBranchIO<DSFullNetwork>(128, network));
+
+  // Write output from a background thread on process 0
+  p_asyncIO = cursor->get("asynchronousIO",false);
+  p_busIO->setAsync(p_asyncIO);
+  p_branchIO->setAsync(p_asyncIO);
 }
 
 /**
@@ -195,9 +245,19 @@ void gridpack::dynamic_simulation::DSFullApp::readGenerators(void)
   gridpack::parser::PTI23_parser<DSFullNetwork> parser(p_network);
   cursor = p_config->getCursor("Configuration.Dynamic_simulation");
   std::string filename = cursor->get("generatorParameters","");
+  if (p_restored) return;
   printf("p[%d] generatorParameters: %s\n",p_comm.rank(),filename.c_str());
   if (filename.size() > 0) parser.externalParse(filename.c_str());
   printf("p[%d] finished Generator parameters\n",p_comm.rank());
+
+  // The dynamic models on each bus are now known, so the network can be
+  // repartitioned using estimates of the cost of each bus as weights
+  if (cursor->get("costWeightedPartition",false)) {
+    p_network->clean();
+    p_network->useCostWeights(true);
+    p_network->partition();
+  }
+  if (p_snap) p_snap->write(p_snapshot);
 }
 
 /**
@@ -217,6 +277,7 @@ void gridpack::dynamic_simulation::DSFullApp::initialize()
 {
   // create factory
   p_factory.reset(new gridpack::dynamic_simulation::DSFullFactory(p_network));
+  p_factory->setGeneratorBatching(p_batchGenerators);
   // p_factory->dumpData();
   p_factory->load();
 
@@ -441,18 +502,18 @@ void gridpack::dynamic_simulation::DSFullApp::solve(
 
   timer->stop(t_init);
 #ifdef USE_TIMESTAMP
-  if (p_generatorWatch) p_generatorIO->header("t, t_stamp");//bus_id,ckt,x1d_1,x2w_1,x3Eqp_1,x4Psidp_1,x5Psiqpp_1");
+  if (p_generatorWatch && p_generatorIO) p_generatorIO->header("t, t_stamp");//bus_id,ckt,x1d_1,x2w_1,x3Eqp_1,x4Psidp_1,x5Psiqpp_1");
 //#  if (p_generatorWatch) p_generatorIO->header("t, t_stamp,bus_id,ckt,x1d_1,x2w_1,x3Eqp_1,x4Psidp_1,x5Psiqpp_1");
-  if (p_generatorWatch) p_generatorIO->write("watch_header");
-  if (p_generatorWatch) p_generatorIO->header("\n");
+  if (p_generatorWatch && p_generatorIO) p_generatorIO->write("watch_header");
+  if (p_generatorWatch && p_generatorIO) p_generatorIO->header("\n");
 
   if (p_loadWatch) p_loadIO->header("t, t_stamp");
   if (p_loadWatch) p_loadIO->write("load_watch_header");
   if (p_loadWatch) p_loadIO->header("\n");
 #else
-  if (p_generatorWatch) p_generatorIO->header("t");
-  if (p_generatorWatch) p_generatorIO->write("watch_header");
-  if (p_generatorWatch) p_generatorIO->header("\n");
+  if (p_generatorWatch && p_generatorIO) p_generatorIO->header("t");
+  if (p_generatorWatch && p_generatorIO) p_generatorIO->write("watch_header");
+  if (p_generatorWatch && p_generatorIO) p_generatorIO->header("\n");
 
   if (p_loadWatch) p_loadIO->header("t");
   if (p_loadWatch) p_loadIO->write("load_watch_header");
@@ -1000,7 +1061,10 @@ void gridpack::dynamic_simulation::DSFullApp::solve(
     }
     int t_secure = timer->createCategory("DS Solve: Check Security");
     timer->start(t_secure);
-    if (p_generatorWatch && I_Steps%p_generatorWatchFrequency == 0) {
+    if (p_generatorWatch && p_generatorSeries &&
+        I_Steps%p_generatorWatchFrequency == 0) {
+      writeGeneratorSeries(static_cast<double>(I_Steps)*p_time_step);
+    } else if (p_generatorWatch && I_Steps%p_generatorWatchFrequency == 0) {
       char tbuf[32];
 #ifdef USE_TIMESTAMP
       sprintf(tbuf,"%8.4f, %20.4f",static_cast<double>(I_Steps)*p_time_step,
@@ -1670,19 +1734,36 @@ void gridpack::dynamic_simulation::DSFullApp::openGeneratorWatchFile()
   cursor = p_config->getCursor("Configuration.Dynamic_simulation");
 #ifndef USEX_GOSS
   std::string filename;
+  // Watch results can be written as text (default) or as a binary time
+  // series file
+  std::string format;
+  if (!cursor->get("generatorWatchFormat",&format)) format = "text";
+  gridpack::utility::StringUtils util;
+  util.trim(format);
+  util.toLower(format);
+  bool binary = (format == "binary");
+  bool single = cursor->get("generatorWatchSinglePrecision",false);
   if (!p_internal_watch_file_name) {
     if (cursor->get("generatorWatchFileName",&filename)) {
-      p_generatorIO.reset(new gridpack::serial_io::SerialBusIO<DSFullNetwork>(128,
-            p_network));
-      p_generatorIO->open(filename.c_str());
+      if (binary) {
+        openGeneratorSeries(filename.c_str(),single);
+      } else {
+        p_generatorIO.reset(new gridpack::serial_io::SerialBusIO<DSFullNetwork>(128,
+              p_network));
+        p_generatorIO->open(filename.c_str());
+        p_generatorIO->setAsync(p_asyncIO);
+      }
     } else {
       p_busIO->header("No Generator Watch File Name Found\n");
       p_generatorWatch = false;
     }
+  } else if (binary) {
+    openGeneratorSeries(p_gen_watch_file.c_str(),single);
   } else {
     p_generatorIO.reset(new gridpack::serial_io::SerialBusIO<DSFullNetwork>(128,
           p_network));
     p_generatorIO->open(p_gen_watch_file.c_str());
+    p_generatorIO->setAsync(p_asyncIO);
   }
 #else
   std::string topic, URI, username, passwd;
@@ -1717,13 +1798,76 @@ void gridpack::dynamic_simulation::DSFullApp::closeGeneratorWatchFile()
 {
   if (p_generatorWatch) {
 #ifndef USEX_GOSS
-    p_generatorIO->close();
+    if (p_generatorSeries) {
+      p_generatorSeries->close();
+    } else {
+      p_generatorIO->close();
+    }
 #else
     p_generatorIO->closeChannel();
 #endif
   }
 }
 
+/**
+ * Open binary time series file for generator results. Each watched
+ * generator contributes one column for each of its watch values
+ * @param filename name of file
+ * @param single store values in single precision
+ */
+void gridpack::dynamic_simulation::DSFullApp::openGeneratorSeries(
+    const char *filename, bool single)
+{
+  // A bus can appear more than once in p_gen_buses if it has several
+  // watched generators, so find the unique list of buses
+  std::set<int> buses(p_gen_buses.begin(), p_gen_buses.end());
+  p_series_buses.assign(buses.begin(), buses.end());
+  std::vector<std::string> names;
+  char buf[128];
+  gridpack::dynamic_simulation::DSFullBus *bus;
+  int i, j, k;
+  for (i=0; i<p_series_buses.size(); i++) {
+    bus = dynamic_cast<gridpack::dynamic_simulation::DSFullBus*>
+      (p_network->getBus(p_series_buses[i]).get());
+    std::vector<std::string> watched = bus->getWatchedGenerators();
+    if (watched.size() == 0) continue;
+    int nvals = bus->getWatchedValues().size()/watched.size();
+    for (j=0; j<watched.size(); j++) {
+      for (k=0; k<nvals; k++) {
+        if (nvals == 2) {
+          sprintf(buf,"%d_%s_%s",bus->getOriginalIndex(),
+              watched[j].c_str(),k == 0 ? "angle" : "speed");
+        } else {
+          sprintf(buf,"%d_%s_%d",bus->getOriginalIndex(),
+              watched[j].c_str(),k);
+        }
+        names.push_back(std::string(buf));
+      }
+    }
+  }
+  p_generatorSeries.reset(new gridpack::serial_io::TimeSeriesWriter(
+        p_network->communicator(),1024,single));
+  p_generatorSeries->open(filename,names);
+}
+
+/**
+ * Append current values of watched generators to binary time series file
+ * @param time current simulation time
+ */
+void gridpack::dynamic_simulation::DSFullApp::writeGeneratorSeries(double time)
+{
+  std::vector<double> values;
+  gridpack::dynamic_simulation::DSFullBus *bus;
+  int i;
+  for (i=0; i<p_series_buses.size(); i++) {
+    bus = dynamic_cast<gridpack::dynamic_simulation::DSFullBus*>
+      (p_network->getBus(p_series_buses[i]).get());
+    std::vector<double> vals = bus->getWatchedValues();
+    values.insert(values.end(), vals.begin(), vals.end());
+  }
+  p_generatorSeries->append(time,values);
+}
+
 /**
  * Open file containing load watch results
  */
@@ -1737,6 +1881,7 @@ void gridpack::dynamic_simulation::DSFullApp::openLoadWatchFile()
     p_loadIO.reset(new gridpack::serial_io::SerialBusIO<DSFullNetwork>(128,
           p_network));
     p_loadIO->open(filename.c_str());
+    p_loadIO->setAsync(p_asyncIO);
   } else {
     p_busIO->header("No Load Watch File Name Found\n");
     p_loadWatch = false;
@@ -21,6 +21,8 @@
 #include "boost/smart_ptr/shared_ptr.hpp"
 #include "gridpack/configuration/configuration.hpp"
 #include "gridpack/serial_io/serial_io.hpp"
+#include "gridpack/serial_io/time_series.hpp"
+#include "gridpack/network/network_snapshot.hpp"
 #include "dsf_factory.hpp"
 
 
@@ -76,6 +78,10 @@ class DSFullApp
     /**
      * Read generator parameters. These will come from a separate file (most
      * likely). The name of this file comes from the input configuration file.
+     * If a network snapshot file is specified in the input deck, the
+     * snapshot is written after the generator parameters have been read. If
+     * the network was restored from a snapshot, the generator parameters
+     * are already present and the file is not read
      */
     void readGenerators(void);
 
@@ -267,6 +273,20 @@ class DSFullApp
      */
     void closeGeneratorWatchFile();
 
+    /**
+     * Open binary time series file for generator results. Each watched
+     * generator contributes one column for each of its watch values
+     * @param filename name of file
+     * @param single store values in single precision
+     */
+    void openGeneratorSeries(const char *filename, bool single);
+
+    /**
+     * Append current values of watched generators to binary time series file
+     * @param time current simulation time
+     */
+    void writeGeneratorSeries(double time);
+
     /**
      * Open file (specified in input deck) to write load results to.
      * Data from loads specified in input deck will be
@@ -366,10 +386,32 @@ class DSFullApp
     // Frequency deviations for simulation are okay
     bool p_frequencyOK;
 
+    // Snapshot file for network (including generator parameters) and flag
+    // indicating that network was restored from snapshot
+    std::string p_snapshot;
+    bool p_restored;
+    boost::shared_ptr<gridpack::network::NetworkSnapshot<DSFullNetwork> >
+      p_snap;
+
+    // Flag indicating that text output is written from a background thread
+    bool p_asyncIO;
+
+    // Flag indicating that generators of the same type are integrated
+    // together in batches
+    bool p_batchGenerators;
+
     // pointer to bus IO module that is used for generator results
     boost::shared_ptr<gridpack::serial_io::SerialBusIO<DSFullNetwork> >
       p_generatorIO;
 
+    // binary time series file used for generator results instead of
+    // p_generatorIO if generatorWatchFormat is binary
+    boost::shared_ptr<gridpack::serial_io::TimeSeriesWriter>
+      p_generatorSeries;
+
+    // local indices of active buses that contribute to p_generatorSeries
+    std::vector<int> p_series_buses;
+
     // Flag indicating that loads are to be monitored
     bool p_loadWatch;
 
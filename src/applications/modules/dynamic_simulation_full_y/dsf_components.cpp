@@ -22,6 +22,7 @@
 
 #include "boost/smart_ptr/shared_ptr.hpp"
 #include "gridpack/parser/dictionary.hpp"
+#include "gridpack/utilities/string_utils.hpp"
 #include "dsf_components.hpp"
 #include "lvshbl.hpp"
 
@@ -414,6 +415,8 @@ void gridpack::dynamic_simulation::DSFullBus::predictor_currentInjection(bool fl
 	//if (!p_generators[i]->getGenStatus()) {
 	//	continue;
 	//}
+    // generators in a batch are integrated by the factory
+    if (p_generators[i]->getBatch() != NULL) continue;
     p_generators[i]->predictor_currentInjection(flag);
   }
   
@@ -494,6 +497,7 @@ void gridpack::dynamic_simulation::DSFullBus::predictor(double t_inc, bool flag)
 	//if (!p_generators[i]->getGenStatus()) {
 	//	continue;
 	//}
+    if (p_generators[i]->getBatch() != NULL) continue;
     p_generators[i]->predictor(t_inc,flag);
   }
   
@@ -520,6 +524,7 @@ void gridpack::dynamic_simulation::DSFullBus::corrector_currentInjection(bool fl
 	//if (!p_generators[i]->getGenStatus()) {
 	//	continue
 	//}  
+    if (p_generators[i]->getBatch() != NULL) continue;
     p_generators[i]->corrector_currentInjection(flag);
   }
   
@@ -596,6 +601,7 @@ void gridpack::dynamic_simulation::DSFullBus::corrector(double t_inc, bool flag)
 	//if (!p_generators[i]->getGenStatus()) {
 	//	continue;
 	//}
+    if (p_generators[i]->getBatch() != NULL) continue;
     p_generators[i]->corrector(t_inc,flag);
   }
   
@@ -714,6 +720,86 @@ gridpack::ComplexType gridpack::dynamic_simulation::DSFullBus::getYBus(void)
   return YMBus::getYBus();
 }
 
+/**
+ * Relative cost of integrating a dynamic model. This is roughly the number of
+ * state variables in the model
+ * @param model name of model
+ * @return cost estimate
+ */
+static int modelCost(std::string model)
+{
+  gridpack::utility::StringUtils util;
+  std::string type = util.trimQuotes(model);
+  util.toUpper(type);
+  if (type == "GENCLS") return 2;
+  if (type == "GENSAL") return 5;
+  if (type == "GENROU") return 6;
+  if (type == "EXDC1" || type == "ESST1A" || type == "ESST4B") return 4;
+  if (type == "WSIEG1" || type == "WSHYGP") return 5;
+  if (type == "GGOV1") return 10;
+  if (type == "PSSSIM") return 3;
+  if (type == "IEEL") return 1;
+  if (type == "MOTORW" || type == "CIM6BL") return 4;
+  if (type == "ACMTBLU1") return 5;
+  return 4;
+}
+
+/**
+ * Estimate the cost of the bus from the dynamic models (generators,
+ * exciters, governors, stabilizers, relays and dynamic loads) listed in
+ * the DataCollection object. This is used to weight buses when the
+ * network is partitioned
+ * @param data: DataCollection object for this bus
+ * @param rows: number of rows contributed to the Y-matrix
+ * @param work: estimate of the work done by the bus in each time step
+ */
+void gridpack::dynamic_simulation::DSFullBus::estimateCost(
+  const boost::shared_ptr<gridpack::component::DataCollection> &data,
+  int *rows, int *work)
+{
+  int i, ngen, nrelay, nload;
+  std::string model;
+  *rows = 1;
+  *work = 1;
+  // Only generators that are created in load contribute
+  ngen = 0;
+  data->getValue(GENERATOR_NUMBER, &ngen);
+  for (i=0; i<ngen; i++) {
+    int stat = 0;
+    double pg = 0.0;
+    data->getValue(GENERATOR_STAT, &stat, i);
+    data->getValue(GENERATOR_PG, &pg, i);
+    if (!data->getValue(GENERATOR_MODEL, &model, i) || stat != 1 || pg < 0)
+      continue;
+    *work += modelCost(model);
+    bool flag = false;
+    if (data->getValue(HAS_EXCITER, &flag, i) && flag &&
+        data->getValue(EXCITER_MODEL, &model, i)) {
+      *work += modelCost(model);
+    }
+    flag = false;
+    if (data->getValue(HAS_GOVERNOR, &flag, i) && flag &&
+        data->getValue(GOVERNOR_MODEL, &model, i)) {
+      *work += modelCost(model);
+    }
+    flag = false;
+    if (data->getValue(HAS_PSS, &flag, i) && flag &&
+        data->getValue(PSS_MODEL, &model, i)) {
+      *work += modelCost(model);
+    }
+  }
+  nrelay = 0;
+  data->getValue(RELAY_NUMBER, &nrelay);
+  for (i=0; i<nrelay; i++) {
+    if (data->getValue(RELAY_MODEL, &model, i)) *work += 1;
+  }
+  nload = 0;
+  data->getValue(LOAD_NUMBER, &nload);
+  for (i=0; i<nload; i++) {
+    if (data->getValue(LOAD_MODEL, &model, i)) *work += modelCost(model);
+  }
+}
+
 /**
  * Load values stored in DataCollection object into DSFullBus object. The
  * DataCollection object will have been filled when the network was created
@@ -2463,6 +2549,16 @@ std::vector<std::string> gridpack::dynamic_simulation::DSFullBus::getGenerators(
   return p_genid;
 }
 
+/**
+ * Get list of generator models
+ * @return vector of generator models
+ */
+std::vector<boost::shared_ptr<gridpack::dynamic_simulation::BaseGeneratorModel> >
+gridpack::dynamic_simulation::DSFullBus::getGeneratorModels()
+{
+  return p_generators;
+}
+
 /**
  * Get list of load IDs
  * @return vector of generator IDs
@@ -2663,6 +2759,29 @@ void gridpack::dynamic_simulation::DSFullBranch::setYBus(void)
  
 }
 
+/**
+ * Estimate the cost of the branch from the number of relays listed in the
+ * DataCollection object. This is used to weight buses when the network is
+ * partitioned
+ * @param data: DataCollection object for this branch
+ * @param rows: number of rows contributed to the Y-matrix (always 0)
+ * @param work: estimate of the work done by the branch in each time step
+ */
+void gridpack::dynamic_simulation::DSFullBranch::estimateCost(
+  const boost::shared_ptr<gridpack::component::DataCollection> &data,
+  int *rows, int *work)
+{
+  int i, nrelay;
+  std::string model;
+  *rows = 0;
+  *work = 0;
+  nrelay = 0;
+  data->getValue(RELAY_NUMBER, &nrelay);
+  for (i=0; i<nrelay; i++) {
+    if (data->getValue(RELAY_MODEL, &model, i)) *work += 1;
+  }
+}
+
 /**
  * Load values stored in DataCollection object into DSFullBranch object. The
  * DataCollection object will have been filled when the network was created
@@ -184,6 +184,19 @@ class DSFullBus
      *       bus that were read in when network was initialized
      */
     void load(const boost::shared_ptr<gridpack::component::DataCollection> &data);
+
+    /**
+     * Estimate the cost of the bus from the dynamic models (generators,
+     * exciters, governors, stabilizers, relays and dynamic loads) listed in
+     * the DataCollection object. This is used to weight buses when the
+     * network is partitioned
+     * @param data: DataCollection object for this bus
+     * @param rows: number of rows contributed to the Y-matrix
+     * @param work: estimate of the work done by the bus in each time step
+     */
+    void estimateCost(
+        const boost::shared_ptr<gridpack::component::DataCollection> &data,
+        int *rows, int *work);
 	
  	/**
      * load parameters for the extended buses from composite load model
@@ -452,6 +465,12 @@ class DSFullBus
      */
     std::vector<std::string> getGenerators();
 
+    /**
+     * Get list of generator models
+     * @return vector of generator models
+     */
+    std::vector<boost::shared_ptr<BaseGeneratorModel> > getGeneratorModels();
+
     /**
      * Get list of load IDs
      * @return vector of load IDs
@@ -684,6 +703,19 @@ class DSFullBranch
      */
     void load(const boost::shared_ptr<gridpack::component::DataCollection> &data);
 
+    /**
+     * Estimate the cost of the branch from the number of relays listed in
+     * the DataCollection object. This is used to weight buses when the
+     * network is partitioned
+     * @param data: DataCollection object for this branch
+     * @param rows: number of rows contributed to the Y-matrix (always 0)
+     * @param work: estimate of the work done by the branch in each time
+     *       step
+     */
+    void estimateCost(
+        const boost::shared_ptr<gridpack::component::DataCollection> &data,
+        int *rows, int *work);
+
     /**
      * Return the complex admittance of the branch
      * @return: complex addmittance of branch
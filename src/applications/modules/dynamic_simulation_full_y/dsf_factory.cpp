@@ -18,6 +18,7 @@
 
 #include <vector>
 #include "boost/smart_ptr/shared_ptr.hpp"
+#include "gridpack/environment/threads.hpp"
 #include "dsf_factory.hpp"
 
 namespace gridpack {
@@ -33,6 +34,7 @@ DSFullFactory::DSFullFactory(DSFullFactory::NetworkPtr network)
   : gridpack::factory::BaseFactory<DSFullNetwork>(network)
 {
   p_network = network;
+  p_batchGenerators = false;
 
   int i;
   p_numBus = p_network->numBuses();
@@ -61,6 +63,7 @@ DSFullFactory::DSFullFactory(DSFullFactory::NetworkPtr network)
  */
 gridpack::dynamic_simulation::DSFullFactory::~DSFullFactory()
 {
+  clearGeneratorBatches();
   delete [] p_buses;
   delete [] p_branches;
 #ifdef USE_FNCS
@@ -167,10 +170,63 @@ void gridpack::dynamic_simulation::DSFullFactory::initDSVect(double ts)
 {
   int i;
 
+  // Generators must be owned by the buses while they are initialized
+  clearGeneratorBatches();
+
   // Invoke initDSVect method on all bus objects
   for (i=0; i<p_numBus; i++) {
     p_buses[i]->initDSVect(ts);
   }
+
+  if (p_batchGenerators) buildGeneratorBatches();
+}
+
+/**
+ * Integrate all generators of the same type together in a batch
+ * @param flag if true, integrate generators in batches
+ */
+void gridpack::dynamic_simulation::DSFullFactory::setGeneratorBatching(
+    bool flag)
+{
+  p_batchGenerators = flag;
+}
+
+/**
+ * Create batches for all generators that can be batched
+ */
+void gridpack::dynamic_simulation::DSFullFactory::buildGeneratorBatches()
+{
+  int i, j, k;
+  gridpack::dynamic_simulation::GeneratorFactory genFactory;
+  std::string models[2] = {"GENROU", "GENSAL"};
+  for (k=0; k<2; k++) {
+    BaseGeneratorBatch *batch = genFactory.createGeneratorBatch(models[k]);
+    for (i=0; i<p_numBus; i++) {
+      std::vector<boost::shared_ptr<BaseGeneratorModel> > generators
+        = p_buses[i]->getGeneratorModels();
+      for (j=0; j<generators.size(); j++) {
+        batch->add(generators[j].get());
+      }
+    }
+    batch->build();
+    if (batch->size() > 0) {
+      p_genBatches.push_back(batch);
+    } else {
+      delete batch;
+    }
+  }
+}
+
+/**
+ * Return generators to the buses and delete all batches
+ */
+void gridpack::dynamic_simulation::DSFullFactory::clearGeneratorBatches()
+{
+  int i;
+  for (i=0; i<p_genBatches.size(); i++) {
+    delete p_genBatches[i];
+  }
+  p_genBatches.clear();
 }
 
 /**
@@ -179,10 +235,27 @@ void gridpack::dynamic_simulation::DSFullFactory::initDSVect(double ts)
 void gridpack::dynamic_simulation::DSFullFactory::predictor_currentInjection(bool flag)
 {
   int i;
-
-  // Invoke method on all bus objects
+  gridpack::Threads *threads = gridpack::Threads::instance();
+  int nthreads = threads->numThreads();
+
+  // Invoke method on all bus objects. Each bus only updates its own
+  // generators and loads, so buses can be integrated concurrently
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,GRIDPACK_THREAD_CHUNK) \
+  num_threads(nthreads) if(nthreads > 1)
+#endif
   for (i=0; i<p_numBus; i++) {
-    p_buses[i]->predictor_currentInjection(flag);
+    try {
+      p_buses[i]->predictor_currentInjection(flag);
+    } catch (std::exception &e) {
+      threads->setError(e.what());
+    }
+  }
+  threads->checkError();
+
+  // Generators in batches are skipped by the buses
+  for (i=0; i<p_genBatches.size(); i++) {
+    p_genBatches[i]->predictor_currentInjection(flag);
   }
 }
 
@@ -192,10 +265,24 @@ void gridpack::dynamic_simulation::DSFullFactory::predictor_currentInjection(boo
 void gridpack::dynamic_simulation::DSFullFactory::predictor(double t_inc, bool flag)
 {
   int i;
+  gridpack::Threads *threads = gridpack::Threads::instance();
+  int nthreads = threads->numThreads();
 
   // Invoke updateDSVect method on all bus objects
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,GRIDPACK_THREAD_CHUNK) \
+  num_threads(nthreads) if(nthreads > 1)
+#endif
   for (i=0; i<p_numBus; i++) {
-    p_buses[i]->predictor(t_inc,flag);
+    try {
+      p_buses[i]->predictor(t_inc,flag);
+    } catch (std::exception &e) {
+      threads->setError(e.what());
+    }
+  }
+  threads->checkError();
+  for (i=0; i<p_genBatches.size(); i++) {
+    p_genBatches[i]->predictor(t_inc,flag);
   }
 }
 
@@ -205,10 +292,24 @@ void gridpack::dynamic_simulation::DSFullFactory::predictor(double t_inc, bool f
 void gridpack::dynamic_simulation::DSFullFactory::corrector_currentInjection(bool flag)
 {
   int i;
+  gridpack::Threads *threads = gridpack::Threads::instance();
+  int nthreads = threads->numThreads();
 
   // Invoke method on all bus objects
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,GRIDPACK_THREAD_CHUNK) \
+  num_threads(nthreads) if(nthreads > 1)
+#endif
   for (i=0; i<p_numBus; i++) {
-    p_buses[i]->corrector_currentInjection(flag);
+    try {
+      p_buses[i]->corrector_currentInjection(flag);
+    } catch (std::exception &e) {
+      threads->setError(e.what());
+    }
+  }
+  threads->checkError();
+  for (i=0; i<p_genBatches.size(); i++) {
+    p_genBatches[i]->corrector_currentInjection(flag);
   }
 }
 
@@ -218,10 +319,24 @@ void gridpack::dynamic_simulation::DSFullFactory::corrector_currentInjection(boo
 void gridpack::dynamic_simulation::DSFullFactory::corrector(double t_inc, bool flag)
 {
   int i;
+  gridpack::Threads *threads = gridpack::Threads::instance();
+  int nthreads = threads->numThreads();
 
   // Invoke updateDSVect method on all bus objects
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,GRIDPACK_THREAD_CHUNK) \
+  num_threads(nthreads) if(nthreads > 1)
+#endif
   for (i=0; i<p_numBus; i++) {
-    p_buses[i]->corrector(t_inc,flag);
+    try {
+      p_buses[i]->corrector(t_inc,flag);
+    } catch (std::exception &e) {
+      threads->setError(e.what());
+    }
+  }
+  threads->checkError();
+  for (i=0; i<p_genBatches.size(); i++) {
+    p_genBatches[i]->corrector(t_inc,flag);
   }
 }
 
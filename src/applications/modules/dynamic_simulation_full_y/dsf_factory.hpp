@@ -22,6 +22,7 @@
 #include "boost/smart_ptr/shared_ptr.hpp"
 #include "gridpack/factory/base_factory.hpp"
 #include "dsf_components.hpp"
+#include "base_classes/base_generator_batch.hpp"
 #include <vector>
 
 namespace gridpack {
@@ -75,6 +76,14 @@ class DSFullFactory
      */
     void initDSVect(double ts);
 
+    /**
+     * Integrate all generators of the same type together in a batch
+     * instead of one at a time on each bus. Only GENROU and GENSAL
+     * generators are batched. Takes effect at the next call to initDSVect
+     * @param flag if true, integrate generators in batches
+     */
+    void setGeneratorBatching(bool flag);
+
     /**
      * Update vectors in each integration time step (Predictor)
      */
@@ -236,6 +245,21 @@ class DSFullFactory
     int p_numBranch;
 
     DSFullBranch **p_branches;
+
+    /**
+     * Create batches for all generators that can be batched. Called after
+     * generators have been initialized
+     */
+    void buildGeneratorBatches();
+
+    /**
+     * Return generators to the buses and delete all batches
+     */
+    void clearGeneratorBatches();
+
+    bool p_batchGenerators;
+
+    std::vector<BaseGeneratorBatch*> p_genBatches;
 };
 
 } // dynamic_simulation
@@ -18,6 +18,8 @@
 #include "classical.hpp"
 #include "gensal.hpp"
 #include "genrou.hpp"
+#include "gensal_batch.hpp"
+#include "genrou_batch.hpp"
 #include "wsieg1.hpp"
 #include "exdc1.hpp"
 #include "esst1a.hpp"
@@ -158,3 +160,33 @@ gridpack::dynamic_simulation::GeneratorFactory::createPssModel(
   return ret;
 
 }
+
+/**
+ * Create a batch that integrates all generators of one type together
+ * @param model string containing generator model type
+ * @return pointer to batch. If generator model cannot be batched, then
+ * return NULL pointer
+ */
+gridpack::dynamic_simulation::BaseGeneratorBatch*
+gridpack::dynamic_simulation::GeneratorFactory::createGeneratorBatch(
+    std::string model)
+{
+  std::string type = p_util.trimQuotes(model);
+  p_util.toUpper(type);
+
+  gridpack::dynamic_simulation::BaseGeneratorBatch* ret;
+  if (type == "GENSAL") {
+    gridpack::dynamic_simulation::GensalBatch *tmp;
+    tmp =  new gridpack::dynamic_simulation::GensalBatch;
+    ret =
+      dynamic_cast<gridpack::dynamic_simulation::BaseGeneratorBatch*>(tmp);
+  } else if (type == "GENROU") {
+    gridpack::dynamic_simulation::GenrouBatch *tmp;
+    tmp =  new gridpack::dynamic_simulation::GenrouBatch;
+    ret =
+      dynamic_cast<gridpack::dynamic_simulation::BaseGeneratorBatch*>(tmp);
+  } else {
+    ret = NULL;
+  }
+  return ret;
+}
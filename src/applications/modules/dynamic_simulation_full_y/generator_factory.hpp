@@ -22,6 +22,7 @@
 #include "base_classes/base_exciter_model.hpp"
 #include "base_classes/base_governor_model.hpp"
 #include "base_classes/base_pss_model.hpp"
+#include "base_classes/base_generator_batch.hpp"
 #include "gridpack/utilities/string_utils.hpp"
 
 namespace gridpack {
@@ -71,6 +72,14 @@ class GeneratorFactory
      */
     BasePssModel* createPssModel(std::string model);
 
+    /**
+     * Create a batch that integrates all generators of one type together
+     * @param model string containing generator model type
+     * @return pointer to batch. If generator model cannot be batched, then
+     * return NULL pointer
+     */
+    BaseGeneratorBatch* createGeneratorBatch(std::string model);
+
   private:
 
     gridpack::utility::StringUtils p_util;
@@ -23,6 +23,7 @@
 #include "gridpack/parser/dictionary.hpp"
 #include "base_generator_model.hpp"
 #include "genrou.hpp"
+#include "base_generator_batch.hpp"
 //#include "exdc1.hpp"
 
 /**
@@ -90,7 +91,7 @@ void gridpack::dynamic_simulation::GenrouGenerator::load(
   //printf("load S10 = %f, S12 = %f\n", S10, S12);
   if (!data->getValue(GENERATOR_XQP, &Xqp, idx)) Xqp=0.0; // Xqp
   //if (!data->getValue(GENERATOR_XQPP, &Xqp, idx)) Xqpp=0.0; // Xqpp // SJin: no GENERATOR_XQPP yet
-  if (!data->getValue(GENERATOR_XDPP, &Xqp, idx)) Xqpp=0.0; // Xqpp // SJin: use Xdpp for compile
+  if (!data->getValue(GENERATOR_XDPP, &Xqpp, idx)) Xqpp=0.0; // Xqpp // SJin: use Xdpp for compile
 }
 
 /**
@@ -175,6 +176,7 @@ void gridpack::dynamic_simulation::GenrouGenerator::init(double mag,
  */
 gridpack::ComplexType gridpack::dynamic_simulation::GenrouGenerator::INorton()
 {
+  if (getBatch()) return getBatch()->INorton(getBatchSlot());
   return p_INorton;
 }
 
@@ -414,6 +416,10 @@ void gridpack::dynamic_simulation::GenrouGenerator::corrector(
 void gridpack::dynamic_simulation::GenrouGenerator::setVoltage(
     gridpack::ComplexType voltage)
 {
+  if (getBatch()) {
+    getBatch()->setVoltage(getBatchSlot(), voltage);
+    return;
+  }
   presentMag = abs(voltage);
   presentAng = atan2(imag(voltage), real(voltage));  
 }
@@ -424,6 +430,7 @@ void gridpack::dynamic_simulation::GenrouGenerator::setVoltage(
  */
 double gridpack::dynamic_simulation::GenrouGenerator::getFieldVoltage()
 {
+  if (getBatch()) getBatch()->sync(getBatchSlot());
   return Efd;
 }
 
@@ -435,6 +442,7 @@ double gridpack::dynamic_simulation::GenrouGenerator::getFieldVoltage()
 void gridpack::dynamic_simulation::GenrouGenerator::write(
     const char* signal, char *string)
 {
+  if (getBatch()) getBatch()->sync(getBatchSlot());
   if (!strcmp(signal,"standard")) {
     //sprintf(string,"      %8d            %2s    %12.6f    %12.6f    %12.6f    %12.6f\n",
     //    p_bus_id,p_ckt.c_str(),real(p_mac_ang_s1),real(p_mac_spd_s1),real(p_mech),
@@ -453,6 +461,7 @@ void gridpack::dynamic_simulation::GenrouGenerator::getWatchValues(
     std::vector<double> &vals)
 {
   vals.clear();
+  if (getBatch()) getBatch()->sync(getBatchSlot());
   if (getWatch()) {
     vals.push_back(x1d_1+1.0);
     vals.push_back(x2w_1);
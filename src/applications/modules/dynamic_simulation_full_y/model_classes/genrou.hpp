@@ -22,6 +22,8 @@
 
 namespace gridpack {
 namespace dynamic_simulation {
+class GenrouBatch;
+
 class GenrouGenerator : public BaseGeneratorModel
 {
   public:
@@ -159,6 +161,8 @@ class GenrouGenerator : public BaseGeneratorModel
     std::string p_ckt;
     int p_bus_id;
 
+    friend class GenrouBatch;
+
     friend class boost::serialization::access;
 
     template<class Archive>
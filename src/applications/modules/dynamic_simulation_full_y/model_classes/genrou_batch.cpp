@@ -0,0 +1,379 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -----------------------------------------------------------
+/**
+ * @file   genrou_batch.cpp
+ * @author agent
+ * @Last modified:   October 17, 2026
+ *
+ * @brief
+ *
+ *
+ */
+
+#include <vector>
+#include <cmath>
+
+#include "genrou_batch.hpp"
+
+/**
+ *  Basic constructor
+ */
+gridpack::dynamic_simulation::GenrouBatch::GenrouBatch(void)
+  : BaseGeneratorBatch(F_NFIELD)
+{
+}
+
+/**
+ *  Basic destructor
+ */
+gridpack::dynamic_simulation::GenrouBatch::~GenrouBatch(void)
+{
+  clear();
+}
+
+/**
+ * Add generator to batch if it is a GENROU generator
+ * @param generator generator model
+ * @return true if generator was added to batch
+ */
+bool gridpack::dynamic_simulation::GenrouBatch::add(
+    BaseGeneratorModel *generator)
+{
+  if (dynamic_cast<GenrouGenerator*>(generator) == NULL) return false;
+  p_models.push_back(generator);
+  return true;
+}
+
+/**
+ * Return generator in slot
+ * @param slot location of generator in batch
+ * @return pointer to generator
+ */
+gridpack::dynamic_simulation::GenrouGenerator*
+gridpack::dynamic_simulation::GenrouBatch::generator(int slot)
+{
+  return static_cast<GenrouGenerator*>(p_models[slot]);
+}
+
+/**
+ * Copy parameters and state of one generator into the batch
+ * @param slot location of generator in batch
+ */
+void gridpack::dynamic_simulation::GenrouBatch::load(int slot)
+{
+  GenrouGenerator *gen = generator(slot);
+  field(F_H)[slot] = gen->H;
+  field(F_D)[slot] = gen->D;
+  field(F_Ra)[slot] = gen->Ra;
+  field(F_Xd)[slot] = gen->Xd;
+  field(F_Xq)[slot] = gen->Xq;
+  field(F_Xdp)[slot] = gen->Xdp;
+  field(F_Xdpp)[slot] = gen->Xdpp;
+  field(F_Xl)[slot] = gen->Xl;
+  field(F_Xqp)[slot] = gen->Xqp;
+  field(F_Xqpp)[slot] = gen->Xqpp;
+  field(F_Tdop)[slot] = gen->Tdop;
+  field(F_Tdopp)[slot] = gen->Tdopp;
+  field(F_Tqopp)[slot] = gen->Tqopp;
+  // Coefficients of saturation function (see GenrouGenerator::Sat)
+  double a_ = gen->S12 / gen->S10 - 1.0 / 1.2;
+  double b_ = -2 * gen->S12 / gen->S10 + 2;
+  double c_ = gen->S12 / gen->S10 - 1.2;
+  double A = (-b_ - sqrt(b_ * b_ - 4 * a_ * c_)) / (2 * a_);
+  field(F_SatA)[slot] = A;
+  field(F_SatB)[slot] = gen->S10 / ((1.0 - A) * (1.0 - A));
+  field(F_MVABase)[slot] = gen->MVABase;
+  field(F_Sbase)[slot] = gen->p_sbase;
+
+  double x[24] = {gen->x1d, gen->x2w, gen->x3Eqp, gen->x4Psidp,
+    gen->x5Psiqp, gen->x6Edp, gen->x1d_1, gen->x2w_1, gen->x3Eqp_1,
+    gen->x4Psidp_1, gen->x5Psiqp_1, gen->x6Edp_1, gen->dx1d, gen->dx2w,
+    gen->dx3Eqp, gen->dx4Psidp, gen->dx5Psiqp, gen->dx6Edp, gen->dx1d_1,
+    gen->dx2w_1, gen->dx3Eqp_1, gen->dx4Psidp_1, gen->dx5Psiqp_1,
+    gen->dx6Edp_1};
+  int i;
+  for (i=0; i<24; i++) field(F_X1d+i)[slot] = x[i];
+  field(F_Id)[slot] = gen->Id;
+  field(F_Iq)[slot] = gen->Iq;
+  field(F_Efd)[slot] = gen->Efd;
+  field(F_LadIfd)[slot] = gen->LadIfd;
+  field(F_Pmech)[slot] = gen->Pmech;
+  p_mag[slot] = gen->presentMag;
+  p_ang[slot] = gen->presentAng;
+  p_IrNorton[slot] = real(gen->p_INorton);
+  p_IiNorton[slot] = imag(gen->p_INorton);
+}
+
+/**
+ * Copy state of one generator from the batch back to the generator
+ * object
+ * @param slot location of generator in batch
+ */
+void gridpack::dynamic_simulation::GenrouBatch::sync(int slot)
+{
+  GenrouGenerator *gen = generator(slot);
+  double *x[24] = {&gen->x1d, &gen->x2w, &gen->x3Eqp, &gen->x4Psidp,
+    &gen->x5Psiqp, &gen->x6Edp, &gen->x1d_1, &gen->x2w_1, &gen->x3Eqp_1,
+    &gen->x4Psidp_1, &gen->x5Psiqp_1, &gen->x6Edp_1, &gen->dx1d,
+    &gen->dx2w, &gen->dx3Eqp, &gen->dx4Psidp, &gen->dx5Psiqp, &gen->dx6Edp,
+    &gen->dx1d_1, &gen->dx2w_1, &gen->dx3Eqp_1, &gen->dx4Psidp_1,
+    &gen->dx5Psiqp_1, &gen->dx6Edp_1};
+  int i;
+  for (i=0; i<24; i++) *(x[i]) = field(F_X1d+i)[slot];
+  gen->Id = field(F_Id)[slot];
+  gen->Iq = field(F_Iq)[slot];
+  gen->Efd = field(F_Efd)[slot];
+  gen->LadIfd = field(F_LadIfd)[slot];
+  gen->Pmech = field(F_Pmech)[slot];
+  gen->presentMag = p_mag[slot];
+  gen->presentAng = p_ang[slot];
+  gen->Vterm = p_mag[slot];
+  gen->Theta = p_ang[slot];
+  gen->IrNorton = p_IrNorton[slot];
+  gen->IiNorton = p_IiNorton[slot];
+  gen->p_INorton = gridpack::ComplexType(p_IrNorton[slot],p_IiNorton[slot]);
+}
+
+/**
+ * Calculate current injections for all generators
+ * @param rotor index of first of the rotor angle and speed variables
+ * @param flux index of the set of state variables that the fluxes are
+ *        taken from
+ */
+void gridpack::dynamic_simulation::GenrouBatch::currentInjection(int rotor,
+    int flux)
+{
+  int k;
+  const double *Ra = field(F_Ra);
+  const double *Xdp = field(F_Xdp);
+  const double *Xdpp = field(F_Xdpp);
+  const double *Xl = field(F_Xl);
+  const double *Xqp = field(F_Xqp);
+  const double *Xqpp = field(F_Xqpp);
+  const double *MVABase = field(F_MVABase);
+  const double *Sbase = field(F_Sbase);
+  const double *x1d = field(rotor);
+  const double *x2w = field(rotor+1);
+  const double *x3Eqp = field(flux+2);
+  const double *x4Psidp = field(flux+3);
+  const double *x5Psiqp = field(flux+4);
+  const double *x6Edp = field(flux+5);
+  const double *mag = &p_mag[0];
+  const double *ang = &p_ang[0];
+  double *Id = field(F_Id);
+  double *Iq = field(F_Iq);
+  double *IrNorton = &p_IrNorton[0];
+  double *IiNorton = &p_IiNorton[0];
+  for (k=0; k<p_size; k++) {
+    // Admittance
+    double B = -Xdpp[k] / (Ra[k] * Ra[k] + Xdpp[k] * Xdpp[k]);
+    double G = Ra[k] / (Ra[k] * Ra[k] + Xdpp[k] * Xdpp[k]);
+    double Psiqpp = - x6Edp[k] * (Xqpp[k] - Xl[k]) / (Xqp[k] - Xl[k])
+      - x5Psiqp[k] * (Xqp[k] - Xqpp[k]) / (Xqp[k] - Xl[k]);
+    double Psidpp = + x3Eqp[k] * (Xdpp[k] - Xl[k]) / (Xdp[k] - Xl[k])
+      + x4Psidp[k] * (Xdp[k] - Xdpp[k]) / (Xdp[k] - Xl[k]);
+    double Vd = - Psiqpp * (1 + x2w[k]);
+    double Vq = + Psidpp * (1 + x2w[k]);
+    double Vrterm = mag[k] * cos(ang[k]);
+    double Viterm = mag[k] * sin(ang[k]);
+    double sind = sin(x1d[k]);
+    double cosd = cos(x1d[k]);
+    double Vdterm = Vrterm * sind - Viterm * cosd;
+    double Vqterm = Vrterm * cosd + Viterm * sind;
+    //DQ Axis
+    Id[k] = (Vd - Vdterm) * G - (Vq - Vqterm) * B;
+    Iq[k] = (Vd - Vdterm) * B + (Vq - Vqterm) * G;
+    double Idnorton = Vd * G - Vq * B;
+    double Iqnorton = Vd * B + Vq * G;
+    //Network
+    double Ir = + Idnorton * sind + Iqnorton * cosd;
+    double Ii = - Idnorton * cosd + Iqnorton * sind;
+    IrNorton[k] = Ir * MVABase[k] / Sbase[k];
+    IiNorton[k] = Ii * MVABase[k] / Sbase[k];
+  }
+}
+
+/**
+ * Evaluate derivatives of state variables for all generators
+ * @param state index of first state variable
+ * @param deriv index of first derivative
+ */
+void gridpack::dynamic_simulation::GenrouBatch::derivatives(int state,
+    int deriv)
+{
+  int k;
+  double pi = 4.0*atan(1.0);
+  const double *H = field(F_H);
+  const double *D = field(F_D);
+  const double *Xd = field(F_Xd);
+  const double *Xq = field(F_Xq);
+  const double *Xdp = field(F_Xdp);
+  const double *Xdpp = field(F_Xdpp);
+  const double *Xl = field(F_Xl);
+  const double *Xqp = field(F_Xqp);
+  const double *Xqpp = field(F_Xqpp);
+  const double *Tdop = field(F_Tdop);
+  const double *Tdopp = field(F_Tdopp);
+  const double *Tqopp = field(F_Tqopp);
+  const double *SatA = field(F_SatA);
+  const double *SatB = field(F_SatB);
+  const double *Id = field(F_Id);
+  const double *Iq = field(F_Iq);
+  const double *Efd = field(F_Efd);
+  const double *Pmech = field(F_Pmech);
+  const double *x2w = field(state+1);
+  const double *x3Eqp = field(state+2);
+  const double *x4Psidp = field(state+3);
+  const double *x5Psiqp = field(state+4);
+  const double *x6Edp = field(state+5);
+  double *LadIfd = field(F_LadIfd);
+  double *dx1d = field(deriv);
+  double *dx2w = field(deriv+1);
+  double *dx3Eqp = field(deriv+2);
+  double *dx4Psidp = field(deriv+3);
+  double *dx5Psiqp = field(deriv+4);
+  double *dx6Edp = field(deriv+5);
+  for (k=0; k<p_size; k++) {
+    double Psiqpp = - x6Edp[k] * (Xqpp[k] - Xl[k]) / (Xqp[k] - Xl[k])
+      - x5Psiqp[k] * (Xqp[k] - Xqpp[k]) / (Xqp[k] - Xl[k]);
+    double Psidpp = + x3Eqp[k] * (Xdpp[k] - Xl[k]) / (Xdp[k] - Xl[k])
+      + x4Psidp[k] * (Xdp[k] - Xdpp[k]) / (Xdp[k] - Xl[k]);
+    double Telec = Psidpp * Iq[k] - Psiqpp * Id[k];
+    double TempD = (Xdp[k] - Xdpp[k]) / ((Xdp[k] - Xl[k]) * (Xdp[k] - Xl[k]))
+      * (-x4Psidp[k] - (Xdp[k] - Xl[k]) * Id[k] + x3Eqp[k]);
+    double Sat = SatB[k] * (x3Eqp[k] - SatA[k]) * (x3Eqp[k] - SatA[k])
+      / x3Eqp[k];
+    LadIfd[k] = x3Eqp[k] * (1 + Sat) + (Xd[k] - Xdp[k]) * (Id[k] + TempD);
+    dx1d[k] = x2w[k] * 2 * pi * 60;
+    dx2w[k] = 1 / (2 * H[k]) * ((Pmech[k] - D[k] * x2w[k]) / (1 + x2w[k])
+        - Telec);
+    dx3Eqp[k] = (Efd[k] - LadIfd[k]) / Tdop[k];
+    dx4Psidp[k] = (-x4Psidp[k] - (Xdp[k] - Xl[k]) * Id[k] + x3Eqp[k])
+      / Tdopp[k];
+    dx5Psiqp[k] = (-x5Psiqp[k] + (Xqp[k] - Xl[k]) * Iq[k] + x6Edp[k])
+      / Tqopp[k];
+    double TempQ = (Xqp[k] - Xqpp[k]) / ((Xqp[k] - Xl[k]) * (Xqp[k] - Xl[k]))
+      * (-x5Psiqp[k] + (Xqp[k] - Xl[k]) * Iq[k] + x6Edp[k]);
+    dx6Edp[k] = (-x6Edp[k] + (Xq[k] - Xqp[k]) * (Iq[k] - TempQ)) / Tqopp[k];
+  }
+}
+
+/**
+ * Calculate current injections for all generators (predictor)
+ * @param flag initial step if true
+ */
+void gridpack::dynamic_simulation::GenrouBatch::predictor_currentInjection(
+    bool flag)
+{
+  if (p_size == 0) return;
+  int i, k;
+  if (!flag) {
+    for (i=0; i<6; i++) {
+      double *x = field(F_X1d+i);
+      const double *x_1 = field(F_X1d_1+i);
+      for (k=0; k<p_size; k++) x[k] = x_1[k];
+    }
+  }
+  currentInjection(F_X1d, F_X1d);
+}
+
+/**
+ * Predict new state variables of all generators for time step
+ * @param t_inc time step increment
+ * @param flag initial step if true
+ */
+void gridpack::dynamic_simulation::GenrouBatch::predictor(double t_inc,
+    bool flag)
+{
+  if (p_size == 0) return;
+  int i, k;
+  double *Efd = field(F_Efd);
+  double *Pmech = field(F_Pmech);
+  for (k=0; k<p_size; k++) {
+    if (p_exciters[k]) Efd[k] = p_exciters[k]->getFieldVoltage();
+    if (p_governors[k]) Pmech[k] = p_governors[k]->getMechanicalPower();
+  }
+  if (!flag) {
+    for (i=0; i<6; i++) {
+      double *x = field(F_X1d+i);
+      const double *x_1 = field(F_X1d_1+i);
+      for (k=0; k<p_size; k++) x[k] = x_1[k];
+    }
+  }
+  derivatives(F_X1d, F_DX1d);
+  for (i=0; i<6; i++) {
+    const double *x = field(F_X1d+i);
+    const double *dx = field(F_DX1d+i);
+    double *x_1 = field(F_X1d_1+i);
+    for (k=0; k<p_size; k++) x_1[k] = x[k] + dx[k] * t_inc;
+  }
+  const double *x2w = field(F_X2w);
+  const double *x2w_1 = field(F_X2w_1);
+  for (k=0; k<p_size; k++) {
+    if (p_exciters[k]) {
+      p_exciters[k]->setOmega(x2w_1[k]);
+      p_exciters[k]->setVterminal(p_mag[k]);
+      p_exciters[k]->predictor(t_inc, flag);
+    }
+    if (p_governors[k]) {
+      p_governors[k]->setRotorSpeedDeviation(x2w[k]);
+      p_governors[k]->predictor(t_inc, flag);
+    }
+  }
+}
+
+/**
+ * Calculate current injections for all generators (corrector). As in
+ * GenrouGenerator, the fluxes from the start of the step are used with the
+ * predicted rotor angle and speed
+ * @param flag initial step if true
+ */
+void gridpack::dynamic_simulation::GenrouBatch::corrector_currentInjection(
+    bool flag)
+{
+  if (p_size == 0) return;
+  currentInjection(F_X1d_1, F_X1d);
+}
+
+/**
+ * Correct state variables of all generators for time step
+ * @param t_inc time step increment
+ * @param flag initial step if true
+ */
+void gridpack::dynamic_simulation::GenrouBatch::corrector(double t_inc,
+    bool flag)
+{
+  if (p_size == 0) return;
+  int i, k;
+  double *Efd = field(F_Efd);
+  double *Pmech = field(F_Pmech);
+  for (k=0; k<p_size; k++) {
+    if (p_exciters[k]) Efd[k] = p_exciters[k]->getFieldVoltage();
+    if (p_governors[k]) Pmech[k] = p_governors[k]->getMechanicalPower();
+  }
+  derivatives(F_X1d_1, F_DX1d_1);
+  for (i=0; i<6; i++) {
+    const double *x = field(F_X1d+i);
+    const double *dx = field(F_DX1d+i);
+    const double *dx_1 = field(F_DX1d_1+i);
+    double *x_1 = field(F_X1d_1+i);
+    for (k=0; k<p_size; k++) x_1[k] = x[k] + (dx[k] + dx_1[k]) / 2.0 * t_inc;
+  }
+  const double *x2w = field(F_X2w);
+  const double *x2w_1 = field(F_X2w_1);
+  for (k=0; k<p_size; k++) {
+    if (p_exciters[k]) {
+      p_exciters[k]->setOmega(x2w_1[k]);
+      p_exciters[k]->setVterminal(p_mag[k]);
+      p_exciters[k]->corrector(t_inc, flag);
+    }
+    if (p_governors[k]) {
+      p_governors[k]->setRotorSpeedDeviation(x2w[k]);
+      p_governors[k]->corrector(t_inc, flag);
+    }
+  }
+}
@@ -0,0 +1,129 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   genrou_batch.hpp
+ * @author agent
+ * @Last modified:   October 17, 2026
+ *
+ * @brief
+ * Integrates all GENROU generators on a processor together. The equations
+ * are the same as in GenrouGenerator.
+ *
+ */
+
+#ifndef _genrou_batch_h_
+#define _genrou_batch_h_
+
+#include <vector>
+#include "base_generator_batch.hpp"
+#include "genrou.hpp"
+
+namespace gridpack {
+namespace dynamic_simulation {
+class GenrouBatch : public BaseGeneratorBatch
+{
+  public:
+    /**
+     * Basic constructor
+     */
+    GenrouBatch();
+
+    /**
+     * Basic destructor
+     */
+    virtual ~GenrouBatch();
+
+    /**
+     * Add generator to batch if it is a GENROU generator
+     * @param generator generator model
+     * @return true if generator was added to batch
+     */
+    bool add(BaseGeneratorModel *generator);
+
+    /**
+     * Copy state of one generator from the batch back to the generator
+     * object
+     * @param slot location of generator in batch
+     */
+    void sync(int slot);
+
+    /**
+     * Calculate current injections for all generators (predictor)
+     * @param flag initial step if true
+     */
+    void predictor_currentInjection(bool flag);
+
+    /**
+     * Predict new state variables of all generators for time step
+     * @param t_inc time step increment
+     * @param flag initial step if true
+     */
+    void predictor(double t_inc, bool flag);
+
+    /**
+     * Calculate current injections for all generators (corrector)
+     * @param flag initial step if true
+     */
+    void corrector_currentInjection(bool flag);
+
+    /**
+     * Correct state variables of all generators for time step
+     * @param t_inc time step increment
+     * @param flag initial step if true
+     */
+    void corrector(double t_inc, bool flag);
+
+  protected:
+
+    /**
+     * Copy parameters and state of one generator into the batch
+     * @param slot location of generator in batch
+     */
+    void load(int slot);
+
+  private:
+
+    /**
+     * Return generator in slot
+     * @param slot location of generator in batch
+     * @return pointer to generator
+     */
+    GenrouGenerator* generator(int slot);
+
+    /**
+     * Calculate current injections for all generators
+     * @param rotor index of first of the rotor angle and speed variables
+     *        used to evaluate currents (F_X1d or F_X1d_1)
+     * @param flux index of the set of state variables that the fluxes are
+     *        taken from (F_X1d or F_X1d_1)
+     */
+    void currentInjection(int rotor, int flux);
+
+    /**
+     * Evaluate derivatives of state variables for all generators
+     * @param state index of first state variable (F_X1d or F_X1d_1)
+     * @param deriv index of first derivative (F_DX1d or F_DX1d_1)
+     */
+    void derivatives(int state, int deriv);
+
+    // index of each variable in batch. State variables x1d..x6Edp are
+    // stored consecutively for each of the four sets of state variables
+    enum {
+      F_H, F_D, F_Ra, F_Xd, F_Xq, F_Xdp, F_Xdpp, F_Xl, F_Xqp, F_Xqpp,
+      F_Tdop, F_Tdopp, F_Tqopp,
+      F_SatA, F_SatB, F_MVABase, F_Sbase,
+      F_X1d, F_X2w, F_X3Eqp, F_X4Psidp, F_X5Psiqp, F_X6Edp,
+      F_X1d_1, F_X2w_1, F_X3Eqp_1, F_X4Psidp_1, F_X5Psiqp_1, F_X6Edp_1,
+      F_DX1d, F_DX2w, F_DX3Eqp, F_DX4Psidp, F_DX5Psiqp, F_DX6Edp,
+      F_DX1d_1, F_DX2w_1, F_DX3Eqp_1, F_DX4Psidp_1, F_DX5Psiqp_1, F_DX6Edp_1,
+      F_Id, F_Iq, F_Efd, F_LadIfd, F_Pmech,
+      F_NFIELD
+    };
+};
+}  // dynamic_simulation
+}  // gridpack
+#endif
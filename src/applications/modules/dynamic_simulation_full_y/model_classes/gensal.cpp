@@ -23,6 +23,7 @@
 #include "gridpack/parser/dictionary.hpp"
 #include "base_generator_model.hpp"
 #include "gensal.hpp"
+#include "base_generator_batch.hpp"
 //#include "exdc1.hpp"
 
 /**
@@ -220,6 +221,7 @@ void gridpack::dynamic_simulation::GensalGenerator::init(double mag,
  */
 gridpack::ComplexType gridpack::dynamic_simulation::GensalGenerator::INorton()
 {
+  if (getBatch()) return getBatch()->INorton(getBatchSlot());
   return p_INorton;
 }
 
@@ -567,6 +569,10 @@ void gridpack::dynamic_simulation::GensalGenerator::setWideAreaFreqforPSS(double
 void gridpack::dynamic_simulation::GensalGenerator::setVoltage(
     gridpack::ComplexType voltage)
 {
+  if (getBatch()) {
+    getBatch()->setVoltage(getBatchSlot(), voltage);
+    return;
+  }
   presentMag = abs(voltage);
   presentAng = atan2(imag(voltage), real(voltage));  
 }
@@ -577,6 +583,7 @@ void gridpack::dynamic_simulation::GensalGenerator::setVoltage(
  */
 double gridpack::dynamic_simulation::GensalGenerator::getFieldVoltage()
 {
+  if (getBatch()) getBatch()->sync(getBatchSlot());
   return Efd;
 }
 
@@ -588,6 +595,7 @@ double gridpack::dynamic_simulation::GensalGenerator::getFieldVoltage()
 bool gridpack::dynamic_simulation::GensalGenerator::serialWrite(
     char* string, const int bufsize, const char *signal)
 {
+  if (getBatch()) getBatch()->sync(getBatchSlot());
   if (!strcmp(signal,"standard")) {
     //sprintf(string,"      %8d            %2s    %12.6f    %12.6f    %12.6f    %12.6f\n",
     //    p_bus_id,p_ckt.c_str(),real(p_mac_ang_s1),real(p_mac_spd_s1),real(p_mech),
@@ -633,6 +641,7 @@ void gridpack::dynamic_simulation::GensalGenerator::getWatchValues(
     std::vector<double> &vals)
 {
   vals.clear();
+  if (getBatch()) getBatch()->sync(getBatchSlot());
   if (getWatch()) {
     vals.push_back(x1d_1);
     vals.push_back(x2w_1+1.0);
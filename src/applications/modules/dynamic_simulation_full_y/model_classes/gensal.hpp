@@ -22,6 +22,8 @@
 
 namespace gridpack {
 namespace dynamic_simulation {
+class GensalBatch;
+
 class GensalGenerator : public BaseGeneratorModel
 {
   public:
@@ -170,6 +172,8 @@ class GensalGenerator : public BaseGeneratorModel
     std::string p_ckt;
     int p_bus_id;
 
+    friend class GensalBatch;
+
     friend class boost::serialization::access;
 
     template<class Archive>
@@ -0,0 +1,439 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -----------------------------------------------------------
+/**
+ * @file   gensal_batch.cpp
+ * @author agent
+ * @Last modified:   October 17, 2026
+ *
+ * @brief
+ *
+ *
+ */
+
+#include <vector>
+#include <cmath>
+
+#include "gensal_batch.hpp"
+
+/**
+ *  Basic constructor
+ */
+gridpack::dynamic_simulation::GensalBatch::GensalBatch(void)
+  : BaseGeneratorBatch(F_NFIELD)
+{
+}
+
+/**
+ *  Basic destructor
+ */
+gridpack::dynamic_simulation::GensalBatch::~GensalBatch(void)
+{
+  clear();
+}
+
+/**
+ * Add generator to batch if it is a GENSAL generator
+ * @param generator generator model
+ * @return true if generator was added to batch
+ */
+bool gridpack::dynamic_simulation::GensalBatch::add(
+    BaseGeneratorModel *generator)
+{
+  if (dynamic_cast<GensalGenerator*>(generator) == NULL) return false;
+  p_models.push_back(generator);
+  return true;
+}
+
+/**
+ * Return generator in slot
+ * @param slot location of generator in batch
+ * @return pointer to generator
+ */
+gridpack::dynamic_simulation::GensalGenerator*
+gridpack::dynamic_simulation::GensalBatch::generator(int slot)
+{
+  return static_cast<GensalGenerator*>(p_models[slot]);
+}
+
+/**
+ * Copy parameters and state of one generator into the batch
+ * @param slot location of generator in batch
+ */
+void gridpack::dynamic_simulation::GensalBatch::load(int slot)
+{
+  GensalGenerator *gen = generator(slot);
+  field(F_H)[slot] = gen->H;
+  field(F_D)[slot] = gen->D;
+  field(F_Ra)[slot] = gen->Ra;
+  field(F_Xd)[slot] = gen->Xd;
+  field(F_Xq)[slot] = gen->Xq;
+  field(F_Xdp)[slot] = gen->Xdp;
+  field(F_Xdpp)[slot] = gen->Xdpp;
+  field(F_Xl)[slot] = gen->Xl;
+  field(F_Tdop)[slot] = gen->Tdop;
+  field(F_Tdopp)[slot] = gen->Tdopp;
+  field(F_Tqopp)[slot] = gen->Tqopp;
+  // Coefficients of saturation function (see GensalGenerator::Sat)
+  double a_ = gen->S12 / gen->S10 - 1.0 / 1.2;
+  double b_ = -2 * gen->S12 / gen->S10 + 2;
+  double c_ = gen->S12 / gen->S10 - 1.2;
+  double A = (-b_ - sqrt(b_ * b_ - 4 * a_ * c_)) / (2 * a_);
+  field(F_SatA)[slot] = A;
+  field(F_SatB)[slot] = gen->S10 / ((1.0 - A) * (1.0 - A));
+  field(F_MVABase)[slot] = gen->MVABase;
+  field(F_Sbase)[slot] = gen->p_sbase;
+  field(F_Efdinit)[slot] = gen->Efdinit;
+  field(F_Pmechinit)[slot] = gen->Pmechinit;
+
+  double x[20] = {gen->x1d_0, gen->x2w_0, gen->x3Eqp_0, gen->x4Psidp_0,
+    gen->x5Psiqpp_0, gen->x1d_1, gen->x2w_1, gen->x3Eqp_1, gen->x4Psidp_1,
+    gen->x5Psiqpp_1, gen->dx1d_0, gen->dx2w_0, gen->dx3Eqp_0,
+    gen->dx4Psidp_0, gen->dx5Psiqpp_0, gen->dx1d_1, gen->dx2w_1,
+    gen->dx3Eqp_1, gen->dx4Psidp_1, gen->dx5Psiqpp_1};
+  int i;
+  for (i=0; i<20; i++) field(F_X1d_0+i)[slot] = x[i];
+  field(F_Id)[slot] = gen->Id;
+  field(F_Iq)[slot] = gen->Iq;
+  field(F_Efd)[slot] = gen->Efd;
+  field(F_LadIfd)[slot] = gen->LadIfd;
+  field(F_Pmech)[slot] = gen->Pmech;
+  field(F_Vstab)[slot] = gen->Vstab;
+  field(F_Vterm)[slot] = gen->Vterm;
+  p_mag[slot] = gen->presentMag;
+  p_ang[slot] = gen->presentAng;
+  p_IrNorton[slot] = real(gen->p_INorton);
+  p_IiNorton[slot] = imag(gen->p_INorton);
+}
+
+/**
+ * Copy state of one generator from the batch back to the generator
+ * object
+ * @param slot location of generator in batch
+ */
+void gridpack::dynamic_simulation::GensalBatch::sync(int slot)
+{
+  GensalGenerator *gen = generator(slot);
+  double *x[20] = {&gen->x1d_0, &gen->x2w_0, &gen->x3Eqp_0,
+    &gen->x4Psidp_0, &gen->x5Psiqpp_0, &gen->x1d_1, &gen->x2w_1,
+    &gen->x3Eqp_1, &gen->x4Psidp_1, &gen->x5Psiqpp_1, &gen->dx1d_0,
+    &gen->dx2w_0, &gen->dx3Eqp_0, &gen->dx4Psidp_0, &gen->dx5Psiqpp_0,
+    &gen->dx1d_1, &gen->dx2w_1, &gen->dx3Eqp_1, &gen->dx4Psidp_1,
+    &gen->dx5Psiqpp_1};
+  int i;
+  for (i=0; i<20; i++) *(x[i]) = field(F_X1d_0+i)[slot];
+  gen->Id = field(F_Id)[slot];
+  gen->Iq = field(F_Iq)[slot];
+  gen->Efd = field(F_Efd)[slot];
+  gen->LadIfd = field(F_LadIfd)[slot];
+  gen->Pmech = field(F_Pmech)[slot];
+  gen->Vstab = field(F_Vstab)[slot];
+  gen->Vterm = field(F_Vterm)[slot];
+  gen->Theta = p_ang[slot];
+  gen->presentMag = p_mag[slot];
+  gen->presentAng = p_ang[slot];
+  gen->IrNorton = p_IrNorton[slot];
+  gen->IiNorton = p_IiNorton[slot];
+  gen->p_INorton = gridpack::ComplexType(p_IrNorton[slot],p_IiNorton[slot]);
+}
+
+/**
+ * Calculate current injections for all generators
+ * @param state index of first state variable used to evaluate currents
+ */
+void gridpack::dynamic_simulation::GensalBatch::currentInjection(int state)
+{
+  int k;
+  const double *Ra = field(F_Ra);
+  const double *Xdp = field(F_Xdp);
+  const double *Xdpp = field(F_Xdpp);
+  const double *Xl = field(F_Xl);
+  const double *MVABase = field(F_MVABase);
+  const double *Sbase = field(F_Sbase);
+  const double *x1d = field(state);
+  const double *x2w = field(state+1);
+  const double *x3Eqp = field(state+2);
+  const double *x4Psidp = field(state+3);
+  const double *x5Psiqpp = field(state+4);
+  const double *mag = &p_mag[0];
+  const double *ang = &p_ang[0];
+  const int *status = &p_status[0];
+  double *Id = field(F_Id);
+  double *Iq = field(F_Iq);
+  double *Vterm = field(F_Vterm);
+  double *IrNorton = &p_IrNorton[0];
+  double *IiNorton = &p_IiNorton[0];
+  for (k=0; k<p_size; k++) {
+    // Admittance
+    double B = -Xdpp[k] / (Ra[k] * Ra[k] + Xdpp[k] * Xdpp[k]);
+    double G = Ra[k] / (Ra[k] * Ra[k] + Xdpp[k] * Xdpp[k]);
+    double Psiqpp = x5Psiqpp[k];
+    double Psidpp = + x3Eqp[k] * (Xdpp[k] - Xl[k]) / (Xdp[k] - Xl[k])
+      + x4Psidp[k] * (Xdp[k] - Xdpp[k]) / (Xdp[k] - Xl[k]);
+    double Vd = -Psiqpp * (1 + x2w[k]);
+    double Vq = +Psidpp * (1 + x2w[k]);
+    Vterm[k] = mag[k];
+    double Vrterm = mag[k] * cos(ang[k]);
+    double Viterm = mag[k] * sin(ang[k]);
+    double sind = sin(x1d[k]);
+    double cosd = cos(x1d[k]);
+    double Vdterm = Vrterm * sind - Viterm * cosd;
+    double Vqterm = Vrterm * cosd + Viterm * sind;
+    //DQ Axis
+    Id[k] = (Vd - Vdterm) * G - (Vq - Vqterm) * B;
+    Iq[k] = (Vd - Vdterm) * B + (Vq - Vqterm) * G;
+    double Idnorton = Vd * G - Vq * B;
+    double Iqnorton = Vd * B + Vq * G;
+    //Network
+    double Ir = + Idnorton * sind + Iqnorton * cosd;
+    double Ii = - Idnorton * cosd + Iqnorton * sind;
+    if (status[k]) {
+      IrNorton[k] = Ir * MVABase[k] / Sbase[k];
+      IiNorton[k] = Ii * MVABase[k] / Sbase[k];
+    } else {
+      IrNorton[k] = 0.0;
+      IiNorton[k] = 0.0;
+    }
+  }
+}
+
+/**
+ * Evaluate derivatives of state variables for generators that are in
+ * service
+ * @param state index of first state variable
+ * @param deriv index of first derivative
+ */
+void gridpack::dynamic_simulation::GensalBatch::derivatives(int state,
+    int deriv)
+{
+  int k;
+  double pi = 4.0*atan(1.0);
+  const double *H = field(F_H);
+  const double *D = field(F_D);
+  const double *Xd = field(F_Xd);
+  const double *Xq = field(F_Xq);
+  const double *Xdp = field(F_Xdp);
+  const double *Xdpp = field(F_Xdpp);
+  const double *Xl = field(F_Xl);
+  const double *Tdop = field(F_Tdop);
+  const double *Tdopp = field(F_Tdopp);
+  const double *Tqopp = field(F_Tqopp);
+  const double *SatA = field(F_SatA);
+  const double *SatB = field(F_SatB);
+  const double *Id = field(F_Id);
+  const double *Iq = field(F_Iq);
+  const double *Efd = field(F_Efd);
+  const double *Pmech = field(F_Pmech);
+  const double *x2w = field(state+1);
+  const double *x3Eqp = field(state+2);
+  const double *x4Psidp = field(state+3);
+  const double *x5Psiqpp = field(state+4);
+  const int *status = &p_status[0];
+  double *LadIfd = field(F_LadIfd);
+  double *dx1d = field(deriv);
+  double *dx2w = field(deriv+1);
+  double *dx3Eqp = field(deriv+2);
+  double *dx4Psidp = field(deriv+3);
+  double *dx5Psiqpp = field(deriv+4);
+  for (k=0; k<p_size; k++) {
+    if (!status[k]) continue;
+    double Psiq = x5Psiqpp[k] - Iq[k] * Xdpp[k];
+    double Psidpp = x3Eqp[k] * (Xdpp[k] - Xl[k]) / (Xdp[k] - Xl[k])
+      + x4Psidp[k] * (Xdp[k] - Xdpp[k]) / (Xdp[k] - Xl[k]);
+    double Psid = Psidpp - Id[k] * Xdpp[k];
+    double Telec = Psid * Iq[k] - Psiq * Id[k];
+    double TempD = (Xdp[k] - Xdpp[k]) / ((Xdp[k] - Xl[k]) * (Xdp[k] - Xl[k]))
+      * ((-x4Psidp[k] - (Xdp[k] - Xl[k]) * Id[k] + x3Eqp[k]));
+    double Sat = SatB[k] * (x3Eqp[k] - SatA[k]) * (x3Eqp[k] - SatA[k])
+      / x3Eqp[k];
+    LadIfd[k] = x3Eqp[k] * (1 + Sat) + (Xd[k] - Xdp[k]) * (Id[k] + TempD);
+    dx1d[k] = x2w[k] * 2 * pi * 60;
+    dx2w[k] = 1 / (2 * H[k]) * ((Pmech[k] - D[k] * x2w[k]) / (1 + x2w[k])
+        - Telec);
+    dx3Eqp[k] = (Efd[k] - LadIfd[k]) / Tdop[k];
+    dx4Psidp[k] = (-x4Psidp[k] - (Xdp[k] - Xl[k]) * Id[k] + x3Eqp[k])
+      / Tdopp[k];
+    dx5Psiqpp[k] = (-x5Psiqpp[k] - (Xq[k] - Xdpp[k]) * Iq[k]) / Tqopp[k];
+  }
+}
+
+/**
+ * Get field voltage and mechanical power for generators that are in
+ * service from their exciters and governors
+ */
+void gridpack::dynamic_simulation::GensalBatch::getInputs()
+{
+  int k;
+  double *Efd = field(F_Efd);
+  double *Pmech = field(F_Pmech);
+  const double *Efdinit = field(F_Efdinit);
+  const double *Pmechinit = field(F_Pmechinit);
+  for (k=0; k<p_size; k++) {
+    if (!p_status[k]) continue;
+    if (p_exciters[k]) {
+      Efd[k] = p_exciters[k]->getFieldVoltage();
+    } else {
+      Efd[k] = Efdinit[k];
+    }
+    if (p_governors[k]) {
+      Pmech[k] = p_governors[k]->getMechanicalPower();
+    } else {
+      Pmech[k] = Pmechinit[k];
+    }
+  }
+}
+
+/**
+ * Pass new state to the stabilizers, exciters and governors of generators
+ * that are in service and advance them by one step
+ * @param t_inc time step increment
+ * @param flag initial step if true
+ * @param predict call predictor if true, otherwise call corrector
+ */
+void gridpack::dynamic_simulation::GensalBatch::updateControls(double t_inc,
+    bool flag, bool predict)
+{
+  int k;
+  const double *x2w_0 = field(F_X2w_0);
+  const double *x2w_1 = field(F_X2w_1);
+  const double *LadIfd = field(F_LadIfd);
+  double *Vstab = field(F_Vstab);
+  for (k=0; k<p_size; k++) {
+    if (!p_status[k]) continue;
+    if (p_pss[k]) {
+      p_pss[k]->setOmega(x2w_1[k]);
+      if (predict) {
+        p_pss[k]->predictor(t_inc, flag);
+      } else {
+        p_pss[k]->corrector(t_inc, flag);
+      }
+      Vstab[k] = p_pss[k]->getVstab();
+    } else {
+      Vstab[k] = 0.0;
+    }
+    if (p_exciters[k]) {
+      if (p_pss[k]) p_exciters[k]->setVstab(Vstab[k]);
+      p_exciters[k]->setVterminal(p_mag[k]);
+      p_exciters[k]->setVcomp(p_mag[k]);
+      p_exciters[k]->setFieldCurrent(LadIfd[k]);
+      if (predict) {
+        p_exciters[k]->predictor(t_inc, flag);
+      } else {
+        p_exciters[k]->corrector(t_inc, flag);
+      }
+    }
+    if (p_governors[k]) {
+      p_governors[k]->setRotorSpeedDeviation(x2w_0[k]);
+      if (predict) {
+        p_governors[k]->predictor(t_inc, flag);
+      } else {
+        p_governors[k]->corrector(t_inc, flag);
+      }
+    }
+  }
+}
+
+/**
+ * Set all state variables of generators that are out of service to zero
+ */
+void gridpack::dynamic_simulation::GensalBatch::zeroTripped()
+{
+  int i, k;
+  for (k=0; k<p_size; k++) {
+    if (p_status[k]) continue;
+    for (i=0; i<10; i++) field(F_X1d_0+i)[k] = 0.0;
+  }
+}
+
+/**
+ * Calculate current injections for all generators (predictor)
+ * @param flag initial step if true
+ */
+void gridpack::dynamic_simulation::GensalBatch::predictor_currentInjection(
+    bool flag)
+{
+  if (p_size == 0) return;
+  int i, k;
+  updateStatus();
+  if (!flag) {
+    for (i=0; i<5; i++) {
+      double *x_0 = field(F_X1d_0+i);
+      const double *x_1 = field(F_X1d_1+i);
+      for (k=0; k<p_size; k++) x_0[k] = x_1[k];
+    }
+  }
+  currentInjection(F_X1d_0);
+}
+
+/**
+ * Predict new state variables of all generators for time step
+ * @param t_inc time step increment
+ * @param flag initial step if true
+ */
+void gridpack::dynamic_simulation::GensalBatch::predictor(double t_inc,
+    bool flag)
+{
+  if (p_size == 0) return;
+  int i, k;
+  updateStatus();
+  getInputs();
+  if (!flag) {
+    for (i=0; i<5; i++) {
+      double *x_0 = field(F_X1d_0+i);
+      const double *x_1 = field(F_X1d_1+i);
+      for (k=0; k<p_size; k++) {
+        if (p_status[k]) x_0[k] = x_1[k];
+      }
+    }
+  }
+  derivatives(F_X1d_0, F_DX1d_0);
+  for (i=0; i<5; i++) {
+    const double *x_0 = field(F_X1d_0+i);
+    const double *dx_0 = field(F_DX1d_0+i);
+    double *x_1 = field(F_X1d_1+i);
+    for (k=0; k<p_size; k++) x_1[k] = x_0[k] + dx_0[k] * t_inc;
+  }
+  zeroTripped();
+  updateControls(t_inc, flag, true);
+}
+
+/**
+ * Calculate current injections for all generators (corrector)
+ * @param flag initial step if true
+ */
+void gridpack::dynamic_simulation::GensalBatch::corrector_currentInjection(
+    bool flag)
+{
+  if (p_size == 0) return;
+  updateStatus();
+  currentInjection(F_X1d_1);
+}
+
+/**
+ * Correct state variables of all generators for time step
+ * @param t_inc time step increment
+ * @param flag initial step if true
+ */
+void gridpack::dynamic_simulation::GensalBatch::corrector(double t_inc,
+    bool flag)
+{
+  if (p_size == 0) return;
+  int i, k;
+  updateStatus();
+  getInputs();
+  derivatives(F_X1d_1, F_DX1d_1);
+  for (i=0; i<5; i++) {
+    const double *x_0 = field(F_X1d_0+i);
+    const double *dx_0 = field(F_DX1d_0+i);
+    const double *dx_1 = field(F_DX1d_1+i);
+    double *x_1 = field(F_X1d_1+i);
+    for (k=0; k<p_size; k++) {
+      x_1[k] = x_0[k] + (dx_0[k] + dx_1[k]) / 2.0 * t_inc;
+    }
+  }
+  zeroTripped();
+  updateControls(t_inc, flag, false);
+}
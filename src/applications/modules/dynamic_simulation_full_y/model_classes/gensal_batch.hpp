@@ -0,0 +1,149 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   gensal_batch.hpp
+ * @author agent
+ * @Last modified:   October 17, 2026
+ *
+ * @brief
+ * Integrates all GENSAL generators on a processor together. The equations
+ * are the same as in GensalGenerator.
+ *
+ */
+
+#ifndef _gensal_batch_h_
+#define _gensal_batch_h_
+
+#include <vector>
+#include "base_generator_batch.hpp"
+#include "gensal.hpp"
+
+namespace gridpack {
+namespace dynamic_simulation {
+class GensalBatch : public BaseGeneratorBatch
+{
+  public:
+    /**
+     * Basic constructor
+     */
+    GensalBatch();
+
+    /**
+     * Basic destructor
+     */
+    virtual ~GensalBatch();
+
+    /**
+     * Add generator to batch if it is a GENSAL generator
+     * @param generator generator model
+     * @return true if generator was added to batch
+     */
+    bool add(BaseGeneratorModel *generator);
+
+    /**
+     * Copy state of one generator from the batch back to the generator
+     * object
+     * @param slot location of generator in batch
+     */
+    void sync(int slot);
+
+    /**
+     * Calculate current injections for all generators (predictor)
+     * @param flag initial step if true
+     */
+    void predictor_currentInjection(bool flag);
+
+    /**
+     * Predict new state variables of all generators for time step
+     * @param t_inc time step increment
+     * @param flag initial step if true
+     */
+    void predictor(double t_inc, bool flag);
+
+    /**
+     * Calculate current injections for all generators (corrector)
+     * @param flag initial step if true
+     */
+    void corrector_currentInjection(bool flag);
+
+    /**
+     * Correct state variables of all generators for time step
+     * @param t_inc time step increment
+     * @param flag initial step if true
+     */
+    void corrector(double t_inc, bool flag);
+
+  protected:
+
+    /**
+     * Copy parameters and state of one generator into the batch
+     * @param slot location of generator in batch
+     */
+    void load(int slot);
+
+  private:
+
+    /**
+     * Return generator in slot
+     * @param slot location of generator in batch
+     * @return pointer to generator
+     */
+    GensalGenerator* generator(int slot);
+
+    /**
+     * Calculate current injections for all generators
+     * @param state index of first state variable used to evaluate currents
+     *        (F_X1d_0 or F_X1d_1)
+     */
+    void currentInjection(int state);
+
+    /**
+     * Evaluate derivatives of state variables for generators that are in
+     * service
+     * @param state index of first state variable (F_X1d_0 or F_X1d_1)
+     * @param deriv index of first derivative (F_DX1d_0 or F_DX1d_1)
+     */
+    void derivatives(int state, int deriv);
+
+    /**
+     * Get field voltage and mechanical power for generators that are in
+     * service from their exciters and governors
+     */
+    void getInputs();
+
+    /**
+     * Pass new state to the stabilizers, exciters and governors of
+     * generators that are in service and advance them by one step
+     * @param t_inc time step increment
+     * @param flag initial step if true
+     * @param predict call predictor if true, otherwise call corrector
+     */
+    void updateControls(double t_inc, bool flag, bool predict);
+
+    /**
+     * Set all state variables of generators that are out of service to
+     * zero
+     */
+    void zeroTripped();
+
+    // index of each variable in batch. State variables x1d..x5Psiqpp are
+    // stored consecutively for each of the four sets of state variables
+    enum {
+      F_H, F_D, F_Ra, F_Xd, F_Xq, F_Xdp, F_Xdpp, F_Xl,
+      F_Tdop, F_Tdopp, F_Tqopp,
+      F_SatA, F_SatB, F_MVABase, F_Sbase, F_Efdinit, F_Pmechinit,
+      F_X1d_0, F_X2w_0, F_X3Eqp_0, F_X4Psidp_0, F_X5Psiqpp_0,
+      F_X1d_1, F_X2w_1, F_X3Eqp_1, F_X4Psidp_1, F_X5Psiqpp_1,
+      F_DX1d_0, F_DX2w_0, F_DX3Eqp_0, F_DX4Psidp_0, F_DX5Psiqpp_0,
+      F_DX1d_1, F_DX2w_1, F_DX3Eqp_1, F_DX4Psidp_1, F_DX5Psiqpp_1,
+      F_Id, F_Iq, F_Efd, F_LadIfd, F_Pmech, F_Vstab, F_Vterm,
+      F_NFIELD
+    };
+};
+}  // dynamic_simulation
+}  // gridpack
+#endif
@@ -0,0 +1,225 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+#include <vector>
+#include <cmath>
+
+#define BOOST_TEST_NO_MAIN
+#define BOOST_TEST_ALTERNATIVE_INIT_API
+#include <boost/test/included/unit_test.hpp>
+
+#include "boost/smart_ptr/shared_ptr.hpp"
+#include "gridpack/environment/environment.hpp"
+#include "gridpack/component/data_collection.hpp"
+#include "gridpack/parser/dictionary.hpp"
+#include "base_exciter_model.hpp"
+#include "base_governor_model.hpp"
+#include "base_generator_batch.hpp"
+#include "genrou.hpp"
+#include "genrou_batch.hpp"
+#include "gensal.hpp"
+#include "gensal_batch.hpp"
+
+#define NMACH 4
+#define NSTEPS 20
+#define TSTEP 0.005
+#define TOLERANCE 1.0e-10
+
+namespace gds = gridpack::dynamic_simulation;
+
+// Exciter that lowers the field voltage in proportion to the rotor speed
+// deviation, so that the generators see an exciter response that depends
+// on their state
+class TestExciter : public gds::BaseExciterModel
+{
+  public:
+    TestExciter() : p_efd0(0.0), p_efd(0.0), p_omega(0.0) {}
+    void setFieldVoltage(double fldv) {p_efd0 = fldv; p_efd = fldv;}
+    double getFieldVoltage() {return p_efd;}
+    void setOmega(double omega) {p_omega = omega;}
+    void predictor(double t_inc, bool flag) {p_efd = p_efd0 - 5.0*p_omega;}
+    void corrector(double t_inc, bool flag) {p_efd = p_efd0 - 5.0*p_omega;}
+  private:
+    double p_efd0, p_efd, p_omega;
+};
+
+// Governor with a simple droop on the rotor speed deviation
+class TestGovernor : public gds::BaseGovernorModel
+{
+  public:
+    TestGovernor() : p_pm0(0.0), p_pm(0.0), p_dw(0.0) {}
+    void setMechanicalPower(double pmech) {p_pm0 = pmech; p_pm = pmech;}
+    double getMechanicalPower() {return p_pm;}
+    void setRotorSpeedDeviation(double delta_o) {p_dw = delta_o;}
+    void predictor(double t_inc, bool flag) {p_pm = p_pm0 - 20.0*p_dw;}
+    void corrector(double t_inc, bool flag) {p_pm = p_pm0 - 20.0*p_dw;}
+  private:
+    double p_pm0, p_pm, p_dw;
+};
+
+// Parameters of machine i. The machines differ slightly from each other so
+// that mixing up slots in the batch would be detected
+boost::shared_ptr<gridpack::component::DataCollection> machineData(int i)
+{
+  boost::shared_ptr<gridpack::component::DataCollection>
+    data(new gridpack::component::DataCollection);
+  double x = static_cast<double>(i);
+  data->addValue(BUS_NUMBER, i+1);
+  data->addValue(GENERATOR_ID, "1", 0);
+  data->addValue(GENERATOR_PG, 0.5+0.1*x, 0);
+  data->addValue(GENERATOR_QG, 0.2-0.05*x, 0);
+  data->addValue(GENERATOR_STAT, 1, 0);
+  data->addValue(GENERATOR_MBASE, 100.0, 0);
+  data->addValue(GENERATOR_INERTIA_CONSTANT_H, 3.0+0.5*x, 0);
+  data->addValue(GENERATOR_DAMPING_COEFFICIENT_0, 0.5*x, 0);
+  data->addValue(GENERATOR_RESISTANCE, 0.0025, 0);
+  data->addValue(GENERATOR_XD, 1.8, 0);
+  data->addValue(GENERATOR_XQ, 1.75-0.05*x, 0);
+  data->addValue(GENERATOR_XDP, 0.3, 0);
+  data->addValue(GENERATOR_XQP, 0.55, 0);
+  data->addValue(GENERATOR_XDPP, 0.25, 0);
+  data->addValue(GENERATOR_XL, 0.15, 0);
+  data->addValue(GENERATOR_TDOP, 8.0-0.5*x, 0);
+  data->addValue(GENERATOR_TDOPP, 0.03, 0);
+  data->addValue(GENERATOR_TQOPP, 0.05, 0);
+  data->addValue(GENERATOR_S1, 0.1, 0);
+  data->addValue(GENERATOR_S12, 0.4, 0);
+  return data;
+}
+
+// Terminal voltage of machine i at a time step. The voltage drops for the
+// first few steps to move the machines away from equilibrium
+gridpack::ComplexType voltage(int i, int step)
+{
+  double mag = 1.02-0.01*static_cast<double>(i);
+  double ang = 0.1*static_cast<double>(i);
+  if (step < 5) mag *= 0.7;
+  return gridpack::ComplexType(mag*cos(ang), mag*sin(ang));
+}
+
+void checkClose(double a, double b)
+{
+  BOOST_CHECK_SMALL(a-b, TOLERANCE*(1.0+fabs(a)));
+}
+
+void checkINorton(gds::BaseGeneratorModel *scalar,
+    gds::BaseGeneratorModel *batched)
+{
+  gridpack::ComplexType s = scalar->INorton();
+  gridpack::ComplexType b = batched->INorton();
+  checkClose(real(s), real(b));
+  checkClose(imag(s), imag(b));
+}
+
+// Run the same machines through the scalar models and through a batch for
+// several time steps and check that the current injections and states
+// agree after each stage of the step. Machines with odd indices are
+// only given an exciter and governor if allModels is true
+template <class Generator, class Batch>
+void run(bool allModels)
+{
+  int i, j, step;
+  std::vector<boost::shared_ptr<Generator> > scalar, batched;
+  Batch batch;
+  for (i=0; i<NMACH; i++) {
+    boost::shared_ptr<gridpack::component::DataCollection> data
+      = machineData(i);
+    for (j=0; j<2; j++) {
+      boost::shared_ptr<Generator> gen(new Generator);
+      gen->load(data, 0);
+      gen->setWatch(true);
+      if (allModels || i%2 == 0) {
+        boost::shared_ptr<gds::BaseExciterModel> exciter(new TestExciter);
+        boost::shared_ptr<gds::BaseGovernorModel> governor(new TestGovernor);
+        gen->setExciter(exciter);
+        gen->setGovernor(governor);
+      }
+      gridpack::ComplexType v = voltage(i, NSTEPS);
+      gen->init(abs(v), atan2(imag(v), real(v)), TSTEP);
+      if (j == 0) {
+        scalar.push_back(gen);
+      } else {
+        batched.push_back(gen);
+        BOOST_REQUIRE(batch.add(gen.get()));
+      }
+    }
+  }
+  batch.build();
+  BOOST_REQUIRE_EQUAL(batch.size(), NMACH);
+
+  gridpack::ComplexType inorton0;
+  for (step=0; step<NSTEPS; step++) {
+    bool flag = (step == 0);
+    for (i=0; i<NMACH; i++) {
+      scalar[i]->setVoltage(voltage(i, step));
+      batched[i]->setVoltage(voltage(i, step));
+      scalar[i]->predictor_currentInjection(flag);
+    }
+    batch.predictor_currentInjection(flag);
+    if (flag) inorton0 = scalar[0]->INorton();
+    for (i=0; i<NMACH; i++) {
+      checkINorton(scalar[i].get(), batched[i].get());
+      scalar[i]->predictor(TSTEP, flag);
+    }
+    batch.predictor(TSTEP, flag);
+    for (i=0; i<NMACH; i++) {
+      scalar[i]->corrector_currentInjection(flag);
+    }
+    batch.corrector_currentInjection(flag);
+    for (i=0; i<NMACH; i++) {
+      checkINorton(scalar[i].get(), batched[i].get());
+      scalar[i]->corrector(TSTEP, flag);
+    }
+    batch.corrector(TSTEP, flag);
+    for (i=0; i<NMACH; i++) {
+      std::vector<double> svals, bvals;
+      scalar[i]->getWatchValues(svals);
+      batched[i]->getWatchValues(bvals);
+      BOOST_REQUIRE_EQUAL(svals.size(), bvals.size());
+      for (j=0; j<static_cast<int>(svals.size()); j++) {
+        checkClose(svals[j], bvals[j]);
+      }
+      if (scalar[i]->getExciter()) {
+        checkClose(scalar[i]->getExciter()->getFieldVoltage(),
+            batched[i]->getExciter()->getFieldVoltage());
+        checkClose(scalar[i]->getGovernor()->getMechanicalPower(),
+            batched[i]->getGovernor()->getMechanicalPower());
+      }
+    }
+  }
+
+  // The machines should have moved away from their initial state
+  BOOST_CHECK(abs(scalar[0]->INorton()-inorton0) > 1.0e-6);
+
+  // After the batch is cleared the generators hold the batch state
+  batch.clear();
+  for (i=0; i<NMACH; i++) checkINorton(scalar[i].get(), batched[i].get());
+}
+
+BOOST_AUTO_TEST_SUITE ( TestGeneratorBatch )
+
+BOOST_AUTO_TEST_CASE( TestGenrouBatch )
+{
+  // The scalar GENROU model requires an exciter and a governor
+  run<gds::GenrouGenerator, gds::GenrouBatch>(true);
+}
+
+BOOST_AUTO_TEST_CASE( TestGensalBatch )
+{
+  run<gds::GensalGenerator, gds::GensalBatch>(false);
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+bool init_function(void)
+{
+  return true;
+}
+
+int main (int argc, char **argv) {
+  gridpack::Environment env(argc, argv);
+  int result = ::boost::unit_test::unit_test_main( &init_function, argc, argv );
+  return result;
+}
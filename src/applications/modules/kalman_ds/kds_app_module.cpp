@@ -151,11 +151,15 @@ void gridpack::kalman_filter::KalmanApp::setTimeData(
     data, delta_t_ang, nsteps_ang,
     keys);
   int me = network->communicator().rank();
-  // Create hash distribution object
+  // Create hash distribution object. The magnitude series is normally given
+  // for the same buses as the angle series, so the plan that routes the
+  // angle data is reused for the magnitudes
   gridpack::hash_distr::HashDistribution<KalmanNetwork,double,double>
     hash(network);
+  std::vector<int> plan_keys = keys;
+  int plan = hash.createBusPlan(plan_keys);
   // distribute angle time series data
-  hash.distributeBusValues(keys, data, nsteps_ang);
+  hash.distributeBusValues(plan, keys, data, nsteps_ang);
   int i;
   gridpack::kalman_filter::KalmanBus *bus;
   int ndata = keys.size();
@@ -183,7 +187,14 @@ void gridpack::kalman_filter::KalmanApp::setTimeData(
   }
   p_nsteps = nsteps_ang;
   p_delta_t = delta_t_ang;
-  hash.distributeBusValues(keys, data, nsteps_mag);
+  int changed = (keys != plan_keys) ? 1 : 0;
+  network->communicator().sum(&changed, 1);
+  if (changed > 0) {
+    hash.destroyPlan(plan);
+    plan = hash.createBusPlan(keys);
+  }
+  hash.distributeBusValues(plan, keys, data, nsteps_mag);
+  hash.destroyPlan(plan);
   ndata = keys.size();
   for (i=0; i<ndata; i++) {
     bus = dynamic_cast<gridpack::kalman_filter::KalmanBus*>
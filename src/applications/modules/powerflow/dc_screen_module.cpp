@@ -0,0 +1,506 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   dc_screen_module.cpp
+ * @author agent
+ * @date   2026-10-17
+ *
+ * @brief
+ *
+ *
+ */
+// -------------------------------------------------------------
+
+#include <cmath>
+#include <algorithm>
+#include "dc_screen_module.hpp"
+#include "pf_dense_lu.hpp"
+#include "gridpack/mapper/full_map.hpp"
+#include "gridpack/timer/coarse_timer.hpp"
+
+namespace {
+
+/**
+ * Comparison used to rank contingencies. Contingencies that could not be
+ * screened (negative loading) come first, followed by contingencies in
+ * order of decreasing loading
+ */
+struct LoadingCompare
+{
+  const std::vector<double> &p_loading;
+  LoadingCompare(const std::vector<double> &loading) : p_loading(loading) {}
+  bool operator()(int i, int j) const
+  {
+    double li = p_loading[i];
+    double lj = p_loading[j];
+    if (li < 0.0 && lj >= 0.0) return true;
+    if (lj < 0.0) return false;
+    if (li != lj) return li > lj;
+    return i < j;
+  }
+};
+
+}
+
+/**
+ * Basic constructor
+ */
+gridpack::powerflow::DCScreenModule::DCScreenModule(void)
+{
+  p_threshold = 0.9;
+  p_rateB = false;
+  p_cacheLimit = 256;
+  p_useCount = 0;
+  p_numScreened = 0;
+  p_time = 0.0;
+}
+
+/**
+ * Basic destructor
+ */
+gridpack::powerflow::DCScreenModule::~DCScreenModule(void)
+{
+}
+
+/**
+ * Set up screening calculation. The base case power flow must have been
+ * solved before calling this function
+ * @param network power flow network with a converged base case
+ * @param cursor pointer to block in input deck containing linear solver
+ *        parameters for the factorization of B'
+ */
+void gridpack::powerflow::DCScreenModule::setNetwork(
+    boost::shared_ptr<PFNetwork> &network,
+    gridpack::utility::Configuration::CursorPtr cursor)
+{
+  gridpack::utility::CoarseTimer *timer =
+    gridpack::utility::CoarseTimer::instance();
+  int t_setup = timer->createCategory("DC Screen: Setup");
+  timer->start(t_setup);
+  p_network = network;
+  p_factory.reset(new PFFactoryModule(p_network));
+  p_numScreened = 0;
+  p_time = 0.0;
+  p_dAng.clear();
+  p_dAngIndex.clear();
+  p_dAngKey.clear();
+  p_dAngUse.clear();
+  p_useCount = 0;
+
+  // Store base case flows and ratings for all line elements on active
+  // branches
+  int nbranch = p_network->numBranches();
+  int i, k;
+  p_lineOffset.assign(nbranch+1,0);
+  p_lineTag.clear();
+  p_lineB.clear();
+  p_lineP.clear();
+  p_lineQ.clear();
+  p_lineRate.clear();
+  for (i=0; i<nbranch; i++) {
+    p_lineOffset[i] = p_lineTag.size();
+    if (!p_network->getActiveBranch(i)) continue;
+    gridpack::powerflow::PFBranch *branch =
+      dynamic_cast<gridpack::powerflow::PFBranch*>
+      (p_network->getBranch(i).get());
+    std::vector<std::string> tags = branch->getLineTags();
+    for (k=0; k<tags.size(); k++) {
+      if (!branch->getBranchStatus(tags[k])) continue;
+      double rate;
+      if (p_rateB) {
+        rate = branch->getBranchRatingB(tags[k]);
+        if (rate <= 0.0) rate = branch->getBranchRatingA(tags[k]);
+      } else {
+        rate = branch->getBranchRatingA(tags[k]);
+      }
+      // Lines that are overloaded in the base case are ignored by the
+      // AC violation checks, so do not flag them here
+      if (branch->getIgnore(tags[k])) rate = 0.0;
+      gridpack::ComplexType s = branch->getComplexPower(tags[k]);
+      p_lineTag.push_back(tags[k]);
+      p_lineB.push_back(branch->getDCSusceptance(tags[k]));
+      p_lineP.push_back(real(s));
+      p_lineQ.push_back(imag(s));
+      p_lineRate.push_back(rate);
+    }
+  }
+  p_lineOffset[nbranch] = p_lineTag.size();
+
+  // Set up exchange of DC angles to ghost buses
+  int nbus = p_network->numBuses();
+  std::vector<int> gidx(nbus);
+  std::vector<bool> active(nbus);
+  for (i=0; i<nbus; i++) {
+    gidx[i] = p_network->getGlobalBusIndex(i);
+    active[i] = p_network->getActiveBus(i);
+  }
+  p_busAng.assign(nbus,0.0);
+  p_busAngPtr.resize(nbus);
+  for (i=0; i<nbus; i++) p_busAngPtr[i] = &p_busAng[i];
+  p_angExchange.reset(new gridpack::parallel::GhostExchange(
+        p_network->communicator()));
+  p_angExchange->setup(gidx,active,sizeof(double));
+
+  // Build and factor B'
+  p_factory->setMode(DCFlow);
+  gridpack::mapper::FullMatrixMap<PFNetwork> bMap(p_network);
+  p_solver.reset();
+  p_B = bMap.mapToRealMatrix();
+  p_vMap.reset(new gridpack::mapper::BusVectorMap<PFNetwork>(p_network));
+  p_inj = p_vMap->mapToRealVector();
+  p_ang.reset(p_inj->clone());
+  p_solver.reset(new gridpack::math::RealLinearSolver(*p_B));
+  p_solver->configure(cursor);
+  p_inj->zero();
+  p_inj->ready();
+  p_ang->zero();
+  p_ang->ready();
+  p_solver->solve(*p_inj, *p_ang);
+  timer->stop(t_setup);
+}
+
+/**
+ * Set threshold for flagging contingencies
+ * @param threshold fraction of line rating
+ */
+void gridpack::powerflow::DCScreenModule::setThreshold(double threshold)
+{
+  p_threshold = threshold;
+}
+
+/**
+ * Use rating B instead of rating A when evaluating line loadings
+ * @param flag if true, use rating B
+ */
+void gridpack::powerflow::DCScreenModule::useRateB(bool flag)
+{
+  p_rateB = flag;
+}
+
+/**
+ * Set the maximum number of PTDF columns that are kept
+ * @param nlines maximum number of stored columns
+ */
+void gridpack::powerflow::DCScreenModule::setCacheLimit(int nlines)
+{
+  p_cacheLimit = nlines;
+}
+
+/**
+ * Set injections on the end points of a line
+ * @param from, to original indices of buses at each end of line
+ * @param value injection at from bus
+ */
+void gridpack::powerflow::DCScreenModule::setLineInjection(int from, int to,
+    double value)
+{
+  std::vector<int> lids = p_network->getLocalBranchIndices(from,to);
+  int j;
+  for (j=0; j<lids.size(); j++) {
+    gridpack::powerflow::PFBranch *branch =
+      dynamic_cast<gridpack::powerflow::PFBranch*>
+      (p_network->getBranch(lids[j]).get());
+    dynamic_cast<gridpack::powerflow::PFBus*>(branch->getBus1().get())
+      ->setDCInjection(value);
+    dynamic_cast<gridpack::powerflow::PFBus*>(branch->getBus2().get())
+      ->setDCInjection(-value);
+  }
+}
+
+/**
+ * Return the angle differences across all local branches for a unit flow
+ * on a line
+ * @param from, to original indices of buses at each end of line
+ * @param ckt circuit identifier of line
+ * @return angle differences, indexed by local branch index
+ */
+const std::vector<double>&
+gridpack::powerflow::DCScreenModule::lineSensitivity(int from, int to,
+    const std::string &ckt)
+{
+  std::pair<std::pair<int,int>,std::string> key(std::pair<int,int>(from,to),
+      ckt);
+  std::map<std::pair<std::pair<int,int>,std::string>, int>::iterator it;
+  it = p_dAngIndex.find(key);
+  if (it != p_dAngIndex.end()) {
+    p_dAngUse[it->second] = p_useCount;
+    return p_dAng[it->second];
+  }
+  int nbranch = p_network->numBranches();
+  int l;
+  p_factory->setMode(DCFlow);
+  setLineInjection(from,to,1.0);
+  p_vMap->mapToRealVector(p_inj);
+  setLineInjection(from,to,0.0);
+  p_ang->zero();
+  p_solver->solve(*p_inj, *p_ang);
+  p_vMap->mapToBus(p_ang);
+  int nbus = p_network->numBuses();
+  for (l=0; l<nbus; l++) {
+    if (p_network->getActiveBus(l)) {
+      p_busAng[l] = dynamic_cast<gridpack::powerflow::PFBus*>
+        (p_network->getBus(l).get())->getDCAngle();
+    }
+  }
+  p_angExchange->exchange(nbus > 0 ? &p_busAngPtr[0] : NULL);
+  for (l=0; l<nbus; l++) {
+    if (!p_network->getActiveBus(l)) {
+      dynamic_cast<gridpack::powerflow::PFBus*>
+        (p_network->getBus(l).get())->setDCAngle(p_busAng[l]);
+    }
+  }
+  // Replace the least recently used column if the cache is full. Columns
+  // used by the contingency that is currently being screened are never
+  // replaced, so the cache may temporarily grow past the limit if a
+  // contingency removes more lines than the limit
+  int idx = p_dAng.size();
+  if (p_cacheLimit > 0 && idx >= p_cacheLimit) {
+    for (l=0; l<p_dAng.size(); l++) {
+      if (p_dAngUse[l] < p_useCount &&
+          (idx == p_dAng.size() || p_dAngUse[l] < p_dAngUse[idx])) {
+        idx = l;
+      }
+    }
+  }
+  if (idx == p_dAng.size()) {
+    p_dAng.push_back(std::vector<double>(nbranch,0.0));
+    p_dAngKey.push_back(key);
+    p_dAngUse.push_back(p_useCount);
+  } else {
+    p_dAngIndex.erase(p_dAngKey[idx]);
+    p_dAngKey[idx] = key;
+    p_dAngUse[idx] = p_useCount;
+  }
+  p_dAngIndex.insert(std::pair<std::pair<std::pair<int,int>,std::string>,
+      int>(key,idx));
+  std::vector<double> &dang = p_dAng[idx];
+  dang.assign(nbranch,0.0);
+  for (l=0; l<nbranch; l++) {
+    if (p_network->getActiveBranch(l)) {
+      gridpack::powerflow::PFBranch *branch =
+        dynamic_cast<gridpack::powerflow::PFBranch*>
+        (p_network->getBranch(l).get());
+      dang[l] = branch->getDCAngleDifference();
+    }
+  }
+  return dang;
+}
+
+/**
+ * Estimate the maximum loading of any line in the network after the
+ * contingency. If lines k are removed from service, the flows g_k that
+ * would have to be cancelled at the ends of the removed lines satisfy
+ *   (I - PTDF_kk) g = f0_k
+ * and the change in flow on any other line l is PTDF_lk g. The columns of
+ * PTDF for the removed lines are obtained from solutions of B' x = e_from -
+ * e_to. Each column is only evaluated the first time a line is removed.
+ * @param event contingency to be screened
+ * @return maximum estimated loading or a negative value if contingency
+ *         cannot be screened
+ */
+double gridpack::powerflow::DCScreenModule::screen(const Contingency &event)
+{
+  if (event.p_type != Branch) return -1.0;
+  gridpack::utility::CoarseTimer *timer =
+    gridpack::utility::CoarseTimer::instance();
+  int t_screen = timer->createCategory("DC Screen: Screen Contingency");
+  timer->start(t_screen);
+  double t0 = timer->currentTime();
+  gridpack::parallel::Communicator comm = p_network->communicator();
+  int nout = event.p_from.size();
+  int nbranch = p_network->numBranches();
+  int i, j, k, l;
+
+  // Find susceptance and base case flow of lines that are removed
+  std::vector<double> bout(nout,0.0);
+  std::vector<double> fout(nout,0.0);
+  std::vector<int> found(nout,0);
+  std::vector<int> outBranch(nout,-1);
+  std::vector<int> outLine(nout,-1);
+  for (i=0; i<nout; i++) {
+    std::vector<int> lids = p_network->getLocalBranchIndices(event.p_from[i],
+        event.p_to[i]);
+    for (j=0; j<lids.size(); j++) {
+      int idx = lids[j];
+      for (k=p_lineOffset[idx]; k<p_lineOffset[idx+1]; k++) {
+        if (p_lineTag[k] == event.p_ckt[i]) {
+          outBranch[i] = idx;
+          outLine[i] = k;
+          bout[i] = p_lineB[k];
+          fout[i] = p_lineP[k];
+          found[i] = 1;
+        }
+      }
+    }
+  }
+  if (nout > 0) {
+    comm.sum(&bout[0],nout);
+    comm.sum(&fout[0],nout);
+    comm.sum(&found[0],nout);
+  }
+  bool ok = (nout > 0);
+  for (i=0; i<nout; i++) {
+    if (found[i] != 1 || bout[i] == 0.0) ok = false;
+  }
+  if (!ok) {
+    timer->stop(t_screen);
+    p_time += timer->currentTime()-t0;
+    p_numScreened++;
+    return -1.0;
+  }
+
+  // Get angle differences across all branches for unit flow on each
+  // removed line. All lines are evaluated before any references to the
+  // columns are kept, since adding columns may move the existing ones
+  std::vector<const std::vector<double>*> dAng(nout);
+  p_useCount++;
+  for (i=0; i<nout; i++) {
+    lineSensitivity(event.p_from[i],event.p_to[i],event.p_ckt[i]);
+  }
+  for (i=0; i<nout; i++) {
+    dAng[i] = &lineSensitivity(event.p_from[i],event.p_to[i],
+        event.p_ckt[i]);
+  }
+
+  // Construct I - PTDF_kk and solve for compensating flows. The sign
+  // convention of angle differences follows the orientation of the
+  // branch, so flows are evaluated in the same orientation
+  std::vector<double> M(nout*nout,0.0);
+  for (i=0; i<nout; i++) {
+    if (outLine[i] < 0 || !p_network->getActiveBranch(outBranch[i])) continue;
+    for (j=0; j<nout; j++) {
+      M[i*nout+j] = -bout[i]*(*dAng[j])[outBranch[i]];
+    }
+  }
+  comm.sum(&M[0],nout*nout);
+  for (i=0; i<nout; i++) M[i*nout+i] += 1.0;
+  std::vector<int> piv;
+  // A removed line with PTDF_kk close to 1 islands part of the network
+  double mmax = 0.0;
+  for (i=0; i<nout*nout; i++) mmax = std::max(mmax,std::fabs(M[i]));
+  ok = gridpack::powerflow::denseFactor(nout,M,piv);
+  for (i=0; i<nout && ok; i++) {
+    if (std::fabs(M[i*nout+i]) < 1.0e-6*mmax) ok = false;
+  }
+  if (!ok) {
+    timer->stop(t_screen);
+    p_time += timer->currentTime()-t0;
+    p_numScreened++;
+    return -1.0;
+  }
+  std::vector<double> g = fout;
+  gridpack::powerflow::denseSolve(nout,M,piv,&g[0]);
+
+  // Estimate post-contingency loading on remaining lines
+  double loading = 0.0;
+  for (l=0; l<nbranch; l++) {
+    if (p_lineOffset[l] == p_lineOffset[l+1]) continue;
+    double dang = 0.0;
+    for (i=0; i<nout; i++) dang += g[i]*(*dAng[i])[l];
+    for (k=p_lineOffset[l]; k<p_lineOffset[l+1]; k++) {
+      if (p_lineRate[k] <= 0.0) continue;
+      bool removed = false;
+      for (i=0; i<nout; i++) {
+        if (outLine[i] == k) removed = true;
+      }
+      if (removed) continue;
+      double p = p_lineP[k] + p_lineB[k]*dang;
+      double q = p_lineQ[k];
+      double load = sqrt(p*p+q*q)/p_lineRate[k];
+      if (load > loading) loading = load;
+    }
+  }
+  comm.max(&loading,1);
+  timer->stop(t_screen);
+  p_time += timer->currentTime()-t0;
+  p_numScreened++;
+  return loading;
+}
+
+/**
+ * Screen a list of contingencies. The contingencies are divided between
+ * the network communicators that make up the world communicator
+ * @param events list of contingencies (same on all processors)
+ * @param world communicator containing all network communicators
+ * @param loading estimated maximum loading for each contingency
+ */
+void gridpack::powerflow::DCScreenModule::screen(
+    const std::vector<Contingency> &events,
+    const gridpack::parallel::Communicator &world,
+    std::vector<double> &loading)
+{
+  gridpack::parallel::Communicator comm = p_network->communicator();
+  int nevents = events.size();
+  int nprocs = world.size();
+  int me = world.rank();
+  int i;
+  // Assign an index to each network communicator using the process with
+  // rank 0 on that communicator
+  std::vector<int> leader(nprocs,0);
+  if (comm.rank() == 0) leader[me] = 1;
+  world.sum(&leader[0],nprocs);
+  int ngrp = 0;
+  int grp = 0;
+  for (i=0; i<nprocs; i++) {
+    if (i == me) grp = ngrp;
+    ngrp += leader[i];
+  }
+  if (comm.rank() != 0) grp = 0;
+  comm.sum(&grp,1);
+
+  loading.assign(nevents,0.0);
+  for (i=grp; i<nevents; i+=ngrp) {
+    loading[i] = screen(events[i]);
+  }
+  if (comm.rank() != 0) {
+    for (i=0; i<nevents; i++) loading[i] = 0.0;
+  }
+  if (nevents > 0) world.sum(&loading[0],nevents);
+}
+
+/**
+ * Check if a contingency should be evaluated with a full AC calculation
+ * @param loading estimated maximum loading returned by screen
+ * @return true if contingency is flagged
+ */
+bool gridpack::powerflow::DCScreenModule::isFlagged(double loading) const
+{
+  return (loading < 0.0 || loading > p_threshold);
+}
+
+/**
+ * Order contingencies by estimated loading
+ * @param loading estimated maximum loading for each contingency
+ * @param order indices of contingencies in ranked order
+ */
+void gridpack::powerflow::DCScreenModule::rank(
+    const std::vector<double> &loading, std::vector<int> &order) const
+{
+  int i;
+  int nevents = loading.size();
+  order.resize(nevents);
+  for (i=0; i<nevents; i++) order[i] = i;
+  std::sort(order.begin(),order.end(),LoadingCompare(loading));
+}
+
+/**
+ * Number of contingencies screened since setNetwork was called
+ * @return number of contingencies
+ */
+int gridpack::powerflow::DCScreenModule::numScreened(void) const
+{
+  return p_numScreened;
+}
+
+/**
+ * Time spent in screen since setNetwork was called
+ * @return time in seconds
+ */
+double gridpack::powerflow::DCScreenModule::screenTime(void) const
+{
+  return p_time;
+}
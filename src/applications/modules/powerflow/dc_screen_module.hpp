@@ -0,0 +1,213 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   dc_screen_module.hpp
+ * @author agent
+ * @date   2026-10-17
+ *
+ * @brief
+ * Screening of line contingencies using linear sensitivities (PTDF/LODF)
+ * derived from the DC power flow equations. The B' matrix is factored once
+ * and the PTDF column of each line that is taken out of service is
+ * calculated once and reused by all contingencies containing that line.
+ * Post-contingency flows are estimated from the AC base case flows so that
+ * only contingencies that may cause line overloads need to be evaluated
+ * with a full AC power flow calculation. Bus voltage magnitudes are not
+ * part of the DC model, so contingencies are not screened for voltage
+ * violations.
+ *
+ */
+// -------------------------------------------------------------
+
+#ifndef _dc_screen_module_h_
+#define _dc_screen_module_h_
+
+#include <map>
+#include "boost/smart_ptr/shared_ptr.hpp"
+#include "gridpack/configuration/configuration.hpp"
+#include "gridpack/math/linear_solver.hpp"
+#include "gridpack/mapper/bus_vector_map.hpp"
+#include "gridpack/parallel/ghost_exchange.hpp"
+#include "pf_factory_module.hpp"
+#include "pf_app_module.hpp"
+
+namespace gridpack {
+namespace powerflow {
+
+class DCScreenModule
+{
+  public:
+    /**
+     * Basic constructor
+     */
+    DCScreenModule(void);
+
+    /**
+     * Basic destructor
+     */
+    ~DCScreenModule(void);
+
+    /**
+     * Set up screening calculation. The base case power flow must have been
+     * solved before calling this function, since the flows on all lines are
+     * stored and used as the starting point for the estimated
+     * post-contingency flows. This is a collective operation on the network
+     * communicator.
+     * @param network power flow network with a converged base case
+     * @param cursor pointer to block in input deck containing linear solver
+     *        parameters for the factorization of B'
+     */
+    void setNetwork(boost::shared_ptr<PFNetwork> &network,
+        gridpack::utility::Configuration::CursorPtr cursor);
+
+    /**
+     * Set threshold for flagging contingencies. A contingency is flagged if
+     * the estimated loading on any line exceeds this fraction of the line
+     * rating. The default is 0.9
+     * @param threshold fraction of line rating
+     */
+    void setThreshold(double threshold);
+
+    /**
+     * Use rating B instead of rating A when evaluating line loadings
+     * @param flag if true, use rating B
+     */
+    void useRateB(bool flag);
+
+    /**
+     * Set the maximum number of PTDF columns that are kept. Each column
+     * stores one value per local branch. When the limit is reached, the
+     * column that was least recently used is replaced. The default is 256
+     * columns. A value less than or equal to zero keeps the columns of all
+     * lines that have been taken out of service
+     * @param nlines maximum number of stored columns
+     */
+    void setCacheLimit(int nlines);
+
+    /**
+     * Estimate the maximum loading, as a fraction of the line rating, of any
+     * line in the network after the contingency. This is a collective
+     * operation on the network communicator.
+     * @param event contingency to be screened. Multiple lines can be taken
+     *        out of service in a single contingency
+     * @return maximum estimated loading. A negative value is returned if
+     *         the contingency cannot be screened with the DC model
+     *         (generator contingencies, lines that are not found or
+     *         outages that island part of the network)
+     */
+    double screen(const Contingency &event);
+
+    /**
+     * Screen a list of contingencies. The contingencies are divided between
+     * the network communicators that make up the world communicator and
+     * results are replicated on all processors. This is a collective
+     * operation on the world communicator
+     * @param events list of contingencies (same on all processors)
+     * @param world communicator containing all network communicators
+     * @param loading estimated maximum loading for each contingency
+     */
+    void screen(const std::vector<Contingency> &events,
+        const gridpack::parallel::Communicator &world,
+        std::vector<double> &loading);
+
+    /**
+     * Check if a contingency should be evaluated with a full AC calculation
+     * @param loading estimated maximum loading returned by screen
+     * @return true if loading exceeds threshold or contingency could not be
+     *         screened
+     */
+    bool isFlagged(double loading) const;
+
+    /**
+     * Order contingencies by estimated loading. Contingencies that could
+     * not be screened are placed at the front of the list, followed by the
+     * remaining contingencies in order of decreasing loading
+     * @param loading estimated maximum loading for each contingency
+     * @param order indices of contingencies in ranked order
+     */
+    void rank(const std::vector<double> &loading, std::vector<int> &order) const;
+
+    /**
+     * Number of contingencies screened since setNetwork was called
+     * @return number of contingencies
+     */
+    int numScreened(void) const;
+
+    /**
+     * Time spent in screen since setNetwork was called. This does not
+     * include the factorization of B'
+     * @return time in seconds
+     */
+    double screenTime(void) const;
+
+  private:
+
+    /**
+     * Set injections on the end points of a line
+     * @param from, to original indices of buses at each end of line
+     * @param value injection at from bus. The negative of this value is
+     *        assigned to the to bus
+     */
+    void setLineInjection(int from, int to, double value);
+
+    /**
+     * Return the angle differences across all local branches for a unit
+     * flow on a line. These are evaluated the first time a line is
+     * requested and stored for subsequent contingencies. This is a
+     * collective operation on the network communicator.
+     * @param from, to original indices of buses at each end of line
+     * @param ckt circuit identifier of line
+     * @return angle differences, indexed by local branch index
+     */
+    const std::vector<double>& lineSensitivity(int from, int to,
+        const std::string &ckt);
+
+    boost::shared_ptr<PFNetwork> p_network;
+    boost::shared_ptr<PFFactoryModule> p_factory;
+    boost::shared_ptr<gridpack::mapper::BusVectorMap<PFNetwork> > p_vMap;
+    boost::shared_ptr<gridpack::math::RealMatrix> p_B;
+    boost::shared_ptr<gridpack::math::RealLinearSolver> p_solver;
+    boost::shared_ptr<gridpack::math::RealVector> p_inj;
+    boost::shared_ptr<gridpack::math::RealVector> p_ang;
+
+    // Base case data for line elements on locally active branches. Line
+    // elements for branch i are located between p_lineOffset[i] and
+    // p_lineOffset[i+1]
+    std::vector<int> p_lineOffset;
+    std::vector<std::string> p_lineTag;
+    std::vector<double> p_lineB;
+    std::vector<double> p_lineP;
+    std::vector<double> p_lineQ;
+    std::vector<double> p_lineRate;
+
+    // Angle differences across all local branches for each line outage
+    // that has been evaluated, and the location of each line in this list.
+    // p_dAngKey is the line stored in each slot and p_dAngUse is the value
+    // of p_useCount when the slot was last used
+    std::vector<std::vector<double> > p_dAng;
+    std::map<std::pair<std::pair<int,int>,std::string>, int> p_dAngIndex;
+    std::vector<std::pair<std::pair<int,int>,std::string> > p_dAngKey;
+    std::vector<long> p_dAngUse;
+    long p_useCount;
+    int p_cacheLimit;
+
+    // Exchange of DC angles from active buses to ghost buses. The DC angle
+    // is kept out of the bus exchange buffer so that it does not add to
+    // the cost of updateBuses in power flow calculations
+    boost::shared_ptr<gridpack::parallel::GhostExchange> p_angExchange;
+    std::vector<double> p_busAng;
+    std::vector<void*> p_busAngPtr;
+
+    double p_threshold;
+    bool p_rateB;
+    int p_numScreened;
+    double p_time;
+};
+
+} // namespace powerflow
+} // namespace gridpack
+#endif
@@ -24,8 +24,11 @@
 #include "gridpack/parser/MAT_parser.hpp"
 #include "gridpack/export/PSSE33Export.hpp"
 #include "gridpack/parser/GOSS_parser.hpp"
+#include "gridpack/network/network_snapshot.hpp"
 #include "gridpack/math/math.hpp"
+#include "gridpack/environment/threads.hpp"
 #include "pf_helper.hpp"
+#include "pf_dense_lu.hpp"
 
 #define USE_REAL_VALUES
 
@@ -35,6 +38,9 @@
 gridpack::powerflow::PFAppModule::PFAppModule(void)
 {
   p_no_print = false;
+  p_lowRank = false;
+  p_lowRankMaxIteration = 20;
+  p_lowRankMaxRank = 32;
 }
 
 /**
@@ -94,13 +100,39 @@ void gridpack::powerflow::PFAppModule::readNetwork(
   p_tolerance = cursor->get("tolerance",1.0e-6);
   p_qlim = cursor->get("qlim",0);
   p_max_iteration = cursor->get("maxIteration",50);
+  // Parameters for low-rank contingency solves
+  p_lowRank = cursor->get("lowRankContingency",false);
+  p_lowRankMaxIteration = cursor->get("lowRankMaxIteration",20);
+  p_lowRankMaxRank = cursor->get("lowRankMaxRank",32);
   ComplexType tol;
   // Phase shift sign
   double phaseShiftSign = cursor->get("phaseShiftSign",1.0);
+  // Use point-to-point exchanges between neighboring processors for ghost
+  // bus updates
+  network->useNeighborExchange(cursor->get("neighborExchange",false));
+  // Number of threads used in loops over buses and branches (only used if
+  // GridPACK is built with OpenMP)
+  gridpack::Threads::instance()->setNumThreads(
+      cursor->get("componentThreads",1));
+
+  // Restore the partitioned network from a snapshot if one exists for the
+  // current network configuration file and number of processors
+  std::string snapshot = cursor->get("networkSnapshot","");
+  gridpack::network::NetworkSnapshot<PFNetwork> snap(network);
+  snap.addSourceFile(filename);
+  char sbuf[128];
+  sprintf(sbuf,"phaseShiftSign %f",phaseShiftSign);
+  snap.addSourceString(sbuf);
+  bool restored = false;
 
   int t_pti = timer->createCategory("Powerflow: Network Parser");
   timer->start(t_pti);
-  if (filetype == PTI23) {
+  if (snapshot.size() > 0) restored = snap.read(snapshot);
+  if (restored) {
+    if (!p_no_print && p_comm.rank() == 0) {
+      printf("Network restored from snapshot %s\n",snapshot.c_str());
+    }
+  } else if (filetype == PTI23) {
     gridpack::parser::PTI23_parser<PFNetwork> parser(network);
 #ifdef USE_GOSS
     char sbuf[256], sbuf2[256];
@@ -117,6 +149,8 @@ void gridpack::powerflow::PFAppModule::readNetwork(
     }
   } else if (filetype == PTI33) {
     gridpack::parser::PTI33_parser<PFNetwork> parser(network);
+    // Read bus, load, generator and branch blocks on all processors
+    parser.setParallelRead(cursor->get("parallelRead",false));
 #ifdef USE_GOSS
     char sbuf[256], sbuf2[256];
     sprintf(sbuf,"{ \"simulation_id\": \"%s\"}",simID.c_str());
@@ -153,6 +187,11 @@ void gridpack::powerflow::PFAppModule::readNetwork(
 
   // Create serial IO object to export data from branches
   p_branchIO.reset(new gridpack::serial_io::SerialBranchIO<PFNetwork>(512,network));
+
+  // Write output from a background thread on process 0
+  bool async = cursor->get("asynchronousIO",false);
+  p_busIO->setAsync(async);
+  p_branchIO->setAsync(async);
   char ioBuf[128];
 
   if (!p_no_print) {
@@ -165,7 +204,10 @@ void gridpack::powerflow::PFAppModule::readNetwork(
   // partition network
   int t_part = timer->createCategory("Powerflow: Partition");
   timer->start(t_part);
-  network->partition();
+  if (!restored) {
+    network->partition();
+    if (snapshot.size() > 0) snap.write(snapshot);
+  }
   timer->stop(t_part);
   timer->stop(t_total);
 }
@@ -332,6 +374,9 @@ bool gridpack::powerflow::PFAppModule::solve()
     gridpack::math::LinearSolver solver(*J);
 #endif
     solver.configure(cursor);
+    // The Jacobian is refilled by the same mapper in every iteration, so
+    // its nonzero pattern does not change
+    solver.numericRefactor();
     timer->stop(t_csolv);
 
     // First iteration
@@ -645,6 +690,50 @@ std::vector<std::string> gridpack::powerflow::PFAppModule::writeBranchString(
   return ret;
 }
 
+/**
+ * Return numerical results from buses on process 0
+ * @param signal type of values to return ("voltage" or "generator")
+ * @param index global index of bus contributing each record
+ * @param values values of all records, stored contiguously
+ * @return number of values in each record
+ */
+int gridpack::powerflow::PFAppModule::getBusValues(const char *signal,
+    std::vector<int> &index, std::vector<double> &values)
+{
+  gridpack::utility::CoarseTimer *timer =
+    gridpack::utility::CoarseTimer::instance();
+  int t_total = timer->createCategory("Powerflow: Total Application");
+  timer->start(t_total);
+  int t_gather = timer->createCategory("Powerflow: Gather Values");
+  timer->start(t_gather);
+  int ret = p_busIO->gatherValues(index,values,signal);
+  timer->stop(t_gather);
+  timer->stop(t_total);
+  return ret;
+}
+
+/**
+ * Return numerical results from branches on process 0
+ * @param signal type of values to return ("flow_values")
+ * @param index global index of branch contributing each record
+ * @param values values of all records, stored contiguously
+ * @return number of values in each record
+ */
+int gridpack::powerflow::PFAppModule::getBranchValues(const char *signal,
+    std::vector<int> &index, std::vector<double> &values)
+{
+  gridpack::utility::CoarseTimer *timer =
+    gridpack::utility::CoarseTimer::instance();
+  int t_total = timer->createCategory("Powerflow: Total Application");
+  timer->start(t_total);
+  int t_gather = timer->createCategory("Powerflow: Gather Values");
+  timer->start(t_gather);
+  int ret = p_branchIO->gatherValues(index,values,signal);
+  timer->stop(t_gather);
+  timer->stop(t_total);
+  return ret;
+}
+
 void gridpack::powerflow::PFAppModule::writeHeader(const char *msg)
 {
   if (p_no_print) return;
@@ -807,6 +896,233 @@ bool gridpack::powerflow::PFAppModule::unSetContingency(
   return ret;
 }
 
+namespace {
+
+/**
+ * Get values of a distributed vector at a list of global indices. The
+ * values are returned on all processors
+ * @param comm communicator for vector
+ * @param vec distributed vector
+ * @param idx global indices
+ * @param values vector values at indices
+ */
+void gatherValues(const gridpack::parallel::Communicator &comm,
+    const gridpack::math::RealVector &vec, const std::vector<int> &idx,
+    std::vector<double> &values)
+{
+  int i, lo, hi;
+  int nidx = idx.size();
+  values.assign(nidx,0.0);
+  vec.localIndexRange(lo,hi);
+  for (i=0; i<nidx; i++) {
+    if (idx[i] >= lo && idx[i] < hi) vec.getElement(idx[i],values[i]);
+  }
+  if (nidx > 0) comm.sum(&values[0],nidx);
+}
+
+}
+
+/**
+ * Save the current solution and factor the Jacobian at this solution so
+ * that it can be used by contingencySolve. This should be called after
+ * the base case has been solved and before any contingencies are set.
+ * @return false if low-rank contingency solves are not enabled
+ */
+bool gridpack::powerflow::PFAppModule::setBaseCase()
+{
+  if (!p_lowRank) return false;
+  gridpack::utility::CoarseTimer *timer =
+    gridpack::utility::CoarseTimer::instance();
+  int t_base = timer->createCategory("Powerflow: Set Base Case");
+  timer->start(t_base);
+  p_factory->saveVoltages();
+  p_factory->setYBus();
+  p_factory->setMode(Jacobian);
+  gridpack::mapper::FullMatrixMap<PFNetwork> jMap(p_network);
+  p_baseSolver.reset();
+  p_baseJ = jMap.mapToRealMatrix();
+  p_baseSolver.reset(new gridpack::math::RealLinearSolver(*p_baseJ));
+  gridpack::utility::Configuration::CursorPtr cursor;
+  cursor = p_config->getCursor("Configuration.Powerflow");
+  p_baseSolver->configure(cursor);
+
+  // Factor the Jacobian now so that the cost is not charged to the first
+  // contingency
+  gridpack::math::RealVector b(p_comm, p_baseJ->localRows());
+  gridpack::math::RealVector x(p_comm, p_baseJ->localRows());
+  b.fill(1.0);
+  b.ready();
+  x.zero();
+  x.ready();
+  p_baseSolver->solve(b, x);
+  timer->stop(t_base);
+  return true;
+}
+
+/**
+ * Solve the current contingency. If a base case has been set, the
+ * contingency is solved starting from the base case solution using the
+ * factored base case Jacobian J0 plus a low-rank correction. The
+ * contingency Jacobian J is evaluated once at the base case solution and
+ * J - J0 only has nonzero rows for buses next to the outage. If R is the
+ * set of these rows, then each Newton step solves (J0 + E_R D) x = b using
+ * the Sherman-Morrison-Woodbury formula
+ *   x = y - Z C^{-1} D y,  y = J0^{-1} b,  Z = J0^{-1} E_R,  C = I + D Z
+ * This is a chord iteration since the corrected Jacobian is not updated.
+ * @return false if an error was caught in the solution algorithm
+ */
+bool gridpack::powerflow::PFAppModule::contingencySolve()
+{
+  if (!p_lowRank || !p_baseJ) return solve();
+  gridpack::utility::CoarseTimer *timer =
+    gridpack::utility::CoarseTimer::instance();
+  int t_total = timer->createCategory("Powerflow: Total Application");
+  int t_lrank = timer->createCategory("Powerflow: Low-Rank Contingency Solve");
+  timer->start(t_total);
+  timer->start(t_lrank);
+  p_factory->clearViolations();
+
+  // Start from base case solution and evaluate contingency Jacobian and
+  // mismatch there
+  p_factory->restoreVoltages();
+  p_network->updateBuses();
+  p_factory->setYBus();
+  p_factory->setSBus();
+  p_factory->setMode(RHS);
+  gridpack::mapper::BusVectorMap<PFNetwork> vMap(p_network);
+  boost::shared_ptr<gridpack::math::RealVector> PQ = vMap.mapToRealVector();
+  p_factory->setMode(Jacobian);
+  gridpack::mapper::FullMatrixMap<PFNetwork> jMap(p_network);
+  boost::shared_ptr<gridpack::math::RealMatrix> J = jMap.mapToRealMatrix();
+
+  // The correction only works if the contingency leaves the structure of
+  // the Jacobian unchanged
+  bool ok = (J->rows() == p_baseJ->rows());
+  ok = ok && (J->localRows() == p_baseJ->localRows());
+  ok = p_comm.all(ok);
+
+  double tol = 2.0*p_tolerance;
+  int iter = 0;
+  if (ok) {
+    int nproc = p_comm.size();
+    int me = p_comm.rank();
+    int i, j, lo, hi;
+    int nloc = J->localRows();
+
+    // dJ = J - J0
+    boost::shared_ptr<gridpack::math::RealMatrix> dJ(p_baseJ->clone());
+    dJ->scale(-1.0);
+    dJ->add(*J);
+
+    // Find rows of dJ that contain nonzero values by multiplying by a
+    // vector with irregular values
+    gridpack::math::RealVector w(p_comm, nloc);
+    w.localIndexRange(lo,hi);
+    for (i=lo; i<hi; i++) {
+      double r = 0.6180339887*static_cast<double>(i+1);
+      w.setElement(i, 1.0+r-floor(r));
+    }
+    w.ready();
+    boost::scoped_ptr<gridpack::math::RealVector>
+      dJw(gridpack::math::multiply(*dJ, w));
+    double scale = dJw->normInfinity();
+    std::vector<int> lrows;
+    for (i=lo; i<hi; i++) {
+      double v;
+      dJw->getElement(i,v);
+      if (fabs(v) > 1.0e-12*scale) lrows.push_back(i);
+    }
+    std::vector<int> counts(nproc,0);
+    counts[me] = lrows.size();
+    p_comm.sum(&counts[0],nproc);
+    int nrank = 0;
+    int offset = 0;
+    for (i=0; i<nproc; i++) {
+      if (i == me) offset = nrank;
+      nrank += counts[i];
+    }
+    ok = (nrank <= p_lowRankMaxRank);
+
+    std::vector<int> rows(nrank,0);
+    std::vector<boost::shared_ptr<gridpack::math::RealVector> > Z;
+    std::vector<double> C, t;
+    std::vector<int> piv;
+    if (ok && nrank > 0) {
+      for (i=0; i<counts[me]; i++) rows[offset+i] = lrows[i];
+      p_comm.sum(&rows[0],nrank);
+
+      // Z = J0^{-1} E_R and C = I + D Z
+      C.resize(nrank*nrank);
+      gridpack::math::RealVector e(p_comm, nloc);
+      gridpack::math::RealVector dJz(p_comm, nloc);
+      for (j=0; j<nrank; j++) {
+        e.zero();
+        if (rows[j] >= lo && rows[j] < hi) e.setElement(rows[j],1.0);
+        e.ready();
+        boost::shared_ptr<gridpack::math::RealVector> z(e.clone());
+        z->zero();
+        z->ready();
+        p_baseSolver->solve(e, *z);
+        Z.push_back(z);
+        gridpack::math::multiply(*dJ, *z, dJz);
+        gatherValues(p_comm, dJz, rows, t);
+        for (i=0; i<nrank; i++) {
+          C[i*nrank+j] = t[i];
+          if (i == j) C[i*nrank+j] += 1.0;
+        }
+      }
+      ok = gridpack::powerflow::denseFactor(nrank, C, piv);
+    }
+
+    // Chord iteration using corrected Jacobian
+    boost::shared_ptr<gridpack::math::RealVector> X(PQ->clone());
+    gridpack::math::RealVector dJy(p_comm, nloc);
+    tol = PQ->normInfinity();
+    while (ok && tol > p_tolerance && iter < p_lowRankMaxIteration) {
+      X->zero();
+      X->ready();
+      p_baseSolver->solve(*PQ, *X);
+      if (nrank > 0) {
+        gridpack::math::multiply(*dJ, *X, dJy);
+        gatherValues(p_comm, dJy, rows, t);
+        gridpack::powerflow::denseSolve(nrank, C, piv, &t[0]);
+        for (j=0; j<nrank; j++) X->add(*Z[j], -t[j]);
+      }
+      p_factory->setMode(RHS);
+      vMap.mapToBus(X);
+      p_network->updateBuses();
+      vMap.mapToRealVector(PQ);
+      tol = PQ->normInfinity();
+      // stop if the iteration is diverging
+      if (!(tol < 1.0e10)) ok = false;
+      iter++;
+    }
+    ok = ok && (tol <= p_tolerance);
+    if (ok && p_qlim != 0) {
+      // Let the full solver handle changes from PV to PQ buses
+      ok = p_factory->checkQlimViolations();
+    }
+  }
+  timer->stop(t_lrank);
+  timer->stop(t_total);
+
+  if (ok) {
+    if (!p_no_print) {
+      char ioBuf[128];
+      sprintf(ioBuf,"\nLow-rank contingency solve converged after"
+          " %d iterations Tol: %12.6e\n",iter,tol);
+      p_busIO->header(ioBuf);
+    }
+    return true;
+  }
+  if (!p_no_print) {
+    p_busIO->header("\nLow-rank contingency solve failed, using full solve\n");
+  }
+  p_factory->restoreVoltages();
+  p_network->updateBuses();
+  return solve();
+}
+
 /**
  * Set voltage limits on all buses
  * @param Vmin lower bound on voltages
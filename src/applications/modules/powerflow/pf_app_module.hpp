@@ -21,6 +21,7 @@
 #include "boost/smart_ptr/shared_ptr.hpp"
 #include "gridpack/serial_io/serial_io.hpp"
 #include "gridpack/configuration/configuration.hpp"
+#include "gridpack/math/linear_solver.hpp"
 #include "pf_factory_module.hpp"
 
 namespace gridpack {
@@ -134,6 +135,25 @@ class PFAppModule
     std::vector<std::string> writeBusString(const char *signal = NULL);
     std::vector<std::string> writeBranchString(const char *signal = NULL);
 
+    /**
+     * Return numerical results from buses or branches on process 0. Records
+     * are ordered by global index and each record contains the same number
+     * of values. Bus signals are "voltage" (original bus index, angle,
+     * voltage magnitude, 1 if voltage magnitude is monitored, 1 if bus type
+     * has changed) and "generator" (original bus index, Pg, Qg for each
+     * generator). The branch signal is "flow_values" (original indices of
+     * both buses, P, Q, square of ratio of flow to rating, rating, 1 if
+     * rating is exceeded for each line)
+     * @param signal type of values to return
+     * @param index global index of bus or branch contributing each record
+     * @param values values of all records, stored contiguously
+     * @return number of values in each record
+     */
+    int getBusValues(const char *signal, std::vector<int> &index,
+        std::vector<double> &values);
+    int getBranchValues(const char *signal, std::vector<int> &index,
+        std::vector<double> &values);
+
     /**
      * Redirect output from standard out
      * @param filename name of file to write results to
@@ -173,6 +193,28 @@ class PFAppModule
      */
     bool unSetContingency(Contingency &event);
 
+    /**
+     * Save the current solution and factor the Jacobian at this solution so
+     * that it can be used by contingencySolve. This should be called after
+     * the base case has been solved and before any contingencies are set.
+     * It does nothing unless lowRankContingency is set in the Powerflow
+     * block of the input file
+     * @return false if low-rank contingency solves are not enabled
+     */
+    bool setBaseCase();
+
+    /**
+     * Solve the current contingency. If a base case has been set, the
+     * contingency is solved starting from the base case solution using the
+     * factored base case Jacobian plus a low-rank correction for the
+     * Jacobian entries that are changed by the contingency. If this
+     * iteration does not converge, or the contingency changes the
+     * dimensions of the Jacobian, then a full solve is done instead.
+     * Otherwise this is the same as solve
+     * @return false if an error was caught in the solution algorithm
+     */
+    bool contingencySolve();
+
     /**
      * Set voltage limits on all buses
      * @param Vmin lower bound on voltages
@@ -364,6 +406,14 @@ class PFAppModule
     // Flag to suppress all printing to standard out
     bool p_no_print;
 
+    // Low-rank contingency solves. The base case Jacobian is factored once
+    // and contingencies are solved using a correction to it
+    bool p_lowRank;
+    int p_lowRankMaxIteration;
+    int p_lowRankMaxRank;
+    boost::shared_ptr<gridpack::math::RealMatrix> p_baseJ;
+    boost::shared_ptr<gridpack::math::RealLinearSolver> p_baseSolver;
+
 #ifdef USE_GOSS
     gridpack::goss::GOSSClient p_goss_client;
 
@@ -0,0 +1,87 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   pf_dense_lu.hpp
+ * @author agent
+ * @date   2026-10-17
+ *
+ * @brief
+ * LU factorization of small dense matrices that are replicated on all
+ * processors. These are used for the low-rank corrections in contingency
+ * calculations
+ *
+ */
+// -------------------------------------------------------------
+
+#ifndef _pf_dense_lu_h_
+#define _pf_dense_lu_h_
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+namespace gridpack {
+namespace powerflow {
+
+/**
+ * Factor a small dense matrix in place using Gaussian elimination with
+ * partial pivoting
+ * @param n dimension of matrix
+ * @param a matrix values in row-major order
+ * @param piv pivot rows
+ * @return false if matrix is singular
+ */
+inline bool denseFactor(int n, std::vector<double> &a, std::vector<int> &piv)
+{
+  int i, j, k;
+  piv.resize(n);
+  for (k=0; k<n; k++) {
+    int imax = k;
+    double amax = std::fabs(a[k*n+k]);
+    for (i=k+1; i<n; i++) {
+      if (std::fabs(a[i*n+k]) > amax) {
+        amax = std::fabs(a[i*n+k]);
+        imax = i;
+      }
+    }
+    piv[k] = imax;
+    if (amax == 0.0) return false;
+    if (imax != k) {
+      for (j=0; j<n; j++) std::swap(a[k*n+j],a[imax*n+j]);
+    }
+    for (i=k+1; i<n; i++) {
+      a[i*n+k] /= a[k*n+k];
+      for (j=k+1; j<n; j++) a[i*n+j] -= a[i*n+k]*a[k*n+j];
+    }
+  }
+  return true;
+}
+
+/**
+ * Solve a small dense system using a matrix factored by denseFactor
+ * @param n dimension of matrix
+ * @param a factored matrix
+ * @param piv pivot rows
+ * @param b right hand side. This is overwritten by the solution
+ */
+inline void denseSolve(int n, const std::vector<double> &a,
+    const std::vector<int> &piv, double *b)
+{
+  int i, j;
+  for (i=0; i<n; i++) {
+    if (piv[i] != i) std::swap(b[i],b[piv[i]]);
+    for (j=0; j<i; j++) b[i] -= a[i*n+j]*b[j];
+  }
+  for (i=n-1; i>=0; i--) {
+    for (j=i+1; j<n; j++) b[i] -= a[i*n+j]*b[j];
+    b[i] /= a[i*n+i];
+  }
+}
+
+} // namespace powerflow
+} // namespace gridpack
+#endif
@@ -36,6 +36,7 @@ PFFactoryModule::PFFactoryModule(PFFactoryModule::NetworkPtr network)
 {
   p_network = network;
   p_rateB = false;
+  p_busSetsBuilt = false;
 }
 
 /**
@@ -602,15 +603,24 @@ bool gridpack::powerflow::PFFactoryModule::checkQlimViolations()
   int numBus = p_network->numBuses();
   int i;
   bool bus_ok = true;
-  for (i=0; i<numBus; i++) {
-    if (p_network->getActiveBus(i)) {
-      gridpack::powerflow::PFBus *bus =
-        dynamic_cast<gridpack::powerflow::PFBus*>
-        (p_network->getBus(i).get());
-      if (bus->chkQlim()) bus_ok = false;
-    }
+  buildBusSets();
+  // Boundary buses are checked first so that their new values are included
+  // in the ghost update. Interior buses have no ghost copies on other
+  // processors and can be checked while the update is in progress
+  for (i=0; i<p_boundaryBuses.size(); i++) {
+    gridpack::powerflow::PFBus *bus =
+      dynamic_cast<gridpack::powerflow::PFBus*>
+      (p_network->getBus(p_boundaryBuses[i]).get());
+    if (bus->chkQlim()) bus_ok = false;
   }
-  p_network->updateBuses();
+  p_network->beginBusUpdate();
+  for (i=0; i<p_interiorBuses.size(); i++) {
+    gridpack::powerflow::PFBus *bus =
+      dynamic_cast<gridpack::powerflow::PFBus*>
+      (p_network->getBus(p_interiorBuses[i]).get());
+    if (bus->chkQlim()) bus_ok = false;
+  }
+  p_network->endBusUpdate();
   for (i=0; i<numBus; i++) {
     if (!p_network->getActiveBus(i)) {
       gridpack::powerflow::PFBus *bus =
@@ -632,17 +642,25 @@ bool gridpack::powerflow::PFFactoryModule::checkQlimViolations(int area)
   int numBus = p_network->numBuses();
   int i;
   bool bus_ok = true;
-  for (i=0; i<numBus; i++) {
-    if (p_network->getActiveBus(i)) {
-      gridpack::powerflow::PFBus *bus =
-        dynamic_cast<gridpack::powerflow::PFBus*>
-        (p_network->getBus(i).get());
-      if (bus->getArea() == area) {
-        if (!bus->chkQlim()) bus_ok = false;
-      }
+  buildBusSets();
+  for (i=0; i<p_boundaryBuses.size(); i++) {
+    gridpack::powerflow::PFBus *bus =
+      dynamic_cast<gridpack::powerflow::PFBus*>
+      (p_network->getBus(p_boundaryBuses[i]).get());
+    if (bus->getArea() == area) {
+      if (!bus->chkQlim()) bus_ok = false;
+    }
+  }
+  p_network->beginBusUpdate();
+  for (i=0; i<p_interiorBuses.size(); i++) {
+    gridpack::powerflow::PFBus *bus =
+      dynamic_cast<gridpack::powerflow::PFBus*>
+      (p_network->getBus(p_interiorBuses[i]).get());
+    if (bus->getArea() == area) {
+      if (!bus->chkQlim()) bus_ok = false;
     }
   }
-  p_network->updateBuses();
+  p_network->endBusUpdate();
   for (i=0; i<numBus; i++) {
     if (!p_network->getActiveBus(i)) {
       gridpack::powerflow::PFBus *bus =
@@ -663,15 +681,21 @@ void gridpack::powerflow::PFFactoryModule::clearQlimViolations()
   int numBus = p_network->numBuses();
   int i;
   bool bus_ok = true;
-  for (i=0; i<numBus; i++) {
-    if (p_network->getActiveBus(i)) {
-      gridpack::powerflow::PFBus *bus =
-        dynamic_cast<gridpack::powerflow::PFBus*>
-        (p_network->getBus(i).get());
-      bus->clearQlim();
-    }
+  buildBusSets();
+  for (i=0; i<p_boundaryBuses.size(); i++) {
+    gridpack::powerflow::PFBus *bus =
+      dynamic_cast<gridpack::powerflow::PFBus*>
+      (p_network->getBus(p_boundaryBuses[i]).get());
+    bus->clearQlim();
   }
-  p_network->updateBuses();
+  p_network->beginBusUpdate();
+  for (i=0; i<p_interiorBuses.size(); i++) {
+    gridpack::powerflow::PFBus *bus =
+      dynamic_cast<gridpack::powerflow::PFBus*>
+      (p_network->getBus(p_interiorBuses[i]).get());
+    bus->clearQlim();
+  }
+  p_network->endBusUpdate();
   for (i=0; i<numBus; i++) {
     if (!p_network->getActiveBus(i)) {
       gridpack::powerflow::PFBus *bus =
@@ -682,6 +706,17 @@ void gridpack::powerflow::PFFactoryModule::clearQlimViolations()
   }
 }
 
+/**
+ * Sort the locally owned buses into interior and boundary buses the first
+ * time they are needed. The sets depend only on the network topology
+ */
+void gridpack::powerflow::PFFactoryModule::buildBusSets()
+{
+  if (p_busSetsBuilt) return;
+  getInteriorAndBoundaryBuses(p_interiorBuses, p_boundaryBuses);
+  p_busSetsBuilt = true;
+}
+
 /**
  * Reinitialize voltages
  */
@@ -699,6 +734,36 @@ void gridpack::powerflow::PFFactoryModule::resetVoltages()
   }
 }
 
+/**
+ * Save current voltages on all buses so that they can be restored later
+ */
+void gridpack::powerflow::PFFactoryModule::saveVoltages()
+{
+  int numBus = p_network->numBuses();
+  int i;
+  for (i=0; i<numBus; i++) {
+    gridpack::powerflow::PFBus *bus =
+      dynamic_cast<gridpack::powerflow::PFBus*>
+      (p_network->getBus(i).get());
+    bus->saveVoltage();
+  }
+}
+
+/**
+ * Restore voltages on all buses to values stored with saveVoltages
+ */
+void gridpack::powerflow::PFFactoryModule::restoreVoltages()
+{
+  int numBus = p_network->numBuses();
+  int i;
+  for (i=0; i<numBus; i++) {
+    gridpack::powerflow::PFBus *bus =
+      dynamic_cast<gridpack::powerflow::PFBus*>
+      (p_network->getBus(i).get());
+    bus->restoreVoltage();
+  }
+}
+
 /**
  * Scale generator real power. If zone less than 1 then scale all
  * generators in the area.
@@ -167,6 +167,16 @@ class PFFactoryModule
      */
     void resetVoltages();
 
+    /**
+     * Save current voltages on all buses so that they can be restored later
+     */
+    void saveVoltages();
+
+    /**
+     * Restore voltages on all buses to values stored with saveVoltages
+     */
+    void restoreVoltages();
+
     /**
      * Scale generator real power. If zone less than 1 then scale all
      * generators in the area
@@ -251,6 +261,19 @@ class PFFactoryModule
     std::vector<Violation> p_violations;
 
     bool p_rateB;
+
+    /**
+     * Sort the locally owned buses into interior and boundary buses if this
+     * has not already been done
+     */
+    void buildBusSets();
+
+    // Locally owned buses that are not connected to any ghost buses or
+    // branches and those that are. Used to overlap Q limit checks with
+    // ghost updates
+    std::vector<int> p_interiorBuses;
+    std::vector<int> p_boundaryBuses;
+    bool p_busSetsBuilt;
 };
 
 } // powerflow
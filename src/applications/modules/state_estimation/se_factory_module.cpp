@@ -33,6 +33,8 @@ SEFactoryModule::SEFactoryModule(SEFactoryModule::NetworkPtr network)
   : gridpack::factory::BaseFactory<SENetwork>(network)
 {
   p_network = network;
+  p_busPlan = -1;
+  p_branchPlan = -1;
 }
 
 /**
@@ -63,7 +65,9 @@ void gridpack::state_estimation::SEFactoryModule::setYBus(void)
 }
 
 /**
- * Disribute measurements
+ * Disribute measurements. The routing of measurements to buses and
+ * branches is kept between calls and only rebuilt if the list of measured
+ * buses or branches changes
  * @param measurements a vector containing all measurements
  */
 void gridpack::state_estimation::SEFactoryModule::setMeasurements(
@@ -95,16 +99,34 @@ void gridpack::state_estimation::SEFactoryModule::setMeasurements(
       branch_keys.push_back(key);
     }
   }
-  gridpack::hash_distr::HashDistribution<SENetwork,Measurement,Measurement>
-    distr(p_network);
-  distr.distributeBusValues(bus_keys,bus_meas);
+  if (!p_distr) {
+    p_distr.reset(new gridpack::hash_distr::HashDistribution<SENetwork,
+        Measurement,Measurement>(p_network));
+  }
+  // Creating plans is collective, so rebuild them on all processors if the
+  // keys have changed on any processor
+  int changed[2];
+  changed[0] = (p_busPlan < 0 || bus_keys != p_busPlanKeys) ? 1 : 0;
+  changed[1] = (p_branchPlan < 0 || branch_keys != p_branchPlanKeys) ? 1 : 0;
+  p_network->communicator().sum(changed,2);
+  if (changed[0] > 0) {
+    p_distr->destroyPlan(p_busPlan);
+    p_busPlan = p_distr->createBusPlan(bus_keys);
+    p_busPlanKeys = bus_keys;
+  }
+  if (changed[1] > 0) {
+    p_distr->destroyPlan(p_branchPlan);
+    p_branchPlan = p_distr->createBranchPlan(branch_keys);
+    p_branchPlanKeys = branch_keys;
+  }
+  p_distr->distributeBusValues(p_busPlan,bus_keys,bus_meas);
   int nsize = bus_keys.size();
   for (i=0; i<nsize; i++) {
     p_network->getBus(bus_keys[i])->addMeasurement(bus_meas[i]);
   }
   bus_keys.clear();
   bus_meas.clear();
-  distr.distributeBranchValues(branch_keys,branch_ids,branch_meas);
+  p_distr->distributeBranchValues(p_branchPlan,branch_ids,branch_meas);
   branch_keys.clear();
   nsize = branch_ids.size();
   for (i=0; i<nsize; i++) {
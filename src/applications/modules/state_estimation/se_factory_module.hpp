@@ -20,6 +20,7 @@
 
 #include "boost/smart_ptr/shared_ptr.hpp"
 #include "gridpack/factory/base_factory.hpp"
+#include "gridpack/parser/hash_distr.hpp"
 #include "gridpack/applications/components/se_matrix/se_components.hpp"
 
 namespace gridpack {
@@ -45,7 +46,9 @@ class SEFactoryModule
     void setYBus(void);
 
     /**
-     * Disribute measurements
+     * Disribute measurements. The routing of measurements to buses and
+     * branches is kept between calls and only rebuilt if the list of
+     * measured buses or branches changes
      * @param measurements a vector containing all measurements
      */
     void setMeasurements(std::vector<Measurement> measurements);
@@ -58,6 +61,15 @@ class SEFactoryModule
   private:
 
     NetworkPtr p_network;
+
+    // Distribution plans for the measured buses and branches on this
+    // processor and the keys used to create them
+    boost::shared_ptr<gridpack::hash_distr::HashDistribution<SENetwork,
+      Measurement,Measurement> > p_distr;
+    int p_busPlan;
+    int p_branchPlan;
+    std::vector<int> p_busPlanKeys;
+    std::vector<std::pair<int,int> > p_branchPlanKeys;
 };
 
 } // state_estimation
@@ -20,6 +20,7 @@
 
 #include "gridpack/include/gridpack.hpp"
 #include "gridpack/applications/modules/powerflow/pf_app_module.hpp"
+#include "gridpack/applications/modules/powerflow/dc_screen_module.hpp"
 #include "rtpr_driver.hpp"
 
 #define RTPR_DEBUG
@@ -839,6 +840,11 @@ void gridpack::rtpr::RTPRDriver::execute(int argc, char** argv, gridpack::Enviro
     printf("Using Branch Rating B parameter for checking line overloads\n");
   }
 
+  // Only run AC calculations for contingencies flagged by DC screening
+  p_screenCtgs = cursor->get("screenContingencies",false);
+  p_screenThreshold = cursor->get("screeningThreshold",0.9);
+  p_screenCacheLines = cursor->get("screeningCacheLines",256);
+
   // TODO: Set these values from input deck
   double start;
   if (!cursor->get("contingencyDSStart",&start)) {
@@ -1234,6 +1240,44 @@ bool gridpack::rtpr::RTPRDriver::runContingencies()
   if (ntasks == 0) {
     return chkSolve;
   }
+
+  // Screen contingencies using DC sensitivities. Contingencies that are not
+  // flagged cannot overload any lines and are removed from the list before
+  // the task manager is set up, so the statistics and success records only
+  // cover contingencies that were evaluated. The DC model has no voltage
+  // magnitudes, so voltage violations are not checked for removed
+  // contingencies
+  std::vector<gridpack::powerflow::Contingency> events;
+  if (p_screenCtgs) {
+    gridpack::utility::CoarseTimer *timer =
+      gridpack::utility::CoarseTimer::instance();
+    gridpack::utility::Configuration *config =
+      gridpack::utility::Configuration::configuration();
+    gridpack::powerflow::DCScreenModule dc_screen;
+    dc_screen.setThreshold(p_screenThreshold);
+    dc_screen.useRateB(p_useRateB);
+    dc_screen.setCacheLimit(p_screenCacheLines);
+    dc_screen.setNetwork(p_pf_network,
+        config->getCursor("Configuration.Powerflow"));
+    std::vector<double> loading;
+    double t_start = timer->currentTime();
+    dc_screen.screen(p_events, p_world, loading);
+    double t_screen = timer->currentTime()-t_start;
+    p_world.max(&t_screen,1);
+    int k;
+    for (k=0; k<ntasks; k++) {
+      if (dc_screen.isFlagged(loading[k])) events.push_back(p_events[k]);
+    }
+    int nflagged = events.size();
+    if (p_world.rank() == 0) {
+      printf("DC screening of %d contingencies: %f seconds"
+          " (%f contingencies/second), %d flagged\n",ntasks,t_screen,
+          t_screen > 0.0 ? ntasks/t_screen : 0.0,nflagged);
+    }
+    ntasks = nflagged;
+  } else {
+    events = p_events;
+  }
   taskmgr.set(ntasks);
 #ifdef USE_STATBLOCK
   gridpack::utility::StringUtils util;
@@ -1301,7 +1345,7 @@ bool gridpack::rtpr::RTPRDriver::runContingencies()
     }
 #endif
     printf("Executing task %d on process %d\n",task_id,p_world.rank());
-    sprintf(sbuf,"%s_%f.out",p_events[task_id].p_name.c_str(),fabs(p_rating));
+    sprintf(sbuf,"%s_%f.out",events[task_id].p_name.c_str(),fabs(p_rating));
     // Open a new file, based on the contingency name, to store results from
     // this particular contingency calculation
     if (p_print_calcs) p_pf_app.open(sbuf);
@@ -1309,34 +1353,34 @@ bool gridpack::rtpr::RTPRDriver::runContingencies()
     // information on the contingency
     sprintf(sbuf,"\nRunning task on %d processes\n",p_task_comm.size());
     if (p_print_calcs) p_pf_app.writeHeader(sbuf);
-    if (p_events[task_id].p_type == Branch) {
-      int nlines = p_events[task_id].p_from.size();
+    if (events[task_id].p_type == Branch) {
+      int nlines = events[task_id].p_from.size();
       int j;
       for (j=0; j<nlines; j++) {
         sprintf(sbuf," Line: (from) %d (to) %d (line) \'%s\'\n",
-            p_events[task_id].p_from[j],p_events[task_id].p_to[j],
-            p_events[task_id].p_ckt[j].c_str());
+            events[task_id].p_from[j],events[task_id].p_to[j],
+            events[task_id].p_ckt[j].c_str());
         printf("p[%d] Line: (from) %d (to) %d (line) \'%s\'\n",
             p_pf_network->communicator().rank(),
-            p_events[task_id].p_from[j],p_events[task_id].p_to[j],
-            p_events[task_id].p_ckt[j].c_str());
+            events[task_id].p_from[j],events[task_id].p_to[j],
+            events[task_id].p_ckt[j].c_str());
       }
-    } else if (p_events[task_id].p_type == Generator) {
-      int nbus = p_events[task_id].p_busid.size();
+    } else if (events[task_id].p_type == Generator) {
+      int nbus = events[task_id].p_busid.size();
       int j;
       for (j=0; j<nbus; j++) {
         sprintf(sbuf," Generator: (bus) %d (generator ID) \'%s\'\n",
-            p_events[task_id].p_busid[j],p_events[task_id].p_genid[j].c_str());
+            events[task_id].p_busid[j],events[task_id].p_genid[j].c_str());
         printf("p[%d] Generator: (bus) %d (generator ID) \'%s\'\n",
             p_pf_network->communicator().rank(),
-            p_events[task_id].p_busid[j],p_events[task_id].p_genid[j].c_str());
+            events[task_id].p_busid[j],events[task_id].p_genid[j].c_str());
       }
     }
     if (p_print_calcs) p_pf_app.writeHeader(sbuf);
     // Reset all voltages back to their original values
     p_pf_app.resetVoltages();
     // Set contingency
-    p_pf_app.setContingency(p_events[task_id]);
+    p_pf_app.setContingency(events[task_id]);
     // Solve power flow equations for this system
 #ifdef USE_SUCCESS
     contingency_idx.push_back(task_id);
@@ -1362,20 +1406,20 @@ bool gridpack::rtpr::RTPRDriver::runContingencies()
       // Include results of violation checks in output
       if (ok) {
         sprintf(sbuf,"\nNo violation for contingency %s\n",
-            p_events[task_id].p_name.c_str());
+            events[task_id].p_name.c_str());
 #ifdef USE_SUCCESS
         contingency_violation.push_back(1);
 #endif
       } 
       if (!ok1) {
         sprintf(sbuf,"\nBus Violation for contingency %s\n",
-            p_events[task_id].p_name.c_str());
+            events[task_id].p_name.c_str());
       }
       if (p_print_calcs) p_pf_app.print(sbuf);
       if (p_print_calcs) p_pf_app.writeCABus();
       if (!ok2) {
         sprintf(sbuf,"\nBranch Violation for contingency %s\n",
-            p_events[task_id].p_name.c_str());
+            events[task_id].p_name.c_str());
       }
 
 #ifdef USE_SUCCESS
@@ -1418,7 +1462,7 @@ bool gridpack::rtpr::RTPRDriver::runContingencies()
       violationDesc = p_pf_app.getContingencyFailures();
       nsize = violationDesc.size();
       if (nsize>0) {
-        sprintf(sbuf,"%s_%f.desc",p_events[task_id].p_name.c_str(),p_rating);
+        sprintf(sbuf,"%s_%f.desc",events[task_id].p_name.c_str(),p_rating);
         if (p_task_comm.rank() == 0) {
           int i;
           std::ofstream fout;
@@ -1440,7 +1484,7 @@ bool gridpack::rtpr::RTPRDriver::runContingencies()
       contingency_violation.push_back(0);
 #endif
       sprintf(sbuf,"\nDivergent for contingency %s\n",
-          p_events[task_id].p_name.c_str());
+          events[task_id].p_name.c_str());
       if (p_print_calcs) p_pf_app.print(sbuf);
 #ifdef USE_STATBLOCK
       pflow.clear();
@@ -1466,7 +1510,7 @@ bool gridpack::rtpr::RTPRDriver::runContingencies()
 #endif
     } 
     // Return network to its original base case state
-    p_pf_app.unSetContingency(p_events[task_id]);
+    p_pf_app.unSetContingency(events[task_id]);
     // Close output file for this contingency
     if (p_print_calcs) p_pf_app.close();
   }
@@ -1498,7 +1542,7 @@ bool gridpack::rtpr::RTPRDriver::runContingencies()
     fout.open(sbuf);
     for (i=0; i<ntasks; i++) {
       if (contingency_success[i]) {
-        fout << "contingency: " << p_events[i].p_name << " success: true";
+        fout << "contingency: " << events[i].p_name << " success: true";
         if (contingency_violation[i] == 1) {
           fout << " violation: none" << std::endl;
         } else if (contingency_violation[i] == 2) {
@@ -1509,7 +1553,7 @@ bool gridpack::rtpr::RTPRDriver::runContingencies()
           fout << " violation: bus and branch" << std::endl;
         }
       } else {
-        fout << "contingency: " << p_events[i].p_name
+        fout << "contingency: " << events[i].p_name
           << " success: false" << std::endl;
       }
     }
@@ -211,6 +211,11 @@ class RTPRDriver
 
     bool p_useRateB;
 
+    // Screen contingencies with DC sensitivities before AC calculations
+    bool p_screenCtgs;
+    double p_screenThreshold;
+    int p_screenCacheLines;
+
     std::vector<int> p_watch_busIDs;
     std::vector<std::string> p_watch_genIDs;
 
@@ -432,7 +432,8 @@ void GenMatVecInterface::slabSetValues(RealType **values)
  * Simple constructor
  */
 BaseComponent::BaseComponent(void)
-  : p_XCBuf(NULL), p_XCBufSize(0), p_mode(-1), p_rank(-1)
+  : p_XCBuf(NULL), p_XCBufSize(0), p_XCChanged(NULL), p_XCTracking(false),
+    p_mode(-1), p_rank(-1)
 {
 }
 
@@ -455,6 +456,17 @@ void BaseComponent::load(
   // a generic load method can be defined in the base factory class.
 }
 
+/**
+ * Restore pointers to the data collection after the network has been
+ * repartitioned by BaseFactory::rebalance
+ * @param data data collection associated with component
+ */
+void BaseComponent::rebind(
+  const boost::shared_ptr<DataCollection> &data)
+{
+  // No-op. Components that store pointers in load must override this
+}
+
 /**
  * Return the size of the buffer needed for data exchanges. Note that this
  * must be the same size for all bus and all branch objects (branch buffers
@@ -491,6 +503,43 @@ void BaseComponent::getXCBuf(void **buf)
   *buf = NULL;
 }
 
+/**
+ * Assign the location of the flag that marks the data exchange buffer as
+ * changed
+ * @param flag pointer to flag
+ */
+void BaseComponent::setXCChangedFlag(char *flag)
+{
+  p_XCChanged = flag;
+}
+
+/**
+ * Mark the data exchange buffer as changed
+ */
+void BaseComponent::setXCBufChanged(void)
+{
+  if (p_XCChanged != NULL) *p_XCChanged = 1;
+}
+
+/**
+ * Declare that the component calls setXCBufChanged whenever it modifies
+ * its exchange buffer
+ * @param flag if true, component marks changes to its exchange buffer
+ */
+void BaseComponent::setXCChangeTracking(bool flag)
+{
+  p_XCTracking = flag;
+}
+
+/**
+ * Report whether the component marks changes to its exchange buffer
+ * @return true if component calls setXCBufChanged
+ */
+bool BaseComponent::getXCChangeTracking(void) const
+{
+  return p_XCTracking;
+}
+
 /**
  * Set an internal variable that can be used to control the behavior of the
  * component. This function doesn't need to be implemented, but if needed,
@@ -534,6 +583,22 @@ bool BaseComponent::getDataItem(void *data, const char *signal)
   return false;
 }
 
+/**
+ * Return numerical values from component. This is the numerical
+ * counterpart of serialWrite and can be used to collect results without
+ * formatting and parsing strings. A component can return several
+ * records (e.g. one for each generator on a bus), each containing the
+ * same number of values
+ * @param values vector that values are appended to
+ * @param signal string to control behavior of routine (e.g. what
+ * values to return)
+ * @return number of records appended to values
+ */
+int BaseComponent::getValues(std::vector<double> &values, const char *signal)
+{
+  return 0;
+}
+
 /**
  * Save state variables inside the component to a DataCollection object.
  * This can be used as a way of moving data in a way that is useful for
@@ -714,6 +779,21 @@ int BaseBusComponent::getGlobalIndex(void) const
   return p_globalIndex;
 }
 
+/**
+ * Estimate the computational cost of the bus. These estimates are used
+ * as weights when the network is partitioned
+ * @param data data collection associated with bus
+ * @param rows number of rows contributed by the bus to matrices
+ * @param work relative amount of work done by the bus in each step
+ */
+void BaseBusComponent::estimateCost(
+    const boost::shared_ptr<gridpack::component::DataCollection> &data,
+    int *rows, int *work)
+{
+  *rows = 1;
+  *work = 1;
+}
+
 // Base implementation for a branch object. Provides a mechanism for the branch to
 // provide the buses at either end of the branch
 
@@ -875,5 +955,20 @@ int BaseBranchComponent::getGlobalIndex(void) const
   return p_globalIndex;
 }
 
+/**
+ * Estimate the computational cost of the branch. These estimates are used
+ * as weights when the network is partitioned
+ * @param data data collection associated with branch
+ * @param rows number of rows contributed by the branch to matrices
+ * @param work relative amount of work done by the branch in each step
+ */
+void BaseBranchComponent::estimateCost(
+    const boost::shared_ptr<gridpack::component::DataCollection> &data,
+    int *rows, int *work)
+{
+  *rows = 0;
+  *work = 0;
+}
+
 }  // component
 }  // gridpack
@@ -351,6 +351,19 @@ class GenMatVecInterface {
 //  class BaseComponent:
 //  This class implements some basic functions that can be
 //  expected from any component on the network.
+//
+//  Thread safety: if GridPACK is built with OpenMP and the number
+//  of threads is set using gridpack::Threads, the factories and
+//  mappers call setMode, the matrix and vector size and values
+//  functions, setValues and the dynamic simulation predictor and
+//  corrector functions on different components at the same time.
+//  load is always called serially. Implementations of these functions may only
+//  modify the component itself and objects that it owns (for
+//  example, its generator and load models). They must not call
+//  MPI, GA or math library functions and must not write to
+//  static or global variables. Values may be read from data
+//  collections but new fields must not be added. Neighboring
+//  buses and branches may be read but not modified.
 // -------------------------------------------------------------
 class BaseComponent
   : public MatVecInterface, public GenMatVecInterface {
@@ -373,6 +386,17 @@ class BaseComponent
     virtual void load(
         const boost::shared_ptr<gridpack::component::DataCollection> &data);
 
+    /**
+     * Restore pointers to the data collection after the network has been
+     * repartitioned by BaseFactory::rebalance. A component that has been
+     * moved to another processor only keeps the state included in its
+     * serialize method, so any pointer that load stores must be set again
+     * here. The default implementation does nothing
+     * @param data data collection associated with component
+     */
+    virtual void rebind(
+        const boost::shared_ptr<gridpack::component::DataCollection> &data);
+
     /**
      * Return the size of the buffer needed for data exchanges. Note that this
      * must be the same size for all bus and all branch objects (branch buffers
@@ -397,6 +421,35 @@ class BaseComponent
      */
     virtual void getXCBuf(void **bus);
 
+    /**
+     * Assign the location of the flag that marks the data exchange buffer as
+     * changed. These flags are allocated and deallocated by the network
+     * @param flag pointer to flag
+     */
+    void setXCChangedFlag(char *flag);
+
+    /**
+     * Mark the data exchange buffer as changed. If the network is only
+     * exchanging changed buffers, this must be called whenever a component
+     * modifies the contents of its exchange buffer
+     */
+    void setXCBufChanged(void);
+
+    /**
+     * Declare that the component calls setXCBufChanged whenever it modifies
+     * its exchange buffer. If the network is only exchanging changed
+     * buffers, the buffers of components that do not track changes are sent
+     * in every update. The default is false
+     * @param flag if true, component marks changes to its exchange buffer
+     */
+    void setXCChangeTracking(bool flag);
+
+    /**
+     * Report whether the component marks changes to its exchange buffer
+     * @return true if component calls setXCBufChanged
+     */
+    bool getXCChangeTracking(void) const;
+
     /**
      * Set an internal variable that can be used to control the behavior of the
      * component. This function doesn't need to be implemented, but if needed,
@@ -438,6 +491,19 @@ class BaseComponent
      */
     virtual bool getDataItem(void *data, const char *signal = NULL);
 
+    /**
+     * Return numerical values from component. This is the numerical
+     * counterpart of serialWrite and can be used to collect results without
+     * formatting and parsing strings. A component can return several
+     * records (e.g. one for each generator on a bus), each containing the
+     * same number of values
+     * @param values vector that values are appended to
+     * @param signal string to control behavior of routine (e.g. what
+     * values to return)
+     * @return number of records appended to values
+     */
+    virtual int getValues(std::vector<double> &values, const char *signal = NULL);
+
     /**
      * Set rank holding the component
      * @param rank processor rank holding the component
@@ -462,6 +528,17 @@ class BaseComponent
      */
      int p_XCBufSize;
 
+    /**
+     * Flag that marks exchange buffer as changed. This is allocated by the
+     * network
+     */
+     char *p_XCChanged;
+
+    /**
+     * Component marks changes to its exchange buffer
+     */
+     bool p_XCTracking;
+
      /**
       * Current mode
       */
@@ -485,6 +562,7 @@ class BaseComponent
     ar << boost::serialization::base_object<MatVecInterface>(*this)
        << boost::serialization::base_object<GenMatVecInterface>(*this)
        << p_XCBufSize
+       << p_XCTracking
        << p_mode;
   }
 
@@ -495,6 +573,7 @@ class BaseComponent
     ar >> boost::serialization::base_object<MatVecInterface>(*this)
        >> boost::serialization::base_object<GenMatVecInterface>(*this)
        >> p_XCBufSize
+       >> p_XCTracking
        >> p_mode;
   }
 
@@ -586,6 +665,21 @@ class BaseBusComponent
      */
     int getGlobalIndex(void) const;
 
+    /**
+     * Estimate the computational cost of the bus. These estimates are used
+     * as weights when the network is partitioned. This is called before
+     * the load method, so the estimate must be based on the contents of
+     * the data collection. The default is one matrix row and one unit of
+     * work
+     * @param data data collection associated with bus
+     * @param rows number of rows contributed by the bus to matrices
+     * @param work relative amount of work done by the bus in each step,
+     *        apart from matrix operations
+     */
+    virtual void estimateCost(
+        const boost::shared_ptr<gridpack::component::DataCollection> &data,
+        int *rows, int *work);
+
   private:
     /**
      * Branches that are connect to bus
@@ -722,6 +816,21 @@ class BaseBranchComponent
      */
     int getGlobalIndex(void) const;
 
+    /**
+     * Estimate the computational cost of the branch. These estimates are
+     * used as weights when the network is partitioned and are added to the
+     * cost of the bus that the branch is assigned to. This is called before
+     * the load method, so the estimate must be based on the contents of the
+     * data collection. The default is no rows and no work
+     * @param data data collection associated with branch
+     * @param rows number of rows contributed by the branch to matrices
+     * @param work relative amount of work done by the branch in each step,
+     *        apart from matrix operations
+     */
+    virtual void estimateCost(
+        const boost::shared_ptr<gridpack::component::DataCollection> &data,
+        int *rows, int *work);
+
   private:
     /**
      *  Pointers to buses at either end of branch
@@ -6,6 +6,244 @@
 #include "gridpack/component/data_collection.hpp"
 #include <iostream>
 #include <cstdio>
+#include <cstring>
+#include <deque>
+
+namespace {
+
+/**
+ * Global table of interned field names. Names are hashed directly from the
+ * C string using FNV-1a and stored in an open addressing table, so looking
+ * up a name does not require any memory allocation. The table is never
+ * cleared, so IDs remain valid for the life of the process.
+ *
+ * Components are loaded serially, so names are only added to the table
+ * by one thread. Component functions that are called from several OpenMP
+ * threads at once may read data collections, which only looks up names,
+ * but must not add new fields (see BaseComponent). The table therefore
+ * does not need any locks
+ */
+class KeyTable {
+public:
+  KeyTable(void)
+  {
+    p_slots.resize(1024,-1);
+  }
+
+  /**
+   * Find ID of name without adding it to the table
+   * @param name field name
+   * @return field ID or -1 if name is not in the table
+   */
+  int lookup(const char *name)
+  {
+    unsigned int slot;
+    return p_lookup(name, p_hash(name), &slot);
+  }
+
+  /**
+   * Find ID of name, adding it to the table if it is not already present
+   * @param name field name
+   * @return field ID
+   */
+  int find(const char *name)
+  {
+    unsigned int hash = p_hash(name);
+    unsigned int slot;
+    int id = p_lookup(name, hash, &slot);
+    if (id < 0) {
+      id = p_names.size();
+      p_names.push_back(std::string(name));
+      p_hashes.push_back(hash);
+      p_slots[slot] = id;
+      // keep load factor below one half
+      if (2*p_names.size() > p_slots.size()) p_rehash();
+    }
+    return id;
+  }
+
+  /**
+   * Return name corresponding to ID. Names are stored in a deque, so the
+   * reference stays valid when other names are added
+   * @param id field ID
+   * @return field name
+   */
+  const std::string& name(int id)
+  {
+    return p_names[id];
+  }
+
+  /**
+   * Number of names in table
+   */
+  int size(void)
+  {
+    return p_names.size();
+  }
+
+private:
+
+  /**
+   * Find name in table
+   * @param name field name
+   * @param hash hash of name
+   * @param slot slot holding name or first empty slot
+   * @return field ID or -1 if name is not in the table
+   */
+  int p_lookup(const char *name, unsigned int hash, unsigned int *slot) const
+  {
+    unsigned int mask = p_slots.size()-1;
+    *slot = hash&mask;
+    while (p_slots[*slot] >= 0) {
+      int id = p_slots[*slot];
+      if (p_hashes[id] == hash && strcmp(p_names[id].c_str(),name) == 0) {
+        return id;
+      }
+      *slot = (*slot+1)&mask;
+    }
+    return -1;
+  }
+
+  unsigned int p_hash(const char *name) const
+  {
+    unsigned int hash = 2166136261u;
+    while (*name != '\0') {
+      hash ^= static_cast<unsigned char>(*name);
+      hash *= 16777619u;
+      name++;
+    }
+    return hash;
+  }
+
+  void p_rehash(void)
+  {
+    int i;
+    p_slots.assign(2*p_slots.size(),-1);
+    unsigned int mask = p_slots.size()-1;
+    int nnames = p_names.size();
+    for (i=0; i<nnames; i++) {
+      unsigned int slot = p_hashes[i]&mask;
+      while (p_slots[slot] >= 0) slot = (slot+1)&mask;
+      p_slots[slot] = i;
+    }
+  }
+
+  std::vector<int> p_slots;
+  std::deque<std::string> p_names;
+  std::vector<unsigned int> p_hashes;
+};
+
+/**
+ * Return global key table. The table is created on first use so that it is
+ * available to DataCollection objects created during static initialization
+ */
+KeyTable& keyTable(void)
+{
+  static KeyTable table;
+  return table;
+}
+
+/**
+ * Add value to table if no entry with the same field ID and index exists
+ */
+template <typename T>
+void insertValue(std::vector<gridpack::component::DataCollectionEntry<T> > &table,
+    int field, int idx, const T &value)
+{
+  gridpack::component::DataCollectionEntry<T> entry;
+  entry.field = field;
+  entry.idx = idx;
+  typename std::vector<gridpack::component::DataCollectionEntry<T> >::iterator
+    it = std::lower_bound(table.begin(), table.end(), entry);
+  if (it != table.end() && it->field == field && it->idx == idx) return;
+  entry.value = value;
+  table.insert(it, entry);
+}
+
+/**
+ * Find entry with field ID and index. Returns NULL if entry does not exist
+ */
+template <typename T>
+gridpack::component::DataCollectionEntry<T>* findValue(
+    std::vector<gridpack::component::DataCollectionEntry<T> > &table,
+    int field, int idx)
+{
+  gridpack::component::DataCollectionEntry<T> entry;
+  entry.field = field;
+  entry.idx = idx;
+  typename std::vector<gridpack::component::DataCollectionEntry<T> >::iterator
+    it = std::lower_bound(table.begin(), table.end(), entry);
+  if (it != table.end() && it->field == field && it->idx == idx) return &(*it);
+  return NULL;
+}
+
+/**
+ * Modify existing value
+ */
+template <typename T>
+bool setEntry(std::vector<gridpack::component::DataCollectionEntry<T> > &table,
+    int field, int idx, const T &value)
+{
+  gridpack::component::DataCollectionEntry<T> *entry
+    = findValue(table, field, idx);
+  if (entry == NULL) return false;
+  entry->value = value;
+  return true;
+}
+
+/**
+ * Retrieve existing value
+ */
+template <typename T>
+bool getEntry(std::vector<gridpack::component::DataCollectionEntry<T> > &table,
+    int field, int idx, T *value)
+{
+  gridpack::component::DataCollectionEntry<T> *entry
+    = findValue(table, field, idx);
+  if (entry == NULL) return false;
+  *value = entry->value;
+  return true;
+}
+
+/**
+ * Print contents of table in the form "name" or "name:idx"
+ */
+template <typename T>
+void dumpTable(const std::vector<gridpack::component::DataCollectionEntry<T> > &table,
+    const char *type)
+{
+  int i;
+  int nsize = table.size();
+  for (i=0; i<nsize; i++) {
+    std::cout << "  ("<<type<<") key: "
+      <<gridpack::component::DataCollection::fieldName(table[i].field);
+    if (table[i].idx != gridpack::component::DataCollectionEntry<T>::NO_INDEX) {
+      std::cout << ":" << table[i].idx;
+    }
+    std::cout <<" value: "<<table[i].value<<std::endl;
+  }
+}
+
+/**
+ * Append field IDs used in table to list
+ */
+template <typename T>
+void addFields(const std::vector<gridpack::component::DataCollectionEntry<T> > &table,
+    std::vector<int> &fields)
+{
+  int i;
+  int nsize = table.size();
+  for (i=0; i<nsize; i++) {
+    if (i == 0 || table[i].field != table[i-1].field) {
+      fields.push_back(table[i].field);
+    }
+  }
+}
+
+// Index used for values that are added without an index
+const int NOIDX = gridpack::component::DataCollectionEntry<int>::NO_INDEX;
+
+} // anonymous namespace
 
 /**
  * Simple constructor
@@ -38,52 +276,52 @@ gridpack::component::DataCollection & gridpack::component::DataCollection::opera
   return *this;
 }
 
+
 /**
  *  Add variables to DataCollection object
  *  @param name name given to data element
  *  @param value value of data element
  */
-void gridpack::component::DataCollection::addValue(const char *name, const int value)
+void gridpack::component::DataCollection::addValue(const char *name,
+    const int value)
 {
-  std::string str = name;
-  p_ints.insert(std::pair<std::string, int>(str,value));
+  insertValue(p_ints, fieldId(name), NOIDX, value);
 }
 
-void gridpack::component::DataCollection::addValue(const char *name, const long value)
+void gridpack::component::DataCollection::addValue(const char *name,
+    const long value)
 {
-  std::string str = name;
-  p_longs.insert(std::pair<std::string, long>(str,value));
+  insertValue(p_longs, fieldId(name), NOIDX, value);
 }
 
-void gridpack::component::DataCollection::addValue(const char *name, const bool value)
+void gridpack::component::DataCollection::addValue(const char *name,
+    const bool value)
 {
-  std::string str = name;
-  p_bools.insert(std::pair<std::string, bool>(str,value));
+  insertValue(p_bools, fieldId(name), NOIDX, value);
 }
 
-void gridpack::component::DataCollection::addValue(const char *name, const char *value)
+void gridpack::component::DataCollection::addValue(const char *name,
+    const char *value)
 {
-  std::string str = name;
-  std::string val = value;
-  p_strings.insert(std::pair<std::string, std::string>(str,val));
+  insertValue(p_strings, fieldId(name), NOIDX, std::string(value));
 }
 
-void gridpack::component::DataCollection::addValue(const char *name, const float value)
+void gridpack::component::DataCollection::addValue(const char *name,
+    const float value)
 {
-  std::string str = name;
-  p_floats.insert(std::pair<std::string, float>(str,value));
+  insertValue(p_floats, fieldId(name), NOIDX, value);
 }
 
-void gridpack::component::DataCollection::addValue(const char *name, const double value)
+void gridpack::component::DataCollection::addValue(const char *name,
+    const double value)
 {
-  std::string str = name;
-  p_doubles.insert(std::pair<std::string, double>(str,value));
+  insertValue(p_doubles, fieldId(name), NOIDX, value);
 }
 
-void gridpack::component::DataCollection::addValue(const char *name, const gridpack::ComplexType value)
+void gridpack::component::DataCollection::addValue(const char *name,
+    const gridpack::ComplexType value)
 {
-  std::string str = name;
-  p_complexType.insert(std::pair<std::string, gridpack::ComplexType>(str,value));
+  insertValue(p_complexType, fieldId(name), NOIDX, value);
 }
 
 /**
@@ -94,82 +332,46 @@ void gridpack::component::DataCollection::addValue(const char *name, const gridp
  *  @param value value of data element
  *  @param idx index of value
  */
-void gridpack::component::DataCollection::addValue(const char *name, const int value,
-    const int idx)
+void gridpack::component::DataCollection::addValue(const char *name,
+    const int value, const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-  p_ints.insert(std::pair<std::string, int>(str,value));
+  insertValue(p_ints, fieldId(name), idx, value);
 }
 
-void gridpack::component::DataCollection::addValue(const char *name, const long value,
-    const int idx)
+void gridpack::component::DataCollection::addValue(const char *name,
+    const long value, const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-  p_longs.insert(std::pair<std::string, long>(str,value));
+  insertValue(p_longs, fieldId(name), idx, value);
 }
 
-void gridpack::component::DataCollection::addValue(const char *name, const bool value,
-    const int idx)
+void gridpack::component::DataCollection::addValue(const char *name,
+    const bool value, const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-  p_bools.insert(std::pair<std::string, bool>(str,value));
+  insertValue(p_bools, fieldId(name), idx, value);
 }
 
-void gridpack::component::DataCollection::addValue(const char *name, const char *value,
-    const int idx)
+void gridpack::component::DataCollection::addValue(const char *name,
+    const char *value, const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-  std::string val = value;
-  p_strings.insert(std::pair<std::string, std::string>(str,val));
+  insertValue(p_strings, fieldId(name), idx, std::string(value));
 }
 
-void gridpack::component::DataCollection::addValue(const char *name, const float value,
-    const int idx)
+void gridpack::component::DataCollection::addValue(const char *name,
+    const float value, const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-  p_floats.insert(std::pair<std::string, float>(str,value));
+  insertValue(p_floats, fieldId(name), idx, value);
 }
 
-void gridpack::component::DataCollection::addValue(const char *name, const double value,
-    const int idx)
+void gridpack::component::DataCollection::addValue(const char *name,
+    const double value, const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-  p_doubles.insert(std::pair<std::string, double>(str,value));
+  insertValue(p_doubles, fieldId(name), idx, value);
 }
 
 void gridpack::component::DataCollection::addValue(const char *name,
     const gridpack::ComplexType value, const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-  p_complexType.insert(std::pair<std::string, gridpack::ComplexType>(str,value));
+  insertValue(p_complexType, fieldId(name), idx, value);
 }
 
 /**
@@ -180,124 +382,60 @@ void gridpack::component::DataCollection::addValue(const char *name,
  *  @return false if no element of the correct name and type exists in
  *  DataCollection object
  */
-bool gridpack::component::DataCollection::setValue(const char *name, const int value)
-{
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, int>::iterator it;
-#else
-  boost::unordered_map<std::string, int>::iterator it;
-#endif
-  it = p_ints.find(str);
-  if (it != p_ints.end()) {
-    it->second = value;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::setValue(const char *name,
+    const int value)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return setEntry(p_ints, field, NOIDX, value);
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const long value)
-{
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, long>::iterator it;
-#else
-  boost::unordered_map<std::string, long>::iterator it;
-#endif
-  it = p_longs.find(str);
-  if (it != p_longs.end()) {
-    it->second = value;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::setValue(const char *name,
+    const long value)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return setEntry(p_longs, field, NOIDX, value);
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const bool value)
-{
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, bool>::iterator it;
-#else
-  boost::unordered_map<std::string, bool>::iterator it;
-#endif
-  it = p_bools.find(str);
-  if (it != p_bools.end()) {
-    it->second = value;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::setValue(const char *name,
+    const bool value)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return setEntry(p_bools, field, NOIDX, value);
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const char *value)
-{
-  std::string str = name;
-  std::string val = value;
-#ifdef OLD_MAP
-  std::map<std::string, std::string>::iterator it;
-#else
-  boost::unordered_map<std::string, std::string>::iterator it;
-#endif
-  it = p_strings.find(str);
-  if (it != p_strings.end()) {
-    it->second = val;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::setValue(const char *name,
+    const char *value)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return setEntry(p_strings, field, NOIDX, std::string(value));
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const float value)
-{
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, float>::iterator it;
-#else
-  boost::unordered_map<std::string, float>::iterator it;
-#endif
-  it = p_floats.find(str);
-  if (it != p_floats.end()) {
-    it->second = value;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::setValue(const char *name,
+    const float value)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return setEntry(p_floats, field, NOIDX, value);
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const double value)
-{
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, double>::iterator it;
-#else
-  boost::unordered_map<std::string, double>::iterator it;
-#endif
-  it = p_doubles.find(str);
-  if (it != p_doubles.end()) {
-    it->second = value;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::setValue(const char *name,
+    const double value)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return setEntry(p_doubles, field, NOIDX, value);
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const gridpack::ComplexType value)
-{
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, gridpack::ComplexType>::iterator it;
-#else
-  boost::unordered_map<std::string, gridpack::ComplexType>::iterator it;
-#endif
-  it = p_complexType.find(str);
-  if (it != p_complexType.end()) {
-    it->second = value;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::setValue(const char *name,
+    const gridpack::ComplexType value)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return setEntry(p_complexType, field, NOIDX, value);
 }
 
 /**
@@ -310,159 +448,60 @@ bool gridpack::component::DataCollection::setValue(const char *name, const gridp
  *  @return false if no element of the correct name and type exists in
  *  DataCollection object
  */
-bool gridpack::component::DataCollection::setValue(const char *name, const int value,
-    const int idx)
-{
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, int>::iterator it;
-#else
-  boost::unordered_map<std::string, int>::iterator it;
-#endif
-  it = p_ints.find(str);
-  if (it != p_ints.end()) {
-    it->second = value;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::setValue(const char *name,
+    const int value, const int idx)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return setEntry(p_ints, field, idx, value);
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const long value,
-    const int idx)
-{
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, long>::iterator it;
-#else
-  boost::unordered_map<std::string, long>::iterator it;
-#endif
-  it = p_longs.find(str);
-  if (it != p_longs.end()) {
-    it->second = value;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::setValue(const char *name,
+    const long value, const int idx)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return setEntry(p_longs, field, idx, value);
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const bool value,
-    const int idx)
-{
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, bool>::iterator it;
-#else
-  boost::unordered_map<std::string, bool>::iterator it;
-#endif
-  it = p_bools.find(str);
-  if (it != p_bools.end()) {
-    it->second = value;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::setValue(const char *name,
+    const bool value, const int idx)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return setEntry(p_bools, field, idx, value);
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const char *value,
-    const int idx)
-{
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-  std::string val = value;
-#ifdef OLD_MAP
-  std::map<std::string, std::string>::iterator it;
-#else
-  boost::unordered_map<std::string, std::string>::iterator it;
-#endif
-  it = p_strings.find(str);
-  if (it != p_strings.end()) {
-    it->second = val;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::setValue(const char *name,
+    const char *value, const int idx)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return setEntry(p_strings, field, idx, std::string(value));
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const float value,
-    const int idx)
-{
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, float>::iterator it;
-#else
-  boost::unordered_map<std::string, float>::iterator it;
-#endif
-  it = p_floats.find(str);
-  if (it != p_floats.end()) {
-    it->second = value;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::setValue(const char *name,
+    const float value, const int idx)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return setEntry(p_floats, field, idx, value);
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const double value,
-    const int idx)
-{
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, double>::iterator it;
-#else
-  boost::unordered_map<std::string, double>::iterator it;
-#endif
-  it = p_doubles.find(str);
-  if (it != p_doubles.end()) {
-    it->second = value;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::setValue(const char *name,
+    const double value, const int idx)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return setEntry(p_doubles, field, idx, value);
 }
 
 bool gridpack::component::DataCollection::setValue(const char *name,
     const gridpack::ComplexType value, const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, gridpack::ComplexType>::iterator it;
-#else
-  boost::unordered_map<std::string, gridpack::ComplexType>::iterator it;
-#endif
-  it = p_complexType.find(str);
-  if (it != p_complexType.end()) {
-    it->second = value;
-    return true;
-  } else {
-    return false;
-  }
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return setEntry(p_complexType, field, idx, value);
 }
 
 /**
@@ -473,123 +512,60 @@ bool gridpack::component::DataCollection::setValue(const char *name,
  *  @return false if no element of the correct name and type exists in
  *  DataCollection object
  */
-bool gridpack::component::DataCollection::getValue(const char *name, int *value)
-{
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, int>::iterator it;
-#else
-  boost::unordered_map<std::string, int>::iterator it;
-#endif
-  it = p_ints.find(str);
-  if (it != p_ints.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::getValue(const char *name,
+    int *value)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return getEntry(p_ints, field, NOIDX, value);
 }
 
-bool gridpack::component::DataCollection::getValue(const char *name, long *value)
-{
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, long>::iterator it;
-#else
-  boost::unordered_map<std::string, long>::iterator it;
-#endif
-  it = p_longs.find(str);
-  if (it != p_longs.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::getValue(const char *name,
+    long *value)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return getEntry(p_longs, field, NOIDX, value);
 }
 
-bool gridpack::component::DataCollection::getValue(const char *name, bool *value)
-{
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, bool>::iterator it;
-#else
-  boost::unordered_map<std::string, bool>::iterator it;
-#endif
-  it = p_bools.find(str);
-  if (it != p_bools.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::getValue(const char *name,
+    bool *value)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return getEntry(p_bools, field, NOIDX, value);
 }
 
-bool gridpack::component::DataCollection::getValue(const char *name, std::string *value)
-{
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, std::string>::iterator it;
-#else
-  boost::unordered_map<std::string, std::string>::iterator it;
-#endif
-  it = p_strings.find(str);
-  if (it != p_strings.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::getValue(const char *name,
+    std::string *value)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return getEntry(p_strings, field, NOIDX, value);
 }
 
-bool gridpack::component::DataCollection::getValue(const char *name, float *value)
-{
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, float>::iterator it;
-#else
-  boost::unordered_map<std::string, float>::iterator it;
-#endif
-  it = p_floats.find(str);
-  if (it != p_floats.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::getValue(const char *name,
+    float *value)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return getEntry(p_floats, field, NOIDX, value);
 }
 
-bool gridpack::component::DataCollection::getValue(const char *name, double *value)
-{
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, double>::iterator it;
-#else
-  boost::unordered_map<std::string, double>::iterator it;
-#endif
-  it = p_doubles.find(str);
-  if (it != p_doubles.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::getValue(const char *name,
+    double *value)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return getEntry(p_doubles, field, NOIDX, value);
 }
 
-bool gridpack::component::DataCollection::getValue(const char *name, gridpack::ComplexType *value)
-{
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, gridpack::ComplexType>::iterator it;
-#else
-  boost::unordered_map<std::string, gridpack::ComplexType>::iterator it;
-#endif
-  it = p_complexType.find(str);
-  if (it != p_complexType.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::getValue(const char *name,
+    gridpack::ComplexType *value)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return getEntry(p_complexType, field, NOIDX, value);
 }
 
 /**
@@ -602,158 +578,60 @@ bool gridpack::component::DataCollection::getValue(const char *name, gridpack::C
  *  @return false if no element of the correct name and type exists in
  *  DataCollection object
  */
-bool gridpack::component::DataCollection::getValue(const char *name, int *value,
-    const int idx)
-{
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, int>::iterator it;
-#else
-  boost::unordered_map<std::string, int>::iterator it;
-#endif
-  it = p_ints.find(str);
-  if (it != p_ints.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::getValue(const char *name,
+    int *value, const int idx)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return getEntry(p_ints, field, idx, value);
 }
 
-bool gridpack::component::DataCollection::getValue(const char *name, long *value,
-    const int idx)
-{
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, long>::iterator it;
-#else
-  boost::unordered_map<std::string, long>::iterator it;
-#endif
-  it = p_longs.find(str);
-  if (it != p_longs.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::getValue(const char *name,
+    long *value, const int idx)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return getEntry(p_longs, field, idx, value);
 }
 
-bool gridpack::component::DataCollection::getValue(const char *name, bool *value,
-    const int idx)
-{
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, bool>::iterator it;
-  it = p_bools.find(str);
-#else
-  boost::unordered_map<std::string, bool>::iterator it;
-#endif
-  if (it != p_bools.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::getValue(const char *name,
+    bool *value, const int idx)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return getEntry(p_bools, field, idx, value);
 }
 
-bool gridpack::component::DataCollection::getValue(const char *name, std::string *value,
-    const int idx)
-{
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, std::string>::iterator it;
-#else
-  boost::unordered_map<std::string, std::string>::iterator it;
-#endif
-  it = p_strings.find(str);
-  if (it != p_strings.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::getValue(const char *name,
+    std::string *value, const int idx)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return getEntry(p_strings, field, idx, value);
 }
 
-bool gridpack::component::DataCollection::getValue(const char *name, float *value,
-    const int idx)
-{
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, float>::iterator it;
-#else
-  boost::unordered_map<std::string, float>::iterator it;
-#endif
-  it = p_floats.find(str);
-  if (it != p_floats.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::getValue(const char *name,
+    float *value, const int idx)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return getEntry(p_floats, field, idx, value);
 }
 
-bool gridpack::component::DataCollection::getValue(const char *name, double *value,
-    const int idx)
-{
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, double>::iterator it;
-#else
-  boost::unordered_map<std::string, double>::iterator it;
-#endif
-  it = p_doubles.find(str);
-  if (it != p_doubles.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+bool gridpack::component::DataCollection::getValue(const char *name,
+    double *value, const int idx)
+{
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return getEntry(p_doubles, field, idx, value);
 }
 
 bool gridpack::component::DataCollection::getValue(const char *name,
     gridpack::ComplexType *value, const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, gridpack::ComplexType>::iterator it;
-#else
-  boost::unordered_map<std::string, gridpack::ComplexType>::iterator it;
-#endif
-  it = p_complexType.find(str);
-  if (it != p_complexType.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+  int field = findFieldId(name);
+  if (field < 0) return false;
+  return getEntry(p_complexType, field, idx, value);
 }
 
 /**
@@ -761,96 +639,71 @@ bool gridpack::component::DataCollection::getValue(const char *name,
  */
 void gridpack::component::DataCollection::dump(void)
 {
-  // print out integers
-#ifdef OLD_MAP
-  std::map<std::string, int>::iterator int_it;
-#else
-  boost::unordered_map<std::string, int>::iterator int_it;
-#endif
-  int_it = p_ints.begin();
-  int i = 0;
-  while (int_it != p_ints.end()) {
-    std::string key = int_it->first;
-    int ival = int_it->second;
-    std::cout << "  (INTEGER) key: "<<key<<" value: "<<ival<<std::endl;
-    int_it++;
-  }
-  // print out longs
-#ifdef OLD_MAP
-  std::map<std::string, long>::iterator long_it;
-#else
-  boost::unordered_map<std::string, long>::iterator long_it;
-#endif
-  long_it = p_longs.begin();
-  while (long_it != p_longs.end()) {
-    std::string key = long_it->first;
-    long lval = long_it->second;
-    std::cout << "  (LONG) key: "<<key<<" value: "<<lval<<std::endl;
-    long_it++;
-  }
-  // print out bools
-#ifdef OLD_MAP
-  std::map<std::string, bool>::iterator bool_it;
-#else
-  boost::unordered_map<std::string, bool>::iterator bool_it;
-#endif
-  bool_it = p_bools.begin();
-  while (bool_it != p_bools.end()) {
-    std::string key = bool_it->first;
-    bool bval = bool_it->second;
-    std::cout << "  (BOOL) key: "<<key<<" value: "<<bval<<std::endl;
-    bool_it++;
-  }
-  // print out strings
-#ifdef OLD_MAP
-  std::map<std::string, std::string>::iterator str_it;
-#else
-  boost::unordered_map<std::string, std::string>::iterator str_it;
-#endif
-  str_it = p_strings.begin();
-  while (str_it != p_strings.end()) {
-    std::string key = str_it->first;
-    std::string sval = str_it->second;
-    std::cout << "  (STRING) key: "<<key<<" value: "<<sval<<std::endl;
-    str_it++;
-  }
-  // print out floats
-#ifdef OLD_MAP
-  std::map<std::string, float>::iterator flt_it;
-#else
-  boost::unordered_map<std::string, float>::iterator flt_it;
-#endif
-  flt_it = p_floats.begin();
-  while (flt_it != p_floats.end()) {
-    std::string key = flt_it->first;
-    float fval = flt_it->second;
-    std::cout << "  (FLOAT) key: "<<key<<" value: "<<fval<<std::endl;
-    flt_it++;
-  }
-  // print out doubles
-#ifdef OLD_MAP
-  std::map<std::string, double>::iterator dbl_it;
-#else
-  boost::unordered_map<std::string, double>::iterator dbl_it;
-#endif
-  dbl_it = p_doubles.begin();
-  while (dbl_it != p_doubles.end()) {
-    std::string key = dbl_it->first;
-    double dval = dbl_it->second;
-    std::cout << "  (DOUBLE) key: "<<key<<" value: "<<dval<<std::endl;
-    dbl_it++;
-  }
-  // print out complex
-#ifdef OLD_MAP
-  std::map<std::string, gridpack::ComplexType>::iterator cmplx_it;
-#else
-  boost::unordered_map<std::string, gridpack::ComplexType>::iterator cmplx_it;
-#endif
-  cmplx_it = p_complexType.begin();
-  while (cmplx_it != p_complexType.end()) {
-    std::string key = cmplx_it->first;
-    ComplexType cval = cmplx_it->second;
-    std::cout << "  (COMPLEX) key: "<<key<<" value: "<<cval<<std::endl;
-    cmplx_it++;
-  }
+  dumpTable(p_ints, "INTEGER");
+  dumpTable(p_longs, "LONG");
+  dumpTable(p_bools, "BOOL");
+  dumpTable(p_strings, "STRING");
+  dumpTable(p_floats, "FLOAT");
+  dumpTable(p_doubles, "DOUBLE");
+  dumpTable(p_complexType, "COMPLEX");
+}
+
+/**
+ * Return the integer ID of a field name. Names are interned in a global
+ * key table the first time they are seen
+ * @param name name of data element
+ * @return integer ID of name
+ */
+int gridpack::component::DataCollection::fieldId(const char *name)
+{
+  return keyTable().find(name);
+}
+
+/**
+ * Return the integer ID of a field name without adding the name to the
+ * global key table
+ * @param name name of data element
+ * @return integer ID of name or -1 if the name has not been interned
+ */
+int gridpack::component::DataCollection::findFieldId(const char *name)
+{
+  return keyTable().lookup(name);
+}
+
+/**
+ * Return the name corresponding to an integer field ID
+ * @param id field ID returned by fieldId
+ * @return name of data element
+ */
+const std::string& gridpack::component::DataCollection::fieldName(int id)
+{
+  return keyTable().name(id);
+}
+
+/**
+ * Total number of names in the global key table
+ * @return number of distinct field names seen by this process
+ */
+int gridpack::component::DataCollection::numFields(void)
+{
+  return keyTable().size();
+}
+
+/**
+ * Get sorted list of all field IDs used in this collection
+ * @param fields list of distinct field IDs
+ */
+void gridpack::component::DataCollection::p_usedFields(
+    std::vector<int> &fields) const
+{
+  fields.clear();
+  addFields(p_ints, fields);
+  addFields(p_longs, fields);
+  addFields(p_bools, fields);
+  addFields(p_strings, fields);
+  addFields(p_floats, fields);
+  addFields(p_doubles, fields);
+  addFields(p_complexType, fields);
+  std::sort(fields.begin(), fields.end());
+  fields.erase(std::unique(fields.begin(), fields.end()), fields.end());
 }
@@ -6,15 +6,14 @@
 #ifndef _data_collection_h
 #define _data_collection_h
 
-#define OLD_MAP
-
-#ifndef OLD_MAP
-#include <boost/unordered_map.hpp>
-#endif
 #include <map>
+#include <vector>
 #include <string>
+#include <algorithm>
+#include <climits>
 #include <boost/serialization/map.hpp>
 #include <boost/serialization/string.hpp>
+#include <boost/serialization/split_member.hpp>
 
 #include "gridpack/utilities/complex.hpp"
 
@@ -25,6 +24,27 @@
 namespace gridpack{
 namespace component{
 
+/**
+ * Single value stored in a DataCollection. The name of the value is
+ * represented by an integer field ID obtained from the global key table
+ * (see DataCollection::fieldId) and values without an index use the index
+ * DataCollectionEntry::NO_INDEX. Entries are kept sorted by field ID and
+ * index so that they can be found with a binary search
+ */
+template <typename T>
+struct DataCollectionEntry {
+  enum { NO_INDEX = INT_MIN };
+  int field;
+  int idx;
+  T value;
+
+  bool operator<(const DataCollectionEntry &rhs) const
+  {
+    if (field != rhs.field) return field < rhs.field;
+    return idx < rhs.idx;
+  }
+};
+
 class DataCollection {
 public:
   /**
@@ -143,40 +163,144 @@ public:
    * Dump contents of data collection to standard out
    */
   void dump(void);
+
+  /**
+   * Return the integer ID of a field name. Names are interned in a global
+   * key table the first time they are seen and the same ID is returned for
+   * all subsequent calls with the same name. IDs are only unique within a
+   * process and should not be sent to other processors
+   * @param name name of data element
+   * @return integer ID of name
+   */
+  static int fieldId(const char *name);
+
+  /**
+   * Return the integer ID of a field name without adding it to the global
+   * key table. Used when reading or modifying values, since a name that
+   * has never been interned cannot be in any collection
+   * @param name name of data element
+   * @return integer ID of name or -1 if the name has not been seen
+   */
+  static int findFieldId(const char *name);
+
+  /**
+   * Return the name corresponding to an integer field ID
+   * @param id field ID returned by fieldId
+   * @return name of data element
+   */
+  static const std::string& fieldName(int id);
+
+  /**
+   * Total number of names in the global key table
+   * @return number of distinct field names seen by this process
+   */
+  static int numFields(void);
 private:
-#ifdef OLD_MAP
-  std::map<std::string, int> p_ints; 
-  std::map<std::string, long> p_longs; 
-  std::map<std::string, bool> p_bools; 
-  std::map<std::string, std::string> p_strings; 
-  std::map<std::string, float> p_floats; 
-  std::map<std::string, double> p_doubles; 
-  std::map<std::string, gridpack::ComplexType> p_complexType; 
-#else
-  boost::unordered_map<std::string, int> p_ints; 
-  boost::unordered_map<std::string, long> p_longs; 
-  boost::unordered_map<std::string, bool> p_bools; 
-  boost::unordered_map<std::string, std::string> p_strings; 
-  boost::unordered_map<std::string, float> p_floats; 
-  boost::unordered_map<std::string, double> p_doubles; 
-  boost::unordered_map<std::string, gridpack::ComplexType> p_complexType; 
-#endif
+  std::vector<DataCollectionEntry<int> > p_ints; 
+  std::vector<DataCollectionEntry<long> > p_longs; 
+  std::vector<DataCollectionEntry<bool> > p_bools; 
+  std::vector<DataCollectionEntry<std::string> > p_strings; 
+  std::vector<DataCollectionEntry<float> > p_floats; 
+  std::vector<DataCollectionEntry<double> > p_doubles; 
+  std::vector<DataCollectionEntry<gridpack::ComplexType> > p_complexType; 
+
+  /**
+   * Get sorted list of all field IDs used in this collection
+   * @param fields list of distinct field IDs
+   */
+  void p_usedFields(std::vector<int> &fields) const;
 
 private:
   friend class boost::serialization::access;
 
-  /// Serialization method
-  template<class Archive> void serialize(Archive &ar, const unsigned int)
+  /**
+   * Write a value table to an archive. Field IDs are replaced by their
+   * position in the list of fields used by this collection
+   */
+  template<class Archive, typename T>
+  void p_saveTable(Archive &ar,
+      const std::vector<DataCollectionEntry<T> > &table,
+      const std::vector<int> &fields) const
+  {
+    int i;
+    int nsize = table.size();
+    ar << nsize;
+    for (i=0; i<nsize; i++) {
+      int f = std::lower_bound(fields.begin(), fields.end(),
+          table[i].field) - fields.begin();
+      ar << f;
+      ar << table[i].idx;
+      ar << table[i].value;
+    }
+  }
+
+  /**
+   * Read a value table from an archive and convert positions in the list
+   * of fields back to local field IDs
+   */
+  template<class Archive, typename T>
+  void p_loadTable(Archive &ar, std::vector<DataCollectionEntry<T> > &table,
+      const std::vector<int> &fields)
+  {
+    int i;
+    int nsize;
+    ar >> nsize;
+    table.resize(nsize);
+    for (i=0; i<nsize; i++) {
+      int f;
+      ar >> f;
+      ar >> table[i].idx;
+      ar >> table[i].value;
+      table[i].field = fields[f];
+    }
+    // local field IDs may be ordered differently than on the sending process
+    std::sort(table.begin(), table.end());
+  }
+
+  /// Serialization methods. Field IDs are local to each process so the
+  /// names of the fields used in this collection are written once, followed
+  /// by the entries in each table
+  template<class Archive> void save(Archive &ar, const unsigned int) const
   {
-    ar & p_ints
-      & p_longs
-      & p_bools
-      & p_strings
-      & p_floats
-      & p_doubles
-      & p_complexType;
+    std::vector<int> fields;
+    p_usedFields(fields);
+    int i;
+    int nfields = fields.size();
+    ar << nfields;
+    for (i=0; i<nfields; i++) {
+      ar << fieldName(fields[i]);
+    }
+    p_saveTable(ar, p_ints, fields);
+    p_saveTable(ar, p_longs, fields);
+    p_saveTable(ar, p_bools, fields);
+    p_saveTable(ar, p_strings, fields);
+    p_saveTable(ar, p_floats, fields);
+    p_saveTable(ar, p_doubles, fields);
+    p_saveTable(ar, p_complexType, fields);
   }
 
+  template<class Archive> void load(Archive &ar, const unsigned int)
+  {
+    int i;
+    int nfields;
+    ar >> nfields;
+    std::vector<int> fields(nfields);
+    for (i=0; i<nfields; i++) {
+      std::string name;
+      ar >> name;
+      fields[i] = fieldId(name.c_str());
+    }
+    p_loadTable(ar, p_ints, fields);
+    p_loadTable(ar, p_longs, fields);
+    p_loadTable(ar, p_bools, fields);
+    p_loadTable(ar, p_strings, fields);
+    p_loadTable(ar, p_floats, fields);
+    p_loadTable(ar, p_doubles, fields);
+    p_loadTable(ar, p_complexType, fields);
+  }
+
+  BOOST_SERIALIZATION_SPLIT_MEMBER()
+
 };
 
 
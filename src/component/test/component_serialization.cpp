@@ -277,6 +277,57 @@ BOOST_AUTO_TEST_CASE( DataCollection_bin )
   check_data_collection(key, *dcin, *dcout);
 }
 
+BOOST_AUTO_TEST_CASE( DataCollection_indexed )
+{
+  gridpack::component::DataCollection dcin, dcout;
+  int i;
+  double dval;
+  int ival;
+
+  // indexed and unindexed values with the same name are distinct
+  dcin.addValue("GENERATOR_PG", 1.5);
+  for (i=0; i<4; i++) {
+    dcin.addValue("GENERATOR_PG", static_cast<double>(i), i);
+    dcin.addValue("GENERATOR_ID", "1", i);
+  }
+  dcin.addValue("BUS_NUMBER", 12);
+
+  // adding an existing value does not overwrite it
+  dcin.addValue("BUS_NUMBER", 13);
+  BOOST_CHECK(dcin.getValue("BUS_NUMBER", &ival));
+  BOOST_CHECK_EQUAL(ival, 12);
+
+  BOOST_CHECK(dcin.setValue("GENERATOR_PG", 2.5, 2));
+  BOOST_CHECK(!dcin.setValue("GENERATOR_PG", 2.5, 4));
+  BOOST_CHECK(!dcin.getValue("GENERATOR_PG", &ival));
+  BOOST_CHECK_EQUAL(gridpack::component::DataCollection::fieldId("GENERATOR_PG"),
+      gridpack::component::DataCollection::fieldId("GENERATOR_PG"));
+
+  std::stringstream obuf;
+  { 
+    outarchive oa(obuf);
+    oa << dcin;
+  }
+
+  { 
+    inarchive ia(obuf);
+    ia >> dcout;
+  }
+
+  BOOST_CHECK(dcout.getValue("GENERATOR_PG", &dval));
+  BOOST_CHECK_CLOSE(dval, 1.5, delta);
+  for (i=0; i<4; i++) {
+    std::string sval;
+    BOOST_CHECK(dcout.getValue("GENERATOR_PG", &dval, i));
+    BOOST_CHECK_CLOSE(dval, (i == 2 ? 2.5 : static_cast<double>(i)), delta);
+    BOOST_CHECK(dcout.getValue("GENERATOR_ID", &sval, i));
+    BOOST_CHECK_EQUAL(sval, std::string("1"));
+  }
+  BOOST_CHECK(!dcout.getValue("GENERATOR_PG", &dval, 4));
+  BOOST_CHECK(dcout.getValue("BUS_NUMBER", &ival));
+  BOOST_CHECK_EQUAL(ival, 12);
+}
+
 BOOST_AUTO_TEST_CASE( DataCollection_mpi )
 {
   gridpack::parallel::Communicator comm;
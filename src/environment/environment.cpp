@@ -24,6 +24,11 @@
 #include "gridpack/utilities/string_utils.hpp"
 #include "gridpack/environment/no_print.hpp"
 
+// The asynchronous IO thread and, if OpenMP is used, the threads working on
+// buses and branches never call MPI. Only the main thread does, so ask for
+// MPI_THREAD_FUNNELED support
+#define GRIDPACK_ENV_ARGS(argc,argv) argc,argv,boost::mpi::threading::funneled
+
 namespace gridpack {
 
 void Environment::PrintHelp(char** argv,const char* help)
@@ -54,7 +59,7 @@ void Environment::PrintStatus()
 //  class Environment
 // -------------------------------------------------------------
 
-Environment::Environment(int argc, char **argv):p_boostEnv(argc,argv),clparser(argc,argv)
+Environment::Environment(int argc, char **argv):p_boostEnv(GRIDPACK_ENV_ARGS(argc,argv)),clparser(argc,argv)
 {
   pma_stack = 200000;
   pma_heap  = 200000;
@@ -65,7 +70,7 @@ Environment::Environment(int argc, char **argv):p_boostEnv(argc,argv),clparser(a
   gridpack::math::Initialize(&argc,&argv);
 }
 
-Environment::Environment(int argc, char **argv,const char* help): p_boostEnv(argc,argv),clparser(argc,argv)
+Environment::Environment(int argc, char **argv,const char* help): p_boostEnv(GRIDPACK_ENV_ARGS(argc,argv)),clparser(argc,argv)
 {
   PrintHelp(argv,help);
   pma_stack = 200000;
@@ -77,7 +82,7 @@ Environment::Environment(int argc, char **argv,const char* help): p_boostEnv(arg
   gridpack::math::Initialize(&argc,&argv);
 }
   
-Environment::Environment(int argc, char **argv,const char* help,const long int& ma_stack,const long int& ma_heap): p_boostEnv(argc,argv),clparser(argc,argv)
+Environment::Environment(int argc, char **argv,const char* help,const long int& ma_stack,const long int& ma_heap): p_boostEnv(GRIDPACK_ENV_ARGS(argc,argv)),clparser(argc,argv)
 {
   PrintHelp(argv,help);
 
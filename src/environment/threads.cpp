@@ -0,0 +1,110 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+
+#include <stdio.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "gridpack/environment/threads.hpp"
+#include "gridpack/utilities/exception.hpp"
+
+gridpack::Threads
+         *gridpack::Threads::p_instance = NULL;
+
+/**
+ * Retrieve instance of the Threads object
+ */
+gridpack::Threads *gridpack::Threads::instance()
+{
+  if (p_instance == NULL) {
+    p_instance = new Threads();
+  }
+  return p_instance;
+}
+
+/**
+ * Set the number of threads used in loops over network components. This
+ * has no effect if GridPACK was not built with OpenMP
+ * @param nthreads number of threads (values less than 1 are set to 1)
+ */
+void gridpack::Threads::setNumThreads(int nthreads)
+{
+#ifdef _OPENMP
+  p_nthreads = (nthreads > 1 ? nthreads : 1);
+#else
+  p_nthreads = 1;
+#endif
+}
+
+/**
+ * Return the number of threads used in loops over network components
+ * @return number of threads (always 1 if OpenMP is not available)
+ */
+int gridpack::Threads::numThreads()
+{
+  return p_nthreads;
+}
+
+/**
+ * Check if GridPACK was built with OpenMP
+ * @return true if loops over network components can be threaded
+ */
+bool gridpack::Threads::available()
+{
+#ifdef _OPENMP
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * Record an error that occurred inside a threaded loop. Only the first
+ * error is kept
+ * @param msg error message
+ */
+void gridpack::Threads::setError(const char *msg)
+{
+#ifdef _OPENMP
+#pragma omp critical(gridpack_threads_error)
+#endif
+  {
+    if (!p_error) {
+      p_error = true;
+      p_message = msg;
+    }
+  }
+}
+
+/**
+ * Throw a gridpack::Exception if an error was recorded in the last
+ * threaded loop
+ */
+void gridpack::Threads::checkError()
+{
+  if (p_error) {
+    std::string msg = p_message;
+    p_error = false;
+    p_message.clear();
+    throw gridpack::Exception(msg);
+  }
+}
+
+/**
+ * Constructor
+ */
+gridpack::Threads::Threads()
+{
+  p_nthreads = 1;
+  p_error = false;
+}
+
+/**
+ * Destructor
+ */
+gridpack::Threads::~Threads()
+{
+}
@@ -0,0 +1,88 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+#ifndef _threads_h
+#define _threads_h
+
+#include <string>
+
+// Simple singleton object to keep track of the number of threads used in
+// loops over the buses and branches on each process. Threads are only used
+// if GridPACK is built with OpenMP (USE_OPENMP). Only the main thread
+// calls MPI and GA, so MPI_THREAD_FUNNELED support is sufficient.
+
+// number of components handed to a thread at a time in threaded loops
+#define GRIDPACK_THREAD_CHUNK 16
+
+namespace gridpack{
+
+class Threads {
+public:
+  
+  /**
+   * Retrieve instance of the Threads object
+   */
+  static Threads *instance();
+
+  /**
+   * Set the number of threads used in loops over network components. This
+   * has no effect if GridPACK was not built with OpenMP
+   * @param nthreads number of threads (values less than 1 are set to 1)
+   */
+  void setNumThreads(int nthreads);
+
+  /**
+   * Return the number of threads used in loops over network components
+   * @return number of threads (always 1 if OpenMP is not available)
+   */
+  int numThreads();
+
+  /**
+   * Check if GridPACK was built with OpenMP
+   * @return true if loops over network components can be threaded
+   */
+  bool available();
+
+  /**
+   * Record an error that occurred inside a threaded loop. Exceptions cannot
+   * leave an OpenMP parallel region, so they are caught inside the loop and
+   * thrown again by checkError once the loop is finished. Only the first
+   * error is kept
+   * @param msg error message
+   */
+  void setError(const char *msg);
+
+  /**
+   * Throw a gridpack::Exception if an error was recorded in the last
+   * threaded loop. This must be called outside the parallel region
+   */
+  void checkError();
+
+protected:
+  /**
+   * Constructor
+   */
+  Threads();
+
+  /**
+   * Destructor
+   */
+  ~Threads();
+
+private:
+
+  static Threads *p_instance;
+
+  int                 p_nthreads;
+
+  bool                p_error;
+
+  std::string         p_message;
+};
+
+
+}    // gridpack
+
+#endif // _threads_h
@@ -21,6 +21,7 @@
 #include <vector>
 #include "boost/smart_ptr/shared_ptr.hpp"
 #include "gridpack/timer/coarse_timer.hpp"
+#include "gridpack/environment/threads.hpp"
 #include "gridpack/network/base_network.hpp"
 #include "gridpack/component/base_component.hpp"
 
@@ -44,6 +45,8 @@ class BaseFactory {
       : p_network(network)
     { 
       p_profile = false;
+      p_exchange = false;
+      p_allocXC = true;
       p_numBuses = p_network->numBuses();
       p_numBranches = p_network->numBranches();
       p_buses = new gridpack::component::BaseBusComponent*[p_numBuses];
@@ -259,6 +262,10 @@ class BaseFactory {
       int i;
       int rank = p_network->communicator().rank();
 
+      // Components are loaded serially, even if threads are used in other
+      // loops. Load methods commonly add new fields to data collections and
+      // are not required to follow the thread safety rules in BaseComponent
+
       // Invoke load method on all bus objects
       int t_load1 = timer->createCategory("Factory:load:bus");
       timer->start(t_load1);
@@ -295,6 +302,8 @@ class BaseFactory {
       timer->configTimer(p_profile);
       int t_setx = timer->createCategory("Factory:setExchange");
       timer->start(t_setx);
+      p_exchange = true;
+      p_allocXC = flag;
       int busXCSize, branchXCSize;
       int nbus, nbranch;
 
@@ -361,6 +370,60 @@ class BaseFactory {
       timer->configTimer(true);
     }
 
+    /**
+     * Repartition the network if the time spent on each process is not
+     * balanced (see BaseNetwork::rebalance). If the network is
+     * repartitioned, the lists of buses and branches in the factory, the
+     * pointers to data collections (rebind), the component indices and
+     * neighbor pointers (setComponents) and the exchange buffers and ghost
+     * updates (if setExchange has been called) are set up again for the
+     * new distribution. Mappers, vectors and matrices that were created
+     * before this call must be recreated if the network is repartitioned.
+     * This is a network-level operation: only component state included in
+     * the serialize methods survives a move, so it can only be used with
+     * components that serialize all of their state and override rebind if
+     * load stores pointers. The dynamic simulation and Kalman filter
+     * components do not meet these conditions
+     * @param time time spent on this process in the part of the
+     *        calculation that should be balanced
+     * @param tolerance repartition only if the ratio of the maximum to the
+     *        average time is larger than this value
+     * @return true if the network was repartitioned
+     */
+    virtual bool rebalance(double time, double tolerance = 1.1)
+    {
+      if (!p_network->rebalance(time, tolerance)) return false;
+      int i;
+      int rank = p_network->communicator().rank();
+      delete [] p_buses;
+      delete [] p_branches;
+      p_numBuses = p_network->numBuses();
+      p_numBranches = p_network->numBranches();
+      p_buses = new gridpack::component::BaseBusComponent*[p_numBuses];
+      p_branches = new gridpack::component::BaseBranchComponent*[p_numBranches];
+      // Components that moved were rebuilt from their serialized state, so
+      // pointers that load set in them must be restored
+      for (i=0; i<p_numBuses; i++) {
+        p_buses[i] = p_network->getBus(i).get();
+        p_buses[i]->setRank(rank);
+        p_buses[i]->rebind(p_network->getBusData(i));
+      }
+      for (i=0; i<p_numBranches; i++) {
+        p_branches[i] = p_network->getBranch(i).get();
+        p_branches[i]->setRank(rank);
+        p_branches[i]->rebind(p_network->getBranchData(i));
+      }
+      setComponents();
+      if (p_exchange) {
+        setExchange(p_allocXC);
+        p_network->initBusUpdate();
+        p_network->initBranchUpdate();
+        p_network->updateBuses();
+        p_network->updateBranches();
+      }
+      return true;
+    }
+
     /**
      * Set the mode for all BaseComponent objects in the network.
      * @param mode integer representing desired mode
@@ -368,9 +431,18 @@ class BaseFactory {
     virtual void setMode(int mode)
     {
       int i;
+      int nthreads = gridpack::Threads::instance()->numThreads();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,GRIDPACK_THREAD_CHUNK) \
+      num_threads(nthreads) if(nthreads > 1)
+#endif
       for (i=0; i<p_numBuses; i++) {
         p_buses[i]->setMode(mode);
       }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,GRIDPACK_THREAD_CHUNK) \
+      num_threads(nthreads) if(nthreads > 1)
+#endif
       for (i=0; i<p_numBranches; i++) {
         p_branches[i]->setMode(mode);
       }
@@ -450,6 +522,48 @@ class BaseFactory {
       }
     }
 
+    /**
+     * Sort locally owned buses into interior buses, which are only connected
+     * to other locally owned buses and branches, and boundary buses, which
+     * are connected to at least one ghost bus or ghost branch. Calculations on
+     * interior buses can be carried out while a ghost update started with
+     * BaseNetwork::beginBusUpdate is still in progress.
+     * @param interior local indices of interior buses
+     * @param boundary local indices of boundary buses
+     */
+    void getInteriorAndBoundaryBuses(std::vector<int> &interior,
+        std::vector<int> &boundary)
+    {
+      int i, j;
+      interior.clear();
+      boundary.clear();
+      for (i=0; i<p_numBuses; i++) {
+        if (!p_network->getActiveBus(i)) continue;
+        bool isInterior = true;
+        std::vector<int> nghbrBus = p_network->getConnectedBuses(i);
+        for (j=0; j<nghbrBus.size(); j++) {
+          if (!p_network->getActiveBus(nghbrBus[j])) {
+            isInterior = false;
+            break;
+          }
+        }
+        if (isInterior) {
+          std::vector<int> nghbrBranch = p_network->getConnectedBranches(i);
+          for (j=0; j<nghbrBranch.size(); j++) {
+            if (!p_network->getActiveBranch(nghbrBranch[j])) {
+              isInterior = false;
+              break;
+            }
+          }
+        }
+        if (isInterior) {
+          interior.push_back(i);
+        } else {
+          boundary.push_back(i);
+        }
+      }
+    }
+
     /**
      * Save internal state variables of the buses and branches to the
      * associated data collection object for possible use in output or to
@@ -530,6 +644,10 @@ class BaseFactory {
 
     bool p_profile;
 
+    // exchange buffers have been set up and were allocated by network
+    bool p_exchange;
+    bool p_allocXC;
+
     int p_numBuses;
 
     int p_numBranches;
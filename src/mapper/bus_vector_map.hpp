@@ -24,6 +24,7 @@
 #include <gridpack/component/base_component.hpp>
 #include <gridpack/network/base_network.hpp>
 #include <gridpack/math/vector.hpp>
+#include <gridpack/environment/threads.hpp>
 
 //#define DBG_CHECK
 
@@ -44,6 +45,7 @@ BusVectorMap(boost::shared_ptr<_network> network)
 {
   p_Offsets                        = NULL;
   p_ISize                          = NULL;
+  p_BufOffsets                     = NULL;
   p_LocOffsets                     = NULL;
   p_LocSize                        = NULL;
   int                     iSize    = 0;
@@ -69,6 +71,7 @@ BusVectorMap(boost::shared_ptr<_network> network)
 {
   if (p_Offsets != NULL) delete [] p_Offsets;
   if (p_ISize != NULL) delete [] p_ISize;
+  if (p_BufOffsets != NULL) delete [] p_BufOffsets;
   if (p_contributingBuses != NULL) delete [] p_contributingBuses;
   if (p_Indices != NULL) delete [] p_Indices;
   if (p_LocOffsets != NULL) delete [] p_LocOffsets;
@@ -225,14 +228,9 @@ void mapToBus(const gridpack::math::Vector &vector)
   if (p_timer) p_timer->start(t_get);
   vector.getElements(p_numValues, p_Indices, values);
   if (p_timer) p_timer->stop(t_get);
-  ComplexType *vptr = values;
   if (p_timer) t_unpack = p_timer->createCategory("mapToBus: set Data");
   if (p_timer) p_timer->start(t_unpack);
-  for (i=0; i<p_busContribution; i++) {
-    p_contributingBuses[i]->setValues(vptr);
-    isize = p_ISize[i];
-    vptr += isize;
-  }
+  scatterValues(values);
   if (p_timer) p_timer->stop(t_unpack);
   delete [] values;
 }
@@ -252,14 +250,9 @@ void mapToBus(const gridpack::math::RealVector &vector)
   if (p_timer) p_timer->start(t_get);
   vector.getElements(p_numValues, p_Indices, values);
   if (p_timer) p_timer->stop(t_get);
-  RealType *vptr = values;
   if (p_timer) t_unpack = p_timer->createCategory("mapToBus: set Data");
   if (p_timer) p_timer->start(t_unpack);
-  for (i=0; i<p_busContribution; i++) {
-    p_contributingBuses[i]->setValues(vptr);
-    isize = p_ISize[i];
-    vptr += isize;
-  }
+  scatterValues(values);
   if (p_timer) p_timer->stop(t_unpack);
   delete [] values;
 }
@@ -311,11 +304,10 @@ void loadBusData(gridpack::math::Vector &vector, bool flag)
   if (p_timer) t_pack = p_timer->createCategory("loadBusData: Fill Buffer");
   if (p_timer) p_timer->start(t_pack);
   ComplexType *vbuf = new ComplexType[p_numValues];
-  ComplexType *vptr = vbuf;
+  gatherValues(vbuf);
   int *ibuf = new int[p_numValues];
   icnt = 0;
   for (i=0; i<p_busContribution; i++) {
-    p_contributingBuses[i]->vectorValues(vptr);
     isize = p_ISize[i];
     idx = p_Offsets[i];
     for (j=0; j<isize; j++) {
@@ -323,7 +315,6 @@ void loadBusData(gridpack::math::Vector &vector, bool flag)
       idx++;
       icnt++;
     }
-    vptr += isize;
   }
   if (p_timer) p_timer->stop(t_pack);
   if (p_timer) t_add = p_timer->createCategory("loadBusData: Add Elements");
@@ -353,11 +344,10 @@ void loadRealBusData(gridpack::math::RealVector &vector, bool flag)
   if (p_timer) t_pack = p_timer->createCategory("loadBusData: Fill Buffer");
   if (p_timer) p_timer->start(t_pack);
   RealType *vbuf = new RealType[p_numValues];
-  RealType *vptr = vbuf;
+  gatherValues(vbuf);
   int *ibuf = new int[p_numValues];
   icnt = 0;
   for (i=0; i<p_busContribution; i++) {
-    p_contributingBuses[i]->vectorValues(vptr);
     isize = p_ISize[i];
     idx = p_Offsets[i];
     for (j=0; j<isize; j++) {
@@ -365,7 +355,6 @@ void loadRealBusData(gridpack::math::RealVector &vector, bool flag)
       idx++;
       icnt++;
     }
-    vptr += isize;
   }
   if (p_timer) p_timer->stop(t_pack);
   if (p_timer) t_add = p_timer->createCategory("loadBusData: Add Elements");
@@ -397,6 +386,56 @@ void loadRealBusData(boost::shared_ptr<gridpack::math::RealVector> &vector, bool
   loadRealBusData(*vector, flag);
 }
 
+/**
+ * Copy values from all contributing buses into a buffer. The values from
+ * each bus are at a fixed location in the buffer, so buses can be
+ * evaluated concurrently
+ * @param vbuf buffer of length p_numValues
+ */
+template <typename _data_type>
+void gatherValues(_data_type *vbuf)
+{
+  int i;
+  gridpack::Threads *threads = gridpack::Threads::instance();
+  int nthreads = threads->numThreads();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,GRIDPACK_THREAD_CHUNK) \
+  num_threads(nthreads) if(nthreads > 1)
+#endif
+  for (i=0; i<p_busContribution; i++) {
+    try {
+      p_contributingBuses[i]->vectorValues(vbuf+p_BufOffsets[i]);
+    } catch (std::exception &e) {
+      threads->setError(e.what());
+    }
+  }
+  threads->checkError();
+}
+
+/**
+ * Push values from a buffer onto all contributing buses
+ * @param vbuf buffer of length p_numValues
+ */
+template <typename _data_type>
+void scatterValues(_data_type *vbuf)
+{
+  int i;
+  gridpack::Threads *threads = gridpack::Threads::instance();
+  int nthreads = threads->numThreads();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,GRIDPACK_THREAD_CHUNK) \
+  num_threads(nthreads) if(nthreads > 1)
+#endif
+  for (i=0; i<p_busContribution; i++) {
+    try {
+      p_contributingBuses[i]->setValues(vbuf+p_BufOffsets[i]);
+    } catch (std::exception &e) {
+      threads->setError(e.what());
+    }
+  }
+  threads->checkError();
+}
+
 /**
  * Calculate how many buses contribute to vector
  */
@@ -428,12 +467,16 @@ void contributions(void)
   p_contributingBuses 
     = new gridpack::component::BaseBusComponent*[p_busContribution];
   p_ISize = new int[p_busContribution];
+  p_BufOffsets = new int[p_busContribution];
   int icnt = 0;
+  int offset = 0;
   for (i=0; i<p_nBuses; i++) {
     if (p_network->getActiveBus(i)) {
       if (p_network->getBus(i)->vectorSize(&isize)) {
         p_contributingBuses[icnt] = p_network->getBus(i).get();
         p_ISize[icnt] = isize;
+        p_BufOffsets[icnt] = offset;
+        offset += isize;
         icnt++;
       }
     }
@@ -495,6 +538,7 @@ int*                        p_Offsets;
 int*                        p_LocOffsets;
 int*                        p_LocSize;
 int*                        p_ISize;
+int*                        p_BufOffsets; // Offset of bus values in local buffer
 int*                        p_Indices;
 gridpack::component::BaseBusComponent **p_contributingBuses;
 
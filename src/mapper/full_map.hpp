@@ -19,6 +19,7 @@
 
 //#define NZ_PER_ROW
 
+#include <vector>
 #include <boost/smart_ptr/shared_ptr.hpp>
 #include <ga.h>
 #include "gridpack/parallel/parallel.hpp"
@@ -27,6 +28,7 @@
 #include <gridpack/network/base_network.hpp>
 #include <gridpack/math/matrix.hpp>
 #include <gridpack/utilities/exception.hpp>
+#include <gridpack/environment/threads.hpp>
 
 #define DBG_CHECK
 
@@ -56,6 +58,10 @@ FullMatrixMap(boost::shared_ptr<_network> network)
   int                     jSize    = 0;
 
   p_timer = NULL;
+  p_blockInsert = true;
+  p_usePlan = true;
+  p_plan.valid = false;
+  p_realPlan.valid = false;
   //p_timer = gridpack::utility::CoarseTimer::instance();
 
   p_GAgrp = network->communicator().getGroup();
@@ -232,9 +238,20 @@ gridpack::math::Matrix* intMapToMatrix(bool isDense = false)
  */
 void mapToMatrix(gridpack::math::Matrix &matrix)
 {
-  int t_set, t_bus, t_branch;
+  int t_set, t_bus, t_branch, t_refill;
   GA_Pgroup_sync(p_GAgrp);
   if (p_timer) t_set = p_timer->createCategory("Mapper: Set Matrix");
+  if (p_timer) t_refill = p_timer->createCategory("Mapper: Refill Matrix");
+  if (p_timer) p_timer->start(t_refill);
+  bool refilled = refillFromPlan<ComplexType>(matrix, p_plan);
+  if (p_timer) p_timer->stop(t_refill);
+  if (refilled) {
+    if (p_timer) p_timer->start(t_set);
+    GA_Pgroup_sync(p_GAgrp);
+    matrix.ready();
+    if (p_timer) p_timer->stop(t_set);
+    return;
+  }
   if (p_timer) p_timer->start(t_set);
   matrix.zero();
   if (p_timer) p_timer->stop(t_set);
@@ -258,9 +275,20 @@ void mapToMatrix(gridpack::math::Matrix &matrix)
  */
 void mapToRealMatrix(gridpack::math::RealMatrix &matrix)
 {
-  int t_set, t_bus, t_branch;
+  int t_set, t_bus, t_branch, t_refill;
   GA_Pgroup_sync(p_GAgrp);
   if (p_timer) t_set = p_timer->createCategory("Mapper: Set Matrix");
+  if (p_timer) t_refill = p_timer->createCategory("Mapper: Refill Matrix");
+  if (p_timer) p_timer->start(t_refill);
+  bool refilled = refillFromPlan<RealType>(matrix, p_realPlan);
+  if (p_timer) p_timer->stop(t_refill);
+  if (refilled) {
+    if (p_timer) p_timer->start(t_set);
+    GA_Pgroup_sync(p_GAgrp);
+    matrix.ready();
+    if (p_timer) p_timer->stop(t_set);
+    return;
+  }
   if (p_timer) p_timer->start(t_set);
   matrix.zero();
   if (p_timer) p_timer->stop(t_set);
@@ -407,7 +435,286 @@ bool check(void)
   return ok;
 }
 
+/**
+ * Choose how component contributions are inserted into the matrix. If true
+ * (the default), the dense block from each component is inserted with a
+ * single setElementBlock/addElementBlock call. Otherwise, each element is
+ * inserted individually
+ * @param flag if true, insert contributions as blocks
+ */
+void useBlockInsertion(bool flag)
+{
+  p_blockInsert = flag;
+}
+
+/**
+ * Choose how existing matrices are refilled by mapToMatrix and
+ * mapToRealMatrix. If true (the default), the storage location of every
+ * component contribution is found the first time a matrix is refilled and
+ * subsequent refills write values directly into the matrix storage. This
+ * only works if the component block sizes and the sparsity pattern of the
+ * matrix do not change. The plan is rebuilt automatically if the number of
+ * stored matrix values or the local nonzero structure of the matrix
+ * changes
+ * @param flag if true, refill matrices using an assembly plan
+ */
+void useAssemblyPlan(bool flag)
+{
+  p_usePlan = flag;
+  if (!flag) invalidateAssemblyPlan();
+}
+
+/**
+ * Discard any existing assembly plans. This should be called if the
+ * components change the size or location of their matrix contributions
+ * or if a matrix with a different sparsity pattern is passed to
+ * mapToMatrix or mapToRealMatrix
+ */
+void invalidateAssemblyPlan(void)
+{
+  p_plan.valid = false;
+  p_plan.sizes.clear();
+  p_plan.slots.clear();
+  p_realPlan.valid = false;
+  p_realPlan.sizes.clear();
+  p_realPlan.slots.clear();
+}
+
 private:
+
+/**
+ * Locations in the matrix storage of all component contributions,
+ * in the order in which they are loaded into the matrix
+ */
+struct AssemblyPlan {
+  bool valid;
+  int storage;              // number of locally stored matrix values
+  std::size_t pattern;      // signature of local matrix nonzero structure
+  int nvals;                // number of matrix elements
+  std::vector<int> sizes;   // isize, jsize for each contribution
+  std::vector<int> slots;   // storage location of each element
+};
+
+/**
+ * Find the matrix elements of all component contributions and their
+ * location in matrix storage. Elements are listed in the same order that
+ * they are loaded by loadBusData and loadBranchData
+ * @param matrix matrix that is refilled using the plan
+ * @param plan plan to be constructed
+ * @return false if the matrix storage cannot be accessed directly
+ */
+template <typename _matrix>
+bool buildAssemblyPlan(const _matrix &matrix, AssemblyPlan &plan)
+{
+  int i,j,k,idx,jdx,isize,jsize;
+  plan.valid = false;
+  plan.sizes.clear();
+  plan.slots.clear();
+  plan.storage = matrix.localStorageSize();
+  if (plan.storage < 0) return false;
+  plan.pattern = matrix.localPatternSignature();
+  std::vector<int> rows, cols;
+  int jcnt = 0;
+  for (i=0; i<p_nBuses; i++) {
+    if (p_network->getActiveBus(i)) {
+      if (p_network->getBus(i)->matrixDiagSize(&isize,&jsize)) {
+        plan.sizes.push_back(isize);
+        plan.sizes.push_back(jsize);
+        for (k=0; k<jsize; k++) {
+          for (j=0; j<isize; j++) {
+            rows.push_back(p_i_busOffsets[jcnt] + j);
+            cols.push_back(p_j_busOffsets[jcnt] + k);
+          }
+        }
+        jcnt++;
+      }
+    }
+  }
+  boost::shared_ptr<gridpack::component::BaseBranchComponent> branch;
+  jcnt = 0;
+  for (i=0; i<p_nBranches; i++) {
+    branch = p_network->getBranch(i);
+    if (branch->matrixForwardSize(&isize,&jsize)) {
+      branch->getMatVecIndices(&idx, &jdx);
+      if (idx >= p_minRowIndex && idx <= p_maxRowIndex) {
+        plan.sizes.push_back(isize);
+        plan.sizes.push_back(jsize);
+        for (k=0; k<jsize; k++) {
+          for (j=0; j<isize; j++) {
+            rows.push_back(p_i_branchOffsets[jcnt] + j);
+            cols.push_back(p_j_branchOffsets[jcnt] + k);
+          }
+        }
+        jcnt++;
+      }
+    }
+    if (branch->matrixReverseSize(&isize,&jsize)) {
+      branch->getMatVecIndices(&idx, &jdx);
+      if (jdx >= p_minRowIndex && jdx <= p_maxRowIndex) {
+        plan.sizes.push_back(isize);
+        plan.sizes.push_back(jsize);
+        for (k=0; k<jsize; k++) {
+          for (j=0; j<isize; j++) {
+            rows.push_back(p_i_branchOffsets[jcnt] + j);
+            cols.push_back(p_j_branchOffsets[jcnt] + k);
+          }
+        }
+        jcnt++;
+      }
+    }
+  }
+  plan.nvals = rows.size();
+  if (plan.nvals > 0) {
+    plan.valid = matrix.getElementSlots(plan.nvals, &rows[0], &cols[0],
+        plan.slots);
+  } else {
+    plan.valid = true;
+  }
+  return plan.valid;
+}
+
+/**
+ * Evaluate all component contributions in plan order. A contribution for
+ * which the values function returns false is set to zero. The location of
+ * each contribution is found first and the values are then evaluated,
+ * using threads if these are available
+ * @param plan assembly plan
+ * @param vals list of matrix values
+ * @return false if the component block sizes no longer match the plan
+ */
+template <typename _type>
+bool gatherPlanValues(const AssemblyPlan &plan, std::vector<_type> &vals)
+{
+  int i,idx,jdx,isize,jsize;
+  int nblk = plan.sizes.size()/2;
+  int iblk = 0;
+  bool ok = true;
+  vals.resize(plan.nvals);
+  // each task is described by 4 integers: the type of contribution (0 =
+  // bus diagonal, 1 = branch forward, 2 = branch reverse), the local index
+  // of the component, the offset of the block in vals and the block size
+  std::vector<int> tasks;
+  tasks.reserve(4*nblk);
+  int icnt = 0;
+  boost::shared_ptr<gridpack::component::BaseBusComponent> bus;
+  for (i=0; i<p_nBuses && ok; i++) {
+    if (p_network->getActiveBus(i)) {
+      bus = p_network->getBus(i);
+      if (bus->matrixDiagSize(&isize,&jsize)) {
+        if (iblk >= nblk || isize != plan.sizes[2*iblk]
+            || jsize != plan.sizes[2*iblk+1]) {
+          ok = false;
+          break;
+        }
+        tasks.push_back(0);
+        tasks.push_back(i);
+        tasks.push_back(icnt);
+        tasks.push_back(isize*jsize);
+        icnt += isize*jsize;
+        iblk++;
+      }
+    }
+  }
+  boost::shared_ptr<gridpack::component::BaseBranchComponent> branch;
+  for (i=0; i<p_nBranches && ok; i++) {
+    branch = p_network->getBranch(i);
+    if (branch->matrixForwardSize(&isize,&jsize)) {
+      branch->getMatVecIndices(&idx, &jdx);
+      if (idx >= p_minRowIndex && idx <= p_maxRowIndex) {
+        if (iblk >= nblk || isize != plan.sizes[2*iblk]
+            || jsize != plan.sizes[2*iblk+1]) {
+          ok = false;
+          break;
+        }
+        tasks.push_back(1);
+        tasks.push_back(i);
+        tasks.push_back(icnt);
+        tasks.push_back(isize*jsize);
+        icnt += isize*jsize;
+        iblk++;
+      }
+    }
+    if (branch->matrixReverseSize(&isize,&jsize)) {
+      branch->getMatVecIndices(&idx, &jdx);
+      if (jdx >= p_minRowIndex && jdx <= p_maxRowIndex) {
+        if (iblk >= nblk || isize != plan.sizes[2*iblk]
+            || jsize != plan.sizes[2*iblk+1]) {
+          ok = false;
+          break;
+        }
+        tasks.push_back(2);
+        tasks.push_back(i);
+        tasks.push_back(icnt);
+        tasks.push_back(isize*jsize);
+        icnt += isize*jsize;
+        iblk++;
+      }
+    }
+  }
+  if (!ok || iblk != nblk) return false;
+
+  // Evaluate values. Each task writes to its own block of vals
+  _type *values = (plan.nvals > 0 ? &vals[0] : NULL);
+  int ntask = tasks.size()/4;
+  gridpack::Threads *threads = gridpack::Threads::instance();
+  int nthreads = threads->numThreads();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,GRIDPACK_THREAD_CHUNK) \
+  num_threads(nthreads) if(nthreads > 1)
+#endif
+  for (i=0; i<ntask; i++) {
+    int k;
+    int kind = tasks[4*i];
+    int lidx = tasks[4*i+1];
+    _type *blk = values+tasks[4*i+2];
+    bool set;
+    try {
+      if (kind == 0) {
+        set = p_network->getBus(lidx)->matrixDiagValues(blk);
+      } else if (kind == 1) {
+        set = p_network->getBranch(lidx)->matrixForwardValues(blk);
+      } else {
+        set = p_network->getBranch(lidx)->matrixReverseValues(blk);
+      }
+      if (!set) {
+        for (k=0; k<tasks[4*i+3]; k++) blk[k] = 0.0;
+      }
+    } catch (std::exception &e) {
+      threads->setError(e.what());
+    }
+  }
+  threads->checkError();
+  return true;
+}
+
+/**
+ * Refill an existing matrix using an assembly plan. The plan is built
+ * the first time it is needed and rebuilt if the size or signature of
+ * the local matrix storage no longer matches the plan. All values on this processor are
+ * overwritten, but ready() must still be called on the matrix
+ * @param matrix matrix to be refilled
+ * @param plan assembly plan for this type of matrix
+ * @return false if the plan could not be used. In this case the matrix
+ * has not been modified
+ */
+template <typename _type, typename _matrix>
+bool refillFromPlan(_matrix &matrix, AssemblyPlan &plan)
+{
+  if (!p_usePlan) return false;
+  if (!plan.valid || plan.storage != matrix.localStorageSize()
+      || plan.pattern != matrix.localPatternSignature()) {
+    if (!buildAssemblyPlan(matrix, plan)) return false;
+  }
+  std::vector<_type> vals;
+  if (!gatherPlanValues(plan, vals)) {
+    plan.valid = false;
+    return false;
+  }
+  matrix.setSlotValues(plan.nvals, plan.slots,
+      (plan.nvals > 0 ? &vals[0] : NULL), false, true);
+  return true;
+}
+
 /**
  * Return the number of active buses on this process
  * @return number of active buses
@@ -415,10 +722,9 @@ private:
 int getActiveBuses(void)
 {
   int nActiveBuses = 0;
+  const char *active = p_network->getActiveBusArray();
   for (int i = 0; i<p_nBuses; i++) {
-    if (p_network->getActiveBus(i)) {
-      nActiveBuses++;
-    }
+    if (active[i]) nActiveBuses++;
   }
   return nActiveBuses;
 }
@@ -934,6 +1240,8 @@ void loadBusData(gridpack::math::Matrix &matrix, bool flag)
   boost::shared_ptr<gridpack::component::BaseBusComponent> bus;
   // Add matrix elements
   ComplexType *values = new ComplexType[p_maxIBlock*p_maxJBlock];
+  int *rows = new int[p_maxIBlock];
+  int *cols = new int[p_maxJBlock];
   int j,k;
   int jcnt = 0;
   for (i=0; i<p_nBuses; i++) {
@@ -945,17 +1253,27 @@ void loadBusData(gridpack::math::Matrix &matrix, bool flag)
         for (k=0; k<ijsize; k++) values[k] = 0.0;
 #endif
         if (bus->matrixDiagValues(values)) {
-          icnt = 0;
-          for (k=0; k<jsize; k++) {
-            jdx = p_j_busOffsets[jcnt] + k;
-            for (j=0; j<isize; j++) {
-              idx = p_i_busOffsets[jcnt] + j;
-              if (flag) {
-                matrix.addElement(idx, jdx, values[icnt]);
-              } else {
-                matrix.setElement(idx, jdx, values[icnt]);
+          if (p_blockInsert) {
+            for (j=0; j<isize; j++) rows[j] = p_i_busOffsets[jcnt] + j;
+            for (k=0; k<jsize; k++) cols[k] = p_j_busOffsets[jcnt] + k;
+            if (flag) {
+              matrix.addElementBlock(isize, rows, jsize, cols, values);
+            } else {
+              matrix.setElementBlock(isize, rows, jsize, cols, values);
+            }
+          } else {
+            icnt = 0;
+            for (k=0; k<jsize; k++) {
+              jdx = p_j_busOffsets[jcnt] + k;
+              for (j=0; j<isize; j++) {
+                idx = p_i_busOffsets[jcnt] + j;
+                if (flag) {
+                  matrix.addElement(idx, jdx, values[icnt]);
+                } else {
+                  matrix.setElement(idx, jdx, values[icnt]);
+                }
+                icnt++;
               }
-              icnt++;
             }
           }
         }
@@ -966,6 +1284,8 @@ void loadBusData(gridpack::math::Matrix &matrix, bool flag)
 
   // Clean up arrays
   delete [] values;
+  delete [] rows;
+  delete [] cols;
 }
 
 /**
@@ -979,6 +1299,8 @@ void loadRealBusData(gridpack::math::RealMatrix &matrix, bool flag)
   boost::shared_ptr<gridpack::component::BaseBusComponent> bus;
   // Add matrix elements
   RealType *values = new RealType[p_maxIBlock*p_maxJBlock];
+  int *rows = new int[p_maxIBlock];
+  int *cols = new int[p_maxJBlock];
   int j,k;
   int jcnt = 0;
   for (i=0; i<p_nBuses; i++) {
@@ -990,17 +1312,27 @@ void loadRealBusData(gridpack::math::RealMatrix &matrix, bool flag)
         for (k=0; k<ijsize; k++) values[k] = 0.0;
 #endif
         if (bus->matrixDiagValues(values)) {
-          icnt = 0;
-          for (k=0; k<jsize; k++) {
-            jdx = p_j_busOffsets[jcnt] + k;
-            for (j=0; j<isize; j++) {
-              idx = p_i_busOffsets[jcnt] + j;
-              if (flag) {
-                matrix.addElement(idx, jdx, values[icnt]);
-              } else {
-                matrix.setElement(idx, jdx, values[icnt]);
+          if (p_blockInsert) {
+            for (j=0; j<isize; j++) rows[j] = p_i_busOffsets[jcnt] + j;
+            for (k=0; k<jsize; k++) cols[k] = p_j_busOffsets[jcnt] + k;
+            if (flag) {
+              matrix.addElementBlock(isize, rows, jsize, cols, values);
+            } else {
+              matrix.setElementBlock(isize, rows, jsize, cols, values);
+            }
+          } else {
+            icnt = 0;
+            for (k=0; k<jsize; k++) {
+              jdx = p_j_busOffsets[jcnt] + k;
+              for (j=0; j<isize; j++) {
+                idx = p_i_busOffsets[jcnt] + j;
+                if (flag) {
+                  matrix.addElement(idx, jdx, values[icnt]);
+                } else {
+                  matrix.setElement(idx, jdx, values[icnt]);
+                }
+                icnt++;
               }
-              icnt++;
             }
           }
         }
@@ -1011,6 +1343,8 @@ void loadRealBusData(gridpack::math::RealMatrix &matrix, bool flag)
 
   // Clean up arrays
   delete [] values;
+  delete [] rows;
+  delete [] cols;
 }
 
 /**
@@ -1120,6 +1454,8 @@ void loadBranchData(gridpack::math::Matrix &matrix, bool flag)
   if (p_timer) p_timer->start(t_add);
   boost::shared_ptr<gridpack::component::BaseBranchComponent> branch;
   ComplexType *values = new ComplexType[p_maxIBlock*p_maxJBlock];
+  int *rows = new int[p_maxIBlock];
+  int *cols = new int[p_maxJBlock];
   int j,k;
   int jcnt = 0;
   for (i=0; i<p_nBranches; i++) {
@@ -1132,17 +1468,27 @@ void loadBranchData(gridpack::math::Matrix &matrix, bool flag)
         for (k=0; k<ijsize; k++) values[k] = 0.0;
 #endif
         if (branch->matrixForwardValues(values)) {
-          icnt = 0;
-          for (k=0; k<jsize; k++) {
-            jdx = p_j_branchOffsets[jcnt] + k;
-            for (j=0; j<isize; j++) {
-              idx = p_i_branchOffsets[jcnt] + j;
-              if (flag) {
-                matrix.addElement(idx, jdx, values[icnt]);
-              } else {
-                matrix.setElement(idx, jdx, values[icnt]);
+          if (p_blockInsert) {
+            for (j=0; j<isize; j++) rows[j] = p_i_branchOffsets[jcnt] + j;
+            for (k=0; k<jsize; k++) cols[k] = p_j_branchOffsets[jcnt] + k;
+            if (flag) {
+              matrix.addElementBlock(isize, rows, jsize, cols, values);
+            } else {
+              matrix.setElementBlock(isize, rows, jsize, cols, values);
+            }
+          } else {
+            icnt = 0;
+            for (k=0; k<jsize; k++) {
+              jdx = p_j_branchOffsets[jcnt] + k;
+              for (j=0; j<isize; j++) {
+                idx = p_i_branchOffsets[jcnt] + j;
+                if (flag) {
+                  matrix.addElement(idx, jdx, values[icnt]);
+                } else {
+                  matrix.setElement(idx, jdx, values[icnt]);
+                }
+                icnt++;
               }
-              icnt++;
             }
           }
         }
@@ -1157,19 +1503,29 @@ void loadBranchData(gridpack::math::Matrix &matrix, bool flag)
         for (k=0; k<ijsize; k++) values[k] = 0.0;
 #endif
         if (branch->matrixReverseValues(values)) {
-          icnt = 0;
           // Note that because the indices have been reversed, we need to switch
           // the ordering of the offsets as well
-          for (k=0; k<jsize; k++) {
-            idx = p_j_branchOffsets[jcnt] + k;
-            for (j=0; j<isize; j++) {
-              jdx = p_i_branchOffsets[jcnt] + j;
-              if (flag) {
-                matrix.addElement(jdx, idx, values[icnt]);
-              } else {
-                matrix.setElement(jdx, idx, values[icnt]);
+          if (p_blockInsert) {
+            for (j=0; j<isize; j++) rows[j] = p_i_branchOffsets[jcnt] + j;
+            for (k=0; k<jsize; k++) cols[k] = p_j_branchOffsets[jcnt] + k;
+            if (flag) {
+              matrix.addElementBlock(isize, rows, jsize, cols, values);
+            } else {
+              matrix.setElementBlock(isize, rows, jsize, cols, values);
+            }
+          } else {
+            icnt = 0;
+            for (k=0; k<jsize; k++) {
+              idx = p_j_branchOffsets[jcnt] + k;
+              for (j=0; j<isize; j++) {
+                jdx = p_i_branchOffsets[jcnt] + j;
+                if (flag) {
+                  matrix.addElement(jdx, idx, values[icnt]);
+                } else {
+                  matrix.setElement(jdx, idx, values[icnt]);
+                }
+                icnt++;
               }
-              icnt++;
             }
           }
         }
@@ -1181,6 +1537,8 @@ void loadBranchData(gridpack::math::Matrix &matrix, bool flag)
 
   // Clean up array
   delete [] values;
+  delete [] rows;
+  delete [] cols;
 }
 
 /**
@@ -1197,6 +1555,8 @@ void loadRealBranchData(gridpack::math::RealMatrix &matrix, bool flag)
   if (p_timer) p_timer->start(t_add);
   boost::shared_ptr<gridpack::component::BaseBranchComponent> branch;
   RealType *values = new RealType[p_maxIBlock*p_maxJBlock];
+  int *rows = new int[p_maxIBlock];
+  int *cols = new int[p_maxJBlock];
   int j,k;
   int jcnt = 0;
   for (i=0; i<p_nBranches; i++) {
@@ -1209,17 +1569,27 @@ void loadRealBranchData(gridpack::math::RealMatrix &matrix, bool flag)
         for (k=0; k<ijsize; k++) values[k] = 0.0;
 #endif
         if (branch->matrixForwardValues(values)) {
-          icnt = 0;
-          for (k=0; k<jsize; k++) {
-            jdx = p_j_branchOffsets[jcnt] + k;
-            for (j=0; j<isize; j++) {
-              idx = p_i_branchOffsets[jcnt] + j;
-              if (flag) {
-                matrix.addElement(idx, jdx, values[icnt]);
-              } else {
-                matrix.setElement(idx, jdx, values[icnt]);
+          if (p_blockInsert) {
+            for (j=0; j<isize; j++) rows[j] = p_i_branchOffsets[jcnt] + j;
+            for (k=0; k<jsize; k++) cols[k] = p_j_branchOffsets[jcnt] + k;
+            if (flag) {
+              matrix.addElementBlock(isize, rows, jsize, cols, values);
+            } else {
+              matrix.setElementBlock(isize, rows, jsize, cols, values);
+            }
+          } else {
+            icnt = 0;
+            for (k=0; k<jsize; k++) {
+              jdx = p_j_branchOffsets[jcnt] + k;
+              for (j=0; j<isize; j++) {
+                idx = p_i_branchOffsets[jcnt] + j;
+                if (flag) {
+                  matrix.addElement(idx, jdx, values[icnt]);
+                } else {
+                  matrix.setElement(idx, jdx, values[icnt]);
+                }
+                icnt++;
               }
-              icnt++;
             }
           }
         }
@@ -1234,19 +1604,29 @@ void loadRealBranchData(gridpack::math::RealMatrix &matrix, bool flag)
         for (k=0; k<ijsize; k++) values[k] = 0.0;
 #endif
         if (branch->matrixReverseValues(values)) {
-          icnt = 0;
           // Note that because the indices have been reversed, we need to switch
           // the ordering of the offsets as well
-          for (k=0; k<jsize; k++) {
-            idx = p_j_branchOffsets[jcnt] + k;
-            for (j=0; j<isize; j++) {
-              jdx = p_i_branchOffsets[jcnt] + j;
-              if (flag) {
-                matrix.addElement(jdx, idx, values[icnt]);
-              } else {
-                matrix.setElement(jdx, idx, values[icnt]);
+          if (p_blockInsert) {
+            for (j=0; j<isize; j++) rows[j] = p_i_branchOffsets[jcnt] + j;
+            for (k=0; k<jsize; k++) cols[k] = p_j_branchOffsets[jcnt] + k;
+            if (flag) {
+              matrix.addElementBlock(isize, rows, jsize, cols, values);
+            } else {
+              matrix.setElementBlock(isize, rows, jsize, cols, values);
+            }
+          } else {
+            icnt = 0;
+            for (k=0; k<jsize; k++) {
+              idx = p_j_branchOffsets[jcnt] + k;
+              for (j=0; j<isize; j++) {
+                jdx = p_i_branchOffsets[jcnt] + j;
+                if (flag) {
+                  matrix.addElement(jdx, idx, values[icnt]);
+                } else {
+                  matrix.setElement(jdx, idx, values[icnt]);
+                }
+                icnt++;
               }
-              icnt++;
             }
           }
         }
@@ -1258,6 +1638,8 @@ void loadRealBranchData(gridpack::math::RealMatrix &matrix, bool flag)
 
   // Clean up array
   delete [] values;
+  delete [] rows;
+  delete [] cols;
 }
 
 /**
@@ -1289,8 +1671,9 @@ void contributions(void)
   // Get number of contributions from buses
   int isize, jsize;
   p_busContribution = 0;
+  const char *active = p_network->getActiveBusArray();
   for (i=0; i<p_nBuses; i++) {
-    if (p_network->getActiveBus(i)) {
+    if (active[i]) {
       if (p_network->getBus(i)->matrixDiagSize(&isize, &jsize)) p_busContribution++;
     }
   }
@@ -1354,6 +1737,14 @@ int                         p_GAgrp;
     // pointer to timer
 gridpack::utility::CoarseTimer *p_timer;
 
+    // insert component contributions as dense blocks
+bool                        p_blockInsert;
+
+    // assembly plans for refilling complex and real matrices
+bool                        p_usePlan;
+AssemblyPlan                p_plan;
+AssemblyPlan                p_realPlan;
+
 };
 
 } /* namespace mapper */
@@ -766,6 +766,53 @@ void run (const int &me, const int &nprocs)
     }
   }
 
+  // Compare matrix refilled from assembly plan with newly generated matrix
+  boost::shared_ptr<gridpack::math::Matrix> M2 = mMap.mapToMatrix();
+  M2->scale(-1.0);
+  M2->add(*M);
+  double diff = M2->norm2();
+  if (me == 0) {
+    if (diff == 0.0) {
+      printf("\nMatrix refilled from assembly plan is ok\n");
+    } else {
+      printf("\nError in matrix refilled from assembly plan: %e\n",diff);
+    }
+  }
+
+  // Compare time required to refill matrix using element-by-element insertion,
+  // block insertion and an assembly plan
+  int nloop = 20;
+  mMap.useAssemblyPlan(false);
+  mMap.useBlockInsertion(false);
+  double t_elem = MPI_Wtime();
+  for (i=0; i<nloop; i++) {
+    mMap.mapToMatrix(M);
+  }
+  t_elem = MPI_Wtime() - t_elem;
+  mMap.useBlockInsertion(true);
+  double t_block = MPI_Wtime();
+  for (i=0; i<nloop; i++) {
+    mMap.mapToMatrix(M);
+  }
+  t_block = MPI_Wtime() - t_block;
+  mMap.useAssemblyPlan(true);
+  double t_plan = MPI_Wtime();
+  for (i=0; i<nloop; i++) {
+    mMap.mapToMatrix(M);
+  }
+  t_plan = MPI_Wtime() - t_plan;
+  GA_Dgop(&t_elem,one,"max");
+  GA_Dgop(&t_block,one,"max");
+  GA_Dgop(&t_plan,one,"max");
+  if (me == 0) {
+    printf("\nTime for %d matrix fills using element insertion: %12.6f\n",
+        nloop,t_elem);
+    printf("Time for %d matrix fills using block insertion:   %12.6f\n",
+        nloop,t_block);
+    printf("Time for %d matrix fills using assembly plan:     %12.6f\n",
+        nloop,t_plan);
+  }
+
   if (me == 0) {
     printf("\nTesting BusVectorMap\n");
   }
@@ -41,7 +41,7 @@ public:
   /// Default constructor.
   BasicLinearMatrixSolverImplementation(MatrixType& A)
     : LinearMatrixSolverImplementation<T, I>(A),
-      p_solver(A)
+      p_solver(new LinearSolverT<T, I>(*(this->p_A)))
   {
   }
 
@@ -53,18 +53,61 @@ public:
 protected:
 
   /// The linear solver instance used for this
-  LinearSolverT<T, I> p_solver;
+  boost::scoped_ptr< LinearSolverT<T, I> > p_solver;
 
   /// Solve w/ the specified RHS Matrix (specialized)
   MatrixType *p_solve(const MatrixType& B) const
   {
-    return p_solver.solve(B);
+    return p_solver->solve(B);
+  }
+
+  /// Solve w/ the specified RHS Matrix, put result in specified Matrix (specialized)
+  void p_solve(const MatrixType& B, MatrixType& X) const
+  {
+    p_solver->solve(B, X);
+  }
+
+  /// Update coefficient values (specialized)
+  void p_numericRefactor(const MatrixType& A)
+  {
+    this->p_A->equate(A);
+    p_solver->numericRefactor();
+  }
+
+  /// Replace the coefficient Matrix (specialized)
+  /**
+   * The nonzero pattern of @c A may not fit in the existing
+   * coefficient matrix, so a new matrix and linear solver are
+   * created. Factorization counts from the old solver are kept.
+   */
+  void p_refactor(const MatrixType& A)
+  {
+    this->p_nSymbolic += p_solver->symbolicFactorizations();
+    this->p_nNumeric += p_solver->numericFactorizations();
+    p_solver.reset();
+    this->p_A.reset(A.clone());
+    p_solver.reset(new LinearSolverT<T, I>(*(this->p_A)));
+    if (this->isConfigured()) {
+      p_solver->configure(this->p_configCursor);
+    }
+  }
+
+  /// Get the number of symbolic factorizations performed (specialized)
+  int p_symbolicFactorizations(void) const
+  {
+    return this->p_nSymbolic + p_solver->symbolicFactorizations();
+  }
+
+  /// Get the number of numeric factorizations performed (specialized)
+  int p_numericFactorizations(void) const
+  {
+    return this->p_nNumeric + p_solver->numericFactorizations();
   }
 
   /// Specialized way to configure from property tree
   void p_configure(utility::Configuration::CursorPtr props)
   {
-    p_solver.configure(props);
+    p_solver->configure(props);
   }
 
 };
@@ -87,6 +87,36 @@ protected:
     return p_impl->solve(B);
   }
 
+  /// Solve w/ the specified RHS Matrix, put result in specified Matrix (specialized)
+  void p_solve(const MatrixType& B, MatrixType& X) const
+  {
+    p_impl->solve(B, X);
+  }
+
+  /// Update coefficient values (specialized)
+  void p_numericRefactor(const MatrixType& A)
+  {
+    p_impl->numericRefactor(A);
+  }
+
+  /// Replace the coefficient Matrix (specialized)
+  void p_refactor(const MatrixType& A)
+  {
+    p_impl->refactor(A);
+  }
+
+  /// Get the number of symbolic factorizations performed (specialized)
+  int p_symbolicFactorizations(void) const
+  {
+    return p_impl->symbolicFactorizations();
+  }
+
+  /// Get the number of numeric factorizations performed (specialized)
+  int p_numericFactorizations(void) const
+  {
+    return p_impl->numericFactorizations();
+  }
+
 };
 
 typedef LinearMatrixSolverT<ComplexType> ComplexLinearMatrixSolver;
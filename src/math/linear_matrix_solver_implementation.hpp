@@ -49,7 +49,9 @@ public:
       parallel::Distributed(A.communicator()),
       utility::Configurable(),
       utility::Uncopyable(),
-      p_A(A.clone())
+      p_A(A.clone()),
+      p_nSymbolic(0),
+      p_nNumeric(0)
   {
     configurationKey("LinearMatrixSolver");
   }
@@ -65,14 +67,41 @@ public:
     return this->p_solve(B);
   }
 
+  /// Solve w/ the specified RHS Matrix, put result in specified Matrix
+  void solve(const MatrixType& B, MatrixType& X) const
+  {
+    this->p_solve(B, X);
+  }
+
 protected:
 
   /// The coefficient matrix (may not need to remember)
   boost::scoped_ptr<MatrixType> p_A;
+
+  /// Number of symbolic factorizations performed
+  mutable int p_nSymbolic;
+
+  /// Number of numeric factorizations performed
+  mutable int p_nNumeric;
+
+  /// Get the number of symbolic factorizations performed (specialized)
+  int p_symbolicFactorizations(void) const
+  {
+    return p_nSymbolic;
+  }
+
+  /// Get the number of numeric factorizations performed (specialized)
+  int p_numericFactorizations(void) const
+  {
+    return p_nNumeric;
+  }
   
   /// Solve w/ the specified RHS Matrix (specialized)
   virtual MatrixType *p_solve(const MatrixType& B) const = 0;
 
+  /// Solve w/ the specified RHS Matrix, put result in specified Matrix (specialized)
+  virtual void p_solve(const MatrixType& B, MatrixType& X) const = 0;
+
 };
 
 
@@ -55,11 +55,92 @@ public:
     return this->p_solve(B);
   }
 
+  /// Solve w/ the specified RHS Matrix, put result in specified (dense) Matrix
+  /** 
+   * @e Collective.
+   *
+   * This avoids creating a new solution Matrix for every solve when
+   * the same right hand side layout is solved repeatedly.  @c X must
+   * be \ref Matrix::Dense "dense" and have the same size and
+   * distribution as @c B.
+   * 
+   * @param B RHS matrix
+   * @param X solution matrix
+   */
+  void solve(const MatrixType& B, MatrixType& X) const
+  {
+    this->p_solve(B, X);
+  }
+
+  /// Update coefficient values, keeping the existing symbolic factorization
+  /** 
+   * @e Collective.
+   *
+   * Replace the coefficient Matrix values with those in @c A, which
+   * must have the same nonzero pattern as the coefficient Matrix
+   * used for construction. The next call to solve() keeps the
+   * ordering and symbolic factorization and only recomputes the
+   * numeric factorization.
+   * 
+   * @param A new coefficient Matrix
+   */
+  void numericRefactor(const MatrixType& A)
+  {
+    this->p_numericRefactor(A);
+  }
+
+  /// Replace the coefficient Matrix and discard any existing factorization
+  /** 
+   * @e Collective.
+   *
+   * The next call to solve() computes a new ordering and symbolic
+   * factorization.
+   * 
+   * @param A new coefficient Matrix
+   */
+  void refactor(const MatrixType& A)
+  {
+    this->p_refactor(A);
+  }
+
+  /// Get the number of symbolic factorizations performed
+  int symbolicFactorizations(void) const
+  {
+    return this->p_symbolicFactorizations();
+  }
+
+  /// Get the number of numeric factorizations performed
+  int numericFactorizations(void) const
+  {
+    return this->p_numericFactorizations();
+  }
+
+  /// Get the number of factorizations that reused a symbolic factorization
+  int skippedSymbolicFactorizations(void) const
+  {
+    return this->p_numericFactorizations() - this->p_symbolicFactorizations();
+  }
+
 protected:
 
   /// Solve w/ the specified RHS Matrix (specialized)
   virtual MatrixType *p_solve(const MatrixType& B) const = 0;
 
+  /// Solve w/ the specified RHS Matrix, put result in specified Matrix (specialized)
+  virtual void p_solve(const MatrixType& B, MatrixType& X) const = 0;
+
+  /// Update coefficient values (specialized)
+  virtual void p_numericRefactor(const MatrixType& A) = 0;
+
+  /// Replace the coefficient Matrix (specialized)
+  virtual void p_refactor(const MatrixType& A) = 0;
+
+  /// Get the number of symbolic factorizations performed (specialized)
+  virtual int p_symbolicFactorizations(void) const = 0;
+
+  /// Get the number of numeric factorizations performed (specialized)
+  virtual int p_numericFactorizations(void) const = 0;
+
 };
 
 
@@ -202,6 +202,36 @@ protected:
     return p_solver->solve(B);
   }
 
+  /// Solve multiple systems w/ each column of a Matrix a single RHS, put result in specified Matrix (specialized)
+  void p_solve(const MatrixType& B, MatrixType& X) const
+  {
+    p_solver->solve(B, X);
+  }
+
+  /// Reuse the existing symbolic factorization (specialized)
+  void p_numericRefactor(void)
+  {
+    p_solver->numericRefactor();
+  }
+
+  /// Discard any existing factorization (specialized)
+  void p_refactor(void)
+  {
+    p_solver->refactor();
+  }
+
+  /// Get the number of symbolic factorizations performed (specialized)
+  int p_symbolicFactorizations(void) const
+  {
+    return p_solver->symbolicFactorizations();
+  }
+
+  /// Get the number of numeric factorizations performed (specialized)
+  int p_numericFactorizations(void) const
+  {
+    return p_solver->numericFactorizations();
+  }
+
 
 };
 
@@ -63,7 +63,11 @@ public:
       p_doSerial(false),
       p_constSerialMatrix(),
       p_guessZero(false),
-      p_serialSolution()
+      p_serialSolution(),
+      p_numericOnly(false),
+      p_forceSymbolic(false),
+      p_nSymbolic(0),
+      p_nNumeric(0)
   {
   }
 
@@ -137,6 +141,23 @@ protected:
   /// A buffer to use for value transfer
   mutable std::vector<TheType> p_valueBuffer;
 
+  /// Assume the nonzero pattern of the coefficient matrix is constant
+  /**
+   * If true, only numeric factorizations are done after the first
+   * solve. The ordering and symbolic factorization are reused.
+   * 
+   */
+  bool p_numericOnly;
+
+  /// Compute a new symbolic factorization in the next solve
+  mutable bool p_forceSymbolic;
+
+  /// Number of symbolic factorizations performed
+  mutable int p_nSymbolic;
+
+  /// Number of numeric factorizations performed
+  mutable int p_nNumeric;
+
   /// Specialized way to configure from property tree
   void p_configure(utility::Configuration::CursorPtr props)
   {
@@ -152,6 +173,7 @@ protected:
       p_doSerial = (p_doSerial && (this->processor_size() > 1));
 
       p_guessZero = props->get("InitialGuessZero", p_guessZero);
+      p_numericOnly = props->get("NumericRefactor", p_numericOnly);
     }
   }
 
@@ -179,6 +201,31 @@ protected:
     p_maxIterations = n;
   }
 
+  /// Reuse the existing symbolic factorization (specialized)
+  void p_numericRefactor(void)
+  {
+    p_numericOnly = true;
+  }
+
+  /// Discard any existing factorization (specialized)
+  void p_refactor(void)
+  {
+    p_numericOnly = false;
+    p_forceSymbolic = true;
+  }
+
+  /// Get the number of symbolic factorizations performed (specialized)
+  int p_symbolicFactorizations(void) const
+  {
+    return p_nSymbolic;
+  }
+
+  /// Get the number of numeric factorizations performed (specialized)
+  int p_numericFactorizations(void) const
+  {
+    return p_nNumeric;
+  }
+
   /// Solve the specified system w/ RHS and estimate (implementation)  
   virtual void p_solveImpl(MatrixType& A, const VectorType& b, VectorType& x) const = 0;
 
@@ -238,7 +285,14 @@ protected:
       if (!p_serialMatrix ) {
           p_serialMatrix.reset(p_matrix.localClone());
       } else if (!p_constSerialMatrix) {
+        if (p_numericOnly && !p_forceSymbolic) {
+          // keep the same serial matrix so the underlying library
+          // can recognize that only its values have changed
+          boost::scoped_ptr<MatrixType> tmp(p_matrix.localClone());
+          p_serialMatrix->equate(*tmp);
+        } else {
           p_serialMatrix.reset(p_matrix.localClone());
+        }
       }
       
       this->p_serialSolvePrep(b, x);
@@ -286,13 +340,33 @@ protected:
   /// Solve multiple systems w/ each column of the Matrix a single RHS
   MatrixType *p_solve(const MatrixType& B) const
   {
-    VectorType b(B.communicator(), B.localRows());
-    VectorType X(B.communicator(), B.localRows());
     MatrixType *result(new MatrixType(B.communicator(), B.localRows(), B.localCols(), Dense));
+    this->p_solve(B, *result);
+    return result;
+  }
+
+  /// Check that RHS and solution matrices are compatible w/ the coefficient matrix
+  void p_checkMultiple(const MatrixType& B, const MatrixType& X) const
+  {
+    if (B.rows() != p_matrix.rows() || X.rows() != p_matrix.rows() ||
+        B.localRows() != p_matrix.localRows() ||
+        X.localRows() != p_matrix.localRows()) {
+      throw Exception("LinearSolver::solve: RHS and solution matrices must have the same rows as the coefficient matrix");
+    }
+    if (B.cols() != X.cols()) {
+      throw Exception("LinearSolver::solve: RHS and solution matrices must have the same number of columns");
+    }
+  }
+
+  /// Solve multiple systems w/ each column of a Matrix a single RHS, one column at a time
+  void p_solveColumns(const MatrixType& B, MatrixType& X) const
+  {
+    VectorType b(B.communicator(), B.localRows());
+    VectorType x(B.communicator(), B.localRows());
 
     int ilo, ihi;
-    X.localIndexRange(ilo, ihi);
-    int nloc(X.localSize());
+    x.localIndexRange(ilo, ihi);
+    int nloc(x.localSize());
     std::vector<IdxType> iidx;
     iidx.reserve(nloc);
     for (IdxType i = ilo; i < ihi; ++i) { iidx.push_back(i); }
@@ -301,20 +375,31 @@ protected:
 
     for (int j = 0; j < B.cols(); ++j) {
       column(B, j, b);
-      X.zero();
-      X.ready();
+      x.zero();
+      x.ready();
       if (j == 0) {
-        this->solve(b, X);
+        this->solve(b, x);
       } else {
-        this->resolve(b, X);
+        this->resolve(b, x);
       }
       std::fill(jidx.begin(), jidx.end(), j);
-      X.getElements(nloc, &iidx[0], &locX[0]);
-      result->setElements(nloc, &iidx[0], &jidx[0], &locX[0]);
+      x.getElements(nloc, &iidx[0], &locX[0]);
+      X.setElements(nloc, &iidx[0], &jidx[0], &locX[0]);
     }
   
-    result->ready();
-    return result;
+    X.ready();
+  }
+
+  /// Solve multiple systems w/ each column of a Matrix a single RHS, put result in specified Matrix
+  /**
+   * This default implementation solves one column at a time.
+   * Implementations that can use a factored coefficient matrix
+   * directly should override this.
+   */
+  virtual void p_solve(const MatrixType& B, MatrixType& X) const
+  {
+    this->p_checkMultiple(B, X);
+    this->p_solveColumns(B, X);
   }
 
 };
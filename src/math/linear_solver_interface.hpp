@@ -156,6 +156,92 @@ public:
     return this->p_solve(B);
   }
 
+  /// Solve multiple systems w/ each column of a Matrix a single RHS, put result in specified Matrix
+  /** 
+   * @e Collective.
+   *
+   * Solve the linear system for all columns of @c B at once. If the
+   * underlying library has a factored coefficient matrix, all
+   * right hand sides are solved in a single pass over the factors.
+   * Otherwise, each column is solved separately.
+   *
+   * @c B and @c X must have the same communicator and row
+   * distribution as the coefficient Matrix and the same number of
+   * columns. @c X should be ::Dense; @c B is converted to ::Dense
+   * storage internally if necessary.  If these conditions are not
+   * met, an \ref Exception "exception" is thrown.
+   * 
+   * @param B RHS matrix -- each column is used as a RHS Vector
+   * @param X solution matrix -- each column is the solution for the corresponding column in @c B
+   */
+  void solve(const MatrixType& B, MatrixType& X) const
+  {
+    this->p_solve(B, X);
+  }
+
+  /// Reuse the existing symbolic factorization in subsequent solves
+  /** 
+   * @e Collective.
+   *
+   * Declare that the coefficient Matrix values may change between
+   * solves, but its nonzero pattern will not. Subsequent calls to
+   * solve() keep the ordering and symbolic factorization computed
+   * by an earlier solve and only recompute the numeric
+   * factorization. This stays in effect until refactor() is called.
+   * 
+   */
+  void numericRefactor(void)
+  {
+    this->p_numericRefactor();
+  }
+
+  /// Discard any existing factorization
+  /** 
+   * @e Collective.
+   *
+   * Declare that the nonzero pattern of the coefficient Matrix has
+   * changed. The next call to solve() computes a new ordering and
+   * symbolic factorization.
+   * 
+   */
+  void refactor(void)
+  {
+    this->p_refactor();
+  }
+
+  /// Get the number of symbolic factorizations performed
+  /** 
+   * For iterative methods, this is the number of times the
+   * preconditioner was built from scratch.
+   * 
+   * @return number of symbolic factorizations
+   */
+  int symbolicFactorizations(void) const
+  {
+    return this->p_symbolicFactorizations();
+  }
+
+  /// Get the number of numeric factorizations performed
+  /** 
+   * For iterative methods, this is the number of times the
+   * preconditioner was updated with new coefficient values.
+   * 
+   * @return number of numeric factorizations
+   */
+  int numericFactorizations(void) const
+  {
+    return this->p_numericFactorizations();
+  }
+
+  /// Get the number of factorizations that reused a symbolic factorization
+  /** 
+   * @return number of symbolic factorizations that were skipped
+   */
+  int skippedSymbolicFactorizations(void) const
+  {
+    return this->p_numericFactorizations() - this->p_symbolicFactorizations();
+  }
+
 
 protected:
 
@@ -195,6 +281,21 @@ protected:
   /// Solve multiple systems w/ each column of the Matrix a single RHS
   virtual MatrixType *p_solve(const MatrixType& B) const = 0;
 
+  /// Solve multiple systems w/ each column of a Matrix a single RHS, put result in specified Matrix (specialized)
+  virtual void p_solve(const MatrixType& B, MatrixType& X) const = 0;
+
+  /// Reuse the existing symbolic factorization (specialized)
+  virtual void p_numericRefactor(void) = 0;
+
+  /// Discard any existing factorization (specialized)
+  virtual void p_refactor(void) = 0;
+
+  /// Get the number of symbolic factorizations performed (specialized)
+  virtual int p_symbolicFactorizations(void) const = 0;
+
+  /// Get the number of numeric factorizations performed (specialized)
+  virtual int p_numericFactorizations(void) const = 0;
+
 };
 
 
@@ -328,6 +328,51 @@ protected:
     p_matrix_impl->addElements(n, i, j, x); 
   }
 
+  /// Set a dense block of elements
+  void p_setElementBlock(const IdxType& nrows, const IdxType *i,
+                         const IdxType& ncols, const IdxType *j,
+                         const TheType *x)
+  { 
+    p_matrix_impl->setElementBlock(nrows, i, ncols, j, x); 
+  }
+
+  /// Add to a dense block of elements
+  void p_addElementBlock(const IdxType& nrows, const IdxType *i,
+                         const IdxType& ncols, const IdxType *j,
+                         const TheType *x)
+  { 
+    p_matrix_impl->addElementBlock(nrows, i, ncols, j, x); 
+  }
+
+  /// Find where elements are kept in local matrix storage
+  bool p_getElementSlots(const IdxType& n, const IdxType *i,
+                         const IdxType *j,
+                         std::vector<IdxType>& slots) const
+  {
+    return p_matrix_impl->getElementSlots(n, i, j, slots);
+  }
+
+  /// Get the size of the local matrix storage
+  IdxType p_localStorageSize(void) const
+  {
+    return p_matrix_impl->localStorageSize();
+  }
+
+  /// Get a signature of the local nonzero structure
+  std::size_t p_localPatternSignature(void) const
+  {
+    return p_matrix_impl->localPatternSignature();
+  }
+
+  /// Place values directly in local matrix storage
+  void p_setSlotValues(const IdxType& n,
+                       const std::vector<IdxType>& slots,
+                       const TheType *x, const bool& add,
+                       const bool& zero)
+  {
+    p_matrix_impl->setSlotValues(n, slots, x, add, zero);
+  }
+
   /// Get an individual element
   void p_getElement(const IdxType& i, const IdxType& j, TheType& x) const
   { 
@@ -25,6 +25,7 @@
 #ifndef _matrix_interface_hpp_
 #define _matrix_interface_hpp_
 
+#include <vector>
 #include "gridpack/math/implementation_visitable.hpp"
 
 namespace gridpack {
@@ -171,6 +172,125 @@ public:
     this->p_addElements(n, i, j, x);
   }
 
+  /// Set a dense block of elements
+  /** 
+   * @e Local.
+   *
+   * This overwrites the values at all combinations of the specified
+   * rows and columns with a single call to the underlying library.
+   * ready() must be called after all setElementBlock() calls and
+   * before using the matrix.
+   * 
+   * @param nrows number of rows in block
+   * @param i array of @c nrows global, 0-based row indexes
+   * @param ncols number of columns in block
+   * @param j array of @c ncols global, 0-based column indexes
+   * @param x array of @c nrows*ncols values in column-major order,
+   * i.e. x[jj*nrows+ii] is placed at row i[ii], column j[jj]
+   */
+  void setElementBlock(const IdxType& nrows, const IdxType *i,
+                       const IdxType& ncols, const IdxType *j,
+                       const TheType *x)
+  {
+    this->p_setElementBlock(nrows, i, ncols, j, x);
+  }
+
+  /// Add to a dense block of elements
+  /** 
+   * @e Local.
+   *
+   * @param nrows number of rows in block
+   * @param i array of @c nrows global, 0-based row indexes
+   * @param ncols number of columns in block
+   * @param j array of @c ncols global, 0-based column indexes
+   * @param x array of @c nrows*ncols values in column-major order
+   */
+  void addElementBlock(const IdxType& nrows, const IdxType *i,
+                       const IdxType& ncols, const IdxType *j,
+                       const TheType *x)
+  {
+    this->p_addElementBlock(nrows, i, ncols, j, x);
+  }
+
+  /// Find where elements are kept in local matrix storage
+  /** 
+   * @e Local.
+   *
+   * Find the locations in the underlying library storage of a list
+   * of elements in the current nonzero structure of the matrix. The
+   * returned slots can be passed to setSlotValues() to refill the
+   * matrix without searching for each element. Only locally owned
+   * rows can be located. Slots are only valid as long as the nonzero
+   * structure of the matrix does not change (see localStorageSize()).
+   * 
+   * @param n number of elements
+   * @param i array of @c n global, 0-based row indexes
+   * @param j array of @c n global, 0-based column indexes
+   * @param slots storage locations of elements (there may be more
+   * than one location per element)
+   * 
+   * @return false if the elements could not all be located or
+   * the matrix storage does not support direct access
+   */
+  bool getElementSlots(const IdxType& n, const IdxType *i, const IdxType *j,
+                       std::vector<IdxType>& slots) const
+  {
+    return this->p_getElementSlots(n, i, j, slots);
+  }
+
+  /// Get the size of the local matrix storage
+  /** 
+   * @e Local.
+   *
+   * This changes if the nonzero structure of the matrix changes and
+   * can be used to check if slots from getElementSlots() are still
+   * valid.
+   * 
+   * @return number of stored values, or -1 if storage cannot be
+   * accessed directly
+   */
+  IdxType localStorageSize(void) const
+  {
+    return this->p_localStorageSize();
+  }
+
+  /// Get a signature of the local nonzero structure
+  /** 
+   * @e Local.
+   *
+   * The signature changes whenever the nonzero structure of the local
+   * matrix storage changes and differs between matrix objects (barring
+   * hash collisions), so this can be used to check if slots from
+   * getElementSlots() were found for the same structure. Where the
+   * library tracks changes to the nonzero structure, this does not
+   * require a pass over the matrix storage.
+   * 
+   * @return signature of local nonzero structure, or 0 if storage
+   * cannot be accessed directly
+   */
+  std::size_t localPatternSignature(void) const
+  {
+    return this->p_localPatternSignature();
+  }
+
+  /// Place values directly in local matrix storage
+  /** 
+   * @e Local.
+   *
+   * ready() should still be called before the matrix is used.
+   * 
+   * @param n number of values
+   * @param slots storage locations of the values from getElementSlots()
+   * @param x array of @c n values
+   * @param add if true, add values to matrix, otherwise overwrite them
+   * @param zero if true, set all other local values to zero
+   */
+  void setSlotValues(const IdxType& n, const std::vector<IdxType>& slots,
+                     const TheType *x, const bool& add, const bool& zero)
+  {
+    this->p_setSlotValues(n, slots, x, add, zero);
+  }
+
   /// Get an individual element
   /** 
    * @c Local.
@@ -409,6 +529,59 @@ protected:
   virtual void p_addElements(const IdxType& n, const IdxType *i, const IdxType *j, 
                              const TheType *x) = 0;
 
+  /// Set a dense block of elements (specialized)
+  virtual void p_setElementBlock(const IdxType& nrows, const IdxType *i,
+                                 const IdxType& ncols, const IdxType *j,
+                                 const TheType *x)
+  {
+    for (IdxType jj = 0; jj < ncols; ++jj) {
+      for (IdxType ii = 0; ii < nrows; ++ii) {
+        this->p_setElement(i[ii], j[jj], x[jj*nrows+ii]);
+      }
+    }
+  }
+
+  /// Add to a dense block of elements (specialized)
+  virtual void p_addElementBlock(const IdxType& nrows, const IdxType *i,
+                                 const IdxType& ncols, const IdxType *j,
+                                 const TheType *x)
+  {
+    for (IdxType jj = 0; jj < ncols; ++jj) {
+      for (IdxType ii = 0; ii < nrows; ++ii) {
+        this->p_addElement(i[ii], j[jj], x[jj*nrows+ii]);
+      }
+    }
+  }
+
+  /// Find where elements are kept in local matrix storage (specialized)
+  virtual bool p_getElementSlots(const IdxType& n, const IdxType *i,
+                                 const IdxType *j,
+                                 std::vector<IdxType>& slots) const
+  {
+    slots.clear();
+    return false;
+  }
+
+  /// Get the size of the local matrix storage (specialized)
+  virtual IdxType p_localStorageSize(void) const
+  {
+    return -1;
+  }
+
+  /// Get a signature of the local nonzero structure (specialized)
+  virtual std::size_t p_localPatternSignature(void) const
+  {
+    return 0;
+  }
+
+  /// Place values directly in local matrix storage (specialized)
+  virtual void p_setSlotValues(const IdxType& n,
+                               const std::vector<IdxType>& slots,
+                               const TheType *x, const bool& add,
+                               const bool& zero)
+  {
+  }
+
   /// Get an individual element (specialized)
   virtual void p_getElement(const IdxType& i, const IdxType& j, TheType& x) const = 0;
 
@@ -50,6 +50,7 @@ public:
   PetscLinearMatrixSolverImplementation(const MatrixType& A)
     : LinearMatrixSolverImplementation<T, I>(A),
       PETScConfigurable(this->communicator()),
+      p_symbolic(false),
       p_factored(false),
       p_orderingType(MATORDERINGND),
 #if defined(PETSC_HAVE_SUPERLU_DIST)
@@ -72,7 +73,7 @@ public:
     try  {
       PetscBool ok;
       ierr = PetscInitialized(&ok);
-      if (ok && p_factored) {
+      if (ok && p_symbolic) {
         ierr = MatDestroy(&p_Fmat);
       }
     } catch (...) {
@@ -94,7 +95,10 @@ protected:
   /// The underlying PETSc factored coefficient matrix
   mutable Mat p_Fmat;
 
-  /// Is p_Fmat ready?
+  /// Has p_Fmat been created and symbolically factored?
+  mutable bool p_symbolic;
+
+  /// Is p_Fmat ready? (numeric factorization is current)
   mutable bool p_factored;
 
   /// List of supported matrix ordering
@@ -222,8 +226,21 @@ protected:
     this->build(props);
   }
 
-  /// Factor the coefficient matrix
-  void p_factor(void) const
+  /// Fill in factorization options
+  void p_factorInfo(MatFactorInfo& info) const
+  {
+    PetscErrorCode ierr(0);
+    try {
+      ierr = MatFactorInfoInitialize(&info); CHKERRXX(ierr);
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+    info.fill = p_fill;
+    info.dtcol = (p_pivot ? 1 : 0);
+  }
+
+  /// Order and symbolically factor the coefficient matrix
+  void p_factorSymbolic(void) const
   {
     PetscErrorCode ierr(0);
   
@@ -232,38 +249,127 @@ protected:
       MatFactorInfo  info;
       IS perm, iperm;
 
+      p_factorInfo(info);
       ierr = MatGetOrdering(*A, p_orderingType, &perm, &iperm); CHKERRXX(ierr);
       ierr = MatGetFactor(*A, p_solverPackage, p_factorType, &p_Fmat);CHKERRXX(ierr);
-      info.fill = p_fill;
-      info.dtcol = (p_pivot ? 1 : 0);
 
       ierr = MatLUFactorSymbolic(p_Fmat, *A, perm, iperm, &info); CHKERRXX(ierr);
-      ierr = MatLUFactorNumeric(p_Fmat, *A, &info); CHKERRXX(ierr);
 
       ierr = ISDestroy(&perm); CHKERRXX(ierr);
       ierr = ISDestroy(&iperm); CHKERRXX(ierr);
 
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+    p_symbolic = true;
+    p_factored = false;
+    this->p_nSymbolic++;
+  }
+
+  /// Numerically factor the coefficient matrix
+  void p_factorNumeric(void) const
+  {
+    PetscErrorCode ierr(0);
+  
+    try {
+      Mat *A(PETScMatrix(*LinearMatrixSolverImplementation<T, I>::p_A));
+      MatFactorInfo  info;
+
+      p_factorInfo(info);
+      ierr = MatLUFactorNumeric(p_Fmat, *A, &info); CHKERRXX(ierr);
+
     } catch (const PETSC_EXCEPTION_TYPE& e) {
       throw PETScException(ierr, e);
     }
     p_factored = true;
+    this->p_nNumeric++;
   }
 
-  /// Solve w/ the specified RHS Matrix (specialized)
-  MatrixType *p_solve(const MatrixType& B) const
+  /// Factor the coefficient matrix
+  void p_factor(void) const
+  {
+    if (!p_symbolic) {
+      p_factorSymbolic();
+    }
+    if (!p_factored) {
+      p_factorNumeric();
+    }
+  }
+
+  /// Throw away the factored matrix
+  void p_destroyFactor(void)
   {
     PetscErrorCode ierr(0);
-    Mat X;
+    try {
+      if (p_symbolic) {
+        ierr = MatDestroy(&p_Fmat); CHKERRXX(ierr);
+      }
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+    p_symbolic = false;
+    p_factored = false;
+  }
+
+  /// Update coefficient values (specialized)
+  void p_numericRefactor(const MatrixType& A)
+  {
+    LinearMatrixSolverImplementation<T, I>::p_A->equate(A);
+    p_factored = false;
+  }
 
-    // FIXME: enforce B is dense, or copy and convert
+  /// Replace the coefficient Matrix (specialized)
+  void p_refactor(const MatrixType& A)
+  {
+    p_destroyFactor();
+    LinearMatrixSolverImplementation<T, I>::p_A.reset(A.clone());
+  }
+
+  /// Get a dense version of a RHS Matrix
+  /** 
+   * MatMatSolve() requires a dense RHS. If @c B is not dense, a
+   * dense copy is made which must be destroyed by the caller
+   * 
+   * @param B RHS matrix
+   * @param Bdense dense PETSc matrix with the same values as @c B
+   * 
+   * @return true if @c Bdense is a copy
+   */
+  bool p_denseRHS(const MatrixType& B, Mat *Bdense) const
+  {
+    PetscErrorCode ierr(0);
+    PetscBool isdense;
     const Mat *Bmat(PETScMatrix(B));
+    try {
+      ierr = PetscObjectTypeCompareAny((PetscObject)(*Bmat), &isdense,
+                                       MATSEQDENSE, MATMPIDENSE, ""); CHKERRXX(ierr);
+      if (isdense) {
+        *Bdense = *Bmat;
+      } else {
+        ierr = MatConvert(*Bmat, MATDENSE, MAT_INITIAL_MATRIX, Bdense); CHKERRXX(ierr);
+      }
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+    return !isdense;
+  }
+
+  /// Solve w/ the specified RHS Matrix (specialized)
+  MatrixType *p_solve(const MatrixType& B) const
+  {
+    PetscErrorCode ierr(0);
+    Mat X, Bdense;
+    bool copied(p_denseRHS(B, &Bdense));
 
     try {
       if (!p_factored) {
         p_factor();
       }
-      ierr = MatDuplicate(*Bmat, MAT_DO_NOT_COPY_VALUES, &X); CHKERRXX(ierr);
-      ierr = MatMatSolve(p_Fmat, *Bmat, X); CHKERRXX(ierr);
+      ierr = MatDuplicate(Bdense, MAT_DO_NOT_COPY_VALUES, &X); CHKERRXX(ierr);
+      ierr = MatMatSolve(p_Fmat, Bdense, X); CHKERRXX(ierr);
+      if (copied) {
+        ierr = MatDestroy(&Bdense); CHKERRXX(ierr);
+      }
     } catch (const PETSC_EXCEPTION_TYPE& e) {
       throw PETScException(ierr, e);
     }
@@ -281,6 +387,32 @@ protected:
     return result;
   }
 
+  /// Solve w/ the specified RHS Matrix, put result in specified Matrix (specialized)
+  void p_solve(const MatrixType& B, MatrixType& X) const
+  {
+    if (B.rows() != X.rows() || B.cols() != X.cols() ||
+        B.localRows() != X.localRows()) {
+      throw Exception("LinearMatrixSolver::solve: RHS and solution matrices must be the same size");
+    }
+    PetscErrorCode ierr(0);
+    Mat Bdense;
+    bool copied(p_denseRHS(B, &Bdense));
+    Mat *Xmat(PETScMatrix(X));
+
+    try {
+      if (!p_factored) {
+        p_factor();
+      }
+      ierr = MatMatSolve(p_Fmat, Bdense, *Xmat); CHKERRXX(ierr);
+      if (copied) {
+        ierr = MatDestroy(&Bdense); CHKERRXX(ierr);
+      }
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+    X.ready();
+  }
+
 };
 
 template <typename T, typename I>
@@ -50,7 +50,8 @@ public:
   PETScLinearSolverImplementation(MatrixType& A)
     : LinearSolverImplementation<T, I>(A),
       PETScConfigurable(this->communicator()),
-      p_matrixSet(false)
+      p_matrixSet(false),
+      p_lastMat(NULL)
   {
   }
 
@@ -78,6 +79,87 @@ protected:
   /// For constant matrices, has the coefficient matrix been set
   mutable bool p_matrixSet;
 
+  /// The coefficient matrix used in the last solve
+  mutable Mat p_lastMat;
+
+#if PETSC_VERSION_GE(3,5,0)
+  /// The state of the coefficient matrix in the last solve
+  mutable PetscObjectState p_lastState;
+#endif
+
+#if PETSC_VERSION_GE(3,7,0)
+  /// The nonzero state of the coefficient matrix in the last solve
+  mutable PetscObjectState p_lastNonzeroState;
+#endif
+
+  /// Figure out what kind of factorization is needed for the coefficient matrix
+  /** 
+   * PETSc decides for itself whether the preconditioner needs to be
+   * rebuilt, so this mainly keeps statistics. The factorization is
+   * assumed to be symbolic unless the same matrix is used with the
+   * same nonzero pattern as the last solve.
+   * 
+   * @param A coefficient matrix
+   * @param symbolic true if a symbolic factorization is needed
+   * 
+   * @return true if any factorization is needed
+   */
+  bool p_factorizationNeeded(Mat A, bool& symbolic) const
+  {
+    PetscErrorCode ierr(0);
+    bool factor(true);
+    symbolic = true;
+    try {
+#if PETSC_VERSION_GE(3,5,0)
+      PetscObjectState state;
+      ierr = PetscObjectStateGet((PetscObject)A, &state); CHKERRXX(ierr);
+#endif
+#if PETSC_VERSION_GE(3,7,0)
+      PetscObjectState nzstate;
+      ierr = MatGetNonzeroState(A, &nzstate); CHKERRXX(ierr);
+#endif
+      if (p_matrixSet && A == p_lastMat && !this->p_forceSymbolic) {
+#if PETSC_VERSION_GE(3,5,0)
+        factor = (state != p_lastState);
+#endif
+        symbolic = !this->p_numericOnly;
+#if PETSC_VERSION_GE(3,7,0)
+        symbolic = symbolic && (nzstate != p_lastNonzeroState);
+#elif PETSC_VERSION_LT(3,5,0)
+        // KSPSetOperators() is always told the pattern is the same
+        symbolic = false;
+#endif
+        symbolic = symbolic && factor;
+      }
+      p_lastMat = A;
+#if PETSC_VERSION_GE(3,5,0)
+      p_lastState = state;
+#endif
+#if PETSC_VERSION_GE(3,7,0)
+      p_lastNonzeroState = nzstate;
+#endif
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+    return factor;
+  }
+
+  /// Tell a factorization preconditioner to keep its ordering and fill
+  void p_reuseOrdering(const bool& flag) const
+  {
+    PetscErrorCode ierr(0);
+    try {
+      PC pc;
+      PetscBool reuse(flag ? PETSC_TRUE : PETSC_FALSE);
+      ierr = KSPGetPC(p_KSP, &pc); CHKERRXX(ierr);
+      // these have no effect unless pc is a factorization
+      ierr = PCFactorSetReuseOrdering(pc, reuse); CHKERRXX(ierr);
+      ierr = PCFactorSetReuseFill(pc, reuse); CHKERRXX(ierr);
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+  }
+
   /// Do what is necessary to build this instance
   void p_build(const std::string& option_prefix)
   {
@@ -107,8 +189,8 @@ protected:
     }
   }  
 
-  /// Solve w/ the specified RHS and estimate (result in x)
-  void p_solveImpl(MatrixType& A, const VectorType& b, VectorType& x) const
+  /// Give the coefficient matrix to the KSP, if necessary
+  void p_setOperators(MatrixType& A) const
   {
     PetscErrorCode ierr(0);
     try {
@@ -117,39 +199,49 @@ protected:
       if (p_matrixSet && this->p_constSerialMatrix) {
         // KSPSetOperators can be skipped
       } else {
+        bool symbolic;
+        bool factor(p_factorizationNeeded(*Amat, symbolic));
+        if (this->p_forceSymbolic && p_matrixSet) {
+          // throw away the old preconditioner completely
+          p_reuseOrdering(false);
+          ierr = KSPReset(p_KSP); CHKERRXX(ierr);
+        }
+        if (this->p_numericOnly) {
+          p_reuseOrdering(true);
+        }
 #if PETSC_VERSION_LT(3,5,0)
-        ierr = KSPSetOperators(p_KSP, *Amat, *Amat, SAME_NONZERO_PATTERN); CHKERRXX(ierr);
+        ierr = KSPSetOperators(p_KSP, *Amat, *Amat, 
+                               (this->p_forceSymbolic ? DIFFERENT_NONZERO_PATTERN : SAME_NONZERO_PATTERN)); CHKERRXX(ierr);
 #else
         ierr = KSPSetOperators(p_KSP, *Amat, *Amat); CHKERRXX(ierr);
 #endif
         p_matrixSet = true;
+        this->p_forceSymbolic = false;
+        if (factor) this->p_nNumeric++;
+        if (symbolic) this->p_nSymbolic++;
       }
-
-      this->p_resolveImpl(b, x);
-          
     } catch (const PETSC_EXCEPTION_TYPE& e) {
       throw PETScException(ierr, e);
-    } catch (const Exception& e) {
-      throw e;
     }
   }
 
-  /// Solve again w/ the specified RHS, put result in specified vector (specialized)
-  void p_resolveImpl(const VectorType& b, VectorType& x) const
+  /// Solve w/ the specified RHS and estimate (result in x)
+  void p_solveImpl(MatrixType& A, const VectorType& b, VectorType& x) const
+  {
+    this->p_setOperators(A);
+    this->p_resolveImpl(b, x);
+  }
+
+  /// Check the KSP convergence after a solve
+  void p_checkConvergence(void) const
   {
     PetscErrorCode ierr(0);
     int me(this->processor_rank());
     try {
-      const Vec *bvec(PETScVector(b));
-      Vec *xvec(PETScVector(x));
-
-      ierr = KSPSolve(p_KSP, *bvec, *xvec); CHKERRXX(ierr);
       int its;
       KSPConvergedReason reason;
-      PetscReal rnorm;
       ierr = KSPGetIterationNumber(p_KSP, &its); CHKERRXX(ierr);
       ierr = KSPGetConvergedReason(p_KSP, &reason); CHKERRXX(ierr);
-      ierr = KSPGetResidualNorm(p_KSP, &rnorm); CHKERRXX(ierr);
       std::string msg;
       if (reason < 0) {
         msg = 
@@ -164,6 +256,93 @@ protected:
       }
     } catch (const PETSC_EXCEPTION_TYPE& e) {
       throw PETScException(ierr, e);
+    }
+  }
+
+  /// Solve multiple systems w/ each column of a Matrix a single RHS, put result in specified Matrix (specialized)
+  /** 
+   * If the preconditioner is a direct factorization, MatMatSolve()
+   * is applied to the factored matrix so all columns of @c B are
+   * solved in one pass over the factors. Otherwise, KSPMatSolve() is
+   * used if available. Serial solves and non-dense solution matrices
+   * fall back to solving one column at a time.
+   * 
+   * @param B RHS matrix
+   * @param X solution matrix
+   */
+  void p_solve(const MatrixType& B, MatrixType& X) const
+  {
+    this->p_checkMultiple(B, X);
+    if (this->p_doSerial) {
+      this->p_solveColumns(B, X);
+      return;
+    }
+
+    PetscErrorCode ierr(0);
+    bool done(false);
+    try {
+      const Mat *Bmat(PETScMatrix(B));
+      Mat *Xmat(PETScMatrix(X));
+      PetscBool xdense, bdense;
+      ierr = PetscObjectTypeCompareAny((PetscObject)(*Xmat), &xdense,
+                                       MATSEQDENSE, MATMPIDENSE, ""); CHKERRXX(ierr);
+      if (xdense) {
+        ierr = PetscObjectTypeCompareAny((PetscObject)(*Bmat), &bdense,
+                                         MATSEQDENSE, MATMPIDENSE, ""); CHKERRXX(ierr);
+        Mat Bdense;
+        if (bdense) {
+          Bdense = *Bmat;
+        } else {
+          ierr = MatConvert(*Bmat, MATDENSE, MAT_INITIAL_MATRIX, &Bdense); CHKERRXX(ierr);
+        }
+
+        this->p_setOperators(this->p_matrix);
+        ierr = KSPSetUp(p_KSP); CHKERRXX(ierr);
+        PC pc;
+        PetscBool direct;
+        ierr = KSPGetPC(p_KSP, &pc); CHKERRXX(ierr);
+        ierr = PetscObjectTypeCompareAny((PetscObject)pc, &direct,
+                                         PCLU, PCCHOLESKY, ""); CHKERRXX(ierr);
+        if (direct) {
+          Mat F;
+          ierr = PCFactorGetMatrix(pc, &F); CHKERRXX(ierr);
+          ierr = MatMatSolve(F, Bdense, *Xmat); CHKERRXX(ierr);
+          done = true;
+        } else {
+#if PETSC_VERSION_GE(3,14,0)
+          ierr = KSPMatSolve(p_KSP, Bdense, *Xmat); CHKERRXX(ierr);
+          this->p_checkConvergence();
+          done = true;
+#endif
+        }
+
+        if (!bdense) {
+          ierr = MatDestroy(&Bdense); CHKERRXX(ierr);
+        }
+      }
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+
+    if (done) {
+      X.ready();
+    } else {
+      this->p_solveColumns(B, X);
+    }
+  }
+
+  /// Solve again w/ the specified RHS, put result in specified vector (specialized)
+  void p_resolveImpl(const VectorType& b, VectorType& x) const
+  {
+    PetscErrorCode ierr(0);
+    try {
+      const Vec *bvec(PETScVector(b));
+      Vec *xvec(PETScVector(x));
+
+      ierr = KSPSolve(p_KSP, *bvec, *xvec); CHKERRXX(ierr);
+      this->p_checkConvergence();
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
     } catch (const Exception& e) {
       throw e;
     }
@@ -20,6 +20,9 @@
 #ifndef _petsc_matrix_implementation_h_
 #define _petsc_matrix_implementation_h_
 
+#include <vector>
+#include <cstring>
+#include <algorithm>
 #include <petscmat.h>
 #include <boost/scoped_ptr.hpp>
 #include <boost/format.hpp>
@@ -181,6 +184,12 @@ protected:
   /// The actual PETSc matrix to be used
   boost::scoped_ptr<PetscMatrixWrapper> p_mwrap;
 
+  /// Scratch space used to assemble dense blocks for the library
+  std::vector<PetscScalar> p_blockTmp;
+  std::vector<PetscScalar> p_blockVals;
+  std::vector<PetscInt> p_blockRows;
+  std::vector<PetscInt> p_blockCols;
+
   /// Apply a specific unary operation to the vector
   void p_applyOperation(base_unary_function<TheType>& op)
   {
@@ -386,6 +395,386 @@ protected:
     }
   }
 
+  /// Set or add to a dense block of elements with one library call
+  /**
+   * The block is converted to the row-major layout expected by PETSc
+   * (expanding each element into an elementSize x elementSize block if
+   * necessary). If the matrix has a block size that matches the
+   * block and the block is aligned, MatSetValuesBlocked() is used.
+   * 
+   * @param nrows number of rows in block
+   * @param i global row indexes
+   * @param ncols number of columns in block
+   * @param j global column indexes
+   * @param x values in column-major order
+   * @param mode INSERT_VALUES or ADD_VALUES
+   */
+  void p_setElementBlock(const IdxType& nrows, const IdxType *i,
+                         const IdxType& ncols, const IdxType *j,
+                         const TheType *x, InsertMode mode)
+  {
+    if (nrows <= 0 || ncols <= 0) return;
+    PetscErrorCode ierr(0);
+    try {
+      Mat *mat = p_mwrap->getMatrix();
+      const int es(elementSize);
+      const PetscInt nr(nrows*es), nc(ncols*es);
+      const int nval(nrows*ncols);
+      p_blockTmp.resize(nval*es*es);
+      p_blockVals.resize(nr*nc);
+      p_blockRows.resize(nr);
+      p_blockCols.resize(nc);
+      MatrixValueTransferToLibrary<TheType, PetscScalar>
+        trans(nval, const_cast<TheType *>(x), &p_blockTmp[0]);
+      trans.go();
+      for (IdxType jj = 0; jj < ncols; ++jj) {
+        for (IdxType ii = 0; ii < nrows; ++ii) {
+          const PetscScalar *t = &p_blockTmp[(jj*nrows+ii)*es*es];
+          for (int ie = 0; ie < es; ++ie) {
+            for (int je = 0; je < es; ++je) {
+              p_blockVals[(ii*es+ie)*nc + jj*es+je] = t[ie*es+je];
+            }
+          }
+        }
+      }
+      for (IdxType ii = 0; ii < nrows; ++ii) {
+        for (int ie = 0; ie < es; ++ie) {
+          p_blockRows[ii*es+ie] = i[ii]*es + ie;
+        }
+      }
+      for (IdxType jj = 0; jj < ncols; ++jj) {
+        for (int je = 0; je < es; ++je) {
+          p_blockCols[jj*es+je] = j[jj]*es + je;
+        }
+      }
+
+      // Use blocked insertion if the block exactly covers one
+      // aligned matrix block
+      PetscInt bs(1);
+      ierr = MatGetBlockSize(*mat, &bs); CHKERRXX(ierr);
+      bool blocked(bs > 1 && nr == bs && nc == bs &&
+                   p_blockRows[0] % bs == 0 && p_blockCols[0] % bs == 0);
+      for (PetscInt k = 1; blocked && k < nr; ++k) {
+        blocked = (p_blockRows[k] == p_blockRows[0] + k);
+      }
+      for (PetscInt k = 1; blocked && k < nc; ++k) {
+        blocked = (p_blockCols[k] == p_blockCols[0] + k);
+      }
+      if (blocked) {
+        PetscInt bi(p_blockRows[0]/bs), bj(p_blockCols[0]/bs);
+        ierr = MatSetValuesBlocked(*mat, 1, &bi, 1, &bj,
+                                   &p_blockVals[0], mode); CHKERRXX(ierr);
+      } else {
+        ierr = MatSetValues(*mat, nr, &p_blockRows[0], nc, &p_blockCols[0],
+                            &p_blockVals[0], mode); CHKERRXX(ierr);
+      }
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+  }
+
+  /// Set a dense block of elements
+  void p_setElementBlock(const IdxType& nrows, const IdxType *i,
+                         const IdxType& ncols, const IdxType *j,
+                         const TheType *x)
+  {
+    p_setElementBlock(nrows, i, ncols, j, x, INSERT_VALUES);
+  }
+
+  /// Add to a dense block of elements
+  void p_addElementBlock(const IdxType& nrows, const IdxType *i,
+                         const IdxType& ncols, const IdxType *j,
+                         const TheType *x)
+  {
+    p_setElementBlock(nrows, i, ncols, j, x, ADD_VALUES);
+  }
+
+  /// Get the sequential AIJ matrices that hold the local part of this matrix
+  /**
+   * For a parallel matrix, @c A holds the locally owned columns and
+   * @c B holds the remaining columns, which are numbered by their
+   * position in @c garray.
+   *
+   * @return false if the matrix is not assembled or is not stored in
+   * AIJ format
+   */
+  bool p_localAIJ(Mat& A, Mat& B, const PetscInt*& garray) const
+  {
+    PetscErrorCode ierr(0);
+    try {
+      Mat *mat = p_mwrap->getMatrix();
+      PetscBool assembled;
+      ierr = MatAssembled(*mat, &assembled); CHKERRXX(ierr);
+      if (!assembled) return false;
+      MatType type;
+      ierr = MatGetType(*mat, &type); CHKERRXX(ierr);
+      if (std::strcmp(type, MATSEQAIJ) == 0) {
+        A = *mat;
+        B = PETSC_NULL;
+        garray = PETSC_NULL;
+      } else if (std::strcmp(type, MATMPIAIJ) == 0) {
+        ierr = MatMPIAIJGetSeqAIJ(*mat, &A, &B, &garray); CHKERRXX(ierr);
+      } else {
+        return false;
+      }
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+    return true;
+  }
+
+  /// Mix an integer into a hash value
+  static void p_hashCombine(std::size_t& seed, const std::size_t& v)
+  {
+    seed ^= static_cast<std::size_t>(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  }
+
+#if PETSC_VERSION_LT(3,7,0)
+  /// Hash the row offsets and column indexes of a sequential AIJ matrix
+  static std::size_t p_patternHash(Mat A, std::size_t seed)
+  {
+    PetscErrorCode ierr(0);
+    try {
+      PetscInt n;
+      const PetscInt *ia, *ja;
+      PetscBool done;
+      ierr = MatGetRowIJ(A, 0, PETSC_FALSE, PETSC_FALSE, &n, &ia, &ja, &done); CHKERRXX(ierr);
+      if (done) {
+        p_hashCombine(seed, n);
+        for (PetscInt k = 0; k <= n; ++k) p_hashCombine(seed, ia[k]);
+        for (PetscInt k = 0; k < ia[n]; ++k) p_hashCombine(seed, ja[k]);
+      }
+      ierr = MatRestoreRowIJ(A, 0, PETSC_FALSE, PETSC_FALSE, &n, &ia, &ja, &done); CHKERRXX(ierr);
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+    return seed;
+  }
+#endif
+
+  /// Get the number of values stored in a sequential AIJ matrix
+  static PetscInt p_storedValues(Mat A)
+  {
+    PetscErrorCode ierr(0);
+    PetscInt result(0);
+    if (A == PETSC_NULL) return result;
+    try {
+      PetscInt n;
+      const PetscInt *ia, *ja;
+      PetscBool done;
+      ierr = MatGetRowIJ(A, 0, PETSC_FALSE, PETSC_FALSE, &n, &ia, &ja, &done); CHKERRXX(ierr);
+      if (done) result = ia[n];
+      ierr = MatRestoreRowIJ(A, 0, PETSC_FALSE, PETSC_FALSE, &n, &ia, &ja, &done); CHKERRXX(ierr);
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+    return result;
+  }
+
+  /// Find where elements are kept in local matrix storage (specialized)
+  /**
+   * Slots index the values of the diagonal block followed by the
+   * values of the off-diagonal block. Each element has
+   * elementSize*elementSize slots, in row-major order.
+   */
+  bool p_getElementSlots(const IdxType& n, const IdxType *i, const IdxType *j,
+                         std::vector<IdxType>& slots) const
+  {
+    slots.clear();
+    Mat A, B;
+    const PetscInt *garray;
+    if (!p_localAIJ(A, B, garray)) return false;
+
+    PetscErrorCode ierr(0);
+    bool ok(true);
+    try {
+      Mat *mat = p_mwrap->getMatrix();
+      PetscInt rlo, rhi, clo, chi;
+      ierr = MatGetOwnershipRange(*mat, &rlo, &rhi); CHKERRXX(ierr);
+      ierr = MatGetOwnershipRangeColumn(*mat, &clo, &chi); CHKERRXX(ierr);
+
+      PetscInt na(0), nb(0), nbcols(0);
+      const PetscInt *ia, *ja, *ib(PETSC_NULL), *jb(PETSC_NULL);
+      PetscBool done;
+      ierr = MatGetRowIJ(A, 0, PETSC_FALSE, PETSC_FALSE, &na, &ia, &ja, &done); CHKERRXX(ierr);
+      ok = done;
+      if (B != PETSC_NULL) {
+        ierr = MatGetRowIJ(B, 0, PETSC_FALSE, PETSC_FALSE, &nb, &ib, &jb, &done); CHKERRXX(ierr);
+        ok = ok && done;
+        ierr = MatGetSize(B, PETSC_NULL, &nbcols); CHKERRXX(ierr);
+      }
+      const PetscInt nnza(ok ? ia[na] : 0);
+
+      slots.reserve(n*elementSize*elementSize);
+      for (IdxType k = 0; ok && k < n; ++k) {
+        for (int ie = 0; ok && ie < elementSize; ++ie) {
+          PetscInt row(i[k]*elementSize + ie);
+          if (row < rlo || row >= rhi) {
+            ok = false;
+            break;
+          }
+          PetscInt lrow(row - rlo);
+          for (int je = 0; je < elementSize; ++je) {
+            PetscInt col(j[k]*elementSize + je);
+            const PetscInt *first, *last, *p;
+            if (col >= clo && col < chi) {
+              first = ja + ia[lrow];
+              last = ja + ia[lrow+1];
+              p = std::lower_bound(first, last, col - clo);
+              if (p == last || *p != col - clo) {
+                ok = false;
+                break;
+              }
+              slots.push_back(static_cast<IdxType>(p - ja));
+            } else if (B != PETSC_NULL) {
+              const PetscInt *g = std::lower_bound(garray, garray + nbcols, col);
+              if (g == garray + nbcols || *g != col) {
+                ok = false;
+                break;
+              }
+              PetscInt bcol(g - garray);
+              first = jb + ib[lrow];
+              last = jb + ib[lrow+1];
+              p = std::lower_bound(first, last, bcol);
+              if (p == last || *p != bcol) {
+                ok = false;
+                break;
+              }
+              slots.push_back(static_cast<IdxType>(nnza + (p - jb)));
+            } else {
+              ok = false;
+              break;
+            }
+          }
+        }
+      }
+
+      ierr = MatRestoreRowIJ(A, 0, PETSC_FALSE, PETSC_FALSE, &na, &ia, &ja, &done); CHKERRXX(ierr);
+      if (B != PETSC_NULL) {
+        ierr = MatRestoreRowIJ(B, 0, PETSC_FALSE, PETSC_FALSE, &nb, &ib, &jb, &done); CHKERRXX(ierr);
+      }
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+    if (!ok) slots.clear();
+    return ok;
+  }
+
+  /// Get the size of the local matrix storage (specialized)
+  IdxType p_localStorageSize(void) const
+  {
+    Mat A, B;
+    const PetscInt *garray;
+    if (!p_localAIJ(A, B, garray)) return -1;
+    return static_cast<IdxType>(p_storedValues(A) + p_storedValues(B));
+  }
+
+  /// Get a signature of the local nonzero structure (specialized)
+  /**
+   * Hash of the object id and the nonzero state of the PETSc matrix,
+   * which PETSc increments whenever the nonzero structure changes, so no
+   * pass over the matrix storage is needed. Older PETSc versions do not
+   * track the nonzero state; there the row offsets and column indexes of
+   * the diagonal and off-diagonal blocks and the global column numbers of
+   * the off-diagonal block are hashed instead.
+   */
+  std::size_t p_localPatternSignature(void) const
+  {
+    Mat A, B;
+    const PetscInt *garray;
+    if (!p_localAIJ(A, B, garray)) return 0;
+#if PETSC_VERSION_GE(3,7,0)
+    std::size_t result(0);
+    PetscErrorCode ierr(0);
+    try {
+      Mat *mat = p_mwrap->getMatrix();
+      PetscObjectId id;
+      PetscObjectState nzstate;
+      ierr = PetscObjectGetId((PetscObject)(*mat), &id); CHKERRXX(ierr);
+      ierr = MatGetNonzeroState(*mat, &nzstate); CHKERRXX(ierr);
+      p_hashCombine(result, id);
+      p_hashCombine(result, nzstate);
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+    return result;
+#else
+    std::size_t result(p_patternHash(A, 0));
+    if (B != PETSC_NULL) {
+      result = p_patternHash(B, result);
+      PetscErrorCode ierr(0);
+      try {
+        PetscInt nbcols;
+        ierr = MatGetSize(B, PETSC_NULL, &nbcols); CHKERRXX(ierr);
+        for (PetscInt k = 0; k < nbcols; ++k) {
+          p_hashCombine(result, garray[k]);
+        }
+      } catch (const PETSC_EXCEPTION_TYPE& e) {
+        throw PETScException(ierr, e);
+      }
+    }
+    return result;
+#endif
+  }
+
+  /// Place values directly in local matrix storage (specialized)
+  void p_setSlotValues(const IdxType& n, const std::vector<IdxType>& slots,
+                       const TheType *x, const bool& add, const bool& zero)
+  {
+    Mat A, B;
+    const PetscInt *garray;
+    if (!p_localAIJ(A, B, garray)) {
+      throw Exception("PETScMatrixImplementation::setSlotValues: "
+                      "matrix storage cannot be accessed directly");
+    }
+    const int nslot(n*elementSize*elementSize);
+    if (slots.size() != nslot) {
+      throw Exception("PETScMatrixImplementation::setSlotValues: "
+                      "number of slots does not match number of values");
+    }
+    PetscErrorCode ierr(0);
+    try {
+      PetscInt nnza(p_storedValues(A)), nnzb(p_storedValues(B));
+      p_blockTmp.resize(nslot);
+      if (nslot > 0) {
+        MatrixValueTransferToLibrary<TheType, PetscScalar>
+          trans(n, const_cast<TheType *>(x), &p_blockTmp[0]);
+        trans.go();
+      }
+      PetscScalar *a, *b(PETSC_NULL);
+      ierr = MatSeqAIJGetArray(A, &a); CHKERRXX(ierr);
+      if (B != PETSC_NULL) {
+        ierr = MatSeqAIJGetArray(B, &b); CHKERRXX(ierr);
+      }
+      if (zero) {
+        std::fill(a, a + nnza, 0.0);
+        if (b != PETSC_NULL) std::fill(b, b + nnzb, 0.0);
+      }
+      for (int k = 0; k < nslot; ++k) {
+        PetscInt s(slots[k]);
+        PetscScalar *v;
+        if (s < nnza) {
+          v = a + s;
+        } else if (s - nnza < nnzb) {
+          v = b + (s - nnza);
+        } else {
+          continue;
+        }
+        if (add) {
+          *v += p_blockTmp[k];
+        } else {
+          *v = p_blockTmp[k];
+        }
+      }
+      ierr = MatSeqAIJRestoreArray(A, &a); CHKERRXX(ierr);
+      if (B != PETSC_NULL) {
+        ierr = MatSeqAIJRestoreArray(B, &b); CHKERRXX(ierr);
+      }
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+  }
+
   /// Get an individual element
   void p_getElement(const IdxType& i, const IdxType& j, TheType& x) const
   {
@@ -359,6 +359,177 @@ BOOST_AUTO_TEST_CASE ( VersteegMatrixInverse )
   
 }
 
+// -------------------------------------------------------------
+/// Test reuse of the symbolic factorization
+/**
+ * The Versteeg problem is solved, then the coefficient matrix and RHS
+ * are scaled, which changes values but not the nonzero pattern, and
+ * the problem is solved again. The solution should not change and
+ * only one symbolic factorization should be done.
+ * 
+ */
+// -------------------------------------------------------------
+BOOST_AUTO_TEST_CASE ( VersteegRefactor )
+{
+  gridpack::parallel::Communicator world;
+
+  static const int imax = 3*world.size();
+  static const int jmax = 4*world.size();
+  static const int global_size = imax*jmax;
+  int local_size(global_size/world.size());
+
+  boost::scoped_ptr<gridpack::math::RealMatrix> 
+    A(new gridpack::math::RealMatrix(world, local_size, local_size, 
+                                 gridpack::math::Sparse)),
+    I(new gridpack::math::RealMatrix(world, local_size, local_size, 
+                                 gridpack::math::Dense));
+  I->identity();
+
+  boost::scoped_ptr<gridpack::math::RealVector>
+    b(new gridpack::math::RealVector(world, local_size)),
+    x(new gridpack::math::RealVector(world, local_size));
+
+  assemble(imax, jmax, *A, *b);
+  A->ready();
+  b->ready();
+
+  boost::scoped_ptr<gridpack::math::RealLinearSolver> 
+    solver(new gridpack::math::RealLinearSolver(*A));
+
+  BOOST_REQUIRE(test_config);
+  solver->configure(test_config);
+  solver->numericRefactor();
+
+  x->fill(0.0);
+  x->ready();
+  solver->solve(*b, *x);
+  boost::scoped_ptr<gridpack::math::RealVector> x0(x->clone());
+
+  A->scale(2.0);
+  b->scale(2.0);
+  x->fill(0.0);
+  x->ready();
+  solver->solve(*b, *x);
+
+  x->add(*x0, -1.0);
+  double l2norm(x->norm2());
+  if (world.rank() == 0) {
+    std::cout << "Refactor Solution Difference L2 Norm = " << l2norm << std::endl;
+    std::cout << "Symbolic factorizations: " << solver->symbolicFactorizations()
+              << ", numeric factorizations: " << solver->numericFactorizations()
+              << std::endl;
+  }
+  BOOST_CHECK(l2norm < 1.0e-05);
+  BOOST_CHECK_EQUAL(solver->symbolicFactorizations(), 1);
+  BOOST_CHECK_EQUAL(solver->numericFactorizations(), 2);
+  BOOST_CHECK_EQUAL(solver->skippedSymbolicFactorizations(), 1);
+
+  // do the same with a LinearMatrixSolver
+  A->scale(0.5);
+  boost::scoped_ptr<gridpack::math::RealLinearMatrixSolver> 
+    msolver(new gridpack::math::RealLinearMatrixSolver(*A));
+  msolver->configurationKey("LinearMatrixSolver");
+  msolver->configure(test_config);
+
+  boost::scoped_ptr<gridpack::math::RealMatrix> Ainv0(msolver->solve(*I));
+  A->scale(2.0);
+  msolver->numericRefactor(*A);
+  boost::scoped_ptr<gridpack::math::RealMatrix> Ainv(msolver->solve(*I));
+  Ainv->scale(2.0);
+  Ainv0->scale(-1.0);
+  Ainv->add(*Ainv0);
+  l2norm = Ainv->norm2();
+  if (world.rank() == 0) {
+    std::cout << "Refactor Inverse Difference L2 Norm = " << l2norm << std::endl;
+  }
+  BOOST_CHECK(l2norm < 1.0e-05);
+  BOOST_CHECK_EQUAL(msolver->symbolicFactorizations(), 1);
+  BOOST_CHECK_EQUAL(msolver->skippedSymbolicFactorizations(), 1);
+}
+
+// -------------------------------------------------------------
+/// Test solution with several right hand sides at once
+/**
+ * The Versteeg problem is solved for several right hand sides, stored
+ * as columns of a dense Matrix, with a single call to solve() on both
+ * LinearSolver and LinearMatrixSolver.
+ * 
+ */
+// -------------------------------------------------------------
+BOOST_AUTO_TEST_CASE ( VersteegMultipleRHS )
+{
+  gridpack::parallel::Communicator world;
+
+  static const int imax = 3*world.size();
+  static const int jmax = 4*world.size();
+  static const int global_size = imax*jmax;
+  static const int local_cols = 2;
+  int local_size(global_size/world.size());
+
+  boost::scoped_ptr<gridpack::math::RealMatrix> 
+    A(new gridpack::math::RealMatrix(world, local_size, local_size, 
+                                 gridpack::math::Sparse)),
+    B(new gridpack::math::RealMatrix(world, local_size, local_cols, 
+                                 gridpack::math::Dense)),
+    X(new gridpack::math::RealMatrix(world, local_size, local_cols, 
+                                 gridpack::math::Dense));
+
+  boost::scoped_ptr<gridpack::math::RealVector>
+    b(new gridpack::math::RealVector(world, local_size));
+
+  assemble(imax, jmax, *A, *b);
+  A->ready();
+  b->ready();
+
+  // each column of B is a multiple of b
+  int lo, hi;
+  b->localIndexRange(lo, hi);
+  int ncols(B->cols());
+  for (int i = lo; i < hi; ++i) {
+    double v;
+    b->getElement(i, v);
+    for (int j = 0; j < ncols; ++j) {
+      B->setElement(i, j, v*static_cast<double>(j+1));
+    }
+  }
+  B->ready();
+
+  boost::scoped_ptr<gridpack::math::RealLinearSolver> 
+    solver(new gridpack::math::RealLinearSolver(*A));
+
+  BOOST_REQUIRE(test_config);
+  solver->configurationKey("LinearMatrixSolver");
+  solver->configure(test_config);
+  solver->solve(*B, *X);
+
+  boost::scoped_ptr<gridpack::math::RealMatrix> res(multiply(*A, *X));
+  res->scale(-1.0);
+  res->add(*B);
+  double l2norm(res->norm2());
+  if (world.rank() == 0) {
+    std::cout << "Multiple RHS Residual L2 Norm = " << l2norm << std::endl;
+  }
+  BOOST_CHECK(l2norm < 1.0e-05);
+
+  // do the same with a LinearMatrixSolver
+  boost::scoped_ptr<gridpack::math::RealLinearMatrixSolver> 
+    msolver(new gridpack::math::RealLinearMatrixSolver(*A));
+  msolver->configurationKey("LinearMatrixSolver");
+  msolver->configure(test_config);
+  X->zero();
+  msolver->solve(*B, *X);
+
+  res.reset(multiply(*A, *X));
+  res->scale(-1.0);
+  res->add(*B);
+  l2norm = res->norm2();
+  if (world.rank() == 0) {
+    std::cout << "Multiple RHS (LinearMatrixSolver) Residual L2 Norm = " 
+              << l2norm << std::endl;
+  }
+  BOOST_CHECK(l2norm < 1.0e-05);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
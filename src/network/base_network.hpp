@@ -18,6 +18,7 @@
 #ifndef _base_network_h_
 #define _base_network_h_
 
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <vector>
@@ -35,11 +36,15 @@
 #include "gridpack/partition/graph_partitioner.hpp"
 #include "gridpack/parallel/shuffler.hpp"
 #include "gridpack/parallel/ga_shuffler.hpp"
+#include "gridpack/parallel/ghost_exchange.hpp"
 #include "gridpack/timer/coarse_timer.hpp"
 #include "gridpack/utilities/exception.hpp"
 #include "gridpack/environment/environment.hpp"
 #include "gridpack/environment/no_print.hpp"
 
+// average weight of a bus when the network is rebalanced using measured times
+#define REBALANCE_UNITS 100
+
 namespace gridpack {
 namespace network {
 /** @cond */
@@ -309,6 +314,14 @@ explicit BaseNetwork(const parallel::Communicator& comm)
   p_external_branch = false;
   p_allocatedBus = false;
   p_allocatedBranch = false;
+  p_clearTopology();
+  p_neighborExchange = false;
+  p_costWeights = false;
+  p_rebalance = false;
+  p_stepTime = 0.0;
+  p_deltaExchange = false;
+  p_busUpdateCat = 0;
+  p_branchUpdateCat = 0;
   p_network_data.reset(new gridpack::component::DataCollection);
 
   gridpack::NoPrint *noprint = gridpack::NoPrint::instance();
@@ -400,10 +413,16 @@ virtual ~BaseNetwork(void)
  */
 void addBus(int idx)
 {
-  BusDataPtr bus(new BusData<BusType>());
-  bus->p_originalBusIndex = idx;
-  bus->p_globalBusIndex = -1;
-  p_buses.push_back(*bus);
+  p_buses.push_back(BusEntry());
+  p_busActive.push_back(1);
+  p_busOriginalIndex.push_back(idx);
+  p_busGlobalIndex.push_back(-1);
+  // The new bus has an empty neighbor list at the end of the neighbor
+  // array, so compressed storage remains compressed
+  int nsize = p_busNbrBranches.size();
+  p_busNbrOffsets.push_back(nsize);
+  p_busNbrCount.push_back(0);
+  p_busNbrCapacity.push_back(0);
 }
 
 /**
@@ -414,12 +433,15 @@ void addBus(int idx)
  */
 void addBranch(int idx1, int idx2)
 {
-  BranchDataPtr branch(new BranchData<_branch>());
-  branch->p_originalBusIndex1 = idx1;
-  branch->p_originalBusIndex2 = idx2;
-  branch->p_globalBusIndex1 = -1;
-  branch->p_globalBusIndex2 = -1;
-  p_branches.push_back(*branch);
+  p_branches.push_back(BranchEntry());
+  p_branchActive.push_back(1);
+  p_branchGlobalIndex.push_back(-1);
+  p_branchOriginalBus1.push_back(idx1);
+  p_branchOriginalBus2.push_back(idx2);
+  p_branchGlobalBus1.push_back(-1);
+  p_branchGlobalBus2.push_back(-1);
+  p_branchLocalBus1.push_back(-1);
+  p_branchLocalBus2.push_back(-1);
 }
 
 /**
@@ -441,7 +463,7 @@ int totalBuses(void)
   int i, total;
   total = 0;
   for (i=0; i<nBus; i++) {
-    if (p_buses[i].p_activeBus) total++;
+    if (p_busActive[i]) total++;
   }
   int grp = this->communicator().getGroup();
   char plus[2];
@@ -469,7 +491,7 @@ int totalBranches(void)
   int i, total;
   total = 0;
   for (i=0; i<nBranch; i++) {
-    if (p_branches[i].p_activeBranch) total++;
+    if (p_branchActive[i]) total++;
   }
   int grp = this->communicator().getGroup();
   char plus[2];
@@ -520,7 +542,7 @@ bool setOriginalBusIndex(int idx, int o_idx)
   if (idx < 0 || idx >= p_buses.size()) {
     return false;
   } else {
-    p_buses[idx].p_originalBusIndex = o_idx;
+    p_busOriginalIndex[idx] = o_idx;
     return true;
   }
 }
@@ -536,7 +558,7 @@ bool setGlobalBusIndex(int idx, int g_idx)
   if (idx < 0 || idx >= p_buses.size()) {
     return false;
   } else {
-    p_buses[idx].p_globalBusIndex = g_idx;
+    p_busGlobalIndex[idx] = g_idx;
     return true;
   }
 }
@@ -552,7 +574,7 @@ bool setGlobalBranchIndex(int idx, int g_idx)
   if (idx < 0 || idx >= p_branches.size()) {
     return false;
   } else {
-    p_branches[idx].p_globalBranchIndex = g_idx;
+    p_branchGlobalIndex[idx] = g_idx;
     return true;
   }
 }
@@ -568,7 +590,7 @@ bool setOriginalBusIndex1(int idx, int b_idx)
   if (idx < 0 || idx >= p_branches.size()) {
     return false;
   } else {
-    p_branches[idx].p_originalBusIndex1 = b_idx;
+    p_branchOriginalBus1[idx] = b_idx;
     return true;
   }
 }
@@ -584,7 +606,7 @@ bool setOriginalBusIndex2(int idx, int b_idx)
   if (idx < 0 || idx >= p_branches.size()) {
     return false;
   } else {
-    p_branches[idx].p_originalBusIndex2 = b_idx;
+    p_branchOriginalBus2[idx] = b_idx;
     return true;
   }
 }
@@ -600,7 +622,7 @@ bool setGlobalBusIndex1(int idx, int b_idx)
   if (idx < 0 || idx >= p_branches.size()) {
     return false;
   } else {
-    p_branches[idx].p_globalBusIndex1 = b_idx;
+    p_branchGlobalBus1[idx] = b_idx;
     return true;
   }
 }
@@ -616,7 +638,7 @@ bool setGlobalBusIndex2(int idx, int b_idx)
   if (idx < 0 || idx >= p_branches.size()) {
     return false;
   } else {
-    p_branches[idx].p_globalBusIndex2 = b_idx;
+    p_branchGlobalBus2[idx] = b_idx;
     return true;
   }
 }
@@ -632,7 +654,7 @@ bool setLocalBusIndex1(int idx, int b_idx)
   if (idx < 0 || idx >= p_branches.size()) {
     return false;
   } else {
-    p_branches[idx].p_localBusIndex1 = b_idx;
+    p_branchLocalBus1[idx] = b_idx;
     return true;
   }
 }
@@ -648,7 +670,7 @@ bool setLocalBusIndex2(int idx, int b_idx)
   if (idx < 0 || idx >= p_branches.size()) {
     return false;
   } else {
-    p_branches[idx].p_localBusIndex2 = b_idx;
+    p_branchLocalBus2[idx] = b_idx;
     return true;
   }
 }
@@ -664,7 +686,7 @@ bool setActiveBus(int idx, bool flag)
   if (idx < 0 || idx >= p_buses.size()) {
     return false;
   } else {
-    p_buses[idx].p_activeBus = flag;
+    p_busActive[idx] = flag;
     return true;
   }
 }
@@ -680,7 +702,7 @@ bool setActiveBranch(int idx, bool flag)
   if (idx < 0 || idx >= p_branches.size()) {
     return false;
   } else {
-    p_branches[idx].p_activeBranch = flag;
+    p_branchActive[idx] = flag;
     return true;
   }
 }
@@ -695,7 +717,8 @@ bool clearBranchNeighbors(int idx)
   if (idx < 0 || idx >= p_buses.size()) {
     return false;
   } else {
-    p_buses[idx].p_branchNeighbors.clear();
+    if (p_busNbrCount[idx] > 0) p_busNbrCSR = false;
+    p_busNbrCount[idx] = 0;
     return true;
   }
 }
@@ -711,7 +734,7 @@ bool addBranchNeighbor(int idx, int br_idx)
   if (idx < 0 || idx >= p_buses.size()) {
     return false;
   } else {
-    p_buses[idx].p_branchNeighbors.push_back(br_idx);
+    p_addNeighbor(idx, br_idx);
     return true;
   }
 }
@@ -726,7 +749,7 @@ bool addBranchNeighbor(int idx, int br_idx)
 bool getActiveBus(int idx)
 {
   if (idx >= 0 && idx < p_buses.size()) {
-    return p_buses[idx].p_activeBus;
+    return p_busActive[idx];
   } else {
     char buf[256];
     sprintf(buf,"BaseNetwork::getActiveBus: illegal index: %d size: %d\n",
@@ -747,7 +770,7 @@ bool getActiveBus(int idx)
 int getOriginalBusIndex(int idx)
 {
   if (idx >= 0 && idx < p_buses.size()) {
-    return p_buses[idx].p_originalBusIndex;
+    return p_busOriginalIndex[idx];
   } else {
     char buf[256];
     sprintf(buf,"BaseNetwork::getOriginalBusIndex: illegal index: %d size: %d\n",
@@ -768,7 +791,7 @@ int getOriginalBusIndex(int idx)
 int getGlobalBusIndex(int idx)
 {
   if (idx >= 0 && idx < p_buses.size()) {
-    return p_buses[idx].p_globalBusIndex;
+    return p_busGlobalIndex[idx];
   } else {
     char buf[256];
     sprintf(buf,"BaseNetwork::getGlobalBusIndex: illegal index: %d size: %d\n",
@@ -811,7 +834,7 @@ BusPtr getBus(int idx)
 bool getActiveBranch(int idx)
 {
   if (idx >= 0 && idx < p_branches.size()) {
-    return p_branches[idx].p_activeBranch;
+    return p_branchActive[idx];
   } else {
     char buf[256];
     sprintf(buf,"BaseNetwork::getActiveBranch: illegal index: %d size: %d\n",
@@ -832,7 +855,7 @@ bool getActiveBranch(int idx)
 int getGlobalBranchIndex(int idx)
 {
   if (idx >= 0 && idx < p_branches.size()) {
-    return p_branches[idx].p_globalBranchIndex;
+    return p_branchGlobalIndex[idx];
   } else {
     char buf[256];
     sprintf(buf,"BaseNetwork::getGlobalBranchIndex: illegal index: %d size: %d\n",
@@ -876,8 +899,8 @@ BranchPtr getBranch(int idx)
 void getOriginalBranchEndpoints(int idx, int *idx1, int *idx2)
 {
   if (idx >= 0 && idx < p_branches.size()) {
-    *idx1 = p_branches[idx].p_originalBusIndex1;
-    *idx2 = p_branches[idx].p_originalBusIndex2;
+    *idx1 = p_branchOriginalBus1[idx];
+    *idx2 = p_branchOriginalBus2[idx];
   } else {
     char buf[256];
     sprintf(buf,"BaseNetwork::getGlobalBranchIndex: illegal index: %d size: %d\n",
@@ -951,12 +974,37 @@ std::vector<int> getConnectedBranches(int idx) const
     }
     throw gridpack::Exception(buf);
   } else {
-    return p_buses[idx].p_branchNeighbors;
+    const int *first = p_busNbrBranches.empty() ? NULL
+      : &p_busNbrBranches[0] + p_busNbrOffsets[idx];
+    return std::vector<int>(first, first + p_busNbrCount[idx]);
   }
   std::vector<int> null;
   return null;
 }
 
+/**
+ * Return list of branches connected to bus without copying it
+ * @param idx local bus index
+ * @param branches pointer to local indices of connected branches. The
+ *        pointer is invalidated if the neighbor list is modified
+ * @return number of connected branches
+ */
+int getConnectedBranches(int idx, const int **branches) const
+{
+  if (idx<0 || idx >= p_buses.size()) {
+    char buf[256];
+    sprintf(buf,"BaseNetwork::getConnectedBranches: illegal index: %d size: %d\n",
+           idx, static_cast<int>(p_buses.size()));
+    if (!p_no_print) {
+      printf("%s",buf);
+    }
+    throw gridpack::Exception(buf);
+  }
+  int nsize = p_busNbrCount[idx];
+  *branches = nsize == 0 ? NULL : &p_busNbrBranches[p_busNbrOffsets[idx]];
+  return nsize;
+}
+
 /**
  * Return list of buses connected to central bus via one branch
  * @param idx local bus index
@@ -973,16 +1021,18 @@ std::vector<int> getConnectedBuses(int idx) const
     }
     throw gridpack::Exception(buf);
   } else {
-    std::vector<int> branches = p_buses[idx].p_branchNeighbors;
-    int size = branches.size();
+    int nsize = p_busNbrCount[idx];
+    const int *nghbrs = nsize == 0 ? NULL
+      : &p_busNbrBranches[p_busNbrOffsets[idx]];
     std::vector<int> ret;
+    ret.reserve(nsize);
     int i, j;
-    for (i=0; i<size; i++) {
-      j = branches[i];
-      if (p_branches[j].p_localBusIndex1 != idx) {
-        ret.push_back(p_branches[j].p_localBusIndex1);
+    for (i=0; i<nsize; i++) {
+      j = nghbrs[i];
+      if (p_branchLocalBus1[j] != idx) {
+        ret.push_back(p_branchLocalBus1[j]);
       } else {
-        ret.push_back(p_branches[j].p_localBusIndex2);
+        ret.push_back(p_branchLocalBus2[j]);
       }
     }
     return ret;
@@ -1010,8 +1060,114 @@ void getBranchEndpoints(int idx, int *bus1, int *bus2) const
     }
     throw gridpack::Exception(buf);
   } else {
-    *bus1 = p_branches[idx].p_localBusIndex1;
-    *bus2 = p_branches[idx].p_localBusIndex2;
+    *bus1 = p_branchLocalBus1[idx];
+    *bus2 = p_branchLocalBus2[idx];
+  }
+}
+
+// Raw array accessors. These provide direct access to the contiguous arrays
+// that hold bus and branch indices so that loops over the network can be
+// vectorized. The pointers are invalidated if buses or branches are added or
+// removed from the network and may be NULL if there are no buses or branches
+// on this processor.
+
+/**
+ * Return array of active flags for all local buses
+ * @return pointer to array of length numBuses(). Entries are nonzero for
+ * active buses
+ */
+const char* getActiveBusArray(void) const
+{
+  if (p_busActive.size() == 0) return NULL;
+  return &p_busActive[0];
+}
+
+/**
+ * Return array of global indices for all local buses
+ * @return pointer to array of length numBuses()
+ */
+const int* getGlobalBusIndexArray(void) const
+{
+  if (p_busGlobalIndex.size() == 0) return NULL;
+  return &p_busGlobalIndex[0];
+}
+
+/**
+ * Return array of original indices for all local buses
+ * @return pointer to array of length numBuses()
+ */
+const int* getOriginalBusIndexArray(void) const
+{
+  if (p_busOriginalIndex.size() == 0) return NULL;
+  return &p_busOriginalIndex[0];
+}
+
+/**
+ * Return branches connected to all local buses in compressed sparse row
+ * form. The branches connected to bus i are branches[offsets[i]] through
+ * branches[offsets[i+1]-1]. The neighbor storage is compressed by
+ * partition, clean and setMap, so this function cannot be called after
+ * neighbor lists have been modified until one of these has been called
+ * again
+ * @param offsets pointer to array of length numBuses()+1
+ * @param branches pointer to array of local branch indices
+ */
+void getBusNeighborArrays(const int **offsets, const int **branches) const
+{
+  if (!p_busNbrCSR) {
+    char buf[256];
+    sprintf(buf,"BaseNetwork::getBusNeighborArrays: neighbor lists modified"
+        " since last call to setMap\n");
+    if (!p_no_print) {
+      printf("%s",buf);
+    }
+    throw gridpack::Exception(buf);
+  }
+  *offsets = &p_busNbrOffsets[0];
+  if (p_busNbrBranches.size() > 0) {
+    *branches = &p_busNbrBranches[0];
+  } else {
+    *branches = NULL;
+  }
+}
+
+/**
+ * Return array of active flags for all local branches
+ * @return pointer to array of length numBranches(). Entries are nonzero for
+ * active branches
+ */
+const char* getActiveBranchArray(void) const
+{
+  if (p_branchActive.size() == 0) return NULL;
+  return &p_branchActive[0];
+}
+
+/**
+ * Return array of global indices for all local branches
+ * @return pointer to array of length numBranches()
+ */
+const int* getGlobalBranchIndexArray(void) const
+{
+  if (p_branchGlobalIndex.size() == 0) return NULL;
+  return &p_branchGlobalIndex[0];
+}
+
+/**
+ * Return arrays of local indices of buses at either end of all local
+ * branches
+ * @param bus1 pointer to array of length numBranches() containing local
+ * indices of "from" buses
+ * @param bus2 pointer to array of length numBranches() containing local
+ * indices of "to" buses
+ */
+void getBranchEndpointArrays(const int **bus1, const int **bus2) const
+{
+  if (p_branchLocalBus1.size() == 0) {
+    *bus1 = NULL;
+    *bus2 = NULL;
+  } else {
+    *bus1 = &p_branchLocalBus1[0];
+    *bus2 = &p_branchLocalBus2[0];
   }
 }
 
@@ -1020,6 +1176,30 @@ void assemble(void)
 {
 }
 
+/**
+ * Use estimates of the computational cost of buses and branches as weights
+ * when partitioning the network. Each bus gets two weights, the number of
+ * matrix rows and the amount of work done by the bus and its branches in
+ * each step (see BaseBusComponent::estimateCost and
+ * BaseBranchComponent::estimateCost), and both are balanced over
+ * processors. The load on each processor is reported after partitioning.
+ * If this is not set, only the number of buses is balanced
+ * @param flag if true, use cost estimates as weights
+ */
+void useCostWeights(bool flag)
+{
+  p_costWeights = flag;
+}
+
+/**
+ * Report whether cost estimates are used as weights when partitioning
+ * @return true if cost estimates are used
+ */
+bool getCostWeights(void) const
+{
+  return p_costWeights;
+}
+
 /**
  * Partition the network over the available processes
  */
@@ -1046,25 +1226,62 @@ void partition(void)
   GraphPartitioner partitioner(this->communicator(),
       p_buses.size(), p_branches.size());
 
-  for (BusIterator bus = p_buses.begin(); 
-      bus != p_buses.end(); ++bus) {
-    partitioner.add_node(bus->p_globalBusIndex,bus->p_originalBusIndex);
+  int i;
+  int nbus = p_buses.size();
+  int nbranch = p_branches.size();
+  if (p_rebalance) {
+    std::vector<int> bus_work, branch_work;
+    p_measuredWork(bus_work, branch_work);
+    std::vector<int> weights(1);
+    for (i=0; i<nbus; i++) {
+      weights[0] = bus_work[i];
+      partitioner.add_node(p_busGlobalIndex[i],p_busOriginalIndex[i],
+          weights);
+    }
+    for (i=0; i<nbranch; i++) {
+      weights[0] = branch_work[i];
+      partitioner.add_edge(p_branchGlobalIndex[i],
+          p_branchOriginalBus1[i],
+          p_branchOriginalBus2[i], weights);
+    }
+  } else if (p_costWeights) {
+    std::vector<int> weights(2);
+    for (i=0; i<nbus; i++) {
+      p_buses[i].p_bus->estimateCost(p_buses[i].p_data, &weights[0],
+          &weights[1]);
+      partitioner.add_node(p_busGlobalIndex[i],p_busOriginalIndex[i],
+          weights);
+    }
+    for (i=0; i<nbranch; i++) {
+      p_branches[i].p_branch->estimateCost(p_branches[i].p_data,
+          &weights[0], &weights[1]);
+      partitioner.add_edge(p_branchGlobalIndex[i],
+          p_branchOriginalBus1[i],
+          p_branchOriginalBus2[i], weights);
+    }
+  } else {
+    for (i=0; i<nbus; i++) {
+      partitioner.add_node(p_busGlobalIndex[i],p_busOriginalIndex[i]);
+    }
+    for (i=0; i<nbranch; i++) {
+      partitioner.add_edge(p_branchGlobalIndex[i],
+          p_branchOriginalBus1[i],
+          p_branchOriginalBus2[i]);
+    }
   }
-  for (BranchIterator branch = p_branches.begin(); 
-      branch != p_branches.end(); ++branch) {
-    partitioner.add_edge(branch->p_globalBranchIndex, 
-        branch->p_originalBusIndex1,
-        branch->p_originalBusIndex2);
+  if (p_rebalance) {
+    partitioner.repartition();
+  } else {
+    partitioner.partition();
   }
-  partitioner.partition();
+  if (p_costWeights || p_rebalance) p_printLoads(partitioner);
   // Recover global indices for branch ends from partitioner
-  int nbranch = p_branches.size();
   int idx;
   unsigned int index1, index2;
   for (idx=0; idx<nbranch; idx++) {
     partitioner.get_global_edge_ids(idx, &index1, &index2);
-    p_branches[idx].p_globalBusIndex1 = static_cast<int>(index1);
-    p_branches[idx].p_globalBusIndex2 = static_cast<int>(index2);
+    p_branchGlobalBus1[idx] = static_cast<int>(index1);
+    p_branchGlobalBus2[idx] = static_cast<int>(index2);
   }
 
   if (timer != NULL) timer->stop(t_part);
@@ -1083,6 +1300,13 @@ void partition(void)
   BusShufflerType bus_shuffler(this->communicator());
   BranchShufflerType branch_shuffler(this->communicator());
 
+  // Buses and branches are moved between processors as BusData and
+  // BranchData records. These are only used for the move and are converted
+  // back to the local arrays once they have arrived
+  BusDataVector buses;
+  BranchDataVector branches;
+  p_exportTopology(buses, branches);
+
   // Need to make copies of buses and branches that will be ghosted.
   // After active bus/branch distribution, they may not be on this
   // processor.
@@ -1090,7 +1314,7 @@ void partition(void)
   BusDataVector ghostbuses;
   GraphPartitioner::MultiIndexVector gnodedest;
   GraphPartitioner::IndexVector ghostbusdest;
-  BusIterator bus(p_buses.begin());
+  BusIterator bus(buses.begin());
   partitioner.ghost_node_destinations(gnodedest);
 
   for (size_t i = 0; i < gnodedest.size(); ++i, ++bus) {
@@ -1108,7 +1332,7 @@ void partition(void)
   partitioner.ghost_edge_destinations(gdest);
 
   BranchDataVector ghostbranches;
-  BranchIterator branch(p_branches.begin());
+  BranchIterator branch(branches.begin());
   GraphPartitioner::IndexVector ghostbranchdest;
 
   for (size_t i = 0; i < dest.size(); ++i, ++branch) {
@@ -1126,14 +1350,14 @@ void partition(void)
 
   if (timer != NULL) timer->start(t_bus_dist);
   partitioner.node_destinations(dest);
-  bus_shuffler(p_buses, dest);
+  bus_shuffler(buses, dest);
   if (timer != NULL) timer->stop(t_bus_dist);
 
   // distribute active edges
 
   if (timer != NULL) timer->start(t_branch_dist);
   partitioner.edge_destinations(dest);
-  branch_shuffler(p_branches, dest);
+  branch_shuffler(branches, dest);
   if (timer != NULL) timer->stop(t_branch_dist);
 
   // At this point, active buses and branches are on the proper
@@ -1146,7 +1370,7 @@ void partition(void)
   bus_shuffler(ghostbuses, ghostbusdest);
   for (bus = ghostbuses.begin(); bus != ghostbuses.end(); ++bus) {
     bus->p_activeBus = false;
-    p_buses.push_back(*bus);
+    buses.push_back(*bus);
   }
   ghostbuses.clear();
   if (timer != NULL) timer->stop(t_bus_dist);
@@ -1154,62 +1378,65 @@ void partition(void)
   if (timer != NULL) timer->start(t_branch_dist);
   branch_shuffler(ghostbranches, ghostbranchdest);
   std::copy(ghostbranches.begin(), ghostbranches.end(),
-      std::back_inserter(p_branches));
+      std::back_inserter(branches));
   ghostbranches.clear();
   if (timer != NULL) timer->stop(t_branch_dist);
 
   // At this point, each process should have a self-contained
   // network, update local and global indexes, etc.
+  p_importTopology(buses, branches);
 
   // make an index of global bus index to local index and update
   // the branch local bus indexes
   int active_buses(0), active_branches(0);
   {
     std::map<int, int> busindexes;
-    int lidx(0);
-    for (BusIterator b = p_buses.begin(); b != p_buses.end(); ++b, ++lidx) {
+    int lidx;
+    nbus = p_buses.size();
+    for (lidx=0; lidx<nbus; lidx++) {
       clearBranchNeighbors(lidx);
-      busindexes[b->p_globalBusIndex] = lidx;
-      if (b->p_activeBus) active_buses += 1;
+      // components that stayed on this process still point to their old
+      // neighbors if the network is being repartitioned
+      p_buses[lidx].p_bus->clearBranches();
+      p_buses[lidx].p_bus->clearBuses();
+      busindexes[p_busGlobalIndex[lidx]] = lidx;
+      if (p_busActive[lidx]) active_buses += 1;
     }
 
     // go through the branches and set the local bus indexes and pointers
-    lidx = 0;
-    for (BranchIterator b = p_branches.begin(); b != p_branches.end(); ++b, ++lidx) {
-      int gbus, lbus1, lbus2;
+    nbranch = p_branches.size();
+    for (lidx=0; lidx<nbranch; lidx++) {
+      int gbus1, gbus2, lbus1, lbus2;
       BusPtr bus1, bus2;
+      BranchPtr b = p_branches[lidx].p_branch;
 
       // set local indexes
 
-      gbus = b->p_globalBusIndex1;
-      lbus1 = busindexes[gbus];
+      gbus1 = p_branchGlobalBus1[lidx];
+      lbus1 = busindexes[gbus1];
       bus1 = p_buses[lbus1].p_bus;
 
-      gbus = b->p_globalBusIndex2;
-      lbus2 = busindexes[gbus];
+      gbus2 = p_branchGlobalBus2[lidx];
+      lbus2 = busindexes[gbus2];
       bus2 = p_buses[lbus2].p_bus;
 
-      b->p_localBusIndex1 = lbus1;
+      setLocalBusIndex1(lidx, lbus1);
       addBranchNeighbor(lbus1, lidx);
 
-      b->p_localBusIndex2 = lbus2;
+      setLocalBusIndex2(lidx, lbus2);
       addBranchNeighbor(lbus2, lidx);
 
       // set component pointers
 
-      b->p_branch->setBus1(bus1);
-      b->p_branch->setBus2(bus2);
+      b->setBus1(bus1);
+      b->setBus2(bus2);
 
-      gbus = b->p_globalBusIndex1;
-      bus1->addBranch(b->p_branch);
+      bus1->addBranch(b);
       bus1->addBus(bus2);
-      setGlobalBusIndex1(lidx,gbus); 
-      gbus = b->p_globalBusIndex2;
-      bus2->addBranch(b->p_branch);
+      bus2->addBranch(b);
       bus2->addBus(bus1);
-      setGlobalBusIndex2(lidx,gbus); 
 
-      if (b->p_activeBranch) active_branches += 1;
+      if (p_branchActive[lidx]) active_branches += 1;
     }
   }
   setMap();
@@ -1227,6 +1454,62 @@ void partition(void)
 
 
 
+/**
+ * Repartition the network if the time spent on each process is not
+ * balanced. The time measured on each process is divided between its
+ * buses and branches in proportion to their estimated work (see
+ * BaseBusComponent::estimateCost and BaseBranchComponent::estimateCost)
+ * and the network is repartitioned using the current distribution as
+ * the starting point, so only enough buses and branches are moved to
+ * balance the time. Buses and branches move with their data collection
+ * objects and any component state that is included in the component
+ * serialize methods. Ghost buses and branches are rebuilt, but exchange
+ * buffers are removed (see clean), so these must be set up again.
+ * Mappers, vectors and matrices created from the old distribution must
+ * also be recreated. BaseFactory::rebalance takes care of the factory and
+ * exchange buffers. This is a collective operation
+ * @param time time spent on this process in the part of the calculation
+ *        that should be balanced, for example since the last call to
+ *        rebalance
+ * @param tolerance repartition only if the ratio of the maximum to the
+ *        average time is larger than this value
+ * @return true if the network was repartitioned
+ */
+bool rebalance(double time, double tolerance = 1.1)
+{
+  int nprocs = this->processor_size();
+  if (nprocs < 2) return false;
+  double tmax, tsum;
+  MPI_Comm comm = static_cast<MPI_Comm>(this->communicator());
+  MPI_Allreduce(&time,&tmax,1,MPI_DOUBLE,MPI_MAX,comm);
+  MPI_Allreduce(&time,&tsum,1,MPI_DOUBLE,MPI_SUM,comm);
+  if (tsum <= 0.0) return false;
+  double imbalance = tmax*static_cast<double>(nprocs)/tsum;
+  if (this->processor_rank() == 0 && !p_no_print) {
+    printf("\nTime imbalance (maximum/average): %8.4f tolerance: %8.4f\n",
+        imbalance,tolerance);
+  }
+  if (imbalance <= tolerance) return false;
+
+  clean();
+  p_rebalance = true;
+  p_stepTime = time;
+  partition();
+  p_rebalance = false;
+  p_stepTime = 0.0;
+
+  // Reference bus may have moved
+  p_refBus = -1;
+  int i;
+  int nbus = p_buses.size();
+  for (i=0; i<nbus; i++) {
+    if (p_buses[i].p_refFlag && (p_refBus == -1 || p_busActive[i])) {
+      p_refBus = i;
+    }
+  }
+  return true;
+}
+
 /**
  * Clean all ghost buses and branches from the system. This can be used
  * before repartitioning the network. This operation also removes all exchange
@@ -1241,6 +1524,8 @@ void clean(void)
   // remove all exchange buffers
   freeXCBus();
   freeXCBranch();
+  p_busExchange.reset();
+  p_branchExchange.reset();
   if (p_activeBusIndices) {
     for (i=0; i<p_numActiveBuses; ++i) {
       delete p_activeBusIndices[i];
@@ -1290,64 +1575,80 @@ void clean(void)
   int size = p_branches.size();
   int new_id = 0;
   for (i=0; i<size; i++) {
-    if (p_branches[i].p_activeBranch) {
+    if (p_branchActive[i]) {
       p_branches[new_id] = p_branches[i];
+      p_branchGlobalIndex[new_id] = p_branchGlobalIndex[i];
+      p_branchOriginalBus1[new_id] = p_branchOriginalBus1[i];
+      p_branchOriginalBus2[new_id] = p_branchOriginalBus2[i];
+      p_branchGlobalBus1[new_id] = p_branchGlobalBus1[i];
+      p_branchGlobalBus2[new_id] = p_branchGlobalBus2[i];
+      p_branchLocalBus1[new_id] = p_branchLocalBus1[i];
+      p_branchLocalBus2[new_id] = p_branchLocalBus2[i];
       branches.insert(std::pair<int, int>(i,new_id));
       new_id++;
     }
   }
   // clean up the ends of the branch vectors
-  size = size - new_id;
-  for (i=0; i<size; i++) {
-    p_branches.pop_back();
-  }
-
-  // remove inactive buses
+  p_branches.erase(p_branches.begin()+new_id, p_branches.end());
+  p_branchActive.assign(new_id, 1);
+  p_branchGlobalIndex.resize(new_id);
+  p_branchOriginalBus1.resize(new_id);
+  p_branchOriginalBus2.resize(new_id);
+  p_branchGlobalBus1.resize(new_id);
+  p_branchGlobalBus2.resize(new_id);
+  p_branchLocalBus1.resize(new_id);
+  p_branchLocalBus2.resize(new_id);
+
+  // remove inactive buses and rebuild the neighbor lists in compressed
+  // form without the branches that have been removed
+  std::vector<int> nbrOffsets(1,0);
+  std::vector<int> nbrBranches;
+  nbrBranches.reserve(p_busNbrBranches.size());
+  int jsize, offset;
   size = p_buses.size();
   new_id = 0;
   for (i=0; i<size; i++) {
-    if (p_buses[i].p_activeBus) {
+    if (p_busActive[i]) {
       p_buses[new_id] = p_buses[i];
+      p_busOriginalIndex[new_id] = p_busOriginalIndex[i];
+      p_busGlobalIndex[new_id] = p_busGlobalIndex[i];
+      offset = p_busNbrOffsets[i];
+      jsize = p_busNbrCount[i];
+      for (j=0; j<jsize; j++) {
+        p = branches.find(p_busNbrBranches[offset+j]);
+        if (p != branches.end()) {
+          nbrBranches.push_back(p->second);
+        }
+      }
+      nbrOffsets.push_back(nbrBranches.size());
       buses.insert(std::pair<int, int>(i,new_id));
       new_id++;
     }
   }
   // clean up the ends of the bus vectors
-  size = size - new_id;
-  for (i=0; i<size; i++) {
-    p_buses.pop_back();
-  }
+  p_buses.erase(p_buses.begin()+new_id, p_buses.end());
+  p_busActive.assign(new_id, 1);
+  p_busOriginalIndex.resize(new_id);
+  p_busGlobalIndex.resize(new_id);
+  p_setNeighborArrays(nbrOffsets, nbrBranches);
 
   // reset all local indices
   size = p_branches.size();
   for (i=0; i<size; i++) {
-    p = buses.find(p_branches[i].p_localBusIndex1);
+    p = buses.find(p_branchLocalBus1[i]);
     if (p != buses.end()) {
-      p_branches[i].p_localBusIndex1 = p->second;
+      p_branchLocalBus1[i] = p->second;
     } else {
-      p_branches[i].p_localBusIndex1 = -1;
+      p_branchLocalBus1[i] = -1;
     }
-    p = buses.find(p_branches[i].p_localBusIndex2);
+    p = buses.find(p_branchLocalBus2[i]);
     if (p != buses.end()) {
-      p_branches[i].p_localBusIndex2 = p->second;
+      p_branchLocalBus2[i] = p->second;
     } else {
-      p_branches[i].p_localBusIndex2 = -1;
+      p_branchLocalBus2[i] = -1;
     }
   }
 
-  int jsize;
-  size = p_buses.size();
-  for (i=0; i<size; i++) {
-    std::vector<int> neighbors = p_buses[i].p_branchNeighbors;
-    jsize = neighbors.size();
-    p_buses[i].p_branchNeighbors.clear();
-    for (j=0; j<jsize; j++) {
-      p = branches.find(neighbors[j]);
-      if (p != branches.end()) {
-        p_buses[i].p_branchNeighbors.push_back(p->second);
-      }
-    }
-  }
   if (p_refBus != -1) {
     p_refBus = buses[p_refBus];
   }
@@ -1378,9 +1679,8 @@ template <class _new_bus, class _new_branch> void clone(
     *(new_network->getBusData(i)) = *(getBusData(i));
     new_network->setActiveBus(i,getActiveBus(i));
     // set neighbor indices
-    std::vector<int> nghbrs;
-    nghbrs = getConnectedBranches(i);
-    nsize = nghbrs.size();
+    const int *nghbrs;
+    nsize = getConnectedBranches(i,&nghbrs);
     for (j=0; j<nsize; j++) {
       new_network->addBranchNeighbor(i,nghbrs[j]);
     }
@@ -1651,9 +1951,12 @@ void clear(void)
     GA_Destroy(p_busGA);
     NGA_Deregister_type(p_busXCBufType);
   }
+  p_busExchange.reset();
+  p_branchExchange.reset();
   // Get rid of all buses and branches
   p_buses.clear();
   p_branches.clear();
+  p_clearTopology();
 
   //reset all internal parameters to their initial state
   p_refBus = -1;
@@ -1718,7 +2021,9 @@ void allocXCBus(int size)
     p_busXCBufSize = size;
     p_allocatedBus = true;
     p_external_bus = false;
+    p_busXCChanged.assign(nsize, 1);
   }
+  p_setXCBusChangedFlags();
 }
 
 /**
@@ -1741,7 +2046,9 @@ void freeXCBus(void)
     delete [] p_busXCBuffers;
     p_external_bus = false;
     p_busXCBufSize = 0;
+    p_busXCChanged.clear();
   }
+  p_setXCBusChangedFlags();
 }
 
 /**
@@ -1769,8 +2076,10 @@ void allocXCBusPointers(int size)
   if (size > 0) {
     p_busXCBuffers = new void*[nsize];
     p_busXCBufSize = size;
+    p_busXCChanged.assign(nsize, 1);
   }
   p_external_bus = true;
+  p_setXCBusChangedFlags();
 }
 
 /**
@@ -1818,6 +2127,39 @@ void* getXCBusBuffer(int idx)
   return NULL;
 }
 
+/**
+ * Mark exchange buffer for bus as changed so that it is included in the
+ * next update if only changed buffers are exchanged
+ * @param idx local index of bus
+ */
+void setXCBusBufferChanged(int idx)
+{
+  if (idx < 0 || idx >= p_busXCChanged.size()) {
+    char buf[256];
+    sprintf(buf,"BaseNetwork::setXCBusBufferChanged: illegal index: %d size: %ld\n",
+            idx, p_busXCChanged.size());
+    if (!p_no_print) {
+      printf("%s",buf);
+    }
+    throw gridpack::Exception(buf);
+  }
+  p_busXCChanged[idx] = 1;
+}
+
+/**
+ * Return a pointer to the flag that marks the exchange buffer for a bus as
+ * changed
+ * @param idx local index of bus
+ * @return pointer to flag (NULL if exchange buffers are not allocated)
+ */
+char* getXCBusChangedFlag(int idx)
+{
+  if (idx < 0 || idx >= p_busXCChanged.size()) {
+    return NULL;
+  }
+  return &p_busXCChanged[idx];
+}
+
 /**
  * Allocate buffers for exchanging data for ghost branches
  * @param size size (in bytes) of buffer
@@ -1857,7 +2199,9 @@ void allocXCBranch(int size)
     }
     p_allocatedBranch = true;
     p_branchXCBufSize = size;
+    p_branchXCChanged.assign(nsize, 1);
   }
+  p_setXCBranchChangedFlags();
 }
 
 /**
@@ -1880,7 +2224,9 @@ void freeXCBranch(void)
     delete [] p_branchXCBuffers;
     p_branchXCBufSize = 0;
     p_external_branch = false;
+    p_branchXCChanged.clear();
   }
+  p_setXCBranchChangedFlags();
 }
 
 /**
@@ -1904,6 +2250,39 @@ void* getXCBranchBuffer(int idx)
   return NULL;
 }
 
+/**
+ * Mark exchange buffer for branch as changed so that it is included in the
+ * next update if only changed buffers are exchanged
+ * @param idx local index of branch
+ */
+void setXCBranchBufferChanged(int idx)
+{
+  if (idx < 0 || idx >= p_branchXCChanged.size()) {
+    char buf[256];
+    sprintf(buf,"BaseNetwork::setXCBranchBufferChanged: illegal index: %d size: %ld\n",
+            idx, p_branchXCChanged.size());
+    if (!p_no_print) {
+      printf("%s",buf);
+    }
+    throw gridpack::Exception(buf);
+  }
+  p_branchXCChanged[idx] = 1;
+}
+
+/**
+ * Return a pointer to the flag that marks the exchange buffer for a branch
+ * as changed
+ * @param idx local index of branch
+ * @return pointer to flag (NULL if exchange buffers are not allocated)
+ */
+char* getXCBranchChangedFlag(int idx)
+{
+  if (idx < 0 || idx >= p_branchXCChanged.size()) {
+    return NULL;
+  }
+  return &p_branchXCChanged[idx];
+}
+
 /**
  * Allocate array of pointers to buffers for exchanging data for ghost branchs
  * @param size size of buffers that will be assigned to pointers
@@ -1929,8 +2308,10 @@ void allocXCBranchPointers(int size)
   if (size > 0) {
     p_branchXCBuffers = new void*[nsize];
     p_branchXCBufSize = size;
+    p_branchXCChanged.assign(nsize, 1);
   }
   p_external_branch = true;
+  p_setXCBranchChangedFlags();
 }
 
 /**
@@ -1957,6 +2338,55 @@ void setXCBranchBuffer(int idx, void* ptr)
   }
 }
 
+/**
+ * Select the method used to update ghost buses and branches. The default
+ * method moves data through a global array. The alternative only exchanges
+ * messages between processors that share ghost buses or branches and does
+ * not require any global synchronization. This must be called before
+ * initBusUpdate and initBranchUpdate.
+ * @param flag if true, use point-to-point exchanges between neighboring
+ *        processors
+ */
+void useNeighborExchange(bool flag)
+{
+  p_neighborExchange = flag;
+}
+
+/**
+ * Report which method is used to update ghost buses and branches
+ * @return true if point-to-point exchanges between neighboring processors
+ *         are used
+ */
+bool getNeighborExchange(void) const
+{
+  return p_neighborExchange;
+}
+
+/**
+ * Only send exchange buffers that have been marked as changed since the
+ * last update, along with a compact list of their positions. Buffers are
+ * marked using setXCBusBufferChanged/setXCBranchBufferChanged or by the
+ * components themselves (see BaseComponent::setXCBufChanged). Only
+ * components that have called setXCChangeTracking(true) are filtered, the
+ * buffers of all other components are sent in every update. This only
+ * has an effect if point-to-point exchanges between neighboring processors
+ * are used and must be called before initBusUpdate and initBranchUpdate.
+ * @param flag if true, only exchange changed buffers
+ */
+void useDeltaExchange(bool flag)
+{
+  p_deltaExchange = flag;
+}
+
+/**
+ * Report whether only changed exchange buffers are sent in updates
+ * @return true if only changed buffers are exchanged
+ */
+bool getDeltaExchange(void) const
+{
+  return p_deltaExchange;
+}
+
 /**
  * This function must be called before calling the update bus routine.
  * It initializes data structures for the bus update
@@ -1966,13 +2396,17 @@ void initBusUpdate(void)
   int i, size, numBuses;
   int grp = this->communicator().getGroup();
   GA_Pgroup_sync(grp);
+  p_busUpdateCat = gridpack::utility::CoarseTimer::instance()->createCategory(
+      "BaseNetwork<>::updateBuses()");
   // Don't do anything if buffers are not allocated
   if (p_busXCBufSize > 0) {
     // Clean up old GA, if it exists
     if (p_busGASet) {
       GA_Destroy(p_busGA);
       NGA_Deregister_type(p_busXCBufType);
+      p_busGASet = false;
     }
+    p_busExchange.reset();
     if (p_activeBusIndices) {
       for (i=0; i<p_numActiveBuses; ++i) {
         delete p_activeBusIndices[i];
@@ -1995,8 +2429,25 @@ void initBusUpdate(void)
       delete [] ((char*)p_busRcvBuf);
       p_busRcvBuf = NULL;
     }
-    // Find out how many active buses exist
     size = p_buses.size();
+    // Set up point-to-point exchange pattern between neighboring
+    // processors instead of a global array
+    if (p_neighborExchange) {
+      std::vector<int> gidx(size);
+      std::vector<bool> active(size);
+      for (i=0; i<size; i++) {
+        gidx[i] = p_busGlobalIndex[i];
+        active[i] = p_busActive[i];
+      }
+      p_busExchange.reset(new parallel::GhostExchange(this->communicator()));
+      p_busExchange->setDeltaMode(p_deltaExchange);
+      p_busExchange->setup(gidx, active, p_busXCBufSize);
+      // Make sure that first update sends everything
+      std::fill(p_busXCChanged.begin(), p_busXCChanged.end(), 1);
+      if (p_deltaExchange) p_checkBusChangeTracking();
+      return;
+    }
+    // Find out how many active buses exist
     numBuses = 0;
     int idx, icnt = 0, lcnt=0;
     for (i=0; i<size; i++) {
@@ -2101,6 +2552,14 @@ void initBusUpdate(void)
  */
 void updateBuses(void)
 {
+  if (p_busExchange) {
+    beginBusUpdate();
+    endBusUpdate();
+    return;
+  }
+  gridpack::utility::CoarseTimer *timer =
+    gridpack::utility::CoarseTimer::instance();
+  timer->start(p_busUpdateCat);
   int grp = this->communicator().getGroup();
   // Copy data from XC buffer to send buffer
   GA_Pgroup_sync(grp);
@@ -2148,6 +2607,50 @@ void updateBuses(void)
     }
   }
   GA_Pgroup_sync(grp);
+  timer->addCount(p_busUpdateCat,
+      static_cast<long>(p_numActiveBuses+p_numInactiveBuses)*p_busXCBufSize);
+  timer->stop(p_busUpdateCat);
+}
+
+/**
+ * Start an update of the bus ghost values. If point-to-point exchanges
+ * between neighboring processors are used, this call only posts the
+ * exchange and returns immediately so that calculations that do not
+ * depend on ghost buses can proceed while data is in transit. Exchange
+ * buffers of ghost buses must not be accessed until endBusUpdate has been
+ * called. If global arrays are used, this call performs the complete
+ * update.
+ */
+void beginBusUpdate(void)
+{
+  if (p_busExchange) {
+    gridpack::utility::CoarseTimer *timer =
+      gridpack::utility::CoarseTimer::instance();
+    timer->start(p_busUpdateCat);
+    if (p_deltaExchange && p_busXCChanged.size() > 0) {
+      p_markUntrackedBuses();
+      p_busExchange->begin(p_busXCBuffers, &p_busXCChanged[0]);
+      std::fill(p_busXCChanged.begin(), p_busXCChanged.end(), 0);
+    } else {
+      p_busExchange->begin(p_busXCBuffers);
+    }
+    timer->addCount(p_busUpdateCat, p_busExchange->bytesSent());
+  } else {
+    updateBuses();
+  }
+}
+
+/**
+ * Complete an update of the bus ghost values started by beginBusUpdate
+ */
+void endBusUpdate(void)
+{
+  if (p_busExchange) {
+    p_busExchange->end(p_busXCBuffers);
+    gridpack::utility::CoarseTimer *timer =
+      gridpack::utility::CoarseTimer::instance();
+    timer->stop(p_busUpdateCat);
+  }
 }
 
 /**
@@ -2159,13 +2662,17 @@ void initBranchUpdate(void)
   int i, size, numBranches;
   int grp = this->communicator().getGroup();
   GA_Pgroup_sync(grp);
+  p_branchUpdateCat = gridpack::utility::CoarseTimer::instance()->createCategory(
+      "BaseNetwork<>::updateBranches()");
   // Don't do anything if buffers are not allocated
   if (p_branchXCBufSize > 0) {
     // Clean up old GA, if it exists
     if (p_branchGASet) {
       GA_Destroy(p_branchGA);
       NGA_Deregister_type(p_branchXCBufType);
+      p_branchGASet = false;
     }
+    p_branchExchange.reset();
     if (p_activeBranchIndices) {
       for (i=0; i<p_numActiveBranches; ++i) {
         delete p_activeBranchIndices[i];
@@ -2188,8 +2695,25 @@ void initBranchUpdate(void)
         p_branchRcvBuf = NULL;
       }
     }
-    // Find out how many active branches exist
     size = p_branches.size();
+    // Set up point-to-point exchange pattern between neighboring
+    // processors instead of a global array
+    if (p_neighborExchange) {
+      std::vector<int> gidx(size);
+      std::vector<bool> active(size);
+      for (i=0; i<size; i++) {
+        gidx[i] = p_branchGlobalIndex[i];
+        active[i] = p_branchActive[i];
+      }
+      p_branchExchange.reset(new parallel::GhostExchange(this->communicator()));
+      p_branchExchange->setDeltaMode(p_deltaExchange);
+      p_branchExchange->setup(gidx, active, p_branchXCBufSize);
+      // Make sure that first update sends everything
+      std::fill(p_branchXCChanged.begin(), p_branchXCChanged.end(), 1);
+      if (p_deltaExchange) p_checkBranchChangeTracking();
+      return;
+    }
+    // Find out how many active branches exist
     numBranches = 0;
     for (i=0; i<size; i++) {
       if (getActiveBranch(i)) {
@@ -2283,6 +2807,14 @@ void initBranchUpdate(void)
  */
 void updateBranches(void)
 {
+  if (p_branchExchange) {
+    beginBranchUpdate();
+    endBranchUpdate();
+    return;
+  }
+  gridpack::utility::CoarseTimer *timer =
+    gridpack::utility::CoarseTimer::instance();
+  timer->start(p_branchUpdateCat);
   // Copy data from XC buffer to send buffer
   int grp = this->communicator().getGroup();
   GA_Pgroup_sync(grp);
@@ -2330,6 +2862,46 @@ void updateBranches(void)
     }
   }
   GA_Pgroup_sync(grp);
+  timer->addCount(p_branchUpdateCat,
+      static_cast<long>(p_numActiveBranches+p_numInactiveBranches)
+      *p_branchXCBufSize);
+  timer->stop(p_branchUpdateCat);
+}
+
+/**
+ * Start an update of the branch ghost values. See beginBusUpdate
+ */
+void beginBranchUpdate(void)
+{
+  if (p_branchExchange) {
+    gridpack::utility::CoarseTimer *timer =
+      gridpack::utility::CoarseTimer::instance();
+    timer->start(p_branchUpdateCat);
+    if (p_deltaExchange && p_branchXCChanged.size() > 0) {
+      p_markUntrackedBranches();
+      p_branchExchange->begin(p_branchXCBuffers, &p_branchXCChanged[0]);
+      std::fill(p_branchXCChanged.begin(), p_branchXCChanged.end(), 0);
+    } else {
+      p_branchExchange->begin(p_branchXCBuffers);
+    }
+    timer->addCount(p_branchUpdateCat, p_branchExchange->bytesSent());
+  } else {
+    updateBranches();
+  }
+}
+
+/**
+ * Complete an update of the branch ghost values started by
+ * beginBranchUpdate
+ */
+void endBranchUpdate(void)
+{
+  if (p_branchExchange) {
+    p_branchExchange->end(p_branchXCBuffers);
+    gridpack::utility::CoarseTimer *timer =
+      gridpack::utility::CoarseTimer::instance();
+    timer->stop(p_branchUpdateCat);
+  }
 }
 
 /**
@@ -2340,6 +2912,9 @@ void writeGraph(const std::string& outname)
 {
   static const bool internal_indexes(false);
   std::ofstream out;
+  int i;
+  int nbus = p_buses.size();
+  int nbranch = p_branches.size();
   if (this->processor_rank() == 0) {
     out.open(outname.c_str(), std::ofstream::out | std::ofstream::trunc);
     out << "digraph {" << std::endl;
@@ -2353,10 +2928,9 @@ void writeGraph(const std::string& outname)
       out << "subgraph cluster_" << p << " {" << std::endl;
       out << "color=red" << std::endl;
       out << "label=" << p << ";" << std::endl;
-      BusIterator bus;
-      for (bus = p_buses.begin(); bus != p_buses.end(); ++bus) {
-        if (bus->p_activeBus) {
-          int bidx(internal_indexes ? bus->p_globalBusIndex : bus->p_originalBusIndex);
+      for (i=0; i<nbus; i++) {
+        if (p_busActive[i]) {
+          int bidx(internal_indexes ? p_busGlobalIndex[i] : p_busOriginalIndex[i]);
           out << " n" << bidx << "[label=" << bidx << "];" << std::endl;
         }
       }
@@ -2370,11 +2944,10 @@ void writeGraph(const std::string& outname)
   for (int p = 0; p < this->processor_size(); ++p) {
     if (p == this->processor_rank()) {
       out.open(outname.c_str(), std::ofstream::out | std::ofstream::app);
-      BranchIterator branch;
-      for (branch = p_branches.begin(); branch != p_branches.end(); ++branch) {
-        if (branch->p_activeBranch) {
-          int bidx1(internal_indexes ? branch->p_globalBusIndex1 : branch->p_originalBusIndex1);
-          int bidx2(internal_indexes ? branch->p_globalBusIndex2 : branch->p_originalBusIndex2);
+      for (i=0; i<nbranch; i++) {
+        if (p_branchActive[i]) {
+          int bidx1(internal_indexes ? p_branchGlobalBus1[i] : p_branchOriginalBus1[i]);
+          int bidx2(internal_indexes ? p_branchGlobalBus2[i] : p_branchOriginalBus2[i]);
           out << "n" << bidx1 << " -> " 
             << "n" << bidx2 << ";" 
             << std::endl;
@@ -2399,15 +2972,14 @@ void writeGraph(const std::string& outname)
       out << "digraph \"" << p << "\" {" << std::endl;
       out << "label=\"Process " << p << "\";" << std::endl;
       out << "node [color=lightgrey];" << std::endl;
-      BusIterator bus;
-      for (bus = p_buses.begin(); bus != p_buses.end(); ++bus) {
+      for (i=0; i<nbus; i++) {
         std::string color("black");
         std::string style("\"\"");
-        if (!bus->p_activeBus) {
+        if (!p_busActive[i]) {
           color = "red";
           style = "dotted";
         }
-        int bidx(internal_indexes ? bus->p_globalBusIndex : bus->p_originalBusIndex);
+        int bidx(internal_indexes ? p_busGlobalIndex[i] : p_busOriginalIndex[i]);
         out << " n" << bidx
           << " ["
           << "label=" << bidx << ", "
@@ -2415,16 +2987,15 @@ void writeGraph(const std::string& outname)
           << "style=" << style 
           << "];" << std::endl;
       }
-      BranchIterator branch;
-      for (branch = p_branches.begin(); branch != p_branches.end(); ++branch) {
+      for (i=0; i<nbranch; i++) {
         std::string color("black");
         std::string style("solid");
-        if (!branch->p_activeBranch) {
+        if (!p_branchActive[i]) {
           color = "red";
           style = "dotted";
         }
-        int bidx1(internal_indexes ? branch->p_globalBusIndex1 : branch->p_originalBusIndex1);
-        int bidx2(internal_indexes ? branch->p_globalBusIndex2 : branch->p_originalBusIndex2);
+        int bidx1(internal_indexes ? p_branchGlobalBus1[i] : p_branchOriginalBus1[i]);
+        int bidx2(internal_indexes ? p_branchGlobalBus2[i] : p_branchOriginalBus2[i]);
         out << "n" << bidx1 << " -> " 
           << "n" << bidx2 << " " 
           << "[" 
@@ -2445,6 +3016,8 @@ void writeGraph(const std::string& outname)
  */
 void setMap(void)
 {
+  p_busNbrCSR = false;
+  p_buildNeighborCSR();
   int nbus = numBuses();
   int nbranch = numBranches();
   int i,idx,idx1,idx2;
@@ -2534,22 +3107,517 @@ private:
   // add some typedefs so things are more readable and we don't have
   // to type so much
 
-  typedef boost::shared_ptr< BusData<BusType> > BusDataPtr;
   typedef std::vector<  BusData<BusType> > BusDataVector;
   typedef typename BusDataVector::iterator BusIterator;
-  typedef boost::shared_ptr< BranchData<BranchType> > BranchDataPtr;
   typedef std::vector< BranchData<BranchType> > BranchDataVector;
   typedef typename BranchDataVector::iterator BranchIterator;
 
   /**
-   * Vector of bus data and objects
+   * Component object and data collection of a local bus. The indices,
+   * flags and neighbors of the bus are stored in the contiguous arrays
+   * below, which are the only copy of this data
    */
-  BusDataVector p_buses;
+  struct BusEntry {
+    BusEntry(void)
+      : p_bus(new BusType),
+        p_data(new component::DataCollection),
+        p_refFlag(false)
+    {}
+    BusEntry(const BusData<BusType> &rec)
+      : p_bus(rec.p_bus), p_data(rec.p_data), p_refFlag(rec.p_refFlag)
+    {}
+    boost::shared_ptr<BusType>                   p_bus;
+    boost::shared_ptr<component::DataCollection> p_data;
+    bool                                         p_refFlag;
+  };
 
   /**
-   * Vector of branch data and objects
+   * Component object and data collection of a local branch
    */
-  BranchDataVector p_branches;
+  struct BranchEntry {
+    BranchEntry(void)
+      : p_branch(new BranchType),
+        p_data(new component::DataCollection)
+    {}
+    BranchEntry(const BranchData<BranchType> &rec)
+      : p_branch(rec.p_branch), p_data(rec.p_data)
+    {}
+    boost::shared_ptr<BranchType>                p_branch;
+    boost::shared_ptr<component::DataCollection> p_data;
+  };
+
+/**
+ * Print the matrix rows and work assigned to each processor by the
+ * partitioner, along with the ratio of the maximum to the average load.
+ * This is a collective operation
+ * @param partitioner graph partitioner after the partition has been
+ *        calculated
+ */
+void p_printLoads(const GraphPartitioner &partitioner)
+{
+  std::vector<int> loads;
+  int ncon = partitioner.partition_loads(loads);
+  int nprocs = this->processor_size();
+  if (this->processor_rank() != 0 || p_no_print) return;
+  if (ncon == 1) {
+    // single weight is the measured work used by rebalance
+    double sum = 0.0, max = 0.0;
+    int p;
+    printf("\nPartition loads\n\n");
+    printf("  Process        Work\n");
+    for (p=0; p<nprocs; p++) {
+      printf("  %7d %11d\n",p,loads[p]);
+      sum += static_cast<double>(loads[p]);
+      if (static_cast<double>(loads[p]) > max) {
+        max = static_cast<double>(loads[p]);
+      }
+    }
+    if (sum > 0.0) max = max*static_cast<double>(nprocs)/sum;
+    printf("\nLoad imbalance (maximum/average) work: %8.4f\n\n",max);
+    return;
+  }
+  int i, p;
+  std::vector<double> sum(ncon,0.0), max(ncon,0.0);
+  printf("\nPartition loads\n\n");
+  printf("  Process        Rows        Work\n");
+  for (p=0; p<nprocs; p++) {
+    printf("  %7d %11d %11d\n",p,loads[p*ncon],loads[p*ncon+1]);
+    for (i=0; i<ncon; i++) {
+      double load = static_cast<double>(loads[p*ncon+i]);
+      sum[i] += load;
+      if (load > max[i]) max[i] = load;
+    }
+  }
+  for (i=0; i<ncon; i++) {
+    if (sum[i] > 0.0) {
+      max[i] = max[i]*static_cast<double>(nprocs)/sum[i];
+    } else {
+      max[i] = 1.0;
+    }
+  }
+  printf("\nLoad imbalance (maximum/average) rows: %8.4f work: %8.4f\n\n",
+      max[0],max[1]);
+}
+
+/**
+ * Divide the time measured on this process (p_stepTime) between the local
+ * buses and branches in proportion to the work estimated by the
+ * components. The weights are scaled so that the average bus has a
+ * weight of about REBALANCE_UNITS and every bus has a weight of at least
+ * one
+ * @param bus_work weights for local buses
+ * @param branch_work weights for local branches
+ */
+void p_measuredWork(std::vector<int> &bus_work, std::vector<int> &branch_work)
+{
+  int i, rows, work;
+  int nbus = p_buses.size();
+  int nbranch = p_branches.size();
+  std::vector<double> bwork(nbus), rwork(nbranch);
+  double total = 0.0;
+  for (i=0; i<nbus; i++) {
+    p_buses[i].p_bus->estimateCost(p_buses[i].p_data, &rows, &work);
+    bwork[i] = static_cast<double>(work > 0 ? work : 0);
+    total += bwork[i];
+  }
+  for (i=0; i<nbranch; i++) {
+    p_branches[i].p_branch->estimateCost(p_branches[i].p_data, &rows, &work);
+    rwork[i] = static_cast<double>(work > 0 ? work : 0);
+    total += rwork[i];
+  }
+  double sums[2], gsums[2];
+  sums[0] = static_cast<double>(nbus);
+  sums[1] = p_stepTime;
+  MPI_Allreduce(sums,gsums,2,MPI_DOUBLE,MPI_SUM,
+      static_cast<MPI_Comm>(this->communicator()));
+  double scale = 0.0;
+  if (total > 0.0 && gsums[1] > 0.0) {
+    scale = static_cast<double>(REBALANCE_UNITS)*gsums[0]*p_stepTime
+      /(gsums[1]*total);
+  }
+  bus_work.resize(nbus);
+  for (i=0; i<nbus; i++) {
+    bus_work[i] = static_cast<int>(bwork[i]*scale+0.5);
+    if (bus_work[i] < 1) bus_work[i] = 1;
+  }
+  branch_work.resize(nbranch);
+  for (i=0; i<nbranch; i++) {
+    branch_work[i] = static_cast<int>(rwork[i]*scale+0.5);
+  }
+}
+
+/**
+ * Mark the exchange buffers of buses that do not track changes to their
+ * buffers so that they are included in the next delta update
+ */
+void p_markUntrackedBuses(void)
+{
+  int i;
+  int nsize = p_buses.size();
+  for (i=0; i<nsize; i++) {
+    if (!p_buses[i].p_bus || !p_buses[i].p_bus->getXCChangeTracking()) {
+      p_busXCChanged[i] = 1;
+    }
+  }
+}
+
+/**
+ * Mark the exchange buffers of branches that do not track changes to their
+ * buffers so that they are included in the next delta update
+ */
+void p_markUntrackedBranches(void)
+{
+  int i;
+  int nsize = p_branches.size();
+  for (i=0; i<nsize; i++) {
+    if (!p_branches[i].p_branch ||
+        !p_branches[i].p_branch->getXCChangeTracking()) {
+      p_branchXCChanged[i] = 1;
+    }
+  }
+}
+
+/**
+ * Warn if delta exchanges are requested for buses but no bus component
+ * tracks changes to its exchange buffer. All bus buffers are then sent in
+ * every update. This is a collective operation
+ */
+void p_checkBusChangeTracking(void)
+{
+  int i;
+  int nsize = p_buses.size();
+  int ntracked = 0;
+  for (i=0; i<nsize; i++) {
+    if (p_buses[i].p_bus && p_buses[i].p_bus->getXCChangeTracking()) {
+      ntracked++;
+    }
+  }
+  this->communicator().sum(&ntracked,1);
+  if (ntracked == 0 && this->communicator().rank() == 0 && !p_no_print) {
+    printf("BaseNetwork::initBusUpdate: delta exchange is on but no bus"
+        " tracks changes to its exchange buffer, all buffers will be sent\n");
+  }
+}
+
+/**
+ * Warn if delta exchanges are requested for branches but no branch
+ * component tracks changes to its exchange buffer. This is a collective
+ * operation
+ */
+void p_checkBranchChangeTracking(void)
+{
+  int i;
+  int nsize = p_branches.size();
+  int ntracked = 0;
+  for (i=0; i<nsize; i++) {
+    if (p_branches[i].p_branch &&
+        p_branches[i].p_branch->getXCChangeTracking()) {
+      ntracked++;
+    }
+  }
+  this->communicator().sum(&ntracked,1);
+  if (ntracked == 0 && this->communicator().rank() == 0 && !p_no_print) {
+    printf("BaseNetwork::initBranchUpdate: delta exchange is on but no"
+        " branch tracks changes to its exchange buffer, all buffers will be"
+        " sent\n");
+  }
+}
+
+/**
+ * Point the changed flag of each bus at its entry in p_busXCChanged. This
+ * must be called whenever p_busXCChanged is reallocated or cleared so that
+ * components never hold a pointer into freed storage
+ */
+void p_setXCBusChangedFlags(void)
+{
+  int i;
+  int nsize = p_buses.size();
+  for (i=0; i<nsize; i++) {
+    if (p_buses[i].p_bus) {
+      p_buses[i].p_bus->setXCChangedFlag(getXCBusChangedFlag(i));
+    }
+  }
+}
+
+/**
+ * Point the changed flag of each branch at its entry in p_branchXCChanged
+ */
+void p_setXCBranchChangedFlags(void)
+{
+  int i;
+  int nsize = p_branches.size();
+  for (i=0; i<nsize; i++) {
+    if (p_branches[i].p_branch) {
+      p_branches[i].p_branch->setXCChangedFlag(getXCBranchChangedFlag(i));
+    }
+  }
+}
+
+/**
+ * Copy all local buses and branches into BusData and BranchData records so
+ * that they can be moved between processors. The records are only used
+ * for the move
+ * @param buses records for all local buses
+ * @param branches records for all local branches
+ */
+void p_exportTopology(BusDataVector &buses, BranchDataVector &branches)
+{
+  int i;
+  int nbus = p_buses.size();
+  buses.clear();
+  buses.reserve(nbus);
+  // Records are copied from a single template so that the default
+  // constructor does not create a new component for every record
+  BusData<BusType> bus_rec;
+  for (i=0; i<nbus; i++) {
+    bus_rec.p_activeBus = (p_busActive[i] != 0);
+    bus_rec.p_originalBusIndex = p_busOriginalIndex[i];
+    bus_rec.p_globalBusIndex = p_busGlobalIndex[i];
+    bus_rec.p_branchNeighbors.assign(
+        p_busNbrBranches.begin()+p_busNbrOffsets[i],
+        p_busNbrBranches.begin()+p_busNbrOffsets[i]+p_busNbrCount[i]);
+    bus_rec.p_bus = p_buses[i].p_bus;
+    bus_rec.p_data = p_buses[i].p_data;
+    bus_rec.p_refFlag = p_buses[i].p_refFlag;
+    buses.push_back(bus_rec);
+  }
+  int nbranch = p_branches.size();
+  branches.clear();
+  branches.reserve(nbranch);
+  BranchData<BranchType> branch_rec;
+  for (i=0; i<nbranch; i++) {
+    branch_rec.p_activeBranch = (p_branchActive[i] != 0);
+    branch_rec.p_globalBranchIndex = p_branchGlobalIndex[i];
+    branch_rec.p_originalBusIndex1 = p_branchOriginalBus1[i];
+    branch_rec.p_originalBusIndex2 = p_branchOriginalBus2[i];
+    branch_rec.p_globalBusIndex1 = p_branchGlobalBus1[i];
+    branch_rec.p_globalBusIndex2 = p_branchGlobalBus2[i];
+    branch_rec.p_localBusIndex1 = p_branchLocalBus1[i];
+    branch_rec.p_localBusIndex2 = p_branchLocalBus2[i];
+    branch_rec.p_branch = p_branches[i].p_branch;
+    branch_rec.p_data = p_branches[i].p_data;
+    branches.push_back(branch_rec);
+  }
+  p_buses.clear();
+  p_branches.clear();
+  p_clearTopology();
+}
+
+/**
+ * Replace all local buses and branches with the contents of BusData and
+ * BranchData records that have been moved between processors. The records
+ * are emptied
+ * @param buses records for all local buses
+ * @param branches records for all local branches
+ */
+void p_importTopology(BusDataVector &buses, BranchDataVector &branches)
+{
+  int i;
+  int nbus = buses.size();
+  p_buses.clear();
+  p_buses.reserve(nbus);
+  p_busActive.resize(nbus);
+  p_busOriginalIndex.resize(nbus);
+  p_busGlobalIndex.resize(nbus);
+  std::vector<int> nbrOffsets(nbus+1,0);
+  std::vector<int> nbrBranches;
+  for (i=0; i<nbus; i++) {
+    p_busActive[i] = buses[i].p_activeBus;
+    p_busOriginalIndex[i] = buses[i].p_originalBusIndex;
+    p_busGlobalIndex[i] = buses[i].p_globalBusIndex;
+    const std::vector<int> &nghbrs = buses[i].p_branchNeighbors;
+    nbrBranches.insert(nbrBranches.end(), nghbrs.begin(), nghbrs.end());
+    nbrOffsets[i+1] = nbrBranches.size();
+    p_buses.push_back(BusEntry(buses[i]));
+  }
+  p_setNeighborArrays(nbrOffsets, nbrBranches);
+  int nbranch = branches.size();
+  p_branches.clear();
+  p_branches.reserve(nbranch);
+  p_branchActive.resize(nbranch);
+  p_branchGlobalIndex.resize(nbranch);
+  p_branchOriginalBus1.resize(nbranch);
+  p_branchOriginalBus2.resize(nbranch);
+  p_branchGlobalBus1.resize(nbranch);
+  p_branchGlobalBus2.resize(nbranch);
+  p_branchLocalBus1.resize(nbranch);
+  p_branchLocalBus2.resize(nbranch);
+  for (i=0; i<nbranch; i++) {
+    p_branchActive[i] = branches[i].p_activeBranch;
+    p_branchGlobalIndex[i] = branches[i].p_globalBranchIndex;
+    p_branchOriginalBus1[i] = branches[i].p_originalBusIndex1;
+    p_branchOriginalBus2[i] = branches[i].p_originalBusIndex2;
+    p_branchGlobalBus1[i] = branches[i].p_globalBusIndex1;
+    p_branchGlobalBus2[i] = branches[i].p_globalBusIndex2;
+    p_branchLocalBus1[i] = branches[i].p_localBusIndex1;
+    p_branchLocalBus2[i] = branches[i].p_localBusIndex2;
+    p_branches.push_back(BranchEntry(branches[i]));
+  }
+  buses.clear();
+  branches.clear();
+}
+
+/**
+ * Remove all entries from the bus and branch index arrays
+ */
+void p_clearTopology(void)
+{
+  p_busActive.clear();
+  p_busOriginalIndex.clear();
+  p_busGlobalIndex.clear();
+  p_busNbrOffsets.assign(1, 0);
+  p_busNbrCount.clear();
+  p_busNbrCapacity.clear();
+  p_busNbrBranches.clear();
+  p_busNbrCSR = true;
+  p_branchActive.clear();
+  p_branchGlobalIndex.clear();
+  p_branchOriginalBus1.clear();
+  p_branchOriginalBus2.clear();
+  p_branchGlobalBus1.clear();
+  p_branchGlobalBus2.clear();
+  p_branchLocalBus1.clear();
+  p_branchLocalBus2.clear();
+}
+
+/**
+ * Add a branch to the neighbor list of a bus. The branch is stored in the
+ * free space at the end of the list of the bus if there is any, otherwise
+ * the list is moved to the end of the neighbor array with room to grow.
+ * Lists that are moved leave unused space in the array until the storage
+ * is compressed again by p_buildNeighborCSR
+ * @param idx local index of bus
+ * @param br_idx local index of branch attached to bus
+ */
+void p_addNeighbor(int idx, int br_idx)
+{
+  int nbus = p_buses.size();
+  int offset = p_busNbrOffsets[idx];
+  int count = p_busNbrCount[idx];
+  int nsize = p_busNbrBranches.size();
+  if (count < p_busNbrCapacity[idx]) {
+    // Unused space is left behind whenever a list is shortened or moved
+    p_busNbrBranches[offset+count] = br_idx;
+    p_busNbrCSR = false;
+  } else if (offset+count == nsize) {
+    p_busNbrBranches.push_back(br_idx);
+    p_busNbrCapacity[idx]++;
+    p_busNbrOffsets[nbus] = nsize+1;
+    // Appending to the last bus keeps the storage compressed
+    if (idx != nbus-1) p_busNbrCSR = false;
+  } else {
+    int capacity = std::max(4, 2*count);
+    p_busNbrBranches.resize(nsize+capacity, -1);
+    std::copy(p_busNbrBranches.begin()+offset,
+        p_busNbrBranches.begin()+offset+count,
+        p_busNbrBranches.begin()+nsize);
+    p_busNbrBranches[nsize+count] = br_idx;
+    p_busNbrOffsets[idx] = nsize;
+    p_busNbrCapacity[idx] = capacity;
+    p_busNbrOffsets[nbus] = nsize+capacity;
+    p_busNbrCSR = false;
+  }
+  p_busNbrCount[idx] = count+1;
+}
+
+/**
+ * Replace the neighbor storage with compressed arrays. The arrays are
+ * emptied
+ * @param offsets offsets of the neighbor list of each bus in branches
+ *        (length is number of buses plus one)
+ * @param branches local indices of branches connected to each bus
+ */
+void p_setNeighborArrays(std::vector<int> &offsets, std::vector<int> &branches)
+{
+  int i;
+  int nbus = offsets.size()-1;
+  p_busNbrOffsets.swap(offsets);
+  p_busNbrBranches.swap(branches);
+  p_busNbrCount.resize(nbus);
+  for (i=0; i<nbus; i++) {
+    p_busNbrCount[i] = p_busNbrOffsets[i+1] - p_busNbrOffsets[i];
+  }
+  p_busNbrCapacity = p_busNbrCount;
+  p_busNbrCSR = true;
+  offsets.clear();
+  branches.clear();
+}
+
+/**
+ * Compress the neighbor storage if neighbor lists have been modified, so
+ * that the lists are stored in bus order without unused space. This is
+ * called from partition, clean and setMap so that the storage is never
+ * rearranged from inside a const accessor
+ */
+void p_buildNeighborCSR(void)
+{
+  if (p_busNbrCSR) return;
+  int i, j;
+  int nbus = p_buses.size();
+  std::vector<int> offsets(nbus+1);
+  std::vector<int> branches;
+  offsets[0] = 0;
+  for (i=0; i<nbus; i++) {
+    offsets[i+1] = offsets[i] + p_busNbrCount[i];
+  }
+  branches.resize(offsets[nbus]);
+  for (i=0; i<nbus; i++) {
+    int offset = p_busNbrOffsets[i];
+    int nsize = p_busNbrCount[i];
+    for (j=0; j<nsize; j++) {
+      branches[offsets[i]+j] = p_busNbrBranches[offset+j];
+    }
+  }
+  p_setNeighborArrays(offsets, branches);
+}
+
+  /**
+   * Vector of bus objects and data collections
+   */
+  std::vector<BusEntry> p_buses;
+
+  /**
+   * Vector of branch objects and data collections
+   */
+  std::vector<BranchEntry> p_branches;
+
+  /**
+   * Indices and flags for local buses, stored as separate arrays so that
+   * loops over buses only touch the fields they need. BusData records are
+   * only created to move buses between processors (see p_exportTopology
+   * and p_importTopology)
+   */
+  std::vector<char> p_busActive;
+  std::vector<int>  p_busOriginalIndex;
+  std::vector<int>  p_busGlobalIndex;
+
+  /**
+   * Branches connected to each local bus. The branches attached to bus i
+   * are p_busNbrBranches[p_busNbrOffsets[i]] through
+   * p_busNbrBranches[p_busNbrOffsets[i]+p_busNbrCount[i]-1] and the list
+   * can grow in place up to p_busNbrCapacity[i] entries. If p_busNbrCSR is
+   * true, the lists are stored in bus order without unused space, so the
+   * arrays are in compressed sparse row form and p_busNbrOffsets[nbus] is
+   * the total number of entries. The storage is compressed by partition,
+   * clean and setMap
+   */
+  std::vector<int> p_busNbrOffsets;
+  std::vector<int> p_busNbrCount;
+  std::vector<int> p_busNbrCapacity;
+  std::vector<int> p_busNbrBranches;
+  bool p_busNbrCSR;
+
+  /**
+   * Indices and flags for local branches, stored as contiguous arrays
+   */
+  std::vector<char> p_branchActive;
+  std::vector<int>  p_branchGlobalIndex;
+  std::vector<int>  p_branchOriginalBus1;
+  std::vector<int>  p_branchOriginalBus2;
+  std::vector<int>  p_branchGlobalBus1;
+  std::vector<int>  p_branchGlobalBus2;
+  std::vector<int>  p_branchLocalBus1;
+  std::vector<int>  p_branchLocalBus2;
 
   /**
    * Parameter for keeping track of reference bus
@@ -2604,6 +3672,40 @@ private:
   void *p_branchSndBuf;
   void *p_branchRcvBuf;
 
+  /**
+   * Use cost estimates from components as weights when partitioning
+   */
+  bool p_costWeights;
+
+  /**
+   * Repartition starting from the current distribution, using the time
+   * measured on this process as the weight (see rebalance)
+   */
+  bool p_rebalance;
+  double p_stepTime;
+
+  /**
+   * Point-to-point exchanges between neighboring processors. These are
+   * used instead of the global arrays if p_neighborExchange is true
+   */
+  bool p_neighborExchange;
+  boost::shared_ptr<parallel::GhostExchange> p_busExchange;
+  boost::shared_ptr<parallel::GhostExchange> p_branchExchange;
+
+  /**
+   * Flags marking exchange buffers that have changed since the last update.
+   * These are only used if p_deltaExchange is true
+   */
+  bool p_deltaExchange;
+  std::vector<char> p_busXCChanged;
+  std::vector<char> p_branchXCChanged;
+
+  /**
+   * Timer categories for ghost updates
+   */
+  int p_busUpdateCat;
+  int p_branchUpdateCat;
+
   /**
    * Map structures that can map between Original and local indices
    */
@@ -0,0 +1,400 @@
+// Emacs Mode Line: -*- Mode:c++;-*-
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   network_snapshot.hpp
+ * @author agent
+ * @date   2026-10-17
+ *
+ * @brief
+ * Save a partitioned network to a binary file and restore it in later runs
+ * without parsing the network configuration files or calling the
+ * partitioner. The file contains a header with a format version, the number
+ * of processors used to create it and a hash of the contents of the source
+ * files, followed by a table of offsets and one section per processor. Each
+ * section holds the buses and branches (including ghosts) owned by that
+ * processor, their indices and data collections, so a processor only reads
+ * its own section when the snapshot is restored.
+ *
+ * A snapshot is only used if the version, the number of processors and the
+ * source file hash all match. Otherwise read returns false and the calling
+ * program should parse and partition the network as usual and then write a
+ * new snapshot.
+ *
+ * Snapshots are written with boost binary archives and are not portable
+ * between different architectures or boost versions. A snapshot that cannot
+ * be read is treated as out of date.
+ *
+ */
+// -------------------------------------------------------------
+
+#ifndef _network_snapshot_hpp_
+#define _network_snapshot_hpp_
+
+#include <mpi.h>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <boost/shared_ptr.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include "gridpack/parallel/communicator.hpp"
+#include "gridpack/component/data_collection.hpp"
+#include "gridpack/utilities/exception.hpp"
+
+// Identifier at start of snapshot file and current format version. The
+// version must be incremented if the contents of a section change
+#define SNAPSHOT_MAGIC "GPNSNAP"
+#define SNAPSHOT_VERSION 1
+
+namespace gridpack {
+namespace network {
+
+template <class _network>
+class NetworkSnapshot
+{
+  public:
+
+    /**
+     * Constructor
+     * @param network network that is written to or restored from a
+     *        snapshot
+     */
+    NetworkSnapshot(boost::shared_ptr<_network> network)
+      : p_network(network), p_hashSet(false), p_hash(0)
+    {
+    }
+
+    /**
+     * Destructor
+     */
+    ~NetworkSnapshot()
+    {
+    }
+
+    /**
+     * Add a file that was used to create the network. The snapshot is
+     * considered out of date if the contents of any of these files change.
+     * Files must be added in the same order when the snapshot is written
+     * and read
+     * @param file name of source file
+     */
+    void addSourceFile(const std::string &file)
+    {
+      p_sources.push_back(file);
+      p_hashSet = false;
+    }
+
+    /**
+     * Add a parameter that affects the contents of the network (for
+     * example, an option that modifies the data read from the source
+     * files). The snapshot is considered out of date if this string changes
+     * @param str string describing parameter and its value
+     */
+    void addSourceString(const std::string &str)
+    {
+      p_strings.push_back(str);
+      p_hashSet = false;
+    }
+
+    /**
+     * Restore network from a snapshot. The network should not contain any
+     * buses or branches. If the snapshot is missing or out of date the
+     * network is not modified. This is a collective operation on the
+     * network communicator
+     * @param file name of snapshot file
+     * @return true if network was restored from snapshot
+     */
+    bool read(const std::string &file)
+    {
+      const gridpack::parallel::Communicator &comm = p_network->communicator();
+      MPI_Comm mcomm = static_cast<MPI_Comm>(comm);
+      int me = comm.rank();
+      int nprocs = comm.size();
+      unsigned long long hash = sourceHash();
+
+      // Process 0 checks the header and reads the section offsets
+      std::vector<unsigned long long> table(2*nprocs+2,0);
+      int ok = 0;
+      if (me == 0) {
+        std::ifstream fin(file.c_str(), std::ios::in | std::ios::binary);
+        if (fin.is_open()) {
+          SnapshotHeader header;
+          fin.read(reinterpret_cast<char*>(&header),sizeof(header));
+          if (fin.good() && strncmp(header.magic,SNAPSHOT_MAGIC,8) == 0 &&
+              header.version == SNAPSHOT_VERSION &&
+              header.nprocs == nprocs && header.hash == hash) {
+            fin.read(reinterpret_cast<char*>(&table[0]),
+                2*nprocs*sizeof(unsigned long long));
+            if (fin.good()) ok = 1;
+          }
+          fin.close();
+        }
+      }
+      MPI_Bcast(&ok,1,MPI_INT,0,mcomm);
+      if (!ok) return false;
+      MPI_Bcast(&table[0],2*nprocs,MPI_UNSIGNED_LONG_LONG,0,mcomm);
+
+      // Read this processor's section
+      MPI_File fh;
+      if (MPI_File_open(mcomm,const_cast<char*>(file.c_str()),
+            MPI_MODE_RDONLY,MPI_INFO_NULL,&fh) != MPI_SUCCESS) {
+        return false;
+      }
+      MPI_Offset offset = static_cast<MPI_Offset>(table[2*me]);
+      int size = static_cast<int>(table[2*me+1]);
+      std::vector<char> buf(size+1);
+      MPI_Status status;
+      MPI_File_read_at_all(fh,offset,&buf[0],size,MPI_CHAR,&status);
+      MPI_File_close(&fh);
+
+      // Unpack section. If any processor fails, the network is cleared on
+      // all processors so that it can be parsed again
+      ok = 1;
+      try {
+        std::string str(&buf[0],size);
+        std::istringstream in(str);
+        boost::archive::binary_iarchive ia(in);
+        unpack(ia);
+      } catch (...) {
+        ok = 0;
+      }
+      int all_ok;
+      MPI_Allreduce(&ok,&all_ok,1,MPI_INT,MPI_MIN,mcomm);
+      if (!all_ok) {
+        p_network->clear();
+        return false;
+      }
+      p_network->setMap();
+      return true;
+    }
+
+    /**
+     * Write network to a snapshot. This should be called after the network
+     * has been partitioned and all data from external files has been added
+     * to the data collections. This is a collective operation on the
+     * network communicator
+     * @param file name of snapshot file
+     */
+    void write(const std::string &file)
+    {
+      const gridpack::parallel::Communicator &comm = p_network->communicator();
+      MPI_Comm mcomm = static_cast<MPI_Comm>(comm);
+      int me = comm.rank();
+      int nprocs = comm.size();
+      unsigned long long hash = sourceHash();
+
+      std::string section;
+      {
+        std::ostringstream out;
+        boost::archive::binary_oarchive oa(out);
+        pack(oa);
+        section = out.str();
+      }
+
+      // Find offset of each section. Sections start after the header and
+      // the table of offsets
+      unsigned long long size = section.length();
+      std::vector<unsigned long long> sizes(nprocs);
+      MPI_Allgather(&size,1,MPI_UNSIGNED_LONG_LONG,&sizes[0],1,
+          MPI_UNSIGNED_LONG_LONG,mcomm);
+      std::vector<unsigned long long> table(2*nprocs);
+      unsigned long long offset = sizeof(SnapshotHeader)
+        + 2*nprocs*sizeof(unsigned long long);
+      int p;
+      for (p=0; p<nprocs; p++) {
+        table[2*p] = offset;
+        table[2*p+1] = sizes[p];
+        offset += sizes[p];
+      }
+
+      MPI_File fh;
+      if (MPI_File_open(mcomm,const_cast<char*>(file.c_str()),
+            MPI_MODE_WRONLY|MPI_MODE_CREATE,MPI_INFO_NULL,&fh) != MPI_SUCCESS) {
+        char buf[512];
+        sprintf(buf,"NetworkSnapshot::write: unable to open file %s\n",
+            file.c_str());
+        throw gridpack::Exception(buf);
+      }
+      MPI_File_set_size(fh,static_cast<MPI_Offset>(offset));
+      MPI_Status status;
+      if (me == 0) {
+        SnapshotHeader header;
+        memset(&header,0,sizeof(header));
+        strncpy(header.magic,SNAPSHOT_MAGIC,8);
+        header.version = SNAPSHOT_VERSION;
+        header.nprocs = nprocs;
+        header.hash = hash;
+        MPI_File_write_at(fh,0,&header,sizeof(header),MPI_CHAR,&status);
+        MPI_File_write_at(fh,sizeof(header),&table[0],
+            2*nprocs*sizeof(unsigned long long),MPI_CHAR,&status);
+      }
+      MPI_File_write_at_all(fh,static_cast<MPI_Offset>(table[2*me]),
+          const_cast<char*>(section.data()),static_cast<int>(size),MPI_CHAR,
+          &status);
+      MPI_File_close(&fh);
+    }
+
+  private:
+
+    struct SnapshotHeader {
+      char magic[8];
+      int version;
+      int nprocs;
+      unsigned long long hash;
+    };
+
+    /**
+     * Hash of the contents of all source files and parameter strings (64
+     * bit FNV-1a). The files are read on process 0 and the hash is
+     * broadcast to all processors. Missing files contribute their name only
+     * @return hash value
+     */
+    unsigned long long sourceHash(void)
+    {
+      if (p_hashSet) return p_hash;
+      const gridpack::parallel::Communicator &comm = p_network->communicator();
+      unsigned long long hash = 14695981039346656037ULL;
+      if (comm.rank() == 0) {
+        int i;
+        std::vector<char> buf(1048576);
+        for (i=0; i<p_sources.size(); i++) {
+          const std::string &name = p_sources[i];
+          hash = addHash(hash,name.data(),name.length());
+          std::ifstream fin(name.c_str(), std::ios::in | std::ios::binary);
+          while (fin.is_open() && fin.good()) {
+            fin.read(&buf[0],buf.size());
+            hash = addHash(hash,&buf[0],fin.gcount());
+          }
+        }
+        for (i=0; i<p_strings.size(); i++) {
+          hash = addHash(hash,p_strings[i].data(),p_strings[i].length());
+        }
+      }
+      MPI_Bcast(&hash,1,MPI_UNSIGNED_LONG_LONG,0,static_cast<MPI_Comm>(comm));
+      p_hash = hash;
+      p_hashSet = true;
+      return p_hash;
+    }
+
+    /**
+     * Add characters to hash
+     * @param hash current hash value
+     * @param buf characters to be added
+     * @param len number of characters
+     * @return new hash value
+     */
+    static unsigned long long addHash(unsigned long long hash,
+        const char *buf, int len)
+    {
+      int i;
+      for (i=0; i<len; i++) {
+        hash ^= static_cast<unsigned char>(buf[i]);
+        hash *= 1099511628211ULL;
+      }
+      return hash;
+    }
+
+    /**
+     * Pack buses, branches and network data on this processor into an
+     * archive
+     * @param oa output archive
+     */
+    void pack(boost::archive::binary_oarchive &oa)
+    {
+      int i;
+      int nbus = p_network->numBuses();
+      oa << nbus;
+      for (i=0; i<nbus; i++) {
+        int o_idx = p_network->getOriginalBusIndex(i);
+        int g_idx = p_network->getGlobalBusIndex(i);
+        bool active = p_network->getActiveBus(i);
+        std::vector<int> nghbrs = p_network->getConnectedBranches(i);
+        oa << o_idx << g_idx << active << nghbrs;
+        const gridpack::component::DataCollection &data
+          = *(p_network->getBusData(i));
+        oa << data;
+      }
+      int nbranch = p_network->numBranches();
+      oa << nbranch;
+      for (i=0; i<nbranch; i++) {
+        int idx1, idx2, l_idx1, l_idx2;
+        p_network->getOriginalBranchEndpoints(i,&idx1,&idx2);
+        p_network->getBranchEndpoints(i,&l_idx1,&l_idx2);
+        int g_idx = p_network->getGlobalBranchIndex(i);
+        bool active = p_network->getActiveBranch(i);
+        oa << idx1 << idx2 << l_idx1 << l_idx2 << g_idx << active;
+        const gridpack::component::DataCollection &data
+          = *(p_network->getBranchData(i));
+        oa << data;
+      }
+      int ref = p_network->getReferenceBus();
+      oa << ref;
+      const gridpack::component::DataCollection &data
+        = *(p_network->getNetworkData());
+      oa << data;
+    }
+
+    /**
+     * Unpack buses, branches and network data from an archive into the
+     * network
+     * @param ia input archive
+     */
+    void unpack(boost::archive::binary_iarchive &ia)
+    {
+      int i, j;
+      int nbus;
+      ia >> nbus;
+      for (i=0; i<nbus; i++) {
+        int o_idx, g_idx;
+        bool active;
+        std::vector<int> nghbrs;
+        ia >> o_idx >> g_idx >> active >> nghbrs;
+        p_network->addBus(o_idx);
+        p_network->setGlobalBusIndex(i,g_idx);
+        p_network->setActiveBus(i,active);
+        for (j=0; j<nghbrs.size(); j++) {
+          p_network->addBranchNeighbor(i,nghbrs[j]);
+        }
+        ia >> *(p_network->getBusData(i));
+      }
+      int nbranch;
+      ia >> nbranch;
+      for (i=0; i<nbranch; i++) {
+        int idx1, idx2, l_idx1, l_idx2, g_idx;
+        bool active;
+        ia >> idx1 >> idx2 >> l_idx1 >> l_idx2 >> g_idx >> active;
+        p_network->addBranch(idx1,idx2);
+        p_network->setGlobalBranchIndex(i,g_idx);
+        p_network->setActiveBranch(i,active);
+        p_network->setLocalBusIndex1(i,l_idx1);
+        p_network->setLocalBusIndex2(i,l_idx2);
+        p_network->setGlobalBusIndex1(i,p_network->getGlobalBusIndex(l_idx1));
+        p_network->setGlobalBusIndex2(i,p_network->getGlobalBusIndex(l_idx2));
+        ia >> *(p_network->getBranchData(i));
+      }
+      int ref;
+      ia >> ref;
+      if (ref != -1) p_network->setReferenceBus(ref);
+      ia >> *(p_network->getNetworkData());
+    }
+
+    boost::shared_ptr<_network> p_network;
+    std::vector<std::string> p_sources;
+    std::vector<std::string> p_strings;
+    bool p_hashSet;
+    unsigned long long p_hash;
+};
+
+} // namespace network
+} // namespace gridpack
+#endif
@@ -14,6 +14,7 @@
  */
 
 #include <iostream>
+#include <fstream>
 #include <ga++.h>
 #include <boost/mpi/environment.hpp>
 #include <boost/mpi/communicator.hpp>
@@ -25,6 +26,7 @@
 
 #include "gridpack/component/base_component.hpp"
 #include "base_network.hpp"
+#include "network_snapshot.hpp"
 #include "gridpack/environment/environment.hpp"
 
 // -------------------------------------------------------------
@@ -427,6 +429,118 @@ BOOST_AUTO_TEST_CASE ( lattice_partition )
   net.writeGraph("lattice-after.dot");
 }
 
+BOOST_AUTO_TEST_CASE ( lattice_rebalance )
+{
+  gridpack::parallel::Communicator world;
+  static const int rows(8), cols(8);
+  BogusLatticeNetwork net(world, rows, cols);
+  int i;
+  if (world.rank() == 0) {
+    for (i=0; i<net.numBuses(); i++) {
+      net.getBusData(i)->addValue("BUS_VALUE",
+          static_cast<double>(net.getOriginalBusIndex(i)));
+    }
+  }
+  net.partition();
+
+  // Network is not changed if the times are balanced
+  int nbus(net.numBuses());
+  BOOST_CHECK(!net.rebalance(1.0));
+  BOOST_CHECK_EQUAL(net.numBuses(), nbus);
+
+  // Make process 0 look much slower than the others
+  double time(world.rank() == 0 ? 4.0 : 1.0);
+  bool moved(net.rebalance(time));
+  BOOST_CHECK_EQUAL(moved, world.size() > 1);
+
+  // All buses and branches are still owned by one process, buses keep
+  // their data and branches point to the correct buses
+  BOOST_CHECK_EQUAL(net.totalBuses(), rows*cols);
+  BOOST_CHECK_EQUAL(net.totalBranches(), rows*(cols-1)+cols*(rows-1));
+  for (i=0; i<net.numBuses(); i++) {
+    double value;
+    BOOST_CHECK(net.getBusData(i)->getValue("BUS_VALUE",&value));
+    BOOST_CHECK_EQUAL(value,
+        static_cast<double>(net.getOriginalBusIndex(i)));
+  }
+  for (i=0; i<net.numBranches(); i++) {
+    int o1, o2, l1, l2;
+    net.getOriginalBranchEndpoints(i,&o1,&o2);
+    net.getBranchEndpoints(i,&l1,&l2);
+    BOOST_CHECK_EQUAL(net.getOriginalBusIndex(l1), o1);
+    BOOST_CHECK_EQUAL(net.getOriginalBusIndex(l2), o2);
+  }
+}
+
+BOOST_AUTO_TEST_CASE ( snapshot )
+{
+  typedef gridpack::network::BaseNetwork<BogusBus, BogusBranch> BogusBaseNetwork;
+  gridpack::parallel::Communicator world;
+  static const int rows(5), cols(5);
+  boost::shared_ptr<BogusBaseNetwork>
+    net(new BogusLatticeNetwork(world, rows, cols));
+  int i;
+  if (world.rank() == 0) {
+    for (i=0; i<net->numBuses(); i++) {
+      net->getBusData(i)->addValue("BUS_VALUE",
+          static_cast<double>(net->getOriginalBusIndex(i)));
+    }
+  }
+  net->partition();
+
+  // Create a source file for the snapshot
+  std::string source("snapshot-source.txt");
+  std::string file("network-snapshot.bin");
+  if (world.rank() == 0) {
+    std::ofstream out(source.c_str());
+    out << "lattice " << rows << " " << cols << std::endl;
+    out.close();
+  }
+  world.barrier();
+
+  gridpack::network::NetworkSnapshot<BogusBaseNetwork> snap(net);
+  snap.addSourceFile(source);
+  snap.write(file);
+
+  boost::shared_ptr<BogusBaseNetwork> copy(new BogusBaseNetwork(world));
+  gridpack::network::NetworkSnapshot<BogusBaseNetwork> rsnap(copy);
+  rsnap.addSourceFile(source);
+  BOOST_CHECK(rsnap.read(file));
+  BOOST_CHECK_EQUAL(copy->numBuses(), net->numBuses());
+  BOOST_CHECK_EQUAL(copy->numBranches(), net->numBranches());
+  for (i=0; i<copy->numBuses(); i++) {
+    BOOST_CHECK_EQUAL(copy->getOriginalBusIndex(i), net->getOriginalBusIndex(i));
+    BOOST_CHECK_EQUAL(copy->getGlobalBusIndex(i), net->getGlobalBusIndex(i));
+    BOOST_CHECK_EQUAL(copy->getActiveBus(i), net->getActiveBus(i));
+    BOOST_CHECK(copy->getConnectedBranches(i) == net->getConnectedBranches(i));
+    double value;
+    BOOST_CHECK(copy->getBusData(i)->getValue("BUS_VALUE",&value));
+    BOOST_CHECK_EQUAL(value,
+        static_cast<double>(copy->getOriginalBusIndex(i)));
+  }
+  for (i=0; i<copy->numBranches(); i++) {
+    int c1, c2, n1, n2;
+    copy->getBranchEndpoints(i,&c1,&c2);
+    net->getBranchEndpoints(i,&n1,&n2);
+    BOOST_CHECK_EQUAL(c1, n1);
+    BOOST_CHECK_EQUAL(c2, n2);
+    BOOST_CHECK_EQUAL(copy->getGlobalBranchIndex(i), net->getGlobalBranchIndex(i));
+    BOOST_CHECK_EQUAL(copy->getActiveBranch(i), net->getActiveBranch(i));
+  }
+
+  // Snapshot is out of date if the source file changes
+  if (world.rank() == 0) {
+    std::ofstream out(source.c_str());
+    out << "lattice " << cols << " " << rows+1 << std::endl;
+    out.close();
+  }
+  world.barrier();
+  boost::shared_ptr<BogusBaseNetwork> stale(new BogusBaseNetwork(world));
+  gridpack::network::NetworkSnapshot<BogusBaseNetwork> ssnap(stale);
+  ssnap.addSourceFile(source);
+  BOOST_CHECK(!ssnap.read(file));
+  BOOST_CHECK_EQUAL(stale->numBuses(), 0);
+}
 
 BOOST_AUTO_TEST_SUITE_END( )
 
@@ -15,6 +15,7 @@
 #include "mpi.h"
 #include <macdecls.h>
 #include "gridpack/network/base_network.hpp"
+#include "gridpack/factory/base_factory.hpp"
 
 #define XDIM 20
 #define YDIM 20
@@ -46,6 +47,12 @@ class TestBranch
 
 BOOST_CLASS_EXPORT(TestBranch)
 
+// The network in the test is created on the stack, so wrap it in a shared
+// pointer that does not delete it when it is passed to a factory
+struct NoDelete {
+  template <class T> void operator()(T*) {}
+};
+
 void factor_grid(int nproc, int xsize, int ysize, int *pdx, int *pdy)
 {
   int i,j,it,ip,ifac,pmax,prime[1000], chk;
@@ -454,6 +461,48 @@ BOOST_AUTO_TEST_CASE( TestNetworkTopology )
   }
   BOOST_CHECK(ok);
 
+  // check that raw array accessors agree with individual accessors
+  ok = true;
+  {
+    const char *bactive = network.getActiveBusArray();
+    const int *bgidx = network.getGlobalBusIndexArray();
+    const int *offsets, *nbranches;
+    // neighbor lists were modified directly, so rebuild the CSR arrays
+    network.setMap();
+    network.getBusNeighborArrays(&offsets, &nbranches);
+    for (i=0; i<nbus; i++) {
+      if ((bactive[i] != 0) != network.getActiveBus(i)) ok = false;
+      if (bgidx[i] != network.getGlobalBusIndex(i)) ok = false;
+      std::vector<int> branches = network.getConnectedBranches(i);
+      if (offsets[i+1]-offsets[i] != branches.size()) {
+        ok = false;
+      } else {
+        for (j=0; j<branches.size(); j++) {
+          if (nbranches[offsets[i]+j] != branches[j]) ok = false;
+        }
+      }
+    }
+    const char *ractive = network.getActiveBranchArray();
+    const int *rgidx = network.getGlobalBranchIndexArray();
+    const int *bus1, *bus2;
+    network.getBranchEndpointArrays(&bus1, &bus2);
+    for (i=0; i<nbranch; i++) {
+      if ((ractive[i] != 0) != network.getActiveBranch(i)) ok = false;
+      if (rgidx[i] != network.getGlobalBranchIndex(i)) ok = false;
+      network.getBranchEndpoints(i, &n1, &n2);
+      if (bus1[i] != n1 || bus2[i] != n2) ok = false;
+    }
+  }
+  oks = (int)ok;
+  ierr = MPI_Allreduce(&oks, &okr, 1, MPI_INT, MPI_PROD, mpi_world);
+  ok = (bool)okr;
+  if (me == 0 && ok) {
+    printf("\nNetwork arrays are ok\n");
+  } else if (!ok) {
+    printf("\nMismatched network arrays on %d\n",me);
+  }
+  BOOST_CHECK(ok);
+
   // Test clone operation
   bool test_clone = true;
   if (test_clone) {
@@ -629,9 +678,205 @@ BOOST_AUTO_TEST_CASE( TestNetworkTopology )
   }
   BOOST_CHECK(ok);
 
+  // Time updates using global arrays
+  int nloop = 100;
+  double t_ga = MPI_Wtime();
+  for (i=0; i<nloop; i++) {
+    network.updateBuses();
+    network.updateBranches();
+  }
+  t_ga = MPI_Wtime() - t_ga;
+
+  // Repeat ghost update test using point-to-point exchanges between
+  // neighboring processors
+  for (i=0; i<nbus; i++) {
+    iptr = (int*)network.getXCBusBuffer(i);
+    if (!network.getActiveBus(i)) *iptr = -1;
+  }
+  for (i=0; i<nbranch; i++) {
+    iptr = (int*)network.getXCBranchBuffer(i);
+    if (!network.getActiveBranch(i)) *iptr = -1;
+  }
+  network.useNeighborExchange(true);
+  network.initBusUpdate();
+  network.initBranchUpdate();
+
+  // Use split-phase updates so that bus and branch exchanges are in flight
+  // at the same time
+  network.beginBusUpdate();
+  network.beginBranchUpdate();
+  network.endBusUpdate();
+  network.endBranchUpdate();
+
+  ok = true;
+  for (i=0; i<nbus; i++) {
+    iptr = (int*)network.getXCBusBuffer(i);
+    if (!network.getActiveBus(i)) {
+      if (*iptr != network.getGlobalBusIndex(i)) {
+        ok = false;
+      }
+    }
+  }
+  for (i=0; i<nbranch; i++) {
+    iptr = (int*)network.getXCBranchBuffer(i);
+    if (!network.getActiveBranch(i)) {
+      if (*iptr != network.getGlobalBranchIndex(i)) {
+        ok = false;
+      }
+    }
+  }
+  oks = (int)ok;
+  ierr = MPI_Allreduce(&oks, &okr, 1, MPI_INT, MPI_PROD, mpi_world);
+  ok = (bool)okr;
+  if (me == 0 && ok) {
+    printf("\nNeighbor bus and branch update ok\n");
+  } else if (!ok) {
+    printf("\nMismatched neighbor update on %d\n",me);
+  }
+  BOOST_CHECK(ok);
+
+  // Time updates using neighbor exchanges
+  double t_nbr = MPI_Wtime();
+  for (i=0; i<nloop; i++) {
+    network.updateBuses();
+    network.updateBranches();
+  }
+  t_nbr = MPI_Wtime() - t_nbr;
+  ierr = MPI_Allreduce(MPI_IN_PLACE, &t_ga, 1, MPI_DOUBLE, MPI_MAX, mpi_world);
+  ierr = MPI_Allreduce(MPI_IN_PLACE, &t_nbr, 1, MPI_DOUBLE, MPI_MAX, mpi_world);
+  if (me == 0) {
+    printf("\nTime for %d updates using global arrays:       %12.6f\n",
+        nloop,t_ga);
+    printf("Time for %d updates using neighbor exchanges: %12.6f\n",
+        nloop,t_nbr);
+  }
+
+  // Test exchanges that only send changed buffers. Modify all locally owned
+  // buses but only flag buses with even global indices as changed. Buses
+  // with global indices divisible by 3 do not track changes and are always
+  // sent. Ghosts of the remaining buses should retain their old values
+  network.useDeltaExchange(true);
+  for (i=0; i<nbus; i++) {
+    network.getBus(i)->setXCChangeTracking(network.getGlobalBusIndex(i)%3 != 0);
+  }
+  network.initBusUpdate();
+  network.updateBuses();
+  for (i=0; i<nbus; i++) {
+    if (network.getActiveBus(i)) {
+      int gidx = network.getGlobalBusIndex(i);
+      iptr = (int*)network.getXCBusBuffer(i);
+      *iptr = gidx + 1;
+      if (gidx%2 == 0) network.setXCBusBufferChanged(i);
+    }
+  }
+  network.updateBuses();
+  ok = true;
+  for (i=0; i<nbus; i++) {
+    iptr = (int*)network.getXCBusBuffer(i);
+    if (!network.getActiveBus(i)) {
+      int gidx = network.getGlobalBusIndex(i);
+      bool sent = (gidx%2 == 0 || gidx%3 == 0);
+      if (sent && *iptr != gidx+1) ok = false;
+      if (!sent && *iptr != gidx) ok = false;
+    }
+  }
+  oks = (int)ok;
+  ierr = MPI_Allreduce(&oks, &okr, 1, MPI_INT, MPI_PROD, mpi_world);
+  ok = (bool)okr;
+  if (me == 0 && ok) {
+    printf("\nDelta bus update ok\n");
+  } else if (!ok) {
+    printf("\nMismatched delta bus update on %d\n",me);
+  }
+  BOOST_CHECK(ok);
+  network.useDeltaExchange(false);
+  network.useNeighborExchange(false);
+
   network.freeXCBus();
   network.freeXCBranch();
 
+  // Sort owned buses into interior and boundary buses. A bus is on the
+  // boundary if it is attached to a ghost branch or if a branch connects it to
+  // a ghost bus. No interior bus can be a ghost on another processor
+  {
+    typedef gridpack::network::BaseNetwork<TestBus, TestBranch> TestNetwork;
+    boost::shared_ptr<TestNetwork> nptr(&network, NoDelete());
+    gridpack::factory::BaseFactory<TestNetwork> factory(nptr);
+    std::vector<int> interior, boundary;
+    factory.getInteriorAndBoundaryBuses(interior, boundary);
+    std::vector<int> ghosted(nbus, 0);
+    for (i=0; i<nbranch; i++) {
+      int n1, n2;
+      network.getBranchEndpoints(i, &n1, &n2);
+      if (!network.getActiveBranch(i) || !network.getActiveBus(n1) ||
+          !network.getActiveBus(n2)) {
+        ghosted[n1] = 1;
+        ghosted[n2] = 1;
+      }
+    }
+    ok = true;
+    std::vector<int> count(nbus, 0);
+    for (i=0; i<interior.size(); i++) {
+      count[interior[i]]++;
+      if (ghosted[interior[i]]) {
+        printf("p[%d] bus %d is next to a ghost but was classified as"
+            " interior\n",me,network.getGlobalBusIndex(interior[i]));
+        ok = false;
+      }
+    }
+    for (i=0; i<boundary.size(); i++) {
+      count[boundary[i]]++;
+      if (!ghosted[boundary[i]]) {
+        printf("p[%d] bus %d is not next to a ghost but was classified as"
+            " boundary\n",me,network.getGlobalBusIndex(boundary[i]));
+        ok = false;
+      }
+    }
+    for (i=0; i<nbus; i++) {
+      int expected = network.getActiveBus(i) ? 1 : 0;
+      if (count[i] != expected) {
+        printf("p[%d] bus %d classified %d times\n",me,
+            network.getGlobalBusIndex(i),count[i]);
+        ok = false;
+      }
+    }
+    // Gather global indices of ghost buses on all processors
+    std::vector<int> ghosts;
+    for (i=0; i<nbus; i++) {
+      if (!network.getActiveBus(i)) ghosts.push_back(network.getGlobalBusIndex(i));
+    }
+    int nghost = ghosts.size();
+    std::vector<int> sizes(nprocs), offsets(nprocs);
+    ierr = MPI_Allgather(&nghost, 1, MPI_INT, &sizes[0], 1, MPI_INT, mpi_world);
+    int total = 0;
+    for (i=0; i<nprocs; i++) {
+      offsets[i] = total;
+      total += sizes[i];
+    }
+    std::vector<int> allGhosts(total+1);
+    ghosts.push_back(0);
+    ierr = MPI_Allgatherv(&ghosts[0], nghost, MPI_INT, &allGhosts[0],
+        &sizes[0], &offsets[0], MPI_INT, mpi_world);
+    std::vector<int> isGhost(XDIM*YDIM, 0);
+    for (i=0; i<total; i++) isGhost[allGhosts[i]] = 1;
+    for (i=0; i<interior.size(); i++) {
+      if (isGhost[network.getGlobalBusIndex(interior[i])]) {
+        printf("p[%d] interior bus %d is a ghost on another processor\n",me,
+            network.getGlobalBusIndex(interior[i]));
+        ok = false;
+      }
+    }
+    oks = (int)ok;
+    ierr = MPI_Allreduce(&oks, &okr, 1, MPI_INT, MPI_PROD, mpi_world);
+    ok = (bool)okr;
+    if (me == 0 && ok) {
+      printf("\nInterior and boundary buses ok\n");
+    } else if (!ok) {
+      printf("\nMismatched interior and boundary buses on %d\n",me);
+    }
+    BOOST_CHECK(ok);
+  }
+
   // Test clean function
   network.clean();
   // Check that total number of remaining buses and branches are as expected
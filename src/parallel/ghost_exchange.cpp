@@ -0,0 +1,471 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   ghost_exchange.cpp
+ * @author agent
+ * @date   2026-10-17
+ *
+ * @brief
+ * Point-to-point exchange of ghost data between neighboring processors.
+ *
+ */
+// -------------------------------------------------------------
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include "gridpack/parallel/ghost_exchange.hpp"
+#include "gridpack/utilities/exception.hpp"
+
+namespace gridpack {
+namespace parallel {
+
+namespace {
+
+/**
+ * Round a byte count up to a multiple of the size of a double so that
+ * message segments and the records that follow the record positions in
+ * delta mode start on aligned addresses
+ * @param nbytes number of bytes
+ * @return aligned number of bytes
+ */
+inline int alignBytes(int nbytes)
+{
+  int align = sizeof(double);
+  return ((nbytes+align-1)/align)*align;
+}
+
+}
+
+// -------------------------------------------------------------
+//  class GhostExchange
+// -------------------------------------------------------------
+
+/**
+ * Default constructor
+ * @param comm communicator over which exchanges take place
+ */
+GhostExchange::GhostExchange(const Communicator &comm)
+  : Distributed(comm), utility::Uncopyable()
+{
+  p_commSet = false;
+  p_size = 0;
+  p_numSend = 0;
+  p_numRecv = 0;
+  p_pending = false;
+  p_delta = false;
+  p_bytesSent = 0;
+}
+
+/**
+ * Default destructor
+ */
+GhostExchange::~GhostExchange(void)
+{
+  p_clear();
+}
+
+/**
+ * Remove any existing communication pattern
+ */
+void GhostExchange::p_clear(void)
+{
+  if (p_pending) {
+    if (p_requests.size() > 0) {
+      MPI_Waitall(p_requests.size(), &p_requests[0], MPI_STATUSES_IGNORE);
+    }
+    p_pending = false;
+  }
+  if (p_commSet) {
+    int finalized;
+    MPI_Finalized(&finalized);
+    if (!finalized) MPI_Comm_free(&p_comm);
+    p_commSet = false;
+  }
+  p_sendProcs.clear();
+  p_sendIndices.clear();
+  p_sendOffsets.clear();
+  p_recvProcs.clear();
+  p_recvIndices.clear();
+  p_recvOffsets.clear();
+  p_sndBuf.clear();
+  p_rcvBuf.clear();
+  p_requests.clear();
+  p_numSend = 0;
+  p_numRecv = 0;
+  p_size = 0;
+}
+
+/**
+ * Map global index to processor that acts as directory for that index
+ * @param idx global index
+ * @return processor rank
+ */
+int GhostExchange::p_directory(int idx) const
+{
+  return idx%(this->communicator().size());
+}
+
+/**
+ * Exchange lists of integers between all processors. This is only used
+ * when setting up the communication pattern.
+ * @param send list of values to be sent to each processor
+ * @param recv list of values received from each processor
+ */
+void GhostExchange::p_allToAll(const std::vector<std::vector<int> > &send,
+    std::vector<std::vector<int> > &recv)
+{
+  int i, j;
+  int nprocs = this->communicator().size();
+  std::vector<int> ndest(nprocs);
+  std::vector<int> nrecv(nprocs);
+  std::vector<int> s_offsets(nprocs);
+  std::vector<int> r_offsets(nprocs);
+  int ssize = 0;
+  for (i=0; i<nprocs; i++) {
+    ndest[i] = send[i].size();
+    s_offsets[i] = ssize;
+    ssize += ndest[i];
+  }
+  MPI_Alltoall(&ndest[0], 1, MPI_INT, &nrecv[0], 1, MPI_INT, p_comm);
+  int rsize = 0;
+  for (i=0; i<nprocs; i++) {
+    r_offsets[i] = rsize;
+    rsize += nrecv[i];
+  }
+  // Pack values into a single buffer. Add an extra element so that buffers
+  // are never of zero length
+  std::vector<int> sbuf(ssize+1);
+  std::vector<int> rbuf(rsize+1);
+  for (i=0; i<nprocs; i++) {
+    for (j=0; j<ndest[i]; j++) {
+      sbuf[s_offsets[i]+j] = send[i][j];
+    }
+  }
+  MPI_Alltoallv(&sbuf[0], &ndest[0], &s_offsets[0], MPI_INT,
+      &rbuf[0], &nrecv[0], &r_offsets[0], MPI_INT, p_comm);
+  recv.clear();
+  recv.resize(nprocs);
+  for (i=0; i<nprocs; i++) {
+    for (j=0; j<nrecv[i]; j++) {
+      recv[i].push_back(rbuf[r_offsets[i]+j]);
+    }
+  }
+}
+
+/**
+ * Set up communication pattern for exchanges. This is a collective
+ * operation.
+ * @param global_idx global indices of all local elements
+ * @param active flags identifying locally owned elements
+ * @param size size (in bytes) of data exchanged for each element
+ */
+void GhostExchange::setup(const std::vector<int> &global_idx,
+    const std::vector<bool> &active, int size)
+{
+  int i, j, idx;
+  p_clear();
+  MPI_Comm_dup(static_cast<MPI_Comm>(this->communicator()), &p_comm);
+  p_commSet = true;
+  p_size = size;
+  int nprocs = this->communicator().size();
+  int me = this->communicator().rank();
+  int nelem = global_idx.size();
+
+  // Register owners of all active elements with the directory processors
+  std::vector<std::vector<int> > send(nprocs);
+  std::vector<std::vector<int> > recv;
+  std::map<int,int> localIndex;
+  for (i=0; i<nelem; i++) {
+    if (active[i]) {
+      idx = global_idx[i];
+      send[p_directory(idx)].push_back(idx);
+      localIndex.insert(std::pair<int,int>(idx,i));
+    }
+  }
+  p_allToAll(send,recv);
+  std::map<int,int> owner;
+  for (i=0; i<nprocs; i++) {
+    for (j=0; j<recv[i].size(); j++) {
+      owner.insert(std::pair<int,int>(recv[i][j],i));
+    }
+  }
+
+  // Query directory processors for the owners of ghost elements
+  std::vector<std::vector<int> > ghosts(nprocs);
+  for (i=0; i<nprocs; i++) send[i].clear();
+  for (i=0; i<nelem; i++) {
+    if (!active[i]) {
+      idx = global_idx[i];
+      send[p_directory(idx)].push_back(idx);
+      ghosts[p_directory(idx)].push_back(i);
+    }
+  }
+  p_allToAll(send,recv);
+  std::map<int,int>::iterator it;
+  for (i=0; i<nprocs; i++) {
+    send[i].clear();
+    for (j=0; j<recv[i].size(); j++) {
+      it = owner.find(recv[i][j]);
+      if (it != owner.end()) {
+        send[i].push_back(it->second);
+      } else {
+        send[i].push_back(-1);
+      }
+    }
+  }
+  std::vector<std::vector<int> > owners;
+  p_allToAll(send,owners);
+
+  // Sort ghost elements by owner and send requests to owners
+  std::vector<std::vector<int> > recvIndices(nprocs);
+  for (i=0; i<nprocs; i++) send[i].clear();
+  for (i=0; i<nprocs; i++) {
+    for (j=0; j<ghosts[i].size(); j++) {
+      int proc = owners[i][j];
+      if (proc < 0) {
+        char buf[256];
+        sprintf(buf,"GhostExchange::setup: p[%d] no owner found for index: %d\n",
+            me,global_idx[ghosts[i][j]]);
+        throw gridpack::Exception(buf);
+      }
+      send[proc].push_back(global_idx[ghosts[i][j]]);
+      recvIndices[proc].push_back(ghosts[i][j]);
+    }
+  }
+  p_allToAll(send,recv);
+
+  // Construct send and receive lists for neighboring processors. Buffer
+  // offsets are in bytes, are aligned and leave enough room for the record
+  // count and positions that are sent in delta mode
+  int nbytes = 0;
+  p_numRecv = 0;
+  for (i=0; i<nprocs; i++) {
+    if (recvIndices[i].size() > 0) {
+      p_recvProcs.push_back(i);
+      p_recvIndices.push_back(recvIndices[i]);
+      p_recvOffsets.push_back(nbytes);
+      p_numRecv += recvIndices[i].size();
+      nbytes += alignBytes((recvIndices[i].size()+1)*sizeof(int))
+        + alignBytes(recvIndices[i].size()*p_size);
+    }
+  }
+  p_rcvBuf.resize(nbytes);
+  nbytes = 0;
+  p_numSend = 0;
+  for (i=0; i<nprocs; i++) {
+    if (recv[i].size() > 0) {
+      std::vector<int> list;
+      for (j=0; j<recv[i].size(); j++) {
+        it = localIndex.find(recv[i][j]);
+        if (it == localIndex.end()) {
+          char buf[256];
+          sprintf(buf,"GhostExchange::setup: p[%d] index %d not owned locally\n",
+              me,recv[i][j]);
+          throw gridpack::Exception(buf);
+        }
+        list.push_back(it->second);
+      }
+      p_sendProcs.push_back(i);
+      p_sendIndices.push_back(list);
+      p_sendOffsets.push_back(nbytes);
+      p_numSend += list.size();
+      nbytes += alignBytes((list.size()+1)*sizeof(int))
+        + alignBytes(list.size()*p_size);
+    }
+  }
+  p_sndBuf.resize(nbytes);
+  p_requests.resize(p_sendProcs.size()+p_recvProcs.size());
+}
+
+/**
+ * Copy data from locally owned elements to ghost elements on neighboring
+ * processors.
+ * @param buffers array of pointers to exchange buffers of all local
+ *        elements (indexed by local element index)
+ * @param changed flags (indexed by local element index) that are nonzero
+ *        for elements whose data has changed since the last exchange. Only
+ *        used if delta mode is on
+ */
+void GhostExchange::exchange(void **buffers, const char *changed)
+{
+  begin(buffers, changed);
+  end(buffers);
+}
+
+/**
+ * Start an exchange. Data from locally owned elements is copied into send
+ * buffers and messages are posted
+ * @param buffers array of pointers to exchange buffers of all local
+ *        elements (indexed by local element index)
+ * @param changed flags (indexed by local element index) that are nonzero
+ *        for elements whose data has changed since the last exchange. Only
+ *        used if delta mode is on
+ */
+void GhostExchange::begin(void **buffers, const char *changed)
+{
+  if (!p_commSet) {
+    throw gridpack::Exception("GhostExchange::begin: setup not called");
+  }
+  if (p_pending) {
+    throw gridpack::Exception("GhostExchange::begin: exchange already in progress");
+  }
+  int i, j, nsize, nbytes;
+  char *ptr;
+  int nreq = 0;
+  bool delta = p_delta && changed != NULL;
+  // Post receives first
+  for (i=0; i<p_recvProcs.size(); i++) {
+    nsize = p_recvIndices[i].size();
+    if (p_delta) {
+      nbytes = alignBytes((nsize+1)*sizeof(int)) + nsize*p_size;
+    } else {
+      nbytes = nsize*p_size;
+    }
+    ptr = &p_rcvBuf[0] + p_recvOffsets[i];
+    MPI_Irecv(ptr, nbytes, MPI_CHAR, p_recvProcs[i], 0, p_comm,
+        &p_requests[nreq]);
+    nreq++;
+  }
+  // Pack data for each neighbor and send it
+  p_bytesSent = 0;
+  for (i=0; i<p_sendProcs.size(); i++) {
+    const std::vector<int> &list = p_sendIndices[i];
+    nsize = list.size();
+    ptr = &p_sndBuf[0] + p_sendOffsets[i];
+    if (p_delta) {
+      // Message consists of the number of records, the positions of the
+      // records in the list of elements shared with the neighbor and the
+      // records themselves. The records start on an aligned offset
+      int ncnt = 0;
+      for (j=0; j<nsize; j++) {
+        if (!delta || changed[list[j]]) ncnt++;
+      }
+      int *iptr = reinterpret_cast<int*>(ptr);
+      char *rptr = ptr + alignBytes((ncnt+1)*sizeof(int));
+      iptr[0] = ncnt;
+      ncnt = 0;
+      for (j=0; j<nsize; j++) {
+        if (!delta || changed[list[j]]) {
+          iptr[ncnt+1] = j;
+          memcpy(rptr+ncnt*p_size, buffers[list[j]], p_size);
+          ncnt++;
+        }
+      }
+      nbytes = alignBytes((ncnt+1)*sizeof(int)) + ncnt*p_size;
+    } else {
+      for (j=0; j<nsize; j++) {
+        memcpy(ptr+j*p_size, buffers[list[j]], p_size);
+      }
+      nbytes = nsize*p_size;
+    }
+    MPI_Isend(ptr, nbytes, MPI_CHAR, p_sendProcs[i], 0, p_comm,
+        &p_requests[nreq]);
+    p_bytesSent += nbytes;
+    nreq++;
+  }
+  p_pending = true;
+}
+
+/**
+ * Complete an exchange started with begin and copy received data into
+ * ghost buffers
+ * @param buffers array of pointers to exchange buffers of all local
+ *        elements (indexed by local element index)
+ */
+void GhostExchange::end(void **buffers)
+{
+  if (!p_pending) {
+    throw gridpack::Exception("GhostExchange::end: no exchange in progress");
+  }
+  int i, j, nsize;
+  char *ptr;
+  int nreq = p_requests.size();
+  if (nreq > 0) {
+    MPI_Waitall(nreq, &p_requests[0], MPI_STATUSES_IGNORE);
+  }
+  p_pending = false;
+  // Copy received data into ghost buffers
+  for (i=0; i<p_recvProcs.size(); i++) {
+    const std::vector<int> &list = p_recvIndices[i];
+    ptr = &p_rcvBuf[0] + p_recvOffsets[i];
+    if (p_delta) {
+      int *iptr = reinterpret_cast<int*>(ptr);
+      nsize = iptr[0];
+      char *rptr = ptr + alignBytes((nsize+1)*sizeof(int));
+      for (j=0; j<nsize; j++) {
+        memcpy(buffers[list[iptr[j+1]]], rptr+j*p_size, p_size);
+      }
+    } else {
+      nsize = list.size();
+      for (j=0; j<nsize; j++) {
+        memcpy(buffers[list[j]], ptr+j*p_size, p_size);
+      }
+    }
+  }
+}
+
+/**
+ * Only send data for elements that have changed since the last exchange.
+ * This must be set to the same value on all processors
+ * @param flag if true, only exchange elements that are flagged as changed
+ */
+void GhostExchange::setDeltaMode(bool flag)
+{
+  if (p_pending) {
+    throw gridpack::Exception("GhostExchange::setDeltaMode: exchange in progress");
+  }
+  p_delta = flag;
+}
+
+/**
+ * Number of bytes sent by this processor in the most recent exchange
+ * @return number of bytes
+ */
+long GhostExchange::bytesSent(void) const
+{
+  return p_bytesSent;
+}
+
+/**
+ * Is there an exchange that has been started but not completed
+ * @return true if begin has been called without a matching end
+ */
+bool GhostExchange::pending(void) const
+{
+  return p_pending;
+}
+
+/**
+ * Number of processors that this processor sends data to
+ * @return number of neighbors
+ */
+int GhostExchange::numSendNeighbors(void) const
+{
+  return p_sendProcs.size();
+}
+
+/**
+ * Number of processors that this processor receives data from
+ * @return number of neighbors
+ */
+int GhostExchange::numRecvNeighbors(void) const
+{
+  return p_recvProcs.size();
+}
+
+/**
+ * Has setup been called for this exchange
+ * @return true if communication pattern has been constructed
+ */
+bool GhostExchange::isSetup(void) const
+{
+  return p_commSet;
+}
+
+} // namespace parallel
+} // namespace gridpack
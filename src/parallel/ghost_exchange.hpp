@@ -0,0 +1,199 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   ghost_exchange.hpp
+ * @author agent
+ * @date   2026-10-17
+ *
+ * @brief
+ * Point-to-point exchange of ghost data between neighboring processors. The
+ * communication pattern is constructed once by a collective setup call and
+ * each subsequent exchange only involves messages between processors that
+ * actually share ghost elements. No global synchronization is required for
+ * an exchange.
+ *
+ */
+// -------------------------------------------------------------
+
+#ifndef _ghost_exchange_hpp_
+#define _ghost_exchange_hpp_
+
+#include <vector>
+#include "gridpack/parallel/distributed.hpp"
+#include "gridpack/utilities/uncopyable.hpp"
+
+namespace gridpack {
+namespace parallel {
+
+// -------------------------------------------------------------
+//  class GhostExchange
+// -------------------------------------------------------------
+class GhostExchange
+  : public Distributed,
+    private utility::Uncopyable
+{
+public:
+
+  /**
+   * Default constructor
+   * @param comm communicator over which exchanges take place
+   */
+  explicit GhostExchange(const Communicator &comm);
+
+  /**
+   * Default destructor
+   */
+  ~GhostExchange(void);
+
+  /**
+   * Set up communication pattern for exchanges. This is a collective
+   * operation. Each element has a unique global index and is owned (active)
+   * on exactly one processor. Inactive elements are ghosts that receive data
+   * from the owning processor during an exchange.
+   * @param global_idx global indices of all local elements
+   * @param active flags identifying locally owned elements
+   * @param size size (in bytes) of data exchanged for each element
+   */
+  void setup(const std::vector<int> &global_idx,
+      const std::vector<bool> &active, int size);
+
+  /**
+   * Copy data from locally owned elements to ghost elements on neighboring
+   * processors. This only involves communication with neighboring processors
+   * @param buffers array of pointers to exchange buffers of all local
+   *        elements (indexed by local element index)
+   * @param changed flags (indexed by local element index) that are nonzero
+   *        for elements whose data has changed since the last exchange. Only
+   *        used if delta mode is on
+   */
+  void exchange(void **buffers, const char *changed = NULL);
+
+  /**
+   * Start an exchange. Data from locally owned elements is copied into send
+   * buffers and messages are posted, but this call does not wait for
+   * messages from other processors to arrive. Ghost buffers must not be
+   * accessed until end has been called
+   * @param buffers array of pointers to exchange buffers of all local
+   *        elements (indexed by local element index)
+   * @param changed flags (indexed by local element index) that are nonzero
+   *        for elements whose data has changed since the last exchange. Only
+   *        used if delta mode is on
+   */
+  void begin(void **buffers, const char *changed = NULL);
+
+  /**
+   * Complete an exchange started with begin and copy received data into
+   * ghost buffers
+   * @param buffers array of pointers to exchange buffers of all local
+   *        elements (indexed by local element index)
+   */
+  void end(void **buffers);
+
+  /**
+   * Is there an exchange that has been started but not completed
+   * @return true if begin has been called without a matching end
+   */
+  bool pending(void) const;
+
+  /**
+   * Only send data for elements that have changed since the last exchange.
+   * Each message then contains the number of changed records and their
+   * positions in addition to the records themselves. This must be set to
+   * the same value on all processors
+   * @param flag if true, only exchange elements that are flagged as changed
+   */
+  void setDeltaMode(bool flag);
+
+  /**
+   * Number of bytes sent by this processor in the most recent exchange
+   * @return number of bytes
+   */
+  long bytesSent(void) const;
+
+  /**
+   * Number of processors that this processor sends data to
+   * @return number of neighbors
+   */
+  int numSendNeighbors(void) const;
+
+  /**
+   * Number of processors that this processor receives data from
+   * @return number of neighbors
+   */
+  int numRecvNeighbors(void) const;
+
+  /**
+   * Has setup been called for this exchange
+   * @return true if communication pattern has been constructed
+   */
+  bool isSetup(void) const;
+
+private:
+
+  /**
+   * Exchange lists of integers between all processors. This is only used
+   * when setting up the communication pattern.
+   * @param send list of values to be sent to each processor
+   * @param recv list of values received from each processor
+   */
+  void p_allToAll(const std::vector<std::vector<int> > &send,
+      std::vector<std::vector<int> > &recv);
+
+  /**
+   * Map global index to processor that acts as directory for that index
+   * @param idx global index
+   * @return processor rank
+   */
+  int p_directory(int idx) const;
+
+  /**
+   * Remove any existing communication pattern
+   */
+  void p_clear(void);
+
+  // private communicator so that exchanges do not collide with other
+  // messages on the original communicator
+  MPI_Comm p_comm;
+  bool p_commSet;
+
+  // size (in bytes) of data for each element
+  int p_size;
+
+  // processors that this processor sends data to, local indices of elements
+  // that are sent to each processor and offsets (in bytes) into send buffer
+  std::vector<int> p_sendProcs;
+  std::vector<std::vector<int> > p_sendIndices;
+  std::vector<int> p_sendOffsets;
+  int p_numSend;
+
+  // processors that this processor receives data from, local indices of
+  // ghost elements that are received from each processor and offsets (in
+  // bytes) into receive buffer
+  std::vector<int> p_recvProcs;
+  std::vector<std::vector<int> > p_recvIndices;
+  std::vector<int> p_recvOffsets;
+  int p_numRecv;
+
+  // contiguous send and receive buffers
+  std::vector<char> p_sndBuf;
+  std::vector<char> p_rcvBuf;
+
+  // outstanding requests
+  std::vector<MPI_Request> p_requests;
+  bool p_pending;
+
+  // only exchange elements that have changed
+  bool p_delta;
+
+  // bytes sent in most recent exchange
+  long p_bytesSent;
+};
+
+} // namespace parallel
+} // namespace gridpack
+
+#endif
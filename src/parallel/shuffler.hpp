@@ -27,11 +27,17 @@
 #include <iostream>
 #include <vector>
 #include <utility>
+#include <cstring>
+#include <cstdio>
+#include <climits>
 #include <boost/mpi.hpp>
 #include <boost/serialization/vector.hpp>
 #include <boost/serialization/utility.hpp>
+#include <boost/type_traits/is_pod.hpp>
+#include <boost/type_traits/integral_constant.hpp>
 
 #include "gridpack/parallel/distributed.hpp"
+#include "gridpack/utilities/exception.hpp"
 
 #ifndef _shuffler_hpp_
 #define _shuffler_hpp_
@@ -50,7 +56,13 @@ namespace parallel {
  * thing.  After execution, each process will contain a vector of the
  * things assigned to it.
  *
- * This uses blocking send/receive.  
+ * The things for each destination are packed into a single buffer and
+ * exchanged with one MPI_Alltoall of the buffer sizes followed by one
+ * MPI_Alltoallv of the buffers. Things that are plain old data are copied
+ * directly into the buffer; all other things are serialized.
+ *
+ * On each process, the things that were already local come first, followed
+ * by the things received from each of the other processes in rank order.
  *
  * The things redistributed must be copy constructable and serializable.  
  * 
@@ -84,52 +96,39 @@ public:
 
     if (comm.size() <= 1) return;
 
-    size_t nthings(0);
-    all_reduce(comm, locthings.size(), nthings, std::plus<size_t>());
-    if (nthings <= 0) return;
-
-    // save the original list of local things 
+    std::vector<ThingVector> tosend(comm.size());
+    p_sort(locthings, destproc, tosend);
 
-    ThingVector tvect(locthings); 
-    locthings.clear();
+    p_exchange(locthings, tosend, boost::is_pod<Thing>());
+  }
 
-    // Work on each processors list of things separately
+  /// Redistribute using a separate exchange for each source process
+  /**
+   * This is the original implementation, which uses one MPI_Allreduce
+   * of the message sizes and blocking send/receive for each source
+   * process. It is retained for comparison and produces the same
+   * result as operator().
+   */
+  void bySource(ThingVector& locthings, const IndexVector& destproc)
+  {
+    BOOST_ASSERT(locthings.size() == destproc.size());
 
-    std::vector<ThingVector> tosend(comm.size());
+    const boost::mpi::communicator& comm(this->communicator());
 
-    // all processes go through the destinations and makes a vector to
-    // send to each of the other processes
+    if (comm.size() <= 1) return;
 
-    size_t locidx(0);
+    size_t nthings(0);
+    all_reduce(comm, locthings.size(), nthings, std::plus<size_t>());
+    if (nthings <= 0) return;
 
-    for (typename IndexVector::const_iterator dest = destproc.begin(); 
-         dest != destproc.end(); ++dest) {
-      if (*dest == comm.rank()) {
-        locthings.push_back(tvect[locidx]);
-      } else {
-        tosend[*dest].push_back(tvect[locidx]);
-      }
-      locidx += 1;
-    }
+    std::vector<ThingVector> tosend(comm.size());
+    p_sort(locthings, destproc, tosend);
 
-#if 0
-    for (int src = 0; src < comm.size(); ++src) {
-      ThingVector tmp;
-      if (comm.rank() == src) {
-        scatter(comm, tosend, tmp, src);
-      } else {
-        scatter(comm, tmp, src);
-      }
-      std::copy(tmp.begin(), tmp.end(), std::back_inserter(locthings));
-    }
-  }
-#else
     int me = comm.rank();
     int nprocs = comm.size();
     for (int src = 0; src < nprocs; ++src) {
       // Don't send messages of zero size. Exchange sizes with all processors
       // first
-      //printf("p[%d] Got to 1\n",me);
       std::vector<int> srcsizes(nprocs);
       std::vector<int> tsizes(nprocs);
       for (int i = 0; i<nprocs; i++) {
@@ -146,28 +145,167 @@ public:
         // FIXME: throw
       }
       //create receive buffer
-     // printf("p[%d] Got to 2\n",me);
       ThingVector tmp;
       if (me == src) {
         for (int i=0; i<nprocs; i++) {
           if (i == me) {
-            //printf("p[%d] Got to 2\n",me);
             tmp = tosend[i];
           } else {
-            //printf("p[%d] Got to 3 size: %d send to: %d\n",me,tsizes[i],i);
             if (tsizes[i] > 0) 
               static_cast<boost::mpi::communicator>(comm).send(i,src,tosend[i]);
           }
         }
       } else {
-            //printf("p[%d] Got to 4 size: %d recieve from: %d\n",me,tsizes[me],src);
         if (tsizes[me] > 0) 
           static_cast<boost::mpi::communicator>(comm).recv(src,src,tmp);
       }
       std::copy(tmp.begin(), tmp.end(), std::back_inserter(locthings));
     }
   }
-#endif
+
+private:
+
+  /// Keep local things and sort the rest by destination process
+  void p_sort(ThingVector& locthings, const IndexVector& destproc,
+              std::vector<ThingVector>& tosend)
+  {
+    int me(this->processor_rank());
+
+    // save the original list of local things 
+
+    ThingVector tvect;
+    tvect.swap(locthings);
+
+    // all processes go through the destinations and makes a vector to
+    // send to each of the other processes
+
+    size_t locidx(0);
+
+    for (typename IndexVector::const_iterator dest = destproc.begin(); 
+         dest != destproc.end(); ++dest) {
+      if (*dest == me) {
+        locthings.push_back(tvect[locidx]);
+      } else {
+        tosend[*dest].push_back(tvect[locidx]);
+      }
+      locidx += 1;
+    }
+  }
+
+  /// Exchange buffer sizes and buffers between all processes
+  /**
+   * @param sendbuf buffers for each process stored contiguously
+   * @param sendcounts number of bytes sent to each process
+   * @param recvbuf buffers received from each process
+   * @param recvcounts number of bytes received from each process
+   * @param recvdispls offset of each received buffer in recvbuf
+   */
+  void p_alltoallv(std::vector<char>& sendbuf,
+                   const std::vector<size_t>& sendcounts,
+                   std::vector<char>& recvbuf,
+                   std::vector<int>& recvcounts,
+                   std::vector<int>& recvdispls)
+  {
+    MPI_Comm comm(static_cast<MPI_Comm>(this->communicator()));
+    int nprocs(this->processor_size());
+    std::vector<int> scounts(nprocs), sdispls(nprocs);
+    size_t total(0);
+    int p;
+    for (p = 0; p < nprocs; ++p) {
+      scounts[p] = static_cast<int>(sendcounts[p]);
+      sdispls[p] = static_cast<int>(total);
+      total += sendcounts[p];
+    }
+    int ok(total <= static_cast<size_t>(INT_MAX) ? 1 : 0), allok;
+    recvcounts.resize(nprocs);
+    recvdispls.resize(nprocs);
+    MPI_Alltoall(&scounts[0], 1, MPI_INT, &recvcounts[0], 1, MPI_INT, comm);
+    total = 0;
+    for (p = 0; p < nprocs; ++p) {
+      recvdispls[p] = static_cast<int>(total);
+      total += recvcounts[p];
+    }
+    if (total > static_cast<size_t>(INT_MAX)) ok = 0;
+    MPI_Allreduce(&ok, &allok, 1, MPI_INT, MPI_MIN, comm);
+    if (!allok) {
+      char buf[256];
+      sprintf(buf,"Shuffler: more than %d bytes sent to or received by"
+          " a process\n",INT_MAX);
+      throw gridpack::Exception(buf);
+    }
+    recvbuf.resize(total+1);
+    sendbuf.push_back('\0');
+    MPI_Alltoallv(&sendbuf[0], &scounts[0], &sdispls[0], MPI_BYTE,
+                  &recvbuf[0], &recvcounts[0], &recvdispls[0], MPI_BYTE, comm);
+  }
+
+  /// Exchange things that are plain old data by copying them directly
+  void p_exchange(ThingVector& locthings, std::vector<ThingVector>& tosend,
+                  const boost::true_type&)
+  {
+    int nprocs(this->processor_size());
+    std::vector<size_t> sendcounts(nprocs);
+    size_t total(0);
+    int p;
+    for (p = 0; p < nprocs; ++p) {
+      sendcounts[p] = tosend[p].size()*sizeof(Thing);
+      total += sendcounts[p];
+    }
+    std::vector<char> sendbuf;
+    sendbuf.reserve(total+1);
+    for (p = 0; p < nprocs; ++p) {
+      if (tosend[p].size() > 0) {
+        const char *first = reinterpret_cast<const char*>(&tosend[p][0]);
+        sendbuf.insert(sendbuf.end(), first, first+sendcounts[p]);
+      }
+      ThingVector().swap(tosend[p]);
+    }
+    std::vector<char> recvbuf;
+    std::vector<int> recvcounts, recvdispls;
+    p_alltoallv(sendbuf, sendcounts, recvbuf, recvcounts, recvdispls);
+    size_t nrecv(0);
+    for (p = 0; p < nprocs; ++p) nrecv += recvcounts[p]/sizeof(Thing);
+    size_t nlocal(locthings.size());
+    locthings.resize(nlocal+nrecv);
+    if (nrecv > 0) {
+      std::memcpy(&locthings[nlocal], &recvbuf[0], nrecv*sizeof(Thing));
+    }
+  }
+
+  /// Exchange things by serializing them
+  void p_exchange(ThingVector& locthings, std::vector<ThingVector>& tosend,
+                  const boost::false_type&)
+  {
+    const boost::mpi::communicator& comm(this->communicator());
+    int nprocs(this->processor_size());
+    std::vector<size_t> sendcounts(nprocs, 0);
+    std::vector<char> sendbuf;
+    int p;
+    for (p = 0; p < nprocs; ++p) {
+      if (tosend[p].size() > 0) {
+        boost::mpi::packed_oarchive oarch(comm);
+        oarch << tosend[p];
+        const char *first = static_cast<const char*>(oarch.address());
+        sendbuf.insert(sendbuf.end(), first, first+oarch.size());
+        sendcounts[p] = oarch.size();
+        ThingVector().swap(tosend[p]);
+      }
+    }
+    std::vector<char> recvbuf;
+    std::vector<int> recvcounts, recvdispls;
+    p_alltoallv(sendbuf, sendcounts, recvbuf, recvcounts, recvdispls);
+    std::vector<char>().swap(sendbuf);
+    for (p = 0; p < nprocs; ++p) {
+      if (recvcounts[p] > 0) {
+        boost::mpi::packed_iarchive iarch(comm);
+        iarch.resize(recvcounts[p]);
+        std::memcpy(iarch.address(), &recvbuf[recvdispls[p]], recvcounts[p]);
+        ThingVector tmp;
+        iarch >> tmp;
+        std::copy(tmp.begin(), tmp.end(), std::back_inserter(locthings));
+      }
+    }
+  }
 
 };
 
@@ -0,0 +1,141 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   shuffle_benchmark.cpp
+ * @author agent
+ * @date   2026-10-17
+ *
+ * @brief
+ * Measure the time needed to redistribute things between processors using
+ * Shuffler (single MPI_Alltoallv), the original source-by-source exchange
+ * (Shuffler::bySource) and gaShuffler. Each processor starts with the same
+ * number of things and sends each of them to a randomly chosen processor.
+ * Integers use the plain old data path in Shuffler and strings use the
+ * serialized path.
+ *
+ * Usage: shuffle_benchmark [things per processor] [repeats] [skip ga]
+ * If a third argument is given, gaShuffler is not timed (it prints a line
+ * for every pair of processors, which is impractical on many processors).
+ *
+ */
+// -------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <boost/serialization/string.hpp>
+#include "mpi.h"
+
+#include "gridpack/parallel/shuffler.hpp"
+#include "gridpack/parallel/ga_shuffler.hpp"
+#include "gridpack/environment/environment.hpp"
+
+#define NTHINGS 10000
+#define NREPEAT 5
+
+// Create things to be redistributed
+int makeThing(int idx, int)
+{
+  return idx;
+}
+
+std::string makeThing(int idx, const std::string&)
+{
+  return std::string(idx%20+1, 'A'+idx%26);
+}
+
+// Time each method for one type of thing. Returns false if the methods do
+// not move the same number of things
+template <typename Thing>
+bool benchmark(const gridpack::parallel::Communicator &world,
+    const char *name, int nthings, int nrepeat, bool use_ga)
+{
+  int me = world.rank();
+  int nprocs = world.size();
+  std::vector<Thing> things;
+  std::vector<int> dest;
+  int i, k;
+  srand(1234+me);
+  for (i=0; i<nthings; i++) {
+    things.push_back(makeThing(me*nthings+i, Thing()));
+    dest.push_back(rand()%nprocs);
+  }
+
+  gridpack::parallel::Shuffler<Thing> shuffle(world);
+  gridpack::parallel::gaShuffler<Thing> ga_shuffle(world);
+  double time[3] = {0.0, 0.0, 0.0};
+  long count[3] = {0, 0, 0};
+  for (k=0; k<nrepeat; k++) {
+    std::vector<Thing> tmp(things);
+    world.barrier();
+    double t0 = MPI_Wtime();
+    shuffle(tmp, dest);
+    time[0] += MPI_Wtime()-t0;
+    count[0] = tmp.size();
+
+    tmp = things;
+    world.barrier();
+    t0 = MPI_Wtime();
+    shuffle.bySource(tmp, dest);
+    time[1] += MPI_Wtime()-t0;
+    count[1] = tmp.size();
+
+    if (use_ga) {
+      tmp = things;
+      world.barrier();
+      t0 = MPI_Wtime();
+      ga_shuffle(tmp, dest);
+      time[2] += MPI_Wtime()-t0;
+      count[2] = tmp.size();
+    }
+  }
+
+  // Report slowest processor
+  double tmax[3];
+  MPI_Reduce(time, tmax, 3, MPI_DOUBLE, MPI_MAX, 0,
+      static_cast<MPI_Comm>(world));
+  int ok = (count[0] == count[1] && (!use_ga || count[0] == count[2]));
+  int allok;
+  MPI_Allreduce(&ok, &allok, 1, MPI_INT, MPI_MIN,
+      static_cast<MPI_Comm>(world));
+  if (me == 0) {
+    for (i=0; i<3; i++) tmax[i] /= static_cast<double>(nrepeat);
+    if (use_ga) {
+      printf("%-8s %6d %10d %12.6f %12.6f %12.6f %8.2f\n", name, nprocs,
+          nthings, tmax[0], tmax[1], tmax[2], tmax[1]/tmax[0]);
+    } else {
+      printf("%-8s %6d %10d %12.6f %12.6f %12s %8.2f\n", name, nprocs,
+          nthings, tmax[0], tmax[1], "-", tmax[1]/tmax[0]);
+    }
+    if (!allok) printf("  Mismatch in number of things received\n");
+  }
+  return allok;
+}
+
+int main(int argc, char **argv)
+{
+  gridpack::Environment env(argc, argv);
+  int ret = 0;
+  if (1) {
+    gridpack::parallel::Communicator world;
+    int nthings = NTHINGS;
+    int nrepeat = NREPEAT;
+    if (argc > 1) nthings = atoi(argv[1]);
+    if (argc > 2) nrepeat = atoi(argv[2]);
+    bool use_ga = (argc <= 3);
+    if (nrepeat < 1) nrepeat = 1;
+    if (world.rank() == 0) {
+      printf("%-8s %6s %10s %12s %12s %12s %8s\n", "Type", "Procs",
+          "Things", "Alltoallv", "bySource", "gaShuffler", "Speedup");
+    }
+    if (!benchmark<int>(world, "int", nthings, nrepeat, use_ga)) ret = 1;
+    if (!benchmark<std::string>(world, "string", nthings, nrepeat, use_ga))
+      ret = 1;
+  }
+  return ret;
+}
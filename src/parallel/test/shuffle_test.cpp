@@ -63,6 +63,12 @@ operator<<(std::ostream& out, const Tester& t)
   return out;
 }
 
+bool
+operator==(const Tester& a, const Tester& b)
+{
+  return a.index == b.index && a.label == b.label;
+}
+
 BOOST_AUTO_TEST_SUITE ( shuffler ) 
 
 BOOST_AUTO_TEST_CASE( int_shuffle )
@@ -183,6 +189,55 @@ BOOST_AUTO_TEST_CASE( multi_tester_shuffle )
     
 }
 
+// Shuffler and the original source-by-source exchange must produce the
+// same things in the same order on every process
+template <typename Thing>
+void
+compare_methods(const gridpack::parallel::Communicator& comm,
+                const std::vector<Thing>& things)
+{
+  std::vector<int> dest;
+  for (size_t i = 0; i < things.size(); ++i) {
+    dest.push_back((3*i + comm.rank()) % comm.size());
+  }
+  std::vector<Thing> a(things), b(things);
+  gridpack::parallel::Shuffler<Thing> shuffle(comm);
+  shuffle(a, dest);
+  shuffle.bySource(b, dest);
+  BOOST_CHECK_EQUAL(a.size(), b.size());
+  for (size_t i = 0; i < a.size() && i < b.size(); ++i) {
+    BOOST_CHECK(a[i] == b[i]);
+  }
+  int nlocal(a.size()), nglobal;
+  int nsent(things.size()), nsentall;
+  boost::mpi::all_reduce(boost::mpi::communicator(comm), nlocal, nglobal,
+                         std::plus<int>());
+  boost::mpi::all_reduce(boost::mpi::communicator(comm), nsent, nsentall,
+                         std::plus<int>());
+  BOOST_CHECK_EQUAL(nglobal, nsentall);
+}
+
+BOOST_AUTO_TEST_CASE( compare_shuffle )
+{
+  gridpack::parallel::Communicator comm;
+  const int local_size(7 + comm.rank());
+  std::vector<int> ithings;
+  std::vector<std::string> sthings;
+  std::vector<Tester> tthings;
+  for (int i = 0; i < local_size; ++i) {
+    int idx(100*comm.rank() + i);
+    ithings.push_back(idx);
+    sthings.push_back(boost::lexical_cast<std::string>(idx));
+    tthings.push_back(Tester(idx));
+  }
+  compare_methods(comm, ithings);
+  compare_methods(comm, sthings);
+  compare_methods(comm, tthings);
+
+  // nothing to move on any process
+  compare_methods(comm, std::vector<int>());
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 BOOST_AUTO_TEST_SUITE( gaShufflerTest )
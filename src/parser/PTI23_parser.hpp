@@ -23,6 +23,7 @@
 
 #include "gridpack/utilities/exception.hpp"
 #include "gridpack/timer/coarse_timer.hpp"
+#include "gridpack/stream/input_stream.hpp"
 #include "gridpack/parser/dictionary.hpp"
 #include "gridpack/network/base_network.hpp"
 #include "gridpack/parser/base_parser.hpp"
@@ -112,9 +113,8 @@ class PTI23_parser : public BasePTIParser<_network>
       p_case_id = 0;
       p_case_sbase = 0.0;
       if (me == 0) {
-        std::ifstream            input;
-        input.open(fileName.c_str());
-        if (!input.is_open()) {
+        gridpack::stream::InputStream input;
+        if (!input.openFile(fileName)) {
           char buf[512];
           sprintf(buf,"Failed to open network configuration file: %s\n\n",
               fileName.c_str());
@@ -186,18 +186,20 @@ class PTI23_parser : public BasePTIParser<_network>
       p_network_data = p_network->getNetworkData();
     }
 
-    void find_case(std::ifstream & input)
+    void find_case(gridpack::stream::InputStream & input)
     {
       //      data_set                                           case_set;
-      std::string                                        line;
+      const char *ptr;
+      int len;
       //      std::vector<gridpack::component::DataCollection>   case_instance;
 
       //      gridpack::component::DataCollection                data;
 
-      std::getline(input, line);
-      while (check_comment(line)) {
-        std::getline(input, line);
+      input.nextLine(&ptr,&len);
+      while (check_comment(ptr,len)) {
+        input.nextLine(&ptr,&len);
       }
+      std::string line(ptr,len);
       std::vector<std::string>  split_line;
 
       this->cleanComment(line);
@@ -227,27 +229,26 @@ class PTI23_parser : public BasePTIParser<_network>
 
     }
 
-    void find_buses(std::ifstream & input)
+    void find_buses(gridpack::stream::InputStream & input)
     {
-      std::string          line;
+      gridpack::parser::LineTokenizer tokens(',',true);
+      const char *line;
+      int len;
       int                  index = 0;
       int                  o_idx;
-      std::getline(input, line);
-      std::getline(input, line);
-      std::getline(input, line);
+      input.nextLine(&line,&len);
+      input.nextLine(&line,&len);
+      input.nextLine(&line,&len);
       double pl,ql,bl,gl;
 
-      while(test_end(line)) {
-        std::vector<std::string>  split_line;
-        this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_on);
+      while(test_end(line,len)) {
+        tokens.split(line,len);
         boost::shared_ptr<gridpack::component::DataCollection>
           data(new gridpack::component::DataCollection);
-        int nstr = split_line.size();
+        int nstr = tokens.size();
 
         // BUS_I               "I"                   integer
-        o_idx = atoi(split_line[0].c_str());
+        o_idx = tokens.getInt(0);
         data->addValue(BUS_NUMBER, o_idx);
         p_busData.push_back(data);
         p_busMap.insert(std::pair<int,int>(o_idx,index));
@@ -257,30 +258,30 @@ class PTI23_parser : public BasePTIParser<_network>
         data->addValue(CASE_ID, p_case_id);
 
         // BUS_NAME             "NAME"                 string
-        if (nstr > 9) data->addValue(BUS_NAME, split_line[9].c_str());
+        if (nstr > 9) data->addValue(BUS_NAME, tokens.getString(9).c_str());
 
         // BUS_BASEKV           "BASKV"               float
-        if (nstr > 10) data->addValue(BUS_BASEKV, atof(split_line[10].c_str()));
+        if (nstr > 10) data->addValue(BUS_BASEKV, tokens.getDouble(10));
 
         // BUS_TYPE               "IDE"                   integer
-        if (nstr > 1) data->addValue(BUS_TYPE, atoi(split_line[1].c_str()));
+        if (nstr > 1) data->addValue(BUS_TYPE, tokens.getInt(1));
 
         // BUS_SHUNT_GL              "GL"                  float
         gl = 0.0;
         if (nstr > 4) {
-          gl = atof(split_line[4].c_str());
+          gl = tokens.getDouble(4);
         }
 
         // BUS_SHUNT_BL              "BL"                  float
         bl = 0.0;
         if (nstr > 5) {
-          bl = atof(split_line[5].c_str());
+          bl = tokens.getDouble(5);
         }
         if (gl != 0.0 || bl != 0.0) {
-          data->addValue(BUS_SHUNT_GL, atof(split_line[4].c_str()));
-          data->addValue(BUS_SHUNT_GL, atof(split_line[4].c_str()),0);
-          data->addValue(BUS_SHUNT_BL, atof(split_line[5].c_str()));
-          data->addValue(BUS_SHUNT_BL, atof(split_line[5].c_str()),0);
+          data->addValue(BUS_SHUNT_GL, tokens.getDouble(4));
+          data->addValue(BUS_SHUNT_GL, tokens.getDouble(4),0);
+          data->addValue(BUS_SHUNT_BL, tokens.getDouble(5));
+          data->addValue(BUS_SHUNT_BL, tokens.getDouble(5),0);
           data->addValue(SHUNT_BUSNUMBER,o_idx);
           int ival = 1;
           data->addValue(SHUNT_NUMBER,ival);
@@ -288,38 +289,38 @@ class PTI23_parser : public BasePTIParser<_network>
         }
 
         // BUS_ZONE            "ZONE"                integer
-        if (nstr > 11) data->addValue(BUS_ZONE, atoi(split_line[11].c_str()));
+        if (nstr > 11) data->addValue(BUS_ZONE, tokens.getInt(11));
 
         // BUS_AREA            "IA"                integer
-        if (nstr > 6) data->addValue(BUS_AREA, atoi(split_line[6].c_str()));
+        if (nstr > 6) data->addValue(BUS_AREA, tokens.getInt(6));
 
         // BUS_VOLTAGE_MAG              "VM"                  float
-        if (nstr > 7) data->addValue(BUS_VOLTAGE_MAG, atof(split_line[7].c_str()));
+        if (nstr > 7) data->addValue(BUS_VOLTAGE_MAG, tokens.getDouble(7));
 
         // BUS_VOLTAGE_ANG              "VA"                  float
-        if (nstr > 8) data->addValue(BUS_VOLTAGE_ANG, atof(split_line[8].c_str()));
+        if (nstr > 8) data->addValue(BUS_VOLTAGE_ANG, tokens.getDouble(8));
 
         // BUS_OWNER              "IA"                  integer
-        if (nstr > 6) data->addValue(BUS_OWNER, atoi(split_line[6].c_str()));
+        if (nstr > 6) data->addValue(BUS_OWNER, tokens.getInt(6));
 
         // LOAD_PL                "PL"                  float
         pl = 0.0;
         if (nstr > 2) {
-          pl = atof(split_line[2].c_str());
+          pl = tokens.getDouble(2);
         }
 
         // LOAD_QL                "QL"                  float
         ql = 0.0;
         if (nstr > 3) {
-          ql = atof(split_line[3].c_str());
+          ql = tokens.getDouble(3);
         }
         if (pl != 0.0 || ql != 0.0) {
-          data->addValue(LOAD_PL, atof(split_line[2].c_str()));
-          data->addValue(LOAD_PL, atof(split_line[2].c_str()),0);
+          data->addValue(LOAD_PL, tokens.getDouble(2));
+          data->addValue(LOAD_PL, tokens.getDouble(2),0);
           std::string tmp("1 ");
           data->addValue(LOAD_ID,tmp.c_str(),0);
-          data->addValue(LOAD_QL, atof(split_line[3].c_str()));
-          data->addValue(LOAD_QL, atof(split_line[3].c_str()),0);
+          data->addValue(LOAD_QL, tokens.getDouble(3));
+          data->addValue(LOAD_QL, tokens.getDouble(3),0);
           int ival = 1;
           data->addValue(LOAD_NUMBER,ival);
           data->addValue(LOAD_STATUS,ival,0);
@@ -327,34 +328,34 @@ class PTI23_parser : public BasePTIParser<_network>
         }
 
         index++;
-        std::getline(input, line);
+        input.nextLine(&line,&len);
       }
     }
 
-    void find_generators(std::ifstream & input, std::string &oldline, bool &parsed)
+    void find_generators(gridpack::stream::InputStream & input, std::string &oldline, bool &parsed)
     {
-      std::string          line;
+      gridpack::parser::LineTokenizer tokens(',',true);
+      const char *line;
+      int len;
       if (parsed) {
-        std::getline(input, line); //this should be the first line of the block
+        input.nextLine(&line,&len); //this should be the first line of the block
       } else {
-        line = oldline;
+        line = oldline.data();
+        len = oldline.length();
       }
-      while(test_end(line)) {
-        std::vector<std::string>  split_line;
-        this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_on);
+      while(test_end(line,len)) {
+        tokens.split(line,len);
 
         // GENERATOR_BUSNUMBER               "I"                   integer
         int l_idx, o_idx;
-        o_idx = atoi(split_line[0].c_str());
+        o_idx = tokens.getInt(0);
         std::map<int, int>::iterator it;
-        int nstr = split_line.size();
+        int nstr = tokens.size();
         it = p_busMap.find(o_idx);
         if (it != p_busMap.end()) {
           l_idx = it->second;
         } else {
-          std::getline(input, line);
+          input.nextLine(&line,&len);
           continue;
         }
 
@@ -363,105 +364,106 @@ class PTI23_parser : public BasePTIParser<_network>
         if (!p_busData[l_idx]->getValue(GENERATOR_NUMBER, &ngen)) ngen = 0;
 
 
-        p_busData[l_idx]->addValue(GENERATOR_BUSNUMBER, atoi(split_line[0].c_str()), ngen);
+        p_busData[l_idx]->addValue(GENERATOR_BUSNUMBER, tokens.getInt(0), ngen);
 
         // Clean up 2 character tag
         gridpack::utility::StringUtils util;
-        std::string tag = util.clean2Char(split_line[1]);
+        std::string tag_fld = tokens.getString(1);
+        std::string tag = util.clean2Char(tag_fld);
         // GENERATOR_ID              "ID"                  integer
         p_busData[l_idx]->addValue(GENERATOR_ID, tag.c_str(), ngen);
 
         // GENERATOR_PG              "PG"                  float
-        if (nstr > 2) p_busData[l_idx]->addValue(GENERATOR_PG, atof(split_line[2].c_str()),
+        if (nstr > 2) p_busData[l_idx]->addValue(GENERATOR_PG, tokens.getDouble(2),
             ngen);
 
         // GENERATOR_QG              "QG"                  float
-        if (nstr > 3) p_busData[l_idx]->addValue(GENERATOR_QG, atof(split_line[3].c_str()),
+        if (nstr > 3) p_busData[l_idx]->addValue(GENERATOR_QG, tokens.getDouble(3),
             ngen);
 
         // GENERATOR_QMAX              "QT"                  float
         if (nstr > 4) p_busData[l_idx]->addValue(GENERATOR_QMAX,
-            atof(split_line[4].c_str()), ngen);
+            tokens.getDouble(4), ngen);
 
         // GENERATOR_QMIN              "QB"                  float
         if (nstr > 5) p_busData[l_idx]->addValue(GENERATOR_QMIN,
-            atof(split_line[5].c_str()), ngen);
+            tokens.getDouble(5), ngen);
 
         // GENERATOR_VS              "VS"                  float
-        if (nstr > 6) p_busData[l_idx]->addValue(GENERATOR_VS, atof(split_line[6].c_str()),
+        if (nstr > 6) p_busData[l_idx]->addValue(GENERATOR_VS, tokens.getDouble(6),
             ngen);
 
         // GENERATOR_IREG            "IREG"                integer
         if (nstr > 7) p_busData[l_idx]->addValue(GENERATOR_IREG,
-            atoi(split_line[7].c_str()), ngen);
+            tokens.getInt(7), ngen);
 
         // GENERATOR_MBASE           "MBASE"               float
         if (nstr > 8) p_busData[l_idx]->addValue(GENERATOR_MBASE,
-            atof(split_line[8].c_str()), ngen);
+            tokens.getDouble(8), ngen);
 
         // GENERATOR_ZSOURCE                                complex
         if (nstr > 9) p_busData[l_idx]->addValue(GENERATOR_ZSOURCE,
-            gridpack::ComplexType(atof(split_line[9].c_str()),
-              atof(split_line[10].c_str())), ngen);
+            gridpack::ComplexType(tokens.getDouble(9),
+              tokens.getDouble(10)), ngen);
 
         // GENERATOR_XTRAN                              complex
         if (nstr > 11) p_busData[l_idx]->addValue(GENERATOR_XTRAN,
-            gridpack::ComplexType(atof(split_line[11].c_str()),
-              atof(split_line[12].c_str())), ngen);
+            gridpack::ComplexType(tokens.getDouble(11),
+              tokens.getDouble(12)), ngen);
 
         // GENERATOR_RT              "RT"                  float
-        if (nstr > 11) p_busData[l_idx]->addValue(GENERATOR_RT, atof(split_line[11].c_str()),
+        if (nstr > 11) p_busData[l_idx]->addValue(GENERATOR_RT, tokens.getDouble(11),
             ngen);
 
         // GENERATOR_XT              "XT"                  float
-        if (nstr > 12) p_busData[l_idx]->addValue(GENERATOR_XT, atof(split_line[12].c_str()),
+        if (nstr > 12) p_busData[l_idx]->addValue(GENERATOR_XT, tokens.getDouble(12),
             ngen);
 
         // GENERATOR_GTAP              "GTAP"                  float
         if (nstr > 13) p_busData[l_idx]->addValue(GENERATOR_GTAP,
-            atof(split_line[13].c_str()), ngen);
+            tokens.getDouble(13), ngen);
 
         // GENERATOR_STAT              "STAT"                  float
         if (nstr > 14)  p_busData[l_idx]->addValue(GENERATOR_STAT,
-            atoi(split_line[14].c_str()), ngen);
+            tokens.getInt(14), ngen);
 
         // GENERATOR_RMPCT           "RMPCT"               float
         if (nstr > 15) p_busData[l_idx]->addValue(GENERATOR_RMPCT,
-            atof(split_line[15].c_str()), ngen);
+            tokens.getDouble(15), ngen);
 
         // GENERATOR_PMAX              "PT"                  float
         if (nstr > 16) p_busData[l_idx]->addValue(GENERATOR_PMAX,
-            atof(split_line[16].c_str()), ngen);
+            tokens.getDouble(16), ngen);
 
         // GENERATOR_PMIN              "PB"                  float
         if (nstr > 17) p_busData[l_idx]->addValue(GENERATOR_PMIN,
-            atof(split_line[17].c_str()), ngen);
+            tokens.getDouble(17), ngen);
 
         // Pick up some non-standard values for Dynamic Simulation
         // GENERATOR_REACTANCE                             float
         if (nstr > 18) p_busData[l_idx]->addValue(GENERATOR_REACTANCE,
-            atof(split_line[18].c_str()), ngen);
+            tokens.getDouble(18), ngen);
 
         // GENERATOR_RESISTANCE                             float
         if (nstr > 19) p_busData[l_idx]->addValue(GENERATOR_RESISTANCE,
-            atof(split_line[19].c_str()), ngen);
+            tokens.getDouble(19), ngen);
 
         // GENERATOR_TRANSIENT_REACTANCE                             float
         if (nstr > 20) p_busData[l_idx]->addValue(GENERATOR_TRANSIENT_REACTANCE,
-            atof(split_line[20].c_str()), ngen);
+            tokens.getDouble(20), ngen);
 
         // GENERATOR_SUBTRANSIENT_REACTANCE                             float
         if (nstr > 21) p_busData[l_idx]->addValue(GENERATOR_SUBTRANSIENT_REACTANCE,
-            atof(split_line[21].c_str()), ngen);
+            tokens.getDouble(21), ngen);
 
         // Pick up some more non-standard values for Dynamic Simulation
         // GENERATOR_INERTIA_CONSTANT_H                           float
         if (nstr > 22) p_busData[l_idx]->addValue(GENERATOR_INERTIA_CONSTANT_H,
-            atof(split_line[22].c_str()), ngen);
+            tokens.getDouble(22), ngen);
 
         // GENERATOR_DAMPING_COEFFICIENT_0                           float
         if (nstr > 23) p_busData[l_idx]->addValue(GENERATOR_DAMPING_COEFFICIENT_0,
-            atof(split_line[23].c_str()), ngen);
+            tokens.getDouble(23), ngen);
 
         // Increment number of generators in data object
         if (ngen == 0) {
@@ -472,28 +474,27 @@ class PTI23_parser : public BasePTIParser<_network>
           p_busData[l_idx]->setValue(GENERATOR_NUMBER,ngen);
         }
 
-        std::getline(input, line);
+        input.nextLine(&line,&len);
       }
     }
 
-    void find_branches(std::ifstream & input)
+    void find_branches(gridpack::stream::InputStream & input)
     {
-      std::string line;
+      gridpack::parser::LineTokenizer tokens(',',true);
+      const char *line;
+      int len;
       int  o_idx1, o_idx2;
       int index = 0;
 
-      std::getline(input, line); //this should be the first line of the block
+      input.nextLine(&line,&len); //this should be the first line of the block
 
       int nelems;
-      while(test_end(line)) {
+      while(test_end(line,len)) {
         std::pair<int, int> branch_pair;
-        std::vector<std::string>  split_line;
-        this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_on);
+        tokens.split(line,len);
 
-        o_idx1 = atoi(split_line[0].c_str());
-        o_idx2 = atoi(split_line[1].c_str());
+        o_idx1 = tokens.getInt(0);
+        o_idx2 = tokens.getInt(1);
 
         // Switch sign if indices are negative
         if (o_idx1 < 0) o_idx1 = -o_idx1;
@@ -551,93 +552,93 @@ class PTI23_parser : public BasePTIParser<_network>
 
         // Clean up 2 character tag
         gridpack::utility::StringUtils util;
-        std::string tag = util.clean2Char(split_line[2]);
+        std::string tag_fld = tokens.getString(2);
+        std::string tag = util.clean2Char(tag_fld);
         // BRANCH_CKT          "CKT"                 character
         p_branchData[l_idx]->addValue(BRANCH_CKT, tag.c_str(),
             nelems);
 
         // BRANCH_R            "R"                   float
-        p_branchData[l_idx]->addValue(BRANCH_R, atof(split_line[3].c_str()),
+        p_branchData[l_idx]->addValue(BRANCH_R, tokens.getDouble(3),
             nelems);
 
         // BRANCH_X            "X"                   float
-        p_branchData[l_idx]->addValue(BRANCH_X, atof(split_line[4].c_str()),
+        p_branchData[l_idx]->addValue(BRANCH_X, tokens.getDouble(4),
             nelems);
 
         // BRANCH_B            "B"                   float
-        p_branchData[l_idx]->addValue(BRANCH_B, atof(split_line[5].c_str()),
+        p_branchData[l_idx]->addValue(BRANCH_B, tokens.getDouble(5),
             nelems);
 
         // BRANCH_RATING_A        "RATEA"               float
         p_branchData[l_idx]->addValue(BRANCH_RATING_A,
-            atof(split_line[6].c_str()), nelems);
+            tokens.getDouble(6), nelems);
 
         // BBRANCH_RATING_        "RATEB"               float
         p_branchData[l_idx]->addValue(BRANCH_RATING_B,
-            atof(split_line[7].c_str()), nelems);
+            tokens.getDouble(7), nelems);
 
         // BRANCH_RATING_C        "RATEC"               float
         p_branchData[l_idx]->addValue(BRANCH_RATING_C,
-            atof(split_line[8].c_str()), nelems);
+            tokens.getDouble(8), nelems);
 
         // BRANCH_TAP        "RATIO"               float
-        p_branchData[l_idx]->addValue(BRANCH_TAP, atof(split_line[9].c_str()), nelems);
+        p_branchData[l_idx]->addValue(BRANCH_TAP, tokens.getDouble(9), nelems);
 
         // BRANCH_SHIFT        "SHIFT"               float
         p_branchData[l_idx]->addValue(BRANCH_SHIFT,
-            atof(split_line[10].c_str()), nelems);
+            tokens.getDouble(10), nelems);
 
         // BRANCH_SHUNT_ADMTTNC_G1        "GI"               float
         p_branchData[l_idx]->addValue(BRANCH_SHUNT_ADMTTNC_G1,
-            atof(split_line[11].c_str()), nelems);
+            tokens.getDouble(11), nelems);
 
         // BRANCH_SHUNT_ADMTTNC_B1        "BI"               float
         p_branchData[l_idx]->addValue(BRANCH_SHUNT_ADMTTNC_B1,
-            atof(split_line[12].c_str()), nelems);
+            tokens.getDouble(12), nelems);
 
         // BRANCH_SHUNT_ADMTTNC_G2        "GJ"               float
         p_branchData[l_idx]->addValue(BRANCH_SHUNT_ADMTTNC_G2,
-            atof(split_line[13].c_str()), nelems);
+            tokens.getDouble(13), nelems);
 
         // BRANCH_SHUNT_ADMTTNC_B2        "BJ"               float
         p_branchData[l_idx]->addValue(BRANCH_SHUNT_ADMTTNC_B2,
-            atof(split_line[14].c_str()), nelems);
+            tokens.getDouble(14), nelems);
 
         // BRANCH_STATUS        "STATUS"               integer
         p_branchData[l_idx]->addValue(BRANCH_STATUS,
-            atoi(split_line[15].c_str()), nelems);
+            tokens.getInt(15), nelems);
 
         nelems++;
         p_branchData[l_idx]->setValue(BRANCH_NUM_ELEMENTS,nelems);
-        std::getline(input, line);
+        input.nextLine(&line,&len);
       }
     }
 
     // TODO: This code is NOT handling these elements correctly. Need to bring
     // it in line with find_branch routine and the definitions in the
     // ex_pti_file
-    void find_transformer(std::ifstream & input)
+    void find_transformer(gridpack::stream::InputStream & input)
     {
-      std::string          line;
+      gridpack::parser::LineTokenizer tokens(',',true);
+      const char *line;
+      int len;
 
-      std::getline(input, line); //this should be the first line of the block
+      input.nextLine(&line,&len); //this should be the first line of the block
 
       std::pair<int, int>   branch_pair;
 
       // get the branch that has the same to and from buses that the transformer hadto
 
-      while(test_end(line)) {
-        std::vector<std::string>  split_line;
-        this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_on);
+      while(test_end(line,len)) {
+        tokens.split(line,len);
 
         // KG: I'm assuming the BRANCH_FROMBUS is the bus index we need to match
-        int fromBus = atoi(split_line[0].c_str());
+        int fromBus = tokens.getInt(0);
         if (fromBus < 0) fromBus = -fromBus;
 
         // KG: I'm assuming the BRANCH_TOBUS is the bus index we need to match
-        int toBus = atoi(split_line[1].c_str());
+        int toBus = tokens.getInt(1);
         if (toBus < 0) toBus = -toBus;
 
         // find branch corresponding to this transformer line
@@ -649,7 +650,7 @@ class PTI23_parser : public BasePTIParser<_network>
         if (it != p_branchMap.end()) {
           l_idx = it->second;
         } else {
-          std::getline(input, line);
+          input.nextLine(&line,&len);
           continue;
         }
 
@@ -659,7 +660,8 @@ class PTI23_parser : public BasePTIParser<_network>
         int nelems = 0;
         p_branchData[l_idx]->getValue(BRANCH_NUM_ELEMENTS,&nelems);
         gridpack::utility::StringUtils util;
-        std::string b_ckt(util.clean2Char(split_line[2]));
+        std::string b_ckt_fld = tokens.getString(2);
+        std::string b_ckt(util.clean2Char(b_ckt_fld));
         int i;
         int idx = -1;
         for (i=0; i<nelems; i++) {
@@ -681,49 +683,49 @@ class PTI23_parser : public BasePTIParser<_network>
          * TRANSFORMER_CONTROL
          */
         p_branchData[l_idx]->addValue(TRANSFORMER_CONTROL,
-            atoi(split_line[3].c_str()),idx);
+            tokens.getInt(3),idx);
 
         /*
          * type: float
          * TRANSFORMER_RMA
          */
         p_branchData[l_idx]->addValue(TRANSFORMER_RMA,
-            atof(split_line[4].c_str()),idx);
+            tokens.getDouble(4),idx);
 
         /*
          * type: float
          * TRANSFORMER_RMI
          */
         p_branchData[l_idx]->addValue(TRANSFORMER_RMI,
-            atof(split_line[5].c_str()),idx);
+            tokens.getDouble(5),idx);
 
         /*
          * type: float
          * TRANSFORMER_VMA
          */
         p_branchData[l_idx]->addValue(TRANSFORMER_VMA,
-            atof(split_line[6].c_str()),idx);
+            tokens.getDouble(6),idx);
 
         /*
          * type: float
          * TRANSFORMER_VMI
          */
         p_branchData[l_idx]->addValue(TRANSFORMER_VMI,
-            atof(split_line[7].c_str()),idx);
+            tokens.getDouble(7),idx);
 
         /*
          * type: float
          * TRANSFORMER_STEP
          */
         p_branchData[l_idx]->addValue(TRANSFORMER_STEP,
-            atof(split_line[8].c_str()),idx);
+            tokens.getDouble(8),idx);
 
         /*
          * type: float
          * TRANSFORMER_TABLE
          */
         p_branchData[l_idx]->addValue(TRANSFORMER_TABLE,
-            atof(split_line[9].c_str()),idx);
+            tokens.getDouble(9),idx);
 
         // This stuff is probably all wrong
 #if 0
@@ -732,19 +734,19 @@ class PTI23_parser : public BasePTIParser<_network>
          * type: integer
          * #define TRANSFORMER_BUS1 "TRANSFORMER_BUS1"
          */
-        p_branchData[l_idx]->addValue(TRANSFORMER_BUS1, atoi(split_line[0].c_str()));
+        p_branchData[l_idx]->addValue(TRANSFORMER_BUS1, tokens.getInt(0));
 
         /*
          * type: integer
          * #define TRANSFORMER_BUS2 "TRANSFORMER_BUS2"
          */
-        p_branchData[l_idx]->addValue(TRANSFORMER_BUS2, atoi(split_line[1].c_str()));
+        p_branchData[l_idx]->addValue(TRANSFORMER_BUS2, tokens.getInt(1));
 
         /*
          * type: integer
          * #define TRANSFORMER_BUS3 "TRANSFORMER_BUS3"
          */
-        //          data->addValue(TRANSFORMER_BUS3, atoi(split_line[1].c_str()));
+        //          data->addValue(TRANSFORMER_BUS3, tokens.getInt(1));
 
         /*
          * type: string
@@ -756,37 +758,37 @@ class PTI23_parser : public BasePTIParser<_network>
          * type: integer
          * #define TRANSFORMER_CW "TRANSFORMER_CW"
          X            */
-        p_branchData[l_idx]->addValue(TRANSFORMER_CW, atoi(split_line[3].c_str()));
+        p_branchData[l_idx]->addValue(TRANSFORMER_CW, tokens.getInt(3));
 
         /*
          * type: integer
          * #define TRANSFORMER_CZ "TRANSFORMER_CZ"
          */
-        p_branchData[l_idx]->addValue(TRANSFORMER_CZ, atoi(split_line[5].c_str()));
+        p_branchData[l_idx]->addValue(TRANSFORMER_CZ, tokens.getInt(5));
 
         /*
          * type: integer
          * #define TRANSFORMER_CM "TRANSFORMER_CM"
          */
-        p_branchData[l_idx]->addValue(TRANSFORMER_CM, atoi(split_line[5].c_str()));
+        p_branchData[l_idx]->addValue(TRANSFORMER_CM, tokens.getInt(5));
 
         /*
          * type: real float
          * #define TRANSFORMER_MAG1 "TRANSFORMER_MAG1"
          */
-        p_branchData[l_idx]->addValue(TRANSFORMER_MAG1, atof(split_line[5].c_str()));
+        p_branchData[l_idx]->addValue(TRANSFORMER_MAG1, tokens.getDouble(5));
 
         /*
          * type: real float
          * #define TRANSFORMER_MAG2 "TRANSFORMER_MAG2"
          */
-        p_branchData[l_idx]->addValue(TRANSFORMER_MAG2, atof(split_line[5].c_str()));
+        p_branchData[l_idx]->addValue(TRANSFORMER_MAG2, tokens.getDouble(5));
 
         /*
          * type: integer
          * #define TRANSFORMER_NMETR "TRANSFORMER_NMETR"
          */
-        p_branchData[l_idx]->addValue(TRANSFORMER_NMETR, atoi(split_line[1].c_str()));
+        p_branchData[l_idx]->addValue(TRANSFORMER_NMETR, tokens.getInt(1));
 
         /*
          * type: string
@@ -799,102 +801,102 @@ class PTI23_parser : public BasePTIParser<_network>
          * #define TRANSFORMER_STATUS "TRANSFORMER_STATUS"
          *
          */
-        p_branchData[l_idx]->addValue(TRANSFORMER_STATUS, atoi(split_line[1].c_str()));
+        p_branchData[l_idx]->addValue(TRANSFORMER_STATUS, tokens.getInt(1));
 
         /*
          * type: integer
          * #define TRANSFORMER_OWNER "TRANSFORMER_OWNER"
          */
-        p_branchData[l_idx]->addValue(TRANSFORMER_OWNER, atoi(split_line[1].c_str()));
+        p_branchData[l_idx]->addValue(TRANSFORMER_OWNER, tokens.getInt(1));
 
         /*
          * type: real float
          * #define TRANSFORMER_R1_2 "TRANSFORMER_R1_2"
          */
-        p_branchData[l_idx]->addValue(TRANSFORMER_R1_2, atof(split_line[1].c_str()));
+        p_branchData[l_idx]->addValue(TRANSFORMER_R1_2, tokens.getDouble(1));
 
         /*
          * type: real float
          * #define TRANSFORMER_X1_2 "TRANSFORMER_X1_2"
          */
-        p_branchData[l_idx]->addValue(TRANSFORMER_X1_2, atof(split_line[1].c_str()));
+        p_branchData[l_idx]->addValue(TRANSFORMER_X1_2, tokens.getDouble(1));
 
         /*
          * type: real float
          * #define TRANSFORMER_SBASE1_2 "TRANSFORMER_SBASE1_2"
          */
-        p_branchData[l_idx]->addValue(TRANSFORMER_SBASE1_2, atof(split_line[1].c_str()));
+        p_branchData[l_idx]->addValue(TRANSFORMER_SBASE1_2, tokens.getDouble(1));
 #endif
 
-        std::getline(input, line);
+        input.nextLine(&line,&len);
       }
     }
 
-    void find_area(std::ifstream & input)
+    void find_area(gridpack::stream::InputStream & input)
     {
-      std::string          line;
+      gridpack::parser::LineTokenizer tokens(',',true);
+      const char *line;
+      int len;
 
-      std::getline(input, line); //this should be the first line of the block
+      input.nextLine(&line,&len); //this should be the first line of the block
 
-      while(test_end(line)) {
-        std::vector<std::string>  split_line;
-        this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","), boost::token_compress_on);
+      while(test_end(line,len)) {
+        tokens.split(line,len);
 
         // AREAINTG_ISW           "ISW"                  integer
         int l_idx, o_idx;
-        o_idx = atoi(split_line[1].c_str());
+        o_idx = tokens.getInt(1);
         std::map<int, int>::iterator it;
         it = p_busMap.find(o_idx);
         if (it != p_busMap.end()) {
           l_idx = it->second;
         } else {
-          std::getline(input, line);
+          input.nextLine(&line,&len);
           continue;
         }
-        p_busData[l_idx]->addValue(AREAINTG_ISW, atoi(split_line[1].c_str()));
+        p_busData[l_idx]->addValue(AREAINTG_ISW, tokens.getInt(1));
 
         // AREAINTG_NUMBER             "I"                    integer
-        p_busData[l_idx]->addValue(AREAINTG_NUMBER, atoi(split_line[0].c_str()));
+        p_busData[l_idx]->addValue(AREAINTG_NUMBER, tokens.getInt(0));
 
         // AREAINTG_PDES          "PDES"                 float
-        p_busData[l_idx]->addValue(AREAINTG_PDES, atof(split_line[2].c_str()));
+        p_busData[l_idx]->addValue(AREAINTG_PDES, tokens.getDouble(2));
 
         // AREAINTG_PTOL          "PTOL"                 float
-        p_busData[l_idx]->addValue(AREAINTG_PTOL, atof(split_line[3].c_str()));
+        p_busData[l_idx]->addValue(AREAINTG_PTOL, tokens.getDouble(3));
 
         // AREAINTG_NAME         "ARNAM"                string
-        p_busData[l_idx]->addValue(AREAINTG_NAME, split_line[4].c_str());
+        p_busData[l_idx]->addValue(AREAINTG_NAME, tokens.getString(4).c_str());
 
-        std::getline(input, line);
+        input.nextLine(&line,&len);
       }
     }
 
-    void find_2term(std::ifstream & input)
+    void find_2term(gridpack::stream::InputStream & input)
     {
-      std::string          line;
+      gridpack::parser::LineTokenizer tokens(',',true);
+      const char *line;
+      int len;
 
-      std::getline(input, line); //this should be the first line of the block
+      input.nextLine(&line,&len); //this should be the first line of the block
 
-      while(test_end(line)) {
-        std::vector<std::string>  split_line;
-        this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","), boost::token_compress_on);
-        std::getline(input, line);
+      while(test_end(line,len)) {
+        tokens.split(line,len);
+        input.nextLine(&line,&len);
       }
     }
 
-    void find_line(std::ifstream & input)
+    void find_line(gridpack::stream::InputStream & input)
     {
-      std::string          line;
+      gridpack::parser::LineTokenizer tokens(',',true);
+      const char *line;
+      int len;
 
-      std::getline(input, line); //this should be the first line of the block
+      input.nextLine(&line,&len); //this should be the first line of the block
 
-      while(test_end(line)) {
-        std::vector<std::string>  split_line;
-        this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","), boost::token_compress_on);
-        std::getline(input, line);
+      while(test_end(line,len)) {
+        tokens.split(line,len);
+        input.nextLine(&line,&len);
       }
     }
 
@@ -902,201 +904,201 @@ class PTI23_parser : public BasePTIParser<_network>
     /*
 
      */
-    void find_shunt(std::ifstream & input)
+    void find_shunt(gridpack::stream::InputStream & input)
     {
-      std::string          line;
+      gridpack::parser::LineTokenizer tokens(',',true);
+      const char *line;
+      int len;
 
-      std::getline(input, line); //this should be the first line of the block
-      while(test_end(line)) {
-        std::vector<std::string>  split_line;
-        this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","), boost::token_compress_on);
+      input.nextLine(&line,&len); //this should be the first line of the block
+      while(test_end(line,len)) {
+        tokens.split(line,len);
 
         /*
          * type: integer
          * #define SWSHUNT_BUSNUMBER "SWSHUNT_BUSNUMBER"
          */
         int l_idx, o_idx;
-        l_idx = atoi(split_line[0].c_str());
+        l_idx = tokens.getInt(0);
         std::map<int, int>::iterator it;
         it = p_busMap.find(l_idx);
         if (it != p_busMap.end()) {
           o_idx = it->second;
         } else {
-          std::getline(input, line);
+          input.nextLine(&line,&len);
           continue;
         }
-        int nval = split_line.size();
+        int nval = tokens.size();
 
-        p_busData[o_idx]->addValue(SWSHUNT_BUSNUMBER, atoi(split_line[0].c_str()));
+        p_busData[o_idx]->addValue(SWSHUNT_BUSNUMBER, tokens.getInt(0));
 
         /*
          * type: integer
          * #define SHUNT_MODSW "SHUNT_MODSW"
          */
-        p_busData[o_idx]->addValue(SHUNT_MODSW, atoi(split_line[1].c_str()));
+        p_busData[o_idx]->addValue(SHUNT_MODSW, tokens.getInt(1));
 
         /*
          * type: real float
          * #define SHUNT_VSWHI "SHUNT_VSWHI"
          */
-        p_busData[o_idx]->addValue(SHUNT_VSWHI, atof(split_line[2].c_str()));
+        p_busData[o_idx]->addValue(SHUNT_VSWHI, tokens.getDouble(2));
 
         /*
          * type: real float
          * #define SHUNT_VSWLO "SHUNT_VSWLO"
          */
-        p_busData[o_idx]->addValue(SHUNT_VSWLO, atof(split_line[3].c_str()));
+        p_busData[o_idx]->addValue(SHUNT_VSWLO, tokens.getDouble(3));
 
         /*
          * type: integer
          * #define SHUNT_SWREM "SHUNT_SWREM"
          */
-        p_busData[o_idx]->addValue(SHUNT_SWREM, atoi(split_line[4].c_str()));
+        p_busData[o_idx]->addValue(SHUNT_SWREM, tokens.getInt(4));
 
         /*
          * type: real float
          * #define SHUNT_RMPCT "SHUNT_RMPCT"
          */
-        //          p_busData[o_idx]->addValue(SHUNT_RMPCT, atof(split_line[4].c_str()));
+        //          p_busData[o_idx]->addValue(SHUNT_RMPCT, tokens.getDouble(4));
 
         /*
          * type: string
          * #define SHUNT_RMIDNT "SHUNT_RMIDNT"
          */
-        //          p_busData[o_idx]->addValue(SHUNT_RMIDNT, split_line[5].c_str());
+        //          p_busData[o_idx]->addValue(SHUNT_RMIDNT, tokens.getString(5).c_str());
 
         /*
          * type: real float
          * #define SHUNT_BINIT "SHUNT_BINIT"
          */
-        p_busData[o_idx]->addValue(SHUNT_BINIT, atof(split_line[5].c_str()));
+        p_busData[o_idx]->addValue(SHUNT_BINIT, tokens.getDouble(5));
 
         /*
          * type: integer
          * #define SHUNT_N1 "SHUNT_N1"
          */
-        p_busData[o_idx]->addValue(SHUNT_N1, atoi(split_line[6].c_str()));
+        p_busData[o_idx]->addValue(SHUNT_N1, tokens.getInt(6));
 
         /*
          * type: integer
          * #define SHUNT_N2 "SHUNT_N2"
          */
         if (8<nval) 
-          p_busData[o_idx]->addValue(SHUNT_N2, atoi(split_line[8].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_N2, tokens.getInt(8));
 
         /*
          * type: integer
          * #define SHUNT_N3 "SHUNT_N3"
          */
         if (10<nval) 
-          p_busData[o_idx]->addValue(SHUNT_N3, atoi(split_line[10].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_N3, tokens.getInt(10));
 
         /*
          * type: integer
          * #define SHUNT_N4 "SHUNT_N4"
          */
         if (12<nval) 
-          p_busData[o_idx]->addValue(SHUNT_N4, atoi(split_line[12].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_N4, tokens.getInt(12));
 
         /*
          * type: integer
          * #define SHUNT_N5 "SHUNT_N5"
          */
         if (14<nval) 
-          p_busData[o_idx]->addValue(SHUNT_N5, atoi(split_line[14].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_N5, tokens.getInt(14));
 
         /*
          * type: integer
          * #define SHUNT_N6 "SHUNT_N6"
          */
         if (16<nval) 
-          p_busData[o_idx]->addValue(SHUNT_N6, atoi(split_line[16].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_N6, tokens.getInt(16));
 
         /*
          * type: integer
          * #define SHUNT_N7 "SHUNT_N7"
          */
         if (18<nval) 
-          p_busData[o_idx]->addValue(SHUNT_N7, atoi(split_line[18].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_N7, tokens.getInt(18));
 
         /*
          * type: integer
          * #define SHUNT_N8 "SHUNT_N8"
          */
         if (20<nval) 
-          p_busData[o_idx]->addValue(SHUNT_N8, atoi(split_line[20].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_N8, tokens.getInt(20));
 
         /*
          * type: real float
          * #define SHUNT_B1 "SHUNT_B1"
          */
         if (7<nval) 
-          p_busData[o_idx]->addValue(SHUNT_B1, atof(split_line[7].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_B1, tokens.getDouble(7));
 
         /*
          * type: real float
          * #define SHUNT_B2 "SHUNT_B2"
          */
         if (9<nval) 
-          p_busData[o_idx]->addValue(SHUNT_B2, atof(split_line[9].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_B2, tokens.getDouble(9));
 
         /*
          * type: real float
          * #define SHUNT_B3 "SHUNT_B3"
          */
         if (11<nval) 
-          p_busData[o_idx]->addValue(SHUNT_B3, atof(split_line[11].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_B3, tokens.getDouble(11));
 
         /*
          * type: real float
          * #define SHUNT_B4 "SHUNT_B4"
          */
         if (13<nval) 
-          p_busData[o_idx]->addValue(SHUNT_B4, atof(split_line[13].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_B4, tokens.getDouble(13));
 
         /*
          * type: real float
          * #define SHUNT_B5 "SHUNT_B5"
          */
         if (15<nval) 
-          p_busData[o_idx]->addValue(SHUNT_B5, atof(split_line[15].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_B5, tokens.getDouble(15));
 
         /*
          * type: real float
          * #define SHUNT_B6 "SHUNT_B6"
          */
         if (17<nval) 
-          p_busData[o_idx]->addValue(SHUNT_B6, atof(split_line[17].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_B6, tokens.getDouble(17));
 
         /*
          * type: real float
          * #define SHUNT_B7 "SHUNT_B7"
          */
         if (19<nval) 
-          p_busData[o_idx]->addValue(SHUNT_B7, atof(split_line[19].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_B7, tokens.getDouble(19));
 
         /*
          * type: real float
          * #define SHUNT_B8 "SHUNT_B8"
          */
         if (21<nval) 
-          p_busData[o_idx]->addValue(SHUNT_B8, atof(split_line[21].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_B8, tokens.getDouble(21));
 
-        std::getline(input, line);
+        input.nextLine(&line,&len);
       }
     }
 
-    void find_imped_corr(std::ifstream & input)
+    void find_imped_corr(gridpack::stream::InputStream & input)
     {
-      std::string          line;
+      gridpack::parser::LineTokenizer tokens(',',true);
+      const char *line;
+      int len;
 
-      std::getline(input, line); //this should be the first line of the block
+      input.nextLine(&line,&len); //this should be the first line of the block
 
-      while(test_end(line)) {
-        std::vector<std::string>  split_line;
-        this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","), boost::token_compress_on);
+      while(test_end(line,len)) {
+        tokens.split(line,len);
 #if 0
         std::vector<gridpack::component::DataCollection>   imped_corr_instance;
         gridpack::component::DataCollection          data;
@@ -1105,36 +1107,37 @@ class PTI23_parser : public BasePTIParser<_network>
          * type: integer
          * #define XFMR_CORR_TABLE_NUMBER "XFMR_CORR_TABLE_NUMBER"
          */
-        data.addValue(XFMR_CORR_TABLE_NUMBER, atoi(split_line[0].c_str()));
+        data.addValue(XFMR_CORR_TABLE_NUMBER, tokens.getInt(0));
         imped_corr_instance.push_back(data);
 
         /*
          * type: real float
          * #define XFMR_CORR_TABLE_Ti "XFMR_CORR_TABLE_Ti"
          */
-        data.addValue(XFMR_CORR_TABLE_Ti, atoi(split_line[0].c_str()));
+        data.addValue(XFMR_CORR_TABLE_Ti, tokens.getInt(0));
         imped_corr_instance.push_back(data);
 
         /*
          * type: real float
          * #define XFMR_CORR_TABLE_Fi "XFMR_CORR_TABLE_Fi"
          */
-        data.addValue(XFMR_CORR_TABLE_Fi, atoi(split_line[0].c_str()));
+        data.addValue(XFMR_CORR_TABLE_Fi, tokens.getInt(0));
         imped_corr_instance.push_back(data);
 
         imped_corr_set.push_back(imped_corr_instance);
 #endif
-        std::getline(input, line);
+        input.nextLine(&line,&len);
       }
     }
 
-    void find_multi_section(std::ifstream & input)
+    void find_multi_section(gridpack::stream::InputStream & input)
     {
-      std::string          line;
+      const char *line;
+      int len;
 
-      std::getline(input, line); //this should be the first line of the block
+      input.nextLine(&line,&len); //this should be the first line of the block
 
-      while(test_end(line)) {
+      while(test_end(line,len)) {
 #if 0
         std::vector<std::string>  split_line;
         this->cleanComment(line);
@@ -1175,43 +1178,46 @@ class PTI23_parser : public BasePTIParser<_network>
 
         multi_section.push_back(multi_section_instance);
 #endif
-        std::getline(input, line);
+        input.nextLine(&line,&len);
       }
     }
 
-    void find_multi_term(std::ifstream & input)
+    void find_multi_term(gridpack::stream::InputStream & input)
     {
-      std::string          line;
+      const char *line;
+      int len;
 
-      std::getline(input, line); //this should be the first line of the block
+      input.nextLine(&line,&len); //this should be the first line of the block
 
-      while(test_end(line)) {
+      while(test_end(line,len)) {
         // TODO: parse something here
-        std::getline(input, line);
+        input.nextLine(&line,&len);
       }
     }
     /*
      * ZONE_I          "I"                       integer
      * ZONE_NAME       "NAME"                    string
      */
-    void find_zone(std::ifstream & input)
+    void find_zone(gridpack::stream::InputStream & input)
     {
-      std::string          line;
+      const char *line;
+      int len;
 
-      std::getline(input, line); //this should be the first line of the block
-      while(test_end(line)) {
+      input.nextLine(&line,&len); //this should be the first line of the block
+      while(test_end(line,len)) {
         // TODO: parse something here
-        std::getline(input, line);
+        input.nextLine(&line,&len);
       }
     }
 
-    void find_interarea(std::ifstream & input)
+    void find_interarea(gridpack::stream::InputStream & input)
     {
-      std::string          line;
+      const char *line;
+      int len;
 
-      std::getline(input, line); //this should be the first line of the block
+      input.nextLine(&line,&len); //this should be the first line of the block
 
-      while(test_end(line)) {
+      while(test_end(line,len)) {
 #if 0
         std::vector<std::string>  split_line;
         this->cleanComment(line);
@@ -1249,7 +1255,7 @@ class PTI23_parser : public BasePTIParser<_network>
 
         inter_area.push_back(inter_area_instance);
 #endif
-        std::getline(input, line);
+        input.nextLine(&line,&len);
       }
     }
 
@@ -1260,12 +1266,13 @@ class PTI23_parser : public BasePTIParser<_network>
      * type: integer
      * #define OWNER_NAME "OWNER_NAME"
      */
-    void find_owner(std::ifstream & input)
+    void find_owner(gridpack::stream::InputStream & input)
     {
-      std::string          line;
-      std::getline(input, line); //this should be the first line of the block
+      const char *line;
+      int len;
+      input.nextLine(&line,&len); //this should be the first line of the block
 
-      while(test_end(line)) {
+      while(test_end(line,len)) {
 #if 0
         std::vector<std::string>  split_line;
         this->cleanComment(line);
@@ -1281,7 +1288,7 @@ class PTI23_parser : public BasePTIParser<_network>
 
         owner.push_back(owner_instance);
 #endif
-        std::getline(input, line);
+        input.nextLine(&line,&len);
       }
     }
 
@@ -1411,11 +1418,21 @@ class PTI23_parser : public BasePTIParser<_network>
      */
     bool test_end(std::string &str) const
     {
+      return test_end(str.data(), str.length());
+    }
+
+    /**
+     * Test to see if line terminates a section
+     * @param str pointer to first character of line
+     * @param len number of characters in line
+     * @return: false if first non-blank character is TERM_CHAR
+     */
+    bool test_end(const char *str, int len) const
+    {
 #if 1
-      if (str[0] == TERM_CHAR) {
+      if (len > 0 && str[0] == TERM_CHAR) {
         return false;
       }
-      int len = str.length();
       int i=0;
       while (i<len && str[i] == ' ') {
         i++;
@@ -1435,7 +1452,7 @@ class PTI23_parser : public BasePTIParser<_network>
         return true;
       }
 #else
-      if (str[0] == '0') {
+      if (len > 0 && str[0] == '0') {
         return false;
       } else {
         return true;
@@ -1457,6 +1474,19 @@ class PTI23_parser : public BasePTIParser<_network>
         return false;
       }
     }
+
+    /**
+     * Test to see if line is a comment line. Check to see if first
+     * non-blank characters are "//"
+     * @param str pointer to first character of line
+     * @param len number of characters in line
+     */
+    bool check_comment(const char *str, int len) const
+    {
+      int ntok = 0;
+      while (ntok < len && str[ntok] == ' ') ntok++;
+      return (ntok+1 < len && str[ntok] == '/' && str[ntok+1] == '/');
+    }
     /*
      * The case_data is the collection of all data points in the case file.
      * Each collection in the case data contains the data associated with a given
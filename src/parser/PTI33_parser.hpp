@@ -32,6 +32,7 @@
 #include "gridpack/network/base_network.hpp"
 #include "gridpack/parser/base_parser.hpp"
 #include "gridpack/parser/base_pti_parser.hpp"
+#include "gridpack/parser/record_exchange.hpp"
 
 #define TERM_CHAR '0'
 // SOURCE: http://www.ee.washington.edu/research/pstca/formats/pti.txt
@@ -51,7 +52,7 @@ class PTI33_parser : public BasePTIParser<_network>
      * of network configuration file (must be child of network::BaseNetwork<>)
      */
     PTI33_parser(boost::shared_ptr<_network> network)
-      : p_network(network), p_maxBusIndex(-1)
+      : p_network(network), p_maxBusIndex(-1), p_parallelRead(false)
     {
       this->setNetwork(network);
       p_network_data = network->getNetworkData();
@@ -81,8 +82,12 @@ class PTI33_parser : public BasePTIParser<_network>
       util.trim(tmpstr);
       std::string ext = this->getExtension(tmpstr);
       if (ext == "raw") {
-        openStream(tmpstr);
-        getCase();
+        if (p_parallelRead && p_network->communicator().size() > 1) {
+          getCaseParallel(tmpstr);
+        } else {
+          openStream(tmpstr);
+          getCase();
+        }
         this->createNetwork(p_busData,p_branchData);
       } else if (ext == "dyr") {
         this->getDS(tmpstr);
@@ -145,6 +150,19 @@ class PTI33_parser : public BasePTIParser<_network>
       }
     }
 
+    /**
+     * Read RAW files in parallel. If this is set to true, all processors
+     * read and parse part of the bus, load, shunt, generator and branch
+     * blocks and the records are assembled on the processors that own the
+     * corresponding buses. Otherwise, process 0 parses the entire file. This
+     * option only applies to RAW files that are read directly from disk.
+     * @param flag if true, read file in parallel
+     */
+    void setParallelRead(bool flag)
+    {
+      p_parallelRead = flag;
+    }
+
   protected:
     /**
      * Open in input stream object based on accessing a file
@@ -279,68 +297,389 @@ class PTI33_parser : public BasePTIParser<_network>
       p_timer->stop(t_case);
     }
 
-    void find_case()
+    /**
+     * Parallel version of getCase. Process 0 scans the file to find the
+     * location of the bus, load, fixed shunt, generator and branch blocks.
+     * Each processor then reads part of each of these blocks and sends the
+     * records to the processor that owns the bus referred to by the record
+     * (the lower numbered bus for branches), where they are parsed by the
+     * same functions used in getCase. The remaining blocks are read by
+     * process 0 and records that modify bus or branch data are forwarded in
+     * the same way.
+     * @param fileName name of RAW file
+     */
+    void getCaseParallel(const std::string &fileName)
     {
-      std::string                                        line;
+      int t_case = p_timer->createCategory("Parser:getCase");
+      p_timer->start(t_case);
+      p_busData.clear();
+      p_branchData.clear();
+      p_busMap.clear();
+
+      MPI_Comm comm = static_cast<MPI_Comm>(p_network->communicator());
+      int me(p_network->communicator().rank());
+      RecordExchange xchng(p_network->communicator());
 
-      p_istream.nextLine(line);
-      while (check_comment(line)) {
-        p_istream.nextLine(line);
+      // Find beginning and end of bus, load, fixed shunt, generator and
+      // branch blocks
+      const int nblocks = 5;
+      std::vector<long> offsets(2*nblocks,0);
+      std::ifstream fin;
+      std::string line;
+      int i, j;
+      if (me == 0) {
+        fin.open(fileName.c_str(), std::ios::in | std::ios::binary);
+        if (!fin.is_open()) {
+          char buf[512];
+          sprintf(buf,"Failed to open network configuration file: %s\n\n",
+              fileName.c_str());
+          throw gridpack::Exception(buf);
+        }
+        std::vector<std::string> header;
+        long offset = 0;
+        // comment lines and case record
+        while (std::getline(fin,line)) {
+          offset += line.length()+1;
+          header.push_back(line);
+          if (!check_comment(line)) break;
+        }
+        // two title lines
+        for (i=0; i<2; i++) {
+          std::getline(fin,line);
+          offset += line.length()+1;
+        }
+        for (i=0; i<nblocks; i++) {
+          offsets[2*i] = offset;
+          while (std::getline(fin,line) && test_end(line)) {
+            offset += line.length()+1;
+          }
+          offsets[2*i+1] = offset;
+          offset += line.length()+1;
+        }
+        p_istream.openStringVector(header);
+        find_case();
+        p_istream.close();
+      } else {
+        p_case_sbase = 0.0;
+        p_case_id = 0;
       }
-      std::vector<std::string>  split_line;
 
-      this->cleanComment(line);
-      boost::algorithm::split(split_line, line, boost::algorithm::is_any_of(","),
-          boost::token_compress_off);
+      // Transmit CASE_SBASE and CASE_ID to all processors
+      double sval =  p_case_sbase;
+      double rval;
+      int ierr = MPI_Allreduce(&sval,&rval,1,MPI_DOUBLE,MPI_SUM,comm);
+      p_case_sbase = rval;
+      int isval, irval;
+      isval = p_case_id;
+      ierr = MPI_Allreduce(&isval,&irval,1,MPI_INT,MPI_SUM,comm);
+      p_case_id = irval;
+      this->setCaseID(p_case_id);
+      this->setCaseSBase(p_case_sbase);
+      ierr = MPI_Bcast(&offsets[0],2*nblocks,MPI_LONG,0,comm);
+
+      // Buses
+      std::vector<std::string> lines, rlines;
+      std::vector<int> dest, tags, rtags;
+      xchng.readBlock(fileName,offsets[0],offsets[1],lines);
+      dest.resize(lines.size());
+      for (i=0; i<lines.size(); i++) {
+        dest[i] = xchng.owner(atoi(lines[i].c_str()));
+      }
+      xchng.exchange(lines,dest,rlines);
+      parse_block(rlines,&PTI33_parser::find_buses,2);
+
+      // Bus names are replicated on all processors so that records that
+      // refer to buses by name can be sent to the correct processor
+      lines.clear();
+#ifdef OLD_MAP
+      std::map<std::string,int>::iterator nit;
+#else
+      boost::unordered_map<std::string, int>::iterator nit;
+#endif
+      for (nit = p_nameMap.begin(); nit != p_nameMap.end(); nit++) {
+        char buf[32];
+        sprintf(buf,"%d,",nit->second);
+        lines.push_back(std::string(buf)+nit->first);
+      }
+      xchng.allGather(lines,rlines);
+      for (i=0; i<rlines.size(); i++) {
+        int ntok = rlines[i].find(',');
+        p_nameMap.insert(std::pair<std::string,int>(
+              rlines[i].substr(ntok+1),atoi(rlines[i].substr(0,ntok).c_str())));
+      }
+      isval = p_maxBusIndex;
+      ierr = MPI_Allreduce(&isval,&irval,1,MPI_INT,MPI_MAX,comm);
+      p_maxBusIndex = irval;
+
+      // Loads, fixed shunts, generators and branches
+      for (j=1; j<nblocks; j++) {
+        xchng.readBlock(fileName,offsets[2*j],offsets[2*j+1],lines);
+        dest.resize(lines.size());
+        int nkey = (j == 4) ? 2 : 1;
+        for (i=0; i<lines.size(); i++) {
+          dest[i] = record_owner(lines[i],nkey,xchng);
+        }
+        xchng.exchange(lines,dest,rlines);
+        if (j == 1) {
+          parse_block(rlines,&PTI33_parser::find_loads,0);
+        } else if (j == 2) {
+          parse_block(rlines,&PTI33_parser::find_fixed_shunts,0);
+        } else if (j == 3) {
+          parse_block(rlines,&PTI33_parser::find_generators,0);
+        } else {
+          parse_block(rlines,&PTI33_parser::find_branches,0);
+        }
+      }
+
+      // Transformers. Records are read on process 0 since they span a
+      // variable number of lines. Two winding transformers go to the owner
+      // of the lower numbered bus, so that they can be combined with lines
+      // between the same buses, and three winding transformers go to the
+      // owner of bus I. New buses created for three winding transformers are
+      // numbered in the order they appear in the file.
+      lines.clear();
+      dest.clear();
+      tags.clear();
+      if (me == 0) {
+        int nstar = p_maxBusIndex;
+        while (std::getline(fin,line) && test_end(line)) {
+          std::vector<std::string> rec(1,line);
+          int nrec = transformer_lines(line);
+          for (i=1; i<nrec; i++) {
+            std::getline(fin,line);
+            rec.push_back(line);
+          }
+          int tag = 0;
+          int d;
+          if (nrec == 5) {
+            gridpack::parser::LineTokenizer tokens, tokens2;
+            tokens.split(rec[0]);
+            tokens2.split(rec[1]);
+            int stat = 0;
+            if (tokens.size() > 11) stat = tokens.getInt(11);
+            if (tokens2.size() >= 4 && stat != 0) {
+              nstar++;
+              tag = nstar;
+            }
+            d = record_owner(rec[0],1,xchng);
+          } else {
+            d = record_owner(rec[0],2,xchng);
+          }
+          for (i=0; i<nrec; i++) {
+            lines.push_back(rec[i]);
+            dest.push_back(d);
+            tags.push_back(i == 0 ? tag : 0);
+          }
+        }
+      }
+      xchng.exchange(lines,tags,dest,rlines,rtags);
+      // Transformers that create a new bus are parsed individually after
+      // setting the bus index. Other transformers are parsed in batches
+      lines.clear();
+      i = 0;
+      while (i<rlines.size()) {
+        int nrec = transformer_lines(rlines[i]);
+        if (rtags[i] > 0) {
+          parse_block(lines,&PTI33_parser::find_transformer,0);
+          lines.clear();
+          p_maxBusIndex = rtags[i]-1;
+          std::vector<std::string> rec(rlines.begin()+i,rlines.begin()+i+nrec);
+          parse_block(rec,&PTI33_parser::find_transformer,0);
+        } else {
+          for (j=0; j<nrec; j++) lines.push_back(rlines[i+j]);
+        }
+        i += nrec;
+      }
+      parse_block(lines,&PTI33_parser::find_transformer,0);
+
+      // Remaining blocks only contain network data or data for a small
+      // number of devices so they are read on process 0. Multi-section lines
+      // and switched shunts are sent to the processors that own the
+      // corresponding branches and buses
+      if (me == 0) {
+        read_block(fin,lines);
+        parse_block(lines,&PTI33_parser::find_area,0);
+        read_block(fin,lines);
+        parse_block(lines,&PTI33_parser::find_2term,0);
+        read_block(fin,lines);
+        parse_block(lines,&PTI33_parser::find_vsc_line,0);
+        read_block(fin,lines);
+        parse_block(lines,&PTI33_parser::find_imped_corr,0);
+        read_block(fin,lines);
+        parse_block(lines,&PTI33_parser::find_multi_term,0);
+        read_block(fin,lines);
+      } else {
+        lines.clear();
+      }
+      dest.resize(lines.size());
+      for (i=0; i<lines.size(); i++) {
+        dest[i] = record_owner(lines[i],2,xchng);
+      }
+      xchng.exchange(lines,dest,rlines);
+      parse_block(rlines,&PTI33_parser::find_multi_section,0);
+      if (me == 0) {
+        read_block(fin,lines);
+        parse_block(lines,&PTI33_parser::find_zone,0);
+        read_block(fin,lines);
+        parse_block(lines,&PTI33_parser::find_interarea,0);
+        read_block(fin,lines);
+        parse_block(lines,&PTI33_parser::find_owner,0);
+        read_block(fin,lines);
+        parse_block(lines,&PTI33_parser::find_facts,0);
+        read_block(fin,lines);
+        fin.close();
+      } else {
+        lines.clear();
+      }
+      dest.resize(lines.size());
+      for (i=0; i<lines.size(); i++) {
+        dest[i] = record_owner(lines[i],1,xchng);
+      }
+      xchng.exchange(lines,dest,rlines);
+      parse_block(rlines,&PTI33_parser::find_switched_shunt,0);
+
+      p_network->broadcastNetworkData(0);
+      p_network_data = p_network->getNetworkData();
+      p_timer->stop(t_case);
+    }
+
+    /**
+     * Parse a block of records using one of the find functions. The lines
+     * are placed in a stream with nheader blank lines in front and a
+     * terminating record at the end
+     * @param lines records in block
+     * @param parse function used to parse block
+     * @param nheader number of header lines expected by parse function
+     */
+    void parse_block(const std::vector<std::string> &lines,
+        void (PTI33_parser::*parse)(), int nheader)
+    {
+      std::vector<std::string> block(nheader,std::string(""));
+      block.insert(block.end(),lines.begin(),lines.end());
+      block.push_back(std::string("0 / END OF BLOCK"));
+      p_istream.openStringVector(block);
+      (this->*parse)();
+      p_istream.close();
+    }
+
+    /**
+     * Read lines from file up to the end of the current block. The line
+     * terminating the block is not included
+     * @param fin file stream
+     * @param lines lines in block
+     */
+    void read_block(std::ifstream &fin, std::vector<std::string> &lines)
+    {
+      std::string line;
+      lines.clear();
+      while (std::getline(fin,line) && test_end(line)) {
+        lines.push_back(line);
+      }
+    }
+
+    /**
+     * Find the processor that should parse a record based on the buses
+     * listed in the first nkey fields. If there is more than one bus, the
+     * lowest bus index is used. Records that refer to buses that can not be
+     * found are kept on the current processor, where they will be skipped
+     * @param line record
+     * @param nkey number of bus fields at the start of the record
+     * @param xchng object describing assignment of buses to processors
+     * @return rank of processor
+     */
+    int record_owner(const std::string &line, int nkey,
+        const RecordExchange &xchng)
+    {
+      int i;
+      int idx = -1;
+      int first = 0;
+      for (i=0; i<nkey; i++) {
+        int last = line.find(',',first);
+        if (last == std::string::npos) last = line.length();
+        int o_idx = getBusIndex(line.substr(first,last-first));
+        if (o_idx < 0) return p_network->communicator().rank();
+        if (idx < 0 || o_idx < idx) idx = o_idx;
+        first = last+1;
+        if (first > line.length()) break;
+      }
+      if (idx < 0) return p_network->communicator().rank();
+      return xchng.owner(idx);
+    }
+
+    /**
+     * Number of lines in a transformer record
+     * @param line first line of record
+     * @return 5 for three winding transformers, 4 otherwise
+     */
+    int transformer_lines(const std::string &line)
+    {
+      gridpack::parser::LineTokenizer tokens;
+      tokens.split(line);
+      std::string field;
+      if (tokens.size() > 2) tokens.getString(2,field);
+      if (tokens.size() > 2 && getBusIndex(field) != 0) return 5;
+      return 4;
+    }
+
+    void find_case()
+    {
+      gridpack::parser::LineTokenizer tokens;
+      const char *line;
+      int len;
+
+      p_istream.nextLine(&line,&len);
+      while (check_comment(line,len)) {
+        p_istream.nextLine(&line,&len);
+      }
+      tokens.split(line,len);
 
       // CASE_ID             "IC"                   ranged integer
-      p_case_id = atoi(split_line[0].c_str());
+      p_case_id = tokens.getInt(0);
 
       // CASE_SBASE          "SBASE"                float
-      p_case_sbase = atof(split_line[1].c_str());
+      p_case_sbase = tokens.getDouble(1);
 
       p_network_data->addValue(CASE_SBASE, p_case_sbase);
       p_network_data->addValue(CASE_ID, p_case_id);
       /*  These do not appear in the dictionary
       // REVISION_ID
-      if (split_line.size() > 2)
-      p_revision_id = atoi(split_line[2].c_str());
+      if (tokens.size() > 2)
+      p_revision_id = tokens.getInt(2);
 
       // XFRRAT_UNITS
-      if (split_line.size() > 3)
-      p_xffrat_units = atof(split_line[3].c_str());
+      if (tokens.size() > 3)
+      p_xffrat_units = tokens.getDouble(3);
 
       // NXFRAT_UNITS
-      if (split_line.size() > 4)
-      p_nxfrat_units = atof(split_line[4].c_str());
+      if (tokens.size() > 4)
+      p_nxfrat_units = tokens.getDouble(4);
 
       // BASE_FREQ
-      if (split_line.size() > 5)
-      p_base_freq = atof(split_line[5].c_str());
+      if (tokens.size() > 5)
+      p_base_freq = tokens.getDouble(5);
        */
 
     }
 
     void find_buses()
     {
-      std::string          line;
+      gridpack::parser::LineTokenizer tokens;
+      const char *line;
+      int len;
       int                  index = 0;
       int                  o_idx;
-      p_istream.nextLine(line);
-      p_istream.nextLine(line);
-      p_istream.nextLine(line);
+      p_istream.nextLine(&line,&len);
+      p_istream.nextLine(&line,&len);
+      p_istream.nextLine(&line,&len);
 
-      while(test_end(line)) {
-        std::vector<std::string>  split_line;
-        this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+      while(test_end(line,len)) {
+        tokens.split(line,len);
         boost::shared_ptr<gridpack::component::DataCollection>
           data(new gridpack::component::DataCollection);
-        int nstr = split_line.size();
+        int nstr = tokens.size();
 
         // BUS_I               "I"                   integer
-        o_idx = atoi(split_line[0].c_str());
+        o_idx = tokens.getInt(0);
         if (p_maxBusIndex<o_idx) p_maxBusIndex = o_idx;
         data->addValue(BUS_NUMBER, o_idx);
         p_busData.push_back(data);
@@ -351,61 +690,60 @@ class PTI33_parser : public BasePTIParser<_network>
         data->addValue(CASE_ID, p_case_id);
 
         // BUS_NAME             "NAME"                 string
-        std::string bus_name = split_line[1];
+        std::string bus_name = tokens.getString(1);
 
         //store bus and index as a pair
         storeBus(bus_name, o_idx);
         if (nstr > 1) data->addValue(BUS_NAME, bus_name.c_str());
 
         // BUS_BASEKV           "BASKV"               float
-        if (nstr > 2) data->addValue(BUS_BASEKV, atof(split_line[2].c_str()));
+        if (nstr > 2) data->addValue(BUS_BASEKV, tokens.getDouble(2));
 
         // BUS_TYPE               "IDE"                   integer
-        if (nstr > 3) data->addValue(BUS_TYPE, atoi(split_line[3].c_str()));
+        if (nstr > 3) data->addValue(BUS_TYPE, tokens.getInt(3));
 
         // BUS_AREA            "IA"                integer
-        if (nstr > 4) data->addValue(BUS_AREA, atoi(split_line[4].c_str()));
+        if (nstr > 4) data->addValue(BUS_AREA, tokens.getInt(4));
 
         // BUS_ZONE            "ZONE"                integer
-        if (nstr > 5) data->addValue(BUS_ZONE, atoi(split_line[5].c_str()));
+        if (nstr > 5) data->addValue(BUS_ZONE, tokens.getInt(5));
 
         // BUS_OWNER              "IA"                  integer
-        if (nstr > 6) data->addValue(BUS_OWNER, atoi(split_line[6].c_str()));
+        if (nstr > 6) data->addValue(BUS_OWNER, tokens.getInt(6));
 
         // BUS_VOLTAGE_MAG              "VM"                  float
-        if (nstr > 7) data->addValue(BUS_VOLTAGE_MAG, atof(split_line[7].c_str()));
+        if (nstr > 7) data->addValue(BUS_VOLTAGE_MAG, tokens.getDouble(7));
 
         // BUS_VOLTAGE_ANG              "VA"                  float
-        if (nstr > 8) data->addValue(BUS_VOLTAGE_ANG, atof(split_line[8].c_str()));
+        if (nstr > 8) data->addValue(BUS_VOLTAGE_ANG, tokens.getDouble(8));
 
         // BUS_VOLTAGE_MAX              "VOLTAGE_MAX"               float
-        if (nstr > 9) data->addValue(BUS_VOLTAGE_MAX, atof(split_line[9].c_str()));
+        if (nstr > 9) data->addValue(BUS_VOLTAGE_MAX, tokens.getDouble(9));
 
         // BUS_VOLTAGE_MIN              "VOLTAGE_MIN"              float
-        if (nstr > 10) data->addValue(BUS_VOLTAGE_MIN, atof(split_line[10].c_str()));
+        if (nstr > 10) data->addValue(BUS_VOLTAGE_MIN, tokens.getDouble(10));
 
         // TODO: Need to add EVHI, EVLO
         index++;
-        p_istream.nextLine(line);
+        p_istream.nextLine(&line,&len);
       }
     }
 
     void find_loads()
     {
-      std::string          line;
-      p_istream.nextLine(line); //this should be the first line of the block
+      gridpack::parser::LineTokenizer tokens;
+      const char *line;
+      int len;
+      p_istream.nextLine(&line,&len); //this should be the first line of the block
 
-      while(test_end(line)) {
-        std::vector<std::string>  split_line;
-        this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+      while(test_end(line,len)) {
+        tokens.split(line,len);
 
         // LOAD_BUSNUMBER               "I"                   integer
         int l_idx, o_idx;
-        o_idx = getBusIndex(split_line[0]);
+        o_idx = getBusIndex(tokens,0);
         if (o_idx < 0) {
-          p_istream.nextLine(line);
+          p_istream.nextLine(&line,&len);
           continue;
         }
 #ifdef OLD_MAP
@@ -417,10 +755,10 @@ class PTI33_parser : public BasePTIParser<_network>
         if (it != p_busMap.end()) {
           l_idx = it->second;
         } else {
-          p_istream.nextLine(line);
+          p_istream.nextLine(&line,&len);
           continue;
         }
-        int nstr = split_line.size();
+        int nstr = tokens.size();
         // Find out how many loads are already on bus
         int nld;
         if (!p_busData[l_idx]->getValue(LOAD_NUMBER, &nld)) nld = 0;
@@ -431,50 +769,51 @@ class PTI33_parser : public BasePTIParser<_network>
         gridpack::utility::StringUtils util;
         if (nstr > 1) {
           // Clean up 2 character tag
-          std::string tag = util.clean2Char(split_line[1]);
+          std::string tag_fld = tokens.getString(1);
+          std::string tag = util.clean2Char(tag_fld);
           // LOAD_ID              "ID"                  integer
           p_busData[l_idx]->addValue(LOAD_ID, tag.c_str(), nld);
         }
 
         // LOAD_STATUS              "ID"                  integer
         if (nstr > 2) p_busData[l_idx]->addValue(LOAD_STATUS,
-            atoi(split_line[2].c_str()), nld);
+            tokens.getInt(2), nld);
 
         // LOAD_AREA            "AREA"                integer
         if (nstr > 3) p_busData[l_idx]->addValue(LOAD_AREA,
-            atoi(split_line[3].c_str()), nld);
+            tokens.getInt(3), nld);
 
         // LOAD_ZONE            "ZONE"                integer
         if (nstr > 4) p_busData[l_idx]->addValue(LOAD_ZONE,
-            atoi(split_line[4].c_str()), nld);
+            tokens.getInt(4), nld);
 
         // LOAD_PL              "PL"                  float
         if (nstr > 5) {
-          if (nld == 0) p_busData[l_idx]->addValue(LOAD_PL, atof(split_line[5].c_str()));
-          p_busData[l_idx]->addValue(LOAD_PL, atof(split_line[5].c_str()), nld);
+          if (nld == 0) p_busData[l_idx]->addValue(LOAD_PL, tokens.getDouble(5));
+          p_busData[l_idx]->addValue(LOAD_PL, tokens.getDouble(5), nld);
         }
 
         // LOAD_QL              "QL"                  float
         if (nstr > 6) {
-          if (nld == 0) p_busData[l_idx]->addValue(LOAD_QL, atof(split_line[6].c_str()));
-          p_busData[l_idx]->addValue(LOAD_QL, atof(split_line[6].c_str()), nld);
+          if (nld == 0) p_busData[l_idx]->addValue(LOAD_QL, tokens.getDouble(6));
+          p_busData[l_idx]->addValue(LOAD_QL, tokens.getDouble(6), nld);
         }
 
         // LOAD_IP              "IP"                  float
         if (nstr > 7) p_busData[l_idx]->addValue(LOAD_IP,
-            atof(split_line[7].c_str()), nld);
+            tokens.getDouble(7), nld);
 
         // LOAD_IQ              "IQ"                  float
         if (nstr > 8) p_busData[l_idx]->addValue(LOAD_IQ,
-            atof(split_line[8].c_str()), nld);
+            tokens.getDouble(8), nld);
 
         // LOAD_YP              "YP"                  float
         if (nstr > 9) p_busData[l_idx]->addValue(LOAD_YP,
-            atof(split_line[9].c_str()), nld);
+            tokens.getDouble(9), nld);
 
         // LOAD_YQ            "YQ"                integer
         if (nstr > 10) p_busData[l_idx]->addValue(LOAD_YQ,
-            atoi(split_line[10].c_str()), nld);
+            tokens.getInt(10), nld);
 
         // TODO: add variables OWNER, SCALE, INTRPT
 
@@ -487,24 +826,23 @@ class PTI33_parser : public BasePTIParser<_network>
           p_busData[l_idx]->setValue(LOAD_NUMBER,nld);
         }
 
-        p_istream.nextLine(line);
+        p_istream.nextLine(&line,&len);
       }
     }
 
     void find_fixed_shunts()
     {
-      std::string          line;
-      p_istream.nextLine(line); //this should be the first line of the block
+      gridpack::parser::LineTokenizer tokens;
+      const char *line;
+      int len;
+      p_istream.nextLine(&line,&len); //this should be the first line of the block
 
-      while(test_end(line)) {
-        std::vector<std::string>  split_line;
-        this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+      while(test_end(line,len)) {
+        tokens.split(line,len);
 
         // SHUNT_BUSNUMBER               "I"                   integer
         int l_idx, o_idx;
-        o_idx = getBusIndex(split_line[0]);
+        o_idx = getBusIndex(tokens,0);
 #ifdef OLD_MAP
         std::map<int, int>::iterator it;
 #else
@@ -514,10 +852,10 @@ class PTI33_parser : public BasePTIParser<_network>
         if (it != p_busMap.end()) {
           l_idx = it->second;
         } else {
-          p_istream.nextLine(line);
+          p_istream.nextLine(&line,&len);
           continue;
         }
-        int nstr = split_line.size();
+        int nstr = tokens.size();
 
         // Find out how many shunts are already on bus
         int nshnt;
@@ -528,29 +866,30 @@ class PTI33_parser : public BasePTIParser<_network>
         if (nstr > 1) {
           // Clean up 2 character tag
           gridpack::utility::StringUtils util;
-          std::string tag = util.clean2Char(split_line[1]);
+          std::string tag_fld = tokens.getString(1);
+          std::string tag = util.clean2Char(tag_fld);
           // SHUNT_ID              "ID"                  integer
           p_busData[l_idx]->addValue(SHUNT_ID, tag.c_str(), nshnt);
         }
 
         // SHUNT_STATUS              "STATUS"                  integer
         if (nstr > 2) p_busData[l_idx]->addValue(SHUNT_STATUS,
-            atoi(split_line[2].c_str()), nshnt);
+            tokens.getInt(2), nshnt);
 
         // BUS_SHUNT_GL              "GL"                  float
         if (nstr > 3) {
           if (nshnt==0) p_busData[l_idx]->addValue(BUS_SHUNT_GL,
-              atof(split_line[3].c_str()));
+              tokens.getDouble(3));
           p_busData[l_idx]->addValue(BUS_SHUNT_GL,
-              atof(split_line[3].c_str()),nshnt);
+              tokens.getDouble(3),nshnt);
         }
 
         // BUS_SHUNT_BL              "BL"                  float
         if (nstr > 4) {
           if (nshnt == 0) p_busData[l_idx]->addValue(BUS_SHUNT_BL,
-              atof(split_line[4].c_str()));
+              tokens.getDouble(4));
           p_busData[l_idx]->addValue(BUS_SHUNT_BL,
-              atof(split_line[4].c_str()),nshnt);
+              tokens.getDouble(4),nshnt);
         }
 
         // Increment number of shunts in data object
@@ -562,34 +901,33 @@ class PTI33_parser : public BasePTIParser<_network>
           p_busData[l_idx]->setValue(SHUNT_NUMBER,nshnt);
         }
 
-        p_istream.nextLine(line);
+        p_istream.nextLine(&line,&len);
       }
     }
 
     void find_generators()
     {
-      std::string          line;
-      p_istream.nextLine(line); //this should be the first line of the block
-      while(test_end(line)) {
-        std::vector<std::string>  split_line;
-        this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+      gridpack::parser::LineTokenizer tokens;
+      const char *line;
+      int len;
+      p_istream.nextLine(&line,&len); //this should be the first line of the block
+      while(test_end(line,len)) {
+        tokens.split(line,len);
 
         // GENERATOR_BUSNUMBER               "I"                   integer
         int l_idx, o_idx;
-        o_idx = getBusIndex(split_line[0]);
+        o_idx = getBusIndex(tokens,0);
 #ifdef OLD_MAP
         std::map<int, int>::iterator it;
 #else
         boost::unordered_map<int, int>::iterator it;
 #endif
-        int nstr = split_line.size();
+        int nstr = tokens.size();
         it = p_busMap.find(o_idx);
         if (it != p_busMap.end()) {
           l_idx = it->second;
         } else {
-          p_istream.nextLine(line);
+          p_istream.nextLine(&line,&len);
           continue;
         }
 
@@ -602,67 +940,68 @@ class PTI33_parser : public BasePTIParser<_network>
 
         // Clean up 2 character tag
         gridpack::utility::StringUtils util;
-        std::string tag = util.clean2Char(split_line[1]);
+        std::string tag_fld = tokens.getString(1);
+        std::string tag = util.clean2Char(tag_fld);
         // GENERATOR_ID              "ID"                  integer
         p_busData[l_idx]->addValue(GENERATOR_ID, tag.c_str(), ngen);
 
         // GENERATOR_PG              "PG"                  float
-        if (nstr > 2) p_busData[l_idx]->addValue(GENERATOR_PG, atof(split_line[2].c_str()),
+        if (nstr > 2) p_busData[l_idx]->addValue(GENERATOR_PG, tokens.getDouble(2),
             ngen);
 
         // GENERATOR_QG              "QG"                  float
-        if (nstr > 3) p_busData[l_idx]->addValue(GENERATOR_QG, atof(split_line[3].c_str()),
+        if (nstr > 3) p_busData[l_idx]->addValue(GENERATOR_QG, tokens.getDouble(3),
             ngen);
 
         // GENERATOR_QMAX              "QT"                  float
         if (nstr > 4) p_busData[l_idx]->addValue(GENERATOR_QMAX,
-            atof(split_line[4].c_str()), ngen);
+            tokens.getDouble(4), ngen);
 
         // GENERATOR_QMIN              "QB"                  float
         if (nstr > 5) p_busData[l_idx]->addValue(GENERATOR_QMIN,
-            atof(split_line[5].c_str()), ngen);
+            tokens.getDouble(5), ngen);
 
         // GENERATOR_VS              "VS"                  float
-        if (nstr > 6) p_busData[l_idx]->addValue(GENERATOR_VS, atof(split_line[6].c_str()),
+        if (nstr > 6) p_busData[l_idx]->addValue(GENERATOR_VS, tokens.getDouble(6),
             ngen);
 
         // GENERATOR_IREG            "IREG"                integer
         if (nstr > 7) p_busData[l_idx]->addValue(GENERATOR_IREG,
-            atoi(split_line[7].c_str()), ngen);
+            tokens.getInt(7), ngen);
 
         // GENERATOR_MBASE           "MBASE"               float
         if (nstr > 8) p_busData[l_idx]->addValue(GENERATOR_MBASE,
-            atof(split_line[8].c_str()), ngen);
+            tokens.getDouble(8), ngen);
 
         // GENERATOR_ZSOURCE                                complex
         if (nstr > 10) p_busData[l_idx]->addValue(GENERATOR_ZSOURCE,
-            gridpack::ComplexType(atof(split_line[9].c_str()),
-              atof(split_line[10].c_str())), ngen);
+            gridpack::ComplexType(tokens.getDouble(9),
+              tokens.getDouble(10)), ngen);
 
         // GENERATOR_XTRAN                              complex
         if (nstr > 12) p_busData[l_idx]->addValue(GENERATOR_XTRAN,
-            gridpack::ComplexType(atof(split_line[11].c_str()),
-              atof(split_line[12].c_str())), ngen);
+            gridpack::ComplexType(tokens.getDouble(11),
+              tokens.getDouble(12)), ngen);
 
         // GENERATOR_GTAP              "GTAP"                  float
         if (nstr > 13) p_busData[l_idx]->addValue(GENERATOR_GTAP,
-            atof(split_line[13].c_str()), ngen);
+            tokens.getDouble(13), ngen);
 
         // GENERATOR_STAT              "STAT"                  float
         if (nstr > 14)  p_busData[l_idx]->addValue(GENERATOR_STAT,
-            atoi(split_line[14].c_str()), ngen);
+            tokens.getInt(14), ngen);
 
         // GENERATOR_RMPCT           "RMPCT"               float
         if (nstr > 15) p_busData[l_idx]->addValue(GENERATOR_RMPCT,
-            atof(split_line[15].c_str()), ngen);
+            tokens.getDouble(15), ngen);
 
         // GENERATOR_PMAX              "PT"                  float
         if (nstr > 16) p_busData[l_idx]->addValue(GENERATOR_PMAX,
-            atof(split_line[16].c_str()), ngen);
+            tokens.getDouble(16), ngen);
 
         // GENERATOR_PMIN              "PB"                  float
         if (nstr > 17) p_busData[l_idx]->addValue(GENERATOR_PMIN,
-            atof(split_line[17].c_str()), ngen);
+            tokens.getDouble(17), ngen);
 
         // TODO: add variables Oi, Fi, WMOD, WPF
         // There may be between 0 and 4 owner pairs.
@@ -670,64 +1009,64 @@ class PTI33_parser : public BasePTIParser<_network>
         // in the line. The owners may be included as blanks.
         if (nstr > 18) {
           int owner = 0;
-          if (this->isBlank(split_line[18])) {
+          if (this->isBlank(tokens,18)) {
             p_busData[l_idx]->getValue(BUS_OWNER,&owner);
           } else {
-            owner = atoi(split_line[18].c_str());
+            owner = tokens.getInt(18);
           }
           p_busData[l_idx]->addValue(GENERATOR_OWNER1, owner, ngen);
           double frac = 1.0;
           if (nstr > 19) {
-            if (!this->isBlank(split_line[19])) {
-              frac = atof(split_line[19].c_str());
+            if (!this->isBlank(tokens,19)) {
+              frac = tokens.getDouble(19);
             }
           }
           p_busData[l_idx]->addValue(GENERATOR_OFRAC1, frac, ngen);
         }
         if (nstr > 20) {
           int owner = 0;
-          if (this->isBlank(split_line[20])) {
+          if (this->isBlank(tokens,20)) {
             owner = 0;
           } else {
-            owner = atoi(split_line[20].c_str());
+            owner = tokens.getInt(20);
           }
           p_busData[l_idx]->addValue(GENERATOR_OWNER2, owner, ngen);
           double frac = 0.0;
           if (nstr > 21) {
-            if (!this->isBlank(split_line[21])) {
-              frac = atof(split_line[21].c_str());
+            if (!this->isBlank(tokens,21)) {
+              frac = tokens.getDouble(21);
             }
           }
           p_busData[l_idx]->addValue(GENERATOR_OFRAC2, frac, ngen);
         }
         if (nstr > 22) {
           int owner = 0;
-          if (this->isBlank(split_line[22])) {
+          if (this->isBlank(tokens,22)) {
             owner = 0;
           } else {
-            owner = atoi(split_line[22].c_str());
+            owner = tokens.getInt(22);
           }
           p_busData[l_idx]->addValue(GENERATOR_OWNER3, owner, ngen);
           double frac = 0.0;
           if (nstr > 23) {
-            if (!this->isBlank(split_line[23])) {
-              frac = atof(split_line[23].c_str());
+            if (!this->isBlank(tokens,23)) {
+              frac = tokens.getDouble(23);
             }
           }
           p_busData[l_idx]->addValue(GENERATOR_OFRAC3, frac, ngen);
         }
         if (nstr > 24) {
           int owner = 0;
-          if (this->isBlank(split_line[24])) {
+          if (this->isBlank(tokens,24)) {
             owner = 0;
           } else {
-            owner = atoi(split_line[24].c_str());
+            owner = tokens.getInt(24);
           }
           p_busData[l_idx]->addValue(GENERATOR_OWNER4, owner, ngen);
           double frac = 0.0;
           if (nstr > 25) {
-            if (!this->isBlank(split_line[25])) {
-              frac = atof(split_line[25].c_str());
+            if (!this->isBlank(tokens,25)) {
+              frac = tokens.getDouble(25);
             }
           }
           p_busData[l_idx]->addValue(GENERATOR_OFRAC4, frac, ngen);
@@ -736,11 +1075,11 @@ class PTI33_parser : public BasePTIParser<_network>
         // Last two entries are WMOD and WPF
         if (nstr > 26) {
           p_busData[l_idx]->addValue(GENERATOR_WMOD,
-            atoi(split_line[26].c_str()), ngen);
+            tokens.getInt(26), ngen);
         }
         if (nstr > 27) {
           p_busData[l_idx]->addValue(GENERATOR_WPF,
-            atof(split_line[27].c_str()), ngen);
+            tokens.getDouble(27), ngen);
         }
 
         // Increment number of generators in data object
@@ -752,28 +1091,27 @@ class PTI33_parser : public BasePTIParser<_network>
           p_busData[l_idx]->setValue(GENERATOR_NUMBER,ngen);
         }
 
-        p_istream.nextLine(line);
+        p_istream.nextLine(&line,&len);
       }
     }
 
     void find_branches()
     {
-      std::string line;
+      gridpack::parser::LineTokenizer tokens;
+      const char *line;
+      int len;
       int  o_idx1, o_idx2;
       int index = 0;
 
-      p_istream.nextLine(line); //this should be the first line of the block
+      p_istream.nextLine(&line,&len); //this should be the first line of the block
 
       int nelems;
-      while(test_end(line)) {
+      while(test_end(line,len)) {
         std::pair<int, int> branch_pair;
-        std::vector<std::string>  split_line;
-        this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+        tokens.split(line,len);
 
-        o_idx1 = getBusIndex(split_line[0]);
-        o_idx2 = getBusIndex(split_line[1]);
+        o_idx1 = getBusIndex(tokens,0);
+        o_idx2 = getBusIndex(tokens,1);
 
         // Check to see if pair has already been created
         int l_idx = 0;
@@ -829,97 +1167,98 @@ class PTI33_parser : public BasePTIParser<_network>
         // BRANCH_SWITCHED
         p_branchData[l_idx]->addValue(BRANCH_SWITCHED, switched, nelems);
 
-        int nstr = split_line.size();
+        int nstr = tokens.size();
         // Clean up 2 character tag
         gridpack::utility::StringUtils util;
-        std::string tag = util.clean2Char(split_line[2]);
+        std::string tag_fld = tokens.getString(2);
+        std::string tag = util.clean2Char(tag_fld);
         // BRANCH_CKT          "CKT"                 character
         if (nstr > 2) p_branchData[l_idx]->addValue(BRANCH_CKT,
             tag.c_str(), nelems);
 
         // BRANCH_R            "R"                   float
         if (nstr > 3) p_branchData[l_idx]->addValue(BRANCH_R,
-            atof(split_line[3].c_str()), nelems);
+            tokens.getDouble(3), nelems);
 
         // BRANCH_X            "X"                   float
         if (nstr > 4) p_branchData[l_idx]->addValue(BRANCH_X,
-            atof(split_line[4].c_str()), nelems);
+            tokens.getDouble(4), nelems);
 
         // BRANCH_B            "B"                   float
         if (nstr > 5) p_branchData[l_idx]->addValue(BRANCH_B,
-            atof(split_line[5].c_str()), nelems);
+            tokens.getDouble(5), nelems);
 
         // BRANCH_RATING_A        "RATEA"               float
         if (nstr > 6) p_branchData[l_idx]->addValue(BRANCH_RATING_A,
-            atof(split_line[6].c_str()), nelems);
+            tokens.getDouble(6), nelems);
 
         // BBRANCH_RATING_        "RATEB"               float
         if (nstr > 7) p_branchData[l_idx]->addValue(BRANCH_RATING_B,
-            atof(split_line[7].c_str()), nelems);
+            tokens.getDouble(7), nelems);
 
         // BRANCH_RATING_C        "RATEC"               float
         if (nstr > 8) p_branchData[l_idx]->addValue(BRANCH_RATING_C,
-            atof(split_line[8].c_str()), nelems);
+            tokens.getDouble(8), nelems);
 
         // BRANCH_SHUNT_ADMTTNC_G1        "GI"               float
         if (nstr > 9) p_branchData[l_idx]->addValue(BRANCH_SHUNT_ADMTTNC_G1,
-            atof(split_line[9].c_str()), nelems);
+            tokens.getDouble(9), nelems);
 
         // BRANCH_SHUNT_ADMTTNC_B1        "BI"               float
         if (nstr > 10) p_branchData[l_idx]->addValue(BRANCH_SHUNT_ADMTTNC_B1,
-            atof(split_line[10].c_str()), nelems);
+            tokens.getDouble(10), nelems);
 
         // BRANCH_SHUNT_ADMTTNC_G2        "GJ"               float
         if (nstr > 11) p_branchData[l_idx]->addValue(BRANCH_SHUNT_ADMTTNC_G2,
-            atof(split_line[11].c_str()), nelems);
+            tokens.getDouble(11), nelems);
 
         // BRANCH_SHUNT_ADMTTNC_B2        "BJ"               float
         if (nstr > 12) p_branchData[l_idx]->addValue(BRANCH_SHUNT_ADMTTNC_B2,
-            atof(split_line[12].c_str()), nelems);
+            tokens.getDouble(12), nelems);
 
         // BRANCH_STATUS        "STATUS"               integer
         if (nstr > 13) p_branchData[l_idx]->addValue(BRANCH_STATUS,
-            atoi(split_line[13].c_str()), nelems);
+            tokens.getInt(13), nelems);
 
         // BRANCH_METER         "MET"                  integer
         if (nstr > 14) p_branchData[l_idx]->addValue(BRANCH_METER,
-            atoi(split_line[14].c_str()), nelems);
+            tokens.getInt(14), nelems);
 
         // BRANCH_LENGTH        "LEN"                        float
         if (nstr > 15) p_branchData[l_idx]->addValue(BRANCH_LENGTH,
-            atof(split_line[15].c_str()), nelems);
+            tokens.getDouble(15), nelems);
 
         // BRANCH_O1        "O1"                       integer
         if (nstr > 16) p_branchData[l_idx]->addValue(BRANCH_O1,
-            atoi(split_line[16].c_str()), nelems);
+            tokens.getInt(16), nelems);
 
         // BRANCH_F1        "F1"                             float
         if (nstr > 17) p_branchData[l_idx]->addValue(BRANCH_F1,
-            atoi(split_line[17].c_str()), nelems);
+            tokens.getInt(17), nelems);
 
         // BRANCH_O2        "O2"                       integer
         if (nstr > 18) p_branchData[l_idx]->addValue(BRANCH_O2,
-            atoi(split_line[18].c_str()), nelems);
+            tokens.getInt(18), nelems);
 
         // BRANCH_F2        "F2"                             float
         if (nstr > 19) p_branchData[l_idx]->addValue(BRANCH_F2,
-            atoi(split_line[19].c_str()), nelems);
+            tokens.getInt(19), nelems);
 
         // BRANCH_O3        "O3"                       integer
         if (nstr > 20) p_branchData[l_idx]->addValue(BRANCH_O3,
-            atoi(split_line[20].c_str()), nelems);
+            tokens.getInt(20), nelems);
 
         // BRANCH_F3        "F3"                             float
         if (nstr > 21) p_branchData[l_idx]->addValue(BRANCH_F3,
-            atoi(split_line[21].c_str()), nelems);
+            tokens.getInt(21), nelems);
 
         // BRANCH_O4        "O4"                       integer
         if (nstr > 22) p_branchData[l_idx]->addValue(BRANCH_O4,
-            atoi(split_line[22].c_str()), nelems);
+            tokens.getInt(22), nelems);
 
         // BRANCH_F4        "F4"                             float
         if (nstr > 23) p_branchData[l_idx]->addValue(BRANCH_F4,
-            atoi(split_line[23].c_str()), nelems);
+            tokens.getInt(23), nelems);
 
         // TODO: add variables MET, LEN, Oi, Fi
 
@@ -931,21 +1270,22 @@ class PTI33_parser : public BasePTIParser<_network>
 
         nelems++;
         p_branchData[l_idx]->setValue(BRANCH_NUM_ELEMENTS,nelems);
-        p_istream.nextLine(line);
+        p_istream.nextLine(&line,&len);
       }
     }
 
     // Utility function to parse lines in 3-winding transformer block
-    bool parse3WindXForm(std::vector<std::string>split_line, double *windv,
-        double* ang, double *ratea, double *rateb, double *ratec)
+    bool parse3WindXForm(const gridpack::parser::LineTokenizer &tokens,
+        double *windv, double* ang, double *ratea, double *rateb,
+        double *ratec)
     {
-      *windv = atof(split_line[0].c_str());
-      *ang = atof(split_line[2].c_str());
-      *ratea = atof(split_line[3].c_str());
-      *rateb = atof(split_line[4].c_str());
-      *ratec = atof(split_line[5].c_str());
+      *windv = tokens.getDouble(0);
+      *ang = tokens.getDouble(2);
+      *ratea = tokens.getDouble(3);
+      *rateb = tokens.getDouble(4);
+      *ratec = tokens.getDouble(5);
       bool ret = true;
-      return ret && (split_line.size() > 5);
+      return ret && (tokens.size() > 5);
     }
 
     // This code is NOT handling these elements correctly. Need to bring
@@ -953,9 +1293,15 @@ class PTI33_parser : public BasePTIParser<_network>
     // ex_pti_file
     void find_transformer()
     {
-      std::string          line;
+      gridpack::parser::LineTokenizer tokens;
+      gridpack::parser::LineTokenizer tokens2;
+      gridpack::parser::LineTokenizer tokens3;
+      gridpack::parser::LineTokenizer tokens4;
+      gridpack::parser::LineTokenizer tokens5;
+      const char *line;
+      int len;
 
-      p_istream.nextLine(line); //this should be the first line of the block
+      p_istream.nextLine(&line,&len); //this should be the first line of the block
 
       std::pair<int, int>   branch_pair;
 
@@ -964,55 +1310,46 @@ class PTI33_parser : public BasePTIParser<_network>
 
       bool wind3X = true;
 
-      while(test_end(line)) {
-        std::vector<std::string>  split_line;
-        this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+      while(test_end(line,len)) {
+        tokens.split(line,len);
         int o_idx1, o_idx2;
-        o_idx1 = getBusIndex(split_line[0]);
-        o_idx2 = getBusIndex(split_line[1]);
+        o_idx1 = getBusIndex(tokens,0);
+        o_idx2 = getBusIndex(tokens,1);
 
         // Check for 2-winding or 3-winding transformer
-        int k = getBusIndex(split_line[2]);
+        int k = getBusIndex(tokens,2);
         if (k != 0) {
           if (wind3X) {
             int o_idx3 = k;
-            p_istream.nextLine(line);
-            std::vector<std::string>  split_line2;
-            this->cleanComment(line);
-            boost::split(split_line2, line, boost::algorithm::is_any_of(","),
-                boost::token_compress_off);
+            p_istream.nextLine(&line,&len);
+            tokens2.split(line,len);
             // Check to see if transformer is active
             int stat;
-            stat = atoi(split_line[11].c_str());
-            if (split_line2.size() < 4 || stat == 0) {
-              p_istream.nextLine(line);
-              p_istream.nextLine(line);
-              p_istream.nextLine(line);
-              p_istream.nextLine(line);
+            stat = tokens.getInt(11);
+            if (tokens2.size() < 4 || stat == 0) {
+              p_istream.nextLine(&line,&len);
+              p_istream.nextLine(&line,&len);
+              p_istream.nextLine(&line,&len);
+              p_istream.nextLine(&line,&len);
               continue;
             }
-            // Get internal indices corresponding to buses 1,2,3
-            int l_idx1, l_idx2, l_idx3;
+            // Get internal index corresponding to bus 1. Buses 2 and 3 are
+            // only checked if the whole network is read on this processor
+            int l_idx1;
             std::map<int,int>::iterator it;
             it = p_busMap.find(o_idx1);
             if (it != p_busMap.end()) {
               l_idx1 = it->second;
             } else {
-              printf("No match found for bus %s\n",split_line[0].c_str());
+              printf("No match found for bus %s\n",tokens.getString(0).c_str());
             }
-            it = p_busMap.find(o_idx2);
-            if (it != p_busMap.end()) {
-              l_idx2 = it->second;
-            } else {
-              printf("No match found for bus %s\n",split_line[1].c_str());
-            }
-            it = p_busMap.find(o_idx3);
-            if (it != p_busMap.end()) {
-              l_idx3 = it->second;
-            } else {
-              printf("No match found for bus %s\n",split_line[2].c_str());
+            if (!p_parallelRead) {
+              if (p_busMap.find(o_idx2) == p_busMap.end()) {
+                printf("No match found for bus %s\n",tokens.getString(1).c_str());
+              }
+              if (p_busMap.find(o_idx3) == p_busMap.end()) {
+                printf("No match found for bus %s\n",tokens.getString(2).c_str());
+              }
             }
             // Create a new bus and three new branches. No need to check
             // previous branches to see if they match since they are all
@@ -1035,48 +1372,31 @@ class PTI33_parser : public BasePTIParser<_network>
             data->addValue(BUS_AREA,ival);
             p_busData[l_idx1]->getValue(BUS_OWNER,&ival);
             data->addValue(BUS_OWNER, ival);
-            double rval = 0.0;
-            double rvol;
-            p_busData[l_idx1]->getValue(BUS_VOLTAGE_MAG,&rvol);
-            rval += rvol;
-            p_busData[l_idx2]->getValue(BUS_VOLTAGE_MAG,&rvol);
-            rval += rvol;
-            p_busData[l_idx3]->getValue(BUS_VOLTAGE_MAG,&rvol);
-            rval += rvol;
-            rval = rval/3.0;
-            rval = 1.0;
-            data->addValue(BUS_VOLTAGE_MAG,rval);
-            rval = 0.0;
-            p_busData[l_idx1]->getValue(BUS_VOLTAGE_ANG,&rvol);
-            rval += rvol;
-            p_busData[l_idx2]->getValue(BUS_VOLTAGE_ANG,&rvol);
-            rval += rvol;
-            p_busData[l_idx3]->getValue(BUS_VOLTAGE_ANG,&rvol);
-            rval += rvol;
-            rval = rval/3.0;
-            rval = 0.0;
-            data->addValue(BUS_VOLTAGE_ANG,rval);
+            // Star bus starts at flat voltage
+            data->addValue(BUS_VOLTAGE_MAG,1.0);
+            data->addValue(BUS_VOLTAGE_ANG,0.0);
 
             // parse remainder of line 1
             double mag1, mag2;
-            mag1 = atof(split_line[7].c_str());
-            mag2 = atof(split_line[8].c_str());
+            mag1 = tokens.getDouble(7);
+            mag2 = tokens.getDouble(8);
             // Clean up 2 character tag
             gridpack::utility::StringUtils util;
-            std::string tag = util.clean2Char(split_line[3]);
+            std::string tag_fld = tokens.getString(3);
+            std::string tag = util.clean2Char(tag_fld);
 
             // parse line 2
             double r12, r23, r31, x12, x23, x31, sb12, sb23, sb31;
             double r1, r2, r3, x1, x2, x3, b1, b2, b3;
-            r12 = atof(split_line2[0].c_str());
-            x12 = atof(split_line2[1].c_str());
-            sb12 = atof(split_line2[2].c_str());
-            r23 = atof(split_line2[3].c_str());
-            x23 = atof(split_line2[4].c_str());
-            sb23 = atof(split_line2[5].c_str());
-            r31 = atof(split_line2[6].c_str());
-            x31 = atof(split_line2[7].c_str());
-            sb31 = atof(split_line2[8].c_str());
+            r12 = tokens2.getDouble(0);
+            x12 = tokens2.getDouble(1);
+            sb12 = tokens2.getDouble(2);
+            r23 = tokens2.getDouble(3);
+            x23 = tokens2.getDouble(4);
+            sb23 = tokens2.getDouble(5);
+            r31 = tokens2.getDouble(6);
+            x31 = tokens2.getDouble(7);
+            sb31 = tokens2.getDouble(8);
             r1 = 0.5*(r12+r31-r23);
             x1 = 0.5*(x12+x31-x23);
             b1 = 0.0;
@@ -1105,13 +1425,10 @@ class PTI33_parser : public BasePTIParser<_network>
             boost::shared_ptr<gridpack::component::DataCollection>
               data1(new gridpack::component::DataCollection);
             p_branchData.push_back(data1);
-            p_istream.nextLine(line);
-            std::vector<std::string> split_line3;
-            this->cleanComment(line);
-            boost::split(split_line3, line, boost::algorithm::is_any_of(","),
-                boost::token_compress_off);
+            p_istream.nextLine(&line,&len);
+            tokens3.split(line,len);
             double windv, ang, ratea, rateb, ratec;
-            parse3WindXForm(split_line3, &windv, &ang, &ratea, &rateb, &ratec);
+            parse3WindXForm(tokens3, &windv, &ang, &ratea, &rateb, &ratec);
             data1->addValue(BRANCH_INDEX,index);
             data1->addValue(BRANCH_FROMBUS,o_idx1);
             data1->addValue(BRANCH_TOBUS,p_maxBusIndex);
@@ -1141,12 +1458,9 @@ class PTI33_parser : public BasePTIParser<_network>
             boost::shared_ptr<gridpack::component::DataCollection>
               data2(new gridpack::component::DataCollection);
             p_branchData.push_back(data2);
-            p_istream.nextLine(line);
-            std::vector<std::string> split_line4;
-            this->cleanComment(line);
-            boost::split(split_line4, line, boost::algorithm::is_any_of(","),
-                boost::token_compress_off);
-            parse3WindXForm(split_line4, &windv, &ang, &ratea, &rateb, &ratec);
+            p_istream.nextLine(&line,&len);
+            tokens4.split(line,len);
+            parse3WindXForm(tokens4, &windv, &ang, &ratea, &rateb, &ratec);
             data2->addValue(BRANCH_INDEX,index);
             data2->addValue(BRANCH_FROMBUS,o_idx2);
             data2->addValue(BRANCH_TOBUS,p_maxBusIndex);
@@ -1176,12 +1490,9 @@ class PTI33_parser : public BasePTIParser<_network>
             boost::shared_ptr<gridpack::component::DataCollection>
               data3(new gridpack::component::DataCollection);
             p_branchData.push_back(data3);
-            p_istream.nextLine(line);
-            std::vector<std::string> split_line5;
-            this->cleanComment(line);
-            boost::split(split_line5, line, boost::algorithm::is_any_of(","),
-                boost::token_compress_off);
-            parse3WindXForm(split_line5, &windv, &ang, &ratea, &rateb, &ratec);
+            p_istream.nextLine(&line,&len);
+            tokens5.split(line,len);
+            parse3WindXForm(tokens5, &windv, &ang, &ratea, &rateb, &ratec);
             data3->addValue(BRANCH_INDEX,index);
             data3->addValue(BRANCH_FROMBUS,o_idx3);
             data3->addValue(BRANCH_TOBUS,p_maxBusIndex);
@@ -1207,31 +1518,22 @@ class PTI33_parser : public BasePTIParser<_network>
             }
           } else {
             // Skip 3-winding transformers (for now)
-            p_istream.nextLine(line);
-            p_istream.nextLine(line);
-            p_istream.nextLine(line);
-            p_istream.nextLine(line);
+            p_istream.nextLine(&line,&len);
+            p_istream.nextLine(&line,&len);
+            p_istream.nextLine(&line,&len);
+            p_istream.nextLine(&line,&len);
             continue;
           }
         } else {
-          int ntoken = split_line.size();
-          p_istream.nextLine(line);
-          std::vector<std::string>  split_line2;
-          this->cleanComment(line);
-          boost::split(split_line2, line, boost::algorithm::is_any_of(","),
-              boost::token_compress_off);
-
-          p_istream.nextLine(line);
-          std::vector<std::string>  split_line3;
-          this->cleanComment(line);
-          boost::split(split_line3, line, boost::algorithm::is_any_of(","),
-              boost::token_compress_off);
-
-          p_istream.nextLine(line);
-          std::vector<std::string>  split_line4;
-          this->cleanComment(line);
-          boost::split(split_line4, line, boost::algorithm::is_any_of(","),
-              boost::token_compress_off);
+          int ntoken = tokens.size();
+          p_istream.nextLine(&line,&len);
+          tokens2.split(line,len);
+
+          p_istream.nextLine(&line,&len);
+          tokens3.split(line,len);
+
+          p_istream.nextLine(&line,&len);
+          tokens4.split(line,len);
           // find branch corresponding to this transformer line. If it doesn't
           // exist, create one
           int l_idx = 0;
@@ -1292,7 +1594,8 @@ class PTI33_parser : public BasePTIParser<_network>
 
           // Clean up 2 character tag
           gridpack::utility::StringUtils util;
-          std::string tag = util.clean2Char(split_line[3]);
+          std::string tag_fld = tokens.getString(3);
+          std::string tag = util.clean2Char(tag_fld);
           // BRANCH_CKT          "CKT"                 character
           p_branchData[l_idx]->addValue(BRANCH_CKT, tag.c_str(), nelems);
 
@@ -1302,105 +1605,105 @@ class PTI33_parser : public BasePTIParser<_network>
            * TRANSFORMER_CW
            */
           p_branchData[l_idx]->addValue(TRANSFORMER_CW,
-              atoi(split_line[4].c_str()),nelems);
+              tokens.getInt(4),nelems);
 
           /*
            * type: integer
            * TRANSFORMER_CZ
            */
           p_branchData[l_idx]->addValue(TRANSFORMER_CZ,
-              atoi(split_line[5].c_str()),nelems);
+              tokens.getInt(5),nelems);
 
           /*
            * type: integer
            * TRANSFORMER_CM
            */
           p_branchData[l_idx]->addValue(TRANSFORMER_CM,
-              atoi(split_line[6].c_str()),nelems);
+              tokens.getInt(6),nelems);
 
           /*
            * type: float
            * TRANSFORMER_MAG1
            */
           p_branchData[l_idx]->addValue(TRANSFORMER_MAG1,
-              atof(split_line[7].c_str()),nelems);
+              tokens.getDouble(7),nelems);
 
           /*
            * type: float
            * TRANSFORMER_MAG2
            */
           p_branchData[l_idx]->addValue(TRANSFORMER_MAG2,
-              atof(split_line[8].c_str()),nelems);
+              tokens.getDouble(8),nelems);
 
           /*
            * type: integer
            * BRANCH_STATUS
            */
           p_branchData[l_idx]->addValue(BRANCH_STATUS,
-              atoi(split_line[11].c_str()),nelems);
+              tokens.getInt(11),nelems);
 
           /**
            * type: integer
            * TRANSFORMER_NMETR
            */
           p_branchData[l_idx]->addValue(TRANSFORMER_NMETR,
-              atoi(split_line[9].c_str()),nelems);
+              tokens.getInt(9),nelems);
 
           /*
            * type: integer
            * BRANCH_O1
            */
           if (ntoken > 12) p_branchData[l_idx]->addValue(BRANCH_O1,
-              atoi(split_line[12].c_str()), nelems);
+              tokens.getInt(12), nelems);
 
           /*
            * type: float
            * BRANCH_F1
            */
           if (ntoken > 13) p_branchData[l_idx]->addValue(BRANCH_F1,
-              atoi(split_line[13].c_str()), nelems);
+              tokens.getInt(13), nelems);
 
           /*
            * type: integer
            * BRANCH_O2
            */
           if (ntoken > 14) p_branchData[l_idx]->addValue(BRANCH_O2,
-              atoi(split_line[14].c_str()), nelems);
+              tokens.getInt(14), nelems);
 
           /*
            * type: float
            * BRANCH_F2
            */
           if (ntoken > 15) p_branchData[l_idx]->addValue(BRANCH_F2,
-              atoi(split_line[15].c_str()), nelems);
+              tokens.getInt(15), nelems);
 
           /*
            * type: integer
            * BRANCH_O3
            */
           if (ntoken > 16) p_branchData[l_idx]->addValue(BRANCH_O3,
-              atoi(split_line[16].c_str()), nelems);
+              tokens.getInt(16), nelems);
 
           /*
            * type: float
            * BRANCH_F3
            */
           if (ntoken > 17) p_branchData[l_idx]->addValue(BRANCH_F3,
-              atoi(split_line[17].c_str()), nelems);
+              tokens.getInt(17), nelems);
 
           /*
            * type: integer
            * BRANCH_O4
            */
           if (ntoken > 18) p_branchData[l_idx]->addValue(BRANCH_O4,
-              atoi(split_line[18].c_str()), nelems);
+              tokens.getInt(18), nelems);
 
           /*
            * type: float
            * BRANCH_F4
            */
           if (ntoken > 19) p_branchData[l_idx]->addValue(BRANCH_F4,
-              atoi(split_line[19].c_str()), nelems);
+              tokens.getInt(19), nelems);
 
 
           // Add parameters from line 2
@@ -1408,14 +1711,14 @@ class PTI33_parser : public BasePTIParser<_network>
            * type: float
            * SBASE2
            */
-          double sbase2 = atof(split_line2[2].c_str());
+          double sbase2 = tokens2.getDouble(2);
           p_branchData[l_idx]->addValue(TRANSFORMER_SBASE1_2,sbase2,nelems);
 
           /*
            * type: float
            * BRANCH_R
            */
-          double rval = atof(split_line2[0].c_str());
+          double rval = tokens2.getDouble(0);
           if (sbase2 == p_case_sbase || sbase2 == 0.0) {
             p_branchData[l_idx]->addValue(BRANCH_R,rval,nelems);
           } else {
@@ -1428,7 +1731,7 @@ class PTI33_parser : public BasePTIParser<_network>
            * type: float
            * BRANCH_X
            */
-          rval = atof(split_line2[1].c_str());
+          rval = tokens2.getDouble(1);
           if (sbase2 == p_case_sbase || sbase2 == 0.0) {
             p_branchData[l_idx]->addValue(BRANCH_X,rval,nelems);
           } else {
@@ -1442,8 +1745,8 @@ class PTI33_parser : public BasePTIParser<_network>
            * type: float
            * BRANCH_TAP: This is the ratio of WINDV1 and WINDV2
            */
-          double windv1 = atof(split_line3[0].c_str());
-          double windv2 = atof(split_line4[0].c_str());
+          double windv1 = tokens3.getDouble(0);
+          double windv2 = tokens4.getDouble(0);
           double tap = windv1/windv2;
           p_branchData[l_idx]->addValue(BRANCH_TAP,tap,nelems);
           p_branchData[l_idx]->addValue(TRANSFORMER_WINDV1,windv1,nelems);
@@ -1454,155 +1757,153 @@ class PTI33_parser : public BasePTIParser<_network>
            * BRANCH_SHIFT
            */
           p_branchData[l_idx]->addValue(BRANCH_SHIFT,
-              atof(split_line3[2].c_str()),nelems);
+              tokens3.getDouble(2),nelems);
           p_branchData[l_idx]->addValue(TRANSFORMER_ANG1,
-              atof(split_line3[2].c_str()),nelems);
+              tokens3.getDouble(2),nelems);
 
           /*
            * type: float
            * BRANCH_RATING_A
            */
           p_branchData[l_idx]->addValue(BRANCH_RATING_A,
-              atof(split_line3[3].c_str()),nelems);
+              tokens3.getDouble(3),nelems);
 
           /*
            * type: float
            * BRANCH_RATING_B
            */
           p_branchData[l_idx]->addValue(BRANCH_RATING_B,
-              atof(split_line3[4].c_str()),nelems);
+              tokens3.getDouble(4),nelems);
 
           /*
            * type: float
            * BRANCH_RATING_C
            */
           p_branchData[l_idx]->addValue(BRANCH_RATING_C,
-              atof(split_line3[5].c_str()),nelems);
+              tokens3.getDouble(5),nelems);
 
           /*
            * type: integer
            * TRANSFORMER_CODE1
            */
           p_branchData[l_idx]->addValue(TRANSFORMER_CODE1,
-              atoi(split_line3[6].c_str()),nelems);
+              tokens3.getInt(6),nelems);
 
           /*
            * type: float
            * TRANSFORMER_RMA
            */
           p_branchData[l_idx]->addValue(TRANSFORMER_RMA,
-              atof(split_line3[8].c_str()),nelems);
+              tokens3.getDouble(8),nelems);
 
           /*
            * type: float
            * TRANSFORMER_RMI
            */
           p_branchData[l_idx]->addValue(TRANSFORMER_RMI,
-              atof(split_line3[9].c_str()),nelems);
+              tokens3.getDouble(9),nelems);
 
           /*
            * type: float
            * TRANSFORMER_VMA
            */
           p_branchData[l_idx]->addValue(TRANSFORMER_VMA,
-              atof(split_line3[10].c_str()),nelems);
+              tokens3.getDouble(10),nelems);
 
           /*
            * type: float
            * TRANSFORMER_VMI
            */
           p_branchData[l_idx]->addValue(TRANSFORMER_VMI,
-              atof(split_line3[11].c_str()),nelems);
+              tokens3.getDouble(11),nelems);
 
           /*
            * type: integer
            * TRANSFORMER_NPT
            */
           p_branchData[l_idx]->addValue(TRANSFORMER_NTP,
-              atoi(split_line3[12].c_str()),nelems);
+              tokens3.getInt(12),nelems);
 
           /*
            * type: integer
            * TRANSFORMER_TAB
            */
           p_branchData[l_idx]->addValue(TRANSFORMER_TAB,
-              atoi(split_line3[13].c_str()),nelems);
+              tokens3.getInt(13),nelems);
 
           /*
            * type: float
            * TRANSFORMER_CR
            */
           p_branchData[l_idx]->addValue(TRANSFORMER_CR,
-              atof(split_line3[14].c_str()),nelems);
+              tokens3.getDouble(14),nelems);
 
           /*
            * type: float
            * TRANSFORMER_CI
            */
           p_branchData[l_idx]->addValue(TRANSFORMER_CX,
-              atof(split_line3[15].c_str()),nelems);
+              tokens3.getDouble(15),nelems);
 
           /*
            * type: float
            * TRANSFORMER_CNXA
            */
           p_branchData[l_idx]->addValue(TRANSFORMER_CNXA,
-              atof(split_line3[16].c_str()),nelems);
+              tokens3.getDouble(16),nelems);
 
           nelems++;
           p_branchData[l_idx]->setValue(BRANCH_NUM_ELEMENTS,nelems);
         }
-        p_istream.nextLine(line);
+        p_istream.nextLine(&line,&len);
       }
     }
 
     void find_area()
     {
-      std::string          line;
+      gridpack::parser::LineTokenizer tokens;
+      const char *line;
+      int len;
 
-      p_istream.nextLine(line); //this should be the first line of the block
+      p_istream.nextLine(&line,&len); //this should be the first line of the block
 
       int ncnt = 0;
-      while(test_end(line)) {
-        std::vector<std::string>  split_line;
-        this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+      while(test_end(line,len)) {
+        tokens.split(line,len);
 
         // AREAINTG_ISW             "I"                    integer
-        p_network_data->addValue(AREAINTG_ISW, atoi(split_line[1].c_str()),ncnt);
+        p_network_data->addValue(AREAINTG_ISW, tokens.getInt(1),ncnt);
 
         // AREAINTG_NUMBER             "I"                    integer
-        p_network_data->addValue(AREAINTG_NUMBER, atoi(split_line[0].c_str()),ncnt);
+        p_network_data->addValue(AREAINTG_NUMBER, tokens.getInt(0),ncnt);
 
         // AREAINTG_PDES          "PDES"                 float
-        p_network_data->addValue(AREAINTG_PDES, atof(split_line[2].c_str()),ncnt);
+        p_network_data->addValue(AREAINTG_PDES, tokens.getDouble(2),ncnt);
 
         // AREAINTG_PTOL          "PTOL"                 float
-        p_network_data->addValue(AREAINTG_PTOL, atof(split_line[3].c_str()),ncnt);
+        p_network_data->addValue(AREAINTG_PTOL, tokens.getDouble(3),ncnt);
 
         // AREAINTG_NAME         "ARNAM"                string
-        p_network_data->addValue(AREAINTG_NAME, split_line[4].c_str(),ncnt);
+        p_network_data->addValue(AREAINTG_NAME, tokens.getString(4).c_str(),ncnt);
         ncnt++;
 
-        p_istream.nextLine(line);
+        p_istream.nextLine(&line,&len);
       }
       p_network_data->addValue(AREA_TOTAL,ncnt);
     }
 
     void find_2term()
     {
-      std::string          line;
+      gridpack::parser::LineTokenizer tokens;
+      const char *line;
+      int len;
 
-      p_istream.nextLine(line); //this should be the first line of the block
+      p_istream.nextLine(&line,&len); //this should be the first line of the block
 
-      while(test_end(line)) {
-        std::vector<std::string>  split_line;
-        this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+      while(test_end(line,len)) {
+        tokens.split(line,len);
         int l_idx, o_idx;
-        o_idx = atoi(split_line[1].c_str());
+        o_idx = tokens.getInt(1);
 #ifdef OLD_MAP
         std::map<int, int>::iterator it;
 #else
@@ -1612,27 +1913,26 @@ class PTI33_parser : public BasePTIParser<_network>
         if (it != p_busMap.end()) {
           l_idx = it->second;
         } else {
-          p_istream.nextLine(line);
+          p_istream.nextLine(&line,&len);
           continue;
         }
 
-        p_istream.nextLine(line);
+        p_istream.nextLine(&line,&len);
       }
     }
 
     void find_vsc_line()
     {
-      std::string          line;
+      gridpack::parser::LineTokenizer tokens;
+      const char *line;
+      int len;
 
-      p_istream.nextLine(line); //this should be the first line of the block
+      p_istream.nextLine(&line,&len); //this should be the first line of the block
 
-      while(test_end(line)) {
-        std::vector<std::string>  split_line;
-        this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+      while(test_end(line,len)) {
+        tokens.split(line,len);
 
-        p_istream.nextLine(line);
+        p_istream.nextLine(&line,&len);
       }
     }
 
@@ -1642,21 +1942,20 @@ class PTI33_parser : public BasePTIParser<_network>
      */
     void find_switched_shunt()
     {
-      std::string          line;
+      gridpack::parser::LineTokenizer tokens;
+      const char *line;
+      int len;
 
-      p_istream.nextLine(line); //this should be the first line of the block
-      while(test_end(line)) {
-        std::vector<std::string>  split_line;
-        this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+      p_istream.nextLine(&line,&len); //this should be the first line of the block
+      while(test_end(line,len)) {
+        tokens.split(line,len);
 
         /*
          * type: integer
          * #define SWSHUNT_BUSNUMBER "SWSHUNT_BUSNUMBER"
          */
         int l_idx, o_idx;
-        l_idx = atoi(split_line[0].c_str());
+        l_idx = tokens.getInt(0);
 #ifdef OLD_MAP
         std::map<int, int>::iterator it;
 #else
@@ -1666,191 +1965,190 @@ class PTI33_parser : public BasePTIParser<_network>
         if (it != p_busMap.end()) {
           o_idx = it->second;
         } else {
-          p_istream.nextLine(line);
+          p_istream.nextLine(&line,&len);
           continue;
         }
-        int nval = split_line.size();
+        int nval = tokens.size();
 
-        p_busData[o_idx]->addValue(SWSHUNT_BUSNUMBER, atoi(split_line[0].c_str()));
+        p_busData[o_idx]->addValue(SWSHUNT_BUSNUMBER, tokens.getInt(0));
 
         /*
          * type: integer
          * #define SHUNT_MODSW "SHUNT_MODSW"
          */
-        p_busData[o_idx]->addValue(SHUNT_MODSW, atoi(split_line[1].c_str()));
+        p_busData[o_idx]->addValue(SHUNT_MODSW, tokens.getInt(1));
 
         /*
          * type: integer
          * #define SHUNT_ADJM "SHUNT_ADJM"
          */
-        p_busData[o_idx]->addValue(SHUNT_ADJM, atoi(split_line[2].c_str()));
+        p_busData[o_idx]->addValue(SHUNT_ADJM, tokens.getInt(2));
 
         /*
          * type: integer
          * #define SHUNT_SWCH_STAT "SHUNT_SWCH_STAT"
          */
-        p_busData[o_idx]->addValue(SHUNT_SWCH_STAT, atoi(split_line[3].c_str()));
+        p_busData[o_idx]->addValue(SHUNT_SWCH_STAT, tokens.getInt(3));
 
         /*
          * type: real float
          * #define SHUNT_VSWHI "SHUNT_VSWHI"
          */
-        p_busData[o_idx]->addValue(SHUNT_VSWHI, atof(split_line[4].c_str()));
+        p_busData[o_idx]->addValue(SHUNT_VSWHI, tokens.getDouble(4));
 
         /*
          * type: real float
          * #define SHUNT_VSWLO "SHUNT_VSWLO"
          */
-        p_busData[o_idx]->addValue(SHUNT_VSWLO, atof(split_line[5].c_str()));
+        p_busData[o_idx]->addValue(SHUNT_VSWLO, tokens.getDouble(5));
 
         /*
          * type: integer
          * #define SHUNT_SWREM "SHUNT_SWREM"
          */
-        p_busData[o_idx]->addValue(SHUNT_SWREM, atoi(split_line[6].c_str()));
+        p_busData[o_idx]->addValue(SHUNT_SWREM, tokens.getInt(6));
 
         /*
          * type: real float
          * #define SHUNT_RMPCT "SHUNT_RMPCT"
          */
-        p_busData[o_idx]->addValue(SHUNT_RMPCT, atof(split_line[7].c_str()));
+        p_busData[o_idx]->addValue(SHUNT_RMPCT, tokens.getDouble(7));
 
         /*
          * type: string
          * #define SHUNT_RMIDNT "SHUNT_RMIDNT"
          */
-        p_busData[o_idx]->addValue(SHUNT_RMIDNT, split_line[8].c_str());
+        p_busData[o_idx]->addValue(SHUNT_RMIDNT, tokens.getString(8).c_str());
 
         /*
          * type: real float
          * #define SHUNT_BINIT "SHUNT_BINIT"
          */
-        p_busData[o_idx]->addValue(SHUNT_BINIT, atof(split_line[9].c_str()));
+        p_busData[o_idx]->addValue(SHUNT_BINIT, tokens.getDouble(9));
 
         if (nval > 10)
-        p_busData[o_idx]->addValue(SHUNT_N1, atoi(split_line[10].c_str()));
+        p_busData[o_idx]->addValue(SHUNT_N1, tokens.getInt(10));
 
         /*
          * type: integer
          * #define SHUNT_N2 "SHUNT_N2"
          */
         if (nval > 12)
-          p_busData[o_idx]->addValue(SHUNT_N2, atoi(split_line[12].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_N2, tokens.getInt(12));
 
         /*
          * type: integer
          * #define SHUNT_N3 "SHUNT_N3"
          */
         if (nval > 14)
-          p_busData[o_idx]->addValue(SHUNT_N3, atoi(split_line[14].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_N3, tokens.getInt(14));
 
         /*
          * type: integer
          * #define SHUNT_N4 "SHUNT_N4"
          */
         if (nval > 16)
-          p_busData[o_idx]->addValue(SHUNT_N4, atoi(split_line[16].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_N4, tokens.getInt(16));
 
         /*
          * type: integer
          * #define SHUNT_N5 "SHUNT_N5"
          */
         if (nval > 18)
-          p_busData[o_idx]->addValue(SHUNT_N5, atoi(split_line[18].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_N5, tokens.getInt(18));
 
         /*
          * type: integer
          * #define SHUNT_N6 "SHUNT_N6"
          */
         if (nval > 20)
-          p_busData[o_idx]->addValue(SHUNT_N6, atoi(split_line[20].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_N6, tokens.getInt(20));
 
         /*
          * type: integer
          * #define SHUNT_N7 "SHUNT_N7"
          */
         if (nval > 22) 
-          p_busData[o_idx]->addValue(SHUNT_N7, atoi(split_line[22].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_N7, tokens.getInt(22));
 
         /*
          * type: integer
          * #define SHUNT_N8 "SHUNT_N8"
          */
         if (nval > 24) 
-          p_busData[o_idx]->addValue(SHUNT_N8, atoi(split_line[24].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_N8, tokens.getInt(24));
 
         /*
          * type: real float
          * #define SHUNT_B1 "SHUNT_B1"
          */
         if (nval > 11) 
-          p_busData[o_idx]->addValue(SHUNT_B1, atof(split_line[11].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_B1, tokens.getDouble(11));
 
         /*
          * type: real float
          * #define SHUNT_B2 "SHUNT_B2"
          */
         if (nval > 13) 
-          p_busData[o_idx]->addValue(SHUNT_B2, atof(split_line[13].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_B2, tokens.getDouble(13));
 
         /*
          * type: real float
          * #define SHUNT_B3 "SHUNT_B3"
          */
         if (nval > 15) 
-          p_busData[o_idx]->addValue(SHUNT_B3, atof(split_line[15].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_B3, tokens.getDouble(15));
 
         /*
          * type: real float
          * #define SHUNT_B4 "SHUNT_B4"
          */
         if (nval > 17) 
-          p_busData[o_idx]->addValue(SHUNT_B4, atof(split_line[17].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_B4, tokens.getDouble(17));
 
         /*
          * type: real float
          * #define SHUNT_B5 "SHUNT_B5"
          */
         if (nval > 19) 
-          p_busData[o_idx]->addValue(SHUNT_B5, atof(split_line[19].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_B5, tokens.getDouble(19));
 
         /*
          * type: real float
          * #define SHUNT_B6 "SHUNT_B6"
          */
         if (nval > 21) 
-          p_busData[o_idx]->addValue(SHUNT_B6, atof(split_line[21].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_B6, tokens.getDouble(21));
 
         /*
          * type: real float
          * #define SHUNT_B7 "SHUNT_B7"
          */
         if (nval > 23) 
-          p_busData[o_idx]->addValue(SHUNT_B7, atof(split_line[23].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_B7, tokens.getDouble(23));
 
         /*
          * type: real float
          * #define SHUNT_B8 "SHUNT_B8"
          */
         if (nval > 25) 
-          p_busData[o_idx]->addValue(SHUNT_B8, atof(split_line[25].c_str()));
+          p_busData[o_idx]->addValue(SHUNT_B8, tokens.getDouble(25));
 
-        p_istream.nextLine(line);
+        p_istream.nextLine(&line,&len);
       }
     }
 
     void find_imped_corr()
     {
-      std::string          line;
+      gridpack::parser::LineTokenizer tokens;
+      const char *line;
+      int len;
 
-      p_istream.nextLine(line); //this should be the first line of the block
+      p_istream.nextLine(&line,&len); //this should be the first line of the block
 
-      while(test_end(line)) {
-        std::vector<std::string>  split_line;
-        this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
-        int nval = split_line.size();
+      while(test_end(line,len)) {
+        tokens.split(line,len);
+        int nval = tokens.size();
         int entries = nval-1;
         entries =  entries - entries%2;
         entries = entries/2;
@@ -1862,7 +2160,7 @@ class PTI33_parser : public BasePTIParser<_network>
          * type: integer
          * #define XFMR_CORR_TABLE_NUMBER "XFMR_CORR_TABLE_NUMBER"
          */
-        int tableid = atoi(split_line[0].c_str());
+        int tableid = tokens.getInt(0);
         data->addValue(XFMR_CORR_TABLE_NUMBER, tableid);
 
         int i;
@@ -1873,48 +2171,48 @@ class PTI33_parser : public BasePTIParser<_network>
            * #define XFMR_CORR_TABLE_Ti "XFMR_CORR_TABLE_Ti"
            */
           sprintf(buf,"XFMR_CORR_TABLE_T%d",i+1);
-          data->addValue(buf, atof(split_line[1+2*i].c_str()));
+          data->addValue(buf, tokens.getDouble(1+2*i));
 
           /*
            * type: real float
            * #define XFMR_CORR_TABLE_Fi "XFMR_CORR_TABLE_Fi"
            */
           sprintf(buf,"XFMR_CORR_TABLE_F%d",i+1);
-          data->addValue(buf, atof(split_line[2+2*i].c_str()));
+          data->addValue(buf, tokens.getDouble(2+2*i));
         }
 
         p_imp_corr_table.insert(std::pair<int,
             boost::shared_ptr<gridpack::component::DataCollection> >(tableid,data));
-        p_istream.nextLine(line);
+        p_istream.nextLine(&line,&len);
       }
     }
 
     void find_multi_term()
     {
-      std::string          line;
+      const char *line;
+      int len;
 
-      p_istream.nextLine(line); //this should be the first line of the block
+      p_istream.nextLine(&line,&len); //this should be the first line of the block
 
-      while(test_end(line)) {
+      while(test_end(line,len)) {
         // TODO: parse something here
-        p_istream.nextLine(line);
+        p_istream.nextLine(&line,&len);
       }
     }
 
     void find_multi_section()
     {
-      std::string          line;
+      gridpack::parser::LineTokenizer tokens;
+      const char *line;
+      int len;
 
-      p_istream.nextLine(line); //this should be the first line of the block
+      p_istream.nextLine(&line,&len); //this should be the first line of the block
 
-      while(test_end(line)) {
-        std::vector<std::string>  split_line;
-        this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+      while(test_end(line,len)) {
+        tokens.split(line,len);
         int o_idx1, o_idx2;
-        o_idx1 = getBusIndex(split_line[0]);
-        o_idx2 = getBusIndex(split_line[1]);
+        o_idx1 = getBusIndex(tokens,0);
+        o_idx2 = getBusIndex(tokens,1);
 
         // find branch corresponding to this line.
         int l_idx = 0;
@@ -1940,13 +2238,14 @@ class PTI33_parser : public BasePTIParser<_network>
             found = true;
           }
         }
-        nelems = split_line.size() - 3;
+        nelems = tokens.size() - 3;
 
         if (!found || nelems <= 0) continue;
 
         // Clean up 2 character tag
         gridpack::utility::StringUtils util;
-        std::string tag = util.clean2Char(split_line[2]);
+        std::string tag_fld = tokens.getString(2);
+        std::string tag = util.clean2Char(tag_fld);
         if (tag.length() != 2 || tag[0] != '&') {
           tag = "&1";
         }
@@ -1961,17 +2260,17 @@ class PTI33_parser : public BasePTIParser<_network>
          * type: integer
          * #define MULTI_SEC_LINE_MET "MULTI_SEC_LINE_MET"
          */
-        p_branchData[l_idx]->addValue(MULTI_SEC_LINE_MET, atoi(split_line[3].c_str()));
+        p_branchData[l_idx]->addValue(MULTI_SEC_LINE_MET, tokens.getInt(3));
 
 
         int i;
         char buf[32];
         for (i=0; i<9; i++) {
           sprintf(buf,"MULTI_SEC_LINE_DUM%d",i+1);
-          p_branchData[l_idx]->addValue(buf,atoi(split_line[i+4].c_str()));
+          p_branchData[l_idx]->addValue(buf,tokens.getInt(i+4));
         }
 
-        p_istream.nextLine(line);
+        p_istream.nextLine(&line,&len);
       }
     }
 
@@ -1981,22 +2280,24 @@ class PTI33_parser : public BasePTIParser<_network>
      */
     void find_zone()
     {
-      std::string          line;
+      const char *line;
+      int len;
 
-      p_istream.nextLine(line); //this should be the first line of the block
-      while(test_end(line)) {
+      p_istream.nextLine(&line,&len); //this should be the first line of the block
+      while(test_end(line,len)) {
         // TODO: parse something here
-        p_istream.nextLine(line);
+        p_istream.nextLine(&line,&len);
       }
     }
 
     void find_interarea()
     {
-      std::string          line;
+      const char *line;
+      int len;
 
-      p_istream.nextLine(line); //this should be the first line of the block
+      p_istream.nextLine(&line,&len); //this should be the first line of the block
 
-      while(test_end(line)) {
+      while(test_end(line,len)) {
 #if 0
         std::vector<std::string>  split_line;
         boost::split(split_line, line, boost::algorithm::is_any_of(","), boost::token_compress_off);
@@ -2033,7 +2334,7 @@ class PTI33_parser : public BasePTIParser<_network>
 
         inter_area.push_back(inter_area_instance);
 #endif
-        p_istream.nextLine(line);
+        p_istream.nextLine(&line,&len);
       }
     }
 
@@ -2046,10 +2347,11 @@ class PTI33_parser : public BasePTIParser<_network>
      */
     void find_owner()
     {
-      std::string          line;
-      p_istream.nextLine(line); //this should be the first line of the block
+      const char *line;
+      int len;
+      p_istream.nextLine(&line,&len); //this should be the first line of the block
 
-      while(test_end(line)) {
+      while(test_end(line,len)) {
 #if 0
         std::vector<std::string>  split_line;
         boost::split(split_line, line, boost::algorithm::is_any_of(","), boost::token_compress_off);
@@ -2064,17 +2366,18 @@ class PTI33_parser : public BasePTIParser<_network>
 
         owner.push_back(owner_instance);
 #endif
-        p_istream.nextLine(line);
+        p_istream.nextLine(&line,&len);
       }
     }
 
     void find_facts()
     {
-      std::string          line;
-      p_istream.nextLine(line); //this should be the first line of the block
+      const char *line;
+      int len;
+      p_istream.nextLine(&line,&len); //this should be the first line of the block
 
-      while(test_end(line)) {
-        p_istream.nextLine(line);
+      while(test_end(line,len)) {
+        p_istream.nextLine(&line,&len);
       }
     }
 
@@ -2204,11 +2507,21 @@ class PTI33_parser : public BasePTIParser<_network>
      */
     bool test_end(std::string &str) const
     {
+      return test_end(str.data(), str.length());
+    }
+
+    /**
+     * Test to see if line terminates a section
+     * @param str pointer to first character of line
+     * @param len number of characters in line
+     * @return: false if first non-blank character is TERM_CHAR
+     */
+    bool test_end(const char *str, int len) const
+    {
 #if 1
-      if (str[0] == TERM_CHAR) {
+      if (len > 0 && str[0] == TERM_CHAR) {
         return false;
       }
-      int len = str.length();
       int i=0;
       while (i<len && str[i] == ' ') {
         i++;
@@ -2228,7 +2541,7 @@ class PTI33_parser : public BasePTIParser<_network>
         return true;
       }
 #else
-      if (str[0] == '0') {
+      if (len > 0 && str[0] == '0') {
         return false;
       } else {
         return true;
@@ -2251,6 +2564,19 @@ class PTI33_parser : public BasePTIParser<_network>
       }
     }
 
+    /**
+     * Test to see if line is a comment line. Check to see if first
+     * non-blank characters are "//"
+     * @param str pointer to first character of line
+     * @param len number of characters in line
+     */
+    bool check_comment(const char *str, int len) const
+    {
+      int ntok = 0;
+      while (ntok < len && str[ntok] == ' ') ntok++;
+      return (ntok+1 < len && str[ntok] == '/' && str[ntok+1] == '/');
+    }
+
     /**
      * Remove leading and trailing blanks
      */
@@ -2357,6 +2683,26 @@ class PTI33_parser : public BasePTIParser<_network>
       }
     }
 
+    /**
+     * Get bus index from a field of a record. Fields that contain a quoted
+     * bus name are handled by getBusIndex(std::string), numerical indices
+     * are converted without copying the field
+     * @param tokens record split into fields
+     * @param i field containing the bus
+     * @return bus index, or -1 if a bus name can not be found
+     */
+    int getBusIndex(const gridpack::parser::LineTokenizer &tokens, int i)
+    {
+      const char *str = tokens.field(i);
+      int len = tokens.length(i);
+      int ntok = 0;
+      while (ntok < len && str[ntok] == ' ') ntok++;
+      if (ntok < len && str[ntok] == '\'') {
+        return getBusIndex(tokens.getString(i));
+      }
+      return abs(tokens.getInt(i));
+    }
+
     /*
      * The case_data is the collection of all data points in the case file.
      * Each collection in the case data contains the data associated with a given
@@ -2419,6 +2765,8 @@ class PTI33_parser : public BasePTIParser<_network>
     int p_case_id;
     int p_maxBusIndex;
     double p_case_sbase;
+    // Read RAW file in parallel
+    bool p_parallelRead;
     gridpack::utility::CoarseTimer *p_timer;
 
     /**
@@ -13,6 +13,9 @@
 
 #define OLD_MAP
 
+// Number of .dyr records sent from process 0 in each batch
+#define DS_STREAM_BATCH 4096
+
 #include <iostream>
 #include <string>
 #include <vector>
@@ -32,6 +35,8 @@
 #include "gridpack/network/base_network.hpp"
 #include "gridpack/parser/base_parser.hpp"
 #include "gridpack/parser/hash_distr.hpp"
+#include "gridpack/parser/line_tokenizer.hpp"
+#include "gridpack/parser/record_stream.hpp"
 #include "gridpack/factory/base_factory.hpp"
 #include "parser_classes/gencls.hpp"
 #include "parser_classes/gensal.hpp"
@@ -786,37 +791,25 @@ class BasePTIParser : public BaseParser<_network>
      * This routine opens up a .dyr file with parameters for dynamic
      * simulation and distributes the parameters to whatever processor holds the
      * corresponding buses. It assumes that a .raw file has already been parsed
+     * and distributed. Records are streamed from process 0 to the processors
+     * holding each bus and are parsed there, so the complete file is never
+     * held in memory on a single processor
      */
     void getDSExternal(const std::string & fileName)
     {
 
       //      int t_ds = p_timer->createCategory("Parser:getDS");
       //      p_timer->start(t_ds);
-      int me(p_network->communicator().rank());
-
       std::vector<gen_params> gen_data;
       std::vector<bus_relay_params> bus_relay_data;
       std::vector<branch_relay_params> branch_relay_data;
       std::vector<load_params> load_data;
-      if (me == 0) {
-        p_input_stream.openFile(fileName);
-        if (!p_input_stream.isOpen()) {
-          // p_timer->stop(t_ds);
-          return;
-        }
-        find_ds_vector(&gen_data, &bus_relay_data,
-            &branch_relay_data, &load_data);
-        p_input_stream.close();
-      }
-      int nsize = gen_data.size();
+      stream_ds_vector(fileName, &gen_data, &bus_relay_data,
+          &branch_relay_data, &load_data);
+      int nsize;
       std::vector<int> buses;
       int i;
-      for (i=0; i<nsize; i++) {
-        buses.push_back(gen_data[i].bus_id);
-      }
-      gridpack::hash_distr::HashDistribution<_network,gen_params,gen_params>
-        distr(p_network);
-      distr.distributeBusValues(buses,gen_data);
+      matchBusValues(gen_data, buses);
       // Now match data with corresponding data collection objects
       gridpack::component::DataCollection *data;
       nsize = buses.size();
@@ -884,14 +877,7 @@ class BasePTIParser : public BaseParser<_network>
         }
       }
       // Add parameters for a bus relay
-      nsize = bus_relay_data.size();
-      buses.clear();
-      for (i=0; i<nsize; i++) {
-        buses.push_back(bus_relay_data[i].bus_id);
-      }
-      gridpack::hash_distr::HashDistribution<_network,bus_relay_params,
-        bus_relay_params> distr_bus(p_network);
-      distr_bus.distributeBusValues(buses,bus_relay_data);
+      matchBusValues(bus_relay_data, buses);
       // Now match data with corresponding data collection objects
       nsize = buses.size();
       for (i=0; i<nsize; i++) {
@@ -907,18 +893,9 @@ class BasePTIParser : public BaseParser<_network>
           parser.extract(bus_relay_data[i], data);
         }
       }
-      buses.clear();
       // Add parameters for a branch relay
-      nsize = branch_relay_data.size();
-      std::vector<std::pair<int,int> > branches;
       std::vector<int> lbranch;
-      for (i=0; i<nsize; i++) {
-        branches.push_back(std::pair<int,int>(branch_relay_data[i].from_bus,
-              branch_relay_data[i].to_bus));
-      }
-      gridpack::hash_distr::HashDistribution<_network,branch_relay_params,
-        branch_relay_params> distr_branch(p_network);
-      distr_branch.distributeBranchValues(branches,lbranch,branch_relay_data);
+      matchBranchValues(branch_relay_data, lbranch);
       // Now match data with corresponding data collection objects
       nsize = lbranch.size();
       for (i=0; i<nsize; i++) {
@@ -933,14 +910,7 @@ class BasePTIParser : public BaseParser<_network>
       }
 
       // Add parameters for a load
-      nsize = load_data.size();
-      buses.clear();
-      for (i=0; i<nsize; i++) {
-        buses.push_back(load_data[i].bus_id);
-      }
-      gridpack::hash_distr::HashDistribution<_network,load_params,
-        load_params> distr_load(p_network);
-      distr_load.distributeBusValues(buses,load_data);
+      matchBusValues(load_data, buses);
       // Now match data with corresponding data collection objects
       nsize = buses.size();
       for (i=0; i<nsize; i++) {
@@ -1235,6 +1205,7 @@ class BasePTIParser : public BaseParser<_network>
     void find_ds_par()
     {
       std::string          line;
+      gridpack::parser::LineTokenizer tokens(',',true);
       gridpack::component::DataCollection *data;
       while(p_input_stream.nextLine(line)) {
         // Check to see if line is blank
@@ -1248,11 +1219,8 @@ class BasePTIParser : public BaseParser<_network>
           idx = line.find('/');
           record.append(line);
         }
-        idx = record.find('/');
-        if (idx != std::string::npos) record.erase(idx,record.length()-idx);
-        std::vector<std::string>  split_line;
-        boost::split(split_line, record, boost::algorithm::is_any_of(","),
-            boost::token_compress_on);
+        tokens.split(record);
+        std::vector<std::string> &split_line = tokens.strings();
 
         std::string sval;
         // MODEL TYPE              "MODEL"                  string
@@ -1263,7 +1231,7 @@ class BasePTIParser : public BaseParser<_network>
         if (onGenerator(sval)) {
           // GENERATOR_BUSNUMBER               "I"                   integer
           int l_idx, o_idx;
-          o_idx = atoi(split_line[0].c_str());
+          o_idx = tokens.getInt(0);
 #ifdef OLD_MAP
           std::map<int, int>::iterator it;
 #else
@@ -1340,9 +1308,9 @@ class BasePTIParser : public BaseParser<_network>
         } else if (onBus(sval)) {
           int l_idx, o_idx;
           if (sval == "LVSHBL") {
-            o_idx = atoi(split_line[0].c_str());
+            o_idx = tokens.getInt(0);
           } else if (sval == "FRQTPAT") {
-            o_idx = atoi(split_line[3].c_str());
+            o_idx = tokens.getInt(3);
           }
 #ifdef OLD_MAP
           std::map<int, int>::iterator it;
@@ -1367,7 +1335,7 @@ class BasePTIParser : public BaseParser<_network>
         } else if (onLoad(sval)) {
           // Load bus number
           int l_idx, o_idx;
-          o_idx = atoi(split_line[0].c_str());
+          o_idx = tokens.getInt(0);
 #ifdef OLD_MAP
           std::map<int, int>::iterator it;
 #else
@@ -1419,8 +1387,8 @@ class BasePTIParser : public BaseParser<_network>
           }
         } else if (onBranch(sval)) {
           int l_idx, from_idx, to_idx;
-          from_idx = atoi(split_line[0].c_str());
-          to_idx = atoi(split_line[2].c_str());
+          from_idx = tokens.getInt(0);
+          to_idx = tokens.getInt(2);
           std::map<std::pair<int, int>, int>::iterator it;
           it = p_branchMap->find(std::pair<int,int>(from_idx,to_idx));
           if (it != p_branchMap->end()) {
@@ -1443,6 +1411,7 @@ class BasePTIParser : public BaseParser<_network>
         std::vector<load_params> *load_vector)
     {
       std::string          line;
+      gridpack::parser::LineTokenizer tokens(',',true);
       gen_vector->clear();
       while(p_input_stream.nextLine(line)) {
         // Check to see if line is blank
@@ -1456,202 +1425,378 @@ class BasePTIParser : public BaseParser<_network>
           idx = line.find('/');
           record.append(line);
         }
-        idx = record.find('/');
-        if (idx != std::string::npos) record.erase(idx,record.length()-idx);
-        std::vector<std::string>  split_line;
-        boost::split(split_line, record, boost::algorithm::is_any_of(","),
-            boost::token_compress_on);
-        std::string sval;
-        gridpack::utility::StringUtils util;
-        sval = util.trimQuotes(split_line[1]);
-        util.toUpper(sval);
+        parse_ds_record(record, tokens, gen_vector, bus_relay_vector,
+            branch_relay_vector, load_vector);
+      }
+    }
 
-        if (onGenerator(sval)) {
-          gen_params data;
+    /**
+     * Read a .dyr file on process 0 and send each record to all processors
+     * holding the bus it refers to (the "from" bus for branch devices).
+     * Records are routed through a directory of bus indices that is
+     * distributed over all processors and are sent in batches of
+     * DS_STREAM_BATCH records while process 0 continues to read the file in
+     * blocks of bounded size. They are parsed by the receiving processors.
+     * Records for buses that are not in the network are ignored. This is a
+     * collective operation
+     * @param fileName name of .dyr file
+     */
+    void stream_ds_vector(const std::string &fileName,
+        std::vector<gen_params> *gen_vector,
+        std::vector<bus_relay_params> *bus_relay_vector,
+        std::vector<branch_relay_params> *branch_relay_vector,
+        std::vector<load_params> *load_vector)
+    {
+      int me(p_network->communicator().rank());
+      gridpack::parser::RecordStream stream(p_network->communicator(),
+          DS_STREAM_BATCH);
+      int nbus = p_network->numBuses();
+      std::vector<int> keys(nbus);
+      int i;
+      for (i=0; i<nbus; i++) {
+        keys[i] = p_network->getOriginalBusIndex(i);
+      }
+      stream.setKeys(keys);
 
-          // GENERATOR_BUSNUMBER               "I"                   integer
-          int o_idx;
-          o_idx = atoi(split_line[0].c_str());
-          data.bus_id = o_idx;
+      gen_vector->clear();
+      bus_relay_vector->clear();
+      branch_relay_vector->clear();
+      load_vector->clear();
+      gridpack::parser::LineTokenizer tokens(',',true);
+      std::vector<std::string> records;
+      if (me == 0) {
+        p_input_stream.openFile(fileName);
+        if (p_input_stream.isOpen()) {
+          std::string line, sval;
+          gridpack::utility::StringUtils util;
+          while(p_input_stream.nextLine(line)) {
+            // Check to see if line is blank
+            int idx = line.find_first_not_of(' ');
+            if (idx == std::string::npos) continue;
+
+            std::string record = line;
+            idx = line.find('/');
+            while (idx == std::string::npos &&
+                p_input_stream.nextLine(line)) {
+              idx = line.find('/');
+              record.append(line);
+            }
+            // Only the model and bus fields are needed to route the record
+            if (tokens.split(record) < 2) continue;
+            tokens.getString(1,sval);
+            sval = util.trimQuotes(sval);
+            util.toUpper(sval);
+            int o_idx;
+            if (sval == "FRQTPAT") {
+              o_idx = tokens.getInt(3);
+            } else if (onGenerator(sval) || onBus(sval) || onLoad(sval) ||
+                onBranch(sval)) {
+              o_idx = tokens.getInt(0);
+            } else {
+              continue;
+            }
+            stream.send(record,o_idx);
+            // Parse any records that belong to this processor
+            if (stream.receive(records)) {
+              for (i=0; i<static_cast<int>(records.size()); i++) {
+                parse_ds_record(records[i], tokens, gen_vector,
+                    bus_relay_vector, branch_relay_vector, load_vector);
+              }
+            }
+          }
+          p_input_stream.close();
+        }
+        stream.finish();
+      }
+      while (stream.receive(records)) {
+        for (i=0; i<static_cast<int>(records.size()); i++) {
+          parse_ds_record(records[i], tokens, gen_vector, bus_relay_vector,
+              branch_relay_vector, load_vector);
+        }
+      }
+      const std::vector<int> &missing = stream.unresolved();
+      for (i=0; i<static_cast<int>(missing.size()); i++) {
+        printf("p[%d] Unresolved original bus index: %d\n",me,missing[i]);
+      }
+    }
 
-          // Clean up 2 character tag for generator ID
-          std::string tag = util.clean2Char(split_line[2]);
-          strcpy(data.gen_id, tag.c_str());
+    /**
+     * Match a list of values to the local buses they refer to. A value is
+     * copied for each local instance of a bus (including ghost buses). On
+     * completion, buses contains the local indices of the buses receiving
+     * data and values contains the corresponding data
+     * @param values list of values. Values must have a bus_id member
+     *        containing the original index of the bus
+     * @param buses local indices of buses
+     */
+    template<typename _data_type>
+    void matchBusValues(std::vector<_data_type> &values,
+        std::vector<int> &buses)
+    {
+      std::multimap<int,int> idxMap;
+      int nbus = p_network->numBuses();
+      int i;
+      for (i=0; i<nbus; i++) {
+        idxMap.insert(std::pair<int,int>(p_network->getOriginalBusIndex(i),i));
+      }
+      std::vector<_data_type> matched;
+      buses.clear();
+      std::multimap<int,int>::iterator it;
+      int nsize = values.size();
+      for (i=0; i<nsize; i++) {
+        it = idxMap.find(values[i].bus_id);
+        while (it != idxMap.end() && it->first == values[i].bus_id) {
+          buses.push_back(it->second);
+          matched.push_back(values[i]);
+          it++;
+        }
+      }
+      values.swap(matched);
+    }
 
-          double rval;
-          int ival;
+    /**
+     * Match a list of values to the local branches they refer to. A value
+     * is copied for each local instance of a branch. On completion, branches
+     * contains the local indices of the branches receiving data and values
+     * contains the corresponding data
+     * @param values list of values. Values must have from_bus and to_bus
+     *        members containing the original indices of the branch endpoints
+     * @param branches local indices of branches
+     */
+    template<typename _data_type>
+    void matchBranchValues(std::vector<_data_type> &values,
+        std::vector<int> &branches)
+    {
+      std::multimap<std::pair<int,int>,int> idxMap;
+      int nbranch = p_network->numBranches();
+      int i, idx1, idx2;
+      for (i=0; i<nbranch; i++) {
+        p_network->getOriginalBranchEndpoints(i,&idx1,&idx2);
+        idxMap.insert(std::pair<std::pair<int,int>,int>(
+              std::pair<int,int>(idx1,idx2),i));
+      }
+      std::vector<_data_type> matched;
+      branches.clear();
+      std::multimap<std::pair<int,int>,int>::iterator it;
+      int nsize = values.size();
+      for (i=0; i<nsize; i++) {
+        std::pair<int,int> key(values[i].from_bus,values[i].to_bus);
+        it = idxMap.find(key);
+        while (it != idxMap.end() && it->first == key) {
+          branches.push_back(it->second);
+          matched.push_back(values[i]);
+          it++;
+        }
+      }
+      values.swap(matched);
+    }
 
+    /**
+     * Parse a single record from a .dyr file and add it to the list of
+     * structs for the corresponding device type
+     * @param record complete record (continuation lines are appended)
+     * @param tokens tokenizer used to split record
+     */
+    void parse_ds_record(const std::string &record,
+        gridpack::parser::LineTokenizer &tokens,
+        std::vector<gen_params> *gen_vector,
+        std::vector<bus_relay_params> *bus_relay_vector,
+        std::vector<branch_relay_params> *branch_relay_vector,
+        std::vector<load_params> *load_vector)
+    {
+      tokens.split(record);
+      std::vector<std::string> &split_line = tokens.strings();
+      std::string sval;
+      gridpack::utility::StringUtils util;
+      sval = util.trimQuotes(split_line[1]);
+      util.toUpper(sval);
 
-          // GENERATOR_MODEL              "MODEL"                  integer
-          strcpy(data.model, sval.c_str());
+      if (onGenerator(sval)) {
+        gen_params data;
 
-          if (sval == "GENCLS") {
-            GenclsParser<gen_params> parser;
-            parser.store(split_line,data);
-          } else if (sval == "GENSAL") {
-            GensalParser<gen_params> parser;
-            parser.store(split_line,data);
-          } else if (sval == "GENROU") {
-            GenrouParser<gen_params> parser;
-            parser.store(split_line,data);
-          } else if (sval == "WSIEG1") {
-            Wsieg1Parser<gen_params> parser;
-            parser.store(split_line,data);
-          } else if (sval == "EXDC1" || sval == "EXDC2") {
-            Exdc1Parser<gen_params> parser;
-            parser.store(split_line,data);
-          } else if (sval == "ESST1A") {
-            Esst1aParser<gen_params> parser;
-            parser.store(split_line,data);
-          } else if (sval == "ESST4B") {
-            Esst4bParser<gen_params> parser;
-            parser.store(split_line,data);
-          } else if (sval == "GGOV1") {
-            Ggov1Parser<gen_params> parser;
-            parser.store(split_line,data);
-          } else if (sval == "TGOV1") {
-            Tgov1Parser<gen_params> parser;
-            parser.store(split_line,data);
-          } else if (sval == "WSHYGP") {
-            WshygpParser<gen_params> parser;
-            parser.store(split_line,data);
-          } else if (sval == "PSSSIM") {
-            PsssimParser<gen_params> parser;
-            parser.store(split_line,data);
-          }
-          gen_vector->push_back(data);
-        } else if (onBus(sval)) {
+        // GENERATOR_BUSNUMBER               "I"                   integer
+        int o_idx;
+        o_idx = tokens.getInt(0);
+        data.bus_id = o_idx;
 
-          // RELAY_BUSNUMBER               "I"                   integer
-          int o_idx;
-          if (sval == "LVSHBL") {
-            bus_relay_params data;
-            o_idx = atoi(split_line[0].c_str());
-            data.bus_id = o_idx;
-            LvshblParser<bus_relay_params> parser;
-            parser.store(split_line,data);
-            bus_relay_vector->push_back(data);
-          } else if (sval == "FRQTPAT") {
-            bus_relay_params data;
-            o_idx = atoi(split_line[3].c_str());
-            data.bus_id = o_idx;
-            FrqtpatParser<bus_relay_params> parser;
-            parser.store(split_line,data);
-            bus_relay_vector->push_back(data);
-          }
-        } else if (onLoad(sval)) {
-          // ID of bus that owns load
-          load_params data;
-          int o_idx = atoi(split_line[0].c_str());
-          data.bus_id = o_idx;
+        // Clean up 2 character tag for generator ID
+        std::string tag = util.clean2Char(split_line[2]);
+        strcpy(data.gen_id, tag.c_str());
 
-          // Clean up 2 character tag for load ID
-          std::string tag = util.clean2Char(split_line[2]);
-          strcpy(data.id, tag.c_str());
-          if (sval == "CIM6BL") {
-            Cim6blParser<load_params> parser;
-            parser.store(split_line,data);
-          } else if (sval == "IEELBL") {
-            IeelblParser<load_params> parser;
-            parser.store(split_line,data);
-          } else if (sval == "USRLOD") {
-            std::string sdev;
-            sdev = util.trimQuotes(split_line[3]);
-            if (sdev == "ACMTBLU1") {
-              Acmtblu1Parser<load_params> parser;
-              parser.store(split_line,data);
-            } else if (sdev == "CMLDBLU1") {
-              Cmldblu1Parser<load_params> parser;
-              parser.store(split_line,data);
-            }
-          }
-          load_vector->push_back(data);
-        } else if (onBranch(sval)) {
-          branch_relay_params data;
+        double rval;
+        int ival;
 
-          int from_idx, to_idx;
-          if (sval == "DISTR1") {
-            from_idx = atoi(split_line[0].c_str());
-            to_idx = atoi(split_line[3].c_str());
-            data.from_bus = from_idx;
-            data.to_bus = to_idx;
-            Distr1Parser<branch_relay_params> parser;
+
+        // GENERATOR_MODEL              "MODEL"                  integer
+        strcpy(data.model, sval.c_str());
+
+        if (sval == "GENCLS") {
+          GenclsParser<gen_params> parser;
+          parser.store(split_line,data);
+        } else if (sval == "GENSAL") {
+          GensalParser<gen_params> parser;
+          parser.store(split_line,data);
+        } else if (sval == "GENROU") {
+          GenrouParser<gen_params> parser;
+          parser.store(split_line,data);
+        } else if (sval == "WSIEG1") {
+          Wsieg1Parser<gen_params> parser;
+          parser.store(split_line,data);
+        } else if (sval == "EXDC1" || sval == "EXDC2") {
+          Exdc1Parser<gen_params> parser;
+          parser.store(split_line,data);
+        } else if (sval == "ESST1A") {
+          Esst1aParser<gen_params> parser;
+          parser.store(split_line,data);
+        } else if (sval == "ESST4B") {
+          Esst4bParser<gen_params> parser;
+          parser.store(split_line,data);
+        } else if (sval == "GGOV1") {
+          Ggov1Parser<gen_params> parser;
+          parser.store(split_line,data);
+        } else if (sval == "TGOV1") {
+          Tgov1Parser<gen_params> parser;
+          parser.store(split_line,data);
+        } else if (sval == "WSHYGP") {
+          WshygpParser<gen_params> parser;
+          parser.store(split_line,data);
+        } else if (sval == "PSSSIM") {
+          PsssimParser<gen_params> parser;
+          parser.store(split_line,data);
+        }
+        gen_vector->push_back(data);
+      } else if (onBus(sval)) {
+
+        // RELAY_BUSNUMBER               "I"                   integer
+        int o_idx;
+        if (sval == "LVSHBL") {
+          bus_relay_params data;
+          o_idx = tokens.getInt(0);
+          data.bus_id = o_idx;
+          LvshblParser<bus_relay_params> parser;
+          parser.store(split_line,data);
+          bus_relay_vector->push_back(data);
+        } else if (sval == "FRQTPAT") {
+          bus_relay_params data;
+          o_idx = tokens.getInt(3);
+          data.bus_id = o_idx;
+          FrqtpatParser<bus_relay_params> parser;
+          parser.store(split_line,data);
+          bus_relay_vector->push_back(data);
+        }
+      } else if (onLoad(sval)) {
+        // ID of bus that owns load
+        load_params data;
+        int o_idx = tokens.getInt(0);
+        data.bus_id = o_idx;
+
+        // Clean up 2 character tag for load ID
+        std::string tag = util.clean2Char(split_line[2]);
+        strcpy(data.id, tag.c_str());
+        if (sval == "CIM6BL") {
+          Cim6blParser<load_params> parser;
+          parser.store(split_line,data);
+        } else if (sval == "IEELBL") {
+          IeelblParser<load_params> parser;
+          parser.store(split_line,data);
+        } else if (sval == "USRLOD") {
+          std::string sdev;
+          sdev = util.trimQuotes(split_line[3]);
+          if (sdev == "ACMTBLU1") {
+            Acmtblu1Parser<load_params> parser;
+            parser.store(split_line,data);
+          } else if (sdev == "CMLDBLU1") {
+            Cmldblu1Parser<load_params> parser;
             parser.store(split_line,data);
           }
-          branch_relay_vector->push_back(data);
         }
+        load_vector->push_back(data);
+      } else if (onBranch(sval)) {
+        branch_relay_params data;
+
+        int from_idx, to_idx;
+        if (sval == "DISTR1") {
+          from_idx = tokens.getInt(0);
+          to_idx = tokens.getInt(3);
+          data.from_bus = from_idx;
+          data.to_bus = to_idx;
+          Distr1Parser<branch_relay_params> parser;
+          parser.store(split_line,data);
+        }
+        branch_relay_vector->push_back(data);
       }
     }
 
     void find_uc_vector(std::vector<uc_params> *uc_vector)
     {
       std::string          line;
+      gridpack::parser::LineTokenizer tokens(',',true,false);
       uc_vector->clear();
       // Ignore first line containing header information
       p_input_stream.nextLine(line);
       while(p_input_stream.nextLine(line)) {
-        std::vector<std::string>  split_line;
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_on);
+        tokens.split(line);
 
         uc_params data;
 
-        int nstr = split_line.size();
+        int nstr = tokens.size();
         if (nstr > 1) {
-          data.type = atoi(split_line[1].c_str());
+          data.type = tokens.getInt(1);
         }
         if (nstr > 2) {
-          data.init_level = atof(split_line[2].c_str());
+          data.init_level = tokens.getDouble(2);
         }
         if (nstr > 3) {
-          data.min_gen = atof(split_line[3].c_str());
+          data.min_gen = tokens.getDouble(3);
         }
         if (nstr > 4) {
-          data.max_gen = atof(split_line[4].c_str());
+          data.max_gen = tokens.getDouble(4);
         }
         if (nstr > 5) {
-          data.max_oper = atof(split_line[5].c_str());
+          data.max_oper = tokens.getDouble(5);
         }
         if (nstr > 6) {
-          data.min_up = atof(split_line[6].c_str());
+          data.min_up = tokens.getDouble(6);
         }
         if (nstr > 7) {
-          data.min_down = atof(split_line[7].c_str());
+          data.min_down = tokens.getDouble(7);
         }
         if (nstr > 8) {
-          data.ramp_up = atof(split_line[8].c_str());
+          data.ramp_up = tokens.getDouble(8);
         }
         if (nstr > 9) {
-          data.ramp_down = atof(split_line[9].c_str());
+          data.ramp_down = tokens.getDouble(9);
         }
         if (nstr > 10) {
-          data.start_up = atof(split_line[10].c_str());
+          data.start_up = tokens.getDouble(10);
         }
         if (nstr > 11) {
-          data.const_cost = atof(split_line[11].c_str());
+          data.const_cost = tokens.getDouble(11);
         }
         if (nstr > 12) {
-          data.lin_cost = atof(split_line[12].c_str());
+          data.lin_cost = tokens.getDouble(12);
         }
         if (nstr > 13) {
-          data.co_2_cost = atof(split_line[13].c_str());
+          data.co_2_cost = tokens.getDouble(13);
         }
         if (nstr > 14) {
-          data.init_prd = atof(split_line[14].c_str());
+          data.init_prd = tokens.getDouble(14);
         }
         if (nstr > 15) {
-          data.start_cap = atof(split_line[15].c_str());
+          data.start_cap = tokens.getDouble(15);
         }
         if (nstr > 16) {
-          data.shut_cap = atof(split_line[16].c_str());
+          data.shut_cap = tokens.getDouble(16);
         }
         if (nstr > 17) {
-          data.bus_id = atoi(split_line[17].c_str());
+          data.bus_id = tokens.getInt(17);
         }
         if (nstr > 18) {
           // Clean up 2 character tag for generator ID
           gridpack::utility::StringUtils util;
-          std::string tag = util.clean2Char(split_line[18]);
+          std::string tag;
+          tokens.getString(18,tag);
+          tag = util.clean2Char(tag);
           strcpy(data.gen_id, tag.c_str());
         }
         uc_vector->push_back(data);
@@ -1671,15 +1816,26 @@ class BasePTIParser : public BaseParser<_network>
     }
 
     /**
-     * Remove comment from string (all text after a single '/' character)
+     * Remove comment from string (all text after a single '/' character
+     * that is not part of a quoted string)
      * @param string line of text to be cleaned
      */
     void cleanComment(std::string &string)
     {
-      int idx = string.find_first_of('/',0);
-      if (idx != std::string::npos) {
-        int len = string.length()-idx;
-        string.erase(idx,len);
+      // Skip over '/' characters that are part of a quoted name
+      char quote = '\0';
+      int len = string.length();
+      int i;
+      for (i=0; i<len; i++) {
+        char c = string[i];
+        if (quote != '\0') {
+          if (c == quote) quote = '\0';
+        } else if (c == '\'' || c == '"') {
+          quote = c;
+        } else if (c == '/') {
+          string.erase(i,len-i);
+          break;
+        }
       }
     }
 
@@ -1687,13 +1843,30 @@ class BasePTIParser : public BaseParser<_network>
      * Check to see if string is blank
      * @return true if no non-blank characters are found
      */
-    bool isBlank(std::string string)
+    bool isBlank(const std::string &string)
     {
       int idx = string.find_first_not_of(' ',0);
       if (idx != std::string::npos) return false;
       return true;
     }
 
+    /**
+     * Check if a field of a record only contains blanks
+     * @param tokens record split into fields
+     * @param i field index
+     * @return true if field is blank
+     */
+    bool isBlank(const gridpack::parser::LineTokenizer &tokens, int i)
+    {
+      const char *str = tokens.field(i);
+      int len = tokens.length(i);
+      int j;
+      for (j=0; j<len; j++) {
+        if (str[j] != ' ') return false;
+      }
+      return true;
+    }
+
     /* ************************************************************************
      **************************************************************************
      ***** OBJECT DATA
@@ -26,8 +26,15 @@
 
 //#define HASH_WITH_MPI
 
+#define HASH_PLAN_TAG 1002
+
+#include <mpi.h>
 #include <ga.h>
+#include <set>
+#include <map>
+#include <cstring>
 #include <boost/unordered_map.hpp>
+#include <boost/shared_ptr.hpp>
 #include "gridpack/parallel/index_hash.hpp"
 #include "gridpack/utilities/exception.hpp"
 
@@ -61,6 +68,7 @@ public:
   HashDistribution(const boost::shared_ptr<_network> network)
     : p_network(network)
   {
+    p_planComm = MPI_COMM_NULL;
 #ifndef SYSTOLIC
     p_indexHashMap.reset(new
         gridpack::hash_map::GlobalIndexHashMap(p_network->communicator()));
@@ -102,6 +110,7 @@ public:
   // Default destructor
   ~HashDistribution(void)
   {
+    if (p_planComm != MPI_COMM_NULL) MPI_Comm_free(&p_planComm);
   }
 
   // Send values corresponding to keys to the processors that own them. On
@@ -1868,8 +1877,568 @@ public:
 #endif
   }
 
+  // Create a plan for distributing bus values. The plan stores the processors
+  // that hold each key, the order in which values are sent and the local
+  // buses that receive each value, so values for the same list of keys can be
+  // distributed repeatedly without rebuilding the routing or reallocating
+  // buffers. This is a collective operation
+  // @param keys list of original bus indices of buses that receive data
+  // @return handle of plan
+  int createBusPlan(const std::vector<int> &keys)
+  {
+    std::vector<std::pair<int,int> > pkeys;
+    int i;
+    for (i=0; i<static_cast<int>(keys.size()); i++) {
+      pkeys.push_back(std::pair<int,int>(keys[i],0));
+    }
+    std::vector<std::pair<int,int> > lkeys;
+    int nbus = p_network->numBuses();
+    for (i=0; i<nbus; i++) {
+      lkeys.push_back(std::pair<int,int>(p_network->getOriginalBusIndex(i),0));
+    }
+    return buildPlan(pkeys, lkeys, true);
+  }
+
+  // Create a plan for distributing branch values. This is a collective
+  // operation
+  // @param keys list of original index pairs of branches that receive data
+  // @return handle of plan
+  int createBranchPlan(const std::vector<std::pair<int,int> > &keys)
+  {
+    std::vector<std::pair<int,int> > lkeys;
+    int nbranch = p_network->numBranches();
+    int i, idx1, idx2;
+    for (i=0; i<nbranch; i++) {
+      p_network->getOriginalBranchEndpoints(i,&idx1,&idx2);
+      lkeys.push_back(std::pair<int,int>(idx1,idx2));
+    }
+    return buildPlan(keys, lkeys, false);
+  }
+
+  // Release the buffers held by a plan. A plan with a pending distribution
+  // cannot be destroyed, since its buffers are still in use by MPI
+  // @param plan handle of plan
+  void destroyPlan(int plan)
+  {
+    if (plan >= 0 && plan < static_cast<int>(p_plans.size()) &&
+        p_plans[plan]) {
+      if (p_plans[plan]->pending) {
+        char buf[256];
+        sprintf(buf,"p[%d] HashDistribution: cannot destroy distribution"
+            " plan %d while a distribution is pending\n",
+            p_network->communicator().rank(),plan);
+        throw gridpack::Exception(buf);
+      }
+      p_plans[plan].reset();
+    }
+  }
+
+  // Send values to the processors that own the buses in a plan. On
+  // completion, keys contain the local indices of the buses receiving data and
+  // values contains the data. This is a collective operation
+  // @param plan handle of plan created with createBusPlan
+  // @param keys on output, a list of local bus indices
+  // @param values on input, a list of values corresponding to the keys used
+  // to create the plan, on output, the values of the received data
+  void distributeBusValues(int plan, std::vector<int> &keys,
+      std::vector<_bus_data_type> &values)
+  {
+    startBusValues(plan, values);
+    completeBusValues(plan, keys, values);
+  }
+
+  // Start sending bus values using a plan without waiting for the values to
+  // arrive. The values are copied into the plan's buffers, so the input
+  // vector can be modified as soon as this call returns. This is a collective
+  // operation and must be followed by completeBusValues
+  // @param plan handle of plan created with createBusPlan
+  // @param values list of values corresponding to the keys used to create the
+  // plan
+  void startBusValues(int plan, const std::vector<_bus_data_type> &values)
+  {
+    startPlan(getPlan(plan,true), values);
+  }
+
+  // Wait for bus values started with startBusValues to arrive
+  // @param plan handle of plan
+  // @param keys on output, a list of local bus indices
+  // @param values on output, the values of the received data
+  void completeBusValues(int plan, std::vector<int> &keys,
+      std::vector<_bus_data_type> &values)
+  {
+    completePlan(getPlan(plan,true), keys, values);
+  }
+
+  // Send a fixed number of values per key to the processors that own the
+  // buses in a plan. As with the version of distributeBusValues that does not
+  // use a plan, the input arrays are deleted and the output arrays are
+  // allocated inside this call and must be deleted by the calling program.
+  // This is a collective operation
+  // @param plan handle of plan created with createBusPlan
+  // @param keys on output, a list of local bus indices
+  // @param values on input, a list of arrays corresponding to the keys used
+  // to create the plan, on output, the arrays of received data
+  // @param nvals number of values in each array
+  void distributeBusValues(int plan, std::vector<int> &keys,
+      std::vector<_bus_data_type*> &values, int nvals)
+  {
+    distr_plan &bplan = getPlan(plan,true);
+    startPlan(bplan, values, nvals);
+    int i;
+    for (i=0; i<static_cast<int>(values.size()); i++) {
+      delete [] values[i];
+    }
+    values.clear();
+    completePlan(bplan, keys, values, nvals);
+  }
+
+  // Send values to the processors that own the branches in a plan. This is a
+  // collective operation
+  // @param plan handle of plan created with createBranchPlan
+  // @param branch_ids on output, contains the local indices of branches that
+  // receive data
+  // @param values on input, a list of values corresponding to the keys used
+  // to create the plan, on output, the values of the received data
+  void distributeBranchValues(int plan, std::vector<int> &branch_ids,
+      std::vector<_branch_data_type> &values)
+  {
+    startBranchValues(plan, values);
+    completeBranchValues(plan, branch_ids, values);
+  }
+
+  // Start sending branch values using a plan without waiting for the values
+  // to arrive. This is a collective operation and must be followed by
+  // completeBranchValues
+  // @param plan handle of plan created with createBranchPlan
+  // @param values list of values corresponding to the keys used to create the
+  // plan
+  void startBranchValues(int plan, const std::vector<_branch_data_type> &values)
+  {
+    startPlan(getPlan(plan,false), values);
+  }
+
+  // Wait for branch values started with startBranchValues to arrive
+  // @param plan handle of plan
+  // @param branch_ids on output, contains the local indices of branches that
+  // receive data
+  // @param values on output, the values of the received data
+  void completeBranchValues(int plan, std::vector<int> &branch_ids,
+      std::vector<_branch_data_type> &values)
+  {
+    completePlan(getPlan(plan,false), branch_ids, values);
+  }
+
+  // Send a fixed number of values per key to the processors that own the
+  // branches in a plan. The input arrays are deleted and the output arrays
+  // must be deleted by the calling program. This is a collective operation
+  // @param plan handle of plan created with createBranchPlan
+  // @param branch_ids on output, contains the local indices of branches that
+  // receive data
+  // @param values on input, a list of arrays corresponding to the keys used
+  // to create the plan, on output, the arrays of received data
+  // @param nvals number of values in each array
+  void distributeBranchValues(int plan, std::vector<int> &branch_ids,
+      std::vector<_branch_data_type*> &values, int nvals)
+  {
+    distr_plan &bplan = getPlan(plan,false);
+    startPlan(bplan, values, nvals);
+    int i;
+    for (i=0; i<static_cast<int>(values.size()); i++) {
+      delete [] values[i];
+    }
+    values.clear();
+    completePlan(bplan, branch_ids, values, nvals);
+  }
+
 private:
 
+  // Routing and buffers for repeated distributions of values for the same
+  // list of keys. Slots are the copies of values that are sent to each
+  // processor, ordered by destination
+  struct distr_plan {
+    bool bus;
+    int nkeys;
+    bool pending;
+    // message tag used by this plan, so that distributions using different
+    // plans can be in progress at the same time
+    int tag;
+    // processors that receive values from this processor and offsets of
+    // their slots
+    std::vector<int> sendProcs;
+    std::vector<int> sendOffset;
+    // index of input value for each slot
+    std::vector<int> sendIndex;
+    // processors that send values to this processor and offsets of their
+    // slots
+    std::vector<int> recvProcs;
+    std::vector<int> recvOffset;
+    // local indices receiving each received slot
+    std::vector<int> localOffset;
+    std::vector<int> localIndex;
+    std::vector<char> sendBuf;
+    std::vector<char> recvBuf;
+    std::vector<MPI_Request> requests;
+  };
+
+  // Return a plan, checking that the handle is valid
+  // @param plan handle of plan
+  // @param bus true if plan is used for bus values
+  distr_plan& getPlan(int plan, bool bus)
+  {
+    if (plan < 0 || plan >= static_cast<int>(p_plans.size()) ||
+        !p_plans[plan] || p_plans[plan]->bus != bus) {
+      char buf[256];
+      sprintf(buf,"HashDistribution: invalid %s distribution plan: %d\n",
+          bus ? "bus" : "branch", plan);
+      throw gridpack::Exception(buf);
+    }
+    return *p_plans[plan];
+  }
+
+  // Processor holding directory entry for a key
+  // @param key index pair
+  // @param nprocs number of processors
+  int planHash(const std::pair<int,int> &key, int nprocs)
+  {
+    unsigned int hash = static_cast<unsigned int>(key.first)*2654435761u
+      + static_cast<unsigned int>(key.second)*40503u;
+    return static_cast<int>((hash>>7)%static_cast<unsigned int>(nprocs));
+  }
+
+  // Send lists of integers to all other processors. This is a collective
+  // operation
+  // @param sbuf list of integers going to each processor
+  // @param rbuf list of integers received from each processor
+  void exchangeInts(std::vector<std::vector<int> > &sbuf,
+      std::vector<std::vector<int> > &rbuf)
+  {
+    int nprocs = sbuf.size();
+    int p;
+    std::vector<int> scount(nprocs), rcount(nprocs);
+    std::vector<int> soff(nprocs), roff(nprocs);
+    int stotal = 0;
+    for (p=0; p<nprocs; p++) {
+      scount[p] = sbuf[p].size();
+      soff[p] = stotal;
+      stotal += scount[p];
+    }
+    MPI_Alltoall(&scount[0],1,MPI_INT,&rcount[0],1,MPI_INT,p_planComm);
+    int rtotal = 0;
+    for (p=0; p<nprocs; p++) {
+      roff[p] = rtotal;
+      rtotal += rcount[p];
+    }
+    std::vector<int> sdata(stotal+1), rdata(rtotal+1);
+    for (p=0; p<nprocs; p++) {
+      if (scount[p] > 0) std::copy(sbuf[p].begin(),sbuf[p].end(),
+          sdata.begin()+soff[p]);
+    }
+    MPI_Alltoallv(&sdata[0],&scount[0],&soff[0],MPI_INT,&rdata[0],
+        &rcount[0],&roff[0],MPI_INT,p_planComm);
+    rbuf.resize(nprocs);
+    for (p=0; p<nprocs; p++) {
+      rbuf[p].assign(rdata.begin()+roff[p],rdata.begin()+roff[p]+rcount[p]);
+    }
+  }
+
+  // Build routing for a list of keys. Each processor registers the keys it
+  // holds with a directory processor chosen by hashing the key. Keys that
+  // are to be sent are looked up in the directory and the resulting list of
+  // destinations is sent to the receiving processors, which resolve each
+  // key to its local indices. This is a collective operation
+  // @param keys keys of values that will be sent from this processor
+  // @param lkeys keys of all local buses or branches, indexed by local index
+  // @param bus true if plan is used for bus values
+  // @return handle of plan
+  int buildPlan(const std::vector<std::pair<int,int> > &keys,
+      const std::vector<std::pair<int,int> > &lkeys, bool bus)
+  {
+    if (p_planComm == MPI_COMM_NULL) {
+      MPI_Comm_dup(static_cast<MPI_Comm>(p_network->communicator()),
+          &p_planComm);
+    }
+    int nprocs = p_network->communicator().size();
+    int i, j, p;
+    std::vector<std::vector<int> > sbuf(nprocs), rbuf;
+
+    // Register local keys with directory
+    std::set<std::pair<int,int> > unique(lkeys.begin(), lkeys.end());
+    std::set<std::pair<int,int> >::iterator its;
+    for (its = unique.begin(); its != unique.end(); its++) {
+      p = planHash(*its,nprocs);
+      sbuf[p].push_back(its->first);
+      sbuf[p].push_back(its->second);
+    }
+    exchangeInts(sbuf, rbuf);
+    std::multimap<std::pair<int,int>,int> directory;
+    for (p=0; p<nprocs; p++) {
+      for (i=0; i<static_cast<int>(rbuf[p].size()); i+=2) {
+        directory.insert(std::pair<std::pair<int,int>,int>(
+              std::pair<int,int>(rbuf[p][i],rbuf[p][i+1]),p));
+      }
+    }
+
+    // Look up processors holding each key
+    unique.clear();
+    unique.insert(keys.begin(), keys.end());
+    for (p=0; p<nprocs; p++) sbuf[p].clear();
+    for (its = unique.begin(); its != unique.end(); its++) {
+      p = planHash(*its,nprocs);
+      sbuf[p].push_back(its->first);
+      sbuf[p].push_back(its->second);
+    }
+    std::vector<std::vector<int> > queries;
+    exchangeInts(sbuf, queries);
+    std::multimap<std::pair<int,int>,int>::iterator itd;
+    for (p=0; p<nprocs; p++) {
+      sbuf[p].clear();
+      for (i=0; i<static_cast<int>(queries[p].size()); i+=2) {
+        std::pair<int,int> key(queries[p][i],queries[p][i+1]);
+        int nloc = sbuf[p].size();
+        sbuf[p].push_back(0);
+        itd = directory.find(key);
+        while (itd != directory.end() && itd->first == key) {
+          sbuf[p].push_back(itd->second);
+          sbuf[p][nloc]++;
+          itd++;
+        }
+      }
+    }
+    directory.clear();
+    exchangeInts(sbuf, rbuf);
+    // Replies are in the same order as the queries
+    std::map<std::pair<int,int>,std::vector<int> > owners;
+    std::vector<int> qpos(nprocs,0);
+    for (its = unique.begin(); its != unique.end(); its++) {
+      p = planHash(*its,nprocs);
+      int n = rbuf[p][qpos[p]];
+      std::vector<int> &procs = owners[*its];
+      procs.assign(rbuf[p].begin()+qpos[p]+1,rbuf[p].begin()+qpos[p]+1+n);
+      qpos[p] += n+1;
+    }
+
+    // Create send schedule
+    boost::shared_ptr<distr_plan> plan(new distr_plan);
+    plan->bus = bus;
+    plan->nkeys = keys.size();
+    plan->pending = false;
+    // Plans are created collectively in the same order on all processors,
+    // so the handle identifies the plan on every processor
+    plan->tag = HASH_PLAN_TAG + p_plans.size();
+    int *tag_ub;
+    int flag;
+    MPI_Comm_get_attr(p_planComm,MPI_TAG_UB,&tag_ub,&flag);
+    if (flag && plan->tag > *tag_ub) {
+      char buf[256];
+      sprintf(buf,"p[%d] HashDistribution: too many distribution plans: %d\n",
+          p_network->communicator().rank(),
+          static_cast<int>(p_plans.size())+1);
+      throw gridpack::Exception(buf);
+    }
+    std::vector<std::vector<int> > slots(nprocs);
+    for (p=0; p<nprocs; p++) sbuf[p].clear();
+    for (i=0; i<static_cast<int>(keys.size()); i++) {
+      std::vector<int> &procs = owners[keys[i]];
+      for (j=0; j<static_cast<int>(procs.size()); j++) {
+        slots[procs[j]].push_back(i);
+        sbuf[procs[j]].push_back(keys[i].first);
+        sbuf[procs[j]].push_back(keys[i].second);
+      }
+    }
+    plan->sendOffset.push_back(0);
+    for (p=0; p<nprocs; p++) {
+      if (slots[p].size() == 0) continue;
+      plan->sendProcs.push_back(p);
+      plan->sendIndex.insert(plan->sendIndex.end(),slots[p].begin(),
+          slots[p].end());
+      plan->sendOffset.push_back(plan->sendIndex.size());
+    }
+
+    // Send keys to receiving processors and create receive schedule
+    exchangeInts(sbuf, rbuf);
+    std::multimap<std::pair<int,int>,int> lmap;
+    for (i=0; i<static_cast<int>(lkeys.size()); i++) {
+      lmap.insert(std::pair<std::pair<int,int>,int>(lkeys[i],i));
+    }
+    plan->recvOffset.push_back(0);
+    plan->localOffset.push_back(0);
+    int nslot = 0;
+    for (p=0; p<nprocs; p++) {
+      if (rbuf[p].size() == 0) continue;
+      plan->recvProcs.push_back(p);
+      for (i=0; i<static_cast<int>(rbuf[p].size()); i+=2) {
+        std::pair<int,int> key(rbuf[p][i],rbuf[p][i+1]);
+        itd = lmap.find(key);
+        while (itd != lmap.end() && itd->first == key) {
+          plan->localIndex.push_back(itd->second);
+          itd++;
+        }
+        plan->localOffset.push_back(plan->localIndex.size());
+        nslot++;
+      }
+      plan->recvOffset.push_back(nslot);
+    }
+    p_plans.push_back(plan);
+    return p_plans.size()-1;
+  }
+
+  // Check that a plan can be started and size its buffers
+  // @param plan distribution plan
+  // @param nvalues number of values supplied by the calling program
+  // @param size number of bytes sent for each key
+  void preparePlan(distr_plan &plan, int nvalues, int size)
+  {
+    int me = p_network->communicator().rank();
+    if (plan.pending) {
+      char buf[256];
+      sprintf(buf,"p[%d] HashDistribution: distribution plan is already in"
+          " use\n",me);
+      throw gridpack::Exception(buf);
+    }
+    if (nvalues != plan.nkeys) {
+      char buf[256];
+      sprintf(buf,"p[%d] HashDistribution: number of values %d does not match"
+          " number of keys in plan %d\n",me,nvalues,plan.nkeys);
+      throw gridpack::Exception(buf);
+    }
+    int nsend = plan.sendIndex.size();
+    int nrecv = plan.localOffset.size()-1;
+    plan.sendBuf.resize(nsend*size+1);
+    plan.recvBuf.resize(nrecv*size+1);
+  }
+
+  // Post sends and receives for a plan once the send buffer has been filled
+  // @param plan distribution plan
+  // @param size number of bytes sent for each key
+  void postPlan(distr_plan &plan, int size)
+  {
+    plan.requests.clear();
+    MPI_Request request;
+    int i;
+    for (i=0; i<static_cast<int>(plan.recvProcs.size()); i++) {
+      int first = plan.recvOffset[i];
+      int count = (plan.recvOffset[i+1]-first)*size;
+      MPI_Irecv(&plan.recvBuf[first*size],count,MPI_BYTE,plan.recvProcs[i],
+          plan.tag,p_planComm,&request);
+      plan.requests.push_back(request);
+    }
+    for (i=0; i<static_cast<int>(plan.sendProcs.size()); i++) {
+      int first = plan.sendOffset[i];
+      int count = (plan.sendOffset[i+1]-first)*size;
+      MPI_Isend(&plan.sendBuf[first*size],count,MPI_BYTE,plan.sendProcs[i],
+          plan.tag,p_planComm,&request);
+      plan.requests.push_back(request);
+    }
+    plan.pending = true;
+  }
+
+  // Wait for the messages of a pending plan to complete
+  // @param plan distribution plan
+  void waitPlan(distr_plan &plan)
+  {
+    if (!plan.pending) {
+      throw gridpack::Exception(
+          "HashDistribution: no distribution is pending for plan");
+    }
+    if (plan.requests.size() > 0) {
+      MPI_Waitall(plan.requests.size(),&plan.requests[0],MPI_STATUSES_IGNORE);
+    }
+    plan.pending = false;
+  }
+
+  // Copy values into send buffer and post sends and receives for a plan
+  // @param plan distribution plan
+  // @param values list of values corresponding to keys used to create plan
+  template <typename _data_type>
+  void startPlan(distr_plan &plan, const std::vector<_data_type> &values)
+  {
+    int size = sizeof(_data_type);
+    preparePlan(plan, values.size(), size);
+    int nsend = plan.sendIndex.size();
+    int i;
+    for (i=0; i<nsend; i++) {
+      memcpy(&plan.sendBuf[i*size],&values[plan.sendIndex[i]],size);
+    }
+    postPlan(plan, size);
+  }
+
+  // Copy arrays of values into send buffer and post sends and receives for a
+  // plan
+  // @param plan distribution plan
+  // @param values list of arrays corresponding to keys used to create plan
+  // @param nvals number of values in each array
+  template <typename _data_type>
+  void startPlan(distr_plan &plan, const std::vector<_data_type*> &values,
+      int nvals)
+  {
+    int size = nvals*sizeof(_data_type);
+    preparePlan(plan, values.size(), size);
+    int nsend = plan.sendIndex.size();
+    int i;
+    for (i=0; i<nsend; i++) {
+      memcpy(&plan.sendBuf[i*size],values[plan.sendIndex[i]],size);
+    }
+    postPlan(plan, size);
+  }
+
+  // Wait for the values sent using a plan and copy them to output arrays
+  // @param plan distribution plan
+  // @param ids local indices of buses or branches receiving data
+  // @param values received data
+  template <typename _data_type>
+  void completePlan(distr_plan &plan, std::vector<int> &ids,
+      std::vector<_data_type> &values)
+  {
+    waitPlan(plan);
+    int size = sizeof(_data_type);
+    int nrecv = plan.localOffset.size()-1;
+    ids.clear();
+    values.clear();
+    ids.reserve(plan.localIndex.size());
+    values.reserve(plan.localIndex.size());
+    int i, j;
+    _data_type data;
+    for (i=0; i<nrecv; i++) {
+      memcpy(&data,&plan.recvBuf[i*size],size);
+      for (j=plan.localOffset[i]; j<plan.localOffset[i+1]; j++) {
+        ids.push_back(plan.localIndex[j]);
+        values.push_back(data);
+      }
+    }
+  }
+
+  // Wait for the arrays sent using a plan and copy them to newly allocated
+  // output arrays
+  // @param plan distribution plan
+  // @param ids local indices of buses or branches receiving data
+  // @param values received arrays
+  // @param nvals number of values in each array
+  template <typename _data_type>
+  void completePlan(distr_plan &plan, std::vector<int> &ids,
+      std::vector<_data_type*> &values, int nvals)
+  {
+    waitPlan(plan);
+    int size = nvals*sizeof(_data_type);
+    int nrecv = plan.localOffset.size()-1;
+    ids.clear();
+    values.clear();
+    ids.reserve(plan.localIndex.size());
+    values.reserve(plan.localIndex.size());
+    int i, j;
+    for (i=0; i<nrecv; i++) {
+      for (j=plan.localOffset[i]; j<plan.localOffset[i+1]; j++) {
+        _data_type *dptr = new _data_type[nvals];
+        memcpy(dptr,&plan.recvBuf[i*size],size);
+        ids.push_back(plan.localIndex[j]);
+        values.push_back(dptr);
+      }
+    }
+  }
+
+  std::vector<boost::shared_ptr<distr_plan> > p_plans;
+
+  MPI_Comm p_planComm;
+
   // processor(s) that own  original bus index or bus index pair
   boost::shared_ptr<gridpack::hash_map::GlobalIndexHashMap> p_indexHashMap;
 
@@ -0,0 +1,302 @@
+// Emacs Mode Line: -*- Mode:c++;-*-
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   line_tokenizer.hpp
+ * @author agent
+ * @date   2026-10-17
+ *
+ * @brief
+ * Split records from PSS/E style files into fields without allocating
+ * new strings for each record. Fields are stored as offsets into a buffer
+ * owned by the tokenizer, numbers are converted directly from the buffer
+ * and the buffer, field list and (optional) list of field strings are
+ * reused from one record to the next. Delimiters inside quoted names are
+ * ignored and an unquoted '/' can be used to terminate the record.
+ *
+ */
+// -------------------------------------------------------------
+
+#ifndef _line_tokenizer_hpp_
+#define _line_tokenizer_hpp_
+
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__has_include)
+#if __has_include(<charconv>) && __cplusplus >= 201703L
+#include <charconv>
+#endif
+#endif
+
+namespace gridpack {
+namespace parser {
+
+class LineTokenizer
+{
+  public:
+    /**
+     * Constructor
+     * @param delim character separating fields
+     * @param compress if true, adjacent delimiters are treated as a single
+     *        delimiter (same as boost::token_compress_on)
+     * @param comments if true, the record ends at the first '/' that is not
+     *        inside a quoted string
+     */
+    LineTokenizer(char delim = ',', bool compress = false,
+        bool comments = true)
+      : p_delim(delim), p_compress(compress), p_comments(comments),
+      p_stringsValid(false)
+    {
+    }
+
+    /**
+     * Destructor
+     */
+    ~LineTokenizer()
+    {
+    }
+
+    /**
+     * Split a record into fields. The record is copied into a buffer owned
+     * by the tokenizer, so the original string can be modified or reused
+     * after this call. Fields are not trimmed, so the number of fields and
+     * their contents are the same as those produced by boost::split, except
+     * that delimiters inside quotes do not start a new field
+     * @param line record to be split
+     * @return number of fields
+     */
+    int split(const std::string &line)
+    {
+      return split(line.data(), line.length());
+    }
+
+    /**
+     * Split a record into fields
+     * @param line pointer to first character of record
+     * @param len number of characters in record
+     * @return number of fields
+     */
+    int split(const char *line, int len)
+    {
+      p_buffer.assign(line, len);
+      p_first.clear();
+      p_last.clear();
+      p_stringsValid = false;
+      const char *buf = p_buffer.data();
+      char quote = '\0';
+      int first = 0;
+      int i;
+      for (i=0; i<len; i++) {
+        char c = buf[i];
+        if (quote != '\0') {
+          if (c == quote) quote = '\0';
+        } else if (c == '\'' || c == '"') {
+          quote = c;
+        } else if (c == p_delim) {
+          if (!p_compress || i == 0 || buf[i-1] != p_delim) {
+            p_first.push_back(first);
+            p_last.push_back(i);
+          }
+          first = i+1;
+        } else if (c == '/' && p_comments) {
+          break;
+        }
+      }
+      p_first.push_back(first);
+      p_last.push_back(i);
+      return p_first.size();
+    }
+
+    /**
+     * Number of fields in the last record
+     * @return number of fields
+     */
+    int size() const
+    {
+      return p_first.size();
+    }
+
+    /**
+     * Pointer to the start of a field. The field is not null terminated
+     * @param i field index
+     * @return pointer to first character in field
+     */
+    const char* field(int i) const
+    {
+      return p_buffer.data()+p_first[i];
+    }
+
+    /**
+     * Number of characters in a field
+     * @param i field index
+     * @return length of field
+     */
+    int length(int i) const
+    {
+      return p_last[i]-p_first[i];
+    }
+
+    /**
+     * Copy a field into a string
+     * @param i field index
+     * @param str string containing the field
+     */
+    void getString(int i, std::string &str) const
+    {
+      str.assign(field(i), length(i));
+    }
+
+    /**
+     * Return a field as a string
+     * @param i field index
+     * @return string containing the field
+     */
+    std::string getString(int i) const
+    {
+      return std::string(field(i), length(i));
+    }
+
+    /**
+     * Convert a field to an integer. Leading white space is skipped and
+     * conversion stops at the first character that is not part of a number
+     * (same behavior as atoi)
+     * @param i field index
+     * @return integer value of field
+     */
+    int getInt(int i) const
+    {
+      return toInt(field(i), length(i));
+    }
+
+    /**
+     * Convert a field to a double (same behavior as atof)
+     * @param i field index
+     * @return double value of field
+     */
+    double getDouble(int i) const
+    {
+      return toDouble(field(i), length(i));
+    }
+
+    /**
+     * Return all fields as strings. The strings are only created the first
+     * time this function is called after a split and the vector and its
+     * strings are reused between records, so no memory is allocated once
+     * the tokenizer has seen a record of the same size
+     * @return list of fields
+     */
+    std::vector<std::string>& strings()
+    {
+      if (!p_stringsValid) {
+        int nfld = p_first.size();
+        p_strings.resize(nfld);
+        int i;
+        for (i=0; i<nfld; i++) getString(i, p_strings[i]);
+        p_stringsValid = true;
+      }
+      return p_strings;
+    }
+
+    /**
+     * Convert a sequence of characters to an integer
+     * @param str pointer to first character
+     * @param len number of characters
+     * @return integer value, or 0 if no number is found
+     */
+    static int toInt(const char *str, int len)
+    {
+      const char *end = str+len;
+      while (str < end && isSpace(*str)) str++;
+      if (str == end) return 0;
+#ifdef __cpp_lib_to_chars
+      int ret = 0;
+      std::from_chars_result res = std::from_chars(str, end, ret);
+      if (res.ec == std::errc() && res.ptr != str) return ret;
+#endif
+      char buf[64];
+      copyField(str, end, buf, sizeof(buf));
+      return atoi(buf);
+    }
+
+    /**
+     * Convert a string to an integer
+     * @param str string containing number
+     * @return integer value, or 0 if no number is found
+     */
+    static int toInt(const std::string &str)
+    {
+      return toInt(str.data(), str.length());
+    }
+
+    /**
+     * Convert a sequence of characters to a double
+     * @param str pointer to first character
+     * @param len number of characters
+     * @return double value, or 0.0 if no number is found
+     */
+    static double toDouble(const char *str, int len)
+    {
+      const char *end = str+len;
+      while (str < end && isSpace(*str)) str++;
+      if (str == end) return 0.0;
+#ifdef __cpp_lib_to_chars
+      double ret = 0.0;
+      std::from_chars_result res = std::from_chars(str, end, ret);
+      if (res.ec == std::errc() && res.ptr != str) return ret;
+#endif
+      // Values with a leading '+' or out of range values are handled by atof
+      char buf[64];
+      copyField(str, end, buf, sizeof(buf));
+      return atof(buf);
+    }
+
+    /**
+     * Convert a string to a double
+     * @param str string containing number
+     * @return double value, or 0.0 if no number is found
+     */
+    static double toDouble(const std::string &str)
+    {
+      return toDouble(str.data(), str.length());
+    }
+
+  private:
+
+    static bool isSpace(char c)
+    {
+      return (c == ' ' || c == '\t' || c == '\r' || c == '\n');
+    }
+
+    /**
+     * Copy a field into a null terminated buffer. Fields that do not fit
+     * are truncated, which does not affect any valid number
+     */
+    static void copyField(const char *str, const char *end, char *buf,
+        int size)
+    {
+      int len = end-str;
+      if (len > size-1) len = size-1;
+      memcpy(buf, str, len);
+      buf[len] = '\0';
+    }
+
+    char p_delim;
+    bool p_compress;
+    bool p_comments;
+    bool p_stringsValid;
+    std::string p_buffer;
+    std::vector<int> p_first;
+    std::vector<int> p_last;
+    std::vector<std::string> p_strings;
+};
+
+} /* namespace parser */
+} /* namespace gridpack */
+#endif /* _line_tokenizer_hpp_ */
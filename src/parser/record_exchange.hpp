@@ -0,0 +1,274 @@
+// Emacs Mode Line: -*- Mode:c++;-*-
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   record_exchange.hpp
+ * @author agent
+ * @date   2026-10-17
+ *
+ * @brief
+ * Utility for reading blocks of records from a text file in parallel and
+ * moving individual records (lines) to the processor that will parse them.
+ * Each processor reads a contiguous byte range of a block so the lines
+ * received by a processor are in the same order as in the original file.
+ * Buses are assigned to processors using a hash of the original bus index,
+ * so any processor can determine where a record belongs without an
+ * additional lookup.
+ *
+ */
+
+// -------------------------------------------------------------
+
+#ifndef _record_exchange_hpp_
+#define _record_exchange_hpp_
+
+#include <mpi.h>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdio>
+
+#include "gridpack/parallel/communicator.hpp"
+#include "gridpack/utilities/exception.hpp"
+
+namespace gridpack {
+namespace parser {
+
+class RecordExchange
+{
+  public:
+    /**
+     * Constructor
+     * @param comm communicator over which records are distributed
+     */
+    RecordExchange(const gridpack::parallel::Communicator &comm)
+      : p_comm(static_cast<MPI_Comm>(comm)), p_me(comm.rank()),
+      p_nprocs(comm.size())
+    {
+    }
+
+    /**
+     * Destructor
+     */
+    ~RecordExchange()
+    {
+    }
+
+    /**
+     * Processor that owns a bus while the network is being read in
+     * @param idx original index of bus
+     * @return rank of owning processor
+     */
+    int owner(int idx) const
+    {
+      // Multiplicative hash so that blocks of consecutive bus numbers
+      // (typically used for areas) are spread evenly
+      unsigned int hash = static_cast<unsigned int>(idx)*2654435761u;
+      return static_cast<int>((hash>>7)%static_cast<unsigned int>(p_nprocs));
+    }
+
+    /**
+     * Read this processor's portion of the lines in a block of a file. The
+     * block is divided into equal byte ranges and each line is assigned to
+     * the processor whose range contains the first character of the line
+     * @param fileName name of file
+     * @param lo offset of first character in block
+     * @param hi offset of first character after block
+     * @param lines lines assigned to this processor (without end of line
+     *        characters)
+     */
+    void readBlock(const std::string &fileName, long lo, long hi,
+        std::vector<std::string> &lines) const
+    {
+      lines.clear();
+      if (hi <= lo) return;
+      long chunk = (hi-lo)/p_nprocs;
+      long start = lo + p_me*chunk;
+      long end = (p_me == p_nprocs-1) ? hi : start+chunk;
+      if (end <= start) return;
+      std::ifstream fin(fileName.c_str(), std::ios::in | std::ios::binary);
+      if (!fin.is_open()) {
+        char buf[512];
+        sprintf(buf,"Failed to open network configuration file: %s\n",
+            fileName.c_str());
+        throw gridpack::Exception(buf);
+      }
+      std::string line;
+      long offset = start;
+      if (start > lo) {
+        // If the previous character is not an end of line, the line that
+        // contains start belongs to the previous processor
+        fin.seekg(start-1);
+        char c;
+        fin.get(c);
+        if (c != '\n') {
+          std::getline(fin,line);
+          offset += line.length()+1;
+        }
+      } else {
+        fin.seekg(start);
+      }
+      while (offset < end && std::getline(fin,line)) {
+        offset += line.length()+1;
+        lines.push_back(line);
+      }
+      fin.close();
+    }
+
+    /**
+     * Send lines to other processors. Lines received from each processor
+     * are kept in their original order and lines from lower ranked
+     * processors appear before lines from higher ranked processors. This is
+     * a collective operation
+     * @param lines lines to be sent
+     * @param tags integer values that accompany each line
+     * @param dest destination processor for each line
+     * @param rlines lines received by this processor
+     * @param rtags integer values accompanying received lines
+     */
+    void exchange(const std::vector<std::string> &lines,
+        const std::vector<int> &tags, const std::vector<int> &dest,
+        std::vector<std::string> &rlines, std::vector<int> &rtags) const
+    {
+      int i, p;
+      int nlines = lines.size();
+      if (static_cast<int>(dest.size()) != nlines ||
+          static_cast<int>(tags.size()) != nlines) {
+        throw gridpack::Exception(
+            "RecordExchange::exchange: inconsistent number of lines");
+      }
+      // Count characters (including end of line) and lines going to each
+      // processor
+      std::vector<int> scount(2*p_nprocs,0);
+      for (i=0; i<nlines; i++) {
+        scount[2*dest[i]] += lines[i].length()+1;
+        scount[2*dest[i]+1]++;
+      }
+      std::vector<int> rcount(2*p_nprocs);
+      MPI_Alltoall(&scount[0],2,MPI_INT,&rcount[0],2,MPI_INT,p_comm);
+
+      std::vector<int> sbytes(p_nprocs), soff(p_nprocs), rbytes(p_nprocs),
+        roff(p_nprocs);
+      std::vector<int> sntag(p_nprocs), stoff(p_nprocs), rntag(p_nprocs),
+        rtoff(p_nprocs);
+      int stotal = 0, rtotal = 0, sttotal = 0, rttotal = 0;
+      for (p=0; p<p_nprocs; p++) {
+        sbytes[p] = scount[2*p];
+        sntag[p] = scount[2*p+1];
+        rbytes[p] = rcount[2*p];
+        rntag[p] = rcount[2*p+1];
+        soff[p] = stotal;
+        stoff[p] = sttotal;
+        roff[p] = rtotal;
+        rtoff[p] = rttotal;
+        stotal += sbytes[p];
+        sttotal += sntag[p];
+        rtotal += rbytes[p];
+        rttotal += rntag[p];
+      }
+
+      // Pack lines and tags in destination order
+      std::vector<char> sbuf(stotal+1);
+      std::vector<int> stags(sttotal+1);
+      std::vector<int> cpos(soff);
+      std::vector<int> tpos(stoff);
+      for (i=0; i<nlines; i++) {
+        int d = dest[i];
+        int len = lines[i].length();
+        if (len > 0) lines[i].copy(&sbuf[cpos[d]],len);
+        sbuf[cpos[d]+len] = '\n';
+        cpos[d] += len+1;
+        stags[tpos[d]] = tags[i];
+        tpos[d]++;
+      }
+
+      std::vector<char> rbuf(rtotal+1);
+      rtags.resize(rttotal+1);
+      MPI_Alltoallv(&sbuf[0],&sbytes[0],&soff[0],MPI_CHAR,
+          &rbuf[0],&rbytes[0],&roff[0],MPI_CHAR,p_comm);
+      MPI_Alltoallv(&stags[0],&sntag[0],&stoff[0],MPI_INT,
+          &rtags[0],&rntag[0],&rtoff[0],MPI_INT,p_comm);
+      rtags.resize(rttotal);
+
+      // Unpack lines
+      rlines.clear();
+      rlines.reserve(rttotal);
+      int first = 0;
+      for (i=0; i<rtotal; i++) {
+        if (rbuf[i] == '\n') {
+          rlines.push_back(std::string(&rbuf[first],i-first));
+          first = i+1;
+        }
+      }
+    }
+
+    /**
+     * Send lines to other processors without any accompanying values. This
+     * is a collective operation
+     * @param lines lines to be sent
+     * @param dest destination processor for each line
+     * @param rlines lines received by this processor
+     */
+    void exchange(const std::vector<std::string> &lines,
+        const std::vector<int> &dest, std::vector<std::string> &rlines) const
+    {
+      std::vector<int> tags(lines.size(),0);
+      std::vector<int> rtags;
+      exchange(lines, tags, dest, rlines, rtags);
+    }
+
+    /**
+     * Gather lines from all processors onto all processors. This is a
+     * collective operation
+     * @param lines lines contributed by this processor
+     * @param rlines lines from all processors, in rank order
+     */
+    void allGather(const std::vector<std::string> &lines,
+        std::vector<std::string> &rlines) const
+    {
+      int i;
+      int nlines = lines.size();
+      int sbytes = 0;
+      for (i=0; i<nlines; i++) sbytes += lines[i].length()+1;
+      std::vector<char> sbuf(sbytes+1);
+      int pos = 0;
+      for (i=0; i<nlines; i++) {
+        int len = lines[i].length();
+        if (len > 0) lines[i].copy(&sbuf[pos],len);
+        sbuf[pos+len] = '\n';
+        pos += len+1;
+      }
+      std::vector<int> rbytes(p_nprocs), roff(p_nprocs);
+      MPI_Allgather(&sbytes,1,MPI_INT,&rbytes[0],1,MPI_INT,p_comm);
+      int rtotal = 0;
+      for (i=0; i<p_nprocs; i++) {
+        roff[i] = rtotal;
+        rtotal += rbytes[i];
+      }
+      std::vector<char> rbuf(rtotal+1);
+      MPI_Allgatherv(&sbuf[0],sbytes,MPI_CHAR,&rbuf[0],&rbytes[0],&roff[0],
+          MPI_CHAR,p_comm);
+      rlines.clear();
+      int first = 0;
+      for (i=0; i<rtotal; i++) {
+        if (rbuf[i] == '\n') {
+          rlines.push_back(std::string(&rbuf[first],i-first));
+          first = i+1;
+        }
+      }
+    }
+
+  private:
+
+    MPI_Comm p_comm;
+    int p_me;
+    int p_nprocs;
+};
+
+} /* namespace parser */
+} /* namespace gridpack */
+#endif /* _record_exchange_hpp_ */
@@ -0,0 +1,458 @@
+// Emacs Mode Line: -*- Mode:c++;-*-
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   record_stream.hpp
+ * @author agent
+ * @date   2026-10-17
+ *
+ * @brief
+ * Stream records (text lines) read on one processor directly to the
+ * processors that hold the network objects they describe. Each processor
+ * registers the keys (original bus indices) it holds with a directory
+ * processor chosen by hashing the key, so the directory is distributed in
+ * the same way as the one used by HashDistribution and no processor holds
+ * an entry for every key. The root processor sends each record to the
+ * directory processor for its key, which forwards it to the processors
+ * holding the key. Records are collected into batches of bounded size that
+ * are sent with non-blocking messages, so the root processor can continue
+ * reading the file while the previous batch is being delivered. At most two
+ * batches are held on the root processor at any time, so its memory use
+ * does not depend on the size of the file.
+ *
+ */
+// -------------------------------------------------------------
+
+#ifndef _record_stream_hpp_
+#define _record_stream_hpp_
+
+#include <mpi.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <list>
+#include <set>
+#include <map>
+
+#include "gridpack/parallel/communicator.hpp"
+
+// Records sent from the root processor to directory processors
+#define RECORD_STREAM_TAG 1001
+// Records sent from directory processors to processors holding the key
+#define RECORD_DELIVER_TAG 1002
+
+namespace gridpack {
+namespace parser {
+
+class RecordStream
+{
+  public:
+    /**
+     * Constructor
+     * @param comm communicator over which records are distributed
+     * @param batch maximum number of records held in a batch before it
+     *        is sent
+     * @param root processor that reads and sends records
+     */
+    RecordStream(const gridpack::parallel::Communicator &comm,
+        int batch = 1024, int root = 0)
+      : p_me(comm.rank()), p_nprocs(comm.size()), p_root(root),
+      p_batch(batch), p_nrecords(0), p_current(0), p_finished(false),
+      p_routed(p_me == root), p_ndone(0)
+    {
+      // Use a separate communicator so that messages cannot be confused
+      // with any other traffic on the network communicator
+      MPI_Comm_dup(static_cast<MPI_Comm>(comm), &p_comm);
+      if (p_me == p_root) {
+        int i;
+        for (i=0; i<2; i++) {
+          p_buffers[i].resize(2*p_nprocs);
+          p_requests[i].clear();
+        }
+      }
+    }
+
+    /**
+     * Destructor
+     */
+    ~RecordStream()
+    {
+      if (p_me == p_root && !p_finished) finish();
+      waitPending();
+      MPI_Comm_free(&p_comm);
+    }
+
+    /**
+     * Register the keys held by this processor. Keys may be held by more
+     * than one processor and records with that key are sent to all of them.
+     * Each key is registered with a directory processor chosen by hashing
+     * the key. This is a collective operation
+     * @param keys list of keys held by this processor
+     */
+    void setKeys(const std::vector<int> &keys)
+    {
+      std::set<int> unique(keys.begin(), keys.end());
+      std::vector<int> scount(p_nprocs,0), rcount(p_nprocs);
+      std::vector<int> soff(p_nprocs), roff(p_nprocs);
+      std::set<int>::iterator it;
+      for (it = unique.begin(); it != unique.end(); it++) {
+        scount[home(*it)]++;
+      }
+      int stotal = 0;
+      int p, i;
+      for (p=0; p<p_nprocs; p++) {
+        soff[p] = stotal;
+        stotal += scount[p];
+      }
+      std::vector<int> sbuf(stotal+1);
+      std::vector<int> fill(soff);
+      for (it = unique.begin(); it != unique.end(); it++) {
+        sbuf[fill[home(*it)]++] = *it;
+      }
+      MPI_Alltoall(&scount[0],1,MPI_INT,&rcount[0],1,MPI_INT,p_comm);
+      int rtotal = 0;
+      for (p=0; p<p_nprocs; p++) {
+        roff[p] = rtotal;
+        rtotal += rcount[p];
+      }
+      std::vector<int> rbuf(rtotal+1);
+      MPI_Alltoallv(&sbuf[0],&scount[0],&soff[0],MPI_INT,&rbuf[0],
+          &rcount[0],&roff[0],MPI_INT,p_comm);
+      p_directory.clear();
+      for (p=0; p<p_nprocs; p++) {
+        for (i=0; i<rcount[p]; i++) {
+          p_directory.insert(std::pair<int,int>(rbuf[roff[p]+i],p));
+        }
+      }
+    }
+
+    /**
+     * Add a record to the stream. The record is sent to all processors
+     * that registered the key. Records with keys that are not registered
+     * on any processor are dropped and reported by unresolved() on the
+     * directory processor for the key. This can only be called on the root
+     * processor
+     * @param record text of record (must not contain end of line
+     *        characters)
+     * @param key key identifying processors that receive record
+     */
+    void send(const std::string &record, int key)
+    {
+      std::vector<std::vector<char> > &buffers = p_buffers[p_current];
+      int h = home(key);
+      if (h == p_me) {
+        route(record.c_str(), record.size(), key, &buffers[p_nprocs]);
+      } else {
+        pack(record.c_str(), record.size(), key, buffers[h]);
+      }
+      p_nrecords++;
+      if (p_nrecords >= p_batch) flush();
+    }
+
+    /**
+     * Send all records in the current batch. Only called on the root
+     * processor
+     */
+    void flush()
+    {
+      // Make sure the sends from the previous use of this set of buffers
+      // have completed before it is refilled
+      int next = 1-p_current;
+      complete(next);
+      std::vector<std::vector<char> > &buffers = p_buffers[p_current];
+      int p;
+      for (p=0; p<2*p_nprocs; p++) {
+        if (buffers[p].size() > 0) {
+          MPI_Request request;
+          int tag = p < p_nprocs ? RECORD_STREAM_TAG : RECORD_DELIVER_TAG;
+          MPI_Isend(&buffers[p][0],buffers[p].size(),MPI_CHAR,p%p_nprocs,
+              tag,p_comm,&request);
+          p_requests[p_current].push_back(request);
+        }
+      }
+      p_current = next;
+      p_nrecords = 0;
+    }
+
+    /**
+     * Send any remaining records and signal all processors that the stream
+     * is complete. Only called on the root processor
+     */
+    void finish()
+    {
+      flush();
+      complete(0);
+      complete(1);
+      int p;
+      for (p=0; p<p_nprocs; p++) {
+        if (p == p_root) continue;
+        // An empty message on each tag tells processor p that the root
+        // processor has no more records to route or deliver
+        isend(std::vector<char>(), p, RECORD_STREAM_TAG);
+        isend(std::vector<char>(), p, RECORD_DELIVER_TAG);
+      }
+      p_finished = true;
+    }
+
+    /**
+     * Receive the next batch of records. Processors continue to forward
+     * records for keys in their part of the directory while they wait.
+     * On processors other than root this blocks until a batch arrives. On
+     * the root processor it does not block until finish() has been called.
+     * Records with the same key are in the order they were sent
+     * @param records records received by this processor
+     * @return false if the stream is complete and no records were returned
+     */
+    bool receive(std::vector<std::string> &records)
+    {
+      records.clear();
+      while (true) {
+        poll();
+        if (p_local.size() > 0) {
+          records.swap(p_local);
+          return true;
+        }
+        if (p_me == p_root && !p_finished) return true;
+        if (p_routed && p_ndone == p_nprocs-1) {
+          waitPending();
+          return false;
+        }
+        MPI_Status status;
+        MPI_Probe(MPI_ANY_SOURCE,MPI_ANY_TAG,p_comm,&status);
+        handle(status);
+      }
+    }
+
+    /**
+     * Keys of records that were sent to this processor for forwarding but
+     * are not held by any processor
+     * @return list of unresolved keys
+     */
+    const std::vector<int>& unresolved() const
+    {
+      return p_unresolved;
+    }
+
+  private:
+
+    /**
+     * Directory processor for a key
+     * @param key key of record
+     * @return processor holding directory entry for key
+     */
+    int home(int key) const
+    {
+      unsigned int hash = static_cast<unsigned int>(key)*2654435761u;
+      return static_cast<int>((hash>>7)%static_cast<unsigned int>(p_nprocs));
+    }
+
+    /**
+     * Append a record and its key to a message buffer
+     * @param record text of record
+     * @param len length of record
+     * @param key key of record
+     * @param buf message buffer
+     */
+    void pack(const char *record, int len, int key, std::vector<char> &buf)
+    {
+      const char *kptr = reinterpret_cast<const char*>(&key);
+      buf.insert(buf.end(), kptr, kptr+sizeof(int));
+      buf.insert(buf.end(), record, record+len);
+      buf.push_back('\n');
+    }
+
+    /**
+     * Look up the processors holding a key in the local part of the
+     * directory and add the record to the buffer for each of them
+     * @param record text of record
+     * @param len length of record
+     * @param key key of record
+     * @param buffers message buffers, indexed by processor
+     */
+    void route(const char *record, int len, int key,
+        std::vector<char> *buffers)
+    {
+      std::multimap<int,int>::iterator it = p_directory.find(key);
+      if (it == p_directory.end()) {
+        p_unresolved.push_back(key);
+        return;
+      }
+      while (it != p_directory.end() && it->first == key) {
+        int p = it->second;
+        if (p == p_me) {
+          p_local.push_back(std::string(record,len));
+        } else {
+          pack(record, len, key, buffers[p]);
+        }
+        it++;
+      }
+    }
+
+    /**
+     * Post a non-blocking send of a message that is kept until the send
+     * completes
+     * @param buf message
+     * @param p destination processor
+     * @param tag message tag
+     */
+    void isend(const std::vector<char> &buf, int p, int tag)
+    {
+      p_pending.push_back(PendingSend());
+      PendingSend &send = p_pending.back();
+      send.buffer = buf;
+      send.buffer.push_back('\0');
+      MPI_Isend(&send.buffer[0],buf.size(),MPI_CHAR,p,tag,p_comm,
+          &send.request);
+    }
+
+    /**
+     * Receive a message that has been probed and either forward its
+     * records (records sent by the root processor to this part of the
+     * directory) or keep them (records for keys held by this processor)
+     * @param status status returned by probe
+     */
+    void handle(MPI_Status &status)
+    {
+      int len;
+      MPI_Get_count(&status,MPI_CHAR,&len);
+      std::vector<char> buf(len+1);
+      int tag = status.MPI_TAG;
+      MPI_Recv(&buf[0],len,MPI_CHAR,status.MPI_SOURCE,tag,p_comm,
+          MPI_STATUS_IGNORE);
+      if (len == 0) {
+        if (tag == RECORD_STREAM_TAG) {
+          // Root processor has finished routing records. All records this
+          // processor forwards have been sent, so tell the other processors
+          // that no more records are coming from here
+          p_routed = true;
+          int p;
+          for (p=0; p<p_nprocs; p++) {
+            if (p != p_me) isend(std::vector<char>(), p, RECORD_DELIVER_TAG);
+          }
+        } else {
+          p_ndone++;
+        }
+        return;
+      }
+      std::vector<std::vector<char> > forward;
+      if (tag == RECORD_STREAM_TAG) forward.resize(p_nprocs);
+      int first = 0;
+      while (first < len) {
+        int key;
+        memcpy(&key,&buf[first],sizeof(int));
+        first += sizeof(int);
+        const char *record = &buf[first];
+        const char *end = static_cast<const char*>(memchr(record,'\n',
+              len-first));
+        int rlen = end-record;
+        if (tag == RECORD_STREAM_TAG) {
+          route(record, rlen, key, &forward[0]);
+        } else {
+          p_local.push_back(std::string(record,rlen));
+        }
+        first += rlen+1;
+      }
+      int p;
+      for (p=0; p<static_cast<int>(forward.size()); p++) {
+        if (forward[p].size() > 0) isend(forward[p], p, RECORD_DELIVER_TAG);
+      }
+    }
+
+    /**
+     * Handle all messages that have arrived without blocking and release
+     * buffers of sends that have completed
+     */
+    void poll()
+    {
+      int flag = 1;
+      MPI_Status status;
+      while (flag) {
+        MPI_Iprobe(MPI_ANY_SOURCE,MPI_ANY_TAG,p_comm,&flag,&status);
+        if (flag) handle(status);
+      }
+      std::list<PendingSend>::iterator it = p_pending.begin();
+      while (it != p_pending.end()) {
+        MPI_Test(&it->request,&flag,MPI_STATUS_IGNORE);
+        if (flag) {
+          it = p_pending.erase(it);
+        } else {
+          it++;
+        }
+      }
+    }
+
+    /**
+     * Wait for all forwarded messages to be delivered
+     */
+    void waitPending()
+    {
+      std::list<PendingSend>::iterator it;
+      for (it = p_pending.begin(); it != p_pending.end(); it++) {
+        MPI_Wait(&it->request,MPI_STATUS_IGNORE);
+      }
+      p_pending.clear();
+    }
+
+    /**
+     * Wait for all sends from a set of buffers to complete and clear the
+     * buffers. Incoming records are handled while waiting so that
+     * processors forwarding records to the root processor do not block it
+     * @param set index of buffer set
+     */
+    void complete(int set)
+    {
+      std::vector<MPI_Request> &requests = p_requests[set];
+      if (requests.size() > 0) {
+        int flag = 0;
+        MPI_Testall(requests.size(),&requests[0],&flag,MPI_STATUSES_IGNORE);
+        while (!flag) {
+          poll();
+          MPI_Testall(requests.size(),&requests[0],&flag,
+              MPI_STATUSES_IGNORE);
+        }
+      }
+      requests.clear();
+      int p;
+      for (p=0; p<static_cast<int>(p_buffers[set].size()); p++) {
+        p_buffers[set][p].clear();
+      }
+    }
+
+    /**
+     * Message posted by a directory processor that is kept until the send
+     * completes
+     */
+    struct PendingSend {
+      std::vector<char> buffer;
+      MPI_Request request;
+    };
+
+    MPI_Comm p_comm;
+    int p_me;
+    int p_nprocs;
+    int p_root;
+    int p_batch;
+    int p_nrecords;
+    int p_current;
+    bool p_finished;
+    bool p_routed;
+    int p_ndone;
+    // Processors holding keys in this processor's part of the directory
+    std::multimap<int,int> p_directory;
+    // Root processor buffers. The first p_nprocs buffers hold records for
+    // directory processors and the last p_nprocs hold records for
+    // processors holding keys in the root processor's part of the directory
+    std::vector<std::vector<char> > p_buffers[2];
+    std::vector<MPI_Request> p_requests[2];
+    std::list<PendingSend> p_pending;
+    std::vector<std::string> p_local;
+    std::vector<int> p_unresolved;
+};
+
+} /* namespace parser */
+} /* namespace gridpack */
+#endif /* _record_stream_hpp_ */
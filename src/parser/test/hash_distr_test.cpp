@@ -23,6 +23,7 @@
 #define YDIM 10
 
 #define NUM_TEST_VALS 10;
+#define NUM_PLAN_REPEAT 3
 
 struct test_data { int idx;
                    int idx1;
@@ -705,6 +706,211 @@ BOOST_AUTO_TEST_CASE( TestHashFunctions )
     printf("\nDistribution of branch vectors failed\n\n");
   }
 
+  // Create distribution plans and reuse them to distribute new values several
+  // times. Odd iterations use the asynchronous interface
+  bus_keys.clear();
+  for (i=min_bus; i<=max_bus; i++) {
+    n = 2*i;
+    n1 = n%3+1;
+    for (j=0; j<n1; j++) {
+      bus_keys.push_back(n);
+    }
+  }
+  branch_keys.clear();
+  for (i=min_branch; i<=max_branch; i++) {
+    if (i<half_branch) {
+      ix = i%(XDIM-1);
+      iy = (i-ix)/(XDIM-1);
+      n1 = 2*(iy*XDIM+ix);
+      n2 = 2*(iy*XDIM+ix+1);
+    } else {
+      n = i - half_branch;
+      ix = n%XDIM;
+      iy = (n-ix)/XDIM;
+      n1 = 2*(iy*XDIM+ix);
+      n2 = 2*((iy+1)*XDIM+ix);
+    }
+    n = (n1+n2)%3+1;
+    for (j=0; j<n; j++) {
+      branch_keys.push_back(std::pair<int,int>(n1,n2));
+    }
+  }
+  int t_plan = timer->createCategory("Create Distribution Plans");
+  timer->start(t_plan);
+  int bus_plan = distr.createBusPlan(bus_keys);
+  int branch_plan = distr.createBranchPlan(branch_keys);
+  timer->stop(t_plan);
+  int t_reuse = timer->createCategory("Distribute Data With Plans");
+  ok = true;
+  int iter;
+  std::vector<int> plan_ids;
+  for (iter=0; iter<NUM_PLAN_REPEAT; iter++) {
+    bus_values.clear();
+    for (i=0; i<static_cast<int>(bus_keys.size()); i++) {
+      test_data data;
+      data.idx = bus_keys[i];
+      data.idx1 = iter;
+      bus_values.push_back(data);
+    }
+    branch_values.clear();
+    for (i=0; i<static_cast<int>(branch_keys.size()); i++) {
+      test_data data;
+      data.idx = iter;
+      data.idx1 = branch_keys[i].first;
+      data.idx2 = branch_keys[i].second;
+      branch_values.push_back(data);
+    }
+    timer->start(t_reuse);
+    if (iter%2 == 0) {
+      distr.distributeBusValues(bus_plan, plan_ids, bus_values);
+    } else {
+      // Keep distributions with both plans in progress at the same time
+      distr.startBusValues(bus_plan, bus_values);
+      distr.startBranchValues(branch_plan, branch_values);
+      BOOST_CHECK_THROW(distr.destroyPlan(bus_plan), gridpack::Exception);
+      distr.completeBusValues(bus_plan, plan_ids, bus_values);
+    }
+    timer->stop(t_reuse);
+    std::vector<int> count(nbus,0);
+    for (i=0; i<static_cast<int>(plan_ids.size()); i++) {
+      bus_id = network->getOriginalBusIndex(plan_ids[i]);
+      count[plan_ids[i]]++;
+      if (bus_values[i].idx != bus_id || bus_values[i].idx1 != iter) {
+        ok = false;
+        printf("p[%d] plan bus %d failed idx: %d iter: %d\n",me,bus_id,
+            bus_values[i].idx,bus_values[i].idx1);
+      }
+    }
+    for (i=0; i<nbus; i++) {
+      bus_id = network->getOriginalBusIndex(i);
+      if (count[i] != bus_id%3+1) {
+        ok = false;
+        printf("p[%d] plan bus %d failed ndata: %d\n",me,bus_id,count[i]);
+      }
+    }
+    timer->start(t_reuse);
+    if (iter%2 == 0) {
+      distr.distributeBranchValues(branch_plan, plan_ids, branch_values);
+    } else {
+      distr.completeBranchValues(branch_plan, plan_ids, branch_values);
+    }
+    timer->stop(t_reuse);
+    count.assign(nbranch,0);
+    for (i=0; i<static_cast<int>(plan_ids.size()); i++) {
+      network->getOriginalBranchEndpoints(plan_ids[i],&from_bus,&to_bus);
+      count[plan_ids[i]]++;
+      if (branch_values[i].idx1 != from_bus ||
+          branch_values[i].idx2 != to_bus || branch_values[i].idx != iter) {
+        ok = false;
+        printf("p[%d] plan branch < %d, %d> failed\n",me,from_bus,to_bus);
+      }
+    }
+    for (i=0; i<nbranch; i++) {
+      network->getOriginalBranchEndpoints(i,&from_bus,&to_bus);
+      if (count[i] != (from_bus+to_bus)%3+1) {
+        ok = false;
+        printf("p[%d] plan branch < %d, %d> failed ndata: %d\n",me,
+            from_bus,to_bus,count[i]);
+      }
+    }
+  }
+  distr.destroyPlan(bus_plan);
+  distr.destroyPlan(branch_plan);
+  BOOST_CHECK(ok);
+  oks = static_cast<int>(ok);
+  ierr = MPI_Allreduce(&oks, &okr, 1, MPI_INT, MPI_PROD, mpi_world);
+  ok = static_cast<bool>(okr);
+  if (me == 0 && ok) {
+    printf("\nDistribution with reusable plans succeeded\n\n");
+  } else if (me == 0 && !ok) {
+    printf("\nDistribution with reusable plans failed\n\n");
+  }
+
+  // Distribute arrays of values using plans
+  int vbus_plan = distr_v.createBusPlan(bus_keys);
+  int vbranch_plan = distr_v.createBranchPlan(branch_keys);
+  ok = true;
+  for (iter=0; iter<NUM_PLAN_REPEAT; iter++) {
+    bus_vec.clear();
+    for (i=0; i<static_cast<int>(bus_keys.size()); i++) {
+      int *idata = new int[nvals];
+      for (k=0; k<nvals; k++) {
+        idata[k] = bus_keys[i]+iter+k;
+      }
+      bus_vec.push_back(idata);
+    }
+    timer->start(t_reuse);
+    distr_v.distributeBusValues(vbus_plan, plan_ids, bus_vec, nvals);
+    timer->stop(t_reuse);
+    std::vector<int> count(nbus,0);
+    for (i=0; i<static_cast<int>(plan_ids.size()); i++) {
+      bus_id = network->getOriginalBusIndex(plan_ids[i]);
+      count[plan_ids[i]]++;
+      for (k=0; k<nvals; k++) {
+        if (bus_vec[i][k] != bus_id+iter+k) {
+          ok = false;
+          printf("p[%d] plan vector<int> bus %d failed k: %d ptr: %d\n",
+              me,bus_id,k,bus_vec[i][k]);
+        }
+      }
+      delete [] bus_vec[i];
+    }
+    for (i=0; i<nbus; i++) {
+      bus_id = network->getOriginalBusIndex(i);
+      if (count[i] != bus_id%3+1) {
+        ok = false;
+        printf("p[%d] plan vector<int> bus %d failed ndata: %d\n",me,bus_id,
+            count[i]);
+      }
+    }
+    branch_vec.clear();
+    for (i=0; i<static_cast<int>(branch_keys.size()); i++) {
+      double *ddata = new double[nvals];
+      for (k=0; k<nvals; k++) {
+        ddata[k] = static_cast<double>(branch_keys[i].first
+            +branch_keys[i].second+iter+k);
+      }
+      branch_vec.push_back(ddata);
+    }
+    timer->start(t_reuse);
+    distr_v.distributeBranchValues(vbranch_plan, plan_ids, branch_vec, nvals);
+    timer->stop(t_reuse);
+    count.assign(nbranch,0);
+    for (i=0; i<static_cast<int>(plan_ids.size()); i++) {
+      network->getOriginalBranchEndpoints(plan_ids[i],&from_bus,&to_bus);
+      count[plan_ids[i]]++;
+      for (k=0; k<nvals; k++) {
+        if (branch_vec[i][k] != static_cast<double>(from_bus+to_bus+iter+k)) {
+          ok = false;
+          printf("p[%d] plan vector<double> branch < %d, %d> failed k: %d"
+              " ptr: %16.2f\n",me,from_bus,to_bus,k,branch_vec[i][k]);
+        }
+      }
+      delete [] branch_vec[i];
+    }
+    for (i=0; i<nbranch; i++) {
+      network->getOriginalBranchEndpoints(i,&from_bus,&to_bus);
+      if (count[i] != (from_bus+to_bus)%3+1) {
+        ok = false;
+        printf("p[%d] plan vector<double> branch < %d, %d> failed ndata: %d\n",
+            me,from_bus,to_bus,count[i]);
+      }
+    }
+  }
+  bus_vec.clear();
+  branch_vec.clear();
+  distr_v.destroyPlan(vbus_plan);
+  distr_v.destroyPlan(vbranch_plan);
+  BOOST_CHECK(ok);
+  oks = static_cast<int>(ok);
+  ierr = MPI_Allreduce(&oks, &okr, 1, MPI_INT, MPI_PROD, mpi_world);
+  ok = static_cast<bool>(okr);
+  if (me == 0 && ok) {
+    printf("\nDistribution of vectors with reusable plans succeeded\n\n");
+  } else if (me == 0 && !ok) {
+    printf("\nDistribution of vectors with reusable plans failed\n\n");
+  }
+
   timer->dump();
 }
 
@@ -0,0 +1,107 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_NO_MAIN
+#define BOOST_TEST_ALTERNATIVE_INIT_API
+#include <boost/test/included/unit_test.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/classification.hpp>
+
+#include "gridpack/parser/line_tokenizer.hpp"
+
+BOOST_AUTO_TEST_SUITE ( TestLineTokenizer )
+
+// Fields should be the same as those produced by boost::split for records
+// without quoted delimiters
+BOOST_AUTO_TEST_CASE( TestSplit )
+{
+  const char *records[] = {
+    "1,'BUS 1   ', 138.0000,3,   1,   1,   1,1.06000,   0.0000",
+    "  2, '1 ', 1, 1, 1, 21.700, 12.700,  0.000, ,",
+    ",",
+    ""
+  };
+  gridpack::parser::LineTokenizer tokens;
+  int i, j;
+  for (i=0; i<4; i++) {
+    std::string line(records[i]);
+    std::vector<std::string> split_line;
+    boost::split(split_line, line, boost::algorithm::is_any_of(","),
+        boost::token_compress_off);
+    int nfld = tokens.split(line);
+    BOOST_CHECK_EQUAL(nfld, static_cast<int>(split_line.size()));
+    std::vector<std::string> &fields = tokens.strings();
+    BOOST_CHECK_EQUAL(fields.size(), split_line.size());
+    for (j=0; j<nfld; j++) {
+      BOOST_CHECK_EQUAL(fields[j], split_line[j]);
+      BOOST_CHECK_EQUAL(tokens.getDouble(j), atof(split_line[j].c_str()));
+      BOOST_CHECK_EQUAL(tokens.getInt(j), atoi(split_line[j].c_str()));
+    }
+  }
+
+  // Same records with adjacent delimiters merged
+  gridpack::parser::LineTokenizer ctokens(',',true);
+  for (i=0; i<4; i++) {
+    std::string line(records[i]);
+    std::vector<std::string> split_line;
+    boost::split(split_line, line, boost::algorithm::is_any_of(","),
+        boost::token_compress_on);
+    int nfld = ctokens.split(line);
+    BOOST_CHECK_EQUAL(nfld, static_cast<int>(split_line.size()));
+    std::vector<std::string> &fields = ctokens.strings();
+    for (j=0; j<nfld; j++) {
+      BOOST_CHECK_EQUAL(fields[j], split_line[j]);
+    }
+  }
+}
+
+// Delimiters and '/' inside quotes do not split the record
+BOOST_AUTO_TEST_CASE( TestQuotes )
+{
+  gridpack::parser::LineTokenizer tokens;
+  std::string line("101, 'NORTH, A/B', \"X/Y\", 1.5 / comment, with comma");
+  BOOST_CHECK_EQUAL(tokens.split(line), 4);
+  std::string name;
+  tokens.getString(1,name);
+  BOOST_CHECK_EQUAL(name, std::string(" 'NORTH, A/B'"));
+  tokens.getString(2,name);
+  BOOST_CHECK_EQUAL(name, std::string(" \"X/Y\""));
+  BOOST_CHECK_EQUAL(tokens.getInt(0), 101);
+  BOOST_CHECK_CLOSE(tokens.getDouble(3), 1.5, 1.0e-12);
+
+  // Comments are part of the last field if they are not removed
+  gridpack::parser::LineTokenizer ntokens(',',false,false);
+  BOOST_CHECK_EQUAL(ntokens.split(line), 5);
+}
+
+// Numbers in the formats found in PSS/E files
+BOOST_AUTO_TEST_CASE( TestNumbers )
+{
+  const char *values[] = {"  0.350000E-01", "-999.000", "+2.5", "1.", ".5",
+    "  12  ", "1.0D+00", "'1 '", "", "  "};
+  int i;
+  for (i=0; i<10; i++) {
+    std::string str(values[i]);
+    BOOST_CHECK_EQUAL(gridpack::parser::LineTokenizer::toDouble(str),
+        atof(values[i]));
+    BOOST_CHECK_EQUAL(gridpack::parser::LineTokenizer::toInt(str),
+        atoi(values[i]));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+bool init_function(void)
+{
+  return true;
+}
+
+int main (int argc, char **argv) {
+  int result = ::boost::unit_test::unit_test_main( &init_function, argc, argv );
+  return result;
+}
@@ -0,0 +1,202 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   parse_benchmark.cpp
+ * @author agent
+ * @date   2026-10-17
+ *
+ * @brief
+ * Measure the rate at which records in PSS/E RAW and DYR files can be read,
+ * split into fields and converted to numbers. The original approach
+ * (std::getline, boost::split and atof) is compared with InputStream and
+ * LineTokenizer. Files or directories can be listed on the command line.
+ * If no arguments are given, all files in the raw and dyr directories of
+ * the GridPACK data sets are used.
+ *
+ */
+// -------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/filesystem.hpp>
+#include "mpi.h"
+
+#include "gridpack/stream/input_stream.hpp"
+#include "gridpack/parser/line_tokenizer.hpp"
+
+#ifndef GRIDPACK_DATA_SETS
+#define GRIDPACK_DATA_SETS "."
+#endif
+
+#define NREPEAT 5
+
+// Statistics accumulated while parsing a file. The sum of all converted
+// values is used to check that both methods produce the same numbers and
+// to keep the compiler from discarding the conversions
+struct parse_stats {
+  long lines;
+  long fields;
+  double sum;
+};
+
+// Remove comment from line (same as BasePTIParser::cleanComment in the
+// original parsers)
+void cleanComment(std::string &line)
+{
+  int idx = line.find_first_of('/',0);
+  if (idx != std::string::npos) {
+    line.erase(idx,line.length()-idx);
+  }
+}
+
+// Parse file using getline, boost::split and atof
+void parseSplit(const std::string &file, parse_stats &stats)
+{
+  std::ifstream fin(file.c_str());
+  std::string line;
+  stats.lines = 0;
+  stats.fields = 0;
+  stats.sum = 0.0;
+  while (std::getline(fin,line)) {
+    std::vector<std::string> split_line;
+    cleanComment(line);
+    boost::split(split_line, line, boost::algorithm::is_any_of(","),
+        boost::token_compress_off);
+    int nfld = split_line.size();
+    int i;
+    for (i=0; i<nfld; i++) {
+      stats.sum += atof(split_line[i].c_str());
+    }
+    stats.lines++;
+    stats.fields += nfld;
+  }
+  fin.close();
+}
+
+// Parse file using InputStream and LineTokenizer
+void parseTokenizer(const std::string &file, parse_stats &stats)
+{
+  gridpack::stream::InputStream input;
+  gridpack::parser::LineTokenizer tokens;
+  const char *line;
+  int len;
+  stats.lines = 0;
+  stats.fields = 0;
+  stats.sum = 0.0;
+  input.openFile(file);
+  // A final line without an end of line is returned with a length but
+  // nextLine reports the end of the file
+  while (input.nextLine(&line, &len) || len > 0) {
+    int nfld = tokens.split(line, len);
+    int i;
+    for (i=0; i<nfld; i++) {
+      stats.sum += tokens.getDouble(i);
+    }
+    stats.lines++;
+    stats.fields += nfld;
+  }
+  input.close();
+}
+
+// Time repeated parses of a file and return the best time in seconds
+double timeParse(void (*parse)(const std::string&, parse_stats&),
+    const std::string &file, parse_stats &stats)
+{
+  double best = -1.0;
+  int i;
+  for (i=0; i<NREPEAT; i++) {
+    double t = MPI_Wtime();
+    parse(file, stats);
+    t = MPI_Wtime()-t;
+    if (best < 0.0 || t < best) best = t;
+  }
+  return best;
+}
+
+// Add files in a directory with the given extension to list
+void addDirectory(const boost::filesystem::path &dir,
+    std::vector<std::string> &files)
+{
+  std::vector<std::string> list;
+  boost::filesystem::directory_iterator it(dir), end;
+  for (; it != end; ++it) {
+    if (!boost::filesystem::is_regular_file(it->status())) continue;
+    std::string ext = it->path().extension().string();
+    if (ext == ".raw" || ext == ".dyr") list.push_back(it->path().string());
+  }
+  std::sort(list.begin(), list.end());
+  files.insert(files.end(), list.begin(), list.end());
+}
+
+int main(int argc, char **argv)
+{
+  MPI_Init(&argc, &argv);
+  std::vector<std::string> files;
+  int i;
+  if (argc > 1) {
+    for (i=1; i<argc; i++) {
+      boost::filesystem::path path(argv[i]);
+      if (boost::filesystem::is_directory(path)) {
+        addDirectory(path, files);
+      } else {
+        files.push_back(path.string());
+      }
+    }
+  } else {
+    boost::filesystem::path root(GRIDPACK_DATA_SETS);
+    addDirectory(root / "raw", files);
+    addDirectory(root / "dyr", files);
+  }
+  if (files.size() == 0) {
+    printf("No input files found\n");
+    MPI_Finalize();
+    return 1;
+  }
+
+  printf("%-40s %10s %10s %12s %12s %8s\n", "File", "Bytes", "Lines",
+      "split MB/s", "token MB/s", "Speedup");
+  double tbytes = 0.0, tsplit = 0.0, ttoken = 0.0;
+  bool ok = true;
+  for (i=0; i<files.size(); i++) {
+    boost::system::error_code ec;
+    double bytes = static_cast<double>(boost::filesystem::file_size(files[i],ec));
+    if (ec) {
+      printf("Unable to open file: %s\n",files[i].c_str());
+      ok = false;
+      continue;
+    }
+    parse_stats split_stats, token_stats;
+    double t1 = timeParse(parseSplit, files[i], split_stats);
+    double t2 = timeParse(parseTokenizer, files[i], token_stats);
+    tbytes += bytes;
+    tsplit += t1;
+    ttoken += t2;
+    std::string name = boost::filesystem::path(files[i]).filename().string();
+    printf("%-40s %10.0f %10ld %12.2f %12.2f %8.2f\n", name.c_str(), bytes,
+        token_stats.lines, bytes/(t1*1.0e6), bytes/(t2*1.0e6), t1/t2);
+    // Both methods should see the same records. Quoted names containing
+    // commas or '/' can change the number of fields, so only the number of
+    // lines is required to match
+    if (split_stats.lines != token_stats.lines) {
+      printf("  Mismatch in number of lines: %ld %ld\n", split_stats.lines,
+          token_stats.lines);
+      ok = false;
+    }
+  }
+  if (tsplit > 0.0 && ttoken > 0.0) {
+    printf("%-40s %10.0f %10s %12.2f %12.2f %8.2f\n", "Total", tbytes, "",
+        tbytes/(tsplit*1.0e6), tbytes/(ttoken*1.0e6), tsplit/ttoken);
+  }
+  MPI_Finalize();
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_NO_MAIN
+#define BOOST_TEST_ALTERNATIVE_INIT_API
+#include <boost/test/included/unit_test.hpp>
+
+#include "mpi.h"
+#include "gridpack/parallel/communicator.hpp"
+#include "gridpack/parser/record_stream.hpp"
+#include "gridpack/environment/environment.hpp"
+
+#define NREPEAT 20
+#define SHARED_KEY 1000
+#define MISSING_KEY 5000
+
+BOOST_AUTO_TEST_SUITE ( TestRecordStream )
+
+// Each processor holds its rank, 100+rank and a key that is held by all
+// processors. Records are sent in small batches so that several batches
+// are in flight at the same time
+BOOST_AUTO_TEST_CASE( TestRouting )
+{
+  gridpack::parallel::Communicator world;
+  int me = world.rank();
+  int nprocs = world.size();
+  gridpack::parser::RecordStream stream(world, 3);
+  std::vector<int> keys;
+  keys.push_back(me);
+  keys.push_back(100+me);
+  keys.push_back(SHARED_KEY);
+  stream.setKeys(keys);
+
+  int i, p;
+  char buf[128];
+  if (me == 0) {
+    for (i=0; i<NREPEAT; i++) {
+      for (p=0; p<nprocs; p++) {
+        sprintf(buf,"%d, 'REC', %d",p,i);
+        stream.send(std::string(buf),p);
+        sprintf(buf,"%d, 'REC', %d",100+p,i);
+        stream.send(std::string(buf),100+p);
+      }
+      sprintf(buf,"%d, 'REC', %d",SHARED_KEY,i);
+      stream.send(std::string(buf),SHARED_KEY);
+      stream.send(std::string("unused"),MISSING_KEY);
+    }
+    stream.finish();
+  }
+
+  // Records with the same key must arrive in the order they were sent
+  std::vector<std::string> expected[3];
+  int keys_me[3];
+  keys_me[0] = me;
+  keys_me[1] = 100+me;
+  keys_me[2] = SHARED_KEY;
+  int k;
+  for (i=0; i<NREPEAT; i++) {
+    for (k=0; k<3; k++) {
+      sprintf(buf,"%d, 'REC', %d",keys_me[k],i);
+      expected[k].push_back(std::string(buf));
+    }
+  }
+  std::vector<std::string> records, received[3];
+  int nreceived = 0;
+  while (stream.receive(records)) {
+    for (i=0; i<static_cast<int>(records.size()); i++) {
+      int key = atoi(records[i].c_str());
+      for (k=0; k<3; k++) {
+        if (key == keys_me[k]) received[k].push_back(records[i]);
+      }
+      nreceived++;
+    }
+  }
+  BOOST_CHECK_EQUAL(nreceived, 3*NREPEAT);
+  for (k=0; k<3; k++) {
+    BOOST_CHECK_EQUAL(received[k].size(), expected[k].size());
+    if (received[k].size() == expected[k].size()) {
+      for (i=0; i<static_cast<int>(expected[k].size()); i++) {
+        BOOST_CHECK_EQUAL(received[k][i], expected[k][i]);
+      }
+    }
+  }
+
+  // Records with the missing key are reported by its directory processor
+  int nmissing = stream.unresolved().size();
+  int total;
+  MPI_Allreduce(&nmissing,&total,1,MPI_INT,MPI_SUM,
+      static_cast<MPI_Comm>(world));
+  BOOST_CHECK_EQUAL(total, NREPEAT);
+}
+
+// A stream with no records still terminates on all processors
+BOOST_AUTO_TEST_CASE( TestEmpty )
+{
+  gridpack::parallel::Communicator world;
+  gridpack::parser::RecordStream stream(world);
+  std::vector<int> keys;
+  stream.setKeys(keys);
+  if (world.rank() == 0) stream.finish();
+  std::vector<std::string> records;
+  int nrecords = 0;
+  while (stream.receive(records)) nrecords += records.size();
+  BOOST_CHECK_EQUAL(nrecords, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+bool init_function(void)
+{
+  return true;
+}
+
+int main (int argc, char **argv) {
+  gridpack::Environment env(argc, argv);
+  int result = ::boost::unit_test::unit_test_main( &init_function, argc, argv );
+  return result;
+}
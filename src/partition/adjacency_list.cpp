@@ -47,7 +47,8 @@ const AdjacencyList::Index AdjacencyList::bogus(-1);
 AdjacencyList::AdjacencyList(const parallel::Communicator& comm)
   : parallel::Distributed(comm),
     utility::Uncopyable(),
-    p_global_nodes(), p_original_nodes(), p_edges(), p_adjacency()
+    p_global_nodes(), p_original_nodes(), p_edges(), p_adjacency(),
+    p_nweights(0), p_node_weights(), p_edge_weights()
 {
   // empty
 }
@@ -56,7 +57,8 @@ AdjacencyList::AdjacencyList(const parallel::Communicator& comm,
                              const int& local_nodes, const int& local_edges)
   : parallel::Distributed(comm),
     utility::Uncopyable(),
-    p_global_nodes(), p_original_nodes(), p_edges(), p_adjacency()
+    p_global_nodes(), p_original_nodes(), p_edges(), p_adjacency(),
+    p_nweights(0), p_node_weights(), p_edge_weights()
 {
   p_global_nodes.reserve(local_nodes);
   p_original_nodes.reserve(local_nodes);
@@ -69,6 +71,73 @@ AdjacencyList::~AdjacencyList(void)
   // empty
 }
 
+// -------------------------------------------------------------
+// AdjacencyList::add_node
+// -------------------------------------------------------------
+void
+AdjacencyList::add_node(const Index& global_index,
+                        const Index& original_index,
+                        const std::vector<int>& weights)
+{
+  if (p_nweights == 0) p_nweights = weights.size();
+  if (static_cast<int>(weights.size()) != p_nweights) {
+    char buf[256];
+    sprintf(buf,"AdjacencyList::add_node: node has %d weights, expected %d\n",
+        static_cast<int>(weights.size()),p_nweights);
+    throw gridpack::Exception(buf);
+  }
+  // nodes added without weights get a weight of 1
+  p_node_weights.resize(p_global_nodes.size()*p_nweights, 1);
+  p_node_weights.insert(p_node_weights.end(), weights.begin(), weights.end());
+  add_node(global_index, original_index);
+}
+
+// -------------------------------------------------------------
+// AdjacencyList::add_edge
+// -------------------------------------------------------------
+void
+AdjacencyList::add_edge(const Index& edge_index,
+                        Index node_index_1,
+                        Index node_index_2,
+                        const std::vector<int>& weights)
+{
+  if (p_nweights == 0) p_nweights = weights.size();
+  if (static_cast<int>(weights.size()) != p_nweights) {
+    char buf[256];
+    sprintf(buf,"AdjacencyList::add_edge: edge has %d weights, expected %d\n",
+        static_cast<int>(weights.size()),p_nweights);
+    throw gridpack::Exception(buf);
+  }
+  // edges added without weights get a weight of 0
+  p_edge_weights.resize(p_edges.size()*p_nweights, 0);
+  p_edge_weights.insert(p_edge_weights.end(), weights.begin(), weights.end());
+  add_edge(edge_index, node_index_1, node_index_2);
+}
+
+// -------------------------------------------------------------
+// AdjacencyList::node_weight
+// -------------------------------------------------------------
+int
+AdjacencyList::node_weight(const int& local_index, const int& idx) const
+{
+  BOOST_ASSERT(local_index < this->nodes());
+  size_t i(local_index*p_nweights + idx);
+  if (idx >= p_nweights || i >= p_node_weights.size()) return 1;
+  return p_node_weights[i];
+}
+
+// -------------------------------------------------------------
+// AdjacencyList::edge_weight
+// -------------------------------------------------------------
+int
+AdjacencyList::edge_weight(const int& local_index, const int& idx) const
+{
+  BOOST_ASSERT(local_index < this->edges());
+  size_t i(local_index*p_nweights + idx);
+  if (idx >= p_nweights || i >= p_edge_weights.size()) return 0;
+  return p_edge_weights[i];
+}
+
 // -------------------------------------------------------------
 // AdjacencyList::node_index
 // -------------------------------------------------------------
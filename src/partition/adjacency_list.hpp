@@ -96,6 +96,17 @@ public:
     p_edges.push_back(tmp);
   }
 
+  /// Add a local node with weights (one for each balance constraint)
+  void add_node(const Index& global_index, const Index& original_index,
+                const std::vector<int>& weights);
+
+  /// Add a local edge with weights that are added to the node that the
+  /// edge is assigned to (one for each balance constraint)
+  void add_edge(const Index& edge_index, 
+                Index node_index_1,
+                Index node_index_2,
+                const std::vector<int>& weights);
+
   /// Get the global indices of the buses at either end of a branch
   void get_global_edge_ids(int idx, Index *node_index_1, Index *node_index_2) const
   {
@@ -103,6 +114,18 @@ public:
     *node_index_2 = p_edges[idx].global_conn.second;
   }
 
+  /// Get the number of weights for each node (0 if no weights were added)
+  int weights(void) const
+  {
+    return p_nweights;
+  }
+
+  /// Get a weight of a local node (1 if the node has no weights)
+  int node_weight(const int& local_index, const int& idx) const;
+
+  /// Get a weight of a local edge (0 if the edge has no weights)
+  int edge_weight(const int& local_index, const int& idx) const;
+
   /// Get the number of local nodes
   size_t nodes(void) const
   {
@@ -161,6 +184,15 @@ protected:
 
   /// The resulting adjacency for local nodes
   p_Adjacency p_adjacency;
+
+  /// The number of weights for each node and edge
+  int p_nweights;
+
+  /// Weights of local nodes
+  std::vector<int> p_node_weights;
+
+  /// Weights of local edges
+  std::vector<int> p_edge_weights;
   
 
 };
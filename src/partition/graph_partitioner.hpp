@@ -64,6 +64,23 @@ public:
     p_impl->add_edge(edge_index, node_index_1, node_index_2);
   }
 
+  /// Add a local node with weights (one for each balance constraint)
+  void add_node(const Index& global_index, const Index& original_index,
+                const std::vector<int>& weights)
+  {
+    p_impl->add_node(global_index, original_index, weights);
+  }
+
+  /// Add a local edge with weights that are added to the node that the
+  /// edge is assigned to (one for each balance constraint)
+  void add_edge(const Index& edge_index, 
+                const Index& node_index_1,
+                const Index& node_index_2,
+                const std::vector<int>& weights)
+  {
+    p_impl->add_edge(edge_index, node_index_1, node_index_2, weights);
+  }
+
   /// Get the global indices of the buses at either end of a branch
   void get_global_edge_ids(int idx, Index *node_index_1, Index *node_index_2) const
   {
@@ -100,6 +117,13 @@ public:
     p_impl->partition();
   }
 
+  /// Repartition a graph that is already distributed, moving as few
+  /// nodes as possible
+  void repartition(const double& itr = 1000.0)
+  {
+    p_impl->repartition(itr);
+  }
+
   /// Get the node destinations
   void node_destinations(IndexVector& dest) const
   {
@@ -124,6 +148,12 @@ public:
     p_impl->ghost_edge_destinations(dest);
   }
 
+  /// Get the total weight of the nodes and edges assigned to each process
+  int partition_loads(std::vector<int>& loads) const
+  {
+    return p_impl->partition_loads(loads);
+  }
+
 protected:
 
   /// The actual implementation
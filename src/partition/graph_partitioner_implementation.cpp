@@ -47,7 +47,8 @@ GraphPartitionerImplementation::GraphPartitionerImplementation(const parallel::C
   : parallel::Distributed(comm), utility::Uncopyable(),
     p_adjacency_list(comm), 
     p_node_destinations(),
-    p_edge_destinations()
+    p_edge_destinations(),
+    p_adaptive(false), p_itr(1000.0)
 {
     gridpack::NoPrint *noprint = gridpack::NoPrint::instance();
     p_no_print = noprint->status();
@@ -60,7 +61,8 @@ GraphPartitionerImplementation::GraphPartitionerImplementation(const parallel::C
   : parallel::Distributed(comm), utility::Uncopyable(),
     p_adjacency_list(comm, local_nodes, local_edges), 
     p_node_destinations(local_nodes),
-    p_edge_destinations(local_edges)
+    p_edge_destinations(local_edges),
+    p_adaptive(false), p_itr(1000.0)
 {
   // empty
 }
@@ -115,6 +117,52 @@ GraphPartitionerImplementation::ghost_edge_destinations(GraphPartitionerImplemen
             std::back_inserter(dest));
 }
 
+// -------------------------------------------------------------
+// GraphPartitionerImplementation::repartition
+// -------------------------------------------------------------
+void
+GraphPartitionerImplementation::repartition(const double& itr)
+{
+  p_adaptive = true;
+  p_itr = itr;
+  this->partition();
+  p_adaptive = false;
+}
+
+// -------------------------------------------------------------
+// GraphPartitionerImplementation::partition_loads
+// -------------------------------------------------------------
+int
+GraphPartitionerImplementation::partition_loads(std::vector<int>& loads) const
+{
+  int nprocs(this->processor_size());
+  int ncon(p_adjacency_list.weights());
+  int maxcon;
+  boost::mpi::all_reduce(communicator(), ncon, maxcon,
+                         boost::mpi::maximum<int>());
+  ncon = (maxcon > 0 ? maxcon : 1);
+
+  std::vector<int> local(nprocs*ncon, 0);
+  int nnodes(p_node_destinations.size());
+  int nedges(p_edge_destinations.size());
+  for (int n = 0; n < nnodes; ++n) {
+    int dest(p_node_destinations[n]);
+    for (int c = 0; c < ncon; ++c) {
+      local[dest*ncon+c] += p_adjacency_list.node_weight(n, c);
+    }
+  }
+  for (int e = 0; e < nedges; ++e) {
+    int dest(p_edge_destinations[e]);
+    for (int c = 0; c < ncon; ++c) {
+      local[dest*ncon+c] += p_adjacency_list.edge_weight(e, c);
+    }
+  }
+  loads.resize(nprocs*ncon);
+  MPI_Allreduce(&local[0], &loads[0], nprocs*ncon, MPI_INT, MPI_SUM,
+                static_cast<MPI_Comm>(communicator()));
+  return ncon;
+}
+
 // -------------------------------------------------------------
 // GraphPartitionerImplementation::partition
 // -------------------------------------------------------------
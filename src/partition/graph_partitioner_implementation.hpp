@@ -68,6 +68,23 @@ public:
     p_adjacency_list.add_edge(edge_index, node_index_1, node_index_2);
   }
 
+  /// Add a local node with weights (one for each balance constraint)
+  void add_node(const Index& global_index, const Index& original_index,
+                const std::vector<int>& weights)
+  {
+    p_adjacency_list.add_node(global_index, original_index, weights);
+  }
+
+  /// Add a local edge with weights that are added to the node that the
+  /// edge is assigned to (one for each balance constraint)
+  void add_edge(const Index& edge_index, 
+                const Index& node_index_1,
+                const Index& node_index_2,
+                const std::vector<int>& weights)
+  {
+    p_adjacency_list.add_edge(edge_index, node_index_1, node_index_2, weights);
+  }
+
   /// Get the global indices of the buses at either end of a branch
   void get_global_edge_ids(int idx, Index *node_index_1, Index *node_index_2) const
   {
@@ -101,6 +118,19 @@ public:
   /// Partition the graph
   void partition(void);
 
+  /// Repartition a graph that is already distributed over processes
+  /**
+   * The current distribution of the nodes is used as the starting
+   * point, so that only enough nodes are moved to restore the balance
+   * of the node weights. This is a collective operation that is used
+   * in place of partition().
+   * 
+   * @param itr ratio of the time spent in inter-process communication
+   * to the time needed to move nodes between processes. Large values
+   * favor a small edge cut and small values favor moving few nodes.
+   */
+  void repartition(const double& itr);
+
   /// Get the node destinations
   void node_destinations(IndexVector& dest) const;
 
@@ -113,6 +143,19 @@ public:
   /// Get the destinations of ghosted edges
   void ghost_edge_destinations(IndexVector& dest) const;
 
+  /// Get the total weight of the nodes and edges assigned to each process
+  /**
+   * This is a collective operation that can be called after the graph
+   * has been partitioned.
+   * 
+   * @param loads total weights for each process, stored with all the
+   * weights for process 0 first
+   * 
+   * @return the number of weights for each process (1, the number of
+   * nodes, if no weights were added)
+   */
+  int partition_loads(std::vector<int>& loads) const;
+
 protected:
 
   /// Adjacency list builder
@@ -130,6 +173,12 @@ protected:
   /// A list of processors where local edges should go
   IndexVector p_ghost_edge_destinations;
 
+  /// True if the current distribution should be used as a starting point
+  bool p_adaptive;
+
+  /// Ratio of communication time to redistribution time (repartition only)
+  double p_itr;
+
   /// Partition the graph (specialized)
   virtual void p_partition(void) = 0;
 
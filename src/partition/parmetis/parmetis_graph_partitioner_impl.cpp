@@ -14,6 +14,7 @@
  */
 
 #include <parmetis.h>
+#include <cstdio>
 #include <algorithm>
 #include <utility>
 #include <boost/mpi/collectives.hpp>
@@ -21,6 +22,7 @@
 #include <boost/serialization/utility.hpp>
 #include "parmetis/parmetis_graph_partitioner_impl.hpp"
 #include "parmetis/parmetis_graph_wrapper.hpp"
+#include "gridpack/utilities/exception.hpp"
 
 
 namespace gridpack {
@@ -83,7 +85,23 @@ ParMETISGraphPartitionerImpl::p_partition(void)
 
   ParMETISGraphWrapper wrap(p_adjacency_list);
 
-  wrap.get_csr_local(vtxdist, xadj, adjncy);
+  // Adaptive repartitioning uses the current distribution of nodes as
+  // the starting partition, so every process must have at least one
+  // node. If not, partition from scratch
+
+  bool adaptive(p_adaptive);
+  if (adaptive) {
+    int locnodes(p_adjacency_list.nodes()), minnodes;
+    boost::mpi::all_reduce(this->communicator(), locnodes, minnodes,
+                           boost::mpi::minimum<int>());
+    if (minnodes <= 0) adaptive = false;
+  }
+
+  if (adaptive) {
+    wrap.get_csr_current(vtxdist, xadj, adjncy);
+  } else {
+    wrap.get_csr_local(vtxdist, xadj, adjncy);
+  }
 
   int nnodes(vtxdist[me+1] - vtxdist[me]);
 
@@ -116,13 +134,23 @@ ParMETISGraphPartitionerImpl::p_partition(void)
 
   int status;
 
+  // If weights were supplied, balance each of them separately
+  // (multi-constraint partitioning). Otherwise, balance the number of
+  // nodes
+
   idx_t ncon(1);
   idx_t wgtflag(3), numflag(0);
   idx_t nparts(this->processor_size());
-  std::vector<idx_t> vwgt(nnodes, 1);
+  std::vector<idx_t> vwgt;
+  if (wrap.weights() > 0) {
+    ncon = wrap.weights();
+    wrap.get_vwgt_local(vtxdist, vwgt);
+  } else {
+    vwgt.resize(nnodes, 1);
+  }
   std::vector<idx_t> adjwgt(adjncy.size(), 2);
   std::vector<real_t> tpwgts(nparts*ncon, 1.0/static_cast<real_t>(nparts));
-  real_t ubvec(1.05);
+  std::vector<real_t> ubvec(ncon, 1.05);
   std::vector<idx_t> options(3);
   // Too verbose
   // options[0] = 1;
@@ -136,25 +164,55 @@ ParMETISGraphPartitionerImpl::p_partition(void)
 
   idx_t edgecut;
   std::vector<idx_t> part(nnodes);
-  status = ParMETIS_V3_PartKway(&vtxdist[0], 
-                                &xadj[0], 
-                                &adjncy[0],
-                                &vwgt[0],
-                                &adjwgt[0],
-                                &wgtflag,
-                                &numflag,
-                                &ncon,
-                                &nparts,
-                                &tpwgts[0],
-                                &ubvec,
-                                &options[0],
-                                &edgecut, &part[0],
-                                &comm);
-  if (status != METIS_OK) {
-    // FIXME: throw an exception
-    std::cerr << "Warning: ParMETIS_V3_PartKway returned an error code: "
-              << status
-              << std::endl;
+  if (adaptive) {
+    // all nodes are assumed to cost the same to move
+    std::vector<idx_t> vsize(nnodes, 1);
+    real_t itr(p_itr);
+    status = ParMETIS_V3_AdaptiveRepart(&vtxdist[0], 
+                                        &xadj[0], 
+                                        &adjncy[0],
+                                        &vwgt[0],
+                                        &vsize[0],
+                                        &adjwgt[0],
+                                        &wgtflag,
+                                        &numflag,
+                                        &ncon,
+                                        &nparts,
+                                        &tpwgts[0],
+                                        &ubvec[0],
+                                        &itr,
+                                        &options[0],
+                                        &edgecut, &part[0],
+                                        &comm);
+  } else {
+    status = ParMETIS_V3_PartKway(&vtxdist[0], 
+                                  &xadj[0], 
+                                  &adjncy[0],
+                                  &vwgt[0],
+                                  &adjwgt[0],
+                                  &wgtflag,
+                                  &numflag,
+                                  &ncon,
+                                  &nparts,
+                                  &tpwgts[0],
+                                  &ubvec[0],
+                                  &options[0],
+                                  &edgecut, &part[0],
+                                  &comm);
+  }
+
+  // Make sure that all processes throw if the partitioner failed on any
+  // of them. METIS_OK is larger than any of the error codes
+
+  int minstatus;
+  boost::mpi::all_reduce(this->communicator(), status, minstatus,
+                         boost::mpi::minimum<int>());
+  if (minstatus != METIS_OK) {
+    char buf[256];
+    sprintf(buf,"ParMETISGraphPartitionerImpl::p_partition: %s returned error code %d\n",
+        (adaptive ? "ParMETIS_V3_AdaptiveRepart" : "ParMETIS_V3_PartKway"),
+        minstatus);
+    throw gridpack::Exception(buf);
   }
 
   // "part" contains the destination processors; transfer this to the
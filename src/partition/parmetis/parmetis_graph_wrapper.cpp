@@ -17,6 +17,7 @@
 
 
 #include <ga++.h>
+#include <algorithm>
 #include <boost/mpi/collectives.hpp>
 #include <boost/assert.hpp>
 #include <boost/lambda/lambda.hpp>
@@ -48,7 +49,7 @@ ParMETISGraphWrapper::ParMETISGraphWrapper(const AdjacencyList& alist)
     p_global_nodes(0), p_global_edges(0),
     p_node_data(), p_local_node_id(), 
     p_node_lo(-1), p_node_hi(-1), 
-    p_xadj_gbl(), p_adjncy_gbl()
+    p_xadj_gbl(), p_adjncy_gbl(), p_ncon(0), p_vwgt_gbl()
 {
   p_initialize();
 }
@@ -168,6 +169,61 @@ ParMETISGraphWrapper::p_initialize_gbl(const int& gblnodes, const int& locnodes,
                                          "ParMETIS Adjacency List", NULL));
   p_adjncy_gbl->zero();
 
+  // Node weights. Each edge is assigned to the same partition as the lowest
+  // numbered node to which it connects, so edge weights are added to that
+  // node
+
+  int ncon(p_adjacency.weights());
+  all_reduce(this->communicator().getCommunicator(), 
+             ncon, p_ncon, boost::mpi::maximum<int>());
+
+  if (p_ncon > 0) {
+    dims[0] = gblnodes*p_ncon;
+    p_vwgt_gbl.reset(new GA::GlobalArray(MT_C_INT, one, dims,
+                                         "ParMETIS Node Weights", NULL));
+    p_vwgt_gbl->zero();
+
+    if (locnodes > 0) {
+      std::vector<int> wgt(locnodes*p_ncon);
+      for (int n = 0; n < locnodes; ++n) {
+        for (int c = 0; c < p_ncon; ++c) {
+          wgt[n*p_ncon+c] = p_adjacency.node_weight(n, c);
+        }
+      }
+      lo[0] = p_node_lo*p_ncon;
+      hi[0] = (p_node_hi+1)*p_ncon - 1;
+      p_vwgt_gbl->put(lo, hi, &wgt[0], ld);
+    }
+
+    communicator().sync();
+
+    if (locedges > 0) {
+      std::vector<int> gidx(locedges), widx(locedges);
+      std::vector<int*> gptr(locedges);
+      for (int e = 0; e < locedges; ++e) {
+        AdjacencyList::Index n1, n2;
+        p_adjacency.edge(e, n1, n2);
+        gidx[e] = std::min(n1, n2);
+        gptr[e] = &gidx[e];
+      }
+      p_local_node_id->gather(&widx[0], &gptr[0], locedges);
+      std::vector<int> wgt(locedges);
+      std::vector<int> sidx(locedges);
+      std::vector<int*> sptr(locedges);
+      for (int c = 0; c < p_ncon; ++c) {
+        for (int e = 0; e < locedges; ++e) {
+          wgt[e] = p_adjacency.edge_weight(e, c);
+          sidx[e] = widx[e]*p_ncon + c;
+          sptr[e] = &sidx[e];
+        }
+        int alpha(1);
+        p_vwgt_gbl->scatterAcc(&wgt[0], &sptr[0], locedges, &alpha);
+      }
+    }
+
+    communicator().sync();
+  }
+
   std::vector<AdjacencyList::Index> nbrs;
   std::vector<int> inbrs;
   for (int p = 0; p < this->processor_size(); ++p) {
@@ -256,7 +312,6 @@ ParMETISGraphWrapper::get_csr_local(std::vector<idx_t>& vtxdist,
   BOOST_ASSERT(p_global_edges > 0);
 
   int nproc(this->processor_size());
-  int me(this->processor_rank());
 
                                 // build the node distribution vector
 
@@ -266,7 +321,6 @@ ParMETISGraphWrapper::get_csr_local(std::vector<idx_t>& vtxdist,
     int p(i % nproc);
     vtxdist[p] += 1;
   }
-  int localnodes(vtxdist[me]);
   int sum(0);
   for (int p = 0; p < nproc; ++p) {
     int tmp(vtxdist[p]);
@@ -275,6 +329,60 @@ ParMETISGraphWrapper::get_csr_local(std::vector<idx_t>& vtxdist,
   }
   vtxdist[nproc] = sum;
 
+  p_get_csr(vtxdist, xadj, adjncy);
+}
+
+// -------------------------------------------------------------
+// ParMETISGraphWrapper::get_csr_current
+// -------------------------------------------------------------
+/** 
+ * The nodes in ::p_xadj_gbl are ordered by the process that added
+ * them to the adjacency list, so the current distribution of nodes
+ * is just the number of local nodes on each process. ParMETIS treats
+ * this distribution as the current partition when repartitioning.
+ * 
+ * @param vtxdist current node distribution
+ * @param xadj index into adjncy for local nodes
+ * @param adjncy neighbors of local nodes
+ */
+void
+ParMETISGraphWrapper::get_csr_current(std::vector<idx_t>& vtxdist,
+                                      std::vector<idx_t>& xadj,
+                                      std::vector<idx_t>& adjncy) const
+{
+  BOOST_ASSERT(p_global_nodes > 0);
+  BOOST_ASSERT(p_global_edges > 0);
+
+  int nproc(this->processor_size());
+  int localnodes(p_node_hi - p_node_lo + 1);
+  std::vector<int> nodes_by_proc;
+  all_gather(this->communicator().getCommunicator(), 
+             localnodes, nodes_by_proc);
+
+  vtxdist.clear();
+  vtxdist.resize(nproc+1, 0);
+  int sum(0);
+  for (int p = 0; p < nproc; ++p) {
+    vtxdist[p] = sum;
+    sum += nodes_by_proc[p];
+  }
+  vtxdist[nproc] = sum;
+
+  p_get_csr(vtxdist, xadj, adjncy);
+}
+
+// -------------------------------------------------------------
+// ParMETISGraphWrapper::p_get_csr
+// -------------------------------------------------------------
+void
+ParMETISGraphWrapper::p_get_csr(const std::vector<idx_t>& vtxdist,
+                                std::vector<idx_t>& xadj,
+                                std::vector<idx_t>& adjncy) const
+{
+  int me(this->processor_rank());
+  int localnodes(vtxdist[me+1] - vtxdist[me]);
+  int sum;
+
                                 // extract adjacency index
 
   int maxdim(two);
@@ -319,6 +427,46 @@ ParMETISGraphWrapper::get_csr_local(std::vector<idx_t>& vtxdist,
   communicator().sync();
 }
 
+/** 
+ * Get the weights of the nodes in the local part of the ParMETIS
+ * graph. If all weights for one of the balance constraints are zero,
+ * all nodes get a weight of one for that constraint.
+ * 
+ * @param vtxdist distribution of nodes from get_csr_local()
+ * @param vwgt node weights, with the weights of each node stored
+ * together
+ */
+void
+ParMETISGraphWrapper::get_vwgt_local(const std::vector<idx_t>& vtxdist,
+                                     std::vector<idx_t>& vwgt) const
+{
+  BOOST_ASSERT(p_ncon > 0);
+  BOOST_ASSERT(p_vwgt_gbl);
+
+  int me(this->processor_rank());
+  int localnodes(vtxdist[me+1] - vtxdist[me]);
+  std::vector<int> tmp(localnodes*p_ncon+1);
+  int lo(vtxdist[me]*p_ncon), hi(vtxdist[me+1]*p_ncon - 1), ld(1);
+  if (hi >= lo) p_vwgt_gbl->get(&lo, &hi, &tmp[0], &ld);
+
+  std::vector<int> sum(p_ncon, 0), gsum(p_ncon);
+  for (int n = 0; n < localnodes; ++n) {
+    for (int c = 0; c < p_ncon; ++c) {
+      sum[c] += tmp[n*p_ncon+c];
+    }
+  }
+  MPI_Allreduce(&sum[0], &gsum[0], p_ncon, MPI_INT, MPI_SUM,
+                static_cast<MPI_Comm>(this->communicator()));
+
+  vwgt.clear();
+  vwgt.reserve(localnodes*p_ncon);
+  for (int n = 0; n < localnodes; ++n) {
+    for (int c = 0; c < p_ncon; ++c) {
+      vwgt.push_back(gsum[c] > 0 ? tmp[n*p_ncon+c] : 1);
+    }
+  }
+}
+
 // -------------------------------------------------------------
 // ParMETISGraphWrapper::set_partition
 // -------------------------------------------------------------
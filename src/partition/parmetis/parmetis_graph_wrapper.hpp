@@ -71,6 +71,22 @@ public:
                      std::vector<idx_t>& xadj,
                      std::vector<idx_t>& adjncy) const;
 
+  /// Get the local part of the "Distributed CSR graph" using the
+  /// current distribution of the nodes (used by adaptive repartitioning)
+  void get_csr_current(std::vector<idx_t>& vtxdist,
+                       std::vector<idx_t>& xadj,
+                       std::vector<idx_t>& adjncy) const;
+
+  /// Get the number of weights for each node (0 if the graph has no weights)
+  int weights(void) const
+  {
+    return p_ncon;
+  }
+
+  /// Get the weights of the local ParMETIS graph nodes
+  void get_vwgt_local(const std::vector<idx_t>& vtxdist,
+                      std::vector<idx_t>& vwgt) const;
+
   /// Assign partition number for local ParMETIS graph nodes
   void set_partition(const std::vector<idx_t>& vtxdist, 
                      const std::vector<idx_t>& part);
@@ -137,9 +153,26 @@ protected:
    */
   boost::scoped_ptr<GA::GlobalArray> p_adjncy_gbl;
 
+  /// The number of weights for each node
+  int p_ncon;
+
+  /// The node weights
+  /**
+   * This is indexed the same way as ::p_xadj_gbl, with the ::p_ncon
+   * weights of each node stored together. Edge weights are added to
+   * the node that the edge will be assigned to.
+   * 
+   */
+  boost::scoped_ptr<GA::GlobalArray> p_vwgt_gbl;
+
   /// The initialize routine
   void p_initialize(void);
 
+  /// Extract the local part of the graph for a given node distribution
+  void p_get_csr(const std::vector<idx_t>& vtxdist,
+                 std::vector<idx_t>& xadj,
+                 std::vector<idx_t>& adjncy) const;
+
   /// Routine to initialize the GA part of this instance
   void p_initialize_gbl(const int& gblnodes, const int& locnodes,
                         const int& gbledges, const int& locedges);
@@ -0,0 +1,348 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   async_writer.hpp
+ * @author agent
+ * @date   2026-10-17
+ *
+ * @brief
+ * Background thread that writes text to output streams. Text is copied into
+ * a bounded queue and the calling thread returns immediately, so the time
+ * spent writing to disk overlaps with the rest of the calculation. If the
+ * queue is full, the calling thread waits until enough text has been
+ * written (back-pressure). The number and length of these waits are
+ * recorded so that the size of the queue can be tuned.
+ *
+ * The background thread never calls MPI or GA, so only
+ * MPI_THREAD_FUNNELED support is needed. Environment requests this level
+ * and the writer checks that it was provided before the thread is started.
+ * Serial IO functions that make MPI or GA calls check that they are not
+ * running on the background thread. There is a single writer per
+ * process and text from all serial IO objects that use it is written in
+ * the order it was queued.
+ *
+ */
+// -------------------------------------------------------------
+
+#ifndef _async_writer_h_
+#define _async_writer_h_
+
+#include <mpi.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <deque>
+#include <string>
+#include <ostream>
+#include <cstdio>
+#include "gridpack/utilities/exception.hpp"
+
+// default limit on the number of bytes held in the queue
+#define ASYNC_WRITER_QUEUE_SIZE 67108864
+
+namespace gridpack {
+namespace serial_io {
+
+class AsyncWriter {
+  public:
+
+  /**
+   * Return the writer used by all serial IO objects on this process
+   * @return pointer to writer
+   */
+  static AsyncWriter* instance(void)
+  {
+    static AsyncWriter writer;
+    return &writer;
+  }
+
+  /**
+   * Simple destructor. Writes any remaining text and stops the background
+   * thread
+   */
+  ~AsyncWriter(void)
+  {
+    if (p_running) {
+      pthread_mutex_lock(&p_mutex);
+      p_stop = true;
+      pthread_cond_broadcast(&p_ready);
+      pthread_mutex_unlock(&p_mutex);
+      pthread_join(p_thread, NULL);
+    }
+    pthread_cond_destroy(&p_ready);
+    pthread_cond_destroy(&p_space);
+    pthread_mutex_destroy(&p_mutex);
+  }
+
+  /**
+   * Set the maximum number of bytes that can be held in the queue
+   * @param bytes maximum size of queue
+   */
+  void setQueueSize(long bytes)
+  {
+    pthread_mutex_lock(&p_mutex);
+    p_maxBytes = bytes > 0 ? bytes : 1;
+    pthread_cond_broadcast(&p_space);
+    pthread_mutex_unlock(&p_mutex);
+  }
+
+  /**
+   * Add text to the queue. If the queue is full, wait until there is room.
+   * A single record larger than the queue is accepted once the queue is
+   * empty
+   * @param out stream that text is written to. The stream must remain open
+   *        until flush has been called
+   * @param text text to be written
+   */
+  void write(std::ostream *out, const std::string &text)
+  {
+    if (text.size() == 0) return;
+    long len = text.size();
+    pthread_mutex_lock(&p_mutex);
+    if (!p_running) start();
+    if (p_queued > 0 && p_queued+len > p_maxBytes) {
+      p_stalls++;
+      double t0 = wallTime();
+      while (p_queued > 0 && p_queued+len > p_maxBytes) {
+        pthread_cond_wait(&p_space, &p_mutex);
+      }
+      p_stallTime += wallTime()-t0;
+    }
+    p_queue.push_back(record(out, text));
+    p_queued += len;
+    if (p_queued > p_maxQueued) p_maxQueued = p_queued;
+    p_records++;
+    p_bytes += len;
+    pthread_cond_signal(&p_ready);
+    pthread_mutex_unlock(&p_mutex);
+  }
+
+  /**
+   * Wait until all queued text has been written and the streams have been
+   * flushed
+   */
+  void flush(void)
+  {
+    pthread_mutex_lock(&p_mutex);
+    while (p_queue.size() > 0 || p_busy) {
+      pthread_cond_wait(&p_space, &p_mutex);
+    }
+    pthread_mutex_unlock(&p_mutex);
+  }
+
+  /**
+   * Check if any text is waiting to be written
+   * @return true if queue is empty and no text is being written
+   */
+  bool idle(void)
+  {
+    pthread_mutex_lock(&p_mutex);
+    bool ret = (p_queue.size() == 0 && !p_busy);
+    pthread_mutex_unlock(&p_mutex);
+    return ret;
+  }
+
+  /**
+   * Check if the calling thread is the background thread
+   * @return true if called from the background thread
+   */
+  bool onWriterThread(void)
+  {
+    return p_running && pthread_equal(pthread_self(), p_thread);
+  }
+
+  /**
+   * Throw an exception if the calling thread is the background thread.
+   * Called at the start of functions that make MPI or GA calls
+   * @param name name of calling function
+   */
+  void checkNotWriterThread(const char *name)
+  {
+    if (onWriterThread()) {
+      char buf[256];
+      sprintf(buf,"%s: MPI and GA cannot be called from the IO thread\n",
+          name);
+      throw gridpack::Exception(buf);
+    }
+  }
+
+  /**
+   * Return number of records that have been queued
+   * @return number of records
+   */
+  long numRecords(void) const
+  {
+    return p_records;
+  }
+
+  /**
+   * Return number of bytes that have been queued
+   * @return number of bytes
+   */
+  long numBytes(void) const
+  {
+    return p_bytes;
+  }
+
+  /**
+   * Return number of times the calling thread had to wait for room in the
+   * queue
+   * @return number of waits
+   */
+  long numStalls(void) const
+  {
+    return p_stalls;
+  }
+
+  /**
+   * Return total time (seconds) that the calling thread spent waiting for
+   * room in the queue
+   * @return time spent waiting
+   */
+  double stallTime(void) const
+  {
+    return p_stallTime;
+  }
+
+  /**
+   * Return the largest number of bytes held in the queue at one time
+   * @return high water mark of queue
+   */
+  long maxQueued(void) const
+  {
+    return p_maxQueued;
+  }
+
+  /**
+   * Print statistics on the use of the queue
+   * @param out stream for output
+   */
+  void printStats(std::ostream &out)
+  {
+    char buf[256];
+    sprintf(buf,"Asynchronous IO: records: %ld bytes: %ld max queued: %ld"
+        " stalls: %ld stall time: %12.6f\n",p_records,p_bytes,p_maxQueued,
+        p_stalls,p_stallTime);
+    out << buf;
+  }
+
+  private:
+
+  typedef std::pair<std::ostream*, std::string> record;
+
+  /**
+   * Constructor is private. Use instance to get writer
+   */
+  AsyncWriter(void)
+    : p_running(false), p_stop(false), p_busy(false), p_queued(0),
+      p_maxBytes(ASYNC_WRITER_QUEUE_SIZE), p_records(0), p_bytes(0),
+      p_stalls(0), p_stallTime(0.0), p_maxQueued(0)
+  {
+    pthread_mutex_init(&p_mutex, NULL);
+    pthread_cond_init(&p_ready, NULL);
+    pthread_cond_init(&p_space, NULL);
+  }
+
+  /**
+   * Start background thread. Called with mutex locked
+   */
+  void start(void)
+  {
+    // MPI calls stay on the main thread, which requires at least
+    // MPI_THREAD_FUNNELED support once a second thread exists
+    int initialized, provided;
+    MPI_Initialized(&initialized);
+    if (initialized) {
+      MPI_Query_thread(&provided);
+      if (provided < MPI_THREAD_FUNNELED) {
+        pthread_mutex_unlock(&p_mutex);
+        throw gridpack::Exception(
+            "AsyncWriter::start: MPI does not provide MPI_THREAD_FUNNELED"
+            " support\n");
+      }
+    }
+    if (pthread_create(&p_thread, NULL, &AsyncWriter::run, this) != 0) {
+      pthread_mutex_unlock(&p_mutex);
+      throw gridpack::Exception(
+          "AsyncWriter::start: unable to create IO thread\n");
+    }
+    p_running = true;
+  }
+
+  /**
+   * Entry point of background thread
+   * @param arg pointer to writer
+   */
+  static void* run(void *arg)
+  {
+    static_cast<AsyncWriter*>(arg)->drain();
+    return NULL;
+  }
+
+  /**
+   * Write records until the writer is stopped
+   */
+  void drain(void)
+  {
+    pthread_mutex_lock(&p_mutex);
+    while (true) {
+      while (p_queue.size() == 0 && !p_stop) {
+        pthread_cond_wait(&p_ready, &p_mutex);
+      }
+      if (p_queue.size() == 0 && p_stop) break;
+      record rec;
+      rec.first = p_queue.front().first;
+      rec.second.swap(p_queue.front().second);
+      p_queue.pop_front();
+      p_busy = true;
+      pthread_mutex_unlock(&p_mutex);
+      *(rec.first) << rec.second;
+      // flush stream if nothing else is waiting for it so that the contents
+      // of the file are current when flush returns
+      pthread_mutex_lock(&p_mutex);
+      bool last = (p_queue.size() == 0);
+      pthread_mutex_unlock(&p_mutex);
+      if (last) rec.first->flush();
+      pthread_mutex_lock(&p_mutex);
+      p_busy = false;
+      p_queued -= rec.second.size();
+      pthread_cond_broadcast(&p_space);
+    }
+    pthread_mutex_unlock(&p_mutex);
+  }
+
+  /**
+   * Return wall clock time
+   * @return time in seconds
+   */
+  static double wallTime(void)
+  {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return static_cast<double>(tv.tv_sec)
+      + 1.0e-6*static_cast<double>(tv.tv_usec);
+  }
+
+  pthread_t p_thread;
+  pthread_mutex_t p_mutex;
+  pthread_cond_t p_ready;
+  pthread_cond_t p_space;
+  bool p_running;
+  bool p_stop;
+  bool p_busy;
+  std::deque<record> p_queue;
+  long p_queued;
+  long p_maxBytes;
+  long p_records;
+  long p_bytes;
+  long p_stalls;
+  double p_stallTime;
+  long p_maxQueued;
+};
+
+}   // serial_io
+}   // gridpack
+#endif  // _async_writer_h_
@@ -0,0 +1,185 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   parallel_file.hpp
+ * @author agent
+ * @date   2026-10-17
+ *
+ * @brief
+ * Text file that is written collectively using MPI-IO. Each call to write
+ * appends one block of text from every processor. Blocks are placed in rank
+ * order, so the file has the same contents as it would if all text were sent
+ * to process 0 and written there, but no data moves between processors.
+ * Headers written by process 0 are held until the next collective write or
+ * until the file is closed.
+ *
+ */
+// -------------------------------------------------------------
+
+#ifndef _parallel_file_h_
+#define _parallel_file_h_
+
+#include <mpi.h>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "gridpack/parallel/communicator.hpp"
+#include "gridpack/utilities/exception.hpp"
+
+namespace gridpack {
+namespace serial_io {
+
+class ParallelFile {
+  public:
+
+  /**
+   * Simple constructor
+   * @param comm communicator of processors writing to file
+   */
+  ParallelFile(const gridpack::parallel::Communicator &comm)
+    : p_comm(static_cast<MPI_Comm>(comm)), p_me(comm.rank()),
+      p_open(false), p_offset(0)
+  {
+  }
+
+  /**
+   * Simple destructor. Closes the file if it is still open
+   */
+  ~ParallelFile(void)
+  {
+    close();
+  }
+
+  /**
+   * Create file, replacing any existing file with the same name. This is a
+   * collective operation
+   * @param filename name of file
+   */
+  void open(const char *filename)
+  {
+    close();
+    int ierr = MPI_File_open(p_comm, const_cast<char*>(filename),
+        MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &p_fh);
+    if (ierr != MPI_SUCCESS) {
+      char buf[512];
+      sprintf(buf,"ParallelFile::open: unable to open file %s\n",filename);
+      throw gridpack::Exception(buf);
+    }
+    MPI_File_set_size(p_fh, 0);
+    p_open = true;
+    p_offset = 0;
+    p_header.clear();
+  }
+
+  /**
+   * Check if file is open
+   * @return true if file is open
+   */
+  bool isOpen(void) const
+  {
+    return p_open;
+  }
+
+  /**
+   * Add text from process 0 only. The text appears in front of the next
+   * block written by write. Calls on other processes are ignored
+   * @param str character string containing the header
+   */
+  void header(const char *str)
+  {
+    if (p_me == 0 && p_open) p_header.append(str);
+  }
+
+  /**
+   * Append a block of text from each processor. Blocks appear in the file
+   * in rank order. This is a collective operation
+   * @param buf text written by this processor
+   * @param len number of characters in buf
+   */
+  void write(const char *buf, long len)
+  {
+    if (!p_open) return;
+    const char *data = buf;
+    if (p_me == 0 && p_header.size() > 0) {
+      p_header.append(buf, len);
+      data = p_header.data();
+      len = p_header.size();
+    }
+    long long size = len;
+    long long offset = 0;
+    long long total = 0;
+    MPI_Exscan(&size, &offset, 1, MPI_LONG_LONG, MPI_SUM, p_comm);
+    if (p_me == 0) offset = 0;
+    MPI_Allreduce(&size, &total, 1, MPI_LONG_LONG, MPI_SUM, p_comm);
+    MPI_Status status;
+    MPI_File_write_at_all(p_fh, static_cast<MPI_Offset>(p_offset+offset),
+        const_cast<char*>(data), static_cast<int>(len), MPI_CHAR, &status);
+    p_offset += total;
+    p_header.clear();
+  }
+
+  /**
+   * Check whether the blocks written by each processor would be in order.
+   * Each processor passes the range of indices (for example, global bus
+   * indices) of the records it holds. This is a collective operation
+   * @param first smallest index on this processor
+   * @param last largest index on this processor. If last < first, the
+   *        processor has no records
+   * @return true if the ranges on processors with records are disjoint and
+   *         increase with rank
+   */
+  bool inRankOrder(int first, int last)
+  {
+    int nprocs;
+    MPI_Comm_size(p_comm, &nprocs);
+    int range[2];
+    range[0] = first;
+    range[1] = last;
+    std::vector<int> ranges(2*nprocs);
+    MPI_Allgather(range, 2, MPI_INT, &ranges[0], 2, MPI_INT, p_comm);
+    bool found = false;
+    int prev = 0;
+    int p;
+    for (p=0; p<nprocs; p++) {
+      if (ranges[2*p+1] < ranges[2*p]) continue;
+      if (found && ranges[2*p] <= prev) return false;
+      prev = ranges[2*p+1];
+      found = true;
+    }
+    return true;
+  }
+
+  /**
+   * Write any remaining header text and close the file. This is a
+   * collective operation
+   */
+  void close(void)
+  {
+    if (!p_open) return;
+    if (p_me == 0 && p_header.size() > 0) {
+      MPI_Status status;
+      MPI_File_write_at(p_fh, static_cast<MPI_Offset>(p_offset),
+          const_cast<char*>(p_header.data()),
+          static_cast<int>(p_header.size()), MPI_CHAR, &status);
+    }
+    p_header.clear();
+    MPI_File_close(&p_fh);
+    p_open = false;
+  }
+
+  private:
+    MPI_Comm p_comm;
+    int p_me;
+    bool p_open;
+    MPI_File p_fh;
+    long long p_offset;
+    std::string p_header;
+};
+
+}   // serial_io
+}   // gridpack
+#endif  // _parallel_file_h_
@@ -20,11 +20,14 @@
 #define _serial_io_h_
 
 #include <boost/smart_ptr/shared_ptr.hpp>
+#include <algorithm>
 #include <ga.h>
 #include "gridpack/parallel/distributed.hpp"
 #include "gridpack/network/base_network.hpp"
 #include "gridpack/component/base_component.hpp"
 #include "gridpack/utilities/exception.hpp"
+#include "gridpack/serial_io/parallel_file.hpp"
+#include "gridpack/serial_io/async_writer.hpp"
 #ifdef USE_GOSS
 #include "gridpack/serial_io/goss_client.hpp"
 #endif
@@ -37,9 +40,100 @@ namespace serial_io {
 // and branches to standard output. Each bus or branch is
 // responsible for creating a string that can be written to
 // standard out. These modules then organize these sequentially
-// and write them from process 0
+// and write them from process 0. Files opened with openParallel
+// are instead written collectively by all processes using MPI-IO.
+// In asynchronous mode, process 0 hands the text to a background
+// thread and continues without waiting for it to reach the disk
 // -------------------------------------------------------------
 
+/**
+ * Gather records of numerical values on process 0 and sort them by global
+ * index. This is shared by the gatherValues methods of SerialBusIO and
+ * SerialBranchIO. This is a collective operation
+ * @param communicator communicator over which records are gathered
+ * @param name name of calling class, used in error messages
+ * @param signal signal used to generate records, used in error messages
+ * @param lidx global index of the bus or branch that contributed each local
+ *        record, in increasing order
+ * @param lvals values of local records, stored contiguously
+ * @param index global index of each gathered record (process 0 only)
+ * @param values values of all records, stored contiguously (process 0
+ *        only)
+ * @return number of values in each record
+ */
+inline int gatherRecords(const gridpack::parallel::Communicator &communicator,
+    const char *name, const char *signal, std::vector<int> &lidx,
+    std::vector<double> &lvals, std::vector<int> &index,
+    std::vector<double> &values)
+{
+  index.clear();
+  values.clear();
+  int i, j, p;
+  int nrec = lidx.size();
+  int width = 0;
+  if (nrec > 0) width = lvals.size()/nrec;
+  MPI_Comm comm = static_cast<MPI_Comm>(communicator);
+  int me, nprocs;
+  MPI_Comm_rank(comm, &me);
+  MPI_Comm_size(comm, &nprocs);
+  int nvals;
+  MPI_Allreduce(&width, &nvals, 1, MPI_INT, MPI_MAX, comm);
+  int ok = (nrec == 0 || (width == nvals &&
+        static_cast<int>(lvals.size()) == nrec*nvals)) ? 1 : 0;
+  int allok;
+  MPI_Allreduce(&ok, &allok, 1, MPI_INT, MPI_MIN, comm);
+  if (!allok) {
+    char buf[256];
+    sprintf(buf,"%s::gatherValues: records for signal %s do not all"
+        " have the same number of values\n",name,
+        signal == NULL ? "NULL" : signal);
+    throw gridpack::Exception(buf);
+  }
+
+  // Gather records on process 0
+  std::vector<int> counts(nprocs), offsets(nprocs);
+  std::vector<int> vcounts(nprocs), voffsets(nprocs);
+  MPI_Gather(&nrec,1,MPI_INT,&counts[0],1,MPI_INT,0,comm);
+  int total = 0;
+  if (me == 0) {
+    for (p=0; p<nprocs; p++) {
+      offsets[p] = total;
+      vcounts[p] = counts[p]*nvals;
+      voffsets[p] = total*nvals;
+      total += counts[p];
+    }
+  }
+  std::vector<int> allidx(total+1);
+  std::vector<double> allvals(total*nvals+1);
+  lidx.push_back(0);
+  lvals.push_back(0.0);
+  MPI_Gatherv(&lidx[0],nrec,MPI_INT,&allidx[0],&counts[0],&offsets[0],
+      MPI_INT,0,comm);
+  MPI_Gatherv(&lvals[0],nrec*nvals,MPI_DOUBLE,&allvals[0],&vcounts[0],
+      &voffsets[0],MPI_DOUBLE,0,comm);
+  if (me == 0) {
+    // Records from each processor are already sorted, so a stable sort
+    // on the global index puts all records in order while keeping
+    // multiple records from the same bus or branch in the order they
+    // were returned
+    std::vector<std::pair<int,int> > sorted(total);
+    for (i=0; i<total; i++) {
+      sorted[i] = std::pair<int,int>(allidx[i],i);
+    }
+    std::stable_sort(sorted.begin(), sorted.end());
+    index.resize(total);
+    values.resize(total*nvals);
+    for (i=0; i<total; i++) {
+      index[i] = sorted[i].first;
+      int src = sorted[i].second;
+      for (j=0; j<nvals; j++) {
+        values[i*nvals+j] = allvals[src*nvals+j];
+      }
+    }
+  }
+  return nvals;
+}
+
 template <class _network>
 class SerialBusIO {
   public:
@@ -56,6 +150,7 @@ class SerialBusIO {
     p_GA_type = NGA_Register_type(max_str_len);
     p_network = network;
     p_size = max_str_len;
+    p_async = false;
   
     // Find total number of buses in network and create GAs for moving strings
     // around
@@ -104,6 +199,9 @@ class SerialBusIO {
     NGA_Deregister_type(p_GA_type);
     GA_Destroy(p_stringGA);
     GA_Destroy(p_maskGA);
+    // A parallel file may be shared with another IO object, so it is
+    // closed when its last user releases it
+    p_pfile.reset();
     this->close();
   }
 
@@ -144,11 +242,86 @@ class SerialBusIO {
   void close()
   {
     if (GA_Pgroup_nodeid(p_GAgrp) == 0) {
+      // text for this stream may still be queued in the background thread
+      if (p_async || !AsyncWriter::instance()->idle()) {
+        AsyncWriter::instance()->flush();
+      }
       if (p_fout) {
         if (p_fout->is_open()) p_fout->close();
       }
     }
     p_fout.reset();
+    // The parallel file may be shared with other IO objects through
+    // setParallelStream. It is closed when the last of them releases it
+    p_pfile.reset();
+  }
+
+  /**
+   * Redirect output to a file that is written collectively by all processes
+   * using MPI-IO. Each process writes the strings from its own buses
+   * directly to the file, so nothing is gathered on process 0. The contents
+   * of the file are the same as for a file opened with open. This is a
+   * collective operation
+   * @param filename name of file that output goes to
+   */
+  void openParallel(const char *filename)
+  {
+    this->close();
+    p_pfile.reset(new ParallelFile(p_network->communicator()));
+    p_pfile->open(filename);
+  }
+
+  /**
+   * return file opened with openParallel
+   * @return parallel file (empty if no parallel file is open)
+   */
+  boost::shared_ptr<ParallelFile> getParallelStream()
+  {
+    return p_pfile;
+  }
+
+  /**
+   * Set output to go to a file opened by another IO object with
+   * openParallel
+   * @param file parallel file
+   */
+  void setParallelStream(boost::shared_ptr<ParallelFile> file)
+  {
+    p_pfile = file;
+  }
+
+  /**
+   * Write output asynchronously. Process 0 copies text into a queue that is
+   * written to the file by a background thread, so calls to write and
+   * header return without waiting for the disk. IO objects that share a
+   * stream should use the same mode. Output to files opened with
+   * openParallel is not affected
+   * @param flag true if output is written asynchronously
+   */
+  void setAsync(bool flag)
+  {
+    if (p_async && !flag && GA_Pgroup_nodeid(p_GAgrp) == 0) {
+      AsyncWriter::instance()->flush();
+    }
+    p_async = flag;
+  }
+
+  /**
+   * Wait until all output has been written. This is a collective operation
+   * and acts as a barrier, so the file is complete on all processes when
+   * this call returns
+   */
+  void flush()
+  {
+    if (GA_Pgroup_nodeid(p_GAgrp) == 0) {
+      AsyncWriter::instance()->flush();
+      if (p_fout) {
+        p_fout->flush();
+      } else {
+        std::cout.flush();
+      }
+    }
+    GA_Pgroup_sync(p_GAgrp);
   }
 
   /**
@@ -158,7 +331,10 @@ class SerialBusIO {
    */
   void write(const char *signal = NULL)
   {
-    if (p_fout) {
+    AsyncWriter::instance()->checkNotWriterThread("SerialBusIO::write");
+    if (p_pfile) {
+      parallelWrite(signal);
+    } else if (p_fout) {
       write(*p_fout, signal);
     } else {
       write(std::cout, signal);
@@ -227,10 +403,15 @@ class SerialBusIO {
    */
   void header(const char *str)
   {
+    AsyncWriter::instance()->checkNotWriterThread("SerialBusIO::header");
+    if (p_pfile) {
+      p_pfile->header(str);
+      return;
+    }
     if (GA_Pgroup_nodeid(p_GAgrp) == 0) {
       if (p_fout) 
       {
-        *p_fout << str;
+        output(*p_fout, str);
       } 
 #ifdef USE_GOSS
       else if (m_client.isConnectionValid()) 
@@ -240,7 +421,7 @@ class SerialBusIO {
       }
 #endif
       else
-        std::cout << str;
+        output(std::cout, str);
     }
 
 
@@ -253,6 +434,44 @@ class SerialBusIO {
 */
   }
 
+  /**
+   * Gather numerical values from buses on process 0. Each bus can
+   * contribute several records through its getValues method and all records
+   * must contain the same number of values. Records are ordered by global
+   * bus index, so they are in the same order as the strings returned by
+   * writeStrings. No strings are formatted or parsed. This is a collective
+   * operation
+   * @param index global index of the bus that contributed each record
+   *        (process 0 only)
+   * @param values values of all records, stored contiguously (process 0
+   *        only)
+   * @param signal character string passed to getValues to control which
+   *        values are returned
+   * @return number of values in each record
+   */
+  int gatherValues(std::vector<int> &index, std::vector<double> &values,
+      const char *signal = NULL)
+  {
+    int nBus = p_network->numBuses();
+    std::vector<std::pair<int,int> > order;
+    int i, j;
+    for (i=0; i<nBus; i++) {
+      if (p_network->getActiveBus(i)) {
+        order.push_back(std::pair<int,int>(
+              p_network->getGlobalBusIndex(i),i));
+      }
+    }
+    std::sort(order.begin(), order.end());
+    std::vector<int> lidx;
+    std::vector<double> lvals;
+    for (i=0; i<static_cast<int>(order.size()); i++) {
+      int nrec = p_network->getBus(order[i].second)->getValues(lvals,signal);
+      for (j=0; j<nrec; j++) lidx.push_back(order[i].first);
+    }
+    return gatherRecords(p_network->communicator(),"SerialBusIO",signal,
+        lidx,lvals,index,values);
+  }
+
   /**
    * This is a function that can use the machinery that has been set up in the
    * serialBusIO class to move data to the head node
@@ -570,6 +789,13 @@ class SerialBusIO {
     if (GA_Pgroup_nodeid(p_GAgrp) == 0) {
       int nprocs = GA_Pgroup_nnodes(p_GAgrp);
       int lo, hi;
+      // In asynchronous mode, all strings are collected and queued as a
+      // single record. Otherwise, make sure earlier queued text has been
+      // written so that output stays in order
+      std::string text;
+      if (!p_async && !AsyncWriter::instance()->idle()) {
+        AsyncWriter::instance()->flush();
+      }
       for (i=0; i<nprocs; i++) {
         NGA_Distribution(p_maskGA, i, &lo, &hi);
         int ld = hi - lo + 1;
@@ -605,7 +831,11 @@ class SerialBusIO {
           for (j=0; j<ld; j++) {
             if (imask[j] == 1) {
 #ifndef USE_GOSS
-              out << ptr;
+              if (p_async) {
+                text.append(ptr);
+              } else {
+                out << ptr;
+              }
 #else
               if (m_client.isConnectionValid()) {
 		std::cout << "publishing " << m_topic << " to GOSS" << std::endl;
@@ -626,6 +856,7 @@ class SerialBusIO {
           if (p_size*nwrites > 0) delete [] iobuf;
         }
       }
+      if (p_async) AsyncWriter::instance()->write(&out, text);
     }
     GA_Pgroup_sync(p_GAgrp);
   }
@@ -652,6 +883,65 @@ class SerialBusIO {
     }
   }*/
 
+  /**
+   * Write a string from process 0, either directly or through the background
+   * thread
+   * @param out stream object for output
+   * @param str character string to be written
+   */
+  void output(std::ostream &out, const char *str)
+  {
+    if (p_async) {
+      AsyncWriter::instance()->write(&out, std::string(str));
+    } else {
+      if (!AsyncWriter::instance()->idle()) AsyncWriter::instance()->flush();
+      out << str;
+    }
+  }
+
+  /**
+   * Write output from buses to a file opened with openParallel. Strings are
+   * ordered by global bus index. After partitioning, each process holds a
+   * contiguous block of global indices, so each process writes its own
+   * strings at an offset found with a prefix sum. If the blocks are not in
+   * rank order, the strings are gathered on process 0 as in the serial
+   * version and written from there
+   * @param signal an optional character string used to control contents of
+   *                output
+   */
+  void parallelWrite(const char *signal)
+  {
+    int nBus = p_network->numBuses();
+    std::vector<std::pair<int,int> > order;
+    int i;
+    for (i=0; i<nBus; i++) {
+      if (p_network->getActiveBus(i)) {
+        order.push_back(std::pair<int,int>(
+              p_network->getGlobalBusIndex(i),i));
+      }
+    }
+    std::sort(order.begin(), order.end());
+    int nsize = order.size();
+    std::string text;
+    if (nsize > 0 ? p_pfile->inRankOrder(order[0].first,
+          order[nsize-1].first) : p_pfile->inRankOrder(0,-1)) {
+      std::vector<char> string(p_size+1);
+      for (i=0; i<nsize; i++) {
+        if (p_network->getBus(order[i].second)->serialWrite(&string[0],
+              p_size,signal)) {
+          string[p_size] = '\0';
+          text.append(&string[0]);
+        }
+      }
+    } else {
+      std::vector<std::string> strings = writeStrings(signal);
+      for (i=0; i<static_cast<int>(strings.size()); i++) {
+        text.append(strings[i]);
+      }
+    }
+    p_pfile->write(text.data(), text.size());
+  }
+
   private:
     int p_GA_type;
     boost::shared_ptr<_network> p_network;
@@ -659,6 +949,8 @@ class SerialBusIO {
     int p_maskGA;
     int p_size;
     boost::shared_ptr<std::ofstream> p_fout;
+    boost::shared_ptr<ParallelFile> p_pfile;
+    bool p_async;
     int p_GAgrp;
 #ifdef USE_GOSS
     gridpack::goss::GOSSClient m_client;
@@ -685,6 +977,7 @@ class SerialBranchIO {
     p_GA_type = NGA_Register_type(max_str_len);
     p_network = network;
     p_size = max_str_len;
+    p_async = false;
 
     // Find total number of branches in network and create GAs for moving strings
     // around
@@ -709,6 +1002,9 @@ class SerialBranchIO {
     NGA_Deregister_type(p_GA_type);
     GA_Destroy(p_stringGA);
     GA_Destroy(p_maskGA);
+    // A parallel file may be shared with another IO object, so it is
+    // closed when its last user releases it
+    p_pfile.reset();
     this->close();
   }
 
@@ -774,11 +1070,86 @@ class SerialBranchIO {
   void close()
   {
     if (GA_Pgroup_nodeid(p_GAgrp) == 0) {
+      // text for this stream may still be queued in the background thread
+      if (p_async || !AsyncWriter::instance()->idle()) {
+        AsyncWriter::instance()->flush();
+      }
       if (p_fout) {
         if (p_fout->is_open()) p_fout->close();
       }
     }
     p_fout.reset();
+    // The parallel file may be shared with other IO objects through
+    // setParallelStream. It is closed when the last of them releases it
+    p_pfile.reset();
+  }
+
+  /**
+   * Redirect output to a file that is written collectively by all processes
+   * using MPI-IO. Each process writes the strings from its own branches
+   * directly to the file, so nothing is gathered on process 0. The contents
+   * of the file are the same as for a file opened with open. This is a
+   * collective operation
+   * @param filename name of file that output goes to
+   */
+  void openParallel(const char *filename)
+  {
+    this->close();
+    p_pfile.reset(new ParallelFile(p_network->communicator()));
+    p_pfile->open(filename);
+  }
+
+  /**
+   * return file opened with openParallel
+   * @return parallel file (empty if no parallel file is open)
+   */
+  boost::shared_ptr<ParallelFile> getParallelStream()
+  {
+    return p_pfile;
+  }
+
+  /**
+   * Set output to go to a file opened by another IO object with
+   * openParallel
+   * @param file parallel file
+   */
+  void setParallelStream(boost::shared_ptr<ParallelFile> file)
+  {
+    p_pfile = file;
+  }
+
+  /**
+   * Write output asynchronously. Process 0 copies text into a queue that is
+   * written to the file by a background thread, so calls to write and
+   * header return without waiting for the disk. IO objects that share a
+   * stream should use the same mode. Output to files opened with
+   * openParallel is not affected
+   * @param flag true if output is written asynchronously
+   */
+  void setAsync(bool flag)
+  {
+    if (p_async && !flag && GA_Pgroup_nodeid(p_GAgrp) == 0) {
+      AsyncWriter::instance()->flush();
+    }
+    p_async = flag;
+  }
+
+  /**
+   * Wait until all output has been written. This is a collective operation
+   * and acts as a barrier, so the file is complete on all processes when
+   * this call returns
+   */
+  void flush()
+  {
+    if (GA_Pgroup_nodeid(p_GAgrp) == 0) {
+      AsyncWriter::instance()->flush();
+      if (p_fout) {
+        p_fout->flush();
+      } else {
+        std::cout.flush();
+      }
+    }
+    GA_Pgroup_sync(p_GAgrp);
   }
 
   /**
@@ -788,7 +1159,10 @@ class SerialBranchIO {
    */
   void write(const char *signal = NULL)
   {
-    if (p_fout) {
+    AsyncWriter::instance()->checkNotWriterThread("SerialBranchIO::write");
+    if (p_pfile) {
+      parallelWrite(signal);
+    } else if (p_fout) {
       write(*p_fout, signal);
     } else {
       write(std::cout, signal);
@@ -810,6 +1184,44 @@ class SerialBranchIO {
     }
   }*/
 
+  /**
+   * Gather numerical values from branches on process 0. Each branch can
+   * contribute several records through its getValues method and all records
+   * must contain the same number of values. Records are ordered by global
+   * branch index, so they are in the same order as the strings returned by
+   * writeStrings. No strings are formatted or parsed. This is a collective
+   * operation
+   * @param index global index of the branch that contributed each record
+   *        (process 0 only)
+   * @param values values of all records, stored contiguously (process 0
+   *        only)
+   * @param signal character string passed to getValues to control which
+   *        values are returned
+   * @return number of values in each record
+   */
+  int gatherValues(std::vector<int> &index, std::vector<double> &values,
+      const char *signal = NULL)
+  {
+    int nBranch = p_network->numBranches();
+    std::vector<std::pair<int,int> > order;
+    int i, j;
+    for (i=0; i<nBranch; i++) {
+      if (p_network->getActiveBranch(i)) {
+        order.push_back(std::pair<int,int>(
+              p_network->getGlobalBranchIndex(i),i));
+      }
+    }
+    std::sort(order.begin(), order.end());
+    std::vector<int> lidx;
+    std::vector<double> lvals;
+    for (i=0; i<static_cast<int>(order.size()); i++) {
+      int nrec = p_network->getBranch(order[i].second)->getValues(lvals,signal);
+      for (j=0; j<nrec; j++) lidx.push_back(order[i].first);
+    }
+    return gatherRecords(p_network->communicator(),"SerialBranchIO",signal,
+        lidx,lvals,index,values);
+  }
+
   /**
    * This is a function that can use the machinery that has been set up in the
    * serialBranchIO class to move data to the head node
@@ -1106,6 +1518,13 @@ class SerialBranchIO {
     if (GA_Pgroup_nodeid(p_GAgrp) == 0) {
       int nprocs = GA_Pgroup_nnodes(p_GAgrp);
       int lo, hi;
+      // In asynchronous mode, all strings are collected and queued as a
+      // single record. Otherwise, make sure earlier queued text has been
+      // written so that output stays in order
+      std::string text;
+      if (!p_async && !AsyncWriter::instance()->idle()) {
+        AsyncWriter::instance()->flush();
+      }
       for (i=0; i<nprocs; i++) {
         NGA_Distribution(p_maskGA, i, &lo, &hi);
         int ld = hi - lo + 1;
@@ -1140,7 +1559,11 @@ class SerialBranchIO {
           nwrites = 0;
           for (j=0; j<ld; j++) {
             if (imask[j] == 1) {
-              out << ptr;
+              if (p_async) {
+                text.append(ptr);
+              } else {
+                out << ptr;
+              }
               ptr += p_size;
               nwrites++;
             }
@@ -1148,6 +1571,7 @@ class SerialBranchIO {
           if (p_size*nwrites > 0) delete [] iobuf;
         }
       }
+      if (p_async) AsyncWriter::instance()->write(&out, text);
     }
     GA_Pgroup_sync(p_GAgrp);
   }
@@ -1169,10 +1593,15 @@ public:
 
   void header(const char *str)
   {
+    AsyncWriter::instance()->checkNotWriterThread("SerialBranchIO::header");
+    if (p_pfile) {
+      p_pfile->header(str);
+      return;
+    }
     if (GA_Pgroup_nodeid(p_GAgrp) == 0) {
       if (p_fout)
       {
-        *p_fout << str;
+        output(*p_fout, str);
       } 
 #ifdef USE_GOSS
       else if (m_client.isConnectionValid()) 
@@ -1182,11 +1611,70 @@ public:
       }
 #endif
       else
-        std::cout << str;
+        output(std::cout, str);
     }
 
   }
 
+  /**
+   * Write a string from process 0, either directly or through the background
+   * thread
+   * @param out stream object for output
+   * @param str character string to be written
+   */
+  void output(std::ostream &out, const char *str)
+  {
+    if (p_async) {
+      AsyncWriter::instance()->write(&out, std::string(str));
+    } else {
+      if (!AsyncWriter::instance()->idle()) AsyncWriter::instance()->flush();
+      out << str;
+    }
+  }
+
+  /**
+   * Write output from branches to a file opened with openParallel. Strings are
+   * ordered by global branch index. After partitioning, each process holds a
+   * contiguous block of global indices, so each process writes its own
+   * strings at an offset found with a prefix sum. If the blocks are not in
+   * rank order, the strings are gathered on process 0 as in the serial
+   * version and written from there
+   * @param signal an optional character string used to control contents of
+   *                output
+   */
+  void parallelWrite(const char *signal)
+  {
+    int nBranch = p_network->numBranches();
+    std::vector<std::pair<int,int> > order;
+    int i;
+    for (i=0; i<nBranch; i++) {
+      if (p_network->getActiveBranch(i)) {
+        order.push_back(std::pair<int,int>(
+              p_network->getGlobalBranchIndex(i),i));
+      }
+    }
+    std::sort(order.begin(), order.end());
+    int nsize = order.size();
+    std::string text;
+    if (nsize > 0 ? p_pfile->inRankOrder(order[0].first,
+          order[nsize-1].first) : p_pfile->inRankOrder(0,-1)) {
+      std::vector<char> string(p_size+1);
+      for (i=0; i<nsize; i++) {
+        if (p_network->getBranch(order[i].second)->serialWrite(&string[0],
+              p_size,signal)) {
+          string[p_size] = '\0';
+          text.append(&string[0]);
+        }
+      }
+    } else {
+      std::vector<std::string> strings = writeStrings(signal);
+      for (i=0; i<static_cast<int>(strings.size()); i++) {
+        text.append(strings[i]);
+      }
+    }
+    p_pfile->write(text.data(), text.size());
+  }
+
   private:
     int p_GA_type;
     boost::shared_ptr<_network> p_network;
@@ -1194,6 +1682,8 @@ public:
     int p_maskGA;
     int p_size;
     boost::shared_ptr<std::ofstream> p_fout;
+    boost::shared_ptr<ParallelFile> p_pfile;
+    bool p_async;
     int p_GAgrp;
 #ifdef USE_GOSS
     gridpack::goss::GOSSClient m_client;
@@ -6,6 +6,9 @@
 
 #include "mpi.h"
 #include <vector>
+#include <fstream>
+#include <sstream>
+#include <string>
 #include <macdecls.h>
 #include "gridpack/environment/environment.hpp"
 #include "gridpack/utilities/complex.hpp"
@@ -277,6 +280,61 @@ void run (const int &me, const int &nprocs)
   branchIO.header("\n         Original1  Original2  Global1 Global2\n");
   branchIO.write();
 
+  // Write the same output to a file from process 0 and to a file written
+  // collectively with MPI-IO and check that the two files agree
+  busIO.open("serial_io_test.txt");
+  branchIO.setStream(busIO.getStream());
+  busIO.header("\n  Bus Properties\n");
+  busIO.write();
+  branchIO.header("\n  Branch Properties\n");
+  branchIO.write();
+  busIO.close();
+  branchIO.setStream(busIO.getStream());
+
+  busIO.openParallel("parallel_io_test.txt");
+  branchIO.setParallelStream(busIO.getParallelStream());
+  busIO.header("\n  Bus Properties\n");
+  busIO.write();
+  branchIO.header("\n  Branch Properties\n");
+  branchIO.write();
+  busIO.close();
+  branchIO.setParallelStream(busIO.getParallelStream());
+
+  // Write the same output again from the background IO thread
+  busIO.setAsync(true);
+  branchIO.setAsync(true);
+  busIO.open("async_io_test.txt");
+  branchIO.setStream(busIO.getStream());
+  busIO.header("\n  Bus Properties\n");
+  busIO.write();
+  branchIO.header("\n  Branch Properties\n");
+  branchIO.write();
+  busIO.flush();
+  busIO.close();
+  branchIO.setStream(busIO.getStream());
+  busIO.setAsync(false);
+  branchIO.setAsync(false);
+
+  if (me == 0) {
+    std::ifstream fserial("serial_io_test.txt");
+    std::ifstream fparallel("parallel_io_test.txt");
+    std::ifstream fasync("async_io_test.txt");
+    std::stringstream sserial, sparallel, sasync;
+    sserial << fserial.rdbuf();
+    sparallel << fparallel.rdbuf();
+    sasync << fasync.rdbuf();
+    if (sserial.str() != sparallel.str() || sserial.str().size() == 0) {
+      printf("\n    Serial and parallel output files differ\n");
+    } else {
+      printf("\n    Serial and parallel output files are ok\n");
+    }
+    if (sserial.str() != sasync.str()) {
+      printf("\n    Serial and asynchronous output files differ\n");
+    } else {
+      printf("\n    Serial and asynchronous output files are ok\n");
+    }
+  }
+
   // Test gatherData functionality
   busIO.header("\n Test gather data functionality\n");
   std::vector<TestBus::test_data> bus_data;
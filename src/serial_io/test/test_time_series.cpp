@@ -0,0 +1,106 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+#include <vector>
+#include <string>
+#include <cstdio>
+
+#define BOOST_TEST_NO_MAIN
+#define BOOST_TEST_ALTERNATIVE_INIT_API
+#include <boost/test/included/unit_test.hpp>
+
+#include "mpi.h"
+#include "gridpack/environment/environment.hpp"
+#include "gridpack/parallel/communicator.hpp"
+#include "gridpack/serial_io/time_series.hpp"
+
+#define NSTEPS 250
+#define CHUNK 64
+
+// Each processor owns me+1 signals. Values are a simple function of the
+// processor, signal and step so that they can be checked after the file is
+// read back in
+double value(int proc, int sig, int step)
+{
+  return 1000.0*static_cast<double>(proc)+100.0*static_cast<double>(sig)
+    + 0.25*static_cast<double>(step);
+}
+
+// Write a time series file from all processors and read it back in on
+// process 0. Single precision values are exactly representable, so both
+// precisions are checked for equality
+void run(bool single)
+{
+  gridpack::parallel::Communicator world;
+  int me = world.rank();
+  int nprocs = world.size();
+  int i, j, p;
+  char buf[128];
+
+  std::vector<std::string> names;
+  for (i=0; i<=me; i++) {
+    sprintf(buf,"signal_%d_%d",me,i);
+    names.push_back(std::string(buf));
+  }
+  gridpack::serial_io::TimeSeriesWriter writer(world,CHUNK,single);
+  writer.open("time_series_test.bin",names);
+  for (j=0; j<NSTEPS; j++) {
+    std::vector<double> values;
+    for (i=0; i<=me; i++) values.push_back(value(me,i,j));
+    writer.append(0.01*static_cast<double>(j),values);
+  }
+  writer.close();
+
+  if (me == 0) {
+    gridpack::serial_io::TimeSeriesReader reader;
+    bool ok = reader.open("time_series_test.bin");
+    BOOST_REQUIRE(ok);
+    BOOST_CHECK_EQUAL(reader.numSignals(), nprocs*(nprocs+1)/2);
+    BOOST_CHECK_EQUAL(reader.numSteps(), NSTEPS);
+    std::vector<double> times = reader.times();
+    BOOST_CHECK_EQUAL(static_cast<int>(times.size()), NSTEPS);
+    for (j=0; j<static_cast<int>(times.size()); j++) {
+      BOOST_CHECK_EQUAL(times[j], 0.01*static_cast<double>(j));
+    }
+    for (p=0; p<nprocs; p++) {
+      for (i=0; i<=p; i++) {
+        sprintf(buf,"signal_%d_%d",p,i);
+        int idx = reader.findSignal(std::string(buf));
+        BOOST_CHECK(idx >= 0);
+        if (idx < 0) continue;
+        std::vector<double> series = reader.signal(idx);
+        BOOST_CHECK_EQUAL(static_cast<int>(series.size()), NSTEPS);
+        for (j=0; j<static_cast<int>(series.size()); j++) {
+          BOOST_CHECK_EQUAL(series[j], value(p,i,j));
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE ( TestTimeSeries )
+
+BOOST_AUTO_TEST_CASE( TestDoublePrecision )
+{
+  run(false);
+}
+
+BOOST_AUTO_TEST_CASE( TestSinglePrecision )
+{
+  run(true);
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+bool init_function(void)
+{
+  return true;
+}
+
+int main (int argc, char **argv) {
+  gridpack::Environment env(argc, argv);
+  int result = ::boost::unit_test::unit_test_main( &init_function, argc, argv );
+  return result;
+}
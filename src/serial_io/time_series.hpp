@@ -0,0 +1,451 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   time_series.hpp
+ * @author agent
+ * @date   2026-10-17
+ *
+ * @brief
+ * Binary, column oriented files for time series of monitored quantities.
+ * Each processor registers the signals it owns when the file is opened and
+ * then appends one row of values per time step. Rows are held in memory
+ * and written in chunks. Within a chunk, the times are followed by the
+ * values of each signal for all rows in the chunk, so a single signal can
+ * be read without reading the rest of the file. Chunks are written with
+ * non-blocking MPI-IO calls, so the simulation continues while the previous
+ * chunk is written.
+ *
+ * File layout (native byte order)
+ *   header: "GPTS", int version, int bytes per value, int number of signals,
+ *           then for each signal an int length followed by the name
+ *   chunk:  int number of rows, double times[rows], then for each signal
+ *           values[rows] stored as double or float
+ *
+ */
+// -------------------------------------------------------------
+
+#ifndef _time_series_h_
+#define _time_series_h_
+
+#include <mpi.h>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include "gridpack/parallel/communicator.hpp"
+#include "gridpack/utilities/exception.hpp"
+
+#define TIME_SERIES_VERSION 1
+
+namespace gridpack {
+namespace serial_io {
+
+class TimeSeriesWriter {
+  public:
+
+  /**
+   * Simple constructor
+   * @param comm communicator of processors writing to file
+   * @param chunk number of rows held in memory before they are written
+   * @param single store values in single precision. This halves the size of
+   *        the file. Times are always stored in double precision
+   */
+  TimeSeriesWriter(const gridpack::parallel::Communicator &comm,
+      int chunk = 1024, bool single = false)
+    : p_comm(static_cast<MPI_Comm>(comm)), p_me(comm.rank()),
+      p_chunk(chunk), p_single(single), p_open(false), p_nsignals(0),
+      p_nrows(0), p_current(0), p_offset(0)
+  {
+    if (p_chunk < 1) p_chunk = 1;
+    p_pending[0] = false;
+    p_pending[1] = false;
+  }
+
+  /**
+   * Simple destructor. Writes any remaining rows and closes the file
+   */
+  ~TimeSeriesWriter(void)
+  {
+    close();
+  }
+
+  /**
+   * Create file and write the description of all signals. Signals are
+   * stored in rank order and, on each processor, in the order they are
+   * listed. This is a collective operation
+   * @param filename name of file
+   * @param names names of signals owned by this processor
+   */
+  void open(const char *filename, const std::vector<std::string> &names)
+  {
+    close();
+    int ierr = MPI_File_open(p_comm, const_cast<char*>(filename),
+        MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &p_fh);
+    if (ierr != MPI_SUCCESS) {
+      char buf[512];
+      sprintf(buf,"TimeSeriesWriter::open: unable to open file %s\n",
+          filename);
+      throw gridpack::Exception(buf);
+    }
+    MPI_File_set_size(p_fh, 0);
+    p_open = true;
+    p_offset = 0;
+    p_nrows = 0;
+    p_nsignals = names.size();
+    p_times.clear();
+    p_values.clear();
+    int total;
+    MPI_Allreduce(&p_nsignals, &total, 1, MPI_INT, MPI_SUM, p_comm);
+
+    std::vector<char> &buf = p_buffer[p_current];
+    buf.clear();
+    if (p_me == 0) {
+      buf.insert(buf.end(), "GPTS", "GPTS"+4);
+      append(buf, TIME_SERIES_VERSION);
+      append(buf, p_single ? static_cast<int>(sizeof(float))
+          : static_cast<int>(sizeof(double)));
+      append(buf, total);
+    }
+    int i;
+    for (i=0; i<p_nsignals; i++) {
+      append(buf, static_cast<int>(names[i].size()));
+      buf.insert(buf.end(), names[i].begin(), names[i].end());
+    }
+    startWrite();
+  }
+
+  /**
+   * Add one row of values. Rows are written when the chunk is full. All
+   * processors must append the same number of rows, since writing a chunk
+   * is a collective operation
+   * @param time time of row
+   * @param values values of signals owned by this processor, in the order
+   *        used in open
+   */
+  void append(double time, const std::vector<double> &values)
+  {
+    if (!p_open) return;
+    if (static_cast<int>(values.size()) != p_nsignals) {
+      char buf[256];
+      sprintf(buf,"TimeSeriesWriter::append: expected %d values found %d\n",
+          p_nsignals,static_cast<int>(values.size()));
+      throw gridpack::Exception(buf);
+    }
+    p_times.push_back(time);
+    p_values.insert(p_values.end(), values.begin(), values.end());
+    p_nrows++;
+    if (p_nrows >= p_chunk) flush();
+  }
+
+  /**
+   * Start writing any rows held in memory. The write completes in the
+   * background. This is a collective operation
+   */
+  void flush()
+  {
+    if (!p_open || p_nrows == 0) return;
+    // wait until buffer is free before refilling it
+    wait(p_current);
+    std::vector<char> &buf = p_buffer[p_current];
+    buf.clear();
+    int i, j;
+    if (p_me == 0) {
+      append(buf, p_nrows);
+      for (i=0; i<p_nrows; i++) append(buf, p_times[i]);
+    }
+    // transpose rows into columns
+    for (j=0; j<p_nsignals; j++) {
+      for (i=0; i<p_nrows; i++) {
+        double value = p_values[i*p_nsignals+j];
+        if (p_single) {
+          append(buf, static_cast<float>(value));
+        } else {
+          append(buf, value);
+        }
+      }
+    }
+    p_times.clear();
+    p_values.clear();
+    p_nrows = 0;
+    startWrite();
+  }
+
+  /**
+   * Write remaining rows and close the file. This is a collective operation
+   */
+  void close()
+  {
+    if (!p_open) return;
+    flush();
+    wait(0);
+    wait(1);
+    MPI_File_close(&p_fh);
+    p_open = false;
+  }
+
+  private:
+
+  /**
+   * Append the bytes of a value to a buffer
+   * @param buf buffer
+   * @param value value to be added
+   */
+  template <typename T>
+  void append(std::vector<char> &buf, const T &value)
+  {
+    const char *ptr = reinterpret_cast<const char*>(&value);
+    buf.insert(buf.end(), ptr, ptr+sizeof(T));
+  }
+
+  /**
+   * Start a non-blocking write of the current buffer. Offsets of the
+   * contributions from each processor are found from a prefix sum
+   */
+  void startWrite()
+  {
+    std::vector<char> &buf = p_buffer[p_current];
+    long long size = buf.size();
+    long long offset = 0;
+    long long total = 0;
+    MPI_Exscan(&size, &offset, 1, MPI_LONG_LONG, MPI_SUM, p_comm);
+    if (p_me == 0) offset = 0;
+    MPI_Allreduce(&size, &total, 1, MPI_LONG_LONG, MPI_SUM, p_comm);
+    if (size > 0) {
+      MPI_File_iwrite_at(p_fh, static_cast<MPI_Offset>(p_offset+offset),
+          &buf[0], static_cast<int>(size), MPI_BYTE,
+          &p_request[p_current]);
+      p_pending[p_current] = true;
+    }
+    p_offset += total;
+    p_current = 1-p_current;
+  }
+
+  /**
+   * Wait for the write from a buffer to complete
+   * @param set index of buffer
+   */
+  void wait(int set)
+  {
+    if (p_pending[set]) {
+      MPI_Status status;
+      MPI_Wait(&p_request[set], &status);
+      p_pending[set] = false;
+    }
+  }
+
+  MPI_Comm p_comm;
+  int p_me;
+  int p_chunk;
+  bool p_single;
+  bool p_open;
+  MPI_File p_fh;
+  int p_nsignals;
+  int p_nrows;
+  std::vector<double> p_times;
+  std::vector<double> p_values;
+  std::vector<char> p_buffer[2];
+  MPI_Request p_request[2];
+  bool p_pending[2];
+  int p_current;
+  long long p_offset;
+};
+
+class TimeSeriesReader {
+  public:
+
+  /**
+   * Simple constructor
+   */
+  TimeSeriesReader(void)
+    : p_size(sizeof(double))
+  {
+  }
+
+  /**
+   * Simple destructor
+   */
+  ~TimeSeriesReader(void)
+  {
+  }
+
+  /**
+   * Read the header and chunk layout of a file written by TimeSeriesWriter.
+   * This is called on a single processor
+   * @param filename name of file
+   * @return false if the file could not be opened or is not a time series
+   *         file
+   */
+  bool open(const char *filename)
+  {
+    p_names.clear();
+    p_chunks.clear();
+    p_rows.clear();
+    p_fin.close();
+    p_fin.clear();
+    p_fin.open(filename, std::ios::in | std::ios::binary);
+    if (!p_fin.is_open()) return false;
+    char magic[4];
+    int version, nsignals;
+    if (!p_fin.read(magic, 4) || strncmp(magic, "GPTS", 4) != 0) return false;
+    if (!read(version) || version != TIME_SERIES_VERSION) return false;
+    if (!read(p_size) || !read(nsignals)) return false;
+    if (p_size != sizeof(double) && p_size != sizeof(float)) return false;
+    int i, len;
+    for (i=0; i<nsignals; i++) {
+      if (!read(len)) return false;
+      std::string name(len, ' ');
+      if (len > 0 && !p_fin.read(&name[0], len)) return false;
+      p_names.push_back(name);
+    }
+    // Find the start of each chunk. A chunk that was only partly written
+    // is ignored
+    std::streamoff header = p_fin.tellg();
+    p_fin.seekg(0, std::ios::end);
+    std::streamoff end = p_fin.tellg();
+    p_fin.seekg(header);
+    int nrows;
+    while (read(nrows)) {
+      std::streamoff start = p_fin.tellg();
+      std::streamoff next = start + static_cast<std::streamoff>(nrows)
+          *(sizeof(double)+nsignals*p_size);
+      if (nrows < 0 || next > end) break;
+      p_chunks.push_back(start);
+      p_rows.push_back(nrows);
+      p_fin.seekg(next);
+    }
+    p_fin.clear();
+    return true;
+  }
+
+  /**
+   * Return number of signals in file
+   * @return number of signals
+   */
+  int numSignals(void) const
+  {
+    return p_names.size();
+  }
+
+  /**
+   * Return names of signals in the order they are stored
+   * @return list of signal names
+   */
+  const std::vector<std::string>& signalNames(void) const
+  {
+    return p_names;
+  }
+
+  /**
+   * Find the index of a signal
+   * @param name name of signal
+   * @return index of signal or -1 if it is not in file
+   */
+  int findSignal(const std::string &name) const
+  {
+    int i;
+    for (i=0; i<static_cast<int>(p_names.size()); i++) {
+      if (p_names[i] == name) return i;
+    }
+    return -1;
+  }
+
+  /**
+   * Return number of rows (time steps) in file
+   * @return number of rows
+   */
+  int numSteps(void) const
+  {
+    int i;
+    int ret = 0;
+    for (i=0; i<static_cast<int>(p_rows.size()); i++) ret += p_rows[i];
+    return ret;
+  }
+
+  /**
+   * Return times of all rows
+   * @return list of times
+   */
+  std::vector<double> times(void)
+  {
+    std::vector<double> ret;
+    int i, j;
+    for (i=0; i<static_cast<int>(p_chunks.size()); i++) {
+      p_fin.seekg(p_chunks[i]);
+      for (j=0; j<p_rows[i]; j++) {
+        double value;
+        read(value);
+        ret.push_back(value);
+      }
+    }
+    return ret;
+  }
+
+  /**
+   * Return values of one signal for all rows
+   * @param idx index of signal
+   * @return list of values
+   */
+  std::vector<double> signal(int idx)
+  {
+    std::vector<double> ret;
+    if (idx < 0 || idx >= static_cast<int>(p_names.size())) {
+      char buf[256];
+      sprintf(buf,"TimeSeriesReader::signal: illegal signal index %d\n",idx);
+      throw gridpack::Exception(buf);
+    }
+    int i, j;
+    for (i=0; i<static_cast<int>(p_chunks.size()); i++) {
+      p_fin.seekg(p_chunks[i] + static_cast<std::streamoff>(p_rows[i])
+          *(sizeof(double)+idx*p_size));
+      for (j=0; j<p_rows[i]; j++) {
+        if (p_size == sizeof(float)) {
+          float value;
+          read(value);
+          ret.push_back(static_cast<double>(value));
+        } else {
+          double value;
+          read(value);
+          ret.push_back(value);
+        }
+      }
+    }
+    return ret;
+  }
+
+  /**
+   * Close file
+   */
+  void close(void)
+  {
+    p_fin.close();
+  }
+
+  private:
+
+  /**
+   * Read a single value from file
+   * @param value value read from file
+   * @return false if value could not be read
+   */
+  template <typename T>
+  bool read(T &value)
+  {
+    return static_cast<bool>(p_fin.read(reinterpret_cast<char*>(&value),
+          sizeof(T)));
+  }
+
+  std::ifstream p_fin;
+  int p_size;
+  std::vector<std::string> p_names;
+  std::vector<std::streamoff> p_chunks;
+  std::vector<int> p_rows;
+};
+
+}   // serial_io
+}   // gridpack
+#endif  // _time_series_h_
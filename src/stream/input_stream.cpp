@@ -5,6 +5,7 @@
  */
 
 #include <iostream>
+#include <cstring>
 #include "gridpack/stream/input_stream.hpp"
 
 /**
@@ -15,6 +16,9 @@ gridpack::stream::InputStream::InputStream()
   p_srcFile = false;
   p_srcVector = false;
   p_isOpen = false;
+  p_position = 0;
+  p_end = 0;
+  p_eof = false;
 }
 
 /**
@@ -35,8 +39,15 @@ gridpack::stream::InputStream::~InputStream()
 bool gridpack::stream::InputStream::openFile(std::string file)
 {
   bool ret = false;
-  p_fout.open(file.c_str());
+  p_fout.open(file.c_str(), std::ios::in | std::ios::binary);
   if (p_fout.is_open()) {
+    // The file is read in blocks of fixed size and lines are handed out
+    // from the current block. The buffer only grows if a single line is
+    // longer than a block
+    p_buffer.resize(BLOCK_SIZE);
+    p_position = 0;
+    p_end = 0;
+    p_eof = false;
     p_srcFile = true;
     p_isOpen = true;
     ret = true;
@@ -52,6 +63,7 @@ bool gridpack::stream::InputStream::openStringVector(const std::vector<std::stri
 {
   if (fileVec.size() == 0) return false;
   p_fileVector = fileVec;
+  p_fileIterator = p_fileVector.begin();
   p_srcVector = true;
   p_isOpen = true;
   return true;
@@ -62,6 +74,10 @@ void gridpack::stream::InputStream::close()
   if (p_isOpen) {
     if (p_srcFile) {
       p_fout.close();
+      std::vector<char>().swap(p_buffer);
+      p_position = 0;
+      p_end = 0;
+      p_eof = false;
       p_srcFile = false;
     } else if (p_srcVector) {
       p_fileVector.clear();
@@ -83,7 +99,10 @@ bool gridpack::stream::InputStream::nextLine(std::string &line)
   bool ret = false;
   if (p_isOpen) {
     if (p_srcFile) {
-      ret = std::getline(p_fout, line).good();
+      const char *ptr;
+      int len;
+      ret = nextLine(&ptr, &len);
+      line.assign(ptr, len);
     } else {
       if (p_fileIterator != p_fileVector.end()) {
         line = *p_fileIterator;
@@ -99,6 +118,87 @@ bool gridpack::stream::InputStream::nextLine(std::string &line)
   return ret;
 }
 
+/**
+ * Read the next block of the file into the buffer. Characters that have not
+ * been handed out yet are moved to the front of the buffer first
+ * @return false if no more characters could be read
+ */
+bool gridpack::stream::InputStream::readBlock()
+{
+  if (p_eof) return false;
+  size_t remaining = p_end - p_position;
+  if (remaining > 0 && p_position > 0) {
+    memmove(&p_buffer[0], &p_buffer[0] + p_position, remaining);
+  }
+  p_position = 0;
+  p_end = remaining;
+  if (p_end == p_buffer.size()) {
+    p_buffer.resize(2*p_buffer.size());
+  }
+  p_fout.read(&p_buffer[0] + p_end, p_buffer.size() - p_end);
+  size_t nread = static_cast<size_t>(p_fout.gcount());
+  p_end += nread;
+  if (!p_fout.good()) p_eof = true;
+  return (nread > 0);
+}
+
+/**
+ * Get next line from streaming source without copying it. The line is not
+ * null terminated and remains valid until the next call to nextLine or
+ * until the stream is closed
+ * @param line pointer to first character of line
+ * @param len number of characters in line (without end of line)
+ * @return true if another line is found
+ */
+bool gridpack::stream::InputStream::nextLine(const char **line, int *len)
+{
+  bool ret = false;
+  *line = "";
+  *len = 0;
+  if (p_isOpen) {
+    if (p_srcFile) {
+      const char *eol = NULL;
+      size_t start = p_position;
+      while (true) {
+        if (p_position < p_end) {
+          eol = static_cast<const char*>(memchr(&p_buffer[0] + start, '\n',
+                p_end - start));
+        }
+        if (eol != NULL) break;
+        // Only search the characters that are added by the next read
+        size_t searched = p_end - p_position;
+        if (!readBlock()) break;
+        start = p_position + searched;
+      }
+      if (p_position < p_end) {
+        const char *first = &p_buffer[0] + p_position;
+        *line = first;
+        if (eol != NULL) {
+          *len = eol - first;
+          p_position += *len + 1;
+          ret = true;
+        } else {
+          // Last line is not terminated by an end of line. Return it but
+          // report that the end of the file has been reached (this is what
+          // std::getline followed by good() does)
+          *len = p_end - p_position;
+          p_position = p_end;
+        }
+      }
+    } else {
+      if (p_fileIterator != p_fileVector.end()) {
+        *line = p_fileIterator->data();
+        *len = p_fileIterator->length();
+        ret = true;
+        p_fileIterator++;
+      }
+    }
+  } else {
+    std::cout<<"No input stream is open when calling nextLine"<<std::endl;
+  }
+  return ret;
+}
+
 /**
  * Report if a stream is currently open
  * @return true if stream is open
@@ -52,6 +52,16 @@ public:
    * @return true if another line is found
    */
   bool nextLine(std::string &line);
+
+  /**
+   * Get next line from streaming source without copying it. The line is not
+   * null terminated and remains valid until the next call to nextLine or
+   * until the stream is closed
+   * @param line pointer to first character of line
+   * @param len number of characters in line (without end of line)
+   * @return true if another line is found
+   */
+  bool nextLine(const char **line, int *len);
   
   /**
    * Report if a stream is currently open
@@ -61,8 +71,28 @@ public:
 
 private:
 
+  /**
+   * Read the next block of the file into the buffer
+   * @return false if no more characters could be read
+   */
+  bool readBlock();
+
+  // Size of blocks read from file
+  static const size_t BLOCK_SIZE = 1 << 20;
+
   std::ifstream p_fout;
 
+  // File is read in blocks and lines are extracted from this buffer.
+  // Characters between p_position and p_end have not been handed out yet
+  std::vector<char> p_buffer;
+
+  size_t p_position;
+
+  size_t p_end;
+
+  // No more data can be read from the file
+  bool p_eof;
+
   bool p_srcFile;
 
   bool p_srcVector;
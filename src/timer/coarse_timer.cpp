@@ -46,6 +46,7 @@ int gridpack::utility::CoarseTimer::createCategory(const std::string title)
     p_time.push_back(0.0);
     p_istart.push_back(0);
     p_istop.push_back(0);
+    p_count.push_back(0);
   }
   return idx;
 }
@@ -72,6 +73,17 @@ void gridpack::utility::CoarseTimer::stop(const int idx)
   p_istop[idx]++;
 }
 
+/**
+ * Add to a counter associated with the category
+ * @param idx category handle
+ * @param count value added to counter
+ */
+void gridpack::utility::CoarseTimer::addCount(const int idx, const long count)
+{
+  if (!p_profile) return;
+  p_count[idx] += count;
+}
+
 /**
  * Write all timing statistics to standard out
  */
@@ -117,6 +129,10 @@ void gridpack::utility::CoarseTimer::dump(void) const
     MPI_Allreduce(scheck, rcheck, nproc, MPI_INT, MPI_SUM, world);
     MPI_Allreduce(&sncheck, &rncheck, 1, MPI_INT, MPI_SUM, world);
     MPI_Allreduce(stime, rtime, nproc, MPI_DOUBLE, MPI_SUM, world);
+    long scount[2], rcount[2];
+    scount[0] = p_count[i];
+    scount[1] = p_istop[i];
+    MPI_Allreduce(scount, rcount, 2, MPI_LONG, MPI_SUM, world);
     bool ok = true;
     double max = rtime[0];
     double min = rtime[0];
@@ -147,6 +163,13 @@ void gridpack::utility::CoarseTimer::dump(void) const
       if (rms > 0.0) {
         printf("    RMS deviation:     %16.4f\n",rms);
       }
+      if (rcount[0] > 0) {
+        printf("    Total count:       %16ld\n",rcount[0]);
+        if (rcount[1] > 0) {
+          printf("    Count per call:    %16.1f\n",
+              static_cast<double>(rcount[0])/static_cast<double>(rcount[1]));
+        }
+      }
     } else if (me == 0 && rncheck > 0) {
       printf("Invalid time statistics. Start and stop not paired for ");
       printf("%s\n",p_title[i].c_str());
@@ -259,6 +282,7 @@ gridpack::utility::CoarseTimer::CoarseTimer()
   p_time.clear();
   p_istart.clear();
   p_istop.clear();
+  p_count.clear();
   p_profile = true;
 }
 
@@ -273,4 +297,5 @@ gridpack::utility::CoarseTimer::~CoarseTimer()
   p_time.clear();
   p_istart.clear();
   p_istop.clear();
+  p_count.clear();
 }
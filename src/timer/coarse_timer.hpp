@@ -46,6 +46,16 @@ public:
    */
   void stop(const int idx);
 
+  /**
+   * Add to a counter associated with the category. This can be used to
+   * keep track of quantities such as the number of bytes moved by an
+   * operation. The total count and the average count per start/stop pair
+   * are reported along with the timing statistics
+   * @param idx category handle
+   * @param count value added to counter
+   */
+  void addCount(const int idx, const long count);
+
   /**
    * Write all timing statistics to standard out
    */
@@ -95,6 +105,7 @@ private:
   std::vector<double> p_time;
   std::vector<int>    p_istart;
   std::vector<int>    p_istop;
+  std::vector<long>   p_count;
 
   static CoarseTimer *p_instance;
 